@@ -44,6 +44,7 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 
 #include <llvm/ADT/DenseMap.h>
 
@@ -121,6 +122,9 @@ private:
 
   std::unique_ptr< CallContext > _empty_call_context;
 
+  /// \brief Mutex protecting the factory, for parallel analyses
+  std::recursive_mutex _mutex;
+
 public:
   /// \brief Constructor
   CallContextFactory();
@@ -58,6 +58,7 @@ class MemoryFactory;
 class VariableFactory;
 class LiteralFactory;
 class CallContextFactory;
+class WtoCache;
 class LivenessAnalysis;
 class FunctionPointerAnalysis;
 class PointerAnalysis;
@@ -92,6 +93,9 @@ public:
   /// \brief Call context factory
   CallContextFactory* call_context_factory;
 
+  /// \brief Cache of weak topological orders
+  WtoCache* wto_cache;
+
   /// \brief Liveness analysis
   LivenessAnalysis* liveness;
 
@@ -113,7 +117,8 @@ public:
           MemoryFactory& mem_factory_,
           VariableFactory& var_factory_,
           LiteralFactory& lit_factory_,
-          CallContextFactory& call_context_factory_)
+          CallContextFactory& call_context_factory_,
+          WtoCache& wto_cache_)
       : bundle(bundle_),
         opts(std::move(opts_)),
         wd(std::move(wd_)),
@@ -122,6 +127,7 @@ public:
         var_factory(&var_factory_),
         lit_factory(&lit_factory_),
         call_context_factory(&call_context_factory_),
+        wto_cache(&wto_cache_),
         liveness(nullptr),
         function_pointer(nullptr),
         pointer(nullptr),
@@ -64,6 +64,15 @@
 namespace ikos {
 namespace analyzer {
 
+/// \brief Statistics on the reuse of callee fixpoints by the inliner
+struct InlineCallCacheStats {
+  /// \brief Number of calls that reused a previously computed fixpoint
+  std::size_t hits = 0;
+
+  /// \brief Number of calls that required a new fixpoint on the callee
+  std::size_t misses = 0;
+};
+
 /// \brief Inliner of function calls.
 ///
 /// The inlining of a function is done dynamically by matching formal and actual
@@ -71,6 +80,14 @@ namespace analyzer {
 /// the callee returns by simulating call-by-ref and updating the return value
 /// at the call site. The inlining also supports function pointers by resolving
 /// first the set of possible callees and joining the results.
+///
+/// Fixpoints on callees are memoized per call statement and calling context.
+/// If the invariant at the entry of a callee is equal to the entry invariant
+/// of the previously computed fixpoint, the previous fixpoint is reused
+/// instead of analyzing the callee again. A fixpoint computed for a larger
+/// entry invariant is not reused: it would keep the imprecise results of the
+/// first iterations during the narrowing, and the checks on the callee would
+/// not use the final entry invariant.
 template < typename FunctionAnalyzer, typename AbstractDomain >
 class InlineCallExecutionEngine final : public CallExecutionEngine {
 public:
@@ -79,10 +96,17 @@ public:
   using NumericalExecutionEngineT = NumericalExecutionEngine< AbstractDomain >;
 
 private:
-  /// \brief Map from callee function to FunctionAnalyzer
-  using CalleeMap =
-      boost::container::flat_map< ar::Function*,
-                                  std::unique_ptr< FunctionAnalyzer > >;
+  /// \brief Previously computed fixpoint on a callee
+  struct CalleeFixpoint {
+    /// \brief Invariant at the entry of the callee
+    AbstractDomain entry_inv;
+
+    /// \brief Function analyzer on the callee
+    std::unique_ptr< FunctionAnalyzer > analyzer;
+  };
+
+  /// \brief Map from callee function to CalleeFixpoint
+  using CalleeMap = boost::container::flat_map< ar::Function*, CalleeFixpoint >;
 
   /// \brief Map from call statement to CalleeMap
   using CallMap = llvm::DenseMap< ar::CallBase*, CalleeMap >;
@@ -106,6 +130,9 @@ private:
   /// \brief Store previously-computed fixpoints on callees
   CallMap _calls;
 
+  /// \brief Statistics on the reuse of fixpoints on callees
+  InlineCallCacheStats& _cache_stats;
+
   /// \brief True if the calling context is stable
   bool _context_stable;
 
@@ -117,6 +144,7 @@ public:
   InlineCallExecutionEngine(Context& ctx,
                             NumericalExecutionEngineT& engine,
                             const FunctionAnalyzer& caller,
+                            InlineCallCacheStats& cache_stats,
                             bool context_stable,
                             bool convergence_achieved)
       : _ctx(ctx),
@@ -125,6 +153,7 @@ public:
         _exit_inv(AbstractDomain::bottom()),
         _return_stmt(nullptr),
         _calls(),
+        _cache_stats(cache_stats),
         _context_stable(context_stable),
         _convergence_achieved(convergence_achieved) {}
 
@@ -137,6 +166,15 @@ public:
   /// \brief Clear the list of callees
   void clear() { this->_calls.clear(); }
 
+  /// \brief Take the previously-computed fixpoints on callees of another
+  /// inliner on the same function and calling context
+  ///
+  /// This allows a new fixpoint on the function to reuse the fixpoints on
+  /// callees that have the same entry invariants.
+  void take_callees(InlineCallExecutionEngine& other) {
+    this->_calls = std::move(other._calls);
+  }
+
   /// \brief Run the checks on the callees
   void run_checks() const {
     for (auto it = this->_calls.begin(), et = this->_calls.end(); it != et;
@@ -155,7 +193,7 @@ private:
   /// \brief Run the checks on the given CalleeMap
   void run_checks(const CalleeMap& callees) const {
     for (auto it = callees.begin(), et = callees.end(); it != et; ++it) {
-      it->second->run_checks();
+      it->second.analyzer->run_checks();
     }
   }
 
@@ -252,7 +290,7 @@ private:
       // potential callees
       const PointerInfo* pointer_info = this->_engine.pointer_info();
       if (pointer_info != nullptr) {
-        PointsToSet points_to = pointer_info->get(ptr_var).points_to();
+        const PointsToSet& points_to = pointer_info->get(ptr_var).points_to();
 
         // Pointer analysis and value analysis can be inconsistent
         if (!points_to.is_bottom() && !points_to.is_top()) {
@@ -347,20 +385,23 @@ private:
       //
 
       const InlineCallExecutionEngineT* callee_inliner = nullptr;
+      auto it = callee_map.find(callee);
 
-      if (this->_convergence_achieved) {
-        // Use the previously computed fix-point
-        FunctionAnalyzer* callee_analyzer = callee_map.at(callee).get();
+      if (it != callee_map.end() && engine.inv().equals(it->second.entry_inv)) {
+        // The previous fix-point was computed for this entry invariant
+        ++this->_cache_stats.hits;
+        FunctionAnalyzer* callee_analyzer = it->second.analyzer.get();
 
-        if (this->_context_stable) {
+        if (this->_convergence_achieved && this->_context_stable) {
           // Calling context is stable
           callee_analyzer->mark_context_stable();
         }
 
         callee_inliner = &callee_analyzer->inliner();
       } else {
-        // Erase the previous fix-point
-        callee_map.erase(callee);
+        // This also happens after the convergence on the caller, if the
+        // narrowing refined the entry invariant of the callee
+        ++this->_cache_stats.misses;
 
         auto callee_analyzer = std::make_unique<
             FunctionAnalyzer >(_ctx,
@@ -370,6 +411,15 @@ private:
                                this->_context_stable &&
                                    this->_convergence_achieved);
 
+        if (it != callee_map.end()) {
+          // Reuse the fix-points on the callees of the previous fix-point
+          callee_analyzer->inliner().take_callees(
+              it->second.analyzer->inliner());
+
+          // Erase the previous fix-point
+          callee_map.erase(it);
+        }
+
         callee_inliner = &callee_analyzer->inliner();
 
         // Run analysis on callee
@@ -377,7 +427,9 @@ private:
         callee_analyzer->run(engine.inv());
 
         // insert in the callee map
-        callee_map.emplace(callee, std::move(callee_analyzer));
+        callee_map.emplace(callee,
+                           CalleeFixpoint{engine.inv(),
+                                          std::move(callee_analyzer)});
       }
 
       engine.set_inv(callee_inliner->exit_invariant());
@@ -47,6 +47,8 @@
 
 #pragma once
 
+#include <algorithm>
+
 #include <ikos/ar/semantic/intrinsic.hpp>
 #include <ikos/ar/verify/type.hpp>
 
@@ -523,7 +525,7 @@ private:
       return;
     }
 
-    PointerAbsValue value = this->_pointer_info->get(ptr);
+    const PointerAbsValue& value = this->_pointer_info->get(ptr);
     this->_inv.normal().pointers().refine(ptr, value.points_to());
   }
 
@@ -539,7 +541,7 @@ private:
       return;
     }
 
-    PointerAbsValue value = this->_pointer_info->get(ptr);
+    const PointerAbsValue& value = this->_pointer_info->get(ptr);
     this->_inv.normal().pointers().refine(ptr, value);
   }
 
@@ -856,6 +858,21 @@ private:
     this->_inv.caught_exceptions().join_with(this->_inv.normal());
   }
 
+  /// \brief Apply `f` on the normal execution flow state and on the states of
+  /// pending exceptions that are not bottom
+  ///
+  /// This avoids materializing the exception states, which are usually bottom.
+  template < typename Function >
+  void for_each_state(Function f) {
+    f(this->_inv.normal());
+    if (!this->_inv.is_caught_exceptions_bottom()) {
+      f(this->_inv.caught_exceptions());
+    }
+    if (!this->_inv.is_propagated_exceptions_bottom()) {
+      f(this->_inv.propagated_exceptions());
+    }
+  }
+
 public:
   /// \brief Deallocate the memory for the given local variables
   void deallocate_local_variables(ar::Function::LocalVariableIterator begin,
@@ -868,29 +885,24 @@ public:
       LocalVariable* var = this->_var_factory.get_local(*it);
       MemoryLocation* addr = this->_mem_factory.get_local(*it);
 
-      // Forget the allocated size
       AllocSizeVariable* alloc_size_var =
           this->_var_factory.get_alloc_size(addr);
-      this->_inv.normal().integers().forget(alloc_size_var);
-      this->_inv.caught_exceptions().integers().forget(alloc_size_var);
-      this->_inv.propagated_exceptions().integers().forget(alloc_size_var);
 
-      // Set the memory location lifetime to deallocated
-      this->_inv.normal().lifetime().assign_deallocated(addr);
-      this->_inv.caught_exceptions().lifetime().assign_deallocated(addr);
-      this->_inv.propagated_exceptions().lifetime().assign_deallocated(addr);
+      this->for_each_state([=](auto& inv) {
+        // Forget the allocated size
+        inv.integers().forget(alloc_size_var);
 
-      if (this->_precision >= Precision::Memory) {
-        // Forget the memory content
-        this->_inv.normal().forget_mem(addr);
-        this->_inv.caught_exceptions().forget_mem(addr);
-        this->_inv.propagated_exceptions().forget_mem(addr);
-      }
+        // Set the memory location lifetime to deallocated
+        inv.lifetime().assign_deallocated(addr);
 
-      // Forget local variable pointer
-      this->_inv.normal().forget_surface(var);
-      this->_inv.caught_exceptions().forget_surface(var);
-      this->_inv.propagated_exceptions().forget_surface(var);
+        if (this->_precision >= Precision::Memory) {
+          // Forget the memory content
+          inv.forget_mem(addr);
+        }
+
+        // Forget local variable pointer
+        inv.forget_surface(var);
+      });
     }
   }
 
@@ -906,6 +918,18 @@ public:
   ///
   /// Use the liveness analysis to remove dead variables
   void exec_leave(ar::BasicBlock* bb) override {
+    this->forget_dead_variables(bb, /* keep_parameters = */ nullptr);
+  }
+
+  /// \brief Remove the variables that are dead at the end of the given basic
+  /// block
+  ///
+  /// \param bb The basic block
+  /// \param keep_parameters If not null, keep the parameters of this function,
+  /// even if they are dead. This is used to compute function summaries that
+  /// relate the parameters with the returned value.
+  void forget_dead_variables(ar::BasicBlock* bb,
+                             ar::Function* keep_parameters) {
     if (this->_liveness == nullptr) {
       return;
     }
@@ -937,23 +961,27 @@ public:
         continue;
       }
 
+      if (keep_parameters != nullptr && isa< InternalVariable >(var) &&
+          std::find(keep_parameters->param_begin(),
+                    keep_parameters->param_end(),
+                    cast< InternalVariable >(var)->internal_var()) !=
+              keep_parameters->param_end()) { // Ignore
+        continue;
+      }
+
       // Special case for aggregate internal variables: Clean-up the memory
       if (this->_precision >= Precision::Memory) {
         if (auto iv = dyn_cast< InternalVariable >(var)) {
           ar::InternalVariable* ar_iv = iv->internal_var();
           if (ar_iv->type()->is_aggregate()) {
             MemoryLocation* addr = this->_mem_factory.get_aggregate(ar_iv);
-            this->_inv.normal().forget_mem(addr);
-            this->_inv.caught_exceptions().forget_mem(addr);
-            this->_inv.propagated_exceptions().forget_mem(addr);
+            this->for_each_state([=](auto& inv) { inv.forget_mem(addr); });
           }
         }
       }
 
       // Clean-up memory surface
-      this->_inv.normal().forget_surface(var);
-      this->_inv.caught_exceptions().forget_surface(var);
-      this->_inv.propagated_exceptions().forget_surface(var);
+      this->for_each_state([=](auto& inv) { inv.forget_surface(var); });
     }
   }
 
@@ -0,0 +1,264 @@
+/******************************************************************************
+ *
+ * \file
+ * \brief Summary-based call semantic
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2018 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <memory>
+
+#include <llvm/ADT/DenseMap.h>
+
+#include <ikos/ar/semantic/function.hpp>
+#include <ikos/ar/verify/type.hpp>
+
+#include <ikos/analyzer/analysis/execution_engine/engine.hpp>
+#include <ikos/analyzer/analysis/execution_engine/numerical.hpp>
+
+namespace ikos {
+namespace analyzer {
+
+/// \brief Summary of a function
+///
+/// A summary is the invariant at the end of the function, computed from a top
+/// invariant at the entry of the function. The formal parameters are kept in
+/// the summary, so that it relates the parameters with the returned value.
+///
+/// The invariant is projected on the formal parameters, the returned value,
+/// the global variables and the memory reachable from them. The other
+/// variables of the function are forgotten, so that they do not leak into the
+/// invariants of the callers.
+///
+/// This assumes that formal parameters are never assigned in the function
+/// body, which holds for code translated from LLVM.
+template < typename AbstractDomain >
+struct FunctionSummary {
+  /// \brief Invariant at the end of the function
+  AbstractDomain exit_inv;
+
+  /// \brief Return statement, or null
+  ar::ReturnValue* return_stmt;
+};
+
+/// \brief Summary-based call semantic
+///
+/// Calls to functions with a summary are analyzed by binding the formal
+/// parameters to the actual parameters and refining the invariant with the
+/// summary. The callee is assumed to update any memory location.
+///
+/// Calls to functions without a summary (e.g, recursive calls) are safely
+/// ignored, see NumericalExecutionEngine::exec_unknown_intern_call().
+///
+/// The entry invariants of the callees with a summary can be collected, to
+/// check them in their calling contexts afterwards.
+template < typename AbstractDomain >
+class SummaryCallExecutionEngine final : public CallExecutionEngine {
+public:
+  using NumericalExecutionEngineT = NumericalExecutionEngine< AbstractDomain >;
+  using FunctionSummaryT = FunctionSummary< AbstractDomain >;
+
+  /// \brief Map from function to summary
+  using SummaryMap =
+      llvm::DenseMap< ar::Function*, std::unique_ptr< FunctionSummaryT > >;
+
+  /// \brief Map from function to the join of its entry invariants
+  using CallingContextMap = llvm::DenseMap< ar::Function*, AbstractDomain >;
+
+private:
+  /// \brief Analysis context
+  Context& _ctx;
+
+  /// \brief Numerical execution engine
+  NumericalExecutionEngineT& _engine;
+
+  /// \brief Previously computed function summaries
+  const SummaryMap& _summaries;
+
+  /// \brief Entry invariants of the callees, or null
+  CallingContextMap* _calling_contexts;
+
+public:
+  /// \brief Constructor
+  ///
+  /// \param ctx Analysis context
+  /// \param engine Numerical execution engine
+  /// \param summaries Previously computed function summaries
+  /// \param calling_contexts If not null, join the entry invariants of the
+  ///   callees with a summary in this map
+  SummaryCallExecutionEngine(Context& ctx,
+                             NumericalExecutionEngineT& engine,
+                             const SummaryMap& summaries,
+                             CallingContextMap* calling_contexts = nullptr)
+      : _ctx(ctx),
+        _engine(engine),
+        _summaries(summaries),
+        _calling_contexts(calling_contexts) {}
+
+  /// \brief Exit a function
+  ///
+  /// This is called whenever we reach the exit node (if there is one).
+  ///
+  /// Note that this is different from exec(ar::Returnvalue*) if there is
+  /// exceptions. This can be used to catch the invariant, including pending
+  /// exceptions.
+  void exec_exit(ar::Function*) override {}
+
+  /// \brief Execute any call statement
+  void exec(ar::CallBase* call) {
+    if (auto cst = dyn_cast< ar::FunctionPointerConstant >(call->called())) {
+      // Direct call
+      ar::Function* fun = cst->function();
+
+      if (fun->is_declaration()) {
+        // Extern function
+        this->_engine.exec_extern_call(call, fun);
+        return;
+      }
+
+      auto it = this->_summaries.find(fun);
+      if (it != this->_summaries.end() &&
+          ar::TypeVerifier::is_valid_call(call, fun->type())) {
+        this->apply_summary(call, fun, *it->second);
+        return;
+      }
+    }
+
+    // Otherwise
+    this->_engine.exec_unknown_intern_call(call);
+  }
+
+  /// \brief Execute a Call statement
+  void exec(ar::Call* s) override {
+    // execute the call statement
+    this->exec(cast< ar::CallBase >(s));
+
+    // exceptions aren't caught, propagate them
+    this->_engine.inv().merge_caught_in_propagated_exceptions();
+  }
+
+  /// \brief Execute an Invoke statement
+  void exec(ar::Invoke* s) override {
+    // execute the call base statement
+    this->exec(cast< ar::CallBase >(s));
+
+    // Exceptions are caught.
+    // Nothing to do here.
+    // see NumericalExecutionEngine::exec_edge()
+  }
+
+  /// \brief Execute a ReturnValue statement
+  void exec(ar::ReturnValue*) override {}
+
+private:
+  /// \brief Apply the summary of the given callee
+  void apply_summary(ar::CallBase* call,
+                     ar::Function* callee,
+                     const FunctionSummaryT& summary) {
+    if (this->_engine.inv().is_normal_flow_bottom()) {
+      return;
+    }
+
+    // Bind the formal parameters to the actual parameters
+    this->_engine.match_down(call, callee);
+
+    if (this->_calling_contexts != nullptr) {
+      this->add_calling_context(callee);
+    }
+
+    // The callee might update any memory location and throw exceptions
+    this->_engine.exec_unknown_intern_call(call);
+
+    // Refine the invariant with the summary
+    //
+    // Both invariants over-approximate the state after the call, since the
+    // summary was computed from a top invariant.
+    this->_engine.inv().normal().meet_with(summary.exit_inv.normal());
+
+    if (this->_engine.inv().is_normal_flow_bottom()) {
+      return;
+    }
+
+    // Assign the returned value
+    this->_engine.match_up(call, summary.return_stmt);
+
+    // Clean-up the returned variable of the callee, now assigned to the
+    // result of the call
+    if (summary.return_stmt != nullptr && summary.return_stmt->has_operand()) {
+      this->forget_callee_variable(summary.return_stmt->operand());
+    }
+
+    // Clean-up the formal parameters
+    for (auto it = callee->param_begin(), et = callee->param_end(); it != et;
+         ++it) {
+      this->forget_callee_variable(*it);
+    }
+  }
+
+  /// \brief Join the current invariant in the entry invariant of the callee
+  void add_calling_context(ar::Function* callee) {
+    // Do not propagate exceptions from the caller to the callee
+    AbstractDomain entry_inv = this->_engine.inv();
+    entry_inv.ignore_exceptions();
+
+    auto it = this->_calling_contexts->find(callee);
+    if (it == this->_calling_contexts->end()) {
+      this->_calling_contexts->try_emplace(callee, std::move(entry_inv));
+    } else {
+      it->second.join_with(entry_inv);
+    }
+  }
+
+  /// \brief Forget a variable of the callee, coming from its summary
+  void forget_callee_variable(ar::Value* value) {
+    const Literal& lit = this->_ctx.lit_factory->get(value);
+
+    if (lit.is_scalar() && lit.scalar().is_var()) {
+      this->_engine.inv().normal().forget_surface(lit.scalar().var());
+    } else if (lit.is_aggregate() && lit.aggregate().is_var()) {
+      this->_engine.inv().normal().forget_reachable_mem(lit.aggregate().var());
+      this->_engine.inv().normal().forget_surface(lit.aggregate().var());
+    }
+  }
+
+}; // end class SummaryCallExecutionEngine
+
+} // end namespace analyzer
+} // end namespace ikos
@@ -45,6 +45,7 @@
 
 #pragma once
 
+#include <mutex>
 #include <unordered_map>
 
 #include <boost/variant.hpp>
@@ -328,6 +329,9 @@ private:
   /// \brief Map from ar::Value* to Literal
   Map _map;
 
+  /// \brief Mutex protecting the factory, for parallel analyses
+  std::recursive_mutex _mutex;
+
 public:
   /// \brief Constructor
   LiteralFactory(VariableFactory& vfac, const ar::DataLayout& data_layout);
@@ -46,6 +46,7 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <string>
 
 #include <boost/container/flat_map.hpp>
@@ -94,6 +95,9 @@ protected:
   /// \brief Kind of the MemoryLocation
   MemoryLocationKind _kind;
 
+  /// \brief Unique index, assigned by the MemoryFactory
+  core::Index _index;
+
 protected:
   /// \brief Protected constructor
   explicit MemoryLocation(MemoryLocationKind kind);
@@ -117,9 +121,19 @@ public:
   /// \brief Return the kind of the object
   MemoryLocationKind kind() const { return this->_kind; }
 
+  /// \brief Return the unique index of the memory location
+  ///
+  /// Indexes are dense and sequential, in order of creation. With several
+  /// jobs (-j), memory locations are created concurrently, so indexes and the
+  /// iteration order of the abstract domains might change between runs. Use a
+  /// single job for reproducible indexes.
+  core::Index index() const { return this->_index; }
+
   /// \brief Dump the memory location, for debugging purpose
   virtual void dump(std::ostream&) const = 0;
 
+  friend class MemoryFactory;
+
 }; // end class MemoryLocation
 
 /// \brief Local memory location
@@ -324,6 +338,12 @@ private:
                   std::unique_ptr< DynAllocMemoryLocation > >
       _dyn_alloc_map;
 
+  /// \brief Index of the next created memory location
+  core::Index _next_index = 0;
+
+  /// \brief Mutex protecting the factory, for parallel analyses
+  std::recursive_mutex _mutex;
+
 public:
   /// \brief Default constructor for factory
   MemoryFactory();
@@ -343,6 +363,10 @@ public:
   /// \brief Destructor
   ~MemoryFactory();
 
+private:
+  /// \brief Assign the next index to the given memory location
+  void assign_index(MemoryLocation* ml);
+
 public:
   /// \brief Get or create a LocalMemoryLocation
   LocalMemoryLocation* get_local(ar::LocalVariable* var);
@@ -382,12 +406,10 @@ namespace core {
 
 /// \brief Implement IndexableTraits for MemoryLocation*
 ///
-/// The index of MemoryLocation* is the address of the pointer
+/// The index of MemoryLocation* is the sequential index given by the factory
 template <>
 struct IndexableTraits< analyzer::MemoryLocation* > {
-  static Index index(const analyzer::MemoryLocation* m) {
-    return reinterpret_cast< Index >(m);
-  }
+  static Index index(const analyzer::MemoryLocation* m) { return m->index(); }
 };
 
 /// \brief Implement DumpableTraits for MemoryLocation*
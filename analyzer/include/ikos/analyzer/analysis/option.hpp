@@ -66,6 +66,9 @@ enum class MachineIntDomainOption {
   Congruence,
   IntervalCongruence,
   DBM,
+  SparseDBM,
+  NativeDBM,
+  Octagon,
   VarPackDBM,
   VarPackDBMCongruence,
   Gauge,
@@ -96,6 +99,12 @@ inline const char* machine_int_domain_option_str(MachineIntDomainOption d) {
       return "interval-congruence";
     case MachineIntDomainOption::DBM:
       return "dbm";
+    case MachineIntDomainOption::SparseDBM:
+      return "sparse-dbm";
+    case MachineIntDomainOption::NativeDBM:
+      return "native-dbm";
+    case MachineIntDomainOption::Octagon:
+      return "octagon";
     case MachineIntDomainOption::VarPackDBM:
       return "var-pack-dbm";
     case MachineIntDomainOption::VarPackDBMCongruence:
@@ -153,6 +162,69 @@ inline bool machine_int_domain_option_has_narrowing(MachineIntDomainOption d) {
   }
 }
 
+/// \brief Return true if the MachineIntDomainOption uses variable packing
+inline bool machine_int_domain_option_has_var_packing(
+    MachineIntDomainOption d) {
+  switch (d) {
+    case MachineIntDomainOption::VarPackDBM:
+    case MachineIntDomainOption::VarPackDBMCongruence:
+    case MachineIntDomainOption::VarPackApronOctagon:
+    case MachineIntDomainOption::VarPackApronPolkaPolyhedra:
+    case MachineIntDomainOption::VarPackApronPolkaLinearEqualities:
+    case MachineIntDomainOption::VarPackApronPplPolyhedra:
+    case MachineIntDomainOption::VarPackApronPplLinearCongruences:
+    case MachineIntDomainOption::VarPackApronPkgridPolyhedraLinearCongruences:
+      return true;
+    default:
+      return false;
+  }
+}
+
+/// \brief Return true if the MachineIntDomainOption uses Apron
+///
+/// Apron domains share a global manager, which cannot be used by several
+/// threads concurrently.
+inline bool machine_int_domain_option_uses_apron(MachineIntDomainOption d) {
+  switch (d) {
+    case MachineIntDomainOption::ApronInterval:
+    case MachineIntDomainOption::ApronOctagon:
+    case MachineIntDomainOption::ApronPolkaPolyhedra:
+    case MachineIntDomainOption::ApronPolkaLinearEqualities:
+    case MachineIntDomainOption::ApronPplPolyhedra:
+    case MachineIntDomainOption::ApronPplLinearCongruences:
+    case MachineIntDomainOption::ApronPkgridPolyhedraLinearCongruences:
+    case MachineIntDomainOption::VarPackApronOctagon:
+    case MachineIntDomainOption::VarPackApronPolkaPolyhedra:
+    case MachineIntDomainOption::VarPackApronPolkaLinearEqualities:
+    case MachineIntDomainOption::VarPackApronPplPolyhedra:
+    case MachineIntDomainOption::VarPackApronPplLinearCongruences:
+    case MachineIntDomainOption::VarPackApronPkgridPolyhedraLinearCongruences:
+      return true;
+    default:
+      return false;
+  }
+}
+
+/// \brief Return true if invariants of the MachineIntDomainOption can be
+/// shared by several threads
+///
+/// This is required to analyze independent parts of a function concurrently.
+/// Apron domains share a global manager. Variable packing domains and domains
+/// based on core::machine_int::PolymorphicDomain share their representation
+/// between copies and normalize it lazily. Only the other domains are
+/// thread-safe.
+inline bool machine_int_domain_option_is_thread_safe(
+    MachineIntDomainOption d) {
+  switch (d) {
+    case MachineIntDomainOption::Interval:
+    case MachineIntDomainOption::IntervalCongruence:
+    case MachineIntDomainOption::DBM:
+      return true;
+    default:
+      return false;
+  }
+}
+
 /// \brief Represents the precision of an analysis
 enum class Precision {
   /// \brief Only track values in "registers", ie. ar::InternalVariable
@@ -178,13 +250,17 @@ inline const char* precision_str(Precision p) {
   }
 }
 
-/// \brief Either Interprocedural or Intraprocedural
+/// \brief Either Interprocedural, Intraprocedural or Summary
 enum class Procedural {
   /// \brief Analyzes function by taking into account other functions
   Interprocedural,
 
   /// \brief Analyze function independently
   Intraprocedural,
+
+  /// \brief Analyze function independently, bottom-up, using summaries of
+  /// the callees
+  Summary,
 };
 
 /// \brief Return a string representing a Procedural
@@ -194,6 +270,8 @@ inline const char* procedural_str(Procedural proc) {
       return "interprocedural";
     case Procedural::Intraprocedural:
       return "intraprocedural";
+    case Procedural::Summary:
+      return "summary";
     default: { ikos_unreachable("unreachable"); }
   }
 }
@@ -273,9 +351,16 @@ public:
   /// \brief Wether we should use a liveness analysis or not
   bool use_liveness;
 
+  /// \brief Wether we should use a syntactic variable packing analysis or not
+  bool use_syntactic_packing;
+
   /// \brief Wether we should use a pointer analysis or not
   bool use_pointer;
 
+  /// \brief Wether we should only store invariants at cycle heads and join
+  /// points
+  bool sparse_invariants;
+
   /// \brief Precision of the analysis
   Precision precision;
 
@@ -294,7 +379,20 @@ public:
   /// \brief Value of argc, or boost::none
   boost::optional< int > argc;
 
+  /// \brief Number of threads used by the pointer and value analyses
+  unsigned jobs;
+
+  /// \brief Number of threads used to analyze independent components of the
+  /// weak topological order of a function
+  unsigned fixpoint_jobs;
+
 public:
+  /// \brief Return the number of threads used by the value analysis
+  ///
+  /// Functions or entry points are analyzed on separate invariants, but Apron
+  /// domains share a global manager, thus they use a single thread.
+  unsigned value_jobs() const;
+
   /// \brief Save the options in the output database
   void save(SettingsTable&);
 
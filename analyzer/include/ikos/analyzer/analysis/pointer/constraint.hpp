@@ -47,6 +47,10 @@
 
 #pragma once
 
+#include <memory>
+#include <mutex>
+#include <vector>
+
 #include <ikos/core/domain/pointer/solver.hpp>
 
 #include <ikos/ar/semantic/code.hpp>
@@ -63,6 +67,8 @@
 #include <ikos/analyzer/analysis/variable.hpp>
 #include <ikos/analyzer/exception.hpp>
 #include <ikos/analyzer/support/cast.hpp>
+#include <ikos/analyzer/util/log.hpp>
+#include <ikos/analyzer/util/parallel.hpp>
 
 namespace ikos {
 namespace analyzer {
@@ -71,6 +77,10 @@ namespace analyzer {
 using PointerConstraint =
     core::pointer::Constraint< Variable*, MemoryLocation* >;
 
+/// \brief Cycle of pointer copies, collapsed during the resolution
+using PointerCycle =
+    core::pointer::ConstraintSystem< Variable*, MemoryLocation* >::Cycle;
+
 /// \brief System of pointer constraints
 class PointerConstraints {
 private:
@@ -99,17 +109,80 @@ public:
   /// \brief Add a pointer constraint
   void add(std::unique_ptr< PointerConstraint > cst);
 
+  /// \brief Move the pointer constraints of `other` at the end of this system
+  void merge(PointerConstraints&& other);
+
   /// \brief Solve pointer constraints
   void solve();
 
   /// \brief Export results
   void results(PointerInfo&) const;
 
+  /// \brief Return the cycles of copies collapsed during the resolution
+  const std::vector< PointerCycle >& cycles() const;
+
   /// \brief Dump the pointer constraints, for debugging purpose
   void dump(std::ostream&) const;
 
 }; // end class PointerConstraints
 
+/// \brief Generate the pointer constraints of the whole bundle
+///
+/// `process_global(gv, csts)` and `process_function(fun, csts)` add the
+/// constraints of a global variable or a function in `csts`. They are called
+/// in parallel, using `ctx.opts.jobs` threads, each one on its own buffer of
+/// constraints. Buffers are merged in order, so that the constraint system
+/// does not depend on the number of threads.
+template < typename ProcessGlobal, typename ProcessFunction >
+void generate_pointer_constraints(Context& ctx,
+                                  PointerConstraints& csts,
+                                  ProcessGlobal process_global,
+                                  ProcessFunction process_function) {
+  ar::Bundle* bundle = ctx.bundle;
+  std::vector< ar::GlobalVariable* > globals(bundle->global_begin(),
+                                             bundle->global_end());
+  std::vector< ar::Function* > functions(bundle->function_begin(),
+                                         bundle->function_end());
+  std::size_t n = globals.size() + functions.size();
+
+  // Buffer of constraints for each global variable and function
+  std::vector< std::unique_ptr< PointerConstraints > > buffers(n);
+
+  // Mutex serializing the logs
+  std::mutex log_mutex;
+
+  parallel_for(ctx.opts.jobs, n, [&](std::size_t i) {
+    auto buffer = std::make_unique< PointerConstraints >(bundle->data_layout());
+
+    if (i < globals.size()) {
+      ar::GlobalVariable* gv = globals[i];
+      if (gv->is_definition()) {
+        std::lock_guard< std::mutex > lock(log_mutex);
+        log::debug(
+            "Generating pointer constraints for initializer of global "
+            "variable @" +
+            gv->name());
+      }
+      process_global(gv, *buffer);
+    } else {
+      ar::Function* fun = functions[i - globals.size()];
+      if (fun->is_definition()) {
+        std::lock_guard< std::mutex > lock(log_mutex);
+        log::debug("Generating pointer constraints for function @" +
+                   fun->name());
+      }
+      process_function(fun, *buffer);
+    }
+
+    buffers[i] = std::move(buffer);
+  });
+
+  for (std::unique_ptr< PointerConstraints >& buffer : buffers) {
+    csts.merge(std::move(*buffer));
+    buffer.reset();
+  }
+}
+
 /// \brief Generate points-to constraints for a given ar::Code*
 template < typename CodeInvariants >
 class PointerConstraintsGenerator {
@@ -608,7 +681,7 @@ private:
           return;
         }
 
-        PointsToSet points_to =
+        const PointsToSet& points_to =
             this->_function_pointer->get(ptr_var).points_to();
 
         if (points_to.is_top() || points_to.is_bottom()) {
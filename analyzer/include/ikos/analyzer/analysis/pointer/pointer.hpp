@@ -52,6 +52,7 @@
 #pragma once
 
 #include <ikos/analyzer/analysis/context.hpp>
+#include <ikos/analyzer/analysis/pointer/constraint.hpp>
 #include <ikos/analyzer/analysis/pointer/function.hpp>
 #include <ikos/analyzer/analysis/pointer/value.hpp>
 
@@ -75,6 +76,9 @@ private:
   /// \brief Pointer information
   PointerInfo _info;
 
+  /// \brief Cycles of copies collapsed by the constraint solver
+  std::vector< PointerCycle > _cycles;
+
 public:
   /// \brief Constructor
   PointerAnalysis(Context& ctx,
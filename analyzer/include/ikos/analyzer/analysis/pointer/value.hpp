@@ -82,6 +82,9 @@ private:
   /// \brief Data layout
   const ar::DataLayout& _data_layout;
 
+  /// \brief Top pointer abstract value, for variables without information
+  PointerAbsValue _top;
+
 public:
   /// \brief Constructor
   PointerInfo(const ar::DataLayout& data_layout);
@@ -105,7 +108,7 @@ public:
   void clear();
 
   /// \brief Return information about the given pointer
-  PointerAbsValue get(Variable* v) const;
+  const PointerAbsValue& get(Variable* v) const;
 
   /// \brief Insert an information about a pointer
   void insert(Variable* v, const PointerAbsValue&);
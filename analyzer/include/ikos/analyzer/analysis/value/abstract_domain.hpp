@@ -61,13 +61,6 @@ namespace value {
 /// \brief Nullity abstract domain for the value analysis
 using NullityAbstractDomain = core::nullity::NullityDomain< Variable* >;
 
-/// \brief Pointer abstract domain for the value analysis
-using PointerAbstractDomain =
-    core::pointer::PointerDomain< Variable*,
-                                  MemoryLocation*,
-                                  MachineIntAbstractDomain,
-                                  NullityAbstractDomain >;
-
 /// \brief Uninitialized abstract domain for the value analysis
 using UninitializedAbstractDomain =
     core::uninitialized::UninitializedDomain< Variable* >;
@@ -76,19 +69,43 @@ using UninitializedAbstractDomain =
 using LifetimeAbstractDomain =
     core::lifetime::LifetimeDomain< MemoryLocation* >;
 
-/// \brief Memory abstract domain for the value analysis
-using MemoryAbstractDomain =
+/// \brief Pointer abstract domain for the value analysis, on the given
+/// machine integer abstract domain
+template < typename MachineIntDomain >
+using PointerAbstractDomainT =
+    core::pointer::PointerDomain< Variable*,
+                                  MemoryLocation*,
+                                  MachineIntDomain,
+                                  NullityAbstractDomain >;
+
+/// \brief Memory abstract domain for the value analysis, on the given
+/// machine integer abstract domain
+template < typename MachineIntDomain >
+using MemoryAbstractDomainT =
     core::memory::ValueDomain< Variable*,
                                MemoryLocation*,
                                VariableFactory,
-                               MachineIntAbstractDomain,
+                               MachineIntDomain,
                                NullityAbstractDomain,
-                               PointerAbstractDomain,
+                               PointerAbstractDomainT< MachineIntDomain >,
                                UninitializedAbstractDomain,
                                LifetimeAbstractDomain >;
 
+/// \brief Abstract domain for the value analysis, on the given machine
+/// integer abstract domain
+template < typename MachineIntDomain >
+using AbstractDomainT = core::exception::ExceptionDomain<
+    MemoryAbstractDomainT< MachineIntDomain > >;
+
+/// \brief Pointer abstract domain for the value analysis
+using PointerAbstractDomain =
+    PointerAbstractDomainT< MachineIntAbstractDomain >;
+
+/// \brief Memory abstract domain for the value analysis
+using MemoryAbstractDomain = MemoryAbstractDomainT< MachineIntAbstractDomain >;
+
 /// \brief Abstract domain for the value analysis
-using AbstractDomain = core::exception::ExceptionDomain< MemoryAbstractDomain >;
+using AbstractDomain = AbstractDomainT< MachineIntAbstractDomain >;
 
 } // end namespace value
 } // end namespace analyzer
@@ -80,6 +80,14 @@ public:
   /// \brief Run the analysis
   void run();
 
+private:
+  /// \brief Run the analysis, given the top machine integer abstract value
+  ///
+  /// This is instantiated for each machine integer abstract domain in
+  /// value/machine_int_domain/*.cpp
+  template < typename MachineIntDomain >
+  void run(const MachineIntDomain& machine_int_top);
+
 }; // end class InterproceduralValueAnalysis
 
 } // end namespace analyzer
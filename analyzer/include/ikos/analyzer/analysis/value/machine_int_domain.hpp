@@ -43,7 +43,12 @@
 
 #pragma once
 
+#include <ikos/core/domain/machine_int/interval.hpp>
+#include <ikos/core/domain/machine_int/interval_congruence.hpp>
+#include <ikos/core/domain/machine_int/numeric_domain_adapter.hpp>
 #include <ikos/core/domain/machine_int/polymorphic_domain.hpp>
+#include <ikos/core/domain/numeric/dbm.hpp>
+#include <ikos/core/domain/numeric/var_packing_dbm.hpp>
 
 #include <ikos/analyzer/analysis/option.hpp>
 #include <ikos/analyzer/analysis/variable.hpp>
@@ -56,6 +61,27 @@ namespace value {
 using MachineIntAbstractDomain =
     core::machine_int::PolymorphicDomain< Variable* >;
 
+/// \name Machine integer abstract domains with a specialized value analysis
+///
+/// The value analysis is instantiated on these domains directly, avoiding the
+/// virtual calls of MachineIntAbstractDomain on the most common choices.
+/// @{
+
+using IntervalMachineIntDomain = core::machine_int::IntervalDomain< Variable* >;
+
+using IntervalCongruenceMachineIntDomain =
+    core::machine_int::IntervalCongruenceDomain< Variable* >;
+
+using DBMMachineIntDomain = core::machine_int::NumericDomainAdapter<
+    Variable*,
+    core::numeric::DBM< ZNumber, Variable* > >;
+
+using VarPackDBMMachineIntDomain = core::machine_int::NumericDomainAdapter<
+    Variable*,
+    core::numeric::VarPackingDBM< ZNumber, Variable* > >;
+
+/// @}
+
 /// \name Constructors of machine integer abstract domains
 /// @{
 
@@ -63,6 +89,9 @@ MachineIntAbstractDomain make_top_machine_int_interval();
 MachineIntAbstractDomain make_top_machine_int_congruence();
 MachineIntAbstractDomain make_top_machine_int_interval_congruence();
 MachineIntAbstractDomain make_top_machine_int_dbm();
+MachineIntAbstractDomain make_top_machine_int_sparse_dbm();
+MachineIntAbstractDomain make_top_machine_int_native_dbm();
+MachineIntAbstractDomain make_top_machine_int_octagon();
 MachineIntAbstractDomain make_top_machine_int_var_pack_dbm();
 MachineIntAbstractDomain make_top_machine_int_var_pack_dbm_congruence();
 MachineIntAbstractDomain make_top_machine_int_gauge();
@@ -98,6 +127,12 @@ inline MachineIntAbstractDomain make_top_machine_int_domain(
       return make_top_machine_int_interval_congruence();
     case MachineIntDomainOption::DBM:
       return make_top_machine_int_dbm();
+    case MachineIntDomainOption::SparseDBM:
+      return make_top_machine_int_sparse_dbm();
+    case MachineIntDomainOption::NativeDBM:
+      return make_top_machine_int_native_dbm();
+    case MachineIntDomainOption::Octagon:
+      return make_top_machine_int_octagon();
     case MachineIntDomainOption::VarPackDBM:
       return make_top_machine_int_var_pack_dbm();
     case MachineIntDomainOption::VarPackDBMCongruence:
@@ -136,6 +171,33 @@ inline MachineIntAbstractDomain make_top_machine_int_domain(
   }
 }
 
+/// \brief Call `f` with the top machine integer abstract value of the given
+/// choice
+///
+/// The specialized domains are passed with their own type, so that `f` is
+/// instantiated on them. Other domains are passed as a
+/// MachineIntAbstractDomain.
+template < typename Function >
+void dispatch_machine_int_domain(MachineIntDomainOption d, Function&& f) {
+  switch (d) {
+    case MachineIntDomainOption::Interval: {
+      f(IntervalMachineIntDomain::top());
+    } break;
+    case MachineIntDomainOption::IntervalCongruence: {
+      f(IntervalCongruenceMachineIntDomain::top());
+    } break;
+    case MachineIntDomainOption::DBM: {
+      f(DBMMachineIntDomain::top());
+    } break;
+    case MachineIntDomainOption::VarPackDBM: {
+      f(VarPackDBMMachineIntDomain::top());
+    } break;
+    default: {
+      f(make_top_machine_int_domain(d));
+    } break;
+  }
+}
+
 } // end namespace value
 } // end namespace analyzer
 } // end namespace ikos
@@ -46,9 +46,12 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 
+#include <boost/optional.hpp>
+
 #include <llvm/ADT/DenseMap.h>
 #include <llvm/ADT/StringMap.h>
 #include <llvm/ADT/StringRef.h>
@@ -58,6 +61,7 @@
 #include <ikos/core/semantic/machine_int/variable.hpp>
 #include <ikos/core/semantic/memory/cell.hpp>
 #include <ikos/core/semantic/memory/variable.hpp>
+#include <ikos/core/semantic/packable.hpp>
 #include <ikos/core/semantic/pointer/variable.hpp>
 #include <ikos/core/semantic/variable.hpp>
 
@@ -88,6 +92,8 @@ namespace analyzer {
 ///   see ikos/core/semantic/memory/cell.hpp
 /// It must implement memory::VariableTraits,
 ///   see ikos/core/semantic/memory/variable.hpp
+/// It must implement PackableTraits,
+///   see ikos/core/semantic/packable.hpp
 ///
 /// Variable has a 'kind', which is the type of variable it represents.
 /// The 'kind' is an element of VariableKind.
@@ -125,6 +131,12 @@ protected:
   /// \brief The offset variable, or nullptr if it is not a pointer
   std::unique_ptr< Variable > _offset_var;
 
+  /// \brief Unique index, assigned by the VariableFactory
+  core::Index _index;
+
+  /// \brief Syntactic pack, assigned by the VariablePackingAnalysis
+  boost::optional< core::PackId > _pack;
+
 protected:
   /// \brief Protected constructor
   Variable(VariableKind kind, ar::Type* type);
@@ -151,9 +163,23 @@ public:
   /// \brief Return the type of the variable
   ar::Type* type() const { return this->_type; }
 
+  /// \brief Return the unique index of the variable
+  ///
+  /// Indexes are dense and sequential, in order of creation. With several
+  /// jobs (-j), variables are created concurrently, so indexes and the
+  /// iteration order of the abstract domains might change between runs. Use a
+  /// single job for reproducible indexes.
+  core::Index index() const { return this->_index; }
+
   /// \brief Return the offset variable, or nullptr if it is not a pointer
   Variable* offset_var() const { return this->_offset_var.get(); }
 
+  /// \brief Return the syntactic pack of the variable, or boost::none
+  const boost::optional< core::PackId >& pack() const { return this->_pack; }
+
+  /// \brief Set the syntactic pack of the variable
+  void set_pack(core::PackId pack) { this->_pack = pack; }
+
   /// \brief Set the offset variable
   void set_offset_var(std::unique_ptr< Variable > offset_var) {
     this->_offset_var = std::move(offset_var);
@@ -162,6 +188,8 @@ public:
   /// \brief Dump the variable, for debugging purpose
   virtual void dump(std::ostream&) const = 0;
 
+  friend class VariableFactory;
+
 }; // end class Variable
 
 /// \brief Local variable
@@ -497,6 +525,12 @@ private:
   std::vector< std::unique_ptr< UnnamedShadowVariable > >
       _unnamed_shadow_variable_vec;
 
+  /// \brief Index of the next created variable
+  core::Index _next_index = 0;
+
+  /// \brief Mutex protecting the factory, for parallel analyses
+  std::recursive_mutex _mutex;
+
 public:
   /// \brief Constructor
   explicit VariableFactory(ar::Bundle* bundle);
@@ -516,6 +550,11 @@ public:
   /// \brief Destructor
   ~VariableFactory();
 
+private:
+  /// \brief Assign the next indexes to the given variable and its offset
+  /// variable, if any
+  void assign_index(Variable* vn);
+
 public:
   /// \brief Get or Create a LocalVariable
   LocalVariable* get_local(ar::LocalVariable* var);
@@ -562,12 +601,10 @@ namespace core {
 
 /// \brief Implement IndexableTraits for Variable*
 ///
-/// The index of Variable* is the address of the pointer.
+/// The index of Variable* is the sequential index given by the factory.
 template <>
 struct IndexableTraits< analyzer::Variable* > {
-  static Index index(const analyzer::Variable* v) {
-    return reinterpret_cast< Index >(v);
-  }
+  static Index index(const analyzer::Variable* v) { return v->index(); }
 };
 
 /// \brief Implement DumpableTraits for Variable*
@@ -576,6 +613,16 @@ struct DumpableTraits< analyzer::Variable* > {
   static void dump(std::ostream& o, const analyzer::Variable* v) { v->dump(o); }
 };
 
+/// \brief Implement PackableTraits for Variable*
+///
+/// The pack of Variable* is computed by the VariablePackingAnalysis.
+template <>
+struct PackableTraits< analyzer::Variable* > {
+  static boost::optional< PackId > pack(const analyzer::Variable* v) {
+    return v->pack();
+  }
+};
+
 namespace machine_int {
 
 /// \brief Implement machine_int::VariableTraits for Variable*
@@ -0,0 +1,125 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Syntactic variable packing analysis
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2011-2018 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <iosfwd>
+#include <vector>
+
+#include <llvm/ADT/DenseMap.h>
+
+#include <ikos/analyzer/analysis/context.hpp>
+#include <ikos/analyzer/analysis/variable.hpp>
+
+namespace ikos {
+namespace analyzer {
+
+/// \brief Compute syntactic packs of variables for a whole bundle
+///
+/// Two variables are in the same pack if a statement relates them: an
+/// assignment, an integer cast, an addition, a subtraction, a comparison or a
+/// pointer shift (result and base pointer only). A direct call relates the
+/// actual parameters with the formal parameters of the callee, and the result
+/// with the returned value, hence packs can span several functions. For
+/// pointers, the offset variables are packed. Packs have at most MaxPackSize
+/// variables:
+/// a relation that would create a larger pack is ignored, so that a chained
+/// computation does not end up in one pack.
+///
+/// The pack of each internal and local variable is stored in the Variable
+/// (see Variable::pack()), and used by the abstract domains with variable
+/// packing. Global variables, memory cells and shadow variables have no pack,
+/// thus they can be related to any other variable.
+class VariablePackingAnalysis {
+public:
+  /// \brief List of variables
+  using VariableRefList = std::vector< Variable* >;
+
+  /// \brief List of packs
+  using PackList = std::vector< VariableRefList >;
+
+  /// \brief Maximum number of variables in a pack
+  static constexpr std::size_t MaxPackSize = 16;
+
+private:
+  /// \brief Map from code to the list of packs
+  using PackMap = llvm::DenseMap< ar::Code*, PackList >;
+
+private:
+  /// \brief Analysis context
+  Context& _ctx;
+
+  /// \brief List of packs of each function body, restricted to the variables
+  /// of the function
+  PackMap _packs_map;
+
+public:
+  /// \brief Constructor
+  explicit VariablePackingAnalysis(Context& ctx);
+
+  /// \brief Deleted copy constructor
+  VariablePackingAnalysis(const VariablePackingAnalysis&) = delete;
+
+  /// \brief Deleted move constructor
+  VariablePackingAnalysis(VariablePackingAnalysis&&) = delete;
+
+  /// \brief Deleted copy assignment operator
+  VariablePackingAnalysis& operator=(const VariablePackingAnalysis&) = delete;
+
+  /// \brief Deleted move assignment operator
+  VariablePackingAnalysis& operator=(VariablePackingAnalysis&&) = delete;
+
+  /// \brief Destructor
+  ~VariablePackingAnalysis();
+
+  /// \brief Run the analysis
+  void run();
+
+  /// \brief Dump the packs, for debugging purpose
+  void dump(std::ostream& o) const;
+
+}; // end class VariablePackingAnalysis
+
+} // end namespace analyzer
+} // end namespace ikos
@@ -0,0 +1,100 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Cache of weak topological orders
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2011-2018 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+
+#include <llvm/ADT/DenseMap.h>
+
+#include <ikos/core/fixpoint/wto.hpp>
+
+#include <ikos/ar/semantic/code.hpp>
+
+namespace ikos {
+namespace analyzer {
+
+/// \brief Cache of weak topological orders
+///
+/// The weak topological order of an ar::Code only depends on its control flow
+/// graph. The cache computes it once per ar::Code, and fixpoint iterators share
+/// it (see core::InterleavedFwdFixpointIterator).
+///
+/// The cache is thread-safe.
+class WtoCache {
+public:
+  using CodeWto = core::Wto< ar::Code* >;
+
+private:
+  llvm::DenseMap< ar::Code*, std::unique_ptr< const CodeWto > > _map;
+
+  /// \brief Mutex protecting the cache, for parallel analyses
+  std::mutex _mutex;
+
+public:
+  /// \brief Constructor
+  WtoCache();
+
+  /// \brief Deleted copy constructor
+  WtoCache(const WtoCache&) = delete;
+
+  /// \brief Deleted move constructor
+  WtoCache(WtoCache&&) = delete;
+
+  /// \brief Deleted copy assignment operator
+  WtoCache& operator=(const WtoCache&) = delete;
+
+  /// \brief Deleted move assignment operator
+  WtoCache& operator=(WtoCache&&) = delete;
+
+  /// \brief Destructor
+  ~WtoCache();
+
+  /// \brief Get the weak topological order of the given code
+  const CodeWto& get(ar::Code* code);
+
+}; // end class WtoCache
+
+} // end namespace analyzer
+} // end namespace ikos
@@ -43,14 +43,19 @@
 
 #pragma once
 
+#include <ikos/analyzer/analysis/literal.hpp>
 #include <ikos/analyzer/checker/checker.hpp>
+#include <ikos/analyzer/support/cast.hpp>
+#include <ikos/analyzer/util/log.hpp>
 
 namespace ikos {
 namespace analyzer {
 
 /// \brief Assertion prover checker
-class AssertProverChecker final : public Checker {
+template < typename AbstractDomain >
+class AssertProverChecker final : public Checker< AbstractDomain > {
 private:
+  using Checker< AbstractDomain >::out;
   using IntInterval = core::machine_int::Interval;
   using PointsToSet = core::PointsToSet< MemoryLocation* >;
   using Nullity = core::Nullity;
@@ -68,7 +73,7 @@ public:
 
   /// \brief Check a statement
   void check(ar::Statement* stmt,
-             const value::AbstractDomain& inv,
+             const AbstractDomain& inv,
              CallContext* call_context) override;
 
 private:
@@ -80,15 +85,15 @@ private:
 
   /// \brief Check an assert call
   CheckResult check_assert(ar::IntrinsicCall* call,
-                           const value::AbstractDomain& inv);
+                           const AbstractDomain& inv);
 
   /// \brief Execute an __ikos_print_invariant call
   void exec_print_invariant(ar::IntrinsicCall* call,
-                            const value::AbstractDomain& inv);
+                            const AbstractDomain& inv);
 
   /// \brief Execute an __ikos_print_values call
   void exec_print_values(ar::IntrinsicCall* call,
-                         const value::AbstractDomain& inv);
+                         const AbstractDomain& inv);
 
 private:
   /// \brief Dispay the check for the given assert(), if requested
@@ -96,5 +101,202 @@ private:
 
 }; // end class AssertProverChecker
 
+template < typename AbstractDomain >
+AssertProverChecker< AbstractDomain >::AssertProverChecker(Context& ctx)
+    : Checker< AbstractDomain >(ctx) {}
+
+template < typename AbstractDomain >
+CheckerName AssertProverChecker< AbstractDomain >::name() const {
+  return CheckerName::AssertProver;
+}
+
+template < typename AbstractDomain >
+const char* AssertProverChecker< AbstractDomain >::description() const {
+  return "Assertion prover checker";
+}
+
+template < typename AbstractDomain >
+void AssertProverChecker< AbstractDomain >::check(ar::Statement* stmt,
+                                                  const AbstractDomain& inv,
+                                                  CallContext* call_context) {
+  if (auto call = dyn_cast< ar::IntrinsicCall >(stmt)) {
+    ar::Function* fun = call->called_function();
+
+    switch (fun->intrinsic_id()) {
+      case ar::Intrinsic::IkosAssert: {
+        CheckResult check = this->check_assert(call, inv);
+        this->display_invariant(check.result, call, inv);
+        this->_checks.insert(check.kind,
+                             CheckerName::AssertProver,
+                             check.result,
+                             stmt,
+                             call_context,
+                             std::array< ar::Value*, 1 >{{call->argument(0)}});
+      } break;
+      case ar::Intrinsic::IkosPrintInvariant: {
+        this->exec_print_invariant(call, inv);
+      } break;
+      case ar::Intrinsic::IkosPrintValues: {
+        this->exec_print_values(call, inv);
+      } break;
+      default: { break; }
+    }
+  }
+}
+
+template < typename AbstractDomain >
+typename AssertProverChecker< AbstractDomain >::CheckResult
+AssertProverChecker< AbstractDomain >::check_assert(ar::IntrinsicCall* call,
+                                                    const AbstractDomain& inv) {
+  if (inv.is_normal_flow_bottom()) {
+    // Statement unreachable
+    if (this->display_assert_check(Result::Unreachable, call)) {
+      out() << std::endl;
+    }
+    return {CheckKind::Unreachable, Result::Unreachable};
+  }
+
+  const ScalarLit& cond = this->_lit_factory.get_scalar(call->argument(0));
+
+  if (cond.is_undefined() ||
+      (cond.is_machine_int_var() &&
+       inv.normal().uninitialized().is_uninitialized(cond.var()))) {
+    // Undefined operand
+    if (this->display_assert_check(Result::Error, call)) {
+      out() << ": undefined operand" << std::endl;
+    }
+    return {CheckKind::UninitializedVariable, Result::Error};
+  }
+
+  IntInterval flag;
+  if (cond.is_machine_int()) {
+    flag = IntInterval(cond.machine_int());
+  } else if (cond.is_machine_int_var()) {
+    flag = inv.normal().integers().to_interval(cond.var());
+  } else {
+    log::error("unexpected parameter to __ikos_assert()");
+    return {CheckKind::UnexpectedOperand, Result::Error};
+  }
+
+  boost::optional< MachineInt > v = flag.singleton();
+
+  if (v && (*v).is_zero()) {
+    // The condition is definitely 0
+    if (this->display_assert_check(Result::Error, call)) {
+      out() << ": ∀x ∈ " << cond << ", x == 0" << std::endl;
+    }
+    return {CheckKind::Assert, Result::Error};
+  } else if (flag.contains(MachineInt(0, flag.bit_width(), flag.sign()))) {
+    // The condition may be 0
+    if (this->display_assert_check(Result::Warning, call)) {
+      out() << ": (∃x ∈ " << cond << ", x == 0) and (∃x ∈ " << cond
+            << ", x != 0)" << std::endl;
+    }
+    return {CheckKind::Assert, Result::Warning};
+  } else {
+    // The condition cannot be 0
+    if (this->display_assert_check(Result::Ok, call)) {
+      out() << ": ∀x ∈ " << cond << ", x != 0" << std::endl;
+    }
+    return {CheckKind::Assert, Result::Ok};
+  }
+}
+
+template < typename AbstractDomain >
+void AssertProverChecker< AbstractDomain >::exec_print_invariant(
+    ar::IntrinsicCall* call, const AbstractDomain& inv) {
+  this->display_stmt_location(call);
+  out() << "__ikos_print_invariant():\n";
+  inv.dump(out());
+  out() << std::endl;
+}
+
+template < typename AbstractDomain >
+void AssertProverChecker< AbstractDomain >::exec_print_values(
+    ar::IntrinsicCall* call, const AbstractDomain& inv) {
+  this->display_stmt_location(call);
+  out() << "__ikos_print_values(";
+  for (auto it = call->arg_begin(), et = call->arg_end(); it != et;) {
+    (*it)->dump(out());
+    ++it;
+    if (it != et) {
+      out() << ", ";
+    }
+  }
+  out() << "):\n";
+
+  if (inv.is_normal_flow_bottom()) {
+    out() << "Invariant: ";
+    inv.dump(out());
+    out() << std::endl;
+  } else {
+    for (auto it = call->arg_begin(), et = call->arg_end(); it != et; ++it) {
+      const ScalarLit& v = this->_lit_factory.get_scalar(*it);
+
+      if (v.is_machine_int_var()) {
+        out() << "\t";
+        v.var()->dump(out());
+        out() << " -> " << inv.normal().integers().to_interval(v.var()) << "\n";
+      } else if (v.is_floating_point_var()) {
+        // ignored for now
+      } else if (v.is_pointer_var()) {
+        // points-to
+        PointsToSet points_to = inv.normal().pointers().points_to(v.var());
+        out() << "\t";
+        v.var()->dump(out());
+        out() << " -> ";
+        points_to.dump(out());
+        out() << std::endl;
+
+        // offset
+        Variable* offset_var = inv.normal().pointers().offset_var(v.var());
+        out() << "\t";
+        offset_var->dump(out());
+        out() << " -> " << inv.normal().integers().to_interval(offset_var)
+              << "\n";
+
+        // nullity
+        Nullity nullity_val = inv.normal().nullity().get(v.var());
+        out() << "\t";
+        v.var()->dump(out());
+        if (nullity_val.is_null()) {
+          out() << " is null\n";
+        } else if (nullity_val.is_non_null()) {
+          out() << " is non-null\n";
+        } else {
+          out() << " may be null\n";
+        }
+      } else {
+        log::error("__ikos_print_values() operand is not a variable");
+        continue;
+      }
+
+      // initialized (available for all variables)
+      Uninitialized uninit_val = inv.normal().uninitialized().get(v.var());
+      out() << "\t";
+      v.var()->dump(out());
+      if (uninit_val.is_uninitialized()) {
+        out() << " is uninitialized" << std::endl;
+      } else if (uninit_val.is_initialized()) {
+        out() << " is initialized" << std::endl;
+      } else {
+        out() << " may be uninitialized" << std::endl;
+      }
+    }
+  }
+}
+
+template < typename AbstractDomain >
+bool AssertProverChecker< AbstractDomain >::display_assert_check(
+    Result result, ar::IntrinsicCall* call) const {
+  if (this->display_check(result, call)) {
+    out() << "__ikos_assert(";
+    call->argument(0)->dump(out());
+    out() << ")";
+    return true;
+  }
+  return false;
+}
+
 } // end namespace analyzer
 } // end namespace ikos
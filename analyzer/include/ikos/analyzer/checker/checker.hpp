@@ -43,8 +43,6 @@
 
 #pragma once
 
-#include <memory>
-
 #include <ikos/ar/semantic/statement.hpp>
 
 #include <ikos/analyzer/analysis/call_context.hpp>
@@ -53,11 +51,14 @@
 #include <ikos/analyzer/analysis/value/abstract_domain.hpp>
 #include <ikos/analyzer/checker/name.hpp>
 #include <ikos/analyzer/database/output.hpp>
+#include <ikos/analyzer/util/color.hpp>
+#include <ikos/analyzer/util/source_location.hpp>
 
 namespace ikos {
 namespace analyzer {
 
 /// \brief Base class for property checkers
+template < typename AbstractDomain >
 class Checker {
 protected:
   /// \brief Analysis context
@@ -120,17 +121,17 @@ public:
 
   /// \brief Start the checks for the given basic block
   virtual void enter(ar::BasicBlock*,
-                     const value::AbstractDomain&,
+                     const AbstractDomain&,
                      CallContext*) {}
 
   /// \brief End the checks for the given basic block
   virtual void leave(ar::BasicBlock*,
-                     const value::AbstractDomain&,
+                     const AbstractDomain&,
                      CallContext*) {}
 
   /// \brief Check a statement
   virtual void check(ar::Statement* stmt,
-                     const value::AbstractDomain& inv,
+                     const AbstractDomain& inv,
                      CallContext* call_context) = 0;
 
 protected:
@@ -152,7 +153,7 @@ protected:
   /// \return true if the invariant should be displayed
   inline bool display_invariant(Result result,
                                 ar::Statement* stmt,
-                                const value::AbstractDomain& inv) const {
+                                const AbstractDomain& inv) const {
     if (this->display_invariant(result)) {
       this->display_stmt_location(stmt);
       out() << "Invariant:\n";
@@ -184,15 +185,33 @@ protected:
   }
 
   /// \brief Display a statement location
-  void display_stmt_location(ar::Statement* s) const;
+  void display_stmt_location(ar::Statement* s) const {
+    out() << color::bold() << source_location_string(s, this->_ctx.wd) << ": "
+          << color::off();
+  }
 
   /// \brief Display a check result
-  void display_result(Result result) const;
+  void display_result(Result result) const {
+    switch (result) {
+      case Result::Ok: {
+        out() << "[" << color::bold_green() << "ok" << color::off() << "] ";
+      } break;
+      case Result::Warning: {
+        out() << "[" << color::bold_yellow() << "warning" << color::off()
+              << "] ";
+      } break;
+      case Result::Error: {
+        out() << "[" << color::bold_red() << "error" << color::off() << "] ";
+      } break;
+      case Result::Unreachable: {
+        out() << "[" << color::bold_magenta() << "unreachable" << color::off()
+              << "] ";
+      } break;
+      default: { ikos_unreachable("unreachable"); }
+    }
+  }
 
 }; // end class Checker
 
-/// \brief Create a checker, given its name
-std::unique_ptr< Checker > make_checker(Context& ctx, CheckerName name);
-
 } // end namespace analyzer
 } // end namespace ikos
@@ -43,14 +43,20 @@
 
 #pragma once
 
+#include <llvm/IR/Instructions.h>
+
 #include <ikos/analyzer/checker/checker.hpp>
+#include <ikos/analyzer/support/cast.hpp>
 
 namespace ikos {
 namespace analyzer {
 
 /// \brief Dead code checker
-class DeadCodeChecker final : public Checker {
+template < typename AbstractDomain >
+class DeadCodeChecker final : public Checker< AbstractDomain > {
 private:
+  using Checker< AbstractDomain >::out;
+
   /// \brief Previous statement in the basic block
   ar::Statement* _prev_stmt = nullptr;
 
@@ -66,12 +72,12 @@ public:
 
   /// \brief Start the checks for the given basic block
   void enter(ar::BasicBlock* bb,
-             const value::AbstractDomain& inv,
+             const AbstractDomain& inv,
              CallContext* call_context) override;
 
   /// \brief Check a statement
   void check(ar::Statement* stmt,
-             const value::AbstractDomain& inv,
+             const AbstractDomain& inv,
              CallContext* call_context) override;
 
 private:
@@ -87,5 +93,123 @@ private:
 
 }; // end class DeadCodeChecker
 
+template < typename AbstractDomain >
+DeadCodeChecker< AbstractDomain >::DeadCodeChecker(Context& ctx)
+    : Checker< AbstractDomain >(ctx) {}
+
+template < typename AbstractDomain >
+CheckerName DeadCodeChecker< AbstractDomain >::name() const {
+  return CheckerName::DeadCode;
+}
+
+template < typename AbstractDomain >
+const char* DeadCodeChecker< AbstractDomain >::description() const {
+  return "Dead code checker";
+}
+
+template < typename AbstractDomain >
+void DeadCodeChecker< AbstractDomain >::enter(ar::BasicBlock* /*bb*/,
+                                              const AbstractDomain& /*inv*/,
+                                              CallContext* /*call_context*/) {
+  this->_prev_stmt = nullptr;
+}
+
+template < typename AbstractDomain >
+void DeadCodeChecker< AbstractDomain >::check(ar::Statement* stmt,
+                                              const AbstractDomain& inv,
+                                              CallContext* call_context) {
+  if (skip_check(stmt)) {
+    return;
+  }
+
+  // Update _prev_stmt
+  ar::Statement* prev_stmt = this->_prev_stmt;
+  this->_prev_stmt = stmt;
+
+  // Check if the current statement needs a check
+  if (!needs_check(prev_stmt, stmt->parent())) {
+    return;
+  }
+
+  Result result =
+      inv.is_normal_flow_bottom() ? Result::Unreachable : Result::Ok;
+  this->display_dead_code_check(result, stmt);
+  this->display_invariant(result, stmt, inv);
+  this->_checks.insert(CheckKind::Unreachable,
+                       CheckerName::DeadCode,
+                       result,
+                       stmt,
+                       call_context);
+}
+
+template < typename AbstractDomain >
+bool DeadCodeChecker< AbstractDomain >::skip_check(ar::Statement* stmt) {
+  if (!stmt->has_frontend()) {
+    // No checks on statements without debug info
+    return true;
+  }
+
+  if (ar::isa< ar::Assignment >(stmt) || ar::isa< ar::UnaryOperation >(stmt)) {
+    auto value = stmt->frontend< llvm::Value >();
+
+    if (llvm::isa< llvm::PHINode >(value) ||
+        llvm::isa< llvm::CmpInst >(value)) {
+      // No checks on assignments for phi nodes and comparisons
+      return true;
+    }
+  }
+
+  return false;
+}
+
+template < typename AbstractDomain >
+bool DeadCodeChecker< AbstractDomain >::needs_check(ar::Statement* prev_stmt,
+                                                    ar::BasicBlock* bb) {
+  if (prev_stmt != nullptr) {
+    return isa< ar::Comparison >(prev_stmt) || isa< ar::CallBase >(prev_stmt);
+  }
+
+  // First statement of the basic block, look for predecessors
+  std::vector< ar::BasicBlock* > preds{bb->predecessor_begin(),
+                                       bb->predecessor_end()};
+
+  while (!preds.empty()) {
+    ar::BasicBlock* pred = preds.back();
+    preds.pop_back();
+
+    auto it = pred->rbegin(), et = pred->rend();
+
+    // Skip statements without debug info, as well as assignments
+    while (it != et && skip_check(*it)) {
+      ++it;
+    }
+
+    if (it == et) {
+      // Predecessor is empty, look further up
+      preds.insert(preds.end(),
+                   pred->predecessor_begin(),
+                   pred->predecessor_end());
+      continue;
+    }
+
+    ar::Statement* last_stmt = *it;
+    if (isa< ar::Comparison >(last_stmt) || isa< ar::CallBase >(last_stmt)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+template < typename AbstractDomain >
+void DeadCodeChecker< AbstractDomain >::display_dead_code_check(
+    Result result, ar::Statement* stmt) const {
+  if (this->display_check(result, stmt)) {
+    out() << "check_dead_code(";
+    stmt->dump(out());
+    out() << ")" << std::endl;
+  }
+}
+
 } // end namespace analyzer
 } // end namespace ikos
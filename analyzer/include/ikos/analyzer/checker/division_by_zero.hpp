@@ -43,14 +43,20 @@
 
 #pragma once
 
+#include <ikos/analyzer/analysis/literal.hpp>
 #include <ikos/analyzer/checker/checker.hpp>
+#include <ikos/analyzer/json/helper.hpp>
+#include <ikos/analyzer/support/cast.hpp>
+#include <ikos/analyzer/util/log.hpp>
 
 namespace ikos {
 namespace analyzer {
 
 /// \brief Division by zero checker
-class DivisionByZeroChecker final : public Checker {
+template < typename AbstractDomain >
+class DivisionByZeroChecker final : public Checker< AbstractDomain > {
 private:
+  using Checker< AbstractDomain >::out;
   using IntInterval = core::machine_int::Interval;
 
 public:
@@ -65,7 +71,7 @@ public:
 
   /// \brief Check a statement
   void check(ar::Statement* stmt,
-             const value::AbstractDomain& inv,
+             const AbstractDomain& inv,
              CallContext* call_context) override;
 
 private:
@@ -78,7 +84,7 @@ private:
 
   /// \brief Check a division
   CheckResult check_division(ar::BinaryOperation* stmt,
-                             const value::AbstractDomain& inv);
+                             const AbstractDomain& inv);
 
 private:
   /// \brief Dispay the check for the given division, if requested
@@ -86,5 +92,111 @@ private:
 
 }; // end class DivisionByZeroChecker
 
+template < typename AbstractDomain >
+DivisionByZeroChecker< AbstractDomain >::DivisionByZeroChecker(Context& ctx)
+    : Checker< AbstractDomain >(ctx) {}
+
+template < typename AbstractDomain >
+CheckerName DivisionByZeroChecker< AbstractDomain >::name() const {
+  return CheckerName::DivisionByZero;
+}
+
+template < typename AbstractDomain >
+const char* DivisionByZeroChecker< AbstractDomain >::description() const {
+  return "Division by zero checker";
+}
+
+template < typename AbstractDomain >
+void DivisionByZeroChecker< AbstractDomain >::check(ar::Statement* stmt,
+                                                    const AbstractDomain& inv,
+                                                    CallContext* call_context) {
+  if (auto bin = dyn_cast< ar::BinaryOperation >(stmt)) {
+    if (bin->op() == ar::BinaryOperation::UDiv ||
+        bin->op() == ar::BinaryOperation::SDiv ||
+        bin->op() == ar::BinaryOperation::URem ||
+        bin->op() == ar::BinaryOperation::SRem) {
+      CheckResult check = this->check_division(bin, inv);
+      this->display_invariant(check.result, stmt, inv);
+      this->_checks.insert(check.kind,
+                           CheckerName::DivisionByZero,
+                           check.result,
+                           stmt,
+                           call_context,
+                           std::array< ar::Value*, 1 >{{bin->right()}},
+                           check.info);
+    }
+  }
+}
+
+template < typename AbstractDomain >
+typename DivisionByZeroChecker< AbstractDomain >::CheckResult
+DivisionByZeroChecker< AbstractDomain >::check_division(
+    ar::BinaryOperation* stmt, const AbstractDomain& inv) {
+  if (inv.is_normal_flow_bottom()) {
+    // Statement unreachable
+    if (this->display_division_check(Result::Unreachable, stmt)) {
+      out() << std::endl;
+    }
+    return {CheckKind::Unreachable, Result::Unreachable, {}};
+  }
+
+  const ScalarLit& lit = this->_lit_factory.get_scalar(stmt->right());
+
+  if (lit.is_undefined() ||
+      (lit.is_machine_int_var() &&
+       inv.normal().uninitialized().is_uninitialized(lit.var()))) {
+    // Undefined operand
+    if (this->display_division_check(Result::Error, stmt)) {
+      out() << ": undefined operand" << std::endl;
+    }
+    return {CheckKind::UninitializedVariable, Result::Error, {}};
+  }
+
+  IntInterval divisor;
+  if (lit.is_machine_int()) {
+    divisor = IntInterval(lit.machine_int());
+  } else if (lit.is_machine_int_var()) {
+    divisor = inv.normal().integers().to_interval(lit.var());
+  } else {
+    log::error("unexpected operand to ar::BinaryOperation");
+    return {CheckKind::UnexpectedOperand, Result::Error, {}};
+  }
+
+  boost::optional< MachineInt > d = divisor.singleton();
+
+  if (d && (*d).is_zero()) {
+    // The second operand is definitely 0
+    if (this->display_division_check(Result::Error, stmt)) {
+      out() << ": ∀d ∈ divisor, d == 0" << std::endl;
+    }
+    return {CheckKind::DivisionByZero, Result::Error, {}};
+  } else if (divisor.contains(
+                 MachineInt(0, divisor.bit_width(), divisor.sign()))) {
+    // The second operand may be 0
+    if (this->display_division_check(Result::Warning, stmt)) {
+      out() << ": ∃d ∈ divisor, d == 0" << std::endl;
+    }
+    return {CheckKind::DivisionByZero, Result::Warning, to_json(divisor)};
+  } else {
+    // The second operand cannot be definitely 0
+    if (this->display_division_check(Result::Ok, stmt)) {
+      out() << ": ∀d ∈ divisor, d != 0" << std::endl;
+    }
+    return {CheckKind::DivisionByZero, Result::Ok, {}};
+  }
+}
+
+template < typename AbstractDomain >
+bool DivisionByZeroChecker< AbstractDomain >::display_division_check(
+    Result result, ar::BinaryOperation* stmt) const {
+  if (this->display_check(result, stmt)) {
+    out() << "check_dbz(";
+    stmt->dump(out());
+    out() << ")";
+    return true;
+  }
+  return false;
+}
+
 } // end namespace analyzer
 } // end namespace ikos
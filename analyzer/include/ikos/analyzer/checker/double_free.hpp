@@ -46,13 +46,16 @@
 #include <llvm/ADT/SmallVector.h>
 
 #include <ikos/analyzer/checker/checker.hpp>
+#include <ikos/analyzer/support/cast.hpp>
 
 namespace ikos {
 namespace analyzer {
 
 /// \brief Double free checker
-class DoubleFreeChecker final : public Checker {
+template < typename AbstractDomain >
+class DoubleFreeChecker final : public Checker< AbstractDomain > {
 private:
+  using Checker< AbstractDomain >::out;
   using PointsToSet = core::PointsToSet< MemoryLocation* >;
 
 public:
@@ -67,7 +70,7 @@ public:
 
   /// \brief Check a statement
   void check(ar::Statement* stmt,
-             const value::AbstractDomain& inv,
+             const AbstractDomain& inv,
              CallContext* call_context) override;
 
 private:
@@ -81,11 +84,11 @@ private:
 
   /// \brief Check for a double free call
   CheckResult check_double_free(ar::IntrinsicCall* stmt,
-                                const value::AbstractDomain& inv);
+                                const AbstractDomain& inv);
 
   /// \brief Check for a double free call on a memory location
   Result check_memory_location_free(ar::IntrinsicCall* stmt,
-                                    const value::AbstractDomain& inv,
+                                    const AbstractDomain& inv,
                                     MemoryLocation* addr);
 
   /// \brief Display the double free check, if requested
@@ -98,5 +101,187 @@ private:
 
 }; // end class DoubleFreeChecker
 
+template < typename AbstractDomain >
+DoubleFreeChecker< AbstractDomain >::DoubleFreeChecker(Context& ctx)
+    : Checker< AbstractDomain >(ctx) {}
+
+template < typename AbstractDomain >
+CheckerName DoubleFreeChecker< AbstractDomain >::name() const {
+  return CheckerName::DoubleFree;
+}
+
+template < typename AbstractDomain >
+const char* DoubleFreeChecker< AbstractDomain >::description() const {
+  return "Double free checker";
+}
+
+template < typename AbstractDomain >
+void DoubleFreeChecker< AbstractDomain >::check(ar::Statement* stmt,
+                                                const AbstractDomain& inv,
+                                                CallContext* call_context) {
+  if (auto call = dyn_cast< ar::IntrinsicCall >(stmt)) {
+    if (call->intrinsic_id() == ar::Intrinsic::LibcFree ||
+        call->intrinsic_id() == ar::Intrinsic::LibcppDelete ||
+        call->intrinsic_id() == ar::Intrinsic::LibcppDeleteArray ||
+        call->intrinsic_id() == ar::Intrinsic::LibcppFreeException) {
+      CheckResult check = this->check_double_free(call, inv);
+      this->display_invariant(check.result, stmt, inv);
+      this->_checks.insert(check.kind,
+                           CheckerName::DoubleFree,
+                           check.result,
+                           stmt,
+                           call_context,
+                           check.operands,
+                           check.info);
+    }
+  }
+}
+
+template < typename AbstractDomain >
+typename DoubleFreeChecker< AbstractDomain >::CheckResult
+DoubleFreeChecker< AbstractDomain >::check_double_free(
+    ar::IntrinsicCall* stmt, const AbstractDomain& inv) {
+  if (inv.is_normal_flow_bottom()) {
+    // Statement unreachable
+    if (this->display_double_free_check(Result::Unreachable, stmt)) {
+      out() << std::endl;
+    }
+    return {CheckKind::Unreachable, Result::Unreachable, {}, {}};
+  }
+
+  ikos_assert(stmt->num_arguments() == 1);
+
+  const auto operand = stmt->argument(0);
+  const ScalarLit& ptr = this->_lit_factory.get_scalar(operand);
+
+  if (ptr.is_undefined() ||
+      (ptr.is_pointer_var() &&
+       inv.normal().uninitialized().is_uninitialized(ptr.var()))) {
+    if (this->display_double_free_check(Result::Error, stmt)) {
+      out() << ": undefined operand" << std::endl;
+    }
+    return {CheckKind::UninitializedVariable, Result::Error, {operand}, {}};
+  }
+
+  if (ptr.is_null() ||
+      (ptr.is_pointer_var() && inv.normal().nullity().is_null(ptr.var()))) {
+    if (this->display_double_free_check(Result::Ok, stmt)) {
+      out() << ": safe call to free with NULL value" << std::endl;
+    }
+    return {CheckKind::Free, Result::Ok, {operand}, {}};
+  }
+
+  PointsToSet addrs = inv.normal().pointers().points_to(ptr.var());
+
+  if (addrs.is_empty()) {
+    if (this->display_double_free_check(Result::Error, stmt)) {
+      out() << ": empty points-to set for pointer";
+    }
+    return {CheckKind::InvalidPointerDereference, Result::Error, {operand}, {}};
+  } else if (addrs.is_top()) {
+    if (this->display_double_free_check(Result::Warning, stmt)) {
+      out() << ": no points-to information for pointer" << std::endl;
+    }
+    return {CheckKind::IgnoredFree, Result::Warning, {operand}, {}};
+  }
+
+  bool all_error = true;
+  bool all_ok = true;
+
+  JsonDict info;
+  JsonList points_to_info;
+
+  for (const auto& addr : addrs) {
+    JsonDict block_info = {
+        {"id", this->_ctx.output_db->memory_locations.insert(addr)}};
+    auto result = this->check_memory_location_free(stmt, inv, addr);
+    block_info.put("status", static_cast< int >(result));
+
+    if (result == Result::Ok) {
+      all_error = false;
+    } else if (result == Result::Warning) {
+      all_error = false;
+      all_ok = false;
+    } else {
+      all_ok = false;
+    }
+    points_to_info.add(block_info);
+  }
+
+  info.put("points_to", points_to_info);
+
+  if (all_error) {
+    // Unsafe
+    return {CheckKind::Free, Result::Error, {operand}, info};
+  } else if (all_ok) {
+    // Safe
+    return {CheckKind::Free, Result::Ok, {operand}, {}};
+  } else {
+    // Warning
+    return {CheckKind::Free, Result::Warning, {operand}, info};
+  }
+}
+
+template < typename AbstractDomain >
+Result DoubleFreeChecker< AbstractDomain >::check_memory_location_free(
+    ar::IntrinsicCall* stmt, const AbstractDomain& inv, MemoryLocation* addr) {
+  if (isa< DynAllocMemoryLocation >(addr)) {
+    auto lifetime = inv.normal().lifetime().get(addr);
+    if (lifetime.is_deallocated()) {
+      // This is a double free
+      if (this->display_double_free_check(Result::Error, stmt, addr)) {
+        out() << ": double free" << std::endl;
+      }
+      return Result::Error;
+    } else if (lifetime.is_top()) {
+      // A double free could be possible
+      if (this->display_double_free_check(Result::Warning, stmt, addr)) {
+        out() << ": possible double free" << std::endl;
+      }
+      return Result::Warning;
+    } else {
+      // Safe
+      if (this->display_double_free_check(Result::Ok, stmt, addr)) {
+        out() << ": safe call to free()" << std::endl;
+      }
+      return Result::Ok;
+    }
+  } else {
+    // This is a free() call on something which isn't a dynamic allocated
+    // memory.
+    // This is an error
+    if (this->display_double_free_check(Result::Error, stmt, addr)) {
+      out() << ": free() called on a non-dynamic allocated memory" << std::endl;
+    }
+    return Result::Error;
+  }
+}
+
+template < typename AbstractDomain >
+bool DoubleFreeChecker< AbstractDomain >::display_double_free_check(
+    Result result, ar::IntrinsicCall* stmt) const {
+  if (this->display_check(result, stmt)) {
+    out() << "check_dfa(";
+    stmt->dump(out());
+    out() << ")";
+    return true;
+  }
+  return false;
+}
+
+template < typename AbstractDomain >
+bool DoubleFreeChecker< AbstractDomain >::display_double_free_check(
+    Result result, ar::IntrinsicCall* stmt, MemoryLocation* addr) const {
+  if (this->display_check(result, stmt)) {
+    out() << "check_dfa(";
+    stmt->dump(out());
+    out() << ", addr=";
+    addr->dump(out());
+    out() << ")";
+    return true;
+  }
+  return false;
+}
+
 } // end namespace analyzer
 } // end namespace ikos
@@ -45,14 +45,20 @@
 
 #include <llvm/ADT/SmallVector.h>
 
+#include <ikos/ar/verify/type.hpp>
+
 #include <ikos/analyzer/checker/checker.hpp>
+#include <ikos/analyzer/support/cast.hpp>
+#include <ikos/analyzer/util/log.hpp>
 
 namespace ikos {
 namespace analyzer {
 
 /// \brief Function call checker
-class FunctionCallChecker final : public Checker {
+template < typename AbstractDomain >
+class FunctionCallChecker final : public Checker< AbstractDomain > {
 private:
+  using Checker< AbstractDomain >::out;
   using PointsToSet = core::PointsToSet< MemoryLocation* >;
 
 public:
@@ -79,7 +85,7 @@ public:
 
   /// \brief Check a statement
   void check(ar::Statement* stmt,
-             const value::AbstractDomain& inv,
+             const AbstractDomain& inv,
              CallContext* call_context) override;
 
 private:
@@ -92,12 +98,205 @@ private:
   };
 
   /// \brief Check a function call
-  CheckResult check_call(ar::CallBase* call, const value::AbstractDomain& inv);
+  CheckResult check_call(ar::CallBase* call, const AbstractDomain& inv);
 
   /// \brief Dispay a function call check, if requested
   bool display_call_check(Result result, ar::CallBase* call) const;
 
 }; // end class FunctionCallChecker
 
+template < typename AbstractDomain >
+FunctionCallChecker< AbstractDomain >::FunctionCallChecker(Context& ctx)
+    : Checker< AbstractDomain >(ctx) {}
+
+template < typename AbstractDomain >
+CheckerName FunctionCallChecker< AbstractDomain >::name() const {
+  return CheckerName::FunctionCall;
+}
+
+template < typename AbstractDomain >
+const char* FunctionCallChecker< AbstractDomain >::description() const {
+  return "Function call checker";
+}
+
+template < typename AbstractDomain >
+void FunctionCallChecker< AbstractDomain >::check(ar::Statement* stmt,
+                                                  const AbstractDomain& inv,
+                                                  CallContext* call_context) {
+  if (auto call = dyn_cast< ar::CallBase >(stmt)) {
+    CheckResult check = this->check_call(call, inv);
+    this->display_invariant(check.result, stmt, inv);
+    this->_checks.insert(check.kind,
+                         CheckerName::FunctionCall,
+                         check.result,
+                         stmt,
+                         call_context,
+                         check.operands,
+                         check.info);
+  }
+}
+
+template < typename AbstractDomain >
+typename FunctionCallChecker< AbstractDomain >::CheckResult
+FunctionCallChecker< AbstractDomain >::check_call(ar::CallBase* call,
+                                                  const AbstractDomain& inv) {
+  if (inv.is_normal_flow_bottom()) {
+    // Statement unreachable
+    if (this->display_call_check(Result::Unreachable, call)) {
+      out() << std::endl;
+    }
+    return {CheckKind::Unreachable, Result::Unreachable, {}, {}};
+  }
+
+  const ScalarLit& called = this->_lit_factory.get_scalar(call->called());
+
+  // Check uninitialized
+
+  if (called.is_undefined() ||
+      (called.is_pointer_var() &&
+       inv.normal().uninitialized().is_uninitialized(called.var()))) {
+    // Undefined call pointer operand
+    if (this->display_call_check(Result::Error, call)) {
+      out() << ": undefined call pointer operand" << std::endl;
+    }
+    return {CheckKind::UninitializedVariable,
+            Result::Error,
+            {call->called()},
+            {}};
+  }
+
+  // Check null pointer dereference
+
+  if (called.is_null() || (called.is_pointer_var() &&
+                           inv.normal().nullity().is_null(called.var()))) {
+    // Null call pointer operand
+    if (this->display_call_check(Result::Error, call)) {
+      out() << ": null call pointer operand" << std::endl;
+    }
+    return {CheckKind::NullPointerDereference,
+            Result::Error,
+            {call->called()},
+            {}};
+  }
+
+  // Collect potential callees
+  PointsToSet callees;
+
+  if (auto cst = dyn_cast< ar::FunctionPointerConstant >(call->called())) {
+    callees = {this->_ctx.mem_factory->get_function(cst->function())};
+  } else if (isa< ar::InlineAssemblyConstant >(call->called())) {
+    // call to inline assembly
+    if (this->display_call_check(Result::Ok, call)) {
+      out() << ": call to inline assembly" << std::endl;
+    }
+    return {CheckKind::FunctionCallInlineAssembly, Result::Ok, {}, {}};
+  } else if (auto gv = dyn_cast< ar::GlobalVariable >(call->called())) {
+    callees = {this->_ctx.mem_factory->get_global(gv)};
+  } else if (auto lv = dyn_cast< ar::LocalVariable >(call->called())) {
+    callees = {this->_ctx.mem_factory->get_local(lv)};
+  } else if (isa< ar::InternalVariable >(call->called())) {
+    // Indirect call through a function pointer
+    callees = inv.normal().pointers().points_to(called.var());
+  } else {
+    log::error("unexpected call pointer operand");
+    return {CheckKind::UnexpectedOperand, Result::Error, {call->called()}, {}};
+  }
+
+  // Check callees
+  ikos_assert(!callees.is_bottom());
+  if (callees.is_empty()) {
+    // Invalid pointer dereference
+    if (this->display_call_check(Result::Error, call)) {
+      out() << ": points-to set of function pointer is empty" << std::endl;
+    }
+    return {CheckKind::InvalidPointerDereference,
+            Result::Error,
+            {call->called()},
+            {}};
+  } else if (callees.is_top()) {
+    // No points-to set
+    if (this->display_call_check(Result::Warning, call)) {
+      out() << ": no points-to set for function pointer" << std::endl;
+    }
+    return {CheckKind::UnknownFunctionCallPointer,
+            Result::Warning,
+            {call->called()},
+            {}};
+  }
+
+  // Are all the callees valid/invalid
+  bool all_valid = true;
+  bool all_invalid = true;
+
+  JsonList points_to_info;
+
+  for (MemoryLocation* addr : callees) {
+    JsonDict block_info = {
+        {"id", this->_ctx.output_db->memory_locations.insert(addr)}};
+
+    if (!isa< FunctionMemoryLocation >(addr)) {
+      // Not a call to a function memory location, emit a warning
+      if (this->display_call_check(Result::Error, call)) {
+        out() << ": potential call to ";
+        addr->dump(out());
+        out() << ", which is not a function" << std::endl;
+      }
+
+      block_info.put("kind",
+                     static_cast< int >(FunctionCallCheckKind::NotFunction));
+      all_valid = false;
+    } else {
+      ar::Function* callee = cast< FunctionMemoryLocation >(addr)->function();
+      block_info.put("fun_id", this->_ctx.output_db->functions.insert(callee));
+
+      if (!ar::TypeVerifier::is_valid_call(call, callee->type())) {
+        // Ill-formed function call
+        // This could be because of an imprecision of the pointer analysis.
+        if (this->display_call_check(Result::Error, call)) {
+          out() << ": potential call to " << callee->name()
+                << ", wrong signature" << std::endl;
+        }
+
+        block_info.put("kind",
+                       static_cast< int >(
+                           FunctionCallCheckKind::WrongSignature));
+        all_valid = false;
+      } else {
+        if (this->display_call_check(Result::Ok, call)) {
+          out() << ": potential call to " << callee->name() << std::endl;
+        }
+
+        block_info.put("kind", static_cast< int >(FunctionCallCheckKind::Ok));
+        all_invalid = false;
+      }
+    }
+
+    points_to_info.add(block_info);
+  }
+
+  JsonDict info;
+  info.put("points_to", points_to_info);
+
+  if (all_invalid) {
+    return {CheckKind::FunctionCall, Result::Error, {call->called()}, info};
+  } else if (!all_valid) {
+    return {CheckKind::FunctionCall, Result::Warning, {call->called()}, info};
+  } else {
+    return {CheckKind::FunctionCall, Result::Ok, {call->called()}, info};
+  }
+}
+
+template < typename AbstractDomain >
+bool FunctionCallChecker< AbstractDomain >::display_call_check(
+    Result result, ar::CallBase* call) const {
+  if (this->display_check(result, call)) {
+    out() << "check_call(";
+    call->dump(out());
+    out() << ")";
+    return true;
+  }
+  return false;
+}
+
 } // end namespace analyzer
 } // end namespace ikos
@@ -45,14 +45,20 @@
 
 #include <llvm/ADT/SmallVector.h>
 
+#include <ikos/analyzer/analysis/literal.hpp>
 #include <ikos/analyzer/checker/checker.hpp>
+#include <ikos/analyzer/json/helper.hpp>
+#include <ikos/analyzer/support/cast.hpp>
+#include <ikos/analyzer/util/log.hpp>
 
 namespace ikos {
 namespace analyzer {
 
 /// \brief Base for integer overflow checker
-class IntOverflowCheckerBase : public Checker {
+template < typename AbstractDomain >
+class IntOverflowCheckerBase : public Checker< AbstractDomain > {
 private:
+  using Checker< AbstractDomain >::out;
   using IntInterval = core::machine_int::Interval;
   using ZInterval = core::numeric::Interval< ZNumber >;
   using ZBound = core::Bound< ZNumber >;
@@ -64,7 +70,7 @@ public:
 protected:
   /// \brief Check an integer overflow and insert the checks in the database
   void check_integer_overflow(ar::BinaryOperation* stmt,
-                              const value::AbstractDomain& inv,
+                              const AbstractDomain& inv,
                               CallContext* call_context);
 
 private:
@@ -78,7 +84,7 @@ private:
 
   /// \brief Check an integer overflow
   llvm::SmallVector< CheckResult, 2 > check_integer_overflow(
-      ar::BinaryOperation* stmt, const value::AbstractDomain& inv);
+      ar::BinaryOperation* stmt, const AbstractDomain& inv);
 
 private:
   /// \brief Display info about the check
@@ -93,5 +99,218 @@ private:
 
 }; // end class IntOverflowCheckerBase
 
+namespace detail {
+
+/// \brief Return a text representation of the given binary operator
+inline char op_char(ar::BinaryOperation::Operator op) {
+  switch (op) {
+    case ar::BinaryOperation::SAdd:
+    case ar::BinaryOperation::UAdd:
+      return '+';
+    case ar::BinaryOperation::SSub:
+    case ar::BinaryOperation::USub:
+      return '-';
+    case ar::BinaryOperation::SMul:
+    case ar::BinaryOperation::UMul:
+      return '*';
+    case ar::BinaryOperation::SDiv:
+    case ar::BinaryOperation::UDiv:
+      return '/';
+    case ar::BinaryOperation::SRem:
+    case ar::BinaryOperation::URem:
+      return '%';
+    default:
+      ikos_unreachable("unexpected binary operator");
+  }
+}
+
+} // end namespace detail
+
+template < typename AbstractDomain >
+IntOverflowCheckerBase< AbstractDomain >::IntOverflowCheckerBase(Context& ctx)
+    : Checker< AbstractDomain >(ctx) {}
+
+template < typename AbstractDomain >
+void IntOverflowCheckerBase< AbstractDomain >::check_integer_overflow(
+    ar::BinaryOperation* stmt,
+    const AbstractDomain& inv,
+    CallContext* call_context) {
+  auto checks = this->check_integer_overflow(stmt, inv);
+  for (const auto& check : checks) {
+    this->display_invariant(check.result, stmt, inv);
+    this->_checks.insert(check.kind,
+                         this->name(),
+                         check.result,
+                         stmt,
+                         call_context,
+                         check.operands,
+                         check.info);
+  }
+}
+
+template < typename AbstractDomain >
+llvm::SmallVector<
+    typename IntOverflowCheckerBase< AbstractDomain >::CheckResult,
+    2 >
+IntOverflowCheckerBase< AbstractDomain >::check_integer_overflow(
+    ar::BinaryOperation* stmt, const AbstractDomain& inv) {
+  if (inv.is_normal_flow_bottom()) {
+    // Statement unreachable
+    if (this->display_int_overflow_check(Result::Unreachable, stmt)) {
+      out() << std::endl;
+    }
+    return {{CheckKind::Unreachable, Result::Unreachable, {}, {}}};
+  }
+
+  const ScalarLit& left_lit = this->_lit_factory.get_scalar(stmt->left());
+  const ScalarLit& right_lit = this->_lit_factory.get_scalar(stmt->right());
+
+  IntInterval left_interval;
+  IntInterval right_interval;
+
+  if (left_lit.is_undefined() ||
+      (left_lit.is_machine_int_var() &&
+       inv.normal().uninitialized().is_uninitialized(left_lit.var()))) {
+    // Undefined operand
+    if (this->display_int_overflow_check(Result::Error, stmt)) {
+      out() << ": undefined left operand" << std::endl;
+    }
+    return {
+        {CheckKind::UninitializedVariable, Result::Error, {stmt->left()}, {}}};
+  } else if (left_lit.is_machine_int()) {
+    left_interval = IntInterval(left_lit.machine_int());
+  } else if (left_lit.is_machine_int_var()) {
+    left_interval = inv.normal().integers().to_interval(left_lit.var());
+  } else {
+    log::error("unexpected operand to ar::BinaryOperation");
+    return {{CheckKind::UnexpectedOperand, Result::Error, {stmt->left()}, {}}};
+  }
+
+  if (right_lit.is_undefined() ||
+      (right_lit.is_machine_int_var() &&
+       inv.normal().uninitialized().is_uninitialized(right_lit.var()))) {
+    // Undefined operand
+    if (this->display_int_overflow_check(Result::Error, stmt)) {
+      out() << ": undefined right operand" << std::endl;
+    }
+    return {
+        {CheckKind::UninitializedVariable, Result::Error, {stmt->right()}, {}}};
+  } else if (right_lit.is_machine_int()) {
+    right_interval = IntInterval(right_lit.machine_int());
+  } else if (right_lit.is_machine_int_var()) {
+    right_interval = inv.normal().integers().to_interval(right_lit.var());
+  } else {
+    log::error("unexpected operand to ar::BinaryOperation");
+    return {{CheckKind::UnexpectedOperand, Result::Error, {stmt->right()}, {}}};
+  }
+
+  ZInterval result_interval;
+
+  // Computes final interval, depending on the binary operator
+  if (stmt->op() == ar::BinaryOperation::SAdd ||
+      stmt->op() == ar::BinaryOperation::UAdd) {
+    result_interval =
+        left_interval.to_z_interval() + right_interval.to_z_interval();
+  } else if (stmt->op() == ar::BinaryOperation::SSub ||
+             stmt->op() == ar::BinaryOperation::USub) {
+    result_interval =
+        left_interval.to_z_interval() - right_interval.to_z_interval();
+  } else if (stmt->op() == ar::BinaryOperation::SMul ||
+             stmt->op() == ar::BinaryOperation::UMul) {
+    result_interval =
+        left_interval.to_z_interval() * right_interval.to_z_interval();
+  } else if (stmt->op() == ar::BinaryOperation::SDiv ||
+             stmt->op() == ar::BinaryOperation::UDiv) {
+    result_interval =
+        left_interval.to_z_interval() / right_interval.to_z_interval();
+  } else if (stmt->op() == ar::BinaryOperation::URem ||
+             stmt->op() == ar::BinaryOperation::SRem) {
+    // signed remainder INT_MIN % -1 is undefined behavior
+    // we're using division to check this case, because
+    // we're checking INT_MIN / -1
+    result_interval =
+        left_interval.to_z_interval() / right_interval.to_z_interval();
+  } else {
+    ikos_unreachable("unexpected operator");
+  }
+
+  // No result because of division by zero
+  if (result_interval.is_bottom()) {
+    if (this->display_int_overflow_check(Result::Error, stmt)) {
+      out() << ": division by zero" << std::endl;
+    }
+    return {{CheckKind::DivisionByZero, Result::Error, {stmt->right()}, {}}};
+  }
+
+  auto type = cast< ar::IntegerType >(stmt->result()->type());
+  ZBound max(MachineInt::max(type->bit_width(), type->sign()).to_z_number());
+  ZBound min(MachineInt::min(type->bit_width(), type->sign()).to_z_number());
+
+  const ZBound& lb = result_interval.lb();
+  const ZBound& ub = result_interval.ub();
+
+  Result result_underflow, result_overflow;
+
+  JsonDict info;
+  info.put("left", to_json(left_interval));
+  info.put("right", to_json(right_interval));
+
+  if (lb > max) {
+    result_underflow = Result::Ok;
+    result_overflow = Result::Error;
+    if (this->display_int_overflow_check(Result::Error, stmt)) {
+      out() << ": ∀ a, b ∈ left x right, left " << detail::op_char(stmt->op())
+            << " right > INT_MAX" << std::endl;
+    }
+  } else if (ub < min) {
+    result_underflow = Result::Error;
+    result_overflow = Result::Ok;
+    if (this->display_int_overflow_check(Result::Error, stmt)) {
+      out() << ": ∀ a, b ∈ left x right, left " << detail::op_char(stmt->op())
+            << " right < INT_MIN" << std::endl;
+    }
+  } else {
+    result_underflow = (lb < min) ? Result::Warning : Result::Ok;
+    result_overflow = (ub > max) ? Result::Warning : Result::Ok;
+    if (this->display_int_overflow_check(result_underflow, stmt)) {
+      out() << " [underflow]: ";
+      if (result_underflow == Result::Warning) {
+        out() << "lower_bound < min" << std::endl;
+      } else {
+        out() << "lower_bound >= min" << std::endl;
+      }
+    }
+    if (this->display_int_overflow_check(result_overflow, stmt)) {
+      out() << " [overflow]: ";
+      if (result_overflow == Result::Warning) {
+        out() << "upper_bound > max" << std::endl;
+      } else {
+        out() << "upper_bound <= max" << std::endl;
+      }
+    }
+  }
+
+  return {{this->underflow_check_kind(),
+           result_underflow,
+           {stmt->left(), stmt->right()},
+           ((result_underflow != Result::Ok) ? info : JsonDict())},
+          {this->overflow_check_kind(),
+           result_overflow,
+           {stmt->left(), stmt->right()},
+           ((result_overflow != Result::Ok) ? info : JsonDict())}};
+}
+
+template < typename AbstractDomain >
+bool IntOverflowCheckerBase< AbstractDomain >::display_int_overflow_check(
+    Result result, ar::BinaryOperation* stmt) const {
+  if (this->display_check(result, stmt)) {
+    out() << "check_" << this->short_name() << "(";
+    stmt->dump(out());
+    out() << ")";
+    return true;
+  }
+  return false;
+}
+
 } // end namespace analyzer
 } // end namespace ikos
@@ -1,7 +1,7 @@
 /*******************************************************************************
  *
  * \file
- * \brief Base class for property checker and make_checker implementation
+ * \brief Construction of property checkers
  *
  * Author: Maxime Arthaud
  *
@@ -41,6 +41,10 @@
  *
  ******************************************************************************/
 
+#pragma once
+
+#include <memory>
+
 #include <ikos/analyzer/checker/assert_prover.hpp>
 #include <ikos/analyzer/checker/buffer_overflow.hpp>
 #include <ikos/analyzer/checker/checker.hpp>
@@ -57,72 +61,48 @@
 #include <ikos/analyzer/checker/soundness.hpp>
 #include <ikos/analyzer/checker/uninitialized_variable.hpp>
 #include <ikos/analyzer/checker/unsigned_int_overflow.hpp>
-#include <ikos/analyzer/util/color.hpp>
-#include <ikos/analyzer/util/source_location.hpp>
 
 namespace ikos {
 namespace analyzer {
 
-// Checker
-
-void Checker::display_stmt_location(ar::Statement* s) const {
-  out() << color::bold() << source_location_string(s, _ctx.wd) << ": "
-        << color::off();
-}
-
-void Checker::display_result(Result result) const {
-  switch (result) {
-    case Result::Ok: {
-      out() << "[" << color::bold_green() << "ok" << color::off() << "] ";
-    } break;
-    case Result::Warning: {
-      out() << "[" << color::bold_yellow() << "warning" << color::off() << "] ";
-    } break;
-    case Result::Error: {
-      out() << "[" << color::bold_red() << "error" << color::off() << "] ";
-    } break;
-    case Result::Unreachable: {
-      out() << "[" << color::bold_magenta() << "unreachable" << color::off()
-            << "] ";
-    } break;
-    default: { ikos_unreachable("unreachable"); }
-  }
-}
-
-// make_checker
-
-std::unique_ptr< Checker > make_checker(Context& ctx, CheckerName name) {
+/// \brief Create a checker, given its name
+template < typename AbstractDomain >
+std::unique_ptr< Checker< AbstractDomain > > make_checker(Context& ctx,
+                                                       CheckerName name) {
   switch (name) {
     case CheckerName::BufferOverflow:
-      return std::make_unique< BufferOverflowChecker >(ctx);
+      return std::make_unique< BufferOverflowChecker< AbstractDomain > >(ctx);
     case CheckerName::DivisionByZero:
-      return std::make_unique< DivisionByZeroChecker >(ctx);
+      return std::make_unique< DivisionByZeroChecker< AbstractDomain > >(ctx);
     case CheckerName::NullPointerDereference:
-      return std::make_unique< NullDereferenceChecker >(ctx);
+      return std::make_unique< NullDereferenceChecker< AbstractDomain > >(ctx);
     case CheckerName::AssertProver:
-      return std::make_unique< AssertProverChecker >(ctx);
+      return std::make_unique< AssertProverChecker< AbstractDomain > >(ctx);
     case CheckerName::UnalignedPointer:
-      return std::make_unique< PointerAlignmentChecker >(ctx);
+      return std::make_unique< PointerAlignmentChecker< AbstractDomain > >(ctx);
     case CheckerName::UninitializedVariable:
-      return std::make_unique< UninitializedVariableChecker >(ctx);
+      return std::make_unique<
+          UninitializedVariableChecker< AbstractDomain > >(ctx);
     case CheckerName::SignedIntOverflow:
-      return std::make_unique< SignedIntOverflowChecker >(ctx);
+      return std::make_unique<
+          SignedIntOverflowChecker< AbstractDomain > >(ctx);
     case CheckerName::UnsignedIntOverflow:
-      return std::make_unique< UnsignedIntOverflowChecker >(ctx);
+      return std::make_unique<
+          UnsignedIntOverflowChecker< AbstractDomain > >(ctx);
     case CheckerName::ShiftCount:
-      return std::make_unique< ShiftCountChecker >(ctx);
+      return std::make_unique< ShiftCountChecker< AbstractDomain > >(ctx);
     case CheckerName::PointerOverflow:
-      return std::make_unique< PointerOverflowChecker >(ctx);
+      return std::make_unique< PointerOverflowChecker< AbstractDomain > >(ctx);
     case CheckerName::PointerCompare:
-      return std::make_unique< PointerCompareChecker >(ctx);
+      return std::make_unique< PointerCompareChecker< AbstractDomain > >(ctx);
     case CheckerName::Soundness:
-      return std::make_unique< SoundnessChecker >(ctx);
+      return std::make_unique< SoundnessChecker< AbstractDomain > >(ctx);
     case CheckerName::FunctionCall:
-      return std::make_unique< FunctionCallChecker >(ctx);
+      return std::make_unique< FunctionCallChecker< AbstractDomain > >(ctx);
     case CheckerName::DeadCode:
-      return std::make_unique< DeadCodeChecker >(ctx);
+      return std::make_unique< DeadCodeChecker< AbstractDomain > >(ctx);
     case CheckerName::DoubleFree:
-      return std::make_unique< DoubleFreeChecker >(ctx);
+      return std::make_unique< DoubleFreeChecker< AbstractDomain > >(ctx);
     default:
       ikos_unreachable("unreachable");
   }
@@ -43,13 +43,20 @@
 
 #pragma once
 
+#include <ikos/analyzer/analysis/literal.hpp>
 #include <ikos/analyzer/checker/checker.hpp>
+#include <ikos/analyzer/support/cast.hpp>
+#include <ikos/analyzer/util/log.hpp>
 
 namespace ikos {
 namespace analyzer {
 
 /// \brief Null dereference checker
-class NullDereferenceChecker final : public Checker {
+template < typename AbstractDomain >
+class NullDereferenceChecker final : public Checker< AbstractDomain > {
+private:
+  using Checker< AbstractDomain >::out;
+
 public:
   /// \brief Constructor
   explicit NullDereferenceChecker(Context& ctx);
@@ -62,14 +69,14 @@ public:
 
   /// \brief Check a statement
   void check(ar::Statement* stmt,
-             const value::AbstractDomain& inv,
+             const AbstractDomain& inv,
              CallContext* call_context) override;
 
 private:
   /// \brief Check a null dereference and insert the check in the database
   void check_null(ar::Statement* stmt,
                   ar::Value* operand,
-                  const value::AbstractDomain& inv,
+                  const AbstractDomain& inv,
                   CallContext* call_context);
 
   /// \brief Check result
@@ -81,7 +88,7 @@ private:
   /// \brief Check a null dereference
   CheckResult check_null(ar::Statement* stmt,
                          ar::Value* operand,
-                         const value::AbstractDomain& inv);
+                         const AbstractDomain& inv);
 
 private:
   /// \brief Dispay a null dereference check, if requested
@@ -91,5 +98,175 @@ private:
 
 }; // end class NullDereferenceChecker
 
+template < typename AbstractDomain >
+NullDereferenceChecker< AbstractDomain >::NullDereferenceChecker(Context& ctx)
+    : Checker< AbstractDomain >(ctx) {}
+
+template < typename AbstractDomain >
+CheckerName NullDereferenceChecker< AbstractDomain >::name() const {
+  return CheckerName::NullPointerDereference;
+}
+
+template < typename AbstractDomain >
+const char* NullDereferenceChecker< AbstractDomain >::description() const {
+  return "Null dereference checker";
+}
+
+template < typename AbstractDomain >
+void NullDereferenceChecker< AbstractDomain >::check(
+    ar::Statement* stmt, const AbstractDomain& inv, CallContext* call_context) {
+  if (auto load = dyn_cast< ar::Load >(stmt)) {
+    this->check_null(stmt, load->operand(), inv, call_context);
+  }
+  if (auto store = dyn_cast< ar::Store >(stmt)) {
+    this->check_null(stmt, store->pointer(), inv, call_context);
+  }
+  if (auto call = dyn_cast< ar::CallBase >(stmt)) {
+    this->check_null(stmt, call->called(), inv, call_context);
+  }
+  if (auto call = dyn_cast< ar::IntrinsicCall >(stmt)) {
+    ar::Function* fun = call->called_function();
+
+    switch (fun->intrinsic_id()) {
+      case ar::Intrinsic::MemoryCopy:
+      case ar::Intrinsic::MemoryMove: {
+        this->check_null(stmt, call->argument(0), inv, call_context);
+        this->check_null(stmt, call->argument(1), inv, call_context);
+      } break;
+      case ar::Intrinsic::MemorySet: {
+        this->check_null(stmt, call->argument(0), inv, call_context);
+      } break;
+      case ar::Intrinsic::LibcStrlen:
+      case ar::Intrinsic::LibcStrnlen: {
+        this->check_null(stmt, call->argument(0), inv, call_context);
+      } break;
+      case ar::Intrinsic::LibcStrcpy:
+      case ar::Intrinsic::LibcStrncpy: {
+        this->check_null(stmt, call->argument(0), inv, call_context);
+        this->check_null(stmt, call->argument(1), inv, call_context);
+      } break;
+      case ar::Intrinsic::LibcStrcat:
+      case ar::Intrinsic::LibcStrncat: {
+        this->check_null(stmt, call->argument(0), inv, call_context);
+        this->check_null(stmt, call->argument(1), inv, call_context);
+      } break;
+      default: { break; }
+    }
+  }
+}
+
+template < typename AbstractDomain >
+void NullDereferenceChecker< AbstractDomain >::check_null(
+    ar::Statement* stmt,
+    ar::Value* operand,
+    const AbstractDomain& inv,
+    CallContext* call_context) {
+  CheckResult check = this->check_null(stmt, operand, inv);
+  this->display_invariant(check.result, stmt, inv);
+  this->_checks.insert(check.kind,
+                       CheckerName::NullPointerDereference,
+                       check.result,
+                       stmt,
+                       call_context,
+                       std::array< ar::Value*, 1 >{{operand}});
+}
+
+template < typename AbstractDomain >
+typename NullDereferenceChecker< AbstractDomain >::CheckResult
+NullDereferenceChecker< AbstractDomain >::check_null(
+    ar::Statement* stmt, ar::Value* operand, const AbstractDomain& inv) {
+  if (inv.is_normal_flow_bottom()) {
+    // Statement unreachable
+    if (this->display_null_check(Result::Unreachable, stmt, operand)) {
+      out() << std::endl;
+    }
+    return {CheckKind::Unreachable, Result::Unreachable};
+  }
+
+  const ScalarLit& ptr = this->_lit_factory.get_scalar(operand);
+
+  if (ptr.is_undefined() ||
+      (ptr.is_pointer_var() &&
+       inv.normal().uninitialized().is_uninitialized(ptr.var()))) {
+    // Undefined operand
+    if (this->display_null_check(Result::Error, stmt, operand)) {
+      out() << ": undefined operand" << std::endl;
+    }
+    return {CheckKind::UninitializedVariable, Result::Error};
+  }
+
+  if (ptr.is_null()) {
+    // Null operand
+    if (this->display_null_check(Result::Error, stmt, operand)) {
+      out() << ": null operand" << std::endl;
+    }
+    return {CheckKind::NullPointerDereference, Result::Error};
+  }
+
+  if (!ptr.is_pointer_var()) {
+    log::error("unexpected pointer operand");
+    return {CheckKind::UnexpectedOperand, Result::Error};
+  }
+
+  if (isa< ar::LocalVariable >(operand)) {
+    // Local variable
+    if (this->display_null_check(Result::Ok, stmt, operand)) {
+      out() << ": dereferencing a local variable" << std::endl;
+    }
+    return {CheckKind::NullPointerDereference, Result::Ok};
+  } else if (isa< ar::GlobalVariable >(operand)) {
+    // Global variable
+    if (this->display_null_check(Result::Ok, stmt, operand)) {
+      out() << ": dereferencing a global variable" << std::endl;
+    }
+    return {CheckKind::NullPointerDereference, Result::Ok};
+  } else if (isa< ar::InlineAssemblyConstant >(operand)) {
+    // Inline Assembly
+    if (this->display_null_check(Result::Ok, stmt, operand)) {
+      out() << ": dereferencing an inline assembly" << std::endl;
+    }
+    return {CheckKind::NullPointerDereference, Result::Ok};
+  } else if (isa< ar::FunctionPointerConstant >(operand)) {
+    // Function pointer constant
+    if (this->display_null_check(Result::Ok, stmt, operand)) {
+      out() << ": dereferencing a function pointer" << std::endl;
+    }
+    return {CheckKind::NullPointerDereference, Result::Ok};
+  }
+
+  core::Nullity null_val = inv.normal().nullity().get(ptr.var());
+  if (null_val.is_null()) {
+    // Pointer is definitely null
+    if (this->display_null_check(Result::Error, stmt, operand)) {
+      out() << ": pointer is null" << std::endl;
+    }
+    return {CheckKind::NullPointerDereference, Result::Error};
+  } else if (null_val.is_non_null()) {
+    // Pointer is definitely non-null
+    if (this->display_null_check(Result::Ok, stmt, operand)) {
+      out() << ": pointer is non null" << std::endl;
+    }
+    return {CheckKind::NullPointerDereference, Result::Ok};
+  } else {
+    // Pointer may be null
+    if (this->display_null_check(Result::Warning, stmt, operand)) {
+      out() << ": pointer may be null" << std::endl;
+    }
+    return {CheckKind::NullPointerDereference, Result::Warning};
+  }
+}
+
+template < typename AbstractDomain >
+bool NullDereferenceChecker< AbstractDomain >::display_null_check(
+    Result result, ar::Statement* stmt, ar::Value* operand) const {
+  if (this->display_check(result, stmt)) {
+    out() << "check_null_dereference(";
+    operand->dump(out());
+    out() << ")";
+    return true;
+  }
+  return false;
+}
+
 } // end namespace analyzer
 } // end namespace ikos
@@ -45,14 +45,19 @@
 
 #include <llvm/ADT/SmallVector.h>
 
+#include <ikos/analyzer/analysis/literal.hpp>
 #include <ikos/analyzer/checker/checker.hpp>
+#include <ikos/analyzer/support/cast.hpp>
+#include <ikos/analyzer/util/log.hpp>
 
 namespace ikos {
 namespace analyzer {
 
 /// \brief Pointer compare checker
-class PointerCompareChecker final : public Checker {
+template < typename AbstractDomain >
+class PointerCompareChecker final : public Checker< AbstractDomain > {
 private:
+  using Checker< AbstractDomain >::out;
   using IntInterval = core::machine_int::Interval;
   using PointsToSet = core::PointsToSet< MemoryLocation* >;
 
@@ -68,7 +73,7 @@ public:
 
   /// \brief Check a statement
   void check(ar::Statement* stmt,
-             const value::AbstractDomain& inv,
+             const AbstractDomain& inv,
              CallContext* call_context) override;
 
 private:
@@ -82,12 +87,214 @@ private:
 
   /// \brief Check a pointer comparison
   CheckResult check_pointer_compare(ar::Comparison* stmt,
-                                    const value::AbstractDomain& inv);
+                                    const AbstractDomain& inv);
 
   /// \brief Display the pointer comparison check, if requested
   bool display_pointer_compare_check(Result result, ar::Comparison* stmt) const;
 
 }; // end class PointerCompareChecker
 
+template < typename AbstractDomain >
+PointerCompareChecker< AbstractDomain >::PointerCompareChecker(Context& ctx)
+    : Checker< AbstractDomain >(ctx) {}
+
+template < typename AbstractDomain >
+CheckerName PointerCompareChecker< AbstractDomain >::name() const {
+  return CheckerName::PointerCompare;
+}
+
+template < typename AbstractDomain >
+const char* PointerCompareChecker< AbstractDomain >::description() const {
+  return "Pointer compare checker";
+}
+
+template < typename AbstractDomain >
+void PointerCompareChecker< AbstractDomain >::check(ar::Statement* stmt,
+                                                    const AbstractDomain& inv,
+                                                    CallContext* call_context) {
+  if (auto cmp = dyn_cast< ar::Comparison >(stmt)) {
+    if (cmp->is_pointer_predicate() &&
+        cmp->predicate() != ar::Comparison::PEQ &&
+        cmp->predicate() != ar::Comparison::PNE) {
+      CheckResult check = this->check_pointer_compare(cmp, inv);
+      this->display_invariant(check.result, stmt, inv);
+      this->_checks.insert(check.kind,
+                           CheckerName::PointerCompare,
+                           check.result,
+                           stmt,
+                           call_context,
+                           check.operands,
+                           check.info);
+    }
+  }
+}
+
+template < typename AbstractDomain >
+typename PointerCompareChecker< AbstractDomain >::CheckResult
+PointerCompareChecker< AbstractDomain >::check_pointer_compare(
+    ar::Comparison* stmt, const AbstractDomain& inv) {
+  if (inv.is_normal_flow_bottom()) {
+    // Statement unreachable
+    if (this->display_pointer_compare_check(Result::Unreachable, stmt)) {
+      out() << std::endl;
+    }
+    return {CheckKind::Unreachable, Result::Unreachable, {}, {}};
+  }
+
+  const ScalarLit& left_ptr = this->_lit_factory.get_scalar(stmt->left());
+  const ScalarLit& right_ptr = this->_lit_factory.get_scalar(stmt->right());
+
+  // Check uninitialized operands
+
+  if (left_ptr.is_undefined() ||
+      (left_ptr.is_pointer_var() &&
+       inv.normal().uninitialized().is_uninitialized(left_ptr.var()))) {
+    if (this->display_pointer_compare_check(Result::Error, stmt)) {
+      out() << ": undefined left operand" << std::endl;
+    }
+    return {CheckKind::UninitializedVariable,
+            Result::Error,
+            {stmt->left()},
+            {}};
+  } else if (right_ptr.is_undefined() ||
+             (right_ptr.is_pointer_var() &&
+              inv.normal().uninitialized().is_uninitialized(right_ptr.var()))) {
+    if (this->display_pointer_compare_check(Result::Error, stmt)) {
+      out() << ": undefined right operand" << std::endl;
+    }
+    return {CheckKind::UninitializedVariable,
+            Result::Error,
+            {stmt->right()},
+            {}};
+  }
+
+  // Check for null operands
+
+  if (left_ptr.is_null() || (left_ptr.is_pointer_var() &&
+                             inv.normal().nullity().is_null(left_ptr.var()))) {
+    if (this->display_pointer_compare_check(Result::Error, stmt)) {
+      out() << ": null left operand" << std::endl;
+    }
+    return {CheckKind::NullPointerComparison,
+            Result::Error,
+            {stmt->left()},
+            {}};
+  } else if (right_ptr.is_null() ||
+             (right_ptr.is_pointer_var() &&
+              inv.normal().nullity().is_null(right_ptr.var()))) {
+    if (this->display_pointer_compare_check(Result::Error, stmt)) {
+      out() << ": null right operand" << std::endl;
+    }
+    return {CheckKind::NullPointerComparison,
+            Result::Error,
+            {stmt->right()},
+            {}};
+  }
+
+  if (!left_ptr.is_pointer_var()) {
+    log::error("unexpected operand to ar::Comparison");
+    return {CheckKind::UnexpectedOperand, Result::Error, {stmt->left()}, {}};
+  } else if (!right_ptr.is_pointer_var()) {
+    log::error("unexpected operand to ar::Comparison");
+    return {CheckKind::UnexpectedOperand, Result::Error, {stmt->right()}, {}};
+  }
+
+  PointsToSet left_addrs;
+  if (auto gv = dyn_cast< ar::GlobalVariable >(stmt->left())) {
+    left_addrs = {this->_ctx.mem_factory->get_global(gv)};
+  } else if (auto cst = dyn_cast< ar::FunctionPointerConstant >(stmt->left())) {
+    left_addrs = {this->_ctx.mem_factory->get_function(cst->function())};
+  } else {
+    left_addrs = inv.normal().pointers().points_to(left_ptr.var());
+  }
+
+  PointsToSet right_addrs;
+  if (auto gv = dyn_cast< ar::GlobalVariable >(stmt->right())) {
+    right_addrs = {this->_ctx.mem_factory->get_global(gv)};
+  } else if (auto cst =
+                 dyn_cast< ar::FunctionPointerConstant >(stmt->right())) {
+    right_addrs = {this->_ctx.mem_factory->get_function(cst->function())};
+  } else {
+    right_addrs = inv.normal().pointers().points_to(right_ptr.var());
+  }
+
+  if (left_addrs.is_empty()) {
+    if (this->display_pointer_compare_check(Result::Error, stmt)) {
+      out() << ": empty points-to set for left operand" << std::endl;
+    }
+    return {CheckKind::InvalidPointerComparison,
+            Result::Error,
+            {stmt->left()},
+            {}};
+  } else if (right_addrs.is_empty()) {
+    if (this->display_pointer_compare_check(Result::Error, stmt)) {
+      out() << ": empty points-to set for right operand" << std::endl;
+    }
+    return {CheckKind::InvalidPointerComparison,
+            Result::Error,
+            {stmt->right()},
+            {}};
+  }
+
+  PointsToSet join_addrs = left_addrs.join(right_addrs);
+  PointsToSet meet_addrs = left_addrs.meet(right_addrs);
+
+  Result result;
+  if (meet_addrs.is_empty()) {
+    result = Result::Error;
+  } else if (join_addrs.is_top() || join_addrs.size() > 1) {
+    result = Result::Warning;
+  } else {
+    result = Result::Ok;
+  }
+
+  if (this->display_pointer_compare_check(result, stmt)) {
+    out() << ": left addresses=" << left_addrs
+          << " right addresses=" << right_addrs << std::endl;
+  }
+
+  JsonDict info;
+  if (result != Result::Ok) {
+    if (left_addrs.is_set()) {
+      JsonList left_points_to;
+      for (MemoryLocation* mem_loc : left_addrs) {
+        left_points_to.add(
+            this->_ctx.output_db->memory_locations.insert(mem_loc));
+      }
+      info.put("left_points_to", left_points_to);
+    } else {
+      ikos_assert(left_addrs.is_top());
+    }
+
+    if (right_addrs.is_set()) {
+      JsonList right_points_to;
+      for (MemoryLocation* mem_loc : right_addrs) {
+        right_points_to.add(
+            this->_ctx.output_db->memory_locations.insert(mem_loc));
+      }
+      info.put("right_points_to", right_points_to);
+    } else {
+      ikos_assert(right_addrs.is_top());
+    }
+  }
+
+  return {CheckKind::PointerComparison,
+          result,
+          {stmt->left(), stmt->right()},
+          info};
+}
+
+template < typename AbstractDomain >
+bool PointerCompareChecker< AbstractDomain >::display_pointer_compare_check(
+    Result result, ar::Comparison* stmt) const {
+  if (this->display_check(result, stmt)) {
+    out() << "check_pcmp(";
+    stmt->dump(out());
+    out() << ")";
+    return true;
+  }
+  return false;
+}
+
 } // end namespace analyzer
 } // end namespace ikos
@@ -43,14 +43,19 @@
 
 #pragma once
 
+#include <ikos/analyzer/analysis/literal.hpp>
 #include <ikos/analyzer/checker/checker.hpp>
+#include <ikos/analyzer/support/cast.hpp>
+#include <ikos/analyzer/util/log.hpp>
 
 namespace ikos {
 namespace analyzer {
 
 /// \brief Pointer overflow checker
-class PointerOverflowChecker final : public Checker {
+template < typename AbstractDomain >
+class PointerOverflowChecker final : public Checker< AbstractDomain > {
 private:
+  using Checker< AbstractDomain >::out;
   using IntInterval = core::machine_int::Interval;
   using ZInterval = core::numeric::Interval< ZNumber >;
   using ZBound = core::Bound< ZNumber >;
@@ -71,7 +76,7 @@ public:
 
   /// \brief Check a statement
   void check(ar::Statement* stmt,
-             const value::AbstractDomain& inv,
+             const AbstractDomain& inv,
              CallContext* call_context) override;
 
 private:
@@ -84,7 +89,7 @@ private:
 
   /// \brief Check a pointer overflow
   CheckResult check_pointer_overflow(ar::PointerShift* stmt,
-                                     const value::AbstractDomain& inv);
+                                     const AbstractDomain& inv);
 
   /// \brief Display the pointer overflow check, if requested
   bool display_pointer_overflow_check(Result result,
@@ -92,5 +97,144 @@ private:
 
 }; // end class PointerOverflowChecker
 
+template < typename AbstractDomain >
+PointerOverflowChecker< AbstractDomain >::PointerOverflowChecker(Context& ctx)
+    : Checker< AbstractDomain >(ctx), _data_layout(ctx.bundle->data_layout()) {}
+
+template < typename AbstractDomain >
+CheckerName PointerOverflowChecker< AbstractDomain >::name() const {
+  return CheckerName::PointerOverflow;
+}
+
+template < typename AbstractDomain >
+const char* PointerOverflowChecker< AbstractDomain >::description() const {
+  return "Pointer overflow checker";
+}
+
+template < typename AbstractDomain >
+void PointerOverflowChecker< AbstractDomain >::check(
+    ar::Statement* stmt, const AbstractDomain& inv, CallContext* call_context) {
+  if (auto bin = dyn_cast< ar::PointerShift >(stmt)) {
+    CheckResult check = this->check_pointer_overflow(bin, inv);
+    this->display_invariant(check.result, stmt, inv);
+    this->_checks.insert(check.kind,
+                         CheckerName::PointerOverflow,
+                         check.result,
+                         stmt,
+                         call_context,
+                         check.operands);
+  }
+}
+
+template < typename AbstractDomain >
+typename PointerOverflowChecker< AbstractDomain >::CheckResult
+PointerOverflowChecker< AbstractDomain >::check_pointer_overflow(
+    ar::PointerShift* stmt, const AbstractDomain& inv) {
+  if (inv.is_normal_flow_bottom()) {
+    // Statement unreachable
+    if (this->display_pointer_overflow_check(Result::Unreachable, stmt)) {
+      out() << std::endl;
+    }
+    return {CheckKind::Unreachable, Result::Unreachable, {}};
+  }
+
+  const ScalarLit& base = this->_lit_factory.get_scalar(stmt->pointer());
+
+  if (base.is_undefined() ||
+      (base.is_pointer_var() &&
+       inv.normal().uninitialized().is_uninitialized(base.var()))) {
+    if (this->display_pointer_overflow_check(Result::Error, stmt)) {
+      out() << ": undefined base operand" << std::endl;
+    }
+    return {CheckKind::UninitializedVariable, Result::Error, {stmt->pointer()}};
+  }
+
+  ZInterval base_interval;
+  if (isa< ar::NullConstant >(stmt->pointer()) ||
+      isa< ar::GlobalVariable >(stmt->pointer()) ||
+      isa< ar::LocalVariable >(stmt->pointer()) ||
+      isa< ar::FunctionPointerConstant >(stmt->pointer())) {
+    base_interval = ZInterval(0);
+  } else if (isa< ar::InternalVariable >(stmt->pointer())) {
+    Variable* offset_var = inv.normal().pointers().offset_var(base.var());
+    base_interval =
+        inv.normal().integers().to_interval(offset_var).to_z_interval();
+  } else {
+    log::error("unexpected operand to ar::PointerShift");
+    return {CheckKind::UnexpectedOperand, Result::Error, {stmt->pointer()}};
+  }
+
+  Result result = Result::Ok;
+  ZInterval top =
+      IntInterval::top(this->_data_layout.pointers.bit_width, Unsigned)
+          .to_z_interval();
+  ZBound max(MachineInt::max(this->_data_layout.pointers.bit_width, Unsigned)
+                 .to_z_number());
+
+  for (auto it = stmt->term_begin(), et = stmt->term_end();
+       it != et && result != Result::Error;
+       it++) {
+    auto term = *it;
+    auto factor_interval = ZInterval(term.first.to_z_number());
+    const ScalarLit& offset = this->_lit_factory.get_scalar(term.second);
+    ZInterval offset_interval;
+
+    if (offset.is_undefined() ||
+        (offset.is_machine_int_var() &&
+         inv.normal().uninitialized().is_uninitialized(offset.var()))) {
+      if (this->display_pointer_overflow_check(Result::Error, stmt)) {
+        out() << ": undefined operand" << std::endl;
+      }
+      return {CheckKind::UninitializedVariable, Result::Error, {term.second}};
+    } else if (offset.is_machine_int()) {
+      offset_interval = ZInterval(offset.machine_int().to_z_number());
+    } else if (offset.is_machine_int_var()) {
+      offset_interval =
+          inv.normal().integers().to_interval(offset.var()).to_z_interval();
+    } else {
+      log::error("unexpected operand to ar::PointerShift");
+      return {CheckKind::UnexpectedOperand, Result::Error, {term.second}};
+    }
+
+    base_interval += factor_interval * offset_interval;
+
+    if (!base_interval.leq(top)) {
+      // possible overflow
+      if (base_interval.lb() <= max) {
+        result = Result::Warning;
+        if (this->display_pointer_overflow_check(result, stmt)) {
+          out() << ": ∃ p ∈ base_interval | p > " << max << std::endl;
+        }
+      } else {
+        result = Result::Error;
+        if (this->display_pointer_overflow_check(result, stmt)) {
+          out() << " ∀ p ∈ base_interval, p > " << max << std::endl;
+        }
+        break;
+      }
+    } else {
+      if (this->display_pointer_overflow_check(result, stmt)) {
+        out() << ": ∀ p ∈ base_interval, p < " << max << std::endl;
+      }
+    }
+  }
+
+  return {CheckKind::PointerOverflow,
+          result,
+          {stmt->op_begin(), stmt->op_end()}};
+}
+
+template < typename AbstractDomain >
+bool PointerOverflowChecker< AbstractDomain >::display_pointer_overflow_check(
+    Result result, ar::PointerShift* stmt) const {
+  if (this->display_check(result, stmt)) {
+    out() << "check_poa(";
+    stmt->dump(out());
+    out() << ")";
+    return true;
+  }
+  return false;
+}
+
 } // end namespace analyzer
 } // end namespace ikos
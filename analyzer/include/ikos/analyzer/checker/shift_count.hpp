@@ -43,14 +43,20 @@
 
 #pragma once
 
+#include <ikos/analyzer/analysis/literal.hpp>
 #include <ikos/analyzer/checker/checker.hpp>
+#include <ikos/analyzer/json/helper.hpp>
+#include <ikos/analyzer/support/cast.hpp>
+#include <ikos/analyzer/util/log.hpp>
 
 namespace ikos {
 namespace analyzer {
 
 /// \brief Shift count checker
-class ShiftCountChecker final : public Checker {
+template < typename AbstractDomain >
+class ShiftCountChecker final : public Checker< AbstractDomain > {
 private:
+  using Checker< AbstractDomain >::out;
   using IntInterval = core::machine_int::Interval;
 
 public:
@@ -65,7 +71,7 @@ public:
 
   /// \brief Check a statement
   void check(ar::Statement* stmt,
-             const value::AbstractDomain& inv,
+             const AbstractDomain& inv,
              CallContext* call_context) override;
 
 private:
@@ -78,7 +84,7 @@ private:
 
   /// \brief Check a shift count
   CheckResult check_shift_count(ar::BinaryOperation* stmt,
-                                const value::AbstractDomain& inv);
+                                const AbstractDomain& inv);
 
   /// \brief Display a shift count check, if requested
   bool display_shift_count_check(Result result,
@@ -86,5 +92,129 @@ private:
 
 }; // end class ShiftCountChecker
 
+template < typename AbstractDomain >
+ShiftCountChecker< AbstractDomain >::ShiftCountChecker(Context& ctx)
+    : Checker< AbstractDomain >(ctx) {}
+
+template < typename AbstractDomain >
+CheckerName ShiftCountChecker< AbstractDomain >::name() const {
+  return CheckerName::ShiftCount;
+}
+
+template < typename AbstractDomain >
+const char* ShiftCountChecker< AbstractDomain >::description() const {
+  return "Shift count checker";
+}
+
+template < typename AbstractDomain >
+void ShiftCountChecker< AbstractDomain >::check(ar::Statement* stmt,
+                                                const AbstractDomain& inv,
+                                                CallContext* call_context) {
+  if (auto bin = dyn_cast< ar::BinaryOperation >(stmt)) {
+    if (bin->op() == ar::BinaryOperation::SShl ||
+        bin->op() == ar::BinaryOperation::UShl ||
+        bin->op() == ar::BinaryOperation::SLShr ||
+        bin->op() == ar::BinaryOperation::ULShr ||
+        bin->op() == ar::BinaryOperation::SAShr ||
+        bin->op() == ar::BinaryOperation::UAShr) {
+      CheckResult check = this->check_shift_count(bin, inv);
+      this->display_invariant(check.result, stmt, inv);
+      this->_checks.insert(check.kind,
+                           CheckerName::ShiftCount,
+                           check.result,
+                           stmt,
+                           call_context,
+                           std::array< ar::Value*, 1 >{{bin->right()}},
+                           check.info);
+    }
+  }
+}
+
+template < typename AbstractDomain >
+typename ShiftCountChecker< AbstractDomain >::CheckResult
+ShiftCountChecker< AbstractDomain >::check_shift_count(
+    ar::BinaryOperation* stmt, const AbstractDomain& inv) {
+  if (inv.is_normal_flow_bottom()) {
+    // Statement unreachable
+    if (this->display_shift_count_check(Result::Unreachable, stmt)) {
+      out() << std::endl;
+    }
+    return {CheckKind::Unreachable, Result::Unreachable, {}};
+  }
+
+  const ScalarLit& shift_count = this->_lit_factory.get_scalar(stmt->right());
+
+  IntInterval shift_count_interval;
+  if (shift_count.is_undefined() ||
+      (shift_count.is_machine_int_var() &&
+       inv.normal().uninitialized().is_uninitialized(shift_count.var()))) {
+    if (this->display_shift_count_check(Result::Error, stmt)) {
+      out() << ": undefined shift count" << std::endl;
+    }
+    return {CheckKind::UninitializedVariable, Result::Error, {}};
+  } else if (shift_count.is_machine_int()) {
+    shift_count_interval = IntInterval(shift_count.machine_int());
+  } else if (shift_count.is_machine_int_var()) {
+    shift_count_interval =
+        inv.normal().integers().to_interval(shift_count.var());
+  } else {
+    log::error("unexpected pointer operand");
+    return {CheckKind::UnexpectedOperand, Result::Error, {}};
+  }
+
+  auto type = cast< ar::IntegerType >(stmt->result()->type());
+  MachineInt zero = MachineInt::zero(type->bit_width(), type->sign());
+  MachineInt limit =
+      MachineInt(type->bit_width() - 1, type->bit_width(), type->sign());
+
+  if (shift_count_interval.ub() < zero) {
+    if (this->display_shift_count_check(Result::Error, stmt)) {
+      out() << ": ∀c ∈ shift_count, c < 0" << std::endl;
+    }
+    return {CheckKind::ShiftCount,
+            Result::Error,
+            to_json(shift_count_interval)};
+  } else if (shift_count_interval.lb() < zero) {
+    if (this->display_shift_count_check(Result::Warning, stmt)) {
+      out() << ": ∃c ∈ shift_count, c < 0" << std::endl;
+    }
+    return {CheckKind::ShiftCount,
+            Result::Warning,
+            to_json(shift_count_interval)};
+  } else if (shift_count_interval.lb() > limit) {
+    if (this->display_shift_count_check(Result::Error, stmt)) {
+      out() << ": ∀c ∈ shift_count, c >= " << type->bit_width() << std::endl;
+    }
+    return {CheckKind::ShiftCount,
+            Result::Error,
+            to_json(shift_count_interval)};
+  } else if (shift_count_interval.ub() > limit) {
+    if (this->display_shift_count_check(Result::Warning, stmt)) {
+      out() << ": ∃c ∈ shift_count, c >= " << type->bit_width() << std::endl;
+    }
+    return {CheckKind::ShiftCount,
+            Result::Warning,
+            to_json(shift_count_interval)};
+  } else {
+    if (this->display_shift_count_check(Result::Ok, stmt)) {
+      out() << ": ∀c ∈ shift_count, 0 <= c < " << type->bit_width()
+            << std::endl;
+    }
+    return {CheckKind::ShiftCount, Result::Ok, {}};
+  }
+}
+
+template < typename AbstractDomain >
+bool ShiftCountChecker< AbstractDomain >::display_shift_count_check(
+    Result result, ar::BinaryOperation* stmt) const {
+  if (this->display_check(result, stmt)) {
+    out() << "check_shc(";
+    stmt->dump(out());
+    out() << ")";
+    return true;
+  }
+  return false;
+}
+
 } // end namespace analyzer
 } // end namespace ikos
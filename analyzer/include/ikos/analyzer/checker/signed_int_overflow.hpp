@@ -49,7 +49,9 @@ namespace ikos {
 namespace analyzer {
 
 /// \brief Signed integer overflow checker
-class SignedIntOverflowChecker final : public IntOverflowCheckerBase {
+template < typename AbstractDomain >
+class SignedIntOverflowChecker final
+    : public IntOverflowCheckerBase< AbstractDomain > {
 public:
   /// \brief Constructor
   explicit SignedIntOverflowChecker(Context& ctx);
@@ -62,7 +64,7 @@ public:
 
   /// \brief Check a statement
   void check(ar::Statement* stmt,
-             const value::AbstractDomain& inv,
+             const AbstractDomain& inv,
              CallContext* call_context) override;
 
 private:
@@ -74,5 +76,46 @@ private:
 
 }; // end class SignedIntOverflowChecker
 
+template < typename AbstractDomain >
+SignedIntOverflowChecker< AbstractDomain >::SignedIntOverflowChecker(
+    Context& ctx)
+    : IntOverflowCheckerBase< AbstractDomain >(ctx) {}
+
+template < typename AbstractDomain >
+CheckerName SignedIntOverflowChecker< AbstractDomain >::name() const {
+  return CheckerName::SignedIntOverflow;
+}
+
+template < typename AbstractDomain >
+const char* SignedIntOverflowChecker< AbstractDomain >::description() const {
+  return "Signed integer overflow checker";
+}
+
+template < typename AbstractDomain >
+void SignedIntOverflowChecker< AbstractDomain >::check(
+    ar::Statement* stmt, const AbstractDomain& inv, CallContext* call_context) {
+  if (auto bin = dyn_cast< ar::BinaryOperation >(stmt)) {
+    if (bin->op() == ar::BinaryOperation::SAdd ||
+        bin->op() == ar::BinaryOperation::SSub ||
+        bin->op() == ar::BinaryOperation::SMul ||
+        bin->op() == ar::BinaryOperation::SDiv ||
+        bin->op() == ar::BinaryOperation::SRem) {
+      this->check_integer_overflow(bin, inv, call_context);
+    }
+  }
+}
+
+template < typename AbstractDomain >
+CheckKind SignedIntOverflowChecker< AbstractDomain >::underflow_check_kind(
+    ) const {
+  return CheckKind::SignedIntUnderflow;
+}
+
+template < typename AbstractDomain >
+CheckKind SignedIntOverflowChecker< AbstractDomain >::overflow_check_kind(
+    ) const {
+  return CheckKind::SignedIntOverflow;
+}
+
 } // end namespace analyzer
 } // end namespace ikos
@@ -46,10 +46,12 @@
 #include <vector>
 
 #include <boost/optional.hpp>
-
 #include <llvm/ADT/SmallVector.h>
 
+#include <ikos/ar/verify/type.hpp>
+
 #include <ikos/analyzer/checker/checker.hpp>
+#include <ikos/analyzer/util/log.hpp>
 
 namespace ikos {
 namespace analyzer {
@@ -57,8 +59,10 @@ namespace analyzer {
 /// \brief Soundness checker
 ///
 /// Warn about any statement that makes the analysis unsound
-class SoundnessChecker final : public Checker {
+template < typename AbstractDomain >
+class SoundnessChecker final : public Checker< AbstractDomain > {
 private:
+  using Checker< AbstractDomain >::out;
   using PointsToSet = core::PointsToSet< MemoryLocation* >;
   using IntInterval = core::machine_int::Interval;
 
@@ -74,7 +78,7 @@ public:
 
   /// \brief Check a statement
   void check(ar::Statement* stmt,
-             const value::AbstractDomain& inv,
+             const AbstractDomain& inv,
              CallContext* call_context) override;
 
 private:
@@ -89,7 +93,7 @@ private:
   void check_mem_access(ar::Statement* stmt,
                         ar::Value* pointer,
                         CheckKind access_kind,
-                        const value::AbstractDomain& inv,
+                        const AbstractDomain& inv,
                         CallContext* call_context);
 
   /// \brief Check a memory access
@@ -97,20 +101,20 @@ private:
       ar::Statement* stmt,
       ar::Value* pointer,
       CheckKind access_kind,
-      const value::AbstractDomain& inv);
+      const AbstractDomain& inv);
 
   /// \brief Check a call to free()
   ///
   /// Check for free() on an unknown pointer, i.e CheckKind::IgnoredFree
   boost::optional< CheckResult > check_free(ar::IntrinsicCall* call,
-                                            const value::AbstractDomain& inv);
+                                            const AbstractDomain& inv);
 
   /// \brief Check a call
   ///
   /// Check for calls to unknown extern function with an unknown pointer
   /// parameter, i.e CheckKind::IgnoredCallSideEffect
   std::vector< CheckResult > check_call(ar::CallBase* call,
-                                        const value::AbstractDomain& inv);
+                                        const AbstractDomain& inv);
 
   /// \brief Return true if the function is an known external function
   static bool is_known_extern_function(ar::Function* fun);
@@ -120,5 +124,419 @@ private:
 
 }; // end class SoundnessChecker
 
+template < typename AbstractDomain >
+SoundnessChecker< AbstractDomain >::SoundnessChecker(Context& ctx)
+    : Checker< AbstractDomain >(ctx) {}
+
+template < typename AbstractDomain >
+CheckerName SoundnessChecker< AbstractDomain >::name() const {
+  return CheckerName::Soundness;
+}
+
+template < typename AbstractDomain >
+const char* SoundnessChecker< AbstractDomain >::description() const {
+  return "Soundness checker";
+}
+
+template < typename AbstractDomain >
+void SoundnessChecker< AbstractDomain >::check(ar::Statement* stmt,
+                                               const AbstractDomain& inv,
+                                               CallContext* call_context) {
+  if (auto store = dyn_cast< ar::Store >(stmt)) {
+    this->check_mem_access(store,
+                           store->pointer(),
+                           CheckKind::IgnoredStore,
+                           inv,
+                           call_context);
+  } else if (auto memcpy = dyn_cast< ar::MemoryCopy >(stmt)) {
+    this->check_mem_access(memcpy,
+                           memcpy->destination(),
+                           CheckKind::IgnoredMemoryCopy,
+                           inv,
+                           call_context);
+  } else if (auto memmove = dyn_cast< ar::MemoryMove >(stmt)) {
+    this->check_mem_access(memmove,
+                           memmove->destination(),
+                           CheckKind::IgnoredMemoryMove,
+                           inv,
+                           call_context);
+  } else if (auto memset = dyn_cast< ar::MemorySet >(stmt)) {
+    this->check_mem_access(memset,
+                           memset->pointer(),
+                           CheckKind::IgnoredMemorySet,
+                           inv,
+                           call_context);
+  } else {
+    if (auto call = dyn_cast< ar::IntrinsicCall >(stmt)) {
+      if (call->intrinsic_id() == ar::Intrinsic::LibcFree ||
+          call->intrinsic_id() == ar::Intrinsic::LibcppDelete ||
+          call->intrinsic_id() == ar::Intrinsic::LibcppDeleteArray ||
+          call->intrinsic_id() == ar::Intrinsic::LibcppFreeException) {
+        if (auto check = this->check_free(call, inv)) {
+          this->display_invariant(check->result, stmt, inv);
+          this->_checks.insert(check->kind,
+                               CheckerName::Soundness,
+                               check->result,
+                               stmt,
+                               call_context,
+                               check->operands);
+        }
+      }
+    }
+    if (auto call = dyn_cast< ar::CallBase >(stmt)) {
+      auto checks = this->check_call(call, inv);
+      for (const auto& check : checks) {
+        this->display_invariant(check.result, stmt, inv);
+        this->_checks.insert(check.kind,
+                             CheckerName::Soundness,
+                             check.result,
+                             stmt,
+                             call_context,
+                             check.operands);
+      }
+    }
+  }
+}
+
+template < typename AbstractDomain >
+void SoundnessChecker< AbstractDomain >::check_mem_access(
+    ar::Statement* stmt,
+    ar::Value* pointer,
+    CheckKind access_kind,
+    const AbstractDomain& inv,
+    CallContext* call_context) {
+  if (auto check = this->check_mem_access(stmt, pointer, access_kind, inv)) {
+    this->display_invariant(check->result, stmt, inv);
+    this->_checks.insert(check->kind,
+                         CheckerName::Soundness,
+                         check->result,
+                         stmt,
+                         call_context,
+                         check->operands);
+  }
+}
+
+template < typename AbstractDomain >
+boost::optional< typename SoundnessChecker< AbstractDomain >::CheckResult >
+SoundnessChecker< AbstractDomain >::check_mem_access(
+    ar::Statement* stmt,
+    ar::Value* pointer,
+    CheckKind access_kind,
+    const AbstractDomain& inv) {
+  if (inv.is_normal_flow_bottom()) {
+    // Statement unreachable
+    if (this->display_soundness_check(Result::Unreachable, stmt)) {
+      out() << std::endl;
+    }
+    return {{CheckKind::Unreachable, Result::Unreachable, {}}};
+  }
+
+  const ScalarLit& ptr = this->_lit_factory.get_scalar(pointer);
+
+  // Check uninitialized
+  if (ptr.is_undefined() ||
+      (ptr.is_pointer_var() &&
+       inv.normal().uninitialized().is_uninitialized(ptr.var()))) {
+    // Undefined pointer operand
+    if (this->display_soundness_check(Result::Error, stmt)) {
+      out() << ": undefined pointer operand" << std::endl;
+    }
+    return {{CheckKind::UninitializedVariable, Result::Error, {pointer}}};
+  }
+
+  // Check null pointer dereference
+  if (ptr.is_null() ||
+      (ptr.is_pointer_var() && inv.normal().nullity().is_null(ptr.var()))) {
+    // Null pointer operand
+    if (this->display_soundness_check(Result::Error, stmt)) {
+      out() << ": null pointer dereference" << std::endl;
+    }
+    return {{CheckKind::NullPointerDereference, Result::Error, {pointer}}};
+  }
+
+  // Check unexpected operand
+  if (!ptr.is_pointer_var()) {
+    log::error("unexpected pointer operand");
+    return {{CheckKind::UnexpectedOperand, Result::Error, {pointer}}};
+  }
+
+  if (isa< ar::GlobalVariable >(pointer) ||
+      isa< ar::FunctionPointerConstant >(pointer)) {
+    // Points-to set is a singleton
+    return boost::none;
+  }
+
+  // Points-to set of the pointer
+  PointsToSet addrs = inv.normal().pointers().points_to(ptr.var());
+
+  if (addrs.is_empty()) {
+    // Pointer is invalid
+    if (this->display_soundness_check(Result::Error, stmt)) {
+      out() << ": empty points-to set for pointer" << std::endl;
+    }
+    return {{CheckKind::InvalidPointerDereference, Result::Error, {pointer}}};
+  }
+
+  if (addrs.is_top()) {
+    // Ignored memory access because points-to set is top
+    if (this->display_soundness_check(Result::Warning, stmt)) {
+      out() << ": ignored memory access because points-to set is top"
+            << std::endl;
+    }
+    return {{access_kind, Result::Warning, {pointer}}};
+  }
+
+  return boost::none;
+}
+
+template < typename AbstractDomain >
+boost::optional< typename SoundnessChecker< AbstractDomain >::CheckResult >
+SoundnessChecker< AbstractDomain >::check_free(ar::IntrinsicCall* call,
+                                               const AbstractDomain& inv) {
+  if (inv.is_normal_flow_bottom()) {
+    // Statement unreachable
+    if (this->display_soundness_check(Result::Unreachable, call)) {
+      out() << std::endl;
+    }
+    return {{CheckKind::Unreachable, Result::Unreachable, {}}};
+  }
+
+  ikos_assert(call->num_arguments() == 1);
+
+  auto pointer = call->argument(0);
+  const ScalarLit& ptr = this->_lit_factory.get_scalar(pointer);
+
+  // Check uninitialized
+  if (ptr.is_undefined() ||
+      (ptr.is_pointer_var() &&
+       inv.normal().uninitialized().is_uninitialized(ptr.var()))) {
+    // Undefined pointer operand
+    if (this->display_soundness_check(Result::Error, call)) {
+      out() << ": undefined pointer operand" << std::endl;
+    }
+    return {{CheckKind::UninitializedVariable, Result::Error, {pointer}}};
+  }
+
+  // Check null pointer dereference
+  if (ptr.is_null() ||
+      (ptr.is_pointer_var() && inv.normal().nullity().is_null(ptr.var()))) {
+    // Null pointer argument, safe
+    if (this->display_soundness_check(Result::Error, call)) {
+      out() << ": safe call to free with NULL value" << std::endl;
+    }
+    return {{CheckKind::Free, Result::Ok, {pointer}}};
+  }
+
+  // Check unexpected operand
+  if (!ptr.is_pointer_var()) {
+    log::error("unexpected pointer operand");
+    return {{CheckKind::UnexpectedOperand, Result::Error, {pointer}}};
+  }
+
+  if (isa< ar::GlobalVariable >(pointer) ||
+      isa< ar::FunctionPointerConstant >(pointer)) {
+    // Points-to set is a singleton
+    return boost::none;
+  }
+
+  // Points-to set of the pointer
+  PointsToSet addrs = inv.normal().pointers().points_to(ptr.var());
+
+  if (addrs.is_top()) {
+    // Ignored memory access because points-to set is top
+    if (this->display_soundness_check(Result::Warning, call)) {
+      out() << ": ignored memory deallocation because points-to set is top"
+            << std::endl;
+    }
+    return {{CheckKind::IgnoredFree, Result::Warning, {pointer}}};
+  }
+
+  return boost::none;
+}
+
+template < typename AbstractDomain >
+std::vector< typename SoundnessChecker< AbstractDomain >::CheckResult >
+SoundnessChecker< AbstractDomain >::check_call(ar::CallBase* call,
+                                               const AbstractDomain& inv) {
+  if (inv.is_normal_flow_bottom()) {
+    // Statement unreachable
+    if (this->display_soundness_check(Result::Unreachable, call)) {
+      out() << std::endl;
+    }
+    return {{CheckKind::Unreachable, Result::Unreachable, {}}};
+  }
+
+  const ScalarLit& called = this->_lit_factory.get_scalar(call->called());
+
+  // Check uninitialized
+
+  if (called.is_undefined() ||
+      (called.is_pointer_var() &&
+       inv.normal().uninitialized().is_uninitialized(called.var()))) {
+    // Undefined call pointer operand
+    if (this->display_soundness_check(Result::Error, call)) {
+      out() << ": undefined call pointer operand" << std::endl;
+    }
+    return {{
+        CheckKind::UninitializedVariable, Result::Error, {call->called()},
+    }};
+  }
+
+  // Check null pointer dereference
+
+  if (called.is_null() || (called.is_pointer_var() &&
+                           inv.normal().nullity().is_null(called.var()))) {
+    // Null call pointer operand
+    if (this->display_soundness_check(Result::Error, call)) {
+      out() << ": null call pointer operand" << std::endl;
+    }
+    return {
+        {CheckKind::NullPointerDereference, Result::Error, {call->called()}}};
+  }
+
+  // Collect potential callees
+  PointsToSet callees;
+
+  if (auto cst = dyn_cast< ar::FunctionPointerConstant >(call->called())) {
+    callees = {this->_ctx.mem_factory->get_function(cst->function())};
+  } else if (isa< ar::InlineAssemblyConstant >(call->called())) {
+    // call to inline assembly
+    if (this->display_soundness_check(Result::Ok, call)) {
+      out() << ": call to inline assembly" << std::endl;
+    }
+    return {{CheckKind::FunctionCallInlineAssembly, Result::Ok, {}}};
+  } else if (auto gv = dyn_cast< ar::GlobalVariable >(call->called())) {
+    callees = {this->_ctx.mem_factory->get_global(gv)};
+  } else if (auto lv = dyn_cast< ar::LocalVariable >(call->called())) {
+    callees = {this->_ctx.mem_factory->get_local(lv)};
+  } else if (isa< ar::InternalVariable >(call->called())) {
+    // Indirect call through a function pointer
+    callees = inv.normal().pointers().points_to(called.var());
+  } else {
+    log::error("unexpected call pointer operand");
+    return {{CheckKind::UnexpectedOperand, Result::Error, {call->called()}}};
+  }
+
+  // Check callees
+  ikos_assert(!callees.is_bottom());
+  if (callees.is_empty()) {
+    // Invalid pointer dereference
+    if (this->display_soundness_check(Result::Error, call)) {
+      out() << ": points-to set of function pointer is empty" << std::endl;
+    }
+    return {{CheckKind::InvalidPointerDereference,
+             Result::Error,
+             {call->called()}}};
+  } else if (callees.is_top()) {
+    // No points-to set
+    if (this->display_soundness_check(Result::Warning, call)) {
+      out() << ": no points-to set for function pointer" << std::endl;
+    }
+    return {{CheckKind::UnknownFunctionCallPointer,
+             Result::Warning,
+             {call->called()}}};
+  }
+
+  // Is it calling an unknown extern function
+  bool calls_unknown_extern_function =
+      std::any_of(callees.begin(), callees.end(), [call](MemoryLocation* addr) {
+        if (!isa< FunctionMemoryLocation >(addr)) {
+          return false;
+        }
+        ar::Function* callee = cast< FunctionMemoryLocation >(addr)->function();
+        return callee->is_declaration() &&
+               ar::TypeVerifier::is_valid_call(call, callee->type()) &&
+               !is_known_extern_function(callee);
+      });
+
+  if (!calls_unknown_extern_function) {
+    return {}; // sound function call
+  }
+
+  std::vector< CheckResult > checks;
+
+  for (auto it = call->arg_begin(), et = call->arg_end(); it != et; ++it) {
+    ar::Value* arg = *it;
+    if (isa< ar::InternalVariable >(arg) && arg->type()->is_pointer()) {
+      const ScalarLit& ptr = this->_lit_factory.get_scalar(arg);
+      ikos_assert(ptr.is_pointer_var());
+
+      if (!inv.normal().uninitialized().is_uninitialized(ptr.var()) &&
+          !inv.normal().nullity().is_null(ptr.var()) &&
+          inv.normal().pointers().points_to(ptr.var()).is_top()) {
+        // Ignored side effect on the memory because points-to set is top
+        if (this->display_soundness_check(Result::Warning, call)) {
+          out() << ": ignored call side effect on pointer ";
+          arg->dump(out());
+          out() << " because points-to set is top" << std::endl;
+        }
+        checks.push_back(
+            {CheckKind::IgnoredCallSideEffect, Result::Warning, {arg}});
+      }
+    }
+  }
+
+  return checks;
+}
+
+template < typename AbstractDomain >
+bool SoundnessChecker< AbstractDomain >::is_known_extern_function(
+    ar::Function* fun) {
+  ikos_assert(fun->is_declaration());
+
+  if (!fun->is_intrinsic()) {
+    return false;
+  }
+
+  // This needs to be up to date with
+  // NumericalExecutionEngine::exec_intrinsic_call()
+  switch (fun->intrinsic_id()) {
+    case ar::Intrinsic::MemoryCopy:
+    case ar::Intrinsic::MemoryMove:
+    case ar::Intrinsic::MemorySet:
+    case ar::Intrinsic::LibcMalloc:
+    case ar::Intrinsic::LibcCalloc:
+    case ar::Intrinsic::LibcppNew:
+    case ar::Intrinsic::LibcppNewArray:
+    case ar::Intrinsic::LibcppAllocateException:
+    case ar::Intrinsic::LibcFree:
+    case ar::Intrinsic::LibcppDelete:
+    case ar::Intrinsic::LibcppDeleteArray:
+    case ar::Intrinsic::LibcppFreeException:
+    case ar::Intrinsic::LibcRead:
+    case ar::Intrinsic::LibcppThrow:
+    case ar::Intrinsic::LibcppBeginCatch:
+    case ar::Intrinsic::LibcStrlen:
+    case ar::Intrinsic::LibcStrnlen:
+    case ar::Intrinsic::LibcStrcpy:
+    case ar::Intrinsic::LibcStrncpy:
+    case ar::Intrinsic::LibcStrcat:
+    case ar::Intrinsic::LibcStrncat:
+    case ar::Intrinsic::IkosAssert:
+    case ar::Intrinsic::IkosAssume:
+    case ar::Intrinsic::IkosPrintInvariant:
+    case ar::Intrinsic::IkosPrintValues:
+    case ar::Intrinsic::IkosNonDetSi32:
+    case ar::Intrinsic::IkosNonDetUi32:
+    case ar::Intrinsic::IkosCounterInit:
+    case ar::Intrinsic::IkosCounterIncr:
+      return true;
+    default:
+      return false;
+  }
+}
+
+template < typename AbstractDomain >
+bool SoundnessChecker< AbstractDomain >::display_soundness_check(
+    Result result, ar::Statement* stmt) const {
+  if (this->display_check(result, stmt)) {
+    out() << "check_soundness(";
+    stmt->dump(out());
+    out() << ")";
+    return true;
+  }
+  return false;
+}
+
 } // end namespace analyzer
 } // end namespace ikos
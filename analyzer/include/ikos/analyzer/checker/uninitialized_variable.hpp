@@ -46,12 +46,17 @@
 #include <boost/optional.hpp>
 
 #include <ikos/analyzer/checker/checker.hpp>
+#include <ikos/analyzer/support/cast.hpp>
 
 namespace ikos {
 namespace analyzer {
 
 /// \brief Uninitialized variable checker
-class UninitializedVariableChecker final : public Checker {
+template < typename AbstractDomain >
+class UninitializedVariableChecker final : public Checker< AbstractDomain > {
+private:
+  using Checker< AbstractDomain >::out;
+
 public:
   /// \brief Constructor
   explicit UninitializedVariableChecker(Context& ctx);
@@ -64,13 +69,13 @@ public:
 
   /// \brief Check a statement
   void check(ar::Statement* stmt,
-             const value::AbstractDomain& inv,
+             const AbstractDomain& inv,
              CallContext* call_context) override;
 
 private:
   /// \brief Check an operand
   boost::optional< Result > check_initialized(ar::Value* operand,
-                                              const value::AbstractDomain& inv);
+                                              const AbstractDomain& inv);
 
 private:
   /// \brief Dispay a uninitialized variable check, if requested
@@ -83,5 +88,115 @@ private:
 
 }; // end class UninitializedVariableChecker
 
+template < typename AbstractDomain >
+UninitializedVariableChecker< AbstractDomain >::UninitializedVariableChecker(
+    Context& ctx)
+    : Checker< AbstractDomain >(ctx) {}
+
+template < typename AbstractDomain >
+CheckerName UninitializedVariableChecker< AbstractDomain >::name() const {
+  return CheckerName::UninitializedVariable;
+}
+
+template < typename AbstractDomain >
+const char* UninitializedVariableChecker< AbstractDomain >::description(
+    ) const {
+  return "Uninitialized variable checker";
+}
+
+template < typename AbstractDomain >
+void UninitializedVariableChecker< AbstractDomain >::check(
+    ar::Statement* stmt, const AbstractDomain& inv, CallContext* call_context) {
+  if (isa< ar::Assignment >(stmt)) {
+    // Assignments propagate the undefinedness
+    // No checks
+    return;
+  }
+
+  if (inv.is_normal_flow_bottom()) {
+    // Statement is unreachable
+    // No checks
+    return;
+  }
+
+  // Check each operand
+  for (auto it = stmt->op_begin(), et = stmt->op_end(); it != et; ++it) {
+    ar::Value* operand = *it;
+
+    if (auto result = this->check_initialized(operand, inv)) {
+      this->display_initialized_check(*result, stmt, operand);
+      this->display_invariant(*result, stmt, inv);
+      this->_checks.insert(CheckKind::UninitializedVariable,
+                           CheckerName::UninitializedVariable,
+                           *result,
+                           stmt,
+                           call_context,
+                           std::array< ar::Value*, 1 >{{operand}});
+    }
+  }
+}
+
+template < typename AbstractDomain >
+boost::optional< Result >
+UninitializedVariableChecker< AbstractDomain >::check_initialized(
+    ar::Value* operand, const AbstractDomain& inv) {
+  if (isa< ar::UndefinedConstant >(operand)) {
+    return Result::Error;
+  } else if (isa< ar::IntegerConstant >(operand)) {
+    return boost::none;
+  } else if (isa< ar::FloatConstant >(operand)) {
+    return boost::none;
+  } else if (isa< ar::NullConstant >(operand)) {
+    return boost::none;
+  } else if (isa< ar::StructConstant >(operand)) {
+    return boost::none;
+  } else if (isa< ar::ArrayConstant >(operand)) {
+    return boost::none;
+  } else if (isa< ar::VectorConstant >(operand)) {
+    return boost::none;
+  } else if (isa< ar::AggregateZeroConstant >(operand)) {
+    return boost::none;
+  } else if (isa< ar::FunctionPointerConstant >(operand)) {
+    return Result::Ok;
+  } else if (isa< ar::InlineAssemblyConstant >(operand)) {
+    return Result::Ok;
+  } else if (isa< ar::GlobalVariable >(operand)) {
+    return Result::Ok;
+  } else if (isa< ar::LocalVariable >(operand)) {
+    return Result::Ok;
+  } else if (auto iv = dyn_cast< ar::InternalVariable >(operand)) {
+    Variable* var = this->_ctx.var_factory->get_internal(iv);
+    core::Uninitialized uninit_val = inv.normal().uninitialized().get(var);
+
+    if (uninit_val.is_uninitialized()) {
+      return Result::Error;
+    } else if (uninit_val.is_initialized()) {
+      return Result::Ok;
+    } else {
+      return Result::Warning;
+    }
+  } else {
+    ikos_unreachable("unreachable");
+  }
+}
+
+template < typename AbstractDomain >
+void UninitializedVariableChecker< AbstractDomain >::display_initialized_check(
+    Result result, ar::Statement* stmt) const {
+  if (this->display_check(result, stmt)) {
+    out() << "check_initialized()" << std::endl;
+  }
+}
+
+template < typename AbstractDomain >
+void UninitializedVariableChecker< AbstractDomain >::display_initialized_check(
+    Result result, ar::Statement* stmt, ar::Value* operand) const {
+  if (this->display_check(result, stmt)) {
+    out() << "check_initialized(";
+    operand->dump(out());
+    out() << ")" << std::endl;
+  }
+}
+
 } // end namespace analyzer
 } // end namespace ikos
@@ -49,7 +49,9 @@ namespace ikos {
 namespace analyzer {
 
 /// \brief Unsigned integer overflow checker
-class UnsignedIntOverflowChecker final : public IntOverflowCheckerBase {
+template < typename AbstractDomain >
+class UnsignedIntOverflowChecker final
+    : public IntOverflowCheckerBase< AbstractDomain > {
 public:
   /// \brief Constructor
   explicit UnsignedIntOverflowChecker(Context& ctx);
@@ -62,7 +64,7 @@ public:
 
   /// \brief Check a statement
   void check(ar::Statement* stmt,
-             const value::AbstractDomain& inv,
+             const AbstractDomain& inv,
              CallContext* call_context) override;
 
 private:
@@ -74,5 +76,45 @@ private:
 
 }; // end class UnsignedIntOverflowChecker
 
+template < typename AbstractDomain >
+UnsignedIntOverflowChecker< AbstractDomain >::UnsignedIntOverflowChecker(
+    Context& ctx)
+    : IntOverflowCheckerBase< AbstractDomain >(ctx) {}
+
+template < typename AbstractDomain >
+CheckerName UnsignedIntOverflowChecker< AbstractDomain >::name() const {
+  return CheckerName::UnsignedIntOverflow;
+}
+
+template < typename AbstractDomain >
+const char* UnsignedIntOverflowChecker< AbstractDomain >::description() const {
+  return "Unsigned integer overflow checker";
+}
+
+template < typename AbstractDomain >
+void UnsignedIntOverflowChecker< AbstractDomain >::check(
+    ar::Statement* stmt, const AbstractDomain& inv, CallContext* call_context) {
+  if (auto bin = dyn_cast< ar::BinaryOperation >(stmt)) {
+    if (bin->op() == ar::BinaryOperation::UAdd ||
+        bin->op() == ar::BinaryOperation::USub ||
+        bin->op() == ar::BinaryOperation::UMul ||
+        bin->op() == ar::BinaryOperation::UDiv) {
+      this->check_integer_overflow(bin, inv, call_context);
+    }
+  }
+}
+
+template < typename AbstractDomain >
+CheckKind UnsignedIntOverflowChecker< AbstractDomain >::underflow_check_kind(
+    ) const {
+  return CheckKind::UnsignedIntUnderflow;
+}
+
+template < typename AbstractDomain >
+CheckKind UnsignedIntOverflowChecker< AbstractDomain >::overflow_check_kind(
+    ) const {
+  return CheckKind::UnsignedIntOverflow;
+}
+
 } // end namespace analyzer
 } // end namespace ikos
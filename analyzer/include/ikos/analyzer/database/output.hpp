@@ -52,6 +52,7 @@
 #include <ikos/analyzer/database/table/operands.hpp>
 #include <ikos/analyzer/database/table/settings.hpp>
 #include <ikos/analyzer/database/table/statements.hpp>
+#include <ikos/analyzer/database/table/statistics.hpp>
 #include <ikos/analyzer/database/table/times.hpp>
 
 namespace ikos {
@@ -63,6 +64,7 @@ public:
   sqlite::DbConnection& db;
   SettingsTable settings;
   TimesTable times;
+  StatisticsTable statistics;
   FilesTable files;
   FunctionsTable functions;
   StatementsTable statements;
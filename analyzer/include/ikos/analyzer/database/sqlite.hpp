@@ -46,6 +46,7 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <string>
 
 #include <sqlite3.h>
@@ -161,6 +162,11 @@ private:
   /// \brief Number of inserted rows, in CommitPolicy::Auto
   std::size_t _inserted_rows = 0;
 
+  /// \brief Mutex serializing the insertions in the tables
+  ///
+  /// It is recursive because a table might insert rows in other tables.
+  std::recursive_mutex _mutex;
+
 public:
   /// \brief Deleted default constructor
   DbConnection() = delete;
@@ -207,6 +213,12 @@ public:
   /// \brief Return the current commit policy
   CommitPolicy commit_policy() const { return this->_commit_policy; }
 
+  /// \brief Return the mutex serializing the insertions in the tables
+  ///
+  /// Tables lock it on each insertion, so that several threads can write
+  /// results in the database.
+  std::recursive_mutex& mutex() { return this->_mutex; }
+
 private:
   /// \brief Called upon a row insertion
   void row_inserted();
@@ -0,0 +1,105 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Parallel execution utilities
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2011-2018 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+
+#include <ikos/core/support/thread_pool.hpp>
+
+namespace ikos {
+namespace analyzer {
+
+/// \brief Call `f(i)` for each index i in [0, n), using `jobs` threads
+///
+/// The calling thread and up to `jobs - 1` threads of the global
+/// core::ThreadPool pull the next index from a shared counter, hence indexes
+/// are processed in increasing order of start time, but may complete in any
+/// order. If the pool has no thread available, the calling thread processes
+/// the remaining indexes.
+///
+/// If `f` throws an exception, the remaining indexes are skipped and the first
+/// exception is rethrown once all threads are finished.
+///
+/// With jobs <= 1, everything runs on the calling thread.
+template < typename Function >
+void parallel_for(unsigned jobs, std::size_t n, Function f) {
+  if (jobs <= 1 || n <= 1) {
+    for (std::size_t i = 0; i < n; i++) {
+      f(i);
+    }
+    return;
+  }
+
+  std::atomic< std::size_t > next(0);
+  std::mutex error_mutex;
+  std::exception_ptr error = nullptr;
+
+  auto worker = [&]() {
+    try {
+      for (std::size_t i = next++; i < n; i = next++) {
+        f(i);
+      }
+    } catch (...) {
+      std::lock_guard< std::mutex > lock(error_mutex);
+      if (error == nullptr) {
+        error = std::current_exception();
+      }
+      next = n;
+    }
+  };
+
+  auto helpers = static_cast< unsigned >(std::min< std::size_t >(jobs, n) - 1);
+  core::ThreadPool::get().run(helpers, worker);
+
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
+}
+
+} // end namespace analyzer
+} // end namespace ikos
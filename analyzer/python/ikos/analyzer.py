@@ -140,6 +140,12 @@ def parse_arguments(argv):
                           help='Disable the liveness analysis',
                           action='store_true',
                           default=False)
+    analysis.add_argument('--no-syntactic-packing',
+                          dest='no_syntactic_packing',
+                          help='Disable the syntactic variable packing '
+                               'analysis',
+                          action='store_true',
+                          default=False)
     analysis.add_argument('--no-pointer',
                           dest='no_pointer',
                           help='Disable the pointer analysis',
@@ -150,6 +156,13 @@ def parse_arguments(argv):
                           help='Disable the fixpoint profiles analysis',
                           action='store_true',
                           default=False)
+    analysis.add_argument('--sparse-invariants',
+                          dest='sparse_invariants',
+                          help='Only store invariants at cycle heads and join '
+                               'points, recompute the others during the '
+                               'checks. Reduces memory usage',
+                          action='store_true',
+                          default=False)
     analysis.add_argument('--prec',
                           dest='precision_level',
                           metavar='',
@@ -182,6 +195,21 @@ def parse_arguments(argv):
                           metavar='',
                           help='Specify a value for argc',
                           type=int)
+    analysis.add_argument('-j', '--jobs',
+                          dest='jobs',
+                          metavar='<n>',
+                          help='Number of threads used by the pointer and '
+                               'value analyses (default: 1)',
+                          type=int,
+                          default=1)
+    analysis.add_argument('--fixpoint-jobs',
+                          dest='fixpoint_jobs',
+                          metavar='<n>',
+                          help='Number of threads used to analyze independent '
+                               'parts of a function, no effect with '
+                               '--proc=inter (default: 1)',
+                          type=int,
+                          default=1)
 
     # Preprocessing options
     preprocess = parser.add_argument_group('Preprocessing Options')
@@ -260,6 +288,11 @@ def parse_arguments(argv):
                        help='Display liveness analysis results',
                        action='store_true',
                        default=False)
+    debug.add_argument('--display-variable-packing',
+                       dest='display_variable_packing',
+                       help='Display variable packing analysis results',
+                       action='store_true',
+                       default=False)
     debug.add_argument('--display-function-pointer',
                        dest='display_function_pointer',
                        help='Display function pointer analysis results',
@@ -586,16 +619,24 @@ def ikos_analyzer(db_path, pp_path, opt):
         cmd.append('-no-init-globals=%s' % ','.join(opt.no_init_globals))
     if opt.no_liveness:
         cmd.append('-no-liveness')
+    if opt.no_syntactic_packing:
+        cmd.append('-no-syntactic-packing')
     if opt.no_pointer:
         cmd.append('-no-pointer')
     if opt.no_fixpoint_profiles:
         cmd.append('-no-fixpoint-profiles')
+    if opt.sparse_invariants:
+        cmd.append('-sparse-invariants')
     if opt.hardware_addresses:
         cmd.append('-hardware-addresses=%s' % ','.join(opt.hardware_addresses))
     if opt.hardware_addresses_file:
         cmd.append('-hardware-addresses-file=%s' % opt.hardware_addresses_file)
     if opt.argc is not None:
         cmd.append('-argc=%d' % opt.argc)
+    if opt.jobs > 1:
+        cmd.append('-j=%d' % opt.jobs)
+    if opt.fixpoint_jobs > 1:
+        cmd.append('-fixpoint-jobs=%d' % opt.fixpoint_jobs)
 
     # import options
     if opt.no_libc:
@@ -627,6 +668,8 @@ def ikos_analyzer(db_path, pp_path, opt):
         cmd.append('-display-ar')
     if opt.display_liveness:
         cmd.append('-display-liveness')
+    if opt.display_variable_packing:
+        cmd.append('-display-variable-packing')
     if opt.display_function_pointer:
         cmd.append('-display-function-pointer')
     if opt.display_pointer:
@@ -640,6 +683,7 @@ def ikos_analyzer(db_path, pp_path, opt):
     if (opt.display_checks in ('all', 'fail') or
             opt.display_inv in ('all', 'fail') or
             opt.display_liveness or
+            opt.display_variable_packing or
             opt.display_fixpoint_profiles or
             opt.display_function_pointer or
             opt.display_pointer or
@@ -825,6 +869,8 @@ def main(argv):
             if not first:
                 printf('\n')
             report.print_timing_results(db, opt.display_times == 'full')
+            if opt.display_times == 'full':
+                report.print_statistics(db)
             first = False
 
         # display summary
@@ -178,6 +178,12 @@ domains = (
      'Reduced product of Interval and Congruence'),
     ('dbm',
      'Difference-Bound Matrices domain'),
+    ('sparse-dbm',
+     'Sparse Difference-Bound Matrices domain'),
+    ('native-dbm',
+     'Difference-Bound Matrices domain on machine integers'),
+    ('octagon',
+     'Octagon domain'),
     ('var-pack-dbm',
      'Difference-Bound Matrices domain with variable packing'),
     ('var-pack-dbm-congruence',
@@ -237,6 +243,7 @@ default_precision_level = 'mem'
 proceduralities = (
     ('inter', 'Interprocedural analysis'),
     ('intra', 'Intraprocedural analysis'),
+    ('summary', 'Bottom-up summary-based analysis'),
 )
 
 default_procedurality = 'inter'
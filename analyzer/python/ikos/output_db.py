@@ -84,6 +84,21 @@ def load_timing_results(db, full=True, sort=True):
     return c.fetchall()
 
 
+##############
+# statistics #
+##############
+
+
+def load_statistics(db):
+    '''
+    Return the statistics from the database,
+    as a list of tuples (name, value)
+    '''
+    c = db.cursor()
+    c.execute('SELECT name, value FROM statistics ORDER BY name')
+    return c.fetchall()
+
+
 ##########
 # checks #
 ##########
@@ -61,8 +61,8 @@ from ikos.enums import Result, CheckKind, CheckerName, ValueKind, \
     BufferOverflowCheckKind, ChecksTable
 from ikos.log import printf
 from ikos.output_db import load_settings, load_timing_results, \
-    OutputDatabase, File, Function, Statement, CallContext, Operand, \
-    NumOperandPair, MemoryLocation, Check
+    load_statistics, OutputDatabase, File, Function, Statement, CallContext, \
+    Operand, NumOperandPair, MemoryLocation, Check
 
 
 ##################
@@ -106,6 +106,18 @@ def print_timing_results(db, full=True, sort=True):
         printf('%s: %s\n', name.ljust(name_width), format_time(elapsed))
 
 
+def print_statistics(db):
+    ''' Print the statistics from the database '''
+    results = load_statistics(db)
+    if not results:
+        return
+
+    printf(bold('# Statistics:') + '\n')
+    name_width = max(len(name) for name, _ in results)
+    for name, value in results:
+        printf('%s: %d\n', name.ljust(name_width), value)
+
+
 ###########
 # summary #
 ###########
@@ -1940,6 +1952,8 @@ def main(argv):
             if not first:
                 printf('\n')
             print_timing_results(db, opt.display_times == 'full')
+            if opt.display_times == 'full':
+                print_statistics(db)
             first = False
 
         # display summary
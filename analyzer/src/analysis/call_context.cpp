@@ -53,6 +53,7 @@ CallContextFactory::~CallContextFactory() = default;
 
 CallContext* CallContextFactory::get_context(CallContext* parent,
                                              ar::CallBase* call) {
+  std::lock_guard< std::recursive_mutex > lock(this->_mutex);
   ikos_assert(parent != nullptr && call != nullptr);
   auto it = this->_map.find({parent, call});
   if (it == this->_map.end()) {
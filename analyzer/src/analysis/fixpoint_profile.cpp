@@ -46,6 +46,7 @@
 #include <ikos/ar/semantic/statement.hpp>
 
 #include <ikos/analyzer/analysis/fixpoint_profile.hpp>
+#include <ikos/analyzer/analysis/wto.hpp>
 #include <ikos/analyzer/support/cast.hpp>
 
 namespace ikos {
@@ -190,7 +191,7 @@ std::unique_ptr< FixpointProfile > FixpointProfileAnalysis::analyze_function(
 
   std::unique_ptr< FixpointProfile > profile(new FixpointProfile(fun));
   FixpointProfileWtoVisitor visitor(&profile->_widening_hints);
-  core::Wto< ar::Code* > wto(fun->body());
+  core::Wto< ar::Code* > wto = this->_ctx.wto_cache->get(fun->body());
   wto.accept(visitor);
   if (!profile->empty()) {
     return profile;
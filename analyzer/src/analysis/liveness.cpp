@@ -43,6 +43,7 @@
  *
  ******************************************************************************/
 
+#include <ikos/core/adt/bitset_set.hpp>
 #include <ikos/core/domain/discrete_domain.hpp>
 #include <ikos/core/fixpoint/fwd_fixpoint_iterator.hpp>
 
@@ -61,11 +62,13 @@ namespace {
 /// This is a small wrapper around core::DiscreteDomain, with a few changes:
 ///   * The default constructor returns bottom
 ///   * Has convenient operator+ and operator-
+///   * Sets are bitsets, since variable indexes are dense
 template < typename VariableRef >
 class LivenessDomain final
     : public core::AbstractDomain< LivenessDomain< VariableRef > > {
 private:
-  using DiscreteDomain = core::DiscreteDomain< VariableRef >;
+  using DiscreteDomain =
+      core::DiscreteDomain< VariableRef, core::BitsetSet< VariableRef > >;
 
 public:
   using Iterator = typename DiscreteDomain::Iterator;
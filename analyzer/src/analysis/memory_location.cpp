@@ -51,7 +51,8 @@ namespace analyzer {
 
 // MemoryLocation
 
-MemoryLocation::MemoryLocation(MemoryLocationKind kind) : _kind(kind) {}
+MemoryLocation::MemoryLocation(MemoryLocationKind kind)
+    : _kind(kind), _index(0) {}
 
 MemoryLocation::~MemoryLocation() = default;
 
@@ -157,14 +158,23 @@ void DynAllocMemoryLocation::dump(std::ostream& o) const {
 
 MemoryFactory::MemoryFactory()
     : _absolute_zero_memory(std::make_unique< AbsoluteZeroMemoryLocation >()),
-      _argv_memory(std::make_unique< ArgvMemoryLocation >()) {}
+      _argv_memory(std::make_unique< ArgvMemoryLocation >()) {
+  this->assign_index(this->_absolute_zero_memory.get());
+  this->assign_index(this->_argv_memory.get());
+}
 
 MemoryFactory::~MemoryFactory() = default;
 
+void MemoryFactory::assign_index(MemoryLocation* ml) {
+  ml->_index = this->_next_index++;
+}
+
 LocalMemoryLocation* MemoryFactory::get_local(ar::LocalVariable* var) {
+  std::lock_guard< std::recursive_mutex > lock(this->_mutex);
   auto it = this->_local_memory_map.find(var);
   if (it == this->_local_memory_map.end()) {
     auto ml = new LocalMemoryLocation(var);
+    this->assign_index(ml);
     this->_local_memory_map.try_emplace(var,
                                         std::unique_ptr< LocalMemoryLocation >(
                                             ml));
@@ -175,9 +185,11 @@ LocalMemoryLocation* MemoryFactory::get_local(ar::LocalVariable* var) {
 }
 
 GlobalMemoryLocation* MemoryFactory::get_global(ar::GlobalVariable* var) {
+  std::lock_guard< std::recursive_mutex > lock(this->_mutex);
   auto it = this->_global_memory_map.find(var);
   if (it == this->_global_memory_map.end()) {
     auto ml = new GlobalMemoryLocation(var);
+    this->assign_index(ml);
     this->_global_memory_map
         .try_emplace(var, std::unique_ptr< GlobalMemoryLocation >(ml));
     return ml;
@@ -187,9 +199,11 @@ GlobalMemoryLocation* MemoryFactory::get_global(ar::GlobalVariable* var) {
 }
 
 FunctionMemoryLocation* MemoryFactory::get_function(ar::Function* fun) {
+  std::lock_guard< std::recursive_mutex > lock(this->_mutex);
   auto it = this->_function_memory_map.find(fun);
   if (it == this->_function_memory_map.end()) {
     auto ml = new FunctionMemoryLocation(fun);
+    this->assign_index(ml);
     this->_function_memory_map
         .try_emplace(fun, std::unique_ptr< FunctionMemoryLocation >(ml));
     return ml;
@@ -205,9 +219,11 @@ FunctionMemoryLocation* MemoryFactory::get_function(
 
 AggregateMemoryLocation* MemoryFactory::get_aggregate(
     ar::InternalVariable* var) {
+  std::lock_guard< std::recursive_mutex > lock(this->_mutex);
   auto it = this->_aggregate_memory_map.find(var);
   if (it == this->_aggregate_memory_map.end()) {
     auto ml = new AggregateMemoryLocation(var);
+    this->assign_index(ml);
     this->_aggregate_memory_map
         .try_emplace(var, std::unique_ptr< AggregateMemoryLocation >(ml));
     return ml;
@@ -217,9 +233,11 @@ AggregateMemoryLocation* MemoryFactory::get_aggregate(
 }
 
 VaArgMemoryLocation* MemoryFactory::get_va_arg(llvm::StringRef sv) {
+  std::lock_guard< std::recursive_mutex > lock(this->_mutex);
   auto it = this->_va_arg_map.find(sv);
   if (it == this->_va_arg_map.end()) {
     auto ml = new VaArgMemoryLocation(sv);
+    this->assign_index(ml);
     this->_va_arg_map.try_emplace(sv,
                                   std::unique_ptr< VaArgMemoryLocation >(ml));
     return ml;
@@ -238,9 +256,11 @@ ArgvMemoryLocation* MemoryFactory::get_argv() {
 
 DynAllocMemoryLocation* MemoryFactory::get_dyn_alloc(ar::CallBase* call,
                                                      CallContext* context) {
+  std::lock_guard< std::recursive_mutex > lock(this->_mutex);
   auto it = this->_dyn_alloc_map.find({call, context});
   if (it == this->_dyn_alloc_map.end()) {
     auto ml = new DynAllocMemoryLocation(call, context);
+    this->assign_index(ml);
     this->_dyn_alloc_map.try_emplace({call, context},
                                      std::unique_ptr< DynAllocMemoryLocation >(
                                          ml));
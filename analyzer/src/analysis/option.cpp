@@ -50,6 +50,13 @@
 namespace ikos {
 namespace analyzer {
 
+unsigned AnalysisOptions::value_jobs() const {
+  if (machine_int_domain_option_uses_apron(this->machine_int_domain)) {
+    return 1;
+  }
+  return this->jobs;
+}
+
 void AnalysisOptions::save(SettingsTable& table) {
   auto function_name = [](ar::Function* fun) { return fun->name(); };
 
@@ -76,9 +83,12 @@ void AnalysisOptions::save(SettingsTable& table) {
   table.insert("procedural", procedural_str(this->procedural));
 
   table.insert("use-liveness", this->use_liveness);
+  table.insert("use-syntactic-packing", this->use_syntactic_packing);
 
   table.insert("use-pointer-analysis", this->use_pointer);
 
+  table.insert("sparse-invariants", this->sparse_invariants);
+
   table.insert("precision-level", precision_str(this->precision));
 
   table.insert("globals-init-policy",
@@ -93,6 +103,10 @@ void AnalysisOptions::save(SettingsTable& table) {
   if (this->argc) {
     table.insert("argc", std::to_string(*this->argc));
   }
+
+  table.insert("jobs", std::to_string(this->jobs));
+
+  table.insert("fixpoint-jobs", std::to_string(this->fixpoint_jobs));
 }
 
 } // end namespace analyzer
@@ -58,6 +58,10 @@ void PointerConstraints::add(std::unique_ptr< PointerConstraint > cst) {
   this->_system.add(std::move(cst));
 }
 
+void PointerConstraints::merge(PointerConstraints&& other) {
+  this->_system.merge(std::move(other._system));
+}
+
 void PointerConstraints::solve() {
   this->_system.solve();
 }
@@ -73,6 +77,10 @@ void PointerConstraints::results(PointerInfo& info) const {
   }
 }
 
+const std::vector< PointerCycle >& PointerConstraints::cycles() const {
+  return this->_system.cycles();
+}
+
 void PointerConstraints::dump(std::ostream& o) const {
   this->_system.dump(o);
 }
@@ -118,36 +118,30 @@ void FunctionPointerAnalysis::run() {
 
   PointerConstraints constraints(bundle->data_layout());
 
-  PointerConstraintsGenerator< EmptyCodeInvariants > visitor(_ctx,
-                                                             constraints,
-                                                             nullptr);
-
   log::debug("Generating pointer constraints");
-  for (auto it = bundle->global_begin(), et = bundle->global_end(); it != et;
-       ++it) {
-    ar::GlobalVariable* gv = *it;
-    if (gv->is_definition()) {
-      log::debug(
-          "Generating pointer constraints for initializer of global variable "
-          "@" +
-          gv->name());
-      visitor.process_global_var_def(gv, EmptyCodeInvariants());
-    } else {
-      visitor.process_global_var_decl(gv);
-    }
-  }
-
-  for (auto it = bundle->function_begin(), et = bundle->function_end();
-       it != et;
-       ++it) {
-    ar::Function* fun = *it;
-    if (fun->is_definition()) {
-      log::debug("Generating pointer constraints for function @" + fun->name());
-      visitor.process_function_def(fun, EmptyCodeInvariants());
-    } else {
-      visitor.process_function_decl(fun);
-    }
-  }
+  generate_pointer_constraints(
+      _ctx,
+      constraints,
+      [this](ar::GlobalVariable* gv, PointerConstraints& csts) {
+        PointerConstraintsGenerator< EmptyCodeInvariants > visitor(_ctx,
+                                                                   csts,
+                                                                   nullptr);
+        if (gv->is_definition()) {
+          visitor.process_global_var_def(gv, EmptyCodeInvariants());
+        } else {
+          visitor.process_global_var_decl(gv);
+        }
+      },
+      [this](ar::Function* fun, PointerConstraints& csts) {
+        PointerConstraintsGenerator< EmptyCodeInvariants > visitor(_ctx,
+                                                                   csts,
+                                                                   nullptr);
+        if (fun->is_definition()) {
+          visitor.process_function_def(fun, EmptyCodeInvariants());
+        } else {
+          visitor.process_function_decl(fun);
+        }
+      });
 
   log::debug("Solving pointer constraints");
   constraints.solve();
@@ -239,62 +239,74 @@ void PointerAnalysis::run() {
 
   PointerConstraints constraints(bundle->data_layout());
 
-  PointerConstraintsGenerator< NumericalCodeInvariants >
-      visitor(_ctx, constraints, &_function_pointer.results());
-
+  // The intra-procedural numerical invariants and the constraints of each
+  // global variable initializer and function are computed in parallel
   log::debug("Generating pointer constraints");
-  for (auto it = bundle->global_begin(), et = bundle->global_end(); it != et;
-       ++it) {
-    ar::GlobalVariable* gv = *it;
-    if (gv->is_definition()) {
-      log::debug(
-          "Generating intra-procedural numerical invariant for initializer of "
-          "global variable @" +
-          gv->name());
-      NumericalCodeInvariants invariants(_ctx,
-                                         _function_pointer,
-                                         gv->initializer());
-      invariants.run();
-
-      log::debug(
-          "Generating pointer constraints for initializer of global variable "
-          "@" +
-          gv->name());
-      visitor.process_global_var_def(gv, invariants);
-    } else {
-      visitor.process_global_var_decl(gv);
-    }
-  }
-
-  for (auto it = bundle->function_begin(), et = bundle->function_end();
-       it != et;
-       ++it) {
-    ar::Function* fun = *it;
-    if (fun->is_definition()) {
-      log::debug(
-          "Generating intra-procedural numerical invariant for function @" +
-          fun->name());
-      NumericalCodeInvariants invariants(_ctx, _function_pointer, fun->body());
-      invariants.run();
-
-      log::debug("Generating pointer constraints for function @" + fun->name());
-      visitor.process_function_def(fun, invariants);
-    } else {
-      visitor.process_function_decl(fun);
-    }
-  }
+  generate_pointer_constraints(
+      _ctx,
+      constraints,
+      [this](ar::GlobalVariable* gv, PointerConstraints& csts) {
+        PointerConstraintsGenerator< NumericalCodeInvariants >
+            visitor(_ctx, csts, &_function_pointer.results());
+        if (gv->is_definition()) {
+          NumericalCodeInvariants invariants(_ctx,
+                                             _function_pointer,
+                                             gv->initializer());
+          invariants.run();
+          visitor.process_global_var_def(gv, invariants);
+        } else {
+          visitor.process_global_var_decl(gv);
+        }
+      },
+      [this](ar::Function* fun, PointerConstraints& csts) {
+        PointerConstraintsGenerator< NumericalCodeInvariants >
+            visitor(_ctx, csts, &_function_pointer.results());
+        if (fun->is_definition()) {
+          NumericalCodeInvariants invariants(_ctx,
+                                             _function_pointer,
+                                             fun->body());
+          invariants.run();
+          visitor.process_function_def(fun, invariants);
+        } else {
+          visitor.process_function_decl(fun);
+        }
+      });
 
   log::debug("Solving pointer constraints");
   constraints.solve();
 
   // Save information
   constraints.results(this->_info);
+  this->_cycles = constraints.cycles();
 }
 
 /// \brief Dump the pointer analysis results, for debugging purpose
 void PointerAnalysis::dump(std::ostream& o) const {
   o << "Pointer analysis results:\n";
   this->_info.dump(o);
+
+  if (!this->_cycles.empty()) {
+    o << "Collapsed pointer cycles:\n";
+    for (const PointerCycle& cycle : this->_cycles) {
+      bool first = true;
+      o << "{";
+      for (Variable* var : cycle.pointers) {
+        if (!first) {
+          o << ", ";
+        }
+        var->dump(o);
+        first = false;
+      }
+      for (MemoryLocation* mem : cycle.memory_locations) {
+        if (!first) {
+          o << ", ";
+        }
+        mem->dump(o);
+        first = false;
+      }
+      o << "}\n";
+    }
+  }
 }
 
 } // end namespace analyzer
@@ -50,7 +50,8 @@ namespace ikos {
 namespace analyzer {
 
 PointerInfo::PointerInfo(const ar::DataLayout& data_layout)
-    : _data_layout(data_layout) {}
+    : _data_layout(data_layout),
+      _top(PointerAbsValue::top(data_layout.pointers.bit_width, Unsigned)) {}
 
 PointerInfo::~PointerInfo() = default;
 
@@ -58,13 +59,12 @@ void PointerInfo::clear() {
   this->_map.clear();
 }
 
-PointerAbsValue PointerInfo::get(Variable* v) const {
+const PointerAbsValue& PointerInfo::get(Variable* v) const {
   auto it = this->_map.find(v);
   if (it != this->_map.end()) {
     return it->second;
   } else {
-    return PointerAbsValue::top(this->_data_layout.pointers.bit_width,
-                                Unsigned);
+    return this->_top;
   }
 }
 
@@ -0,0 +1,348 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Intraprocedural value analysis implementation, for a given
+ * machine integer abstract domain
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2018 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <ikos/core/fixpoint/fwd_fixpoint_iterator.hpp>
+
+#include <ikos/analyzer/analysis/execution_engine/context_insensitive.hpp>
+#include <ikos/analyzer/analysis/execution_engine/engine.hpp>
+#include <ikos/analyzer/analysis/execution_engine/numerical.hpp>
+#include <ikos/analyzer/analysis/fixpoint_profile.hpp>
+#include <ikos/analyzer/analysis/pointer/pointer.hpp>
+#include <ikos/analyzer/analysis/value/abstract_domain.hpp>
+#include <ikos/analyzer/analysis/value/intraprocedural.hpp>
+#include <ikos/analyzer/analysis/value/machine_int_domain.hpp>
+#include <ikos/analyzer/analysis/variable.hpp>
+#include <ikos/analyzer/analysis/wto.hpp>
+#include <ikos/analyzer/checker/make_checker.hpp>
+#include <ikos/analyzer/database/output.hpp>
+#include <ikos/analyzer/util/demangle.hpp>
+#include <ikos/analyzer/util/log.hpp>
+#include <ikos/analyzer/util/parallel.hpp>
+#include <ikos/analyzer/util/timer.hpp>
+
+namespace ikos {
+namespace analyzer {
+namespace value {
+namespace intraprocedural {
+
+/// \brief Fixpoint on a function body
+template < typename AbstractDomain >
+class FunctionFixpoint
+    : public core::InterleavedFwdFixpointIterator< ar::Code*, AbstractDomain > {
+private:
+  /// \brief Parent class
+  using FwdFixpointIterator =
+      core::InterleavedFwdFixpointIterator< ar::Code*, AbstractDomain >;
+
+private:
+  /// \brief Analysis context
+  Context& _ctx;
+
+  /// \brief Analyzed function
+  ar::Function* _function;
+
+  /// \brief Empty call context
+  CallContext* _empty_call_context;
+
+  /// \brief Machine integer abstract domain
+  MachineIntDomainOption _machine_int_domain;
+
+  /// \brief Fixpoint profile
+  boost::optional< const FixpointProfile& > _profile;
+
+public:
+  /// \brief Create a function fixpoint iterator
+  FunctionFixpoint(Context& ctx, ar::Function* function)
+      : FwdFixpointIterator(function->body(),
+                            ctx.wto_cache->get(function->body()),
+                            ctx.opts.sparse_invariants
+                                ? core::InvariantStorage::Sparse
+                                : core::InvariantStorage::Full,
+                            ctx.opts.fixpoint_jobs),
+        _ctx(ctx),
+        _function(function),
+        _empty_call_context(ctx.call_context_factory->get_empty()),
+        _machine_int_domain(ctx.opts.machine_int_domain),
+        _profile(ctx.fixpoint_profiler == nullptr
+                     ? boost::none
+                     : ctx.fixpoint_profiler->profile(function)) {}
+
+  /// \brief Extrapolate the new state after an increasing iteration
+  AbstractDomain extrapolate(ar::BasicBlock* head,
+                             unsigned iteration,
+                             AbstractDomain before,
+                             AbstractDomain after) override {
+    if (iteration <= 1) {
+      before.join_iter_with(after);
+      return before;
+    }
+    if (iteration == 2 && this->_profile) {
+      if (auto threshold = this->_profile->widening_hint(head)) {
+        before.widen_threshold_with(after, *threshold);
+        return before;
+      }
+    }
+    before.widen_with(after);
+    return before;
+  }
+
+  /// \brief Return true to use decreasing iterations to refine a fixpoint
+  bool refine_iteration(ar::BasicBlock* /*head*/, unsigned iteration) override {
+    if (iteration >= 2 &&
+        !machine_int_domain_option_has_narrowing(this->_machine_int_domain)) {
+      // Narrowing is not implemented for this domain, stop iterating
+      return false;
+    }
+    return true;
+  }
+
+  /// \brief Propagate the invariant through the basic block
+  AbstractDomain analyze_node(ar::BasicBlock* bb, AbstractDomain pre) override {
+    NumericalExecutionEngine< AbstractDomain >
+        exec_engine(std::move(pre),
+                    _ctx,
+                    this->_empty_call_context,
+                    /* precision = */ _ctx.opts.precision,
+                    /* liveness = */ _ctx.liveness,
+                    /* pointer_info = */ _ctx.pointer == nullptr
+                        ? nullptr
+                        : &_ctx.pointer->results());
+    ContextInsensitiveCallExecutionEngine< AbstractDomain > call_exec_engine(
+        exec_engine);
+    exec_engine.exec_enter(bb);
+    for (ar::Statement* stmt : *bb) {
+      transfer_function(exec_engine, call_exec_engine, stmt);
+    }
+    exec_engine.exec_leave(bb);
+    return std::move(exec_engine.inv());
+  }
+
+  /// \brief Propagate the invariant through an edge
+  AbstractDomain analyze_edge(ar::BasicBlock* src,
+                              ar::BasicBlock* dest,
+                              AbstractDomain pre) override {
+    NumericalExecutionEngine< AbstractDomain >
+        exec_engine(std::move(pre),
+                    _ctx,
+                    this->_empty_call_context,
+                    /* precision = */ _ctx.opts.precision,
+                    /* liveness = */ _ctx.liveness,
+                    /* pointer_info = */ _ctx.pointer == nullptr
+                        ? nullptr
+                        : &_ctx.pointer->results());
+    exec_engine.exec_edge(src, dest);
+    return std::move(exec_engine.inv());
+  }
+
+  /// \brief Process the computed abstract value for a node
+  void process_pre(ar::BasicBlock* /*bb*/,
+                   const AbstractDomain& /*pre*/) override {}
+
+  /// \brief Process the computed abstract value for a node
+  void process_post(ar::BasicBlock* /*bb*/,
+                    const AbstractDomain& /*post*/) override {}
+
+  /// \brief Run the checks with the previously computed fix-point
+  void run_checks(
+      const std::vector< std::unique_ptr< Checker< AbstractDomain > > >&
+          checkers) {
+    for (const auto& checker : checkers) {
+      checker->enter(this->_function, this->_empty_call_context);
+    }
+
+    // Check the function body
+    //
+    // Invariants dropped by the sparse storage are propagated from the
+    // previously checked basic block, see visit_chain().
+    auto check_block = [&](ar::BasicBlock* bb, AbstractDomain pre) {
+      NumericalExecutionEngine< AbstractDomain >
+          exec_engine(std::move(pre),
+                      _ctx,
+                      this->_empty_call_context,
+                      /* precision = */ _ctx.opts.precision,
+                      /* liveness = */ _ctx.liveness,
+                      /* pointer_info = */ _ctx.pointer == nullptr
+                          ? nullptr
+                          : &_ctx.pointer->results());
+      ContextInsensitiveCallExecutionEngine< AbstractDomain > call_exec_engine(
+          exec_engine);
+
+      exec_engine.exec_enter(bb);
+      for (const auto& checker : checkers) {
+        checker->enter(bb, exec_engine.inv(), this->_empty_call_context);
+      }
+
+      for (ar::Statement* stmt : *bb) {
+        // Check the statement if it's related to an llvm instruction
+        if (stmt->has_frontend()) {
+          for (const auto& checker : checkers) {
+            checker->check(stmt, exec_engine.inv(), this->_empty_call_context);
+          }
+        }
+        // Propagate
+        transfer_function(exec_engine, call_exec_engine, stmt);
+      }
+
+      for (const auto& checker : checkers) {
+        checker->leave(bb, exec_engine.inv(), this->_empty_call_context);
+      }
+      exec_engine.exec_leave(bb);
+      return std::move(exec_engine.inv());
+    };
+    for (ar::BasicBlock* bb : *this->cfg()) {
+      this->visit_chain(bb, check_block);
+    }
+
+    for (const auto& checker : checkers) {
+      checker->leave(this->_function, this->_empty_call_context);
+    }
+  }
+
+}; // end class FunctionFixpoint
+
+} // end namespace intraprocedural
+} // end namespace value
+
+template < typename MachineIntDomain >
+void IntraproceduralValueAnalysis::run(
+    const MachineIntDomain& machine_int_top) {
+  using AbstractDomain = value::AbstractDomainT< MachineIntDomain >;
+  using MemoryAbstractDomain = value::MemoryAbstractDomainT< MachineIntDomain >;
+  using PointerAbstractDomain =
+      value::PointerAbstractDomainT< MachineIntDomain >;
+  using FunctionFixpoint =
+      value::intraprocedural::FunctionFixpoint< AbstractDomain >;
+
+  // Bundle
+  ar::Bundle* bundle = _ctx.bundle;
+
+  // Initial invariant
+  AbstractDomain init_inv(
+      /*normal=*/MemoryAbstractDomain(
+          PointerAbstractDomain(machine_int_top,
+                                value::NullityAbstractDomain::top()),
+          value::UninitializedAbstractDomain::top(),
+          value::LifetimeAbstractDomain::top()),
+      /*caught_exceptions=*/MemoryAbstractDomain::bottom(),
+      /*propagated_exceptions=*/MemoryAbstractDomain::bottom());
+
+  // Insert every function in the database, and collect the ones to analyze
+  std::vector< ar::Function* > functions;
+  for (auto it = bundle->function_begin(), et = bundle->function_end();
+       it != et;
+       ++it) {
+    ar::Function* function = *it;
+    _ctx.output_db->functions.insert(function);
+
+    if (function->is_definition()) {
+      functions.push_back(function);
+    }
+  }
+
+  // Initial invariant of each function
+  //
+  // The copies are made by this thread, since copying an abstract value might
+  // update its shared representation.
+  std::vector< AbstractDomain > init_invs(functions.size(), init_inv);
+
+  // Mutex serializing the log messages
+  std::mutex log_mutex;
+
+  // Checks are serialized if they are displayed, to keep the output of each
+  // check together.
+  bool serialize_checks =
+      _ctx.opts.display_checks != DisplayOption::None ||
+      _ctx.opts.display_invariants != DisplayOption::None;
+
+  // Mutex serializing the checks, if requested
+  std::mutex check_mutex;
+
+  // Fixpoints and checks are computed in parallel. The output database
+  // serializes the insertions, see sqlite::DbConnection::mutex().
+  parallel_for(_ctx.opts.value_jobs(), functions.size(), [&](std::size_t i) {
+    ar::Function* function = functions[i];
+    FunctionFixpoint fixpoint(_ctx, function);
+
+    {
+      std::lock_guard< std::mutex > lock(log_mutex);
+      log::info("Analyzing function: " + demangle(function->name()));
+    }
+
+    {
+      ScopeTimerDatabase t(_ctx.output_db->times,
+                           "ikos-analyzer.value." + function->name());
+      fixpoint.run(std::move(init_invs[i]));
+    }
+
+    {
+      std::lock_guard< std::mutex > lock(log_mutex);
+      log::info("Checking properties and writing results for function: " +
+                demangle(function->name()));
+    }
+
+    std::unique_lock< std::mutex > check_lock(check_mutex, std::defer_lock);
+    if (serialize_checks) {
+      check_lock.lock();
+    }
+    ScopeTimerDatabase t(_ctx.output_db->times,
+                         "ikos-analyzer.check." + function->name());
+
+    // Checkers have a state (e.g, the previous statement), create them for
+    // each function since functions are checked concurrently.
+    std::vector< std::unique_ptr< Checker< AbstractDomain > > > checkers;
+    for (CheckerName name : _ctx.opts.analyses) {
+      checkers.emplace_back(make_checker< AbstractDomain >(_ctx, name));
+    }
+    fixpoint.run_checks(checkers);
+  });
+}
+
+} // end namespace analyzer
+} // end namespace ikos
@@ -1,7 +1,8 @@
 /*******************************************************************************
  *
  * \file
- * \brief Implement make_top_machine_int_interval
+ * \brief Implement make_top_machine_int_interval, and instantiate the value
+ * analyses on this domain
  *
  * Author: Maxime Arthaud
  *
@@ -41,19 +42,30 @@
  *
  ******************************************************************************/
 
-#include <ikos/core/domain/machine_int/interval.hpp>
-
 #include <ikos/analyzer/analysis/value/machine_int_domain.hpp>
 
+#include "../interprocedural_impl.hpp"
+#include "../intraprocedural_impl.hpp"
+#include "../summary_impl.hpp"
+
 namespace ikos {
 namespace analyzer {
 namespace value {
 
 MachineIntAbstractDomain make_top_machine_int_interval() {
-  return MachineIntAbstractDomain(
-      core::machine_int::IntervalDomain< Variable* >::top());
+  return MachineIntAbstractDomain(IntervalMachineIntDomain::top());
 }
 
 } // end namespace value
+
+template void InterproceduralValueAnalysis::run(
+    const value::IntervalMachineIntDomain& machine_int_top);
+
+template void IntraproceduralValueAnalysis::run(
+    const value::IntervalMachineIntDomain& machine_int_top);
+
+template void SummaryValueAnalysis::run(
+    const value::IntervalMachineIntDomain& machine_int_top);
+
 } // end namespace analyzer
 } // end namespace ikos
@@ -1,9 +1,9 @@
 /*******************************************************************************
  *
  * \file
- * \brief Unsigned integer overflow checker implementation
+ * \brief Implement make_top_machine_int_native_dbm
  *
- * Author: Thomas Bailleux
+ * Author: Maxime Arthaud
  *
  * Contact: ikos@lists.nasa.gov
  *
@@ -41,42 +41,18 @@
  *
  ******************************************************************************/
 
-#include <ikos/analyzer/checker/unsigned_int_overflow.hpp>
+#include <ikos/core/domain/machine_int/dbm.hpp>
+
+#include <ikos/analyzer/analysis/value/machine_int_domain.hpp>
 
 namespace ikos {
 namespace analyzer {
+namespace value {
 
-UnsignedIntOverflowChecker::UnsignedIntOverflowChecker(Context& ctx)
-    : IntOverflowCheckerBase(ctx) {}
-
-CheckerName UnsignedIntOverflowChecker::name() const {
-  return CheckerName::UnsignedIntOverflow;
-}
-
-const char* UnsignedIntOverflowChecker::description() const {
-  return "Unsigned integer overflow checker";
-}
-
-void UnsignedIntOverflowChecker::check(ar::Statement* stmt,
-                                       const value::AbstractDomain& inv,
-                                       CallContext* call_context) {
-  if (auto bin = dyn_cast< ar::BinaryOperation >(stmt)) {
-    if (bin->op() == ar::BinaryOperation::UAdd ||
-        bin->op() == ar::BinaryOperation::USub ||
-        bin->op() == ar::BinaryOperation::UMul ||
-        bin->op() == ar::BinaryOperation::UDiv) {
-      this->check_integer_overflow(bin, inv, call_context);
-    }
-  }
-}
-
-CheckKind UnsignedIntOverflowChecker::underflow_check_kind() const {
-  return CheckKind::UnsignedIntUnderflow;
-}
-
-CheckKind UnsignedIntOverflowChecker::overflow_check_kind() const {
-  return CheckKind::UnsignedIntOverflow;
+MachineIntAbstractDomain make_top_machine_int_native_dbm() {
+  return MachineIntAbstractDomain(core::machine_int::DBM< Variable* >::top());
 }
 
+} // end namespace value
 } // end namespace analyzer
 } // end namespace ikos
@@ -1,9 +1,9 @@
 /*******************************************************************************
  *
  * \file
- * \brief Signed integer overflow checker implementation
+ * \brief Implement make_top_machine_int_octagon
  *
- * Author: Thomas Bailleux
+ * Author: Maxime Arthaud
  *
  * Contact: ikos@lists.nasa.gov
  *
@@ -41,43 +41,22 @@
  *
  ******************************************************************************/
 
-#include <ikos/analyzer/checker/signed_int_overflow.hpp>
+#include <ikos/core/domain/machine_int/numeric_domain_adapter.hpp>
+#include <ikos/core/domain/numeric/octagon.hpp>
+
+#include <ikos/analyzer/analysis/value/machine_int_domain.hpp>
 
 namespace ikos {
 namespace analyzer {
+namespace value {
 
-SignedIntOverflowChecker::SignedIntOverflowChecker(Context& ctx)
-    : IntOverflowCheckerBase(ctx) {}
-
-CheckerName SignedIntOverflowChecker::name() const {
-  return CheckerName::SignedIntOverflow;
-}
-
-const char* SignedIntOverflowChecker::description() const {
-  return "Signed integer overflow checker";
-}
-
-void SignedIntOverflowChecker::check(ar::Statement* stmt,
-                                     const value::AbstractDomain& inv,
-                                     CallContext* call_context) {
-  if (auto bin = dyn_cast< ar::BinaryOperation >(stmt)) {
-    if (bin->op() == ar::BinaryOperation::SAdd ||
-        bin->op() == ar::BinaryOperation::SSub ||
-        bin->op() == ar::BinaryOperation::SMul ||
-        bin->op() == ar::BinaryOperation::SDiv ||
-        bin->op() == ar::BinaryOperation::SRem) {
-      this->check_integer_overflow(bin, inv, call_context);
-    }
-  }
-}
-
-CheckKind SignedIntOverflowChecker::underflow_check_kind() const {
-  return CheckKind::SignedIntUnderflow;
-}
-
-CheckKind SignedIntOverflowChecker::overflow_check_kind() const {
-  return CheckKind::SignedIntOverflow;
+MachineIntAbstractDomain make_top_machine_int_octagon() {
+  return MachineIntAbstractDomain(
+      core::machine_int::NumericDomainAdapter<
+          Variable*,
+          core::numeric::Octagon< ZNumber, Variable* > >::top());
 }
 
+} // end namespace value
 } // end namespace analyzer
 } // end namespace ikos
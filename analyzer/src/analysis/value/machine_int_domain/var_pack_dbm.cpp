@@ -1,7 +1,8 @@
 /*******************************************************************************
  *
  * \file
- * \brief Implement make_top_machine_int_var_pack_dbm
+ * \brief Implement make_top_machine_int_var_pack_dbm, and instantiate the value
+ * analyses on this domain
  *
  * Author: Maxime Arthaud
  *
@@ -41,22 +42,30 @@
  *
  ******************************************************************************/
 
-#include <ikos/core/domain/machine_int/numeric_domain_adapter.hpp>
-#include <ikos/core/domain/numeric/var_packing_dbm.hpp>
-
 #include <ikos/analyzer/analysis/value/machine_int_domain.hpp>
 
+#include "../interprocedural_impl.hpp"
+#include "../intraprocedural_impl.hpp"
+#include "../summary_impl.hpp"
+
 namespace ikos {
 namespace analyzer {
 namespace value {
 
 MachineIntAbstractDomain make_top_machine_int_var_pack_dbm() {
-  return MachineIntAbstractDomain(
-      core::machine_int::NumericDomainAdapter<
-          Variable*,
-          core::numeric::VarPackingDBM< ZNumber, Variable* > >::top());
+  return MachineIntAbstractDomain(VarPackDBMMachineIntDomain::top());
 }
 
 } // end namespace value
+
+template void InterproceduralValueAnalysis::run(
+    const value::VarPackDBMMachineIntDomain& machine_int_top);
+
+template void IntraproceduralValueAnalysis::run(
+    const value::VarPackDBMMachineIntDomain& machine_int_top);
+
+template void SummaryValueAnalysis::run(
+    const value::VarPackDBMMachineIntDomain& machine_int_top);
+
 } // end namespace analyzer
 } // end namespace ikos
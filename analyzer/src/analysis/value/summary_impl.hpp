@@ -0,0 +1,856 @@
+/******************************************************************************
+ *
+ * \file
+ * \brief Summary-based value analysis implementation, for a given
+ * machine integer abstract domain
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2018 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/DenseSet.h>
+
+#include <ikos/core/fixpoint/fwd_fixpoint_iterator.hpp>
+
+#include <ikos/ar/semantic/bundle.hpp>
+#include <ikos/ar/semantic/statement.hpp>
+#include <ikos/ar/verify/type.hpp>
+
+#include <ikos/analyzer/analysis/execution_engine/engine.hpp>
+#include <ikos/analyzer/analysis/execution_engine/numerical.hpp>
+#include <ikos/analyzer/analysis/execution_engine/summary.hpp>
+#include <ikos/analyzer/analysis/fixpoint_profile.hpp>
+#include <ikos/analyzer/analysis/pointer/pointer.hpp>
+#include <ikos/analyzer/analysis/value/abstract_domain.hpp>
+#include <ikos/analyzer/analysis/value/machine_int_domain.hpp>
+#include <ikos/analyzer/analysis/value/summary.hpp>
+#include <ikos/analyzer/analysis/variable.hpp>
+#include <ikos/analyzer/analysis/wto.hpp>
+#include <ikos/analyzer/checker/make_checker.hpp>
+#include <ikos/analyzer/database/output.hpp>
+#include <ikos/analyzer/support/cast.hpp>
+#include <ikos/analyzer/util/demangle.hpp>
+#include <ikos/analyzer/util/log.hpp>
+#include <ikos/analyzer/util/timer.hpp>
+
+#include "interprocedural_impl.hpp"
+
+namespace ikos {
+namespace analyzer {
+namespace value {
+namespace summary {
+
+/// \brief Strongly connected components of the call graph
+///
+/// The call graph contains the defined functions reachable from the given
+/// roots and from the global variable initializers. A function is considered
+/// called by any code referring to it, to account for indirect calls. The
+/// components are computed using Tarjan's algorithm, hence they are sorted in
+/// reverse topological order: callees come before their callers.
+///
+/// Functions referred to by anything else than the called operand of a call
+/// statement might be called indirectly, and are marked as address taken.
+class CallGraphComponents {
+private:
+  /// \brief Visit information on a function
+  struct Node {
+    unsigned index;
+    unsigned lowlink;
+    bool on_stack;
+  };
+
+private:
+  /// \brief Visit information
+  llvm::DenseMap< ar::Function*, Node > _nodes;
+
+  /// \brief Stack of visited functions
+  std::vector< ar::Function* > _stack;
+
+  /// \brief Next visit index
+  unsigned _next_index = 0;
+
+  /// \brief List of components, callees first
+  std::vector< std::vector< ar::Function* > > _components;
+
+  /// \brief Functions that might be called indirectly
+  llvm::DenseSet< ar::Function* > _address_taken;
+
+  /// \brief Functions in a cycle of the call graph
+  llvm::DenseSet< ar::Function* > _recursive;
+
+public:
+  /// \brief Compute the components of the call graph reachable from the given
+  /// defined functions
+  CallGraphComponents(ar::Bundle* bundle,
+                      const std::vector< ar::Function* >& roots) {
+    std::vector< ar::Function* > functions;
+    for (auto it = bundle->global_begin(), et = bundle->global_end(); it != et;
+         ++it) {
+      ar::GlobalVariable* gv = *it;
+      if (gv->is_definition()) {
+        referred_functions(gv->initializer(), functions);
+      }
+    }
+    // The global variable initializers are not analyzed with summaries
+    this->_address_taken.insert(functions.begin(), functions.end());
+    functions.insert(functions.begin(), roots.begin(), roots.end());
+    for (ar::Function* fun : functions) {
+      if (this->_nodes.count(fun) == 0) {
+        this->visit(fun);
+      }
+    }
+  }
+
+  /// \brief Return true if the given function is in the call graph
+  bool contains(ar::Function* fun) const {
+    return this->_nodes.count(fun) != 0;
+  }
+
+  /// \brief Return the components, callees first
+  const std::vector< std::vector< ar::Function* > >& components() const {
+    return this->_components;
+  }
+
+  /// \brief Return true if the given function might be called indirectly
+  bool is_address_taken(ar::Function* fun) const {
+    return this->_address_taken.count(fun) != 0;
+  }
+
+  /// \brief Return true if the given function is in a cycle of the call graph
+  bool is_recursive(ar::Function* fun) const {
+    return this->_recursive.count(fun) != 0;
+  }
+
+private:
+  /// \brief Add the defined functions referred to by the given value
+  static void referred_functions(ar::Value* value,
+                                 std::vector< ar::Function* >& result) {
+    if (auto cst = dyn_cast< ar::FunctionPointerConstant >(value)) {
+      if (cst->function()->is_definition()) {
+        result.push_back(cst->function());
+      }
+    } else if (auto cst = dyn_cast< ar::StructConstant >(value)) {
+      for (auto it = cst->field_begin(), et = cst->field_end(); it != et;
+           ++it) {
+        referred_functions(it->second, result);
+      }
+    } else if (auto cst = dyn_cast< ar::SequentialConstant >(value)) {
+      for (auto it = cst->element_begin(), et = cst->element_end(); it != et;
+           ++it) {
+        referred_functions(*it, result);
+      }
+    }
+  }
+
+  /// \brief Return true if the given statement is a well-formed direct call
+  static bool is_direct_call(ar::Statement* stmt) {
+    auto call = dyn_cast< ar::CallBase >(stmt);
+    if (call == nullptr) {
+      return false;
+    }
+    auto cst = dyn_cast< ar::FunctionPointerConstant >(call->called());
+    return cst != nullptr &&
+           ar::TypeVerifier::is_valid_call(call, cst->function()->type());
+  }
+
+  /// \brief Add the defined functions referred to by the given code
+  ///
+  /// This also marks the functions that might be called indirectly.
+  void referred_functions(ar::Code* code,
+                          std::vector< ar::Function* >& result) {
+    for (ar::BasicBlock* bb : *code) {
+      for (ar::Statement* stmt : *bb) {
+        auto it = stmt->op_begin();
+        auto et = stmt->op_end();
+        if (is_direct_call(stmt)) {
+          referred_functions(cast< ar::CallBase >(stmt)->called(), result);
+          it = cast< ar::CallBase >(stmt)->arg_begin();
+        }
+        std::size_t first_indirect = result.size();
+        for (; it != et; ++it) {
+          referred_functions(*it, result);
+        }
+        this->_address_taken.insert(result.begin() + first_indirect,
+                                    result.end());
+      }
+    }
+  }
+
+  /// \brief Return the defined functions called by `fun`
+  std::vector< ar::Function* > callees(ar::Function* fun) {
+    std::vector< ar::Function* > result;
+    referred_functions(fun->body(), result);
+    return result;
+  }
+
+  /// \brief Frame of the depth-first search
+  struct Frame {
+    /// \brief Visited function
+    ar::Function* fun;
+
+    /// \brief Defined functions directly called by `fun`
+    std::vector< ar::Function* > callees;
+
+    /// \brief Position of the next callee to visit
+    std::size_t next;
+  };
+
+  /// \brief Start the visit of the given function
+  void push(std::vector< Frame >& frames, ar::Function* fun) {
+    unsigned index = this->_next_index++;
+    this->_nodes[fun] = Node{index, index, true};
+    this->_stack.push_back(fun);
+    frames.push_back(Frame{fun, callees(fun), 0});
+  }
+
+  /// \brief Visit the given function
+  ///
+  /// The depth-first search uses an explicit stack, since call graphs can be
+  /// too deep for recursion.
+  void visit(ar::Function* root) {
+    std::vector< Frame > frames;
+    this->push(frames, root);
+
+    while (!frames.empty()) {
+      Frame& frame = frames.back();
+      ar::Function* fun = frame.fun;
+
+      if (frame.next < frame.callees.size()) {
+        ar::Function* callee = frame.callees[frame.next++];
+        auto it = this->_nodes.find(callee);
+        if (it == this->_nodes.end()) {
+          this->push(frames, callee); // invalidates `frame`
+        } else if (it->second.on_stack) {
+          Node& node = this->_nodes[fun];
+          node.lowlink = std::min(node.lowlink, it->second.index);
+        }
+        continue;
+      }
+
+      // All callees have been visited
+      std::vector< ar::Function* > frame_callees = std::move(frame.callees);
+      frames.pop_back();
+
+      const Node node = this->_nodes[fun];
+      if (node.lowlink == node.index) {
+        std::vector< ar::Function* > component;
+        ar::Function* member = nullptr;
+        do {
+          member = this->_stack.back();
+          this->_stack.pop_back();
+          this->_nodes[member].on_stack = false;
+          component.push_back(member);
+        } while (member != fun);
+        if (component.size() > 1 ||
+            std::find(frame_callees.begin(), frame_callees.end(), fun) !=
+                frame_callees.end()) {
+          this->_recursive.insert(component.begin(), component.end());
+        }
+        this->_components.push_back(std::move(component));
+      }
+
+      if (!frames.empty()) {
+        Node& caller = this->_nodes[frames.back().fun];
+        caller.lowlink = std::min(caller.lowlink, node.lowlink);
+      }
+    }
+  }
+
+}; // end class CallGraphComponents
+
+/// \brief Fixpoint on a function body
+template < typename AbstractDomain >
+class FunctionFixpoint
+    : public core::InterleavedFwdFixpointIterator< ar::Code*, AbstractDomain > {
+private:
+  /// \brief Parent class
+  using FwdFixpointIterator =
+      core::InterleavedFwdFixpointIterator< ar::Code*, AbstractDomain >;
+
+  /// \brief Numerical execution engine
+  using NumericalExecutionEngineT = NumericalExecutionEngine< AbstractDomain >;
+
+  /// \brief Summary call execution engine
+  using SummaryCallExecutionEngineT =
+      SummaryCallExecutionEngine< AbstractDomain >;
+
+public:
+  /// \brief Function summary
+  using FunctionSummaryT = FunctionSummary< AbstractDomain >;
+
+  /// \brief Map from function to summary
+  using SummaryMap = typename SummaryCallExecutionEngineT::SummaryMap;
+
+  /// \brief Map from function to the join of its entry invariants
+  using CallingContextMap =
+      typename SummaryCallExecutionEngineT::CallingContextMap;
+
+private:
+  /// \brief Analysis context
+  Context& _ctx;
+
+  /// \brief Analyzed function
+  ar::Function* _function;
+
+  /// \brief Empty call context
+  CallContext* _empty_call_context;
+
+  /// \brief Machine integer abstract domain
+  MachineIntDomainOption _machine_int_domain;
+
+  /// \brief Fixpoint profile
+  boost::optional< const FixpointProfile& > _profile;
+
+  /// \brief Summaries of the callees
+  const SummaryMap& _summaries;
+
+public:
+  /// \brief Create a function fixpoint iterator
+  FunctionFixpoint(Context& ctx,
+                   ar::Function* function,
+                   const SummaryMap& summaries)
+      : FwdFixpointIterator(function->body(),
+                            ctx.wto_cache->get(function->body()),
+                            ctx.opts.sparse_invariants
+                                ? core::InvariantStorage::Sparse
+                                : core::InvariantStorage::Full,
+                            ctx.opts.fixpoint_jobs),
+        _ctx(ctx),
+        _function(function),
+        _empty_call_context(ctx.call_context_factory->get_empty()),
+        _machine_int_domain(ctx.opts.machine_int_domain),
+        _profile(ctx.fixpoint_profiler == nullptr
+                     ? boost::none
+                     : ctx.fixpoint_profiler->profile(function)),
+        _summaries(summaries) {}
+
+  /// \brief Extrapolate the new state after an increasing iteration
+  AbstractDomain extrapolate(ar::BasicBlock* head,
+                             unsigned iteration,
+                             AbstractDomain before,
+                             AbstractDomain after) override {
+    if (iteration <= 1) {
+      before.join_iter_with(after);
+      return before;
+    }
+    if (iteration == 2 && this->_profile) {
+      if (auto threshold = this->_profile->widening_hint(head)) {
+        before.widen_threshold_with(after, *threshold);
+        return before;
+      }
+    }
+    before.widen_with(after);
+    return before;
+  }
+
+  /// \brief Return true to use decreasing iterations to refine a fixpoint
+  bool refine_iteration(ar::BasicBlock* /*head*/, unsigned iteration) override {
+    if (iteration >= 2 &&
+        !machine_int_domain_option_has_narrowing(this->_machine_int_domain)) {
+      // Narrowing is not implemented for this domain, stop iterating
+      return false;
+    }
+    return true;
+  }
+
+  /// \brief Propagate the invariant through the basic block
+  AbstractDomain analyze_node(ar::BasicBlock* bb, AbstractDomain pre) override {
+    NumericalExecutionEngineT exec_engine = this->make_engine(std::move(pre));
+    SummaryCallExecutionEngineT call_exec_engine(_ctx,
+                                                 exec_engine,
+                                                 this->_summaries);
+    exec_engine.exec_enter(bb);
+    for (ar::Statement* stmt : *bb) {
+      transfer_function(exec_engine, call_exec_engine, stmt);
+    }
+    // Keep the formal parameters for the summary
+    exec_engine.forget_dead_variables(bb, this->_function);
+    return std::move(exec_engine.inv());
+  }
+
+  /// \brief Propagate the invariant through an edge
+  AbstractDomain analyze_edge(ar::BasicBlock* src,
+                              ar::BasicBlock* dest,
+                              AbstractDomain pre) override {
+    NumericalExecutionEngineT exec_engine = this->make_engine(std::move(pre));
+    exec_engine.exec_edge(src, dest);
+    return std::move(exec_engine.inv());
+  }
+
+  /// \brief Process the computed abstract value for a node
+  void process_pre(ar::BasicBlock* /*bb*/,
+                   const AbstractDomain& /*pre*/) override {}
+
+  /// \brief Process the computed abstract value for a node
+  void process_post(ar::BasicBlock* /*bb*/,
+                    const AbstractDomain& /*post*/) override {}
+
+  /// \brief Return the invariant at the end of the function, after the
+  /// deallocation of the local variables
+  ///
+  /// This is not const because, with the sparse storage, the post invariant of
+  /// the exit block might have been dropped and needs to be recomputed.
+  AbstractDomain exit_invariant() {
+    ar::BasicBlock* exit = this->_function->body()->exit_block_or_null();
+
+    if (exit == nullptr) {
+      // The function never returns
+      return AbstractDomain::bottom();
+    }
+
+    NumericalExecutionEngineT exec_engine =
+        this->make_engine(this->recompute_post(exit));
+    exec_engine.deallocate_local_variables(
+        this->_function->local_variable_begin(),
+        this->_function->local_variable_end());
+    return std::move(exec_engine.inv());
+  }
+
+  /// \brief Return the summary of the function, using the computed fix-point
+  std::unique_ptr< FunctionSummaryT > summary() {
+    ar::BasicBlock* exit = this->_function->body()->exit_block_or_null();
+
+    ar::ReturnValue* return_stmt = nullptr;
+    if (exit != nullptr && !exit->empty() &&
+        isa< ar::ReturnValue >(exit->back())) {
+      return_stmt = cast< ar::ReturnValue >(exit->back());
+    }
+
+    return std::make_unique< FunctionSummaryT >(
+        FunctionSummaryT{this->summary_invariant(return_stmt), return_stmt});
+  }
+
+private:
+  /// \brief Return the invariant of the summary
+  ///
+  /// The exit invariant is projected on the formal parameters, the returned
+  /// value, the global variables and the memory reachable from them: the other
+  /// internal variables and the local variables of the function are forgotten.
+  AbstractDomain summary_invariant(ar::ReturnValue* return_stmt) {
+    AbstractDomain inv = this->exit_invariant();
+
+    if (inv.is_normal_flow_bottom()) {
+      return inv;
+    }
+
+    ar::Value* returned_value = nullptr;
+    if (return_stmt != nullptr && return_stmt->has_operand()) {
+      returned_value = return_stmt->operand();
+    }
+
+    ar::Code* body = this->_function->body();
+    for (auto it = body->internal_variable_begin(),
+              et = body->internal_variable_end();
+         it != et;
+         ++it) {
+      ar::InternalVariable* iv = *it;
+
+      if (iv == returned_value ||
+          std::find(this->_function->param_begin(),
+                    this->_function->param_end(),
+                    iv) != this->_function->param_end()) {
+        continue;
+      }
+
+      if (_ctx.opts.precision >= Precision::Memory &&
+          iv->type()->is_aggregate()) {
+        inv.normal().forget_mem(_ctx.mem_factory->get_aggregate(iv));
+      }
+      inv.normal().forget_surface(_ctx.var_factory->get_internal(iv));
+    }
+
+    // Local variables are deallocated by exit_invariant()
+    for (auto it = this->_function->local_variable_begin(),
+              et = this->_function->local_variable_end();
+         it != et;
+         ++it) {
+      inv.normal().lifetime().forget(_ctx.mem_factory->get_local(*it));
+    }
+
+    return inv;
+  }
+
+public:
+  /// \brief Run the checks with the previously computed fix-point
+  ///
+  /// If `calling_contexts` is not null, the entry invariants of the callees
+  /// are joined in it.
+  void run_checks(
+      const std::vector< std::unique_ptr< Checker< AbstractDomain > > >&
+          checkers,
+      CallingContextMap* calling_contexts = nullptr) {
+    for (const auto& checker : checkers) {
+      checker->enter(this->_function, this->_empty_call_context);
+    }
+
+    // Check the function body
+    //
+    // Invariants dropped by the sparse storage are propagated from the
+    // previously checked basic block, see visit_chain().
+    auto check_block = [&](ar::BasicBlock* bb, AbstractDomain pre) {
+      NumericalExecutionEngineT exec_engine = this->make_engine(std::move(pre));
+      SummaryCallExecutionEngineT call_exec_engine(_ctx,
+                                                   exec_engine,
+                                                   this->_summaries,
+                                                   calling_contexts);
+
+      exec_engine.exec_enter(bb);
+      for (const auto& checker : checkers) {
+        checker->enter(bb, exec_engine.inv(), this->_empty_call_context);
+      }
+
+      for (ar::Statement* stmt : *bb) {
+        // Check the statement if it's related to an llvm instruction
+        if (stmt->has_frontend()) {
+          for (const auto& checker : checkers) {
+            checker->check(stmt, exec_engine.inv(), this->_empty_call_context);
+          }
+        }
+        // Propagate
+        transfer_function(exec_engine, call_exec_engine, stmt);
+      }
+
+      for (const auto& checker : checkers) {
+        checker->leave(bb, exec_engine.inv(), this->_empty_call_context);
+      }
+      exec_engine.forget_dead_variables(bb, this->_function);
+      return std::move(exec_engine.inv());
+    };
+    for (ar::BasicBlock* bb : *this->cfg()) {
+      this->visit_chain(bb, check_block);
+    }
+
+    for (const auto& checker : checkers) {
+      checker->leave(this->_function, this->_empty_call_context);
+    }
+  }
+
+private:
+  /// \brief Create a numerical execution engine with the given invariant
+  NumericalExecutionEngineT make_engine(AbstractDomain inv) const {
+    return NumericalExecutionEngineT(std::move(inv),
+                                     _ctx,
+                                     this->_empty_call_context,
+                                     /* precision = */ _ctx.opts.precision,
+                                     /* liveness = */ _ctx.liveness,
+                                     /* pointer_info = */ _ctx.pointer ==
+                                             nullptr
+                                         ? nullptr
+                                         : &_ctx.pointer->results());
+  }
+
+}; // end class FunctionFixpoint
+
+} // end namespace summary
+} // end namespace value
+
+template < typename MachineIntDomain >
+void SummaryValueAnalysis::run(const MachineIntDomain& machine_int_top) {
+  using namespace value::interprocedural;
+  using AbstractDomain = value::AbstractDomainT< MachineIntDomain >;
+  using GlobalVarInitializerFixpoint =
+      value::interprocedural::GlobalVarInitializerFixpoint< AbstractDomain >;
+  using FunctionFixpoint = value::summary::FunctionFixpoint< AbstractDomain >;
+  using CallGraphComponents = value::summary::CallGraphComponents;
+
+  // Bundle
+  ar::Bundle* bundle = _ctx.bundle;
+
+  // Create checkers
+  std::vector< std::unique_ptr< Checker< AbstractDomain > > > checkers;
+  for (CheckerName name : _ctx.opts.analyses) {
+    checkers.emplace_back(make_checker< AbstractDomain >(_ctx, name));
+  }
+
+  // Collect the global constructors, entry points and global destructors
+  std::vector< ar::Function* > ctors;
+  ar::GlobalVariable* gv_ctors = bundle->global_or_null("ar.global_ctors");
+  if (gv_ctors != nullptr) {
+    for (const auto& entry : global_ctors(gv_ctors)) {
+      if (entry.first->is_declaration()) {
+        log::error("Global constructor " + entry.first->name() + " is extern");
+        continue;
+      }
+      ctors.push_back(entry.first);
+    }
+  }
+
+  std::vector< ar::Function* > entry_points;
+  for (ar::Function* entry_point : _ctx.opts.entry_points) {
+    if (entry_point->is_declaration()) {
+      log::error("Entry point " + entry_point->name() + " is extern");
+      continue;
+    }
+    entry_points.push_back(entry_point);
+  }
+
+  std::vector< ar::Function* > dtors;
+  ar::GlobalVariable* gv_dtors = bundle->global_or_null("ar.global_dtors");
+  if (gv_dtors != nullptr) {
+    for (const auto& entry : global_dtors(gv_dtors)) {
+      if (entry.first->is_declaration()) {
+        log::error("Global destructor " + entry.first->name() + " is extern");
+        continue;
+      }
+      dtors.push_back(entry.first);
+    }
+  }
+
+  std::vector< ar::Function* > roots;
+  roots.insert(roots.end(), ctors.begin(), ctors.end());
+  roots.insert(roots.end(), entry_points.begin(), entry_points.end());
+  roots.insert(roots.end(), dtors.begin(), dtors.end());
+
+  // Compute the call graph components
+  std::unique_ptr< CallGraphComponents > call_graph;
+  {
+    log::debug("Computing the call graph");
+    ScopeTimerDatabase t(_ctx.output_db->times,
+                         "ikos-analyzer.value.call-graph");
+    call_graph = std::make_unique< CallGraphComponents >(bundle, roots);
+  }
+
+  // Function summaries
+  typename FunctionFixpoint::SummaryMap summaries;
+
+  // Compute the summaries bottom-up, from a top invariant
+  //
+  // Within a component, calls to functions that are not summarized yet are
+  // analyzed as calls to unknown functions.
+  for (const auto& component : call_graph->components()) {
+    for (ar::Function* function : component) {
+      FunctionFixpoint fixpoint(_ctx, function, summaries);
+
+      {
+        log::info("Analyzing function: " + demangle(function->name()));
+        ScopeTimerDatabase t(_ctx.output_db->times,
+                             "ikos-analyzer.value.summary." + function->name());
+        fixpoint.run(init_invariant(machine_int_top));
+      }
+
+      summaries[function] = fixpoint.summary();
+    }
+  }
+
+  // Entry invariants of the functions called by the checked functions
+  typename FunctionFixpoint::CallingContextMap calling_contexts;
+
+  // Initial invariant
+  AbstractDomain init_inv = init_invariant(machine_int_top);
+
+  // Initialize global variables
+  log::debug("Computing global variable static initialization");
+  for (auto it = bundle->global_begin(), et = bundle->global_end(); it != et;
+       ++it) {
+    ar::GlobalVariable* gv = *it;
+    if (gv->is_definition() &&
+        is_initialized(gv, _ctx.opts.globals_init_policy)) {
+      log::debug("Initializing global variable @" + gv->name());
+      GlobalVarInitializerFixpoint fixpoint(_ctx, gv);
+      fixpoint.run(init_inv);
+      init_inv = fixpoint.exit_invariant();
+    }
+  }
+
+  if (_ctx.opts.display_invariants == DisplayOption::All) {
+    log::out() << "Invariant after global variable static initialization:\n";
+    init_inv.dump(log::out());
+    log::out() << std::endl;
+  }
+
+  // Call constructors
+  if (!ctors.empty()) {
+    log::info("Computing global variable dynamic initialization");
+
+    for (ar::Function* ctor : ctors) {
+      FunctionFixpoint fixpoint(_ctx, ctor, summaries);
+
+      {
+        log::info("Analyzing global constructor: " + demangle(ctor->name()));
+        ScopeTimerDatabase t(_ctx.output_db->times,
+                             "ikos-analyzer.value." + ctor->name());
+        fixpoint.run(init_inv);
+      }
+
+      {
+        log::info(
+            "Checking properties and writing results for global constructor: " +
+            demangle(ctor->name()));
+        ScopeTimerDatabase t(_ctx.output_db->times,
+                             "ikos-analyzer.check." + ctor->name());
+        fixpoint.run_checks(checkers, &calling_contexts);
+      }
+
+      init_inv = fixpoint.exit_invariant();
+    }
+
+    if (_ctx.opts.display_invariants == DisplayOption::All) {
+      log::out() << "Invariant after global variable dynamic initialization:\n";
+      init_inv.dump(log::out());
+      log::out() << std::endl;
+    }
+  }
+
+  // Analyze the entry points
+  for (ar::Function* entry_point : entry_points) {
+    // Entry point initial invariant
+    AbstractDomain entry_inv = AbstractDomain::bottom();
+
+    if (std::find(_ctx.opts.no_init_globals.begin(),
+                  _ctx.opts.no_init_globals.end(),
+                  entry_point) == _ctx.opts.no_init_globals.end()) {
+      // Use invariant with initialized global variables
+      entry_inv = init_inv;
+    } else {
+      // Default invariant
+      entry_inv = init_invariant(machine_int_top);
+    }
+
+    if (entry_point->name() == "main" && entry_point->num_parameters() >= 2) {
+      entry_inv = init_main_invariant(_ctx, entry_point, entry_inv);
+    }
+
+    FunctionFixpoint fixpoint(_ctx, entry_point, summaries);
+
+    {
+      log::info("Analyzing entry point: " + demangle(entry_point->name()));
+      ScopeTimerDatabase t(_ctx.output_db->times,
+                           "ikos-analyzer.value." + entry_point->name());
+      fixpoint.run(entry_inv);
+    }
+
+    {
+      log::info("Checking properties and writing results for entry point: " +
+                demangle(entry_point->name()));
+      ScopeTimerDatabase t(_ctx.output_db->times,
+                           "ikos-analyzer.check." + entry_point->name());
+      fixpoint.run_checks(checkers, &calling_contexts);
+    }
+  }
+
+  // Call destructors
+  if (!dtors.empty()) {
+    log::info("Analyzing global destructors");
+
+    for (ar::Function* dtor : dtors) {
+      FunctionFixpoint fixpoint(_ctx, dtor, summaries);
+
+      {
+        log::info("Analyzing global destructor: " + demangle(dtor->name()));
+        ScopeTimerDatabase t(_ctx.output_db->times,
+                             "ikos-analyzer.value." + dtor->name());
+        // Note: We currently analyze destructors with the initial invariant
+        fixpoint.run(init_inv);
+      }
+
+      {
+        log::info(
+            "Checking properties and writing results for global destructor: " +
+            demangle(dtor->name()));
+        ScopeTimerDatabase t(_ctx.output_db->times,
+                             "ikos-analyzer.check." + dtor->name());
+        fixpoint.run_checks(checkers, &calling_contexts);
+      }
+
+      init_inv = fixpoint.exit_invariant();
+    }
+  }
+
+  // Check the other functions top-down, in their calling contexts
+  //
+  // The entry invariant of a function is the join of the invariants at its
+  // call sites, collected while checking its callers. Functions that might be
+  // called indirectly or recursively have calling contexts that are not all
+  // collected, they are checked from a top invariant instead. Functions
+  // without calling context are unreachable.
+  const auto& components = call_graph->components();
+  for (auto it = components.rbegin(), et = components.rend(); it != et; ++it) {
+    for (ar::Function* function : *it) {
+      if (std::find(roots.begin(), roots.end(), function) != roots.end()) {
+        continue;
+      }
+
+      AbstractDomain entry_inv = AbstractDomain::bottom();
+
+      if (call_graph->is_address_taken(function) ||
+          call_graph->is_recursive(function)) {
+        entry_inv = init_invariant(machine_int_top);
+      } else {
+        auto context_it = calling_contexts.find(function);
+        if (context_it == calling_contexts.end()) {
+          continue;
+        }
+        entry_inv = std::move(context_it->second);
+        calling_contexts.erase(context_it);
+      }
+
+      FunctionFixpoint fixpoint(_ctx, function, summaries);
+
+      {
+        log::info("Analyzing function: " + demangle(function->name()));
+        ScopeTimerDatabase t(_ctx.output_db->times,
+                             "ikos-analyzer.value." + function->name());
+        fixpoint.run(std::move(entry_inv));
+      }
+
+      {
+        log::info("Checking properties and writing results for function: " +
+                  demangle(function->name()));
+        ScopeTimerDatabase t(_ctx.output_db->times,
+                             "ikos-analyzer.check." + function->name());
+        fixpoint.run_checks(checkers, &calling_contexts);
+      }
+    }
+  }
+
+  // Insert all functions in the database
+  for (auto it = bundle->function_begin(), et = bundle->function_end();
+       it != et;
+       ++it) {
+    _ctx.output_db->functions.insert(*it);
+  }
+}
+
+} // end namespace analyzer
+} // end namespace ikos
@@ -52,7 +52,11 @@ namespace analyzer {
 // Variable
 
 Variable::Variable(VariableKind kind, ar::Type* type)
-    : _kind(kind), _type(type), _offset_var(nullptr) {
+    : _kind(kind),
+      _type(type),
+      _offset_var(nullptr),
+      _index(0),
+      _pack(boost::none) {
   ikos_assert(this->_type != nullptr);
 }
 
@@ -199,12 +203,21 @@ VariableFactory::VariableFactory(ar::Bundle* bundle)
 
 VariableFactory::~VariableFactory() = default;
 
+void VariableFactory::assign_index(Variable* vn) {
+  vn->_index = this->_next_index++;
+  if (vn->offset_var() != nullptr) {
+    vn->offset_var()->_index = this->_next_index++;
+  }
+}
+
 LocalVariable* VariableFactory::get_local(ar::LocalVariable* var) {
+  std::lock_guard< std::recursive_mutex > lock(this->_mutex);
   auto it = this->_local_variable_map.find(var);
   if (it == this->_local_variable_map.end()) {
     auto vn = new LocalVariable(var);
     vn->set_offset_var(
         std::make_unique< OffsetVariable >(this->_size_type, vn));
+    this->assign_index(vn);
     this->_local_variable_map.try_emplace(var,
                                           std::unique_ptr< LocalVariable >(vn));
     return vn;
@@ -214,11 +227,13 @@ LocalVariable* VariableFactory::get_local(ar::LocalVariable* var) {
 }
 
 GlobalVariable* VariableFactory::get_global(ar::GlobalVariable* var) {
+  std::lock_guard< std::recursive_mutex > lock(this->_mutex);
   auto it = this->_global_variable_map.find(var);
   if (it == this->_global_variable_map.end()) {
     auto vn = new GlobalVariable(var);
     vn->set_offset_var(
         std::make_unique< OffsetVariable >(this->_size_type, vn));
+    this->assign_index(vn);
     this->_global_variable_map.try_emplace(var,
                                            std::unique_ptr< GlobalVariable >(
                                                vn));
@@ -229,6 +244,7 @@ GlobalVariable* VariableFactory::get_global(ar::GlobalVariable* var) {
 }
 
 InternalVariable* VariableFactory::get_internal(ar::InternalVariable* var) {
+  std::lock_guard< std::recursive_mutex > lock(this->_mutex);
   auto it = this->_internal_variable_map.find(var);
   if (it == this->_internal_variable_map.end()) {
     auto vn = new InternalVariable(var);
@@ -236,6 +252,7 @@ InternalVariable* VariableFactory::get_internal(ar::InternalVariable* var) {
       vn->set_offset_var(
           std::make_unique< OffsetVariable >(this->_size_type, vn));
     }
+    this->assign_index(vn);
     this->_internal_variable_map
         .try_emplace(var, std::unique_ptr< InternalVariable >(vn));
     return vn;
@@ -246,11 +263,13 @@ InternalVariable* VariableFactory::get_internal(ar::InternalVariable* var) {
 
 InlineAssemblyPointerVariable* VariableFactory::get_asm_ptr(
     ar::InlineAssemblyConstant* cst) {
+  std::lock_guard< std::recursive_mutex > lock(this->_mutex);
   auto it = this->_inline_asm_pointer_map.find(cst);
   if (it == this->_inline_asm_pointer_map.end()) {
     auto vn = new InlineAssemblyPointerVariable(cst);
     vn->set_offset_var(
         std::make_unique< OffsetVariable >(this->_size_type, vn));
+    this->assign_index(vn);
     this->_inline_asm_pointer_map
         .try_emplace(cst, std::unique_ptr< InlineAssemblyPointerVariable >(vn));
     return vn;
@@ -260,11 +279,13 @@ InlineAssemblyPointerVariable* VariableFactory::get_asm_ptr(
 }
 
 FunctionPointerVariable* VariableFactory::get_function_ptr(ar::Function* fun) {
+  std::lock_guard< std::recursive_mutex > lock(this->_mutex);
   auto it = this->_function_pointer_map.find(fun);
   if (it == this->_function_pointer_map.end()) {
     auto vn = new FunctionPointerVariable(fun);
     vn->set_offset_var(
         std::make_unique< OffsetVariable >(this->_size_type, vn));
+    this->assign_index(vn);
     this->_function_pointer_map
         .try_emplace(fun, std::unique_ptr< FunctionPointerVariable >(vn));
     return vn;
@@ -281,6 +302,7 @@ FunctionPointerVariable* VariableFactory::get_function_ptr(
 CellVariable* VariableFactory::get_cell(MemoryLocation* address,
                                         const MachineInt& offset,
                                         const MachineInt& size) {
+  std::lock_guard< std::recursive_mutex > lock(this->_mutex);
   auto key = std::make_tuple(address, offset, size);
   auto it = this->_cell_map.find(key);
   if (it == this->_cell_map.end()) {
@@ -300,6 +322,7 @@ CellVariable* VariableFactory::get_cell(MemoryLocation* address,
     auto vn = new CellVariable(type, address, offset, size);
     vn->set_offset_var(
         std::make_unique< OffsetVariable >(this->_size_type, vn));
+    this->assign_index(vn);
     this->_cell_map.emplace(key, std::unique_ptr< CellVariable >(vn));
     return vn;
   } else {
@@ -308,9 +331,11 @@ CellVariable* VariableFactory::get_cell(MemoryLocation* address,
 }
 
 AllocSizeVariable* VariableFactory::get_alloc_size(MemoryLocation* address) {
+  std::lock_guard< std::recursive_mutex > lock(this->_mutex);
   auto it = this->_alloc_size_map.find(address);
   if (it == this->_alloc_size_map.end()) {
     auto vn = new AllocSizeVariable(this->_size_type, address);
+    this->assign_index(vn);
     this->_alloc_size_map.try_emplace(address,
                                       std::unique_ptr< AllocSizeVariable >(vn));
     return vn;
@@ -320,6 +345,7 @@ AllocSizeVariable* VariableFactory::get_alloc_size(MemoryLocation* address) {
 }
 
 ReturnVariable* VariableFactory::get_return(ar::Function* fun) {
+  std::lock_guard< std::recursive_mutex > lock(this->_mutex);
   auto it = this->_return_variable_map.find(fun);
   if (it == this->_return_variable_map.end()) {
     auto vn = new ReturnVariable(fun);
@@ -327,6 +353,7 @@ ReturnVariable* VariableFactory::get_return(ar::Function* fun) {
       vn->set_offset_var(
           std::make_unique< OffsetVariable >(this->_size_type, vn));
     }
+    this->assign_index(vn);
     this->_return_variable_map.try_emplace(fun,
                                            std::unique_ptr< ReturnVariable >(
                                                vn));
@@ -338,6 +365,7 @@ ReturnVariable* VariableFactory::get_return(ar::Function* fun) {
 
 NamedShadowVariable* VariableFactory::get_named_shadow(ar::Type* type,
                                                        llvm::StringRef name) {
+  std::lock_guard< std::recursive_mutex > lock(this->_mutex);
   auto it = this->_named_shadow_variable_map.find(name);
   if (it == this->_named_shadow_variable_map.end()) {
     auto vn = new NamedShadowVariable(type, name);
@@ -345,6 +373,7 @@ NamedShadowVariable* VariableFactory::get_named_shadow(ar::Type* type,
       vn->set_offset_var(
           std::make_unique< OffsetVariable >(this->_size_type, vn));
     }
+    this->assign_index(vn);
     this->_named_shadow_variable_map
         .try_emplace(name, std::unique_ptr< NamedShadowVariable >(vn));
     return vn;
@@ -354,12 +383,14 @@ NamedShadowVariable* VariableFactory::get_named_shadow(ar::Type* type,
 }
 
 UnnamedShadowVariable* VariableFactory::create_unnamed_shadow(ar::Type* type) {
+  std::lock_guard< std::recursive_mutex > lock(this->_mutex);
   std::size_t id = this->_unnamed_shadow_variable_vec.size();
   auto vn = new UnnamedShadowVariable(type, id);
   if (vn->type()->is_pointer() || vn->type()->is_aggregate()) {
     vn->set_offset_var(
         std::make_unique< OffsetVariable >(this->_size_type, vn));
   }
+  this->assign_index(vn);
   this->_unnamed_shadow_variable_vec.emplace_back(
       std::unique_ptr< UnnamedShadowVariable >(vn));
   return vn;
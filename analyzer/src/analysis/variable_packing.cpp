@@ -0,0 +1,286 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Implementation of the syntactic variable packing analysis
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2011-2018 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <algorithm>
+
+#include <ikos/core/adt/union_find.hpp>
+
+#include <ikos/ar/semantic/code.hpp>
+#include <ikos/ar/semantic/function.hpp>
+#include <ikos/ar/semantic/statement.hpp>
+
+#include <ikos/analyzer/analysis/variable_packing.hpp>
+#include <ikos/analyzer/util/log.hpp>
+
+namespace ikos {
+namespace analyzer {
+namespace {
+
+/// \brief Union-find on the variables of a bundle
+using VariableUnionFind = core::UnionFind< Variable* >;
+
+/// \brief Compute the packs of the function bodies of a bundle
+class PackBuilder {
+private:
+  /// \brief Variable factory
+  VariableFactory& _vfac;
+
+  /// \brief Packs
+  VariableUnionFind _packs;
+
+  /// \brief Map from variable to the code it belongs to
+  llvm::DenseMap< Variable*, ar::Code* > _codes;
+
+public:
+  /// \brief Constructor
+  explicit PackBuilder(VariableFactory& vfac)
+      : _vfac(vfac), _packs(VariablePackingAnalysis::MaxPackSize) {}
+
+  /// \brief Return the union-find of the packs
+  VariableUnionFind& packs() { return this->_packs; }
+
+  /// \brief Return the code of a variable in the union-find
+  ar::Code* code(Variable* var) const { return this->_codes.lookup(var); }
+
+  /// \brief Process a statement
+  void process(ar::Statement* stmt) {
+    if (stmt->has_result()) {
+      this->variable_ref(stmt->result());
+    }
+    for (auto it = stmt->op_begin(), et = stmt->op_end(); it != et; ++it) {
+      this->variable_ref(*it);
+    }
+
+    if (auto s = ar::dyn_cast< ar::Assignment >(stmt)) {
+      this->merge(s->result(), s->operand());
+    } else if (auto s = ar::dyn_cast< ar::UnaryOperation >(stmt)) {
+      switch (s->op()) {
+        case ar::UnaryOperation::UTrunc:
+        case ar::UnaryOperation::STrunc:
+        case ar::UnaryOperation::ZExt:
+        case ar::UnaryOperation::SExt:
+        case ar::UnaryOperation::Bitcast: {
+          this->merge(s->result(), s->operand());
+        } break;
+        default:
+          break;
+      }
+    } else if (auto s = ar::dyn_cast< ar::BinaryOperation >(stmt)) {
+      switch (s->op()) {
+        case ar::BinaryOperation::UAdd:
+        case ar::BinaryOperation::USub:
+        case ar::BinaryOperation::SAdd:
+        case ar::BinaryOperation::SSub: {
+          this->merge(s->result(), s->left());
+          this->merge(s->result(), s->right());
+        } break;
+        default:
+          break;
+      }
+    } else if (auto s = ar::dyn_cast< ar::Comparison >(stmt)) {
+      this->merge(s->left(), s->right());
+    } else if (auto s = ar::dyn_cast< ar::PointerShift >(stmt)) {
+      this->merge(s->result(), s->pointer());
+    } else if (auto s = ar::dyn_cast< ar::CallBase >(stmt)) {
+      this->process_call(s);
+    }
+  }
+
+private:
+  /// \brief Process a direct call
+  ///
+  /// Actual parameters are packed with the formal parameters, and the result
+  /// of the call with the returned value, so that the inlining and the
+  /// summaries keep the relations between the caller and the callee.
+  void process_call(ar::CallBase* call) {
+    auto cst = ar::dyn_cast< ar::FunctionPointerConstant >(call->called());
+    if (cst == nullptr || !cst->function()->is_definition()) {
+      return;
+    }
+    ar::Function* callee = cst->function();
+
+    std::size_t n = std::min(call->num_arguments(), callee->num_parameters());
+    for (std::size_t i = 0; i < n; i++) {
+      this->merge(call->argument(i), callee->param(i));
+    }
+
+    ar::BasicBlock* exit = callee->body()->exit_block_or_null();
+    if (call->has_result() && exit != nullptr && !exit->empty()) {
+      auto ret = ar::dyn_cast< ar::ReturnValue >(exit->back());
+      if (ret != nullptr && ret->has_operand()) {
+        this->merge(call->result(), ret->operand());
+      }
+    }
+  }
+
+  /// \brief Get the numerical Variable* of an ar::Value and add it in the
+  /// union-find
+  ///
+  /// This is the variable itself for integers, and the offset variable for
+  /// pointers. Returns nullptr if the value is not an internal or local
+  /// variable.
+  Variable* variable_ref(ar::Value* value) {
+    Variable* var = nullptr;
+    ar::Code* code = nullptr;
+    if (auto lv = ar::dyn_cast< ar::LocalVariable >(value)) {
+      var = this->_vfac.get_local(lv);
+      code = lv->function()->body();
+    } else if (auto iv = ar::dyn_cast< ar::InternalVariable >(value)) {
+      var = this->_vfac.get_internal(iv);
+      code = iv->code();
+    } else {
+      return nullptr;
+    }
+
+    if (var->type()->is_integer()) {
+      // var is the numerical variable
+    } else if (var->offset_var() != nullptr) {
+      var = var->offset_var();
+    } else {
+      return nullptr;
+    }
+
+    this->_packs.add(var);
+    this->_codes[var] = code;
+    return var;
+  }
+
+  /// \brief Merge the packs of the given values
+  void merge(ar::Value* x, ar::Value* y) {
+    Variable* x_var = this->variable_ref(x);
+    Variable* y_var = this->variable_ref(y);
+
+    if (x_var != nullptr && y_var != nullptr) {
+      this->_packs.merge(x_var, y_var);
+    }
+  }
+
+}; // end class PackBuilder
+
+} // end anonymous namespace
+
+VariablePackingAnalysis::VariablePackingAnalysis(Context& ctx) : _ctx(ctx) {}
+
+VariablePackingAnalysis::~VariablePackingAnalysis() = default;
+
+void VariablePackingAnalysis::run() {
+  ar::Bundle* bundle = _ctx.bundle;
+  PackBuilder builder(*_ctx.var_factory);
+
+  for (auto it = bundle->function_begin(), et = bundle->function_end();
+       it != et;
+       ++it) {
+    ar::Function* fun = *it;
+    if (fun->is_definition()) {
+      log::debug("Running variable packing analysis on function @" +
+                 fun->name());
+      for (ar::BasicBlock* bb : *fun->body()) {
+        for (ar::Statement* stmt : *bb) {
+          builder.process(stmt);
+        }
+      }
+    }
+  }
+
+  // Store the packs, split by code for the dump
+  VariableUnionFind& packs = builder.packs();
+  llvm::DenseMap< ar::Code*, llvm::DenseMap< Variable*, VariableRefList > >
+      code_root_to_vars;
+
+  for (const auto& p : packs) {
+    Variable* root = packs.find(p.first);
+    p.first->set_pack(root->index());
+    code_root_to_vars[builder.code(p.first)][root].push_back(p.first);
+  }
+
+  auto by_index = [](Variable* x, Variable* y) {
+    return x->index() < y->index();
+  };
+
+  for (auto& code_packs : code_root_to_vars) {
+    PackList& pack_list = this->_packs_map[code_packs.first];
+    for (auto& p : code_packs.second) {
+      std::sort(p.second.begin(), p.second.end(), by_index);
+      pack_list.push_back(std::move(p.second));
+    }
+    std::sort(pack_list.begin(),
+              pack_list.end(),
+              [=](const VariableRefList& x, const VariableRefList& y) {
+                return by_index(x.front(), y.front());
+              });
+  }
+}
+
+void VariablePackingAnalysis::dump(std::ostream& o) const {
+  ar::Bundle* bundle = _ctx.bundle;
+
+  for (auto it = bundle->function_begin(), et = bundle->function_end();
+       it != et;
+       ++it) {
+    ar::Function* fun = *it;
+    if (!fun->is_definition()) {
+      continue;
+    }
+
+    auto packs_it = this->_packs_map.find(fun->body());
+    if (packs_it == this->_packs_map.end()) {
+      continue;
+    }
+
+    o << "Variable packs for function @" << fun->name() << ":\n";
+    for (const VariableRefList& pack : packs_it->second) {
+      o << "{";
+      for (auto var_it = pack.begin(), var_et = pack.end(); var_it != var_et;) {
+        (*var_it)->dump(o);
+        ++var_it;
+        if (var_it != var_et) {
+          o << ", ";
+        }
+      }
+      o << "}\n";
+    }
+  }
+}
+
+} // end namespace analyzer
+} // end namespace ikos
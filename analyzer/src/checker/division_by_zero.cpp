@@ -1,152 +0,0 @@
-/*******************************************************************************
- *
- * \file
- * \brief Division by zero checker implementation
- *
- * Author: Maxime Arthaud
- *
- * Contact: ikos@lists.nasa.gov
- *
- * Notices:
- *
- * Copyright (c) 2011-2018 United States Government as represented by the
- * Administrator of the National Aeronautics and Space Administration.
- * All Rights Reserved.
- *
- * Disclaimers:
- *
- * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
- * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
- * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
- * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
- * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
- * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
- * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
- * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
- * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
- * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
- * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
- * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
- *
- * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
- * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
- * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
- * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
- * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
- * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
- * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
- * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
- * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
- * UNILATERAL TERMINATION OF THIS AGREEMENT.
- *
- ******************************************************************************/
-
-#include <ikos/analyzer/analysis/literal.hpp>
-#include <ikos/analyzer/checker/division_by_zero.hpp>
-#include <ikos/analyzer/json/helper.hpp>
-#include <ikos/analyzer/support/cast.hpp>
-#include <ikos/analyzer/util/log.hpp>
-
-namespace ikos {
-namespace analyzer {
-
-DivisionByZeroChecker::DivisionByZeroChecker(Context& ctx) : Checker(ctx) {}
-
-CheckerName DivisionByZeroChecker::name() const {
-  return CheckerName::DivisionByZero;
-}
-
-const char* DivisionByZeroChecker::description() const {
-  return "Division by zero checker";
-}
-
-void DivisionByZeroChecker::check(ar::Statement* stmt,
-                                  const value::AbstractDomain& inv,
-                                  CallContext* call_context) {
-  if (auto bin = dyn_cast< ar::BinaryOperation >(stmt)) {
-    if (bin->op() == ar::BinaryOperation::UDiv ||
-        bin->op() == ar::BinaryOperation::SDiv ||
-        bin->op() == ar::BinaryOperation::URem ||
-        bin->op() == ar::BinaryOperation::SRem) {
-      CheckResult check = this->check_division(bin, inv);
-      this->display_invariant(check.result, stmt, inv);
-      this->_checks.insert(check.kind,
-                           CheckerName::DivisionByZero,
-                           check.result,
-                           stmt,
-                           call_context,
-                           std::array< ar::Value*, 1 >{{bin->right()}},
-                           check.info);
-    }
-  }
-}
-
-DivisionByZeroChecker::CheckResult DivisionByZeroChecker::check_division(
-    ar::BinaryOperation* stmt, const value::AbstractDomain& inv) {
-  if (inv.is_normal_flow_bottom()) {
-    // Statement unreachable
-    if (this->display_division_check(Result::Unreachable, stmt)) {
-      out() << std::endl;
-    }
-    return {CheckKind::Unreachable, Result::Unreachable, {}};
-  }
-
-  const ScalarLit& lit = this->_lit_factory.get_scalar(stmt->right());
-
-  if (lit.is_undefined() ||
-      (lit.is_machine_int_var() &&
-       inv.normal().uninitialized().is_uninitialized(lit.var()))) {
-    // Undefined operand
-    if (this->display_division_check(Result::Error, stmt)) {
-      out() << ": undefined operand" << std::endl;
-    }
-    return {CheckKind::UninitializedVariable, Result::Error, {}};
-  }
-
-  IntInterval divisor;
-  if (lit.is_machine_int()) {
-    divisor = IntInterval(lit.machine_int());
-  } else if (lit.is_machine_int_var()) {
-    divisor = inv.normal().integers().to_interval(lit.var());
-  } else {
-    log::error("unexpected operand to ar::BinaryOperation");
-    return {CheckKind::UnexpectedOperand, Result::Error, {}};
-  }
-
-  boost::optional< MachineInt > d = divisor.singleton();
-
-  if (d && (*d).is_zero()) {
-    // The second operand is definitely 0
-    if (this->display_division_check(Result::Error, stmt)) {
-      out() << ": ∀d ∈ divisor, d == 0" << std::endl;
-    }
-    return {CheckKind::DivisionByZero, Result::Error, {}};
-  } else if (divisor.contains(
-                 MachineInt(0, divisor.bit_width(), divisor.sign()))) {
-    // The second operand may be 0
-    if (this->display_division_check(Result::Warning, stmt)) {
-      out() << ": ∃d ∈ divisor, d == 0" << std::endl;
-    }
-    return {CheckKind::DivisionByZero, Result::Warning, to_json(divisor)};
-  } else {
-    // The second operand cannot be definitely 0
-    if (this->display_division_check(Result::Ok, stmt)) {
-      out() << ": ∀d ∈ divisor, d != 0" << std::endl;
-    }
-    return {CheckKind::DivisionByZero, Result::Ok, {}};
-  }
-}
-
-bool DivisionByZeroChecker::display_division_check(
-    Result result, ar::BinaryOperation* stmt) const {
-  if (this->display_check(result, stmt)) {
-    out() << "check_dbz(";
-    stmt->dump(out());
-    out() << ")";
-    return true;
-  }
-  return false;
-}
-
-} // end namespace analyzer
-} // end namespace ikos
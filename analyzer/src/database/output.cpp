@@ -50,6 +50,7 @@ OutputDatabase::OutputDatabase(sqlite::DbConnection& db_)
     : db(db_),
       settings(db_),
       times(db_),
+      statistics(db_),
       files(db_),
       functions(db_, files),
       statements(db_, files, functions),
@@ -73,6 +73,7 @@ void ChecksTable::insert(CheckKind kind,
                          CallContext* call_context,
                          llvm::ArrayRef< ar::Value* > operands,
                          const JsonDict& info) {
+  std::lock_guard< std::recursive_mutex > lock(this->_db.mutex());
   sqlite::DbInt64 id = this->_last_insert_id++;
 
   this->_row << id;
@@ -58,6 +58,8 @@ FilesTable::FilesTable(sqlite::DbConnection& db)
 sqlite::DbInt64 FilesTable::insert(llvm::DIFile* file) {
   ikos_assert(file != nullptr);
 
+  std::lock_guard< std::recursive_mutex > lock(this->_db.mutex());
+
   // Check in _di_file_map
   {
     auto it = this->_di_file_map.find(file);
@@ -66,6 +66,7 @@ FunctionsTable::FunctionsTable(sqlite::DbConnection& db, FilesTable& files)
 sqlite::DbInt64 FunctionsTable::insert(ar::Function* fun) {
   ikos_assert(fun != nullptr);
 
+  std::lock_guard< std::recursive_mutex > lock(this->_db.mutex());
   auto it = this->_map.find(fun);
   if (it != this->_map.end()) {
     return it->second;
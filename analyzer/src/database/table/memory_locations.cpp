@@ -72,6 +72,7 @@ MemoryLocationsTable::MemoryLocationsTable(sqlite::DbConnection& db,
 sqlite::DbInt64 MemoryLocationsTable::insert(MemoryLocation* mem_loc) {
   ikos_assert(mem_loc != nullptr);
 
+  std::lock_guard< std::recursive_mutex > lock(this->_db.mutex());
   auto it = this->_map.find(mem_loc);
   if (it != this->_map.end()) {
     return it->second;
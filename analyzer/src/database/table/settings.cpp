@@ -55,10 +55,12 @@ SettingsTable::SettingsTable(sqlite::DbConnection& db)
       _row(db, "settings", 2) {}
 
 void SettingsTable::insert(StringRef name, const char* value) {
+  std::lock_guard< std::recursive_mutex > lock(this->_db.mutex());
   this->_row << name << StringRef(value) << sqlite::end_row;
 }
 
 void SettingsTable::insert(StringRef name, StringRef value) {
+  std::lock_guard< std::recursive_mutex > lock(this->_db.mutex());
   this->_row << name << value << sqlite::end_row;
 }
 
@@ -66,6 +66,7 @@ StatementsTable::StatementsTable(sqlite::DbConnection& db,
 sqlite::DbInt64 StatementsTable::insert(ar::Statement* stmt) {
   ikos_assert(stmt != nullptr);
 
+  std::lock_guard< std::recursive_mutex > lock(this->_db.mutex());
   auto it = this->_map.find(stmt);
   if (it != this->_map.end()) {
     return it->second;
@@ -55,6 +55,7 @@ TimesTable::TimesTable(sqlite::DbConnection& db)
       _row(db, "times", 2) {}
 
 void TimesTable::insert(StringRef name, sqlite::DbDouble time) {
+  std::lock_guard< std::recursive_mutex > lock(this->_db.mutex());
   this->_row << name << time << sqlite::end_row;
 }
 
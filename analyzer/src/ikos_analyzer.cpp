@@ -42,6 +42,7 @@
  *
  ******************************************************************************/
 
+#include <algorithm>
 #include <iostream>
 
 #include <boost/filesystem.hpp>
@@ -57,6 +58,8 @@
 #include <llvm/Support/SourceMgr.h>
 #include <llvm/Support/raw_ostream.h>
 
+#include <ikos/core/support/thread_pool.hpp>
+
 #include <ikos/ar/format/dot.hpp>
 #include <ikos/ar/format/formatter.hpp>
 #include <ikos/ar/format/text.hpp>
@@ -83,13 +86,17 @@
 #include <ikos/analyzer/analysis/result.hpp>
 #include <ikos/analyzer/analysis/value/interprocedural.hpp>
 #include <ikos/analyzer/analysis/value/intraprocedural.hpp>
+#include <ikos/analyzer/analysis/value/summary.hpp>
 #include <ikos/analyzer/analysis/variable.hpp>
+#include <ikos/analyzer/analysis/variable_packing.hpp>
+#include <ikos/analyzer/analysis/wto.hpp>
 #include <ikos/analyzer/checker/name.hpp>
 #include <ikos/analyzer/database/output.hpp>
 #include <ikos/analyzer/util/color.hpp>
 #include <ikos/analyzer/util/log.hpp>
 #include <ikos/analyzer/util/timer.hpp>
 
+namespace core = ikos::core;
 namespace ar = ikos::ar;
 namespace llvm_to_ar = ikos::frontend::import;
 namespace analyzer = ikos::analyzer;
@@ -224,6 +231,18 @@ static llvm::cl::opt< analyzer::MachineIntDomainOption > Domain(
                    machine_int_domain_option_str(
                        analyzer::MachineIntDomainOption::DBM),
                    "Difference-Bound Matrices domain"),
+        clEnumValN(analyzer::MachineIntDomainOption::SparseDBM,
+                   machine_int_domain_option_str(
+                       analyzer::MachineIntDomainOption::SparseDBM),
+                   "Sparse Difference-Bound Matrices domain"),
+        clEnumValN(analyzer::MachineIntDomainOption::NativeDBM,
+                   machine_int_domain_option_str(
+                       analyzer::MachineIntDomainOption::NativeDBM),
+                   "Difference-Bound Matrices domain on machine integers"),
+        clEnumValN(analyzer::MachineIntDomainOption::Octagon,
+                   machine_int_domain_option_str(
+                       analyzer::MachineIntDomainOption::Octagon),
+                   "Octagon domain"),
         clEnumValN(analyzer::MachineIntDomainOption::VarPackDBM,
                    machine_int_domain_option_str(
                        analyzer::MachineIntDomainOption::VarPackDBM),
@@ -333,7 +352,10 @@ static llvm::cl::opt< analyzer::Procedural > Procedural(
                                 "Interprocedural analysis (default)"),
                      clEnumValN(analyzer::Procedural::Intraprocedural,
                                 "intra",
-                                "Intraprocedural analysis")),
+                                "Intraprocedural analysis"),
+                     clEnumValN(analyzer::Procedural::Summary,
+                                "summary",
+                                "Bottom-up summary-based analysis")),
     llvm::cl::init(analyzer::Procedural::Interprocedural),
     llvm::cl::cat(AnalysisCategory));
 
@@ -342,6 +364,11 @@ static llvm::cl::opt< bool > NoLiveness(
     llvm::cl::desc("Disable the liveness analysis"),
     llvm::cl::cat(AnalysisCategory));
 
+static llvm::cl::opt< bool > NoSyntacticPacking(
+    "no-syntactic-packing",
+    llvm::cl::desc("Disable the syntactic variable packing analysis"),
+    llvm::cl::cat(AnalysisCategory));
+
 static llvm::cl::opt< bool > NoPointer(
     "no-pointer",
     llvm::cl::desc("Disable the pointer analysis"),
@@ -352,6 +379,12 @@ static llvm::cl::opt< bool > NoFixpointProfiles(
     llvm::cl::desc("Disable the fixpoint profiles analysis"),
     llvm::cl::cat(AnalysisCategory));
 
+static llvm::cl::opt< bool > SparseInvariants(
+    "sparse-invariants",
+    llvm::cl::desc("Only store invariants at cycle heads and join points, "
+                   "recompute the others during the checks"),
+    llvm::cl::cat(AnalysisCategory));
+
 static llvm::cl::opt< analyzer::Precision > Precision(
     "prec",
     llvm::cl::desc("Precision level:"),
@@ -408,6 +441,22 @@ static llvm::cl::opt< int > Argc("argc",
                                  llvm::cl::init(-1),
                                  llvm::cl::cat(AnalysisCategory));
 
+static llvm::cl::opt< unsigned > Jobs(
+    "j",
+    llvm::cl::desc("Number of threads used by the pointer and value analyses"),
+    llvm::cl::value_desc("jobs"),
+    llvm::cl::init(1),
+    llvm::cl::cat(AnalysisCategory));
+
+static llvm::cl::opt< unsigned > FixpointJobs(
+    "fixpoint-jobs",
+    llvm::cl::desc("Number of threads used to analyze independent parts of a "
+                   "function (intra-procedural and summary-based analyses, "
+                   "no effect with -proc=inter)"),
+    llvm::cl::value_desc("jobs"),
+    llvm::cl::init(1),
+    llvm::cl::cat(AnalysisCategory));
+
 /// @}
 /// \name Import options
 /// @{
@@ -483,6 +532,11 @@ static llvm::cl::opt< bool > DisplayLiveness(
     llvm::cl::desc("Display liveness analysis results"),
     llvm::cl::cat(DebugCategory));
 
+static llvm::cl::opt< bool > DisplayVariablePacking(
+    "display-variable-packing",
+    llvm::cl::desc("Display variable packing analysis results"),
+    llvm::cl::cat(DebugCategory));
+
 static llvm::cl::opt< bool > DisplayFunctionPointer(
     "display-function-pointer",
     llvm::cl::desc("Display function pointer analysis results"),
@@ -598,6 +652,40 @@ inline Iterator find_undefined_functions(Iterator begin,
   });
 }
 
+/// \brief Return the number of threads used by the pointer and value analyses
+static unsigned analysis_jobs() {
+  unsigned jobs = std::max(Jobs.getValue(), 1U);
+  if (jobs > 1 && analyzer::machine_int_domain_option_uses_apron(Domain)) {
+    analyzer::log::warning(
+        "Abstract domain " +
+        std::string(analyzer::machine_int_domain_option_str(Domain)) +
+        " uses a global Apron manager, the value analysis uses 1 thread");
+  }
+  return jobs;
+}
+
+/// \brief Return the number of threads used to analyze independent parts of a
+/// function
+///
+/// Only the intraprocedural and summary-based analyses use them. Threads share
+/// invariants, thus the abstract domain must be thread-safe.
+static unsigned analysis_fixpoint_jobs() {
+  unsigned jobs = std::max(FixpointJobs.getValue(), 1U);
+  if (jobs > 1 && Procedural == analyzer::Procedural::Interprocedural) {
+    analyzer::log::warning(
+        "Option -fixpoint-jobs has no effect with -proc=inter, using 1 thread");
+    jobs = 1;
+  } else if (jobs > 1 &&
+             !analyzer::machine_int_domain_option_is_thread_safe(Domain)) {
+    analyzer::log::warning(
+        "Abstract domain " +
+        std::string(analyzer::machine_int_domain_option_str(Domain)) +
+        " is not thread-safe, using 1 thread per function");
+    jobs = 1;
+  }
+  return jobs;
+}
+
 /// \brief Build analysis options from command line arguments
 static analyzer::AnalysisOptions make_analysis_options(ar::Bundle* bundle) {
   auto resolve_function = [=](const auto& name) {
@@ -617,13 +705,17 @@ static analyzer::AnalysisOptions make_analysis_options(ar::Bundle* bundle) {
       .machine_int_domain = Domain,
       .procedural = Procedural,
       .use_liveness = !NoLiveness,
+      .use_syntactic_packing = !NoSyntacticPacking,
       .use_pointer = !NoPointer,
+      .sparse_invariants = SparseInvariants,
       .precision = Precision,
       .globals_init_policy = GlobalsInitPolicy,
       .display_invariants = DisplayInvariants,
       .display_checks = DisplayChecks,
       .hardware_addresses = {bundle, HardwareAddresses, HardwareAddressesFile},
       .argc = ((Argc >= 0) ? boost::optional< int >(Argc) : boost::none),
+      .jobs = analysis_jobs(),
+      .fixpoint_jobs = analysis_fixpoint_jobs(),
   };
 }
 
@@ -860,11 +952,15 @@ int main(int argc, char** argv) {
     analyzer::AnalysisOptions opts = make_analysis_options(bundle);
     opts.save(output_db.settings);
 
+    // Each job might analyze independent parts of a function concurrently
+    core::ThreadPool::get().set_max_threads(opts.jobs * opts.fixpoint_jobs);
+
     // Initialize factories
     analyzer::MemoryFactory mem_factory;
     analyzer::VariableFactory var_factory(bundle);
     analyzer::LiteralFactory lit_factory(var_factory, bundle->data_layout());
     analyzer::CallContextFactory call_context_factory;
+    analyzer::WtoCache wto_cache;
 
     // Analysis context
     analyzer::Context ctx(bundle,
@@ -874,7 +970,8 @@ int main(int argc, char** argv) {
                           mem_factory,
                           var_factory,
                           lit_factory,
-                          call_context_factory);
+                          call_context_factory,
+                          wto_cache);
 
     // First, run a liveness analysis
     //
@@ -892,6 +989,21 @@ int main(int argc, char** argv) {
       liveness.dump(analyzer::log::out());
     }
 
+    // Run a syntactic variable packing analysis
+    //
+    // This bounds the size of the packs of the relational domains
+    analyzer::VariablePackingAnalysis packing(ctx);
+    if (analyzer::machine_int_domain_option_has_var_packing(Domain) &&
+        !NoSyntacticPacking) {
+      analyzer::log::info("Running variable packing analysis");
+      analyzer::ScopeTimerDatabase t(output_db.times,
+                                     "ikos-analyzer.variable-packing-analysis");
+      packing.run();
+    }
+    if (DisplayVariablePacking) {
+      packing.dump(analyzer::log::out());
+    }
+
     // Run the fixpoint profile analysis
     //
     // This is used to detect widening hints, useful for other analyses
@@ -912,7 +1024,7 @@ int main(int argc, char** argv) {
     // The goal here is to get all function pointers so that we can analyse
     // precisely indirect calls in the following analyses
     analyzer::FunctionPointerAnalysis function_pointer(ctx);
-    if (Procedural == analyzer::Procedural::Intraprocedural && !NoPointer) {
+    if (Procedural != analyzer::Procedural::Interprocedural && !NoPointer) {
       analyzer::log::info("Running function pointer analysis");
       analyzer::ScopeTimerDatabase t(output_db.times,
                                      "ikos-analyzer.function-pointer-analysis");
@@ -927,7 +1039,7 @@ int main(int argc, char** argv) {
     //
     // That step uses the result of the previous function pointer analysis.
     analyzer::PointerAnalysis pointer(ctx, function_pointer);
-    if (Procedural == analyzer::Procedural::Intraprocedural && !NoPointer) {
+    if (Procedural != analyzer::Procedural::Interprocedural && !NoPointer) {
       analyzer::log::info("Running pointer analysis");
       analyzer::ScopeTimerDatabase t(output_db.times,
                                      "ikos-analyzer.pointer-analysis");
@@ -951,6 +1063,12 @@ int main(int argc, char** argv) {
       analyzer::ScopeTimerDatabase t(output_db.times,
                                      "ikos-analyzer.value-analysis");
       analysis.run();
+    } else if (Procedural == analyzer::Procedural::Summary) {
+      analyzer::SummaryValueAnalysis analysis(ctx);
+      analyzer::log::info("Running summary-based value analysis");
+      analyzer::ScopeTimerDatabase t(output_db.times,
+                                     "ikos-analyzer.value-analysis");
+      analysis.run();
     } else {
       ikos_unreachable("unreachable");
     }
@@ -0,0 +1,15 @@
+// UNSAFE
+
+int abs_value(int x) {
+  if (x > 0) {
+    return x;
+  } else {
+    return -x;
+  }
+}
+
+int main() {
+  int y = abs_value(-3);
+  int z = 0;
+  return y / z;
+}
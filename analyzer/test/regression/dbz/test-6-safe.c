@@ -0,0 +1,9 @@
+// SAFE
+
+int divide(int x, int y) {
+  return x / y;
+}
+
+int main() {
+  return divide(10, 2);
+}
@@ -72,10 +72,12 @@ ContextImpl::ContextImpl()
 ContextImpl::~ContextImpl() = default;
 
 void ContextImpl::add_bundle(std::unique_ptr< Bundle > bundle) {
+  std::lock_guard< std::recursive_mutex > lock(this->_mutex);
   this->_bundles.emplace_back(std::move(bundle));
 }
 
 IntegerType* ContextImpl::integer_type(unsigned bit_width, Signedness sign) {
+  std::lock_guard< std::recursive_mutex > lock(this->_mutex);
   auto it = this->_integer_types.find(std::make_pair(bit_width, sign));
   if (it == this->_integer_types.end()) {
     auto type = new IntegerType(bit_width, sign);
@@ -88,6 +90,7 @@ IntegerType* ContextImpl::integer_type(unsigned bit_width, Signedness sign) {
 }
 
 PointerType* ContextImpl::pointer_type(Type* pointee) {
+  std::lock_guard< std::recursive_mutex > lock(this->_mutex);
   auto it = this->_pointer_types.find(pointee);
   if (it == this->_pointer_types.end()) {
     auto type = new PointerType(pointee);
@@ -99,6 +102,7 @@ PointerType* ContextImpl::pointer_type(Type* pointee) {
 }
 
 ArrayType* ContextImpl::array_type(Type* element_type, ZNumber num_element) {
+  std::lock_guard< std::recursive_mutex > lock(this->_mutex);
   auto it = this->_array_types.find(std::make_pair(element_type, num_element));
   if (it == this->_array_types.end()) {
     auto type = new ArrayType(element_type, num_element);
@@ -111,6 +115,7 @@ ArrayType* ContextImpl::array_type(Type* element_type, ZNumber num_element) {
 }
 
 VectorType* ContextImpl::vector_type(Type* element_type, ZNumber num_element) {
+  std::lock_guard< std::recursive_mutex > lock(this->_mutex);
   auto it = this->_vector_types.find(std::make_pair(element_type, num_element));
   if (it == this->_vector_types.end()) {
     auto type = new VectorType(element_type, num_element);
@@ -126,6 +131,7 @@ FunctionType* ContextImpl::function_type(
     Type* return_type,
     const FunctionType::ParamTypes& param_types,
     bool is_var_arg) {
+  std::lock_guard< std::recursive_mutex > lock(this->_mutex);
   auto it = this->_function_types.find(
       std::make_tuple(return_type, param_types, is_var_arg));
   if (it == this->_function_types.end()) {
@@ -141,10 +147,12 @@ FunctionType* ContextImpl::function_type(
 }
 
 void ContextImpl::add_type(std::unique_ptr< Type > type) {
+  std::lock_guard< std::recursive_mutex > lock(this->_mutex);
   this->_types.emplace_back(std::move(type));
 }
 
 UndefinedConstant* ContextImpl::undefined_cst(Type* type) {
+  std::lock_guard< std::recursive_mutex > lock(this->_mutex);
   auto it = this->_undefined_constants.find(type);
   if (it == this->_undefined_constants.end()) {
     auto cst = new UndefinedConstant(type);
@@ -158,6 +166,7 @@ UndefinedConstant* ContextImpl::undefined_cst(Type* type) {
 }
 
 IntegerConstant* ContextImpl::integer_cst(IntegerType* type, MachineInt value) {
+  std::lock_guard< std::recursive_mutex > lock(this->_mutex);
   auto it = this->_integer_constants.find(std::make_pair(type, value));
   if (it == this->_integer_constants.end()) {
     auto cst = new IntegerConstant(type, value);
@@ -171,6 +180,7 @@ IntegerConstant* ContextImpl::integer_cst(IntegerType* type, MachineInt value) {
 
 FloatConstant* ContextImpl::float_cst(FloatType* type,
                                       const std::string& value) {
+  std::lock_guard< std::recursive_mutex > lock(this->_mutex);
   auto it = this->_float_constants.find(std::make_pair(type, value));
   if (it == this->_float_constants.end()) {
     auto cst = new FloatConstant(type, value);
@@ -183,6 +193,7 @@ FloatConstant* ContextImpl::float_cst(FloatType* type,
 }
 
 NullConstant* ContextImpl::null_cst(PointerType* type) {
+  std::lock_guard< std::recursive_mutex > lock(this->_mutex);
   auto it = this->_null_constants.find(type);
   if (it == this->_null_constants.end()) {
     auto cst = new NullConstant(type);
@@ -195,6 +206,7 @@ NullConstant* ContextImpl::null_cst(PointerType* type) {
 
 StructConstant* ContextImpl::struct_cst(StructType* type,
                                         const StructConstant::Values& values) {
+  std::lock_guard< std::recursive_mutex > lock(this->_mutex);
   auto it = this->_struct_constants.find(std::make_pair(type, values));
   if (it == this->_struct_constants.end()) {
     auto cst = new StructConstant(type, values);
@@ -208,6 +220,7 @@ StructConstant* ContextImpl::struct_cst(StructType* type,
 
 ArrayConstant* ContextImpl::array_cst(ArrayType* type,
                                       const ArrayConstant::Values& values) {
+  std::lock_guard< std::recursive_mutex > lock(this->_mutex);
   auto it = this->_array_constants.find(std::make_pair(type, values));
   if (it == this->_array_constants.end()) {
     auto cst = new ArrayConstant(type, values);
@@ -221,6 +234,7 @@ ArrayConstant* ContextImpl::array_cst(ArrayType* type,
 
 VectorConstant* ContextImpl::vector_cst(VectorType* type,
                                         const VectorConstant::Values& values) {
+  std::lock_guard< std::recursive_mutex > lock(this->_mutex);
   auto it = this->_vector_constants.find(std::make_pair(type, values));
   if (it == this->_vector_constants.end()) {
     auto cst = new VectorConstant(type, values);
@@ -233,6 +247,7 @@ VectorConstant* ContextImpl::vector_cst(VectorType* type,
 }
 
 AggregateZeroConstant* ContextImpl::aggregate_zero_cst(AggregateType* type) {
+  std::lock_guard< std::recursive_mutex > lock(this->_mutex);
   auto it = this->_aggregate_zero_constants.find(type);
   if (it == this->_aggregate_zero_constants.end()) {
     auto cst = new AggregateZeroConstant(type);
@@ -245,6 +260,7 @@ AggregateZeroConstant* ContextImpl::aggregate_zero_cst(AggregateType* type) {
 }
 
 FunctionPointerConstant* ContextImpl::function_pointer_cst(Function* function) {
+  std::lock_guard< std::recursive_mutex > lock(this->_mutex);
   auto it = this->_function_pointer_constants.find(function);
   if (it == this->_function_pointer_constants.end()) {
     ikos_assert_msg(function, "function is null");
@@ -260,6 +276,7 @@ FunctionPointerConstant* ContextImpl::function_pointer_cst(Function* function) {
 
 InlineAssemblyConstant* ContextImpl::inline_assembly_cst(
     PointerType* type, const std::string& code) {
+  std::lock_guard< std::recursive_mutex > lock(this->_mutex);
   auto it = this->_inline_assembly_constants.find(std::make_pair(type, code));
   if (it == this->_inline_assembly_constants.end()) {
     auto cst = new InlineAssemblyConstant(type, code);
@@ -44,6 +44,7 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <tuple>
 #include <utility>
 #include <vector>
@@ -166,6 +167,9 @@ private:
                               std::unique_ptr< InlineAssemblyConstant > >
       _inline_assembly_constants;
 
+  // Mutex protecting the lazy creation of types and constants
+  std::recursive_mutex _mutex;
+
 public:
   /// \brief Default constructor
   ContextImpl();
@@ -0,0 +1,667 @@
+/**************************************************************************/ /**
+ *
+ * \file
+ * \brief Sparse bitset set
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2011-2018 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <initializer_list>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+#include <ikos/core/semantic/dumpable.hpp>
+#include <ikos/core/semantic/indexable.hpp>
+#include <ikos/core/support/assert.hpp>
+
+namespace ikos {
+namespace core {
+namespace bitset_set_impl {
+
+/// \brief Number of bits in a word
+constexpr Index WordBits = 64;
+
+/// \brief Return the offset of the word containing the given index
+inline Index word_offset(Index i) {
+  return i / WordBits;
+}
+
+/// \brief Return the mask of the given index within its word
+inline std::uint64_t word_mask(Index i) {
+  return static_cast< std::uint64_t >(1) << (i % WordBits);
+}
+
+/// \brief Return the number of bits set in the given word
+inline std::size_t popcount(std::uint64_t bits) {
+  return static_cast< std::size_t >(__builtin_popcountll(bits));
+}
+
+/// \brief Return the index of a key
+template < typename Key >
+inline Index index(const Key& key) {
+  return IndexableTraits< Key >::index(key);
+}
+
+/// \brief A non-zero word of a sparse bitset, with the corresponding keys
+///
+/// Words are immutable and shared between sets.
+template < typename Key >
+struct Word {
+  /// \brief Offset of the word, i.e the index of its first bit divided by 64
+  Index offset;
+
+  /// \brief Bits of the word
+  std::uint64_t bits;
+
+  /// \brief Keys of the word, sorted by index
+  std::vector< Key > keys;
+};
+
+template < typename Key >
+using WordPtr = std::shared_ptr< const Word< Key > >;
+
+/// \brief Content of a non-empty bitset set
+template < typename Key >
+struct Data {
+  /// \brief Words of the bitset, sorted by offset
+  std::vector< WordPtr< Key > > words;
+
+  /// \brief Number of elements
+  std::size_t size = 0;
+};
+
+template < typename Key >
+using DataPtr = std::shared_ptr< const Data< Key > >;
+
+/// \brief Return the position of the word with the given offset, or of the
+/// first word after it
+template < typename Key >
+inline typename std::vector< WordPtr< Key > >::const_iterator find_word(
+    const std::vector< WordPtr< Key > >& words, Index offset) {
+  return std::lower_bound(words.begin(),
+                          words.end(),
+                          offset,
+                          [](const WordPtr< Key >& w, Index o) {
+                            return w->offset < o;
+                          });
+}
+
+/// \brief Return the position of the key with the given index in the given
+/// word, or of the first key after it
+template < typename Key >
+inline typename std::vector< Key >::const_iterator find_key(
+    const std::vector< Key >& keys, Index i) {
+  return std::lower_bound(keys.begin(),
+                          keys.end(),
+                          i,
+                          [](const Key& k, Index j) { return index(k) < j; });
+}
+
+/// \brief Return the keys of `keys` whose bit is set in `bits`
+template < typename Key >
+inline std::vector< Key > select_keys(const std::vector< Key >& keys,
+                                      std::uint64_t bits) {
+  std::vector< Key > result;
+  result.reserve(popcount(bits));
+  for (const Key& key : keys) {
+    if ((bits & word_mask(index(key))) != 0) {
+      result.push_back(key);
+    }
+  }
+  return result;
+}
+
+/// \brief Return the union of two words with the same offset
+template < typename Key >
+inline WordPtr< Key > join(const WordPtr< Key >& s, const WordPtr< Key >& t) {
+  std::uint64_t bits = s->bits | t->bits;
+  if (bits == s->bits) {
+    return s;
+  } else if (bits == t->bits) {
+    return t;
+  }
+
+  std::vector< Key > keys;
+  keys.reserve(popcount(bits));
+  auto s_it = s->keys.begin(), s_et = s->keys.end();
+  auto t_it = t->keys.begin(), t_et = t->keys.end();
+  while (s_it != s_et && t_it != t_et) {
+    Index i = index(*s_it);
+    Index j = index(*t_it);
+    if (i < j) {
+      keys.push_back(*s_it++);
+    } else if (j < i) {
+      keys.push_back(*t_it++);
+    } else {
+      keys.push_back(*s_it++);
+      ++t_it;
+    }
+  }
+  keys.insert(keys.end(), s_it, s_et);
+  keys.insert(keys.end(), t_it, t_et);
+  return std::make_shared< const Word< Key > >(
+      Word< Key >{s->offset, bits, std::move(keys)});
+}
+
+/// \brief Return the word `s` restricted to the given bits
+///
+/// Returns nullptr if `bits` is zero.
+template < typename Key >
+inline WordPtr< Key > restrict(const WordPtr< Key >& s, std::uint64_t bits) {
+  if (bits == 0) {
+    return nullptr;
+  } else if (bits == s->bits) {
+    return s;
+  } else {
+    return std::make_shared< const Word< Key > >(
+        Word< Key >{s->offset, bits, select_keys(s->keys, bits)});
+  }
+}
+
+/// \brief Return true if `s` is a subset of `t`
+template < typename Key >
+inline bool is_subset_of(const Data< Key >& s, const Data< Key >& t) {
+  if (s.size > t.size) {
+    return false;
+  }
+  auto t_it = t.words.begin(), t_et = t.words.end();
+  for (const WordPtr< Key >& w : s.words) {
+    while (t_it != t_et && (*t_it)->offset < w->offset) {
+      ++t_it;
+    }
+    if (t_it == t_et || (*t_it)->offset != w->offset) {
+      return false;
+    }
+    if (*t_it != w && (w->bits & ~(*t_it)->bits) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// \brief Return true if `s` and `t` are equal
+template < typename Key >
+inline bool equals(const Data< Key >& s, const Data< Key >& t) {
+  if (s.size != t.size || s.words.size() != t.words.size()) {
+    return false;
+  }
+  for (auto s_it = s.words.begin(), t_it = t.words.begin(),
+            s_et = s.words.end();
+       s_it != s_et;
+       ++s_it, ++t_it) {
+    if (*s_it != *t_it && ((*s_it)->offset != (*t_it)->offset ||
+                           (*s_it)->bits != (*t_it)->bits)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// \brief Return the union of two sets
+template < typename Key >
+inline DataPtr< Key > join(const DataPtr< Key >& s, const DataPtr< Key >& t) {
+  if (s == t || t == nullptr) {
+    return s;
+  } else if (s == nullptr) {
+    return t;
+  }
+
+  auto r = std::make_shared< Data< Key > >();
+  r->words.reserve(s->words.size() + t->words.size());
+  bool is_s = true, is_t = true;
+  auto s_it = s->words.begin(), s_et = s->words.end();
+  auto t_it = t->words.begin(), t_et = t->words.end();
+  while (s_it != s_et || t_it != t_et) {
+    WordPtr< Key > w;
+    if (t_it == t_et || (s_it != s_et && (*s_it)->offset < (*t_it)->offset)) {
+      w = *s_it++;
+      is_t = false;
+    } else if (s_it == s_et || (*t_it)->offset < (*s_it)->offset) {
+      w = *t_it++;
+      is_s = false;
+    } else {
+      w = join(*s_it, *t_it);
+      is_s = is_s && w == *s_it;
+      is_t = is_t && w == *t_it;
+      ++s_it;
+      ++t_it;
+    }
+    r->size += w->keys.size();
+    r->words.push_back(std::move(w));
+  }
+
+  if (is_s) {
+    return s;
+  } else if (is_t) {
+    return t;
+  }
+  return r;
+}
+
+/// \brief Return the intersection (or the difference, if `Difference` is
+/// true) of two sets
+template < bool Difference, typename Key >
+inline DataPtr< Key > intersect_or_difference(const DataPtr< Key >& s,
+                                              const DataPtr< Key >& t) {
+  if (s == t) {
+    return Difference ? nullptr : s;
+  } else if (s == nullptr || t == nullptr) {
+    return Difference ? s : nullptr;
+  }
+
+  auto r = std::make_shared< Data< Key > >();
+  r->words.reserve(s->words.size());
+  bool is_s = true;
+  auto t_it = t->words.begin(), t_et = t->words.end();
+  for (const WordPtr< Key >& w : s->words) {
+    while (t_it != t_et && (*t_it)->offset < w->offset) {
+      ++t_it;
+    }
+    std::uint64_t t_bits =
+        (t_it != t_et && (*t_it)->offset == w->offset) ? (*t_it)->bits : 0;
+    WordPtr< Key > u =
+        restrict(w, Difference ? (w->bits & ~t_bits) : (w->bits & t_bits));
+    is_s = is_s && u == w;
+    if (u != nullptr) {
+      r->size += u->keys.size();
+      r->words.push_back(std::move(u));
+    }
+  }
+
+  if (is_s) {
+    return s;
+  } else if (r->words.empty()) {
+    return nullptr;
+  }
+  return r;
+}
+
+/// \brief Forward iterator over the elements of a bitset set
+template < typename Key >
+class BitsetSetIterator final {
+public:
+  // Required types for iterators
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = const Key&;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const Key*;
+  using reference = const Key&;
+
+private:
+  /// \brief Current word, or nullptr for the end iterator
+  const WordPtr< Key >* _word = nullptr;
+
+  /// \brief End of the words
+  const WordPtr< Key >* _word_end = nullptr;
+
+  /// \brief Position of the current key in the current word
+  std::size_t _pos = 0;
+
+public:
+  /// \brief Create an end iterator
+  BitsetSetIterator() = default;
+
+  /// \brief Create an iterator over the given non-empty words
+  BitsetSetIterator(const WordPtr< Key >* begin, const WordPtr< Key >* end)
+      : _word(begin), _word_end(end) {}
+
+  /// \brief Pre-increment the iterator
+  BitsetSetIterator& operator++() {
+    ikos_assert(this->_word != nullptr);
+    if (++this->_pos == (*this->_word)->keys.size()) {
+      this->_pos = 0;
+      if (++this->_word == this->_word_end) {
+        // We reached the end
+        this->_word = nullptr;
+      }
+    }
+    return *this;
+  }
+
+  /// \brief Post-increment the iterator
+  const BitsetSetIterator operator++(int) {
+    BitsetSetIterator r = *this;
+    ++(*this);
+    return r;
+  }
+
+  /// \brief Compare two iterators
+  bool operator==(const BitsetSetIterator& other) const {
+    return this->_word == other._word && this->_pos == other._pos;
+  }
+
+  /// \brief Compare two iterators
+  bool operator!=(const BitsetSetIterator& other) const {
+    return !this->operator==(other);
+  }
+
+  /// \brief Dereference the iterator
+  reference operator*() const { return (*this->_word)->keys[this->_pos]; }
+
+  /// \brief Dereference the iterator
+  pointer operator->() const { return &(*this->_word)->keys[this->_pos]; }
+
+}; // end class BitsetSetIterator
+
+} // end namespace bitset_set_impl
+
+/// \brief A set implemented as a sparse bitset
+///
+/// This is a drop-in replacement for PatriciaTreeSet. The set is a sorted array
+/// of the non-zero 64-bit words of a bitset indexed by IndexableTraits, so
+/// union, intersection, difference and inclusion are computed a word at a time.
+/// Each word also holds its elements, for iteration. Words are immutable and
+/// shared between sets, as well as the array itself, so copies are cheap.
+///
+/// This is efficient when keys have small and dense indexes.
+///
+/// Requirements:
+///
+/// Key must implement IndexableTraits
+/// Key must implement bool Key::operator==(const Key&) const
+template < typename Key >
+class BitsetSet final {
+public:
+  static_assert(IsIndexable< Key >::value,
+                "Key must implement IndexableTraits");
+
+private:
+  using Data = bitset_set_impl::Data< Key >;
+  using DataPtr = bitset_set_impl::DataPtr< Key >;
+  using Word = bitset_set_impl::Word< Key >;
+  using WordPtr = bitset_set_impl::WordPtr< Key >;
+
+public:
+  using Iterator = bitset_set_impl::BitsetSetIterator< Key >;
+
+private:
+  /// \brief Content of the set, or nullptr if the set is empty
+  DataPtr _data;
+
+private:
+  /// \brief Private constructor
+  explicit BitsetSet(DataPtr data) : _data(std::move(data)) {}
+
+public:
+  /// \brief Create an empty bitset set
+  BitsetSet() = default;
+
+  /// \brief Create a bitset set with the given elements
+  BitsetSet(std::initializer_list< Key > elements) {
+    for (const Key& e : elements) {
+      this->insert(e);
+    }
+  }
+
+  /// \brief Create a bitset set with the content of the range [first, last)
+  template < typename InputIterator >
+  BitsetSet(InputIterator first, InputIterator last) {
+    for (auto it = first; it != last; ++it) {
+      this->insert(*it);
+    }
+  }
+
+  /// \brief Copy constructor
+  BitsetSet(const BitsetSet&) noexcept = default;
+
+  /// \brief Move constructor
+  BitsetSet(BitsetSet&&) noexcept = default;
+
+  /// \brief Copy assignment operator
+  BitsetSet& operator=(const BitsetSet&) noexcept = default;
+
+  /// \brief Move assignment operator
+  BitsetSet& operator=(BitsetSet&&) noexcept = default;
+
+  /// \brief Destructor
+  ~BitsetSet() = default;
+
+  /// \brief Return true if the set is empty
+  bool empty() const { return this->_data == nullptr; }
+
+  /// \brief Return the number of elements in the set
+  std::size_t size() const {
+    return this->_data != nullptr ? this->_data->size : 0;
+  }
+
+  /// \brief Clear the content of the set
+  void clear() { this->_data.reset(); }
+
+  /// \brief Return true if the set contains the given key
+  bool contains(const Key& key) const {
+    if (this->_data == nullptr) {
+      return false;
+    }
+    Index i = bitset_set_impl::index(key);
+    Index offset = bitset_set_impl::word_offset(i);
+    auto it = bitset_set_impl::find_word(this->_data->words, offset);
+    return it != this->_data->words.end() && (*it)->offset == offset &&
+           ((*it)->bits & bitset_set_impl::word_mask(i)) != 0;
+  }
+
+  /// \brief Return true if the set is a subset of `other`
+  bool is_subset_of(const BitsetSet& other) const {
+    if (this->_data == other._data || this->_data == nullptr) {
+      return true;
+    } else if (other._data == nullptr) {
+      return false;
+    } else {
+      return bitset_set_impl::is_subset_of(*this->_data, *other._data);
+    }
+  }
+
+  /// \brief Return true if the sets are equal
+  bool equals(const BitsetSet& other) const {
+    if (this->_data == other._data) {
+      return true;
+    } else if (this->_data == nullptr || other._data == nullptr) {
+      return false;
+    } else {
+      return bitset_set_impl::equals(*this->_data, *other._data);
+    }
+  }
+
+  /// \brief Return true if the sets are equal
+  bool operator==(const BitsetSet& other) const { return this->equals(other); }
+
+  /// \brief Return the begin iterator over the elements of the set
+  Iterator begin() const {
+    if (this->_data == nullptr) {
+      return Iterator();
+    }
+    const WordPtr* words = this->_data->words.data();
+    return Iterator(words, words + this->_data->words.size());
+  }
+
+  /// \brief Return the end iterator over the elements of the set
+  Iterator end() const { return Iterator(); }
+
+  /// \brief Insert an element in the set
+  void insert(const Key& key) {
+    if (this->contains(key)) {
+      return;
+    }
+    Index i = bitset_set_impl::index(key);
+    Index offset = bitset_set_impl::word_offset(i);
+    std::uint64_t mask = bitset_set_impl::word_mask(i);
+    auto data = this->copy_data();
+    auto it = bitset_set_impl::find_word(data->words, offset);
+    if (it != data->words.end() && (*it)->offset == offset) {
+      std::vector< Key > keys = (*it)->keys;
+      keys.insert(bitset_set_impl::find_key(keys, i), key);
+      data->words[it - data->words.cbegin()] = std::make_shared< const Word >(
+          Word{offset, (*it)->bits | mask, std::move(keys)});
+    } else {
+      data->words.insert(it,
+                         std::make_shared< const Word >(
+                             Word{offset, mask, std::vector< Key >{key}}));
+    }
+    data->size++;
+    this->_data = std::move(data);
+  }
+
+  /// \brief Remove an element from the set
+  void erase(const Key& key) {
+    if (!this->contains(key)) {
+      return;
+    }
+    if (this->_data->size == 1) {
+      this->_data.reset();
+      return;
+    }
+    Index i = bitset_set_impl::index(key);
+    auto data = this->copy_data();
+    Index offset = bitset_set_impl::word_offset(i);
+    auto it = bitset_set_impl::find_word(data->words, offset);
+    WordPtr w = bitset_set_impl::restrict(*it,
+                                          (*it)->bits &
+                                              ~bitset_set_impl::word_mask(i));
+    if (w == nullptr) {
+      data->words.erase(it);
+    } else {
+      data->words[it - data->words.cbegin()] = std::move(w);
+    }
+    data->size--;
+    this->_data = std::move(data);
+  }
+
+  /// \brief Remove the elements for which predicate(e) returns false
+  template < typename Predicate >
+  void filter(const Predicate& pred) {
+    if (this->_data == nullptr) {
+      return;
+    }
+    auto data = std::make_shared< Data >();
+    for (const WordPtr& w : this->_data->words) {
+      std::uint64_t bits = w->bits;
+      for (const Key& key : w->keys) {
+        if (!pred(key)) {
+          bits &= ~bitset_set_impl::word_mask(bitset_set_impl::index(key));
+        }
+      }
+      WordPtr u = bitset_set_impl::restrict(w, bits);
+      if (u != nullptr) {
+        data->size += u->keys.size();
+        data->words.push_back(std::move(u));
+      }
+    }
+    if (data->size == 0) {
+      this->_data.reset();
+    } else if (data->size != this->_data->size) {
+      this->_data = std::move(data);
+    }
+  }
+
+  /// \brief Perform the union of two bitset sets
+  void join_with(const BitsetSet& other) {
+    this->_data = bitset_set_impl::join(this->_data, other._data);
+  }
+
+  /// \brief Perform the union of two bitset sets
+  BitsetSet join(const BitsetSet& other) const {
+    return BitsetSet(bitset_set_impl::join(this->_data, other._data));
+  }
+
+  /// \brief Perform the intersection of two bitset sets
+  void intersect_with(const BitsetSet& other) {
+    this->_data = bitset_set_impl::intersect_or_difference< false >(
+        this->_data, other._data);
+  }
+
+  /// \brief Perform the intersection of two bitset sets
+  BitsetSet intersect(const BitsetSet& other) const {
+    return BitsetSet(
+        bitset_set_impl::intersect_or_difference< false >(this->_data,
+                                                          other._data));
+  }
+
+  /// \brief Perform the difference of two bitset sets
+  void difference_with(const BitsetSet& other) {
+    this->_data = bitset_set_impl::intersect_or_difference< true >(
+        this->_data, other._data);
+  }
+
+  /// \brief Perform the difference of two bitset sets
+  BitsetSet difference(const BitsetSet& other) const {
+    return BitsetSet(
+        bitset_set_impl::intersect_or_difference< true >(this->_data,
+                                                         other._data));
+  }
+
+  /// \brief Dump the set, for debugging purpose
+  void dump(std::ostream& o) const {
+    static_assert(IsDumpable< Key >::value,
+                  "Key must implement DumpableTraits");
+    o << "{";
+    for (auto it = this->begin(), et = this->end(); it != et;) {
+      DumpableTraits< Key >::dump(o, *it);
+      ++it;
+      if (it != et) {
+        o << "; ";
+      }
+    }
+    o << "}";
+  }
+
+private:
+  /// \brief Return a modifiable copy of the data
+  std::shared_ptr< Data > copy_data() const {
+    if (this->_data == nullptr) {
+      return std::make_shared< Data >();
+    } else {
+      return std::make_shared< Data >(*this->_data);
+    }
+  }
+
+}; // end class BitsetSet
+
+/// \brief Write a bitset set on a stream
+template < typename Key >
+inline std::ostream& operator<<(std::ostream& o, const BitsetSet< Key >& set) {
+  set.dump(o);
+  return o;
+}
+
+} // end namespace core
+} // end namespace ikos
@@ -55,6 +55,7 @@
 #include <stack>
 
 #include <boost/optional.hpp>
+#include <boost/smart_ptr/intrusive_ptr.hpp>
 
 #include <ikos/core/adt/patricia_tree/utils.hpp>
 #include <ikos/core/semantic/dumpable.hpp>
@@ -72,78 +73,84 @@ using namespace patricia_tree_utils;
 template < typename Key, typename Value >
 class PatriciaTree;
 
+/// \brief Reference counted pointer on a patricia tree
+template < typename Key, typename Value >
+using PatriciaTreePtr =
+    boost::intrusive_ptr< const PatriciaTree< Key, Value > >;
+
 template < typename Key, typename Value >
 class PatriciaTreeIterator;
 
 template < typename Key, typename Value >
-inline bool empty(
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& tree);
+struct HashConsingTraits;
+
+template < typename Key, typename Value >
+inline bool empty(const PatriciaTreePtr< Key, Value >& tree);
 
 template < typename Key, typename Value >
-inline std::size_t size(
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& tree);
+inline std::size_t size(const PatriciaTreePtr< Key, Value >& tree);
 
 template < typename Key, typename Value >
 inline boost::optional< const Value& > find_value(
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& tree,
+    const PatriciaTreePtr< Key, Value >& tree,
     const Key& key);
 
 template < typename Key, typename Value, typename Compare >
-inline bool leq(const std::shared_ptr< const PatriciaTree< Key, Value > >& s,
-                const std::shared_ptr< const PatriciaTree< Key, Value > >& t,
+inline bool leq(const PatriciaTreePtr< Key, Value >& s,
+                const PatriciaTreePtr< Key, Value >& t,
                 const Compare& cmp);
 
 template < typename Key, typename Value, typename Compare >
-inline bool equals(const std::shared_ptr< const PatriciaTree< Key, Value > >& s,
-                   const std::shared_ptr< const PatriciaTree< Key, Value > >& t,
+inline bool equals(const PatriciaTreePtr< Key, Value >& s,
+                   const PatriciaTreePtr< Key, Value >& t,
                    const Compare& cmp);
 
 template < typename Key, typename Value >
-inline std::shared_ptr< const PatriciaTree< Key, Value > > insert_or_assign(
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& tree,
+inline PatriciaTreePtr< Key, Value > insert_or_assign(
+    const PatriciaTreePtr< Key, Value >& tree,
     const Key& key,
     const Value& value);
 
 template < typename Key, typename Value, typename CombiningFunction >
-inline std::shared_ptr< const PatriciaTree< Key, Value > > update_or_insert(
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& tree,
+inline PatriciaTreePtr< Key, Value > update_or_insert(
+    const PatriciaTreePtr< Key, Value >& tree,
     const CombiningFunction& combine,
     const Key& key,
     const Value& value);
 
 template < typename Key, typename Value, typename CombiningFunction >
-inline std::shared_ptr< const PatriciaTree< Key, Value > > update_or_ignore(
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& tree,
+inline PatriciaTreePtr< Key, Value > update_or_ignore(
+    const PatriciaTreePtr< Key, Value >& tree,
     const CombiningFunction& combine,
     const Key& key,
     const Value& value);
 
 template < typename Key, typename Value >
-inline std::shared_ptr< const PatriciaTree< Key, Value > > erase(
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& tree,
+inline PatriciaTreePtr< Key, Value > erase(
+    const PatriciaTreePtr< Key, Value >& tree,
     const Key& key);
 
 template < typename Key, typename Value, typename UnaryOp >
-inline std::shared_ptr< const PatriciaTree< Key, Value > > transform(
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& tree,
+inline PatriciaTreePtr< Key, Value > transform(
+    const PatriciaTreePtr< Key, Value >& tree,
     const UnaryOp& op);
 
 template < typename Key, typename Value, typename CombiningFunction >
-inline std::shared_ptr< const PatriciaTree< Key, Value > > join(
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& s,
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& t,
+inline PatriciaTreePtr< Key, Value > join(
+    const PatriciaTreePtr< Key, Value >& s,
+    const PatriciaTreePtr< Key, Value >& t,
     const CombiningFunction& combine);
 
 template < typename Key, typename Value, typename CombiningFunction >
-inline std::shared_ptr< const PatriciaTree< Key, Value > > intersect(
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& s,
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& t,
+inline PatriciaTreePtr< Key, Value > intersect(
+    const PatriciaTreePtr< Key, Value >& s,
+    const PatriciaTreePtr< Key, Value >& t,
     const CombiningFunction& combine);
 
 template < typename Key, typename Value, typename BinaryOp >
 inline typename BinaryOp::ResultType binary_operation(
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& s,
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& t,
+    const PatriciaTreePtr< Key, Value >& s,
+    const PatriciaTreePtr< Key, Value >& t,
     const BinaryOp& op);
 
 } // end namespace patricia_tree_map_impl
@@ -155,6 +162,12 @@ inline typename BinaryOp::ResultType binary_operation(
 /// Key must implement IndexableTraits
 /// Key must implement bool Key::operator==(const Key&) const
 /// Value must implement bool Value::operator==(const Value&) const
+///
+/// If IKOS_PATRICIA_TREE_HASH_CONSING is defined, trees are hash-consed:
+/// equal maps share the same tree, and equals() only compares the trees
+/// physically. Values should implement std::size_t hash_value(const Value&).
+/// Results of leq(), join() and intersect() with a stateless function are
+/// also memoized.
 template < typename Key, typename Value >
 class PatriciaTreeMap final {
 public:
@@ -168,11 +181,11 @@ public:
   using Iterator = patricia_tree_map_impl::PatriciaTreeIterator< Key, Value >;
 
 private:
-  std::shared_ptr< const PatriciaTree > _tree;
+  boost::intrusive_ptr< const PatriciaTree > _tree;
 
 private:
   /// \brief Private constructor
-  explicit PatriciaTreeMap(std::shared_ptr< const PatriciaTree > tree)
+  explicit PatriciaTreeMap(boost::intrusive_ptr< const PatriciaTree > tree)
       : _tree(std::move(tree)) {}
 
 public:
@@ -402,10 +415,8 @@ public:
   // Allow binary_operation to call the private constructor
   template < typename K, typename V, typename BinaryOp >
   friend typename BinaryOp::ResultType patricia_tree_map_impl::binary_operation(
-      const std::shared_ptr<
-          const patricia_tree_map_impl::PatriciaTree< K, V > >& s,
-      const std::shared_ptr<
-          const patricia_tree_map_impl::PatriciaTree< K, V > >& t,
+      const patricia_tree_map_impl::PatriciaTreePtr< K, V >& s,
+      const patricia_tree_map_impl::PatriciaTreePtr< K, V >& t,
       const BinaryOp& op);
 
 }; // end class PatriciaTreeMap
@@ -413,7 +424,7 @@ public:
 namespace patricia_tree_map_impl {
 
 template < typename Key, typename Value >
-class PatriciaTree {
+class PatriciaTree : public NodeBase< PatriciaTree< Key, Value > > {
 private:
   std::size_t _size;
 
@@ -441,31 +452,36 @@ class PatriciaTreeNode final : public PatriciaTree< Key, Value > {
 private:
   Index _prefix;
   Index _branching_bit;
-  std::shared_ptr< const PatriciaTree< Key, Value > > _left_tree;
-  std::shared_ptr< const PatriciaTree< Key, Value > > _right_tree;
+  PatriciaTreePtr< Key, Value > _left_tree;
+  PatriciaTreePtr< Key, Value > _right_tree;
 
 public:
   PatriciaTreeNode(
       Index prefix,
       Index branching_bit,
-      std::shared_ptr< const PatriciaTree< Key, Value > > left_tree,
-      std::shared_ptr< const PatriciaTree< Key, Value > > right_tree)
+      PatriciaTreePtr< Key, Value > left_tree,
+      PatriciaTreePtr< Key, Value > right_tree)
       : PatriciaTree< Key, Value >(left_tree->size() + right_tree->size()),
         _prefix(prefix),
         _branching_bit(branching_bit),
         _left_tree(std::move(left_tree)),
         _right_tree(std::move(right_tree)) {}
 
+  ~PatriciaTreeNode() override {
+    if (HashConsing) {
+      HashConsingTraits< Key, Value >::table().erase(this);
+    }
+  }
+
   Index prefix() const { return this->_prefix; }
 
   Index branching_bit() const { return this->_branching_bit; }
 
-  const std::shared_ptr< const PatriciaTree< Key, Value > >& left_tree() const {
+  const PatriciaTreePtr< Key, Value >& left_tree() const {
     return this->_left_tree;
   }
 
-  const std::shared_ptr< const PatriciaTree< Key, Value > >& right_tree()
-      const {
+  const PatriciaTreePtr< Key, Value >& right_tree() const {
     return this->_right_tree;
   }
 
@@ -480,6 +496,12 @@ public:
   PatriciaTreeLeaf(const Key& key, const Value& value)
       : PatriciaTree< Key, Value >(1), _pair(key, value) {}
 
+  ~PatriciaTreeLeaf() override {
+    if (HashConsing) {
+      HashConsingTraits< Key, Value >::table().erase(this);
+    }
+  }
+
   const Key& key() const { return this->_pair.first; }
 
   const Value& value() const { return this->_pair.second; }
@@ -488,15 +510,145 @@ public:
 
 }; // end class PatriciaTreeLeaf
 
+/// \brief Hash-consing traits of patricia trees
+///
+/// Children of hash-consed nodes are hash-consed, hence nodes are compared
+/// using the addresses of their children.
+template < typename Key, typename Value >
+struct HashConsingTraits {
+  using Tree = PatriciaTree< Key, Value >;
+  using Node = PatriciaTreeNode< Key, Value >;
+  using Leaf = PatriciaTreeLeaf< Key, Value >;
+  using Table = HashConsingTable< Tree, HashConsingTraits< Key, Value > >;
+
+  static Table& table() { return Table::get(); }
+
+  static std::size_t hash(const Tree& tree) {
+    std::size_t hash = 0;
+    if (tree.is_leaf()) {
+      const auto& leaf = static_cast< const Leaf& >(tree);
+      boost::hash_combine(hash, IndexableTraits< Key >::index(leaf.key()));
+      boost::hash_combine(hash, ValueHash< Value >::hash(leaf.value()));
+    } else {
+      const auto& node = static_cast< const Node& >(tree);
+      boost::hash_combine(hash, node.prefix());
+      boost::hash_combine(hash, node.branching_bit());
+      boost::hash_combine(hash, node.left_tree().get());
+      boost::hash_combine(hash, node.right_tree().get());
+    }
+    return hash;
+  }
+
+  static bool equals(const Tree& s, const Tree& t) {
+    if (s.is_leaf()) {
+      if (t.is_node()) {
+        return false;
+      }
+      const auto& s_leaf = static_cast< const Leaf& >(s);
+      const auto& t_leaf = static_cast< const Leaf& >(t);
+      return s_leaf.key() == t_leaf.key() && s_leaf.value() == t_leaf.value();
+    }
+    if (t.is_leaf()) {
+      return false;
+    }
+    const auto& s_node = static_cast< const Node& >(s);
+    const auto& t_node = static_cast< const Node& >(t);
+    return s_node.prefix() == t_node.prefix() &&
+           s_node.branching_bit() == t_node.branching_bit() &&
+           s_node.left_tree() == t_node.left_tree() &&
+           s_node.right_tree() == t_node.right_tree();
+  }
+};
+
+/// \brief Return the hash-consed tree equal to the given new tree
+template < typename Key, typename Value >
+inline PatriciaTreePtr< Key, Value > hash_cons(
+    PatriciaTreePtr< Key, Value > tree) {
+  if (HashConsing) {
+    return HashConsingTraits< Key, Value >::table().insert(std::move(tree));
+  } else {
+    return tree;
+  }
+}
+
+/// \brief Create a leaf
+template < typename Key, typename Value >
+inline PatriciaTreePtr< Key, Value > make_leaf(const Key& key,
+                                               const Value& value) {
+  return hash_cons< Key, Value >(
+      make_ptr< const PatriciaTreeLeaf< Key, Value > >(key, value));
+}
+
+/// \brief Create a node with two non-null children
 template < typename Key, typename Value >
-inline bool empty(
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& tree) {
+inline PatriciaTreePtr< Key, Value > make_branch(
+    Index prefix,
+    Index branching_bit,
+    const PatriciaTreePtr< Key, Value >& left_tree,
+    const PatriciaTreePtr< Key, Value >& right_tree) {
+  return hash_cons< Key, Value >(
+      make_ptr< const PatriciaTreeNode< Key, Value > >(prefix,
+                                                       branching_bit,
+                                                       left_tree,
+                                                       right_tree));
+}
+
+/// \brief Tags for the memoized binary operations
+struct LeqTag {};
+struct JoinTag {};
+struct IntersectTag {};
+
+/// \brief Return the memoization cache of the given operation
+///
+/// Caches are thread-local, so that they can be accessed without locking.
+template < typename Tag,
+           typename Function,
+           typename Key,
+           typename Value,
+           typename Result >
+inline MemoCache< PatriciaTreePtr< Key, Value >, Result >& memo_cache() {
+  static thread_local MemoCache< PatriciaTreePtr< Key, Value >, Result > cache;
+  return cache;
+}
+
+/// \brief Return `compute()`, the result of the binary operation `Tag` with
+/// the function `Function` on the nodes `s` and `t`
+///
+/// Results are only memoized when hash-consing is enabled and `Function` is
+/// stateless, since the result must only depend on `s` and `t`.
+template < typename Tag,
+           typename Function,
+           typename Key,
+           typename Value,
+           typename Compute >
+inline auto memoize(const PatriciaTreePtr< Key, Value >& s,
+                    const PatriciaTreePtr< Key, Value >& t,
+                    const Compute& compute) -> decltype(compute()) {
+  using Result = decltype(compute());
+
+  // Small trees are cheaper to recompute
+  constexpr std::size_t MinSize = 8;
+
+  if (HashConsing && std::is_empty< Function >::value &&
+      s->size() + t->size() >= MinSize) {
+    auto& cache = memo_cache< Tag, Function, Key, Value, Result >();
+    if (const Result* result = cache.find(s, t)) {
+      return *result;
+    }
+    Result result = compute();
+    cache.insert(s, t, result);
+    return result;
+  }
+  return compute();
+}
+
+template < typename Key, typename Value >
+inline bool empty(const PatriciaTreePtr< Key, Value >& tree) {
   return tree == nullptr;
 }
 
 template < typename Key, typename Value >
-inline std::size_t size(
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& tree) {
+inline std::size_t size(const PatriciaTreePtr< Key, Value >& tree) {
   if (tree != nullptr) {
     return tree->size();
   } else {
@@ -506,22 +658,21 @@ inline std::size_t size(
 
 /// \brief Return the leaf associated with the given key, or nullptr
 template < typename Key, typename Value >
-inline std::shared_ptr< const PatriciaTreeLeaf< Key, Value > > find_leaf(
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& tree,
+inline const PatriciaTreeLeaf< Key, Value >* find_leaf(
+    const PatriciaTreePtr< Key, Value >& tree,
     const Key& key) {
   if (tree == nullptr) {
     return nullptr;
   }
   if (tree->is_leaf()) {
     auto leaf =
-        std::static_pointer_cast< const PatriciaTreeLeaf< Key, Value > >(tree);
+        static_cast< const PatriciaTreeLeaf< Key, Value >* >(tree.get());
     if (leaf->key() != key) {
       return nullptr;
     }
     return leaf;
   }
-  auto node =
-      std::static_pointer_cast< const PatriciaTreeNode< Key, Value > >(tree);
+  auto node = static_cast< const PatriciaTreeNode< Key, Value >* >(tree.get());
   if (is_zero_bit(IndexableTraits< Key >::index(key), node->branching_bit())) {
     return find_leaf(node->left_tree(), key);
   } else {
@@ -531,7 +682,7 @@ inline std::shared_ptr< const PatriciaTreeLeaf< Key, Value > > find_leaf(
 
 template < typename Key, typename Value >
 inline boost::optional< const Value& > find_value(
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& tree,
+    const PatriciaTreePtr< Key, Value >& tree,
     const Key& key) {
   auto leaf = find_leaf(tree, key);
   if (leaf == nullptr) {
@@ -541,9 +692,37 @@ inline boost::optional< const Value& > find_value(
   }
 }
 
+/// \brief Lower or equal comparison of two non-null nodes
 template < typename Key, typename Value, typename Compare >
-inline bool leq(const std::shared_ptr< const PatriciaTree< Key, Value > >& s,
-                const std::shared_ptr< const PatriciaTree< Key, Value > >& t,
+inline bool leq_nodes(const PatriciaTreePtr< Key, Value >& s,
+                      const PatriciaTreePtr< Key, Value >& t,
+                      const Compare& cmp) {
+  auto s_node = static_cast< const PatriciaTreeNode< Key, Value >* >(s.get());
+  auto t_node = static_cast< const PatriciaTreeNode< Key, Value >* >(t.get());
+  if (s_node->size() < t_node->size()) {
+    return false;
+  }
+  Index m = s_node->branching_bit();
+  Index n = t_node->branching_bit();
+  Index p = s_node->prefix();
+  Index q = t_node->prefix();
+  if (m == n && p == q) {
+    return leq(s_node->left_tree(), t_node->left_tree(), cmp) &&
+           leq(s_node->right_tree(), t_node->right_tree(), cmp);
+  }
+  if (m < n && match_prefix(q, p, m)) {
+    if (is_zero_bit(q, m)) {
+      return leq(s_node->left_tree(), t, cmp);
+    } else {
+      return leq(s_node->right_tree(), t, cmp);
+    }
+  }
+  return false; // t contains bindings that are not in s
+}
+
+template < typename Key, typename Value, typename Compare >
+inline bool leq(const PatriciaTreePtr< Key, Value >& s,
+                const PatriciaTreePtr< Key, Value >& t,
                 const Compare& cmp) {
   if (s == t) {
     return true;
@@ -558,16 +737,13 @@ inline bool leq(const std::shared_ptr< const PatriciaTree< Key, Value > >& s,
     if (t->is_node()) {
       return false;
     }
-    auto s_leaf =
-        std::static_pointer_cast< const PatriciaTreeLeaf< Key, Value > >(s);
-    auto t_leaf =
-        std::static_pointer_cast< const PatriciaTreeLeaf< Key, Value > >(t);
+    auto s_leaf = static_cast< const PatriciaTreeLeaf< Key, Value >* >(s.get());
+    auto t_leaf = static_cast< const PatriciaTreeLeaf< Key, Value >* >(t.get());
     return s_leaf->key() == t_leaf->key() &&
            cmp(s_leaf->value(), t_leaf->value());
   }
   if (t->is_leaf()) {
-    auto t_leaf =
-        std::static_pointer_cast< const PatriciaTreeLeaf< Key, Value > >(t);
+    auto t_leaf = static_cast< const PatriciaTreeLeaf< Key, Value >* >(t.get());
     auto s_value = find_value(s, t_leaf->key());
     if (s_value) {
       return cmp(*s_value, t_leaf->value());
@@ -575,36 +751,18 @@ inline bool leq(const std::shared_ptr< const PatriciaTree< Key, Value > >& s,
       return false;
     }
   }
-  auto s_node =
-      std::static_pointer_cast< const PatriciaTreeNode< Key, Value > >(s);
-  auto t_node =
-      std::static_pointer_cast< const PatriciaTreeNode< Key, Value > >(t);
-  if (s_node->size() < t_node->size()) {
-    return false;
-  }
-  Index m = s_node->branching_bit();
-  Index n = t_node->branching_bit();
-  Index p = s_node->prefix();
-  Index q = t_node->prefix();
-  if (m == n && p == q) {
-    return leq(s_node->left_tree(), t_node->left_tree(), cmp) &&
-           leq(s_node->right_tree(), t_node->right_tree(), cmp);
-  }
-  if (m < n && match_prefix(q, p, m)) {
-    if (is_zero_bit(q, m)) {
-      return leq(s_node->left_tree(), t, cmp);
-    } else {
-      return leq(s_node->right_tree(), t, cmp);
-    }
-  }
-  return false; // t contains bindings that are not in s
+  return memoize< LeqTag, Compare >(s, t, [&] {
+    return leq_nodes(s, t, cmp);
+  });
 }
 
 template < typename Key, typename Value, typename Compare >
-inline bool equals(const std::shared_ptr< const PatriciaTree< Key, Value > >& s,
-                   const std::shared_ptr< const PatriciaTree< Key, Value > >& t,
+inline bool equals(const PatriciaTreePtr< Key, Value >& s,
+                   const PatriciaTreePtr< Key, Value >& t,
                    const Compare& cmp) {
   if (s == t) {
+    // With hash-consing, distinct nodes might still be equal according to
+    // `cmp`, thus only the physical equality is a shortcut
     return true;
   }
   if (s == nullptr || t == nullptr) {
@@ -614,20 +772,16 @@ inline bool equals(const std::shared_ptr< const PatriciaTree< Key, Value > >& s,
     if (t->is_node()) {
       return false;
     }
-    auto s_leaf =
-        std::static_pointer_cast< const PatriciaTreeLeaf< Key, Value > >(s);
-    auto t_leaf =
-        std::static_pointer_cast< const PatriciaTreeLeaf< Key, Value > >(t);
+    auto s_leaf = static_cast< const PatriciaTreeLeaf< Key, Value >* >(s.get());
+    auto t_leaf = static_cast< const PatriciaTreeLeaf< Key, Value >* >(t.get());
     return s_leaf->key() == t_leaf->key() &&
            cmp(s_leaf->value(), t_leaf->value());
   }
   if (t->is_leaf()) {
     return false;
   }
-  auto s_node =
-      std::static_pointer_cast< const PatriciaTreeNode< Key, Value > >(s);
-  auto t_node =
-      std::static_pointer_cast< const PatriciaTreeNode< Key, Value > >(t);
+  auto s_node = static_cast< const PatriciaTreeNode< Key, Value >* >(s.get());
+  auto t_node = static_cast< const PatriciaTreeNode< Key, Value >* >(t.get());
   return s_node->size() == t_node->size() &&
          s_node->prefix() == t_node->prefix() &&
          s_node->branching_bit() == t_node->branching_bit() &&
@@ -639,71 +793,63 @@ inline bool equals(const std::shared_ptr< const PatriciaTree< Key, Value > >& s,
 ///
 /// Prevent the creation of a node with only one child.
 template < typename Key, typename Value >
-inline std::shared_ptr< const PatriciaTree< Key, Value > > make_node(
+inline PatriciaTreePtr< Key, Value > make_node(
     Index prefix,
     Index branching_bit,
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& left_tree,
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& right_tree) {
+    const PatriciaTreePtr< Key, Value >& left_tree,
+    const PatriciaTreePtr< Key, Value >& right_tree) {
   if (left_tree == nullptr) {
     return right_tree;
   }
   if (right_tree == nullptr) {
     return left_tree;
   }
-  return std::make_shared< const PatriciaTreeNode< Key, Value > >(prefix,
-                                                                  branching_bit,
-                                                                  left_tree,
-                                                                  right_tree);
+  return make_branch(prefix, branching_bit, left_tree, right_tree);
 }
 
 /// \brief Join non-null patricia trees
 template < typename Key, typename Value >
-inline std::shared_ptr< const PatriciaTreeNode< Key, Value > > join_trees(
+inline PatriciaTreePtr< Key, Value > join_trees(
     Index prefix_s,
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& s,
+    const PatriciaTreePtr< Key, Value >& s,
     Index prefix_t,
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& t) {
+    const PatriciaTreePtr< Key, Value >& t) {
   ikos_assert(s != nullptr && t != nullptr);
 
   Index m = branching_bit(prefix_s, prefix_t);
 
   if (is_zero_bit(prefix_s, m)) {
-    return std::make_shared<
-        const PatriciaTreeNode< Key, Value > >(mask(prefix_s, m), m, s, t);
+    return make_branch(mask(prefix_s, m), m, s, t);
   } else {
-    return std::make_shared<
-        const PatriciaTreeNode< Key, Value > >(mask(prefix_s, m), m, t, s);
+    return make_branch(mask(prefix_s, m), m, t, s);
   }
 }
 
 template < typename Key, typename Value >
-inline std::shared_ptr< const PatriciaTree< Key, Value > > insert_or_assign(
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& tree,
+inline PatriciaTreePtr< Key, Value > insert_or_assign(
+    const PatriciaTreePtr< Key, Value >& tree,
     const Key& key,
     const Value& value) {
   if (tree == nullptr) {
-    return std::make_shared< const PatriciaTreeLeaf< Key, Value > >(key, value);
+    return make_leaf(key, value);
   }
   if (tree->is_leaf()) {
     auto leaf =
-        std::static_pointer_cast< const PatriciaTreeLeaf< Key, Value > >(tree);
+        static_cast< const PatriciaTreeLeaf< Key, Value >* >(tree.get());
     if (leaf->key() == key) {
       if (leaf->value() == value) {
         return tree;
       } else {
-        return std::make_shared< const PatriciaTreeLeaf< Key, Value > >(key,
-                                                                        value);
+        return make_leaf(key, value);
       }
     }
-    auto new_leaf =
-        std::make_shared< const PatriciaTreeLeaf< Key, Value > >(key, value);
+    auto new_leaf = make_leaf(key, value);
     return join_trees< Key, Value >(IndexableTraits< Key >::index(key),
                                     new_leaf,
                                     IndexableTraits< Key >::index(leaf->key()),
                                     leaf);
   }
-  auto node =
-      std::static_pointer_cast< const PatriciaTreeNode< Key, Value > >(tree);
+  auto node = static_cast< const PatriciaTreeNode< Key, Value >* >(tree.get());
   if (match_prefix(IndexableTraits< Key >::index(key),
                    node->prefix(),
                    node->branching_bit())) {
@@ -728,8 +874,7 @@ inline std::shared_ptr< const PatriciaTree< Key, Value > > insert_or_assign(
                        new_right_tree);
     }
   }
-  auto new_leaf =
-      std::make_shared< const PatriciaTreeLeaf< Key, Value > >(key, value);
+  auto new_leaf = make_leaf(key, value);
   return join_trees< Key, Value >(IndexableTraits< Key >::index(key),
                                   new_leaf,
                                   node->prefix(),
@@ -737,38 +882,35 @@ inline std::shared_ptr< const PatriciaTree< Key, Value > > insert_or_assign(
 }
 
 template < typename Key, typename Value, typename CombiningFunction >
-inline std::shared_ptr< const PatriciaTree< Key, Value > > update_or_insert(
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& tree,
+inline PatriciaTreePtr< Key, Value > update_or_insert(
+    const PatriciaTreePtr< Key, Value >& tree,
     const CombiningFunction& combine,
     const Key& key,
     const Value& value) {
   if (tree == nullptr) {
-    return std::make_shared< const PatriciaTreeLeaf< Key, Value > >(key, value);
+    return make_leaf(key, value);
   }
   if (tree->is_leaf()) {
     auto leaf =
-        std::static_pointer_cast< const PatriciaTreeLeaf< Key, Value > >(tree);
+        static_cast< const PatriciaTreeLeaf< Key, Value >* >(tree.get());
     if (leaf->key() == key) {
       boost::optional< Value > new_value = combine(leaf->value(), value);
       if (new_value) {
         if (leaf->value() == *new_value) {
           return tree;
         } else {
-          return std::make_shared<
-              const PatriciaTreeLeaf< Key, Value > >(key, *new_value);
+          return make_leaf(key, *new_value);
         }
       }
       return nullptr;
     }
-    auto new_leaf =
-        std::make_shared< const PatriciaTreeLeaf< Key, Value > >(key, value);
+    auto new_leaf = make_leaf(key, value);
     return join_trees< Key, Value >(IndexableTraits< Key >::index(key),
                                     new_leaf,
                                     IndexableTraits< Key >::index(leaf->key()),
                                     leaf);
   }
-  auto node =
-      std::static_pointer_cast< const PatriciaTreeNode< Key, Value > >(tree);
+  auto node = static_cast< const PatriciaTreeNode< Key, Value >* >(tree.get());
   if (match_prefix(IndexableTraits< Key >::index(key),
                    node->prefix(),
                    node->branching_bit())) {
@@ -795,8 +937,7 @@ inline std::shared_ptr< const PatriciaTree< Key, Value > > update_or_insert(
                        new_right_tree);
     }
   }
-  auto new_leaf =
-      std::make_shared< const PatriciaTreeLeaf< Key, Value > >(key, value);
+  auto new_leaf = make_leaf(key, value);
   return join_trees< Key, Value >(IndexableTraits< Key >::index(key),
                                   new_leaf,
                                   node->prefix(),
@@ -804,8 +945,8 @@ inline std::shared_ptr< const PatriciaTree< Key, Value > > update_or_insert(
 }
 
 template < typename Key, typename Value, typename CombiningFunction >
-inline std::shared_ptr< const PatriciaTree< Key, Value > > update_or_ignore(
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& tree,
+inline PatriciaTreePtr< Key, Value > update_or_ignore(
+    const PatriciaTreePtr< Key, Value >& tree,
     const CombiningFunction& combine,
     const Key& key,
     const Value& value) {
@@ -814,23 +955,21 @@ inline std::shared_ptr< const PatriciaTree< Key, Value > > update_or_ignore(
   }
   if (tree->is_leaf()) {
     auto leaf =
-        std::static_pointer_cast< const PatriciaTreeLeaf< Key, Value > >(tree);
+        static_cast< const PatriciaTreeLeaf< Key, Value >* >(tree.get());
     if (leaf->key() == key) {
       boost::optional< Value > new_value = combine(leaf->value(), value);
       if (new_value) {
         if (leaf->value() == *new_value) {
           return tree;
         } else {
-          return std::make_shared<
-              const PatriciaTreeLeaf< Key, Value > >(key, *new_value);
+          return make_leaf(key, *new_value);
         }
       }
       return nullptr;
     }
     return tree;
   }
-  auto node =
-      std::static_pointer_cast< const PatriciaTreeNode< Key, Value > >(tree);
+  auto node = static_cast< const PatriciaTreeNode< Key, Value >* >(tree.get());
   if (match_prefix(IndexableTraits< Key >::index(key),
                    node->prefix(),
                    node->branching_bit())) {
@@ -862,10 +1001,9 @@ inline std::shared_ptr< const PatriciaTree< Key, Value > > update_or_ignore(
 
 /// \brief Update or insert an existing leaf `t_leaf` in a tree `s`
 template < typename Key, typename Value, typename CombiningFunction >
-inline std::shared_ptr< const PatriciaTree< Key, Value > >
-update_or_insert_leaf(
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& s,
-    const std::shared_ptr< const PatriciaTreeLeaf< Key, Value > >& t_leaf,
+inline PatriciaTreePtr< Key, Value > update_or_insert_leaf(
+    const PatriciaTreePtr< Key, Value >& s,
+    const PatriciaTreeLeaf< Key, Value >* t_leaf,
     const CombiningFunction& combine) {
   if (s == t_leaf) {
     return s;
@@ -874,8 +1012,7 @@ update_or_insert_leaf(
     return t_leaf;
   }
   if (s->is_leaf()) {
-    auto s_leaf =
-        std::static_pointer_cast< const PatriciaTreeLeaf< Key, Value > >(s);
+    auto s_leaf = static_cast< const PatriciaTreeLeaf< Key, Value >* >(s.get());
     if (s_leaf->key() == t_leaf->key()) {
       boost::optional< Value > new_value =
           combine(s_leaf->value(), t_leaf->value());
@@ -885,8 +1022,7 @@ update_or_insert_leaf(
         } else if (t_leaf->value() == *new_value) {
           return t_leaf;
         } else {
-          return std::make_shared<
-              const PatriciaTreeLeaf< Key, Value > >(s_leaf->key(), *new_value);
+          return make_leaf(s_leaf->key(), *new_value);
         }
       }
       return nullptr;
@@ -898,8 +1034,7 @@ update_or_insert_leaf(
                                         t_leaf->key()),
                                     t_leaf);
   }
-  auto s_node =
-      std::static_pointer_cast< const PatriciaTreeNode< Key, Value > >(s);
+  auto s_node = static_cast< const PatriciaTreeNode< Key, Value >* >(s.get());
   if (match_prefix(IndexableTraits< Key >::index(t_leaf->key()),
                    s_node->prefix(),
                    s_node->branching_bit())) {
@@ -933,23 +1068,22 @@ update_or_insert_leaf(
 }
 
 template < typename Key, typename Value >
-inline std::shared_ptr< const PatriciaTree< Key, Value > > erase(
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& tree,
+inline PatriciaTreePtr< Key, Value > erase(
+    const PatriciaTreePtr< Key, Value >& tree,
     const Key& key) {
   if (tree == nullptr) {
     return nullptr;
   }
   if (tree->is_leaf()) {
     auto leaf =
-        std::static_pointer_cast< const PatriciaTreeLeaf< Key, Value > >(tree);
+        static_cast< const PatriciaTreeLeaf< Key, Value >* >(tree.get());
     if (leaf->key() == key) {
       return nullptr;
     } else {
       return tree;
     }
   }
-  auto node =
-      std::static_pointer_cast< const PatriciaTreeNode< Key, Value > >(tree);
+  auto node = static_cast< const PatriciaTreeNode< Key, Value >* >(tree.get());
   if (match_prefix(IndexableTraits< Key >::index(key),
                    node->prefix(),
                    node->branching_bit())) {
@@ -978,28 +1112,26 @@ inline std::shared_ptr< const PatriciaTree< Key, Value > > erase(
 }
 
 template < typename Key, typename Value, typename UnaryOp >
-inline std::shared_ptr< const PatriciaTree< Key, Value > > transform(
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& tree,
+inline PatriciaTreePtr< Key, Value > transform(
+    const PatriciaTreePtr< Key, Value >& tree,
     const UnaryOp& op) {
   if (tree == nullptr) {
     return nullptr;
   }
   if (tree->is_leaf()) {
     auto leaf =
-        std::static_pointer_cast< const PatriciaTreeLeaf< Key, Value > >(tree);
+        static_cast< const PatriciaTreeLeaf< Key, Value >* >(tree.get());
     boost::optional< Value > new_value = op(leaf->key(), leaf->value());
     if (new_value) {
       if (leaf->value() == *new_value) {
         return tree;
       } else {
-        return std::make_shared<
-            const PatriciaTreeLeaf< Key, Value > >(leaf->key(), *new_value);
+        return make_leaf(leaf->key(), *new_value);
       }
     }
     return nullptr;
   }
-  auto node =
-      std::static_pointer_cast< const PatriciaTreeNode< Key, Value > >(tree);
+  auto node = static_cast< const PatriciaTreeNode< Key, Value >* >(tree.get());
   auto new_left_tree = transform(node->left_tree(), op);
   auto new_right_tree = transform(node->right_tree(), op);
   if (node->left_tree() == new_left_tree &&
@@ -1013,40 +1145,14 @@ inline std::shared_ptr< const PatriciaTree< Key, Value > > transform(
   }
 }
 
+/// \brief Union of two non-null nodes
 template < typename Key, typename Value, typename CombiningFunction >
-inline std::shared_ptr< const PatriciaTree< Key, Value > > join(
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& s,
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& t,
+inline PatriciaTreePtr< Key, Value > join_nodes(
+    const PatriciaTreePtr< Key, Value >& s,
+    const PatriciaTreePtr< Key, Value >& t,
     const CombiningFunction& combine) {
-  if (s == t) {
-    return s;
-  }
-  if (s == nullptr) {
-    return t;
-  }
-  if (t == nullptr) {
-    return s;
-  }
-  if (s->is_leaf()) {
-    auto s_leaf =
-        std::static_pointer_cast< const PatriciaTreeLeaf< Key, Value > >(s);
-    return update_or_insert_leaf(t,
-                                 s_leaf,
-                                 [=](const Value& t_value,
-                                     const Value& s_value) {
-                                   // reverse the parameters
-                                   return combine(s_value, t_value);
-                                 });
-  }
-  if (t->is_leaf()) {
-    auto t_leaf =
-        std::static_pointer_cast< const PatriciaTreeLeaf< Key, Value > >(t);
-    return update_or_insert_leaf(s, t_leaf, combine);
-  }
-  auto s_node =
-      std::static_pointer_cast< const PatriciaTreeNode< Key, Value > >(s);
-  auto t_node =
-      std::static_pointer_cast< const PatriciaTreeNode< Key, Value > >(t);
+  auto s_node = static_cast< const PatriciaTreeNode< Key, Value >* >(s.get());
+  auto t_node = static_cast< const PatriciaTreeNode< Key, Value >* >(t.get());
   Index m = s_node->branching_bit();
   Index n = t_node->branching_bit();
   Index p = s_node->prefix();
@@ -1100,60 +1206,46 @@ inline std::shared_ptr< const PatriciaTree< Key, Value > > join(
 }
 
 template < typename Key, typename Value, typename CombiningFunction >
-inline std::shared_ptr< const PatriciaTree< Key, Value > > intersect(
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& s,
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& t,
+inline PatriciaTreePtr< Key, Value > join(
+    const PatriciaTreePtr< Key, Value >& s,
+    const PatriciaTreePtr< Key, Value >& t,
     const CombiningFunction& combine) {
   if (s == t) {
     return s;
   }
-  if (s == nullptr || t == nullptr) {
-    return nullptr;
+  if (s == nullptr) {
+    return t;
+  }
+  if (t == nullptr) {
+    return s;
   }
   if (s->is_leaf()) {
-    auto s_leaf =
-        std::static_pointer_cast< const PatriciaTreeLeaf< Key, Value > >(s);
-    auto t_leaf = find_leaf(t, s_leaf->key());
-    if (t_leaf) {
-      boost::optional< Value > new_value =
-          combine(s_leaf->value(), t_leaf->value());
-      if (new_value) {
-        if (s_leaf->value() == *new_value) {
-          return s_leaf;
-        } else if (t_leaf->value() == *new_value) {
-          return t_leaf;
-        } else {
-          return std::make_shared<
-              const PatriciaTreeLeaf< Key, Value > >(s_leaf->key(), *new_value);
-        }
-      }
-    }
-    return nullptr;
+    auto s_leaf = static_cast< const PatriciaTreeLeaf< Key, Value >* >(s.get());
+    return update_or_insert_leaf(t,
+                                 s_leaf,
+                                 [=](const Value& t_value,
+                                     const Value& s_value) {
+                                   // reverse the parameters
+                                   return combine(s_value, t_value);
+                                 });
   }
   if (t->is_leaf()) {
-    auto t_leaf =
-        std::static_pointer_cast< const PatriciaTreeLeaf< Key, Value > >(t);
-    auto s_leaf = find_leaf(s, t_leaf->key());
-    if (s_leaf) {
-      boost::optional< Value > new_value =
-          combine(s_leaf->value(), t_leaf->value());
-      if (new_value) {
-        if (s_leaf->value() == *new_value) {
-          return s_leaf;
-        } else if (t_leaf->value() == *new_value) {
-          return t_leaf;
-        } else {
-          return std::make_shared<
-              const PatriciaTreeLeaf< Key, Value > >(t_leaf->key(), *new_value);
-        }
-      }
-    }
-    return nullptr;
+    auto t_leaf = static_cast< const PatriciaTreeLeaf< Key, Value >* >(t.get());
+    return update_or_insert_leaf(s, t_leaf, combine);
   }
-  auto s_node =
-      std::static_pointer_cast< const PatriciaTreeNode< Key, Value > >(s);
-  auto t_node =
-      std::static_pointer_cast< const PatriciaTreeNode< Key, Value > >(t);
+  return memoize< JoinTag, CombiningFunction >(s, t, [&] {
+    return join_nodes(s, t, combine);
+  });
+}
+
+/// \brief Intersection of two non-null nodes
+template < typename Key, typename Value, typename CombiningFunction >
+inline PatriciaTreePtr< Key, Value > intersect_nodes(
+    const PatriciaTreePtr< Key, Value >& s,
+    const PatriciaTreePtr< Key, Value >& t,
+    const CombiningFunction& combine) {
+  auto s_node = static_cast< const PatriciaTreeNode< Key, Value >* >(s.get());
+  auto t_node = static_cast< const PatriciaTreeNode< Key, Value >* >(t.get());
   Index m = s_node->branching_bit();
   Index n = t_node->branching_bit();
   Index p = s_node->prefix();
@@ -1192,10 +1284,62 @@ inline std::shared_ptr< const PatriciaTree< Key, Value > > intersect(
   return nullptr;
 }
 
+template < typename Key, typename Value, typename CombiningFunction >
+inline PatriciaTreePtr< Key, Value > intersect(
+    const PatriciaTreePtr< Key, Value >& s,
+    const PatriciaTreePtr< Key, Value >& t,
+    const CombiningFunction& combine) {
+  if (s == t) {
+    return s;
+  }
+  if (s == nullptr || t == nullptr) {
+    return nullptr;
+  }
+  if (s->is_leaf()) {
+    auto s_leaf = static_cast< const PatriciaTreeLeaf< Key, Value >* >(s.get());
+    auto t_leaf = find_leaf(t, s_leaf->key());
+    if (t_leaf) {
+      boost::optional< Value > new_value =
+          combine(s_leaf->value(), t_leaf->value());
+      if (new_value) {
+        if (s_leaf->value() == *new_value) {
+          return s_leaf;
+        } else if (t_leaf->value() == *new_value) {
+          return t_leaf;
+        } else {
+          return make_leaf(s_leaf->key(), *new_value);
+        }
+      }
+    }
+    return nullptr;
+  }
+  if (t->is_leaf()) {
+    auto t_leaf = static_cast< const PatriciaTreeLeaf< Key, Value >* >(t.get());
+    auto s_leaf = find_leaf(s, t_leaf->key());
+    if (s_leaf) {
+      boost::optional< Value > new_value =
+          combine(s_leaf->value(), t_leaf->value());
+      if (new_value) {
+        if (s_leaf->value() == *new_value) {
+          return s_leaf;
+        } else if (t_leaf->value() == *new_value) {
+          return t_leaf;
+        } else {
+          return make_leaf(t_leaf->key(), *new_value);
+        }
+      }
+    }
+    return nullptr;
+  }
+  return memoize< IntersectTag, CombiningFunction >(s, t, [&] {
+    return intersect_nodes(s, t, combine);
+  });
+}
+
 template < typename Key, typename Value, typename BinaryOp >
 inline typename BinaryOp::ResultType binary_operation(
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& s,
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& t,
+    const PatriciaTreePtr< Key, Value >& s,
+    const PatriciaTreePtr< Key, Value >& t,
     const BinaryOp& op) {
   if (op.has_equals() && s == t) {
     return op.equals(PatriciaTreeMap< Key, Value >(s));
@@ -1207,23 +1351,19 @@ inline typename BinaryOp::ResultType binary_operation(
     return op.left(PatriciaTreeMap< Key, Value >(s));
   }
   if (s->is_leaf()) {
-    auto s_leaf =
-        std::static_pointer_cast< const PatriciaTreeLeaf< Key, Value > >(s);
+    auto s_leaf = static_cast< const PatriciaTreeLeaf< Key, Value >* >(s.get());
     return op.right_with_left_leaf(PatriciaTreeMap< Key, Value >(t),
                                    s_leaf->key(),
                                    s_leaf->value());
   }
   if (t->is_leaf()) {
-    auto t_leaf =
-        std::static_pointer_cast< const PatriciaTreeLeaf< Key, Value > >(t);
+    auto t_leaf = static_cast< const PatriciaTreeLeaf< Key, Value >* >(t.get());
     return op.left_with_right_leaf(PatriciaTreeMap< Key, Value >(s),
                                    t_leaf->key(),
                                    t_leaf->value());
   }
-  auto s_node =
-      std::static_pointer_cast< const PatriciaTreeNode< Key, Value > >(s);
-  auto t_node =
-      std::static_pointer_cast< const PatriciaTreeNode< Key, Value > >(t);
+  auto s_node = static_cast< const PatriciaTreeNode< Key, Value >* >(s.get());
+  auto t_node = static_cast< const PatriciaTreeNode< Key, Value >* >(t.get());
   Index m = s_node->branching_bit();
   Index n = t_node->branching_bit();
   Index p = s_node->prefix();
@@ -1276,16 +1416,16 @@ public:
   using reference = const std::pair< Key, Value >&;
 
 private:
-  std::shared_ptr< const PatriciaTreeLeaf< Key, Value > > _leaf;
-  std::stack< std::shared_ptr< const PatriciaTreeNode< Key, Value > > > _stack;
+  boost::intrusive_ptr< const PatriciaTreeLeaf< Key, Value > > _leaf;
+  std::stack< boost::intrusive_ptr< const PatriciaTreeNode< Key, Value > > >
+      _stack;
 
 public:
   /// \brief Create an end iterator
   PatriciaTreeIterator() = default;
 
   /// \brief Create an iterator on the given patricia tree
-  explicit PatriciaTreeIterator(
-      const std::shared_ptr< const PatriciaTree< Key, Value > >& tree) {
+  explicit PatriciaTreeIterator(const PatriciaTreePtr< Key, Value >& tree) {
     if (tree != nullptr) {
       this->look_for_next_leaf(tree);
     }
@@ -1336,19 +1476,16 @@ public:
 
 private:
   /// \brief Find the leftmost leaf, store all intermediate nodes
-  void look_for_next_leaf(
-      const std::shared_ptr< const PatriciaTree< Key, Value > >& tree) {
+  void look_for_next_leaf(const PatriciaTreePtr< Key, Value >& tree) {
     auto t = tree;
     ikos_assert(t != nullptr);
     while (t->is_node()) {
-      auto node =
-          std::static_pointer_cast< const PatriciaTreeNode< Key, Value > >(t);
+      auto node = static_cast< const PatriciaTreeNode< Key, Value >* >(t.get());
       this->_stack.push(node);
       t = node->left_tree();
       ikos_assert(t != nullptr); // a node always has two children
     }
-    this->_leaf =
-        std::static_pointer_cast< const PatriciaTreeLeaf< Key, Value > >(t);
+    this->_leaf = static_cast< const PatriciaTreeLeaf< Key, Value >* >(t.get());
   }
 
 }; // end class PatriciaTreeIterator
@@ -54,6 +54,8 @@
 #include <memory>
 #include <stack>
 
+#include <boost/smart_ptr/intrusive_ptr.hpp>
+
 #include <ikos/core/adt/patricia_tree/utils.hpp>
 #include <ikos/core/semantic/dumpable.hpp>
 #include <ikos/core/semantic/indexable.hpp>
@@ -70,55 +72,57 @@ using namespace patricia_tree_utils;
 template < typename Key >
 class PatriciaTree;
 
+/// \brief Reference counted pointer on a patricia tree
+template < typename Key >
+using PatriciaTreePtr = boost::intrusive_ptr< const PatriciaTree< Key > >;
+
 template < typename Key >
 class PatriciaTreeIterator;
 
 template < typename Key >
-inline bool empty(const std::shared_ptr< const PatriciaTree< Key > >& tree);
+inline bool empty(const PatriciaTreePtr< Key >& tree);
 
 template < typename Key >
-inline std::size_t size(
-    const std::shared_ptr< const PatriciaTree< Key > >& tree);
+inline std::size_t size(const PatriciaTreePtr< Key >& tree);
 
 template < typename Key >
-inline bool contains(const std::shared_ptr< const PatriciaTree< Key > >& tree,
-                     const Key& key);
+inline bool contains(const PatriciaTreePtr< Key >& tree, const Key& key);
 
 template < typename Key >
-inline bool is_subset_of(const std::shared_ptr< const PatriciaTree< Key > >& s,
-                         const std::shared_ptr< const PatriciaTree< Key > >& t);
+inline bool is_subset_of(const PatriciaTreePtr< Key >& s,
+                         const PatriciaTreePtr< Key >& t);
 
 template < typename Key >
-inline bool equals(const std::shared_ptr< const PatriciaTree< Key > >& s,
-                   const std::shared_ptr< const PatriciaTree< Key > >& t);
+inline bool equals(const PatriciaTreePtr< Key >& s,
+                   const PatriciaTreePtr< Key >& t);
 
 template < typename Key >
-inline std::shared_ptr< const PatriciaTree< Key > > insert(
-    const std::shared_ptr< const PatriciaTree< Key > >& tree, const Key& key);
+inline PatriciaTreePtr< Key > insert(
+    const PatriciaTreePtr< Key >& tree, const Key& key);
 
 template < typename Key >
-inline std::shared_ptr< const PatriciaTree< Key > > erase(
-    const std::shared_ptr< const PatriciaTree< Key > >& tree, const Key& key);
+inline PatriciaTreePtr< Key > erase(
+    const PatriciaTreePtr< Key >& tree, const Key& key);
 
 template < typename Key, typename Predicate >
-inline std::shared_ptr< const PatriciaTree< Key > > filter(
-    const std::shared_ptr< const PatriciaTree< Key > >& tree,
+inline PatriciaTreePtr< Key > filter(
+    const PatriciaTreePtr< Key >& tree,
     const Predicate& pred);
 
 template < typename Key >
-inline std::shared_ptr< const PatriciaTree< Key > > join(
-    const std::shared_ptr< const PatriciaTree< Key > >& s,
-    const std::shared_ptr< const PatriciaTree< Key > >& t);
+inline PatriciaTreePtr< Key > join(
+    const PatriciaTreePtr< Key >& s,
+    const PatriciaTreePtr< Key >& t);
 
 template < typename Key >
-inline std::shared_ptr< const PatriciaTree< Key > > intersect(
-    const std::shared_ptr< const PatriciaTree< Key > >& s,
-    const std::shared_ptr< const PatriciaTree< Key > >& t);
+inline PatriciaTreePtr< Key > intersect(
+    const PatriciaTreePtr< Key >& s,
+    const PatriciaTreePtr< Key >& t);
 
 template < typename Key >
-inline std::shared_ptr< const PatriciaTree< Key > > difference(
-    const std::shared_ptr< const PatriciaTree< Key > >& s,
-    const std::shared_ptr< const PatriciaTree< Key > >& t);
+inline PatriciaTreePtr< Key > difference(
+    const PatriciaTreePtr< Key >& s,
+    const PatriciaTreePtr< Key >& t);
 
 } // end namespace patricia_tree_set_impl
 
@@ -141,11 +145,11 @@ public:
   using Iterator = patricia_tree_set_impl::PatriciaTreeIterator< Key >;
 
 private:
-  std::shared_ptr< const PatriciaTree > _tree;
+  boost::intrusive_ptr< const PatriciaTree > _tree;
 
 private:
   /// \brief Private constructor
-  explicit PatriciaTreeSet(std::shared_ptr< const PatriciaTree > tree)
+  explicit PatriciaTreeSet(boost::intrusive_ptr< const PatriciaTree > tree)
       : _tree(std::move(tree)) {}
 
 public:
@@ -295,7 +299,7 @@ inline std::ostream& operator<<(std::ostream& o,
 namespace patricia_tree_set_impl {
 
 template < typename Key >
-class PatriciaTree {
+class PatriciaTree : public NodeBase< PatriciaTree< Key > > {
 private:
   std::size_t _size;
 
@@ -323,14 +327,14 @@ class PatriciaTreeNode final : public PatriciaTree< Key > {
 private:
   Index _prefix;
   Index _branching_bit;
-  std::shared_ptr< const PatriciaTree< Key > > _left_tree;
-  std::shared_ptr< const PatriciaTree< Key > > _right_tree;
+  PatriciaTreePtr< Key > _left_tree;
+  PatriciaTreePtr< Key > _right_tree;
 
 public:
   PatriciaTreeNode(Index prefix,
                    Index branching_bit,
-                   std::shared_ptr< const PatriciaTree< Key > > left_tree,
-                   std::shared_ptr< const PatriciaTree< Key > > right_tree)
+                   PatriciaTreePtr< Key > left_tree,
+                   PatriciaTreePtr< Key > right_tree)
       : PatriciaTree< Key >(left_tree->size() + right_tree->size()),
         _prefix(prefix),
         _branching_bit(branching_bit),
@@ -341,11 +345,11 @@ public:
 
   Index branching_bit() const { return this->_branching_bit; }
 
-  const std::shared_ptr< const PatriciaTree< Key > >& left_tree() const {
+  const PatriciaTreePtr< Key >& left_tree() const {
     return this->_left_tree;
   }
 
-  const std::shared_ptr< const PatriciaTree< Key > >& right_tree() const {
+  const PatriciaTreePtr< Key >& right_tree() const {
     return this->_right_tree;
   }
 
@@ -365,13 +369,12 @@ public:
 }; // end class PatriciaTreeLeaf
 
 template < typename Key >
-inline bool empty(const std::shared_ptr< const PatriciaTree< Key > >& tree) {
+inline bool empty(const PatriciaTreePtr< Key >& tree) {
   return tree == nullptr;
 }
 
 template < typename Key >
-inline std::size_t size(
-    const std::shared_ptr< const PatriciaTree< Key > >& tree) {
+inline std::size_t size(const PatriciaTreePtr< Key >& tree) {
   if (tree != nullptr) {
     return tree->size();
   } else {
@@ -380,16 +383,15 @@ inline std::size_t size(
 }
 
 template < typename Key >
-inline bool contains(const std::shared_ptr< const PatriciaTree< Key > >& tree,
-                     const Key& key) {
+inline bool contains(const PatriciaTreePtr< Key >& tree, const Key& key) {
   if (tree == nullptr) {
     return false;
   }
   if (tree->is_leaf()) {
-    auto leaf = std::static_pointer_cast< const PatriciaTreeLeaf< Key > >(tree);
+    auto leaf = static_cast< const PatriciaTreeLeaf< Key >* >(tree.get());
     return leaf->key() == key;
   }
-  auto node = std::static_pointer_cast< const PatriciaTreeNode< Key > >(tree);
+  auto node = static_cast< const PatriciaTreeNode< Key >* >(tree.get());
   if (is_zero_bit(IndexableTraits< Key >::index(key), node->branching_bit())) {
     return contains(node->left_tree(), key);
   } else {
@@ -399,8 +401,8 @@ inline bool contains(const std::shared_ptr< const PatriciaTree< Key > >& tree,
 
 template < typename Key >
 inline bool is_subset_of(
-    const std::shared_ptr< const PatriciaTree< Key > >& s,
-    const std::shared_ptr< const PatriciaTree< Key > >& t) {
+    const PatriciaTreePtr< Key >& s,
+    const PatriciaTreePtr< Key >& t) {
   if (s == t) {
     return true;
   }
@@ -411,14 +413,14 @@ inline bool is_subset_of(
     return false;
   }
   if (s->is_leaf()) {
-    auto s_leaf = std::static_pointer_cast< const PatriciaTreeLeaf< Key > >(s);
+    auto s_leaf = static_cast< const PatriciaTreeLeaf< Key >* >(s.get());
     return contains(t, s_leaf->key());
   }
   if (t->is_leaf()) {
     return false;
   }
-  auto s_node = std::static_pointer_cast< const PatriciaTreeNode< Key > >(s);
-  auto t_node = std::static_pointer_cast< const PatriciaTreeNode< Key > >(t);
+  auto s_node = static_cast< const PatriciaTreeNode< Key >* >(s.get());
+  auto t_node = static_cast< const PatriciaTreeNode< Key >* >(t.get());
   if (s_node->size() > t_node->size()) {
     return false;
   }
@@ -443,8 +445,8 @@ inline bool is_subset_of(
 }
 
 template < typename Key >
-inline bool equals(const std::shared_ptr< const PatriciaTree< Key > >& s,
-                   const std::shared_ptr< const PatriciaTree< Key > >& t) {
+inline bool equals(const PatriciaTreePtr< Key >& s,
+                   const PatriciaTreePtr< Key >& t) {
   if (s == t) {
     return true;
   }
@@ -455,15 +457,15 @@ inline bool equals(const std::shared_ptr< const PatriciaTree< Key > >& s,
     if (t->is_node()) {
       return false;
     }
-    auto s_leaf = std::static_pointer_cast< const PatriciaTreeLeaf< Key > >(s);
-    auto t_leaf = std::static_pointer_cast< const PatriciaTreeLeaf< Key > >(t);
+    auto s_leaf = static_cast< const PatriciaTreeLeaf< Key >* >(s.get());
+    auto t_leaf = static_cast< const PatriciaTreeLeaf< Key >* >(t.get());
     return s_leaf->key() == t_leaf->key();
   }
   if (t->is_leaf()) {
     return false;
   }
-  auto s_node = std::static_pointer_cast< const PatriciaTreeNode< Key > >(s);
-  auto t_node = std::static_pointer_cast< const PatriciaTreeNode< Key > >(t);
+  auto s_node = static_cast< const PatriciaTreeNode< Key >* >(s.get());
+  auto t_node = static_cast< const PatriciaTreeNode< Key >* >(t.get());
   return s_node->size() == t_node->size() &&
          s_node->prefix() == t_node->prefix() &&
          s_node->branching_bit() == t_node->branching_bit() &&
@@ -475,65 +477,65 @@ inline bool equals(const std::shared_ptr< const PatriciaTree< Key > >& s,
 ///
 /// Prevent the creation of a node with only one child.
 template < typename Key >
-inline std::shared_ptr< const PatriciaTree< Key > > make_node(
+inline PatriciaTreePtr< Key > make_node(
     Index prefix,
     Index branching_bit,
-    const std::shared_ptr< const PatriciaTree< Key > >& left_tree,
-    const std::shared_ptr< const PatriciaTree< Key > >& right_tree) {
+    const PatriciaTreePtr< Key >& left_tree,
+    const PatriciaTreePtr< Key >& right_tree) {
   if (left_tree == nullptr) {
     return right_tree;
   }
   if (right_tree == nullptr) {
     return left_tree;
   }
-  return std::make_shared< const PatriciaTreeNode< Key > >(prefix,
-                                                           branching_bit,
-                                                           left_tree,
-                                                           right_tree);
+  return make_ptr< const PatriciaTreeNode< Key > >(prefix,
+                                                   branching_bit,
+                                                   left_tree,
+                                                   right_tree);
 }
 
 /// \brief Join non-null patricia trees
 template < typename Key >
-inline std::shared_ptr< const PatriciaTreeNode< Key > > join_trees(
+inline boost::intrusive_ptr< const PatriciaTreeNode< Key > > join_trees(
     Index prefix_s,
-    const std::shared_ptr< const PatriciaTree< Key > >& s,
+    const PatriciaTreePtr< Key >& s,
     Index prefix_t,
-    const std::shared_ptr< const PatriciaTree< Key > >& t) {
+    const PatriciaTreePtr< Key >& t) {
   ikos_assert(s != nullptr && t != nullptr);
 
   Index m = branching_bit(prefix_s, prefix_t);
 
   if (is_zero_bit(prefix_s, m)) {
-    return std::make_shared< const PatriciaTreeNode< Key > >(mask(prefix_s, m),
-                                                             m,
-                                                             s,
-                                                             t);
+    return make_ptr< const PatriciaTreeNode< Key > >(mask(prefix_s, m),
+                                                     m,
+                                                     s,
+                                                     t);
   } else {
-    return std::make_shared< const PatriciaTreeNode< Key > >(mask(prefix_s, m),
-                                                             m,
-                                                             t,
-                                                             s);
+    return make_ptr< const PatriciaTreeNode< Key > >(mask(prefix_s, m),
+                                                     m,
+                                                     t,
+                                                     s);
   }
 }
 
 template < typename Key >
-inline std::shared_ptr< const PatriciaTree< Key > > insert(
-    const std::shared_ptr< const PatriciaTree< Key > >& tree, const Key& key) {
+inline PatriciaTreePtr< Key > insert(
+    const PatriciaTreePtr< Key >& tree, const Key& key) {
   if (tree == nullptr) {
-    return std::make_shared< const PatriciaTreeLeaf< Key > >(key);
+    return make_ptr< const PatriciaTreeLeaf< Key > >(key);
   }
   if (tree->is_leaf()) {
-    auto leaf = std::static_pointer_cast< const PatriciaTreeLeaf< Key > >(tree);
+    auto leaf = static_cast< const PatriciaTreeLeaf< Key >* >(tree.get());
     if (leaf->key() == key) {
       return tree;
     }
-    auto new_leaf = std::make_shared< const PatriciaTreeLeaf< Key > >(key);
+    auto new_leaf = make_ptr< const PatriciaTreeLeaf< Key > >(key);
     return join_trees< Key >(IndexableTraits< Key >::index(key),
                              new_leaf,
                              IndexableTraits< Key >::index(leaf->key()),
                              leaf);
   }
-  auto node = std::static_pointer_cast< const PatriciaTreeNode< Key > >(tree);
+  auto node = static_cast< const PatriciaTreeNode< Key >* >(tree.get());
   if (match_prefix(IndexableTraits< Key >::index(key),
                    node->prefix(),
                    node->branching_bit())) {
@@ -558,7 +560,7 @@ inline std::shared_ptr< const PatriciaTree< Key > > insert(
                        new_right_tree);
     }
   }
-  auto new_leaf = std::make_shared< const PatriciaTreeLeaf< Key > >(key);
+  auto new_leaf = make_ptr< const PatriciaTreeLeaf< Key > >(key);
   return join_trees< Key >(IndexableTraits< Key >::index(key),
                            new_leaf,
                            node->prefix(),
@@ -567,9 +569,9 @@ inline std::shared_ptr< const PatriciaTree< Key > > insert(
 
 /// \brief Insert the leaf `t_leaf` into the patricia tree `s`
 template < typename Key >
-inline std::shared_ptr< const PatriciaTree< Key > > insert_leaf(
-    const std::shared_ptr< const PatriciaTree< Key > >& s,
-    const std::shared_ptr< const PatriciaTreeLeaf< Key > >& t_leaf) {
+inline PatriciaTreePtr< Key > insert_leaf(
+    const PatriciaTreePtr< Key >& s,
+    const PatriciaTreeLeaf< Key >* t_leaf) {
   if (s == t_leaf) {
     return s;
   }
@@ -577,7 +579,7 @@ inline std::shared_ptr< const PatriciaTree< Key > > insert_leaf(
     return t_leaf;
   }
   if (s->is_leaf()) {
-    auto s_leaf = std::static_pointer_cast< const PatriciaTreeLeaf< Key > >(s);
+    auto s_leaf = static_cast< const PatriciaTreeLeaf< Key >* >(s.get());
     if (s_leaf->key() == t_leaf->key()) {
       return s_leaf;
     }
@@ -586,7 +588,7 @@ inline std::shared_ptr< const PatriciaTree< Key > > insert_leaf(
                              IndexableTraits< Key >::index(t_leaf->key()),
                              t_leaf);
   }
-  auto s_node = std::static_pointer_cast< const PatriciaTreeNode< Key > >(s);
+  auto s_node = static_cast< const PatriciaTreeNode< Key >* >(s.get());
   if (match_prefix(IndexableTraits< Key >::index(t_leaf->key()),
                    s_node->prefix(),
                    s_node->branching_bit())) {
@@ -618,20 +620,20 @@ inline std::shared_ptr< const PatriciaTree< Key > > insert_leaf(
 }
 
 template < typename Key >
-inline std::shared_ptr< const PatriciaTree< Key > > erase(
-    const std::shared_ptr< const PatriciaTree< Key > >& tree, const Key& key) {
+inline PatriciaTreePtr< Key > erase(
+    const PatriciaTreePtr< Key >& tree, const Key& key) {
   if (tree == nullptr) {
     return nullptr;
   }
   if (tree->is_leaf()) {
-    auto leaf = std::static_pointer_cast< const PatriciaTreeLeaf< Key > >(tree);
+    auto leaf = static_cast< const PatriciaTreeLeaf< Key >* >(tree.get());
     if (leaf->key() == key) {
       return nullptr;
     } else {
       return tree;
     }
   }
-  auto node = std::static_pointer_cast< const PatriciaTreeNode< Key > >(tree);
+  auto node = static_cast< const PatriciaTreeNode< Key >* >(tree.get());
   if (match_prefix(IndexableTraits< Key >::index(key),
                    node->prefix(),
                    node->branching_bit())) {
@@ -660,21 +662,21 @@ inline std::shared_ptr< const PatriciaTree< Key > > erase(
 }
 
 template < typename Key, typename Predicate >
-inline std::shared_ptr< const PatriciaTree< Key > > filter(
-    const std::shared_ptr< const PatriciaTree< Key > >& tree,
+inline PatriciaTreePtr< Key > filter(
+    const PatriciaTreePtr< Key >& tree,
     const Predicate& pred) {
   if (tree == nullptr) {
     return nullptr;
   }
   if (tree->is_leaf()) {
-    auto leaf = std::static_pointer_cast< const PatriciaTreeLeaf< Key > >(tree);
+    auto leaf = static_cast< const PatriciaTreeLeaf< Key >* >(tree.get());
     if (pred(leaf->key())) {
       return tree;
     } else {
       return nullptr;
     }
   }
-  auto node = std::static_pointer_cast< const PatriciaTreeNode< Key > >(tree);
+  auto node = static_cast< const PatriciaTreeNode< Key >* >(tree.get());
   auto new_left_tree = filter(node->left_tree(), pred);
   auto new_right_tree = filter(node->right_tree(), pred);
   if (new_left_tree == node->left_tree() &&
@@ -689,9 +691,9 @@ inline std::shared_ptr< const PatriciaTree< Key > > filter(
 }
 
 template < typename Key >
-inline std::shared_ptr< const PatriciaTree< Key > > join(
-    const std::shared_ptr< const PatriciaTree< Key > >& s,
-    const std::shared_ptr< const PatriciaTree< Key > >& t) {
+inline PatriciaTreePtr< Key > join(
+    const PatriciaTreePtr< Key >& s,
+    const PatriciaTreePtr< Key >& t) {
   if (s == t) {
     return s;
   }
@@ -702,15 +704,15 @@ inline std::shared_ptr< const PatriciaTree< Key > > join(
     return s;
   }
   if (s->is_leaf()) {
-    auto s_leaf = std::static_pointer_cast< const PatriciaTreeLeaf< Key > >(s);
+    auto s_leaf = static_cast< const PatriciaTreeLeaf< Key >* >(s.get());
     return insert_leaf(t, s_leaf);
   }
   if (t->is_leaf()) {
-    auto t_leaf = std::static_pointer_cast< const PatriciaTreeLeaf< Key > >(t);
+    auto t_leaf = static_cast< const PatriciaTreeLeaf< Key >* >(t.get());
     return insert_leaf(s, t_leaf);
   }
-  auto s_node = std::static_pointer_cast< const PatriciaTreeNode< Key > >(s);
-  auto t_node = std::static_pointer_cast< const PatriciaTreeNode< Key > >(t);
+  auto s_node = static_cast< const PatriciaTreeNode< Key >* >(s.get());
+  auto t_node = static_cast< const PatriciaTreeNode< Key >* >(t.get());
   Index m = s_node->branching_bit();
   Index n = t_node->branching_bit();
   Index p = s_node->prefix();
@@ -764,9 +766,9 @@ inline std::shared_ptr< const PatriciaTree< Key > > join(
 }
 
 template < typename Key >
-inline std::shared_ptr< const PatriciaTree< Key > > intersect(
-    const std::shared_ptr< const PatriciaTree< Key > >& s,
-    const std::shared_ptr< const PatriciaTree< Key > >& t) {
+inline PatriciaTreePtr< Key > intersect(
+    const PatriciaTreePtr< Key >& s,
+    const PatriciaTreePtr< Key >& t) {
   if (s == t) {
     return s;
   }
@@ -774,7 +776,7 @@ inline std::shared_ptr< const PatriciaTree< Key > > intersect(
     return nullptr;
   }
   if (s->is_leaf()) {
-    auto s_leaf = std::static_pointer_cast< const PatriciaTreeLeaf< Key > >(s);
+    auto s_leaf = static_cast< const PatriciaTreeLeaf< Key >* >(s.get());
     if (contains(t, s_leaf->key())) {
       return s;
     } else {
@@ -782,15 +784,15 @@ inline std::shared_ptr< const PatriciaTree< Key > > intersect(
     }
   }
   if (t->is_leaf()) {
-    auto t_leaf = std::static_pointer_cast< const PatriciaTreeLeaf< Key > >(t);
+    auto t_leaf = static_cast< const PatriciaTreeLeaf< Key >* >(t.get());
     if (contains(s, t_leaf->key())) {
       return t;
     } else {
       return nullptr;
     }
   }
-  auto s_node = std::static_pointer_cast< const PatriciaTreeNode< Key > >(s);
-  auto t_node = std::static_pointer_cast< const PatriciaTreeNode< Key > >(t);
+  auto s_node = static_cast< const PatriciaTreeNode< Key >* >(s.get());
+  auto t_node = static_cast< const PatriciaTreeNode< Key >* >(t.get());
   Index m = s_node->branching_bit();
   Index n = t_node->branching_bit();
   Index p = s_node->prefix();
@@ -828,9 +830,9 @@ inline std::shared_ptr< const PatriciaTree< Key > > intersect(
 }
 
 template < typename Key >
-inline std::shared_ptr< const PatriciaTree< Key > > difference(
-    const std::shared_ptr< const PatriciaTree< Key > >& s,
-    const std::shared_ptr< const PatriciaTree< Key > >& t) {
+inline PatriciaTreePtr< Key > difference(
+    const PatriciaTreePtr< Key >& s,
+    const PatriciaTreePtr< Key >& t) {
   if (s == t) {
     return nullptr;
   }
@@ -841,7 +843,7 @@ inline std::shared_ptr< const PatriciaTree< Key > > difference(
     return s;
   }
   if (s->is_leaf()) {
-    auto s_leaf = std::static_pointer_cast< const PatriciaTreeLeaf< Key > >(s);
+    auto s_leaf = static_cast< const PatriciaTreeLeaf< Key >* >(s.get());
     if (contains(t, s_leaf->key())) {
       return nullptr;
     } else {
@@ -849,11 +851,11 @@ inline std::shared_ptr< const PatriciaTree< Key > > difference(
     }
   }
   if (t->is_leaf()) {
-    auto t_leaf = std::static_pointer_cast< const PatriciaTreeLeaf< Key > >(t);
+    auto t_leaf = static_cast< const PatriciaTreeLeaf< Key >* >(t.get());
     return erase(s, t_leaf->key());
   }
-  auto s_node = std::static_pointer_cast< const PatriciaTreeNode< Key > >(s);
-  auto t_node = std::static_pointer_cast< const PatriciaTreeNode< Key > >(t);
+  auto s_node = static_cast< const PatriciaTreeNode< Key >* >(s.get());
+  auto t_node = static_cast< const PatriciaTreeNode< Key >* >(t.get());
   Index m = s_node->branching_bit();
   Index n = t_node->branching_bit();
   Index p = s_node->prefix();
@@ -909,16 +911,15 @@ public:
   using reference = const Key&;
 
 private:
-  std::shared_ptr< const PatriciaTreeLeaf< Key > > _leaf;
-  std::stack< std::shared_ptr< const PatriciaTreeNode< Key > > > _stack;
+  boost::intrusive_ptr< const PatriciaTreeLeaf< Key > > _leaf;
+  std::stack< boost::intrusive_ptr< const PatriciaTreeNode< Key > > > _stack;
 
 public:
   /// \brief Create an end iterator
   PatriciaTreeIterator() = default;
 
   /// \brief Create an iterator on the given patricia tree
-  explicit PatriciaTreeIterator(
-      const std::shared_ptr< const PatriciaTree< Key > >& tree) {
+  explicit PatriciaTreeIterator(const PatriciaTreePtr< Key >& tree) {
     if (tree != nullptr) {
       this->look_for_next_leaf(tree);
     }
@@ -969,17 +970,16 @@ public:
 
 private:
   /// \brief Find the leftmost leaf, store all intermediate nodes
-  void look_for_next_leaf(
-      const std::shared_ptr< const PatriciaTree< Key > >& tree) {
+  void look_for_next_leaf(const PatriciaTreePtr< Key >& tree) {
     auto t = tree;
     ikos_assert(t != nullptr);
     while (t->is_node()) {
-      auto node = std::static_pointer_cast< const PatriciaTreeNode< Key > >(t);
+      auto node = static_cast< const PatriciaTreeNode< Key >* >(t.get());
       this->_stack.push(node);
       t = node->left_tree();
       ikos_assert(t != nullptr); // a node always has two children
     }
-    this->_leaf = std::static_pointer_cast< const PatriciaTreeLeaf< Key > >(t);
+    this->_leaf = static_cast< const PatriciaTreeLeaf< Key >* >(t.get());
   }
 
 }; // end class PatriciaTreeIterator
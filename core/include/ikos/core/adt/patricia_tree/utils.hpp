@@ -45,7 +45,28 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <boost/functional/hash.hpp>
+#include <boost/smart_ptr/intrusive_ptr.hpp>
+
+#if defined(__has_include)
+#if __has_include(<sys/single_threaded.h>)
+#include <sys/single_threaded.h>
+#define IKOS_HAS_LIBC_SINGLE_THREADED
+#endif
+#endif
+
 #include <ikos/core/semantic/indexable.hpp>
+#include <ikos/core/support/mpl.hpp>
 
 namespace ikos {
 namespace core {
@@ -76,6 +97,521 @@ inline Index branching_bit(Index prefix0, Index prefix1) {
   return lowest_bit(prefix0 ^ prefix1);
 }
 
+/// \brief Return true if the process is known to be single-threaded
+inline bool is_single_threaded() {
+#ifdef IKOS_HAS_LIBC_SINGLE_THREADED
+  return __libc_single_threaded != 0;
+#else
+  return false;
+#endif
+}
+
+/// \brief Atomic reference counter policy
+///
+/// Similar to std::shared_ptr in libstdc++, atomic operations are skipped as
+/// long as the process is single-threaded.
+struct AtomicCounter {
+  using type = std::atomic< unsigned >;
+
+  static unsigned load(const type& counter) noexcept {
+    return counter.load(std::memory_order_relaxed);
+  }
+
+  static void increment(type& counter) noexcept {
+    if (is_single_threaded()) {
+      counter.store(counter.load(std::memory_order_relaxed) + 1,
+                    std::memory_order_relaxed);
+    } else {
+      counter.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  /// \brief Increment the counter, unless it is zero
+  ///
+  /// Return false if the counter is zero.
+  static bool try_increment(type& counter) noexcept {
+    unsigned n = counter.load(std::memory_order_relaxed);
+    do {
+      if (n == 0) {
+        return false;
+      }
+    } while (!counter.compare_exchange_weak(n,
+                                            n + 1,
+                                            std::memory_order_relaxed));
+    return true;
+  }
+
+  static unsigned decrement(type& counter) noexcept {
+    if (is_single_threaded()) {
+      unsigned n = counter.load(std::memory_order_relaxed) - 1;
+      counter.store(n, std::memory_order_relaxed);
+      return n;
+    } else {
+      return counter.fetch_sub(1, std::memory_order_acq_rel) - 1;
+    }
+  }
+};
+
+/// \brief Non-atomic reference counter policy
+struct NonAtomicCounter {
+  using type = unsigned;
+
+  static unsigned load(const type& counter) noexcept { return counter; }
+
+  static void increment(type& counter) noexcept { ++counter; }
+
+  static bool try_increment(type& counter) noexcept {
+    if (counter == 0) {
+      return false;
+    }
+    ++counter;
+    return true;
+  }
+
+  static unsigned decrement(type& counter) noexcept { return --counter; }
+};
+
+/// \brief Reference counter policy of patricia tree nodes
+///
+/// Define IKOS_PATRICIA_TREE_NON_ATOMIC_REFCOUNT to use non-atomic reference
+/// counters. This is only safe if patricia trees are never shared between
+/// threads.
+#ifdef IKOS_PATRICIA_TREE_NON_ATOMIC_REFCOUNT
+using RefCounterPolicy = NonAtomicCounter;
+#else
+using RefCounterPolicy = AtomicCounter;
+#endif
+
+/// \brief Size-class pool allocator for patricia tree nodes
+///
+/// Blocks are grouped in size classes of 16 bytes, up to 256 bytes. Freed
+/// blocks are kept in thread-local free lists, and memory is never returned
+/// to the system.
+///
+/// When a thread exits, its free lists and the rest of its current chunk are
+/// moved to a global pool, where other threads pick them up.
+class NodeAllocator {
+private:
+  /// \brief Size of a size class
+  static constexpr std::size_t ClassSize = 16;
+
+  /// \brief Number of size classes
+  static constexpr std::size_t NumClasses = 16;
+
+  /// \brief Size of a chunk of memory
+  static constexpr std::size_t ChunkSize = 64 * 1024;
+
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+
+  /// \brief Memory released by exited threads
+  struct SharedPool {
+    std::mutex mutex;
+
+    /// \brief All chunks, so that they remain reachable
+    std::vector< void* > chunks;
+
+    /// \brief Partially used chunks, with room for a block of any size
+    std::vector< std::pair< char*, char* > > partial_chunks;
+
+    /// \brief Free lists, for each size class
+    std::vector< FreeBlock* > free_lists[NumClasses];
+
+    /// \brief Number of free lists, to avoid taking the lock when empty
+    std::atomic< std::size_t > num_free_lists{0};
+  };
+
+  /// \brief Return the global pool
+  ///
+  /// The pool is never destroyed, since threads might exit during the
+  /// destruction of static objects.
+  static SharedPool& shared_pool() {
+    static auto p = new SharedPool();
+    return *p;
+  }
+
+  struct Pool {
+    FreeBlock* free_lists[NumClasses] = {};
+    char* chunk_begin = nullptr;
+    char* chunk_end = nullptr;
+
+    Pool() = default;
+
+    Pool(const Pool&) = delete;
+    Pool& operator=(const Pool&) = delete;
+
+    /// \brief Move the free lists and the current chunk to the global pool
+    ~Pool() {
+      SharedPool& shared = shared_pool();
+      std::lock_guard< std::mutex > lock(shared.mutex);
+      for (std::size_t c = 0; c < NumClasses; c++) {
+        if (this->free_lists[c] != nullptr) {
+          shared.free_lists[c].push_back(this->free_lists[c]);
+          shared.num_free_lists++;
+          this->free_lists[c] = nullptr;
+        }
+      }
+      if (static_cast< std::size_t >(this->chunk_end - this->chunk_begin) >=
+          ClassSize * NumClasses) {
+        shared.partial_chunks.emplace_back(this->chunk_begin, this->chunk_end);
+      }
+      this->chunk_begin = nullptr;
+      this->chunk_end = nullptr;
+    }
+  };
+
+  /// \brief Return the pool of the current thread
+  static Pool& pool() {
+    static thread_local Pool p;
+    return p;
+  }
+
+  /// \brief Take a free list of the given size class from the global pool
+  ///
+  /// Return nullptr if there is none.
+  static FreeBlock* acquire_free_list(std::size_t c) {
+    SharedPool& shared = shared_pool();
+    if (shared.num_free_lists.load(std::memory_order_relaxed) == 0) {
+      return nullptr;
+    }
+
+    std::lock_guard< std::mutex > lock(shared.mutex);
+    if (shared.free_lists[c].empty()) {
+      return nullptr;
+    }
+    FreeBlock* list = shared.free_lists[c].back();
+    shared.free_lists[c].pop_back();
+    shared.num_free_lists--;
+    return list;
+  }
+
+  /// \brief Set the current chunk of the given pool
+  ///
+  /// Reuse a partially used chunk from the global pool, or allocate a new
+  /// one. The rest of the previous chunk is smaller than a block and lost.
+  static void acquire_chunk(Pool& p) {
+    SharedPool& shared = shared_pool();
+    std::lock_guard< std::mutex > lock(shared.mutex);
+
+    if (!shared.partial_chunks.empty()) {
+      std::tie(p.chunk_begin, p.chunk_end) = shared.partial_chunks.back();
+      shared.partial_chunks.pop_back();
+      return;
+    }
+
+    void* chunk = ::operator new(ChunkSize);
+    shared.chunks.push_back(chunk);
+    p.chunk_begin = static_cast< char* >(chunk);
+    p.chunk_end = p.chunk_begin + ChunkSize;
+  }
+
+public:
+  /// \brief Allocate a block of the given size
+  static void* allocate(std::size_t size) {
+    if (size > ClassSize * NumClasses) {
+      return ::operator new(size);
+    }
+
+    std::size_t c = (size + ClassSize - 1) / ClassSize - 1;
+    Pool& p = pool();
+
+    if (p.free_lists[c] == nullptr) {
+      p.free_lists[c] = acquire_free_list(c);
+    }
+
+    if (FreeBlock* block = p.free_lists[c]) {
+      p.free_lists[c] = block->next;
+      return block;
+    }
+
+    std::size_t block_size = (c + 1) * ClassSize;
+    if (static_cast< std::size_t >(p.chunk_end - p.chunk_begin) < block_size) {
+      acquire_chunk(p);
+    }
+
+    void* block = p.chunk_begin;
+    p.chunk_begin += block_size;
+    return block;
+  }
+
+  /// \brief Return the number of chunks allocated from the system
+  static std::size_t num_chunks() {
+    SharedPool& shared = shared_pool();
+    std::lock_guard< std::mutex > lock(shared.mutex);
+    return shared.chunks.size();
+  }
+
+  /// \brief Deallocate a block of the given size
+  static void deallocate(void* ptr, std::size_t size) {
+    if (size > ClassSize * NumClasses) {
+      ::operator delete(ptr);
+      return;
+    }
+
+    std::size_t c = (size + ClassSize - 1) / ClassSize - 1;
+    Pool& p = pool();
+
+    auto block = static_cast< FreeBlock* >(ptr);
+    block->next = p.free_lists[c];
+    p.free_lists[c] = block;
+  }
+
+}; // end class NodeAllocator
+
+/// \brief Base class for patricia tree nodes
+///
+/// Nodes are reference counted with an intrusive counter, and allocated with
+/// the NodeAllocator.
+template < typename Derived >
+class NodeBase {
+private:
+  mutable typename RefCounterPolicy::type _ref_count;
+
+public:
+  NodeBase() noexcept : _ref_count(0) {}
+
+  NodeBase(const NodeBase&) noexcept : _ref_count(0) {}
+
+  NodeBase& operator=(const NodeBase&) noexcept { return *this; }
+
+  /// \brief Increment the reference counter, unless it is zero
+  ///
+  /// This is used to resurrect a node from a weak reference. Return false if
+  /// the node is being destroyed.
+  bool try_add_ref() const noexcept {
+    return RefCounterPolicy::try_increment(this->_ref_count);
+  }
+
+  /// \brief Return the reference counter
+  unsigned use_count() const noexcept {
+    return RefCounterPolicy::load(this->_ref_count);
+  }
+
+  static void* operator new(std::size_t size) {
+    return NodeAllocator::allocate(size);
+  }
+
+  static void operator delete(void* ptr, std::size_t size) {
+    NodeAllocator::deallocate(ptr, size);
+  }
+
+  friend void intrusive_ptr_add_ref(const NodeBase* p) noexcept {
+    RefCounterPolicy::increment(p->_ref_count);
+  }
+
+  friend void intrusive_ptr_release(const NodeBase* p) noexcept {
+    if (RefCounterPolicy::decrement(p->_ref_count) == 0) {
+      delete static_cast< const Derived* >(p);
+    }
+  }
+
+protected:
+  ~NodeBase() = default;
+
+}; // end class NodeBase
+
+using boost::static_pointer_cast;
+
+/// \brief Create a new reference counted node
+template < typename T, typename... Args >
+inline boost::intrusive_ptr< T > make_ptr(Args&&... args) {
+  return boost::intrusive_ptr< T >(
+      new std::remove_const_t< T >(std::forward< Args >(args)...));
+}
+
+/// Helpers for ValueHash
+namespace detail {
+
+using boost::hash_value;
+
+template < typename T >
+using HashValueOp = decltype(hash_value(std::declval< const T& >()));
+
+} // end namespace detail
+
+/// \brief Hash function for the values of hash-consed patricia trees
+///
+/// Use `hash_value(const T&)` if it is available, otherwise all values have
+/// the same hash and leaves are only distinguished by their key.
+template < typename T, typename = void >
+struct ValueHash {
+  static std::size_t hash(const T&) { return 0; }
+};
+
+template < typename T >
+struct ValueHash< T,
+                  std::enable_if_t< is_detected< detail::HashValueOp,
+                                                 T >::value > > {
+  static std::size_t hash(const T& value) {
+    using boost::hash_value;
+    return hash_value(value);
+  }
+};
+
+/// \brief Hash-consing of patricia tree nodes
+///
+/// Define IKOS_PATRICIA_TREE_HASH_CONSING to enable hash-consing: structurally
+/// equal trees are represented by the same node, and results of binary
+/// operations on nodes are memoized.
+#ifdef IKOS_PATRICIA_TREE_HASH_CONSING
+constexpr bool HashConsing = true;
+#else
+constexpr bool HashConsing = false;
+#endif
+
+/// \brief Table of hash-consed nodes
+///
+/// The table holds weak references on the nodes: a node must call erase()
+/// in its destructor, before its members are destroyed.
+///
+/// The table is split in shards protected by a mutex, so that threads
+/// creating nodes do not contend on a single lock.
+///
+/// Node must implement:
+///   bool Node::try_add_ref() const
+///
+/// Traits must implement:
+///   static std::size_t hash(const Node&)
+///   static bool equals(const Node&, const Node&)
+template < typename Node, typename Traits >
+class HashConsingTable {
+private:
+  /// \brief Number of shards
+  static constexpr std::size_t NumShards = 64;
+
+  struct Shard {
+    std::mutex mutex;
+    std::unordered_multimap< std::size_t, const Node* > nodes;
+  };
+
+private:
+  Shard _shards[NumShards];
+
+private:
+  HashConsingTable() = default;
+
+  Shard& shard(std::size_t hash) {
+    return this->_shards[(hash ^ (hash >> 16)) % NumShards];
+  }
+
+public:
+  HashConsingTable(const HashConsingTable&) = delete;
+  HashConsingTable(HashConsingTable&&) = delete;
+  HashConsingTable& operator=(const HashConsingTable&) = delete;
+  HashConsingTable& operator=(HashConsingTable&&) = delete;
+
+  /// \brief Return the global table
+  ///
+  /// The table is never destroyed, since nodes might outlive static objects.
+  static HashConsingTable& get() {
+    static auto table = new HashConsingTable();
+    return *table;
+  }
+
+  /// \brief Return the node equal to `node` in the table, or insert `node`
+  boost::intrusive_ptr< const Node > insert(
+      boost::intrusive_ptr< const Node > node) {
+    std::size_t hash = Traits::hash(*node);
+    Shard& s = this->shard(hash);
+    {
+      std::lock_guard< std::mutex > lock(s.mutex);
+      auto range = s.nodes.equal_range(hash);
+      for (auto it = range.first; it != range.second; ++it) {
+        // Skip nodes that are being destroyed
+        if (Traits::equals(*it->second, *node) && it->second->try_add_ref()) {
+          return boost::intrusive_ptr< const Node >(it->second,
+                                                    /*add_ref=*/false);
+        }
+      }
+      s.nodes.emplace(hash, node.get());
+    }
+    return node;
+  }
+
+  /// \brief Remove the given node from the table, if present
+  void erase(const Node* node) {
+    std::size_t hash = Traits::hash(*node);
+    Shard& s = this->shard(hash);
+    std::lock_guard< std::mutex > lock(s.mutex);
+    auto range = s.nodes.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->second == node) {
+        s.nodes.erase(it);
+        return;
+      }
+    }
+  }
+
+  /// \brief Return the number of nodes in the table
+  std::size_t size() {
+    std::size_t n = 0;
+    for (Shard& s : this->_shards) {
+      std::lock_guard< std::mutex > lock(s.mutex);
+      n += s.nodes.size();
+    }
+    return n;
+  }
+
+}; // end class HashConsingTable
+
+/// \brief Bounded cache for the results of binary operations on nodes
+///
+/// This is a direct-mapped cache indexed by the addresses of the operands.
+/// Entries hold a reference on the operands, so that their addresses cannot
+/// be reused by other nodes while they are in the cache.
+template < typename Ptr, typename Result >
+class MemoCache {
+private:
+  /// \brief Number of entries
+  static constexpr std::size_t Size = 4096;
+
+  struct Entry {
+    Ptr left;
+    Ptr right;
+    Result result;
+  };
+
+private:
+  std::vector< Entry > _entries;
+
+private:
+  static std::size_t slot(const Ptr& left, const Ptr& right) {
+    std::size_t hash = 0;
+    boost::hash_combine(hash, left.get());
+    boost::hash_combine(hash, right.get());
+    return hash % Size;
+  }
+
+public:
+  /// \brief Return the cached result for (`left`, `right`), or nullptr
+  const Result* find(const Ptr& left, const Ptr& right) const {
+    if (this->_entries.empty()) {
+      return nullptr;
+    }
+    const Entry& entry = this->_entries[slot(left, right)];
+    if (entry.left == left && entry.right == right) {
+      return &entry.result;
+    }
+    return nullptr;
+  }
+
+  /// \brief Store the result for (`left`, `right`)
+  void insert(const Ptr& left, const Ptr& right, Result result) {
+    if (this->_entries.empty()) {
+      this->_entries.resize(Size);
+    }
+    Entry& entry = this->_entries[slot(left, right)];
+    entry.left = left;
+    entry.right = right;
+    entry.result = std::move(result);
+  }
+
+  /// \brief Remove all entries
+  void clear() { this->_entries.clear(); }
+
+}; // end class MemoCache
+
 } // end namespace patricia_tree_utils
 } // end namespace core
 } // end namespace ikos
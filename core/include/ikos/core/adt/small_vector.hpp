@@ -3,8 +3,8 @@
  * \file
  * \brief Vector container optimized for a small number of elements
  *
- * It uses boost::container::small_vector if available,
- * otherwise falls back to std::vector.
+ * The first N elements are stored inline, in the object itself. The vector
+ * only allocates memory on the heap when it grows beyond N elements.
  *
  * Author: Maxime Arthaud
  *
@@ -46,38 +46,537 @@
 
 #pragma once
 
-#include <boost/version.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 
-#if BOOST_VERSION >= 105800
-
-// Use boost::container::small_vector
-#include <boost/container/small_vector.hpp>
+#include <ikos/core/support/assert.hpp>
 
 namespace ikos {
 namespace core {
 
 /// \brief Vector container optimized for a small number of elements
-template < typename T,
-           std::size_t N,
-           typename Allocator = boost::container::new_allocator< T > >
-using SmallVector = boost::container::small_vector< T, N, Allocator >;
+///
+/// This has the same interface as std::vector, except that the first `N`
+/// elements are stored inline. Moving or swapping a small vector that is not
+/// on the heap moves the elements one by one, and thus invalidates iterators.
+template < typename T, std::size_t N >
+class SmallVector {
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = T&;
+  using const_reference = const T&;
+  using pointer = T*;
+  using const_pointer = const T*;
+  using iterator = T*;
+  using const_iterator = const T*;
+  using reverse_iterator = std::reverse_iterator< iterator >;
+  using const_reverse_iterator = std::reverse_iterator< const_iterator >;
 
-} // end namespace core
-} // end namespace ikos
+private:
+  /// \brief Pointer on the first element, either `_storage` or the heap
+  T* _begin;
 
-#else
+  /// \brief Number of elements
+  size_type _size = 0;
 
-// Fall back to the good old std::vector
-#include <vector>
+  /// \brief Number of elements that fit in the current buffer
+  size_type _capacity = N;
 
-namespace ikos {
-namespace core {
+  /// \brief Inline storage for the first N elements
+  typename std::aligned_storage< sizeof(T) * (N > 0 ? N : 1),
+                                 alignof(T) >::type _storage;
 
-/// \brief Vector container optimized for a small number of elements
-template < typename T, std::size_t N, typename Allocator = std::allocator< T > >
-using SmallVector = std::vector< T, Allocator >;
+public:
+  /// \brief Create an empty vector
+  SmallVector() noexcept : _begin(this->inline_storage()) {}
+
+  /// \brief Create a vector with `n` value-initialized elements
+  explicit SmallVector(size_type n) : SmallVector() { this->resize(n); }
+
+  /// \brief Create a vector with `n` copies of `value`
+  SmallVector(size_type n, const T& value) : SmallVector() {
+    this->assign(n, value);
+  }
+
+  /// \brief Create a vector with the content of the range [first, last)
+  template < typename InputIterator,
+             typename = std::enable_if_t< std::is_convertible<
+                 typename std::iterator_traits< InputIterator >::
+                     iterator_category,
+                 std::input_iterator_tag >::value > >
+  SmallVector(InputIterator first, InputIterator last) : SmallVector() {
+    this->append(first, last);
+  }
+
+  /// \brief Create a vector with the given elements
+  SmallVector(std::initializer_list< T > elements) : SmallVector() {
+    this->append(elements.begin(), elements.end());
+  }
+
+  /// \brief Copy constructor
+  SmallVector(const SmallVector& other) : SmallVector() {
+    this->append(other.begin(), other.end());
+  }
+
+  /// \brief Move constructor
+  SmallVector(SmallVector&& other) noexcept(
+      std::is_nothrow_move_constructible< T >::value)
+      : SmallVector() {
+    this->steal(std::move(other));
+  }
+
+  /// \brief Copy assignment operator
+  SmallVector& operator=(const SmallVector& other) {
+    if (this != &other) {
+      this->assign(other.begin(), other.end());
+    }
+    return *this;
+  }
+
+  /// \brief Move assignment operator
+  SmallVector& operator=(SmallVector&& other) noexcept(
+      std::is_nothrow_move_constructible< T >::value) {
+    if (this != &other) {
+      this->clear();
+      this->deallocate();
+      this->steal(std::move(other));
+    }
+    return *this;
+  }
+
+  /// \brief Assign the given elements
+  SmallVector& operator=(std::initializer_list< T > elements) {
+    this->assign(elements.begin(), elements.end());
+    return *this;
+  }
+
+  /// \brief Destructor
+  ~SmallVector() {
+    this->clear();
+    this->deallocate();
+  }
+
+  /// \brief Replace the content with `n` copies of `value`
+  void assign(size_type n, const T& value) {
+    this->clear();
+    this->reserve(n);
+    std::uninitialized_fill_n(this->_begin, n, value);
+    this->_size = n;
+  }
+
+  /// \brief Replace the content with the range [first, last)
+  template < typename InputIterator >
+  void assign(InputIterator first, InputIterator last) {
+    this->clear();
+    this->append(first, last);
+  }
+
+  /// \brief Replace the content with the given elements
+  void assign(std::initializer_list< T > elements) {
+    this->assign(elements.begin(), elements.end());
+  }
+
+  /// \name Element access
+  /// @{
+
+  reference at(size_type i) {
+    if (i >= this->_size) {
+      throw std::out_of_range("SmallVector::at");
+    }
+    return this->_begin[i];
+  }
+
+  const_reference at(size_type i) const {
+    if (i >= this->_size) {
+      throw std::out_of_range("SmallVector::at");
+    }
+    return this->_begin[i];
+  }
+
+  reference operator[](size_type i) {
+    ikos_assert(i < this->_size);
+    return this->_begin[i];
+  }
+
+  const_reference operator[](size_type i) const {
+    ikos_assert(i < this->_size);
+    return this->_begin[i];
+  }
+
+  reference front() {
+    ikos_assert(this->_size > 0);
+    return this->_begin[0];
+  }
+
+  const_reference front() const {
+    ikos_assert(this->_size > 0);
+    return this->_begin[0];
+  }
+
+  reference back() {
+    ikos_assert(this->_size > 0);
+    return this->_begin[this->_size - 1];
+  }
+
+  const_reference back() const {
+    ikos_assert(this->_size > 0);
+    return this->_begin[this->_size - 1];
+  }
+
+  T* data() noexcept { return this->_begin; }
+
+  const T* data() const noexcept { return this->_begin; }
+
+  /// @}
+  /// \name Iterators
+  /// @{
+
+  iterator begin() noexcept { return this->_begin; }
+
+  const_iterator begin() const noexcept { return this->_begin; }
+
+  const_iterator cbegin() const noexcept { return this->_begin; }
+
+  iterator end() noexcept { return this->_begin + this->_size; }
+
+  const_iterator end() const noexcept { return this->_begin + this->_size; }
+
+  const_iterator cend() const noexcept { return this->_begin + this->_size; }
+
+  reverse_iterator rbegin() noexcept { return reverse_iterator(this->end()); }
+
+  const_reverse_iterator rbegin() const noexcept {
+    return const_reverse_iterator(this->end());
+  }
+
+  const_reverse_iterator crbegin() const noexcept { return this->rbegin(); }
+
+  reverse_iterator rend() noexcept { return reverse_iterator(this->begin()); }
+
+  const_reverse_iterator rend() const noexcept {
+    return const_reverse_iterator(this->begin());
+  }
+
+  const_reverse_iterator crend() const noexcept { return this->rend(); }
+
+  /// @}
+  /// \name Capacity
+  /// @{
+
+  bool empty() const noexcept { return this->_size == 0; }
+
+  size_type size() const noexcept { return this->_size; }
+
+  size_type max_size() const noexcept {
+    return std::numeric_limits< size_type >::max() / sizeof(T);
+  }
+
+  size_type capacity() const noexcept { return this->_capacity; }
+
+  /// \brief Return true if the elements are stored inline
+  bool is_small() const noexcept {
+    return this->_begin == this->inline_storage();
+  }
+
+  void reserve(size_type n) {
+    if (n > this->_capacity) {
+      this->reallocate(n);
+    }
+  }
+
+  void shrink_to_fit() {
+    if (!this->is_small() && this->_size < this->_capacity) {
+      this->reallocate(this->_size);
+    }
+  }
+
+  /// @}
+  /// \name Modifiers
+  /// @{
+
+  void clear() noexcept {
+    this->destroy(this->_begin, this->_begin + this->_size);
+    this->_size = 0;
+  }
+
+  iterator insert(const_iterator pos, const T& value) {
+    return this->emplace(pos, value);
+  }
+
+  iterator insert(const_iterator pos, T&& value) {
+    return this->emplace(pos, std::move(value));
+  }
+
+  iterator insert(const_iterator pos, size_type n, const T& value) {
+    size_type i = this->index(pos);
+    T copy(value); // `value` might be an element of the vector
+    this->reserve(this->_size + n);
+    std::uninitialized_fill_n(this->end(), n, copy);
+    this->_size += n;
+    std::rotate(this->begin() + i, this->end() - n, this->end());
+    return this->begin() + i;
+  }
+
+  template < typename InputIterator,
+             typename = std::enable_if_t< std::is_convertible<
+                 typename std::iterator_traits< InputIterator >::
+                     iterator_category,
+                 std::input_iterator_tag >::value > >
+  iterator insert(const_iterator pos,
+                  InputIterator first,
+                  InputIterator last) {
+    size_type i = this->index(pos);
+    size_type old_size = this->_size;
+    this->append(first, last);
+    std::rotate(this->begin() + i, this->begin() + old_size, this->end());
+    return this->begin() + i;
+  }
+
+  iterator insert(const_iterator pos, std::initializer_list< T > elements) {
+    return this->insert(pos, elements.begin(), elements.end());
+  }
+
+  template < typename... Args >
+  iterator emplace(const_iterator pos, Args&&... args) {
+    size_type i = this->index(pos);
+    this->emplace_back(std::forward< Args >(args)...);
+    std::rotate(this->begin() + i, this->end() - 1, this->end());
+    return this->begin() + i;
+  }
+
+  iterator erase(const_iterator pos) { return this->erase(pos, pos + 1); }
+
+  iterator erase(const_iterator first, const_iterator last) {
+    iterator it = this->begin() + this->index(first);
+    iterator et = this->begin() + this->index(last);
+    ikos_assert(it <= et);
+    iterator new_end = std::move(et, this->end(), it);
+    this->destroy(new_end, this->end());
+    this->_size = static_cast< size_type >(new_end - this->_begin);
+    return it;
+  }
+
+  void push_back(const T& value) { this->emplace_back(value); }
+
+  void push_back(T&& value) { this->emplace_back(std::move(value)); }
+
+  template < typename... Args >
+  reference emplace_back(Args&&... args) {
+    if (this->_size == this->_capacity) {
+      // `args` might refer to an element of the vector, construct it first
+      T value(std::forward< Args >(args)...);
+      this->reallocate(this->grow_capacity(this->_size + 1));
+      ::new (static_cast< void* >(this->end())) T(std::move(value));
+    } else {
+      ::new (static_cast< void* >(this->end()))
+          T(std::forward< Args >(args)...);
+    }
+    ++this->_size;
+    return this->back();
+  }
+
+  void pop_back() {
+    ikos_assert(this->_size > 0);
+    --this->_size;
+    this->end()->~T();
+  }
+
+  void resize(size_type n) {
+    if (n < this->_size) {
+      this->destroy(this->_begin + n, this->end());
+      this->_size = n;
+    } else {
+      this->reserve(n);
+      for (; this->_size < n; ++this->_size) {
+        ::new (static_cast< void* >(this->end())) T();
+      }
+    }
+  }
+
+  void resize(size_type n, const T& value) {
+    if (n < this->_size) {
+      this->destroy(this->_begin + n, this->end());
+      this->_size = n;
+    } else if (n > this->_size) {
+      this->insert(this->end(), n - this->_size, value);
+    }
+  }
+
+  void swap(SmallVector& other) {
+    SmallVector tmp(std::move(other));
+    other = std::move(*this);
+    *this = std::move(tmp);
+  }
+
+  /// @}
+
+private:
+  /// \brief Return a pointer on the inline storage
+  T* inline_storage() noexcept { return reinterpret_cast< T* >(&_storage); }
+
+  /// \brief Return a pointer on the inline storage
+  const T* inline_storage() const noexcept {
+    return reinterpret_cast< const T* >(&_storage);
+  }
+
+  /// \brief Return the index of the given iterator
+  size_type index(const_iterator pos) const {
+    ikos_assert(this->begin() <= pos && pos <= this->end());
+    return static_cast< size_type >(pos - this->begin());
+  }
+
+  /// \brief Return the capacity to use when growing to at least `n` elements
+  size_type grow_capacity(size_type n) const {
+    return std::max(n, 2 * this->_capacity);
+  }
+
+  /// \brief Append the range [first, last)
+  template < typename InputIterator >
+  void append(InputIterator first, InputIterator last) {
+    using Category =
+        typename std::iterator_traits< InputIterator >::iterator_category;
+    if (std::is_convertible< Category, std::forward_iterator_tag >::value) {
+      auto n = static_cast< size_type >(std::distance(first, last));
+      if (this->_size + n > this->_capacity) {
+        // The range might be in the vector, copy it before reallocating
+        this->reallocate(this->grow_capacity(this->_size + n), first, last);
+      } else {
+        std::uninitialized_copy(first, last, this->end());
+      }
+      this->_size += n;
+    } else {
+      for (; first != last; ++first) {
+        this->emplace_back(*first);
+      }
+    }
+  }
+
+  /// \brief Move the elements to a buffer of the given capacity
+  void reallocate(size_type capacity) {
+    const T* none = nullptr;
+    this->reallocate(capacity, none, none);
+  }
+
+  /// \brief Move the elements to a buffer of the given capacity, and copy the
+  /// range [first, last) after them
+  ///
+  /// This does not update the size for the copied elements.
+  template < typename ForwardIterator >
+  void reallocate(size_type capacity,
+                  ForwardIterator first,
+                  ForwardIterator last) {
+    ikos_assert(capacity >= this->_size);
+    T* buffer = (capacity <= N)
+                    ? this->inline_storage()
+                    : static_cast< T* >(::operator new(capacity * sizeof(T)));
+    std::uninitialized_copy(first, last, buffer + this->_size);
+    if (buffer == this->_begin) {
+      return;
+    }
+    for (size_type i = 0; i < this->_size; ++i) {
+      ::new (static_cast< void* >(buffer + i))
+          T(std::move_if_noexcept(this->_begin[i]));
+    }
+    this->destroy(this->_begin, this->end());
+    this->deallocate();
+    this->_begin = buffer;
+    this->_capacity = std::max(capacity, N);
+  }
+
+  /// \brief Release the heap buffer, if any
+  void deallocate() noexcept {
+    if (!this->is_small()) {
+      ::operator delete(this->_begin);
+      this->_begin = this->inline_storage();
+      this->_capacity = N;
+    }
+  }
+
+  /// \brief Move the content of `other`, which is left empty
+  ///
+  /// Requires this vector to be empty and small.
+  void steal(SmallVector&& other) noexcept(
+      std::is_nothrow_move_constructible< T >::value) {
+    if (other.is_small()) {
+      for (size_type i = 0; i < other._size; ++i) {
+        ::new (static_cast< void* >(this->_begin + i))
+            T(std::move(other._begin[i]));
+      }
+      this->_size = other._size;
+      other.clear();
+    } else {
+      this->_begin = other._begin;
+      this->_size = other._size;
+      this->_capacity = other._capacity;
+      other._begin = other.inline_storage();
+      other._size = 0;
+      other._capacity = N;
+    }
+  }
+
+  /// \brief Destroy the elements in [first, last)
+  static void destroy(T* first, T* last) noexcept {
+    for (; first != last; ++first) {
+      first->~T();
+    }
+  }
+
+}; // end class SmallVector
+
+template < typename T, std::size_t N >
+inline bool operator==(const SmallVector< T, N >& lhs,
+                       const SmallVector< T, N >& rhs) {
+  return lhs.size() == rhs.size() &&
+         std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template < typename T, std::size_t N >
+inline bool operator!=(const SmallVector< T, N >& lhs,
+                       const SmallVector< T, N >& rhs) {
+  return !(lhs == rhs);
+}
+
+template < typename T, std::size_t N >
+inline bool operator<(const SmallVector< T, N >& lhs,
+                      const SmallVector< T, N >& rhs) {
+  return std::lexicographical_compare(lhs.begin(),
+                                      lhs.end(),
+                                      rhs.begin(),
+                                      rhs.end());
+}
+
+template < typename T, std::size_t N >
+inline bool operator>(const SmallVector< T, N >& lhs,
+                      const SmallVector< T, N >& rhs) {
+  return rhs < lhs;
+}
+
+template < typename T, std::size_t N >
+inline bool operator<=(const SmallVector< T, N >& lhs,
+                       const SmallVector< T, N >& rhs) {
+  return !(rhs < lhs);
+}
+
+template < typename T, std::size_t N >
+inline bool operator>=(const SmallVector< T, N >& lhs,
+                       const SmallVector< T, N >& rhs) {
+  return !(lhs < rhs);
+}
+
+template < typename T, std::size_t N >
+inline void swap(SmallVector< T, N >& lhs, SmallVector< T, N >& rhs) {
+  lhs.swap(rhs);
+}
 
 } // end namespace core
 } // end namespace ikos
-
-#endif
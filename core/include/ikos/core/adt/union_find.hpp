@@ -0,0 +1,152 @@
+/**************************************************************************/ /**
+ *
+ * \file
+ * \brief Union-find with a bounded size of classes
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2017-2018 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+
+#include <ikos/core/semantic/indexable.hpp>
+
+namespace ikos {
+namespace core {
+
+/// \brief Union-find on elements, with a maximum size of classes
+///
+/// The root of a class is its element with the smallest index, so that classes
+/// do not depend on the order of the merges. A merge that would create a class
+/// larger than the maximum size is refused.
+///
+/// Requirements:
+///
+/// Element must implement IndexableTraits
+/// Element must implement std::hash
+template < typename Element >
+class UnionFind {
+public:
+  static_assert(IsIndexable< Element >::value,
+                "Element must implement IndexableTraits");
+
+private:
+  /// \brief Map from element to parent
+  std::unordered_map< Element, Element > _parents;
+
+  /// \brief Map from root to the size of its class
+  std::unordered_map< Element, std::size_t > _sizes;
+
+  /// \brief Maximum size of a class
+  std::size_t _max_size;
+
+public:
+  /// \brief Create an empty union-find
+  ///
+  /// \param max_size Maximum size of a class
+  explicit UnionFind(
+      std::size_t max_size = std::numeric_limits< std::size_t >::max())
+      : _max_size(max_size) {}
+
+  /// \brief Add an element, in its own class
+  void add(Element e) {
+    if (this->_parents.emplace(e, e).second) {
+      this->_sizes.emplace(e, 1);
+    }
+  }
+
+  /// \brief Return the root of the class containing `e`
+  ///
+  /// The element must have been added.
+  Element find(Element e) {
+    Element root = e;
+    while (!(this->_parents.at(root) == root)) {
+      root = this->_parents.at(root);
+    }
+    while (!(e == root)) {
+      Element& parent = this->_parents.at(e);
+      e = parent;
+      parent = root;
+    }
+    return root;
+  }
+
+  /// \brief Return the size of the class containing `e`
+  std::size_t size(Element e) { return this->_sizes.at(this->find(e)); }
+
+  /// \brief Merge the classes of `x` and `y`
+  ///
+  /// Returns false if the merge is refused because the class would be larger
+  /// than the maximum size.
+  bool merge(Element x, Element y) {
+    Element x_root = this->find(x);
+    Element y_root = this->find(y);
+
+    if (x_root == y_root) {
+      return true;
+    }
+
+    std::size_t size = this->_sizes.at(x_root) + this->_sizes.at(y_root);
+    if (size > this->_max_size) {
+      return false;
+    }
+
+    if (IndexableTraits< Element >::index(y_root) <
+        IndexableTraits< Element >::index(x_root)) {
+      std::swap(x_root, y_root);
+    }
+    this->_parents[y_root] = x_root;
+    this->_sizes.erase(y_root);
+    this->_sizes[x_root] = size;
+    return true;
+  }
+
+  /// \brief Begin iterator on the pairs (element, parent)
+  auto begin() const { return this->_parents.begin(); }
+
+  /// \brief End iterator on the pairs (element, parent)
+  auto end() const { return this->_parents.end(); }
+
+}; // end class UnionFind
+
+} // end namespace core
+} // end namespace ikos
@@ -55,18 +55,16 @@ namespace core {
 
 /// \brief Discrete abstract domain
 ///
-/// The implementation is based on patricia trees.
-template < typename Element >
+/// The implementation is based on patricia trees by default. `Set` can be any
+/// set with the interface of PatriciaTreeSet, e.g BitsetSet.
+template < typename Element, typename Set = PatriciaTreeSet< Element > >
 class DiscreteDomain final
-    : public AbstractDomain< DiscreteDomain< Element > > {
-private:
-  using PatriciaTreeSetT = PatriciaTreeSet< Element >;
-
+    : public AbstractDomain< DiscreteDomain< Element, Set > > {
 public:
-  using Iterator = typename PatriciaTreeSetT::Iterator;
+  using Iterator = typename Set::Iterator;
 
 private:
-  PatriciaTreeSetT _set;
+  Set _set;
   bool _top;
 
 private:
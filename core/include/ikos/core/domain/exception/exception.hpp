@@ -45,6 +45,8 @@
 
 #include <sstream>
 
+#include <boost/optional.hpp>
+
 #include <ikos/core/domain/exception/abstract_domain.hpp>
 
 namespace ikos {
@@ -59,20 +61,28 @@ namespace exception {
 ///   * **caught_exceptions** represents the state of uncaught exceptions;
 ///   * **propagated_exceptions** represents the state of caught exceptions
 ///     that are propagated through the control flow graph.
+///
+/// The exception states are bottom most of the time, for instance in C code.
+/// They are only materialized when they become non-bottom, so that lattice
+/// operations and transfer functions cost nothing for them otherwise.
 template < typename UnderlyingDomain >
 class ExceptionDomain final
     : public exception::AbstractDomain< UnderlyingDomain,
                                         ExceptionDomain< UnderlyingDomain > > {
+private:
+  /// \brief Lazily materialized abstract value, boost::none represents bottom
+  using LazyDomain = boost::optional< UnderlyingDomain >;
+
 private:
   /// \brief Represents the normal execution flow state
   UnderlyingDomain _normal;
 
   /// \brief Represents the state of uncaught exceptions
-  UnderlyingDomain _caught_exceptions;
+  LazyDomain _caught_exceptions;
 
   /// \brief Represents the state of caught exceptions that are propagated
   /// through the control flow graph
-  UnderlyingDomain _propagated_exceptions;
+  LazyDomain _propagated_exceptions;
 
 private:
   struct TopTag {};
@@ -87,15 +97,10 @@ private:
 
   /// \brief Create the top abstract value with no pending exceptions
   explicit ExceptionDomain(TopNoExceptionsTag)
-      : _normal(UnderlyingDomain::top()),
-        _caught_exceptions(UnderlyingDomain::bottom()),
-        _propagated_exceptions(UnderlyingDomain::bottom()) {}
+      : _normal(UnderlyingDomain::top()) {}
 
   /// \brief Create the bottom abstract value
-  explicit ExceptionDomain(BottomTag)
-      : _normal(UnderlyingDomain::bottom()),
-        _caught_exceptions(UnderlyingDomain::bottom()),
-        _propagated_exceptions(UnderlyingDomain::bottom()) {}
+  explicit ExceptionDomain(BottomTag) : _normal(UnderlyingDomain::bottom()) {}
 
 public:
   /// \brief Create the top abstract value
@@ -111,8 +116,8 @@ public:
                   UnderlyingDomain caught_exceptions,
                   UnderlyingDomain propagated_exceptions)
       : _normal(std::move(normal)),
-        _caught_exceptions(std::move(caught_exceptions)),
-        _propagated_exceptions(std::move(propagated_exceptions)) {}
+        _caught_exceptions(lazy(std::move(caught_exceptions))),
+        _propagated_exceptions(lazy(std::move(propagated_exceptions))) {}
 
   /// \brief Copy constructor
   ExceptionDomain(const ExceptionDomain&) = default;
@@ -140,85 +145,223 @@ public:
   /// \brief Create the bottom abstract value
   static ExceptionDomain bottom() { return ExceptionDomain(BottomTag{}); }
 
+private:
+  /// \brief Return the lazy abstract value for the given abstract value
+  static LazyDomain lazy(UnderlyingDomain inv) {
+    if (inv.is_bottom()) {
+      return boost::none;
+    } else {
+      return LazyDomain(std::move(inv));
+    }
+  }
+
+  /// \brief Return true if the given lazy abstract value is bottom
+  static bool is_bottom(const LazyDomain& inv) {
+    return !inv || inv->is_bottom();
+  }
+
+  /// \brief Return true if the given lazy abstract value is top
+  static bool is_top(const LazyDomain& inv) { return inv && inv->is_top(); }
+
+  /// \brief Materialize the given lazy abstract value
+  static UnderlyingDomain& get(LazyDomain& inv) {
+    if (!inv) {
+      inv = UnderlyingDomain::bottom();
+    }
+    return *inv;
+  }
+
+  /// \brief Return the given lazy abstract value, without materializing it
+  static const UnderlyingDomain& get(const LazyDomain& inv) {
+    if (!inv) {
+      static const UnderlyingDomain Bottom = UnderlyingDomain::bottom();
+      return Bottom;
+    }
+    return *inv;
+  }
+
+  /// \brief Return true if `x` is included in `y`
+  static bool leq(const LazyDomain& x, const LazyDomain& y) {
+    if (!x) {
+      return true;
+    } else if (!y) {
+      return x->is_bottom();
+    } else {
+      return x->leq(*y);
+    }
+  }
+
+  /// \brief Return true if `x` is equal to `y`
+  static bool equals(const LazyDomain& x, const LazyDomain& y) {
+    if (!x) {
+      return is_bottom(y);
+    } else if (!y) {
+      return x->is_bottom();
+    } else {
+      return x->equals(*y);
+    }
+  }
+
+  /// \brief Apply a join-like operator `op` (join, widening) on `x` and `y`,
+  /// using that bottom is the identity element
+  template < typename Operator >
+  static void join_like(LazyDomain& x, const LazyDomain& y, Operator op) {
+    if (!y) {
+      return;
+    } else if (!x) {
+      x = *y;
+    } else {
+      op(*x, *y);
+    }
+  }
+
+  /// \brief Apply a meet-like operator `op` (meet, narrowing) on `x` and `y`,
+  /// using that bottom is the absorbing element
+  template < typename Operator >
+  static void meet_like(LazyDomain& x, const LazyDomain& y, Operator op) {
+    if (!x) {
+      return;
+    } else if (!y) {
+      x = boost::none;
+    } else {
+      op(*x, *y);
+    }
+  }
+
+  /// \brief Join `y` into `x` and set `y` to bottom
+  static void merge(LazyDomain& x, LazyDomain& y) {
+    if (!y) {
+      return;
+    } else if (!x) {
+      x = std::move(y);
+    } else {
+      x->join_with(*y);
+    }
+    y = boost::none;
+  }
+
+  /// \brief Join the normal execution flow state into caught exceptions and
+  /// set it to bottom
+  void merge_normal_in_caught_exceptions() {
+    if (!this->_caught_exceptions) {
+      this->_caught_exceptions = std::move(this->_normal);
+      this->_normal = UnderlyingDomain::bottom();
+    } else {
+      this->_caught_exceptions->join_with(this->_normal);
+      this->_normal.set_to_bottom();
+    }
+  }
+
+public:
+  /// \brief Normalize the abstract value
+  void normalize() const {
+    this->_normal.normalize();
+    if (this->_caught_exceptions) {
+      this->_caught_exceptions->normalize();
+    }
+    if (this->_propagated_exceptions) {
+      this->_propagated_exceptions->normalize();
+    }
+  }
+
   bool is_bottom() const override {
-    return this->_normal.is_bottom() && this->_caught_exceptions.is_bottom() &&
-           this->_propagated_exceptions.is_bottom();
+    return this->_normal.is_bottom() && is_bottom(this->_caught_exceptions) &&
+           is_bottom(this->_propagated_exceptions);
   }
 
   bool is_top() const override {
-    return this->_normal.is_top() && this->_caught_exceptions.is_top() &&
-           this->_propagated_exceptions.is_top();
+    return this->_normal.is_top() && is_top(this->_caught_exceptions) &&
+           is_top(this->_propagated_exceptions);
   }
 
   void set_to_bottom() override {
     this->_normal.set_to_bottom();
-    this->_caught_exceptions.set_to_bottom();
-    this->_propagated_exceptions.set_to_bottom();
+    this->_caught_exceptions = boost::none;
+    this->_propagated_exceptions = boost::none;
   }
 
   void set_to_top() override {
     this->_normal.set_to_top();
-    this->_caught_exceptions.set_to_top();
-    this->_propagated_exceptions.set_to_top();
+    this->_caught_exceptions = UnderlyingDomain::top();
+    this->_propagated_exceptions = UnderlyingDomain::top();
   }
 
   bool leq(const ExceptionDomain& other) const override {
     return this->_normal.leq(other._normal) &&
-           this->_caught_exceptions.leq(other._caught_exceptions) &&
-           this->_propagated_exceptions.leq(other._propagated_exceptions);
+           leq(this->_caught_exceptions, other._caught_exceptions) &&
+           leq(this->_propagated_exceptions, other._propagated_exceptions);
   }
 
   bool equals(const ExceptionDomain& other) const override {
     return this->_normal.equals(other._normal) &&
-           this->_caught_exceptions.equals(other._caught_exceptions) &&
-           this->_propagated_exceptions.equals(other._propagated_exceptions);
+           equals(this->_caught_exceptions, other._caught_exceptions) &&
+           equals(this->_propagated_exceptions, other._propagated_exceptions);
   }
 
   void join_with(const ExceptionDomain& other) override {
+    auto op = [](UnderlyingDomain& x, const UnderlyingDomain& y) {
+      x.join_with(y);
+    };
     this->_normal.join_with(other._normal);
-    this->_caught_exceptions.join_with(other._caught_exceptions);
-    this->_propagated_exceptions.join_with(other._propagated_exceptions);
+    join_like(this->_caught_exceptions, other._caught_exceptions, op);
+    join_like(this->_propagated_exceptions, other._propagated_exceptions, op);
   }
 
   void join_loop_with(const ExceptionDomain& other) override {
+    auto op = [](UnderlyingDomain& x, const UnderlyingDomain& y) {
+      x.join_loop_with(y);
+    };
     this->_normal.join_loop_with(other._normal);
-    this->_caught_exceptions.join_loop_with(other._caught_exceptions);
-    this->_propagated_exceptions.join_loop_with(other._propagated_exceptions);
+    join_like(this->_caught_exceptions, other._caught_exceptions, op);
+    join_like(this->_propagated_exceptions, other._propagated_exceptions, op);
   }
 
   void join_iter_with(const ExceptionDomain& other) override {
+    auto op = [](UnderlyingDomain& x, const UnderlyingDomain& y) {
+      x.join_iter_with(y);
+    };
     this->_normal.join_iter_with(other._normal);
-    this->_caught_exceptions.join_iter_with(other._caught_exceptions);
-    this->_propagated_exceptions.join_iter_with(other._propagated_exceptions);
+    join_like(this->_caught_exceptions, other._caught_exceptions, op);
+    join_like(this->_propagated_exceptions, other._propagated_exceptions, op);
   }
 
   void widen_with(const ExceptionDomain& other) override {
+    auto op = [](UnderlyingDomain& x, const UnderlyingDomain& y) {
+      x.widen_with(y);
+    };
     this->_normal.widen_with(other._normal);
-    this->_caught_exceptions.widen_with(other._caught_exceptions);
-    this->_propagated_exceptions.widen_with(other._propagated_exceptions);
+    join_like(this->_caught_exceptions, other._caught_exceptions, op);
+    join_like(this->_propagated_exceptions, other._propagated_exceptions, op);
   }
 
   /// \brief Perform the widening of two abstract values with a threshold
   template < typename Threshold >
   void widen_threshold_with(const ExceptionDomain& other,
                             const Threshold& threshold) {
+    auto op = [&threshold](UnderlyingDomain& x, const UnderlyingDomain& y) {
+      x.widen_threshold_with(y, threshold);
+    };
     this->_normal.widen_threshold_with(other._normal, threshold);
-    this->_caught_exceptions.widen_threshold_with(other._caught_exceptions,
-                                                  threshold);
-    this->_propagated_exceptions
-        .widen_threshold_with(other._propagated_exceptions, threshold);
+    join_like(this->_caught_exceptions, other._caught_exceptions, op);
+    join_like(this->_propagated_exceptions, other._propagated_exceptions, op);
   }
 
   void meet_with(const ExceptionDomain& other) override {
+    auto op = [](UnderlyingDomain& x, const UnderlyingDomain& y) {
+      x.meet_with(y);
+    };
     this->_normal.meet_with(other._normal);
-    this->_caught_exceptions.meet_with(other._caught_exceptions);
-    this->_propagated_exceptions.meet_with(other._propagated_exceptions);
+    meet_like(this->_caught_exceptions, other._caught_exceptions, op);
+    meet_like(this->_propagated_exceptions, other._propagated_exceptions, op);
   }
 
   void narrow_with(const ExceptionDomain& other) override {
+    auto op = [](UnderlyingDomain& x, const UnderlyingDomain& y) {
+      x.narrow_with(y);
+    };
     this->_normal.narrow_with(other._normal);
-    this->_caught_exceptions.narrow_with(other._caught_exceptions);
-    this->_propagated_exceptions.narrow_with(other._propagated_exceptions);
+    meet_like(this->_caught_exceptions, other._caught_exceptions, op);
+    meet_like(this->_propagated_exceptions, other._propagated_exceptions, op);
   }
 
   /*
@@ -230,19 +373,19 @@ public:
   const UnderlyingDomain& normal() const override { return this->_normal; }
 
   UnderlyingDomain& caught_exceptions() override {
-    return this->_caught_exceptions;
+    return get(this->_caught_exceptions);
   }
 
   const UnderlyingDomain& caught_exceptions() const override {
-    return this->_caught_exceptions;
+    return get(this->_caught_exceptions);
   }
 
-  UnderlyingDomain propagated_exceptions() override {
-    return this->_propagated_exceptions;
+  UnderlyingDomain& propagated_exceptions() override {
+    return get(this->_propagated_exceptions);
   }
 
   const UnderlyingDomain& propagated_exceptions() const override {
-    return this->_propagated_exceptions;
+    return get(this->_propagated_exceptions);
   }
 
   bool is_normal_flow_bottom() const override {
@@ -256,77 +399,75 @@ public:
   void set_normal_flow_to_top() override { this->_normal.set_to_top(); }
 
   bool is_caught_exceptions_bottom() const override {
-    return this->_caught_exceptions.is_bottom();
+    return is_bottom(this->_caught_exceptions);
   }
 
   bool is_caught_exceptions_top() const override {
-    return this->_caught_exceptions.is_top();
+    return is_top(this->_caught_exceptions);
   }
 
   void set_caught_exceptions_to_bottom() override {
-    this->_caught_exceptions.set_to_bottom();
+    this->_caught_exceptions = boost::none;
   }
 
   void set_caught_exceptions_to_top() override {
-    this->_caught_exceptions.set_to_top();
+    this->_caught_exceptions = UnderlyingDomain::top();
   }
 
   bool is_propagated_exceptions_bottom() const override {
-    return this->_propagated_exceptions.is_bottom();
+    return is_bottom(this->_propagated_exceptions);
   }
 
   bool is_propagated_exceptions_top() const override {
-    return this->_propagated_exceptions.is_top();
+    return is_top(this->_propagated_exceptions);
   }
 
   void set_propagated_exceptions_to_bottom() override {
-    this->_propagated_exceptions.set_to_bottom();
+    this->_propagated_exceptions = boost::none;
   }
 
   void set_propagated_exceptions_to_top() override {
-    this->_propagated_exceptions.set_to_top();
+    this->_propagated_exceptions = UnderlyingDomain::top();
   }
 
   void merge_propagated_in_caught_exceptions() override {
-    this->_caught_exceptions.join_with(this->_propagated_exceptions);
-    this->_propagated_exceptions.set_to_bottom();
+    merge(this->_caught_exceptions, this->_propagated_exceptions);
   }
 
   void merge_caught_in_propagated_exceptions() override {
-    this->_propagated_exceptions.join_with(this->_caught_exceptions);
-    this->_caught_exceptions.set_to_bottom();
+    merge(this->_propagated_exceptions, this->_caught_exceptions);
   }
 
-  void enter_normal() override { this->_caught_exceptions.set_to_bottom(); }
+  void enter_normal() override { this->_caught_exceptions = boost::none; }
 
   void enter_catch() override {
-    std::swap(this->_normal, this->_caught_exceptions);
-    this->_caught_exceptions.set_to_bottom();
-    this->_propagated_exceptions.set_to_bottom();
+    if (this->_caught_exceptions) {
+      this->_normal = std::move(*this->_caught_exceptions);
+    } else {
+      this->_normal.set_to_bottom();
+    }
+    this->_caught_exceptions = boost::none;
+    this->_propagated_exceptions = boost::none;
   }
 
   void ignore_exceptions() override {
-    this->_caught_exceptions.set_to_bottom();
-    this->_propagated_exceptions.set_to_bottom();
+    this->_caught_exceptions = boost::none;
+    this->_propagated_exceptions = boost::none;
   }
 
-  void throw_exception() override {
-    this->_caught_exceptions.join_with(this->_normal);
-    this->_normal.set_to_bottom();
-  }
+  void throw_exception() override { this->merge_normal_in_caught_exceptions(); }
 
   void resume_exception() override {
-    this->_caught_exceptions.join_with(this->_normal);
-    this->_normal.set_to_bottom();
+    this->merge_normal_in_caught_exceptions();
   }
 
   void dump(std::ostream& o) const override {
     o << "(normal=";
     this->_normal.dump(o);
     o << ", caught_exceptions=";
-    this->_caught_exceptions.dump(o);
+    this->caught_exceptions().dump(o);
     o << ", propagated_exceptions=";
-    this->_propagated_exceptions.dump(o);
+    this->propagated_exceptions().dump(o);
     o << ")";
   }
 
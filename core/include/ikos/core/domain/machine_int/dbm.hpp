@@ -0,0 +1,1372 @@
+/**************************************************************************/ /**
+ *
+ * \file
+ * \brief Difference-Bound Matrices abstract domain on machine integers
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2018 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <boost/container/flat_map.hpp>
+
+#include <ikos/core/domain/machine_int/abstract_domain.hpp>
+#include <ikos/core/domain/machine_int/interval.hpp>
+#include <ikos/core/semantic/dumpable.hpp>
+#include <ikos/core/support/assert.hpp>
+
+namespace ikos {
+namespace core {
+namespace machine_int {
+
+namespace dbm_impl {
+
+/// \brief Weight of an edge in a difference-bound matrix
+using Weight = int64_t;
+
+/// \brief Weight representing +oo
+constexpr Weight Infinity = std::numeric_limits< Weight >::max();
+
+/// \brief Smallest finite weight
+///
+/// Weights are kept above `-Infinity`, so that they can always be negated.
+constexpr Weight MinWeight = -std::numeric_limits< Weight >::max();
+
+/// \brief Add two weights
+///
+/// On overflow, the result is rounded up, which only weakens the constraint.
+inline Weight add(Weight x, Weight y) {
+  if (x == Infinity || y == Infinity) {
+    return Infinity;
+  }
+
+  Weight r;
+  if (__builtin_add_overflow(x, y, &r)) {
+    return (x > 0) ? Infinity : MinWeight;
+  }
+
+  return (r < MinWeight) ? MinWeight : r;
+}
+
+} // end namespace dbm_impl
+
+/// \brief Difference-Bound Matrices abstract domain on machine integers
+///
+/// This is a native implementation of the Difference-Bound Matrices abstract
+/// domain on machine integers, as opposed to numeric::DBM wrapped in a
+/// NumericDomainAdapter.
+///
+/// A constraint `x - y <= c` is on the values of `x` and `y`, interpreted
+/// according to the signedness of their types. The weights are stored in 64
+/// bits integers, and overflows are rounded up to +oo.
+///
+/// Relations are kept when the value of the result is `y + c`, up to a wrap
+/// around that is the same for all the values of `y`. This covers additions
+/// and subtractions of constants, as well as integer casts. Other operations
+/// are computed with intervals.
+///
+/// Variables with a type larger than 64 bits, and unsigned 64 bits variables,
+/// are not in the matrix. They are handled by a separate interval domain.
+///
+/// Note that this abstract domain is not thread-safe.
+template < typename VariableRef >
+class DBM final
+    : public machine_int::AbstractDomain< VariableRef, DBM< VariableRef > > {
+public:
+  using LinearExpressionT = LinearExpression< MachineInt, VariableRef >;
+
+private:
+  using Weight = dbm_impl::Weight;
+  using IntervalDomainT = IntervalDomain< VariableRef >;
+  using VariableTrait = machine_int::VariableTraits< VariableRef >;
+  using Parent = machine_int::AbstractDomain< VariableRef, DBM >;
+
+  /// \brief Index of a variable in the matrix
+  using MatrixIndex = unsigned;
+
+  // \brief Map from variable to index
+  using VarIndexMap = boost::container::flat_map< VariableRef, MatrixIndex >;
+
+  class Matrix {
+  private:
+    std::vector< Weight > _matrix;
+    MatrixIndex _num_vars = 0; // size of the matrix
+
+  public:
+    /// \brief Create an empty matrix
+    Matrix() = default;
+
+    /// \brief Copy constructor
+    Matrix(const Matrix&) = default;
+
+    /// \brief Move constructor
+    Matrix(Matrix&&) = default;
+
+    /// \brief Copy assignment operator
+    Matrix& operator=(const Matrix&) = default;
+
+    /// \brief Move assignment operator
+    Matrix& operator=(Matrix&&) = default;
+
+    /// \brief Destructor
+    ~Matrix() = default;
+
+    /// \brief Return the number of variables in the matrix
+    MatrixIndex num_vars() const { return this->_num_vars; }
+
+    /// \brief Return the element (i, j)
+    Weight operator()(MatrixIndex i, MatrixIndex j) const {
+      ikos_assert_msg(i < this->_num_vars && j < this->_num_vars,
+                      "ouf of bounds matrix access");
+      return this->_matrix[this->_num_vars * i + j];
+    }
+
+    /// \brief Return the element (i, j)
+    Weight& operator()(MatrixIndex i, MatrixIndex j) {
+      ikos_assert_msg(i < this->_num_vars && j < this->_num_vars,
+                      "ouf of bounds matrix access");
+      return this->_matrix[this->_num_vars * i + j];
+    }
+
+    /// \brief Clear the matrix
+    void clear() {
+      this->_num_vars = 0;
+      this->_matrix.clear();
+    }
+
+    /// \brief Clear and resize the matrix
+    void clear_resize(MatrixIndex num_vars) {
+      this->_num_vars = num_vars;
+      this->_matrix.clear();
+      this->_matrix.resize(num_vars * num_vars, dbm_impl::Infinity);
+      for (MatrixIndex i = 0; i < num_vars; i++) {
+        this->operator()(i, i) = 0;
+      }
+    }
+
+    /// \brief Resize the matrix to handle a new variable
+    ///
+    /// \returns the index of the new variable
+    MatrixIndex add_variable() {
+      if (this->_num_vars == 0) {
+        this->clear_resize(2);
+      } else {
+        std::vector< Weight > new_matrix((this->_num_vars + 1) *
+                                             (this->_num_vars + 1),
+                                         dbm_impl::Infinity);
+
+        for (MatrixIndex i = 0; i < this->_num_vars; i++) {
+          for (MatrixIndex j = 0; j < this->_num_vars; j++) {
+            new_matrix[(this->_num_vars + 1) * i + j] =
+                this->_matrix[this->_num_vars * i + j];
+          }
+        }
+
+        std::swap(this->_matrix, new_matrix);
+        this->_num_vars++;
+        this->operator()(this->_num_vars - 1, this->_num_vars - 1) = 0;
+      }
+
+      return this->_num_vars - 1;
+    }
+
+    /// \brief Apply Floyd-Warshall algorithm to normalize the matrix
+    void normalize() {
+      const MatrixIndex n = this->_num_vars;
+
+      for (MatrixIndex i = 0; i < n; i++) {
+        this->_matrix[n * i + i] =
+            std::min(this->_matrix[n * i + i], Weight(0));
+      }
+
+      for (MatrixIndex k = 0; k < n; k++) {
+        for (MatrixIndex i = 0; i < n; i++) {
+          Weight w_i_k = this->_matrix[n * i + k];
+          if (w_i_k == dbm_impl::Infinity) {
+            continue;
+          }
+          for (MatrixIndex j = 0; j < n; j++) {
+            Weight w = dbm_impl::add(w_i_k, this->_matrix[n * k + j]);
+            if (w < this->_matrix[n * i + j]) {
+              this->_matrix[n * i + j] = w;
+            }
+          }
+        }
+      }
+    }
+
+    /// \brief Restore the closure after the element (i, j) was tightened
+    ///
+    /// This runs in O(n^2), instead of O(n^3) for normalize().
+    ///
+    /// Precondition: the matrix was normalized before (i, j) was tightened
+    ///
+    /// \returns false if the matrix has a negative cycle
+    bool close(MatrixIndex i, MatrixIndex j) {
+      const MatrixIndex n = this->_num_vars;
+      const Weight w_i_j = this->_matrix[n * i + j];
+
+      if (dbm_impl::add(w_i_j, this->_matrix[n * j + i]) < 0) {
+        return false;
+      }
+
+      for (MatrixIndex k = 0; k < n; k++) {
+        Weight w_k_j = dbm_impl::add(this->_matrix[n * k + i], w_i_j);
+        if (w_k_j == dbm_impl::Infinity) {
+          continue;
+        }
+        for (MatrixIndex l = 0; l < n; l++) {
+          Weight w = dbm_impl::add(w_k_j, this->_matrix[n * j + l]);
+          if (w < this->_matrix[n * k + l]) {
+            this->_matrix[n * k + l] = w;
+          }
+        }
+      }
+
+      return true;
+    }
+
+    /// \brief Return true if the matrix has a negative cycle
+    bool has_negative_cycle() const {
+      for (MatrixIndex i = 0; i < this->_num_vars; i++) {
+        if (this->operator()(i, i) < 0) {
+          return true;
+        }
+      }
+
+      return false;
+    }
+
+    /// \brief Return true if the matrix only contains +oo
+    bool all_plus_infinity() const {
+      for (MatrixIndex i = 0; i < this->_num_vars; i++) {
+        for (MatrixIndex j = 0; j < this->_num_vars; j++) {
+          if (i != j && this->operator()(i, j) != dbm_impl::Infinity) {
+            return false;
+          }
+        }
+      }
+      return true;
+    }
+
+    /// \brief Return true if all M[i, j] and M[j, i] are +oo, for all j
+    bool all_plus_infinity(MatrixIndex i) const {
+      for (MatrixIndex j = 0; j < this->_num_vars; j++) {
+        if (i == j) {
+          continue;
+        }
+        if (this->operator()(i, j) != dbm_impl::Infinity ||
+            this->operator()(j, i) != dbm_impl::Infinity) {
+          return false;
+        }
+      }
+
+      return true;
+    }
+
+  }; // end class Matrix
+
+private:
+  bool _is_bottom;
+  bool _is_normalized;
+  Matrix _matrix;
+  VarIndexMap _var_index_map;
+
+  // Intervals of the variables that are not in the matrix
+  IntervalDomainT _intervals;
+
+private:
+  struct TopTag {};
+  struct BottomTag {};
+
+  /// \brief Create the top abstract value
+  explicit DBM(TopTag)
+      : _is_bottom(false),
+        _is_normalized(true),
+        _intervals(IntervalDomainT::top()) {}
+
+  /// \brief Create the bottom abstract value
+  explicit DBM(BottomTag)
+      : _is_bottom(true),
+        _is_normalized(true),
+        _intervals(IntervalDomainT::bottom()) {}
+
+public:
+  /// \brief Create the top abstract value
+  DBM() : DBM(TopTag{}) {}
+
+  /// \brief Copy constructor
+  DBM(const DBM&) = default;
+
+  /// \brief Move constructor
+  DBM(DBM&&) = default;
+
+  /// \brief Copy assignment operator
+  DBM& operator=(const DBM&) = default;
+
+  /// \brief Move assignment operator
+  DBM& operator=(DBM&&) = default;
+
+  /// \brief Destructor
+  ~DBM() override = default;
+
+  /// \brief Create the top abstract value
+  static DBM top() { return DBM(TopTag{}); }
+
+  /// \brief Create the bottom abstract value
+  static DBM bottom() { return DBM(BottomTag{}); }
+
+private:
+  /// \brief Return true if the given variable is in the matrix
+  ///
+  /// The values of the variable must fit in a weight.
+  static bool in_matrix(VariableRef x) {
+    unsigned bit_width = VariableTrait::bit_width(x);
+    return bit_width < 64 ||
+           (bit_width == 64 && VariableTrait::sign(x) == Signed);
+  }
+
+  /// \brief Return the smallest value of the type of the given variable
+  static Weight type_min(VariableRef x) {
+    return MachineInt::min(VariableTrait::bit_width(x), VariableTrait::sign(x))
+        .template to< Weight >();
+  }
+
+  /// \brief Return the largest value of the type of the given variable
+  static Weight type_max(VariableRef x) {
+    return MachineInt::max(VariableTrait::bit_width(x), VariableTrait::sign(x))
+        .template to< Weight >();
+  }
+
+  /// \brief Return the interval of the variable x at index i
+  Interval interval(VariableRef x, MatrixIndex i) const {
+    unsigned bit_width = VariableTrait::bit_width(x);
+    Signedness sign = VariableTrait::sign(x);
+    Weight lb = type_min(x);
+    Weight ub = type_max(x);
+
+    if (this->_matrix(i, 0) != dbm_impl::Infinity) {
+      lb = std::max(lb, -this->_matrix(i, 0));
+    }
+    if (this->_matrix(0, i) != dbm_impl::Infinity) {
+      ub = std::min(ub, this->_matrix(0, i));
+    }
+
+    if (lb > ub) {
+      return Interval::bottom(bit_width, sign);
+    } else {
+      return Interval(MachineInt(lb, bit_width, sign),
+                      MachineInt(ub, bit_width, sign));
+    }
+  }
+
+  /// \brief Return false if a variable has no value within its type
+  bool check_bounds() const {
+    for (const auto& p : this->_var_index_map) {
+      if ((this->_matrix(p.second, 0) != dbm_impl::Infinity &&
+           -this->_matrix(p.second, 0) > type_max(p.first)) ||
+          (this->_matrix(0, p.second) != dbm_impl::Infinity &&
+           this->_matrix(0, p.second) < type_min(p.first))) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+public:
+  /// \brief Normalize the difference bound matrix
+  void normalize() const override {
+    if (this->_is_normalized) {
+      return;
+    }
+
+    auto self = const_cast< DBM* >(this);
+
+    if (this->_is_bottom) {
+      self->_is_normalized = true;
+      return;
+    }
+
+    // Floyd-Warshall algorithm
+    self->_matrix.normalize();
+
+    // Check for negative cycle
+    if (this->_matrix.has_negative_cycle() || !this->check_bounds()) {
+      self->set_to_bottom();
+      return;
+    }
+
+    self->_is_normalized = true;
+  }
+
+  bool is_bottom() const override {
+    this->normalize();
+    return this->_is_bottom || this->_intervals.is_bottom();
+  }
+
+  bool is_top() const override {
+    // Does not require normalization
+
+    if (this->_is_bottom) {
+      return false;
+    }
+
+    return this->_matrix.all_plus_infinity() && this->_intervals.is_top();
+  }
+
+  void set_to_bottom() override {
+    this->_is_bottom = true;
+    this->_is_normalized = true;
+    this->_matrix.clear();
+    this->_var_index_map.clear();
+    this->_intervals.set_to_bottom();
+  }
+
+  void set_to_top() override {
+    this->_is_bottom = false;
+    this->_is_normalized = true;
+    this->_matrix.clear();
+    this->_var_index_map.clear();
+    this->_intervals.set_to_top();
+  }
+
+  bool leq(const DBM& other) const override {
+    if (this->is_bottom()) {
+      return true;
+    } else if (other.is_bottom()) {
+      return false;
+    }
+
+    std::vector< std::pair< MatrixIndex, MatrixIndex > > vars;
+    vars.reserve(this->_var_index_map.size());
+
+    // Iterate over this->_var_index_map and other._var_index_map in parallel
+    // This is possible because var_index_map is sorted.
+    for (auto l = this->_var_index_map.begin(),
+              r = other._var_index_map.begin();
+         r != other._var_index_map.end();) {
+      if (l == this->_var_index_map.end() || r->first < l->first) {
+        // Variable in `other` but not in `this`
+        if (!other._matrix.all_plus_infinity(r->second)) {
+          return false;
+        }
+        ++r;
+      } else if (l->first < r->first) {
+        // Variable in `this` but not in `other`, this is fine.
+        ++l;
+      } else {
+        vars.emplace_back(l->second, r->second);
+        ++l;
+        ++r;
+      }
+    }
+
+    // Check if this->_matrix(i, j) <= other._matrix(i, j)
+    for (const auto& i : vars) {
+      // special variable 0
+      if (this->_matrix(i.first, 0) > other._matrix(i.second, 0) ||
+          this->_matrix(0, i.first) > other._matrix(0, i.second)) {
+        return false;
+      }
+
+      for (const auto& j : vars) {
+        if (this->_matrix(i.first, j.first) >
+            other._matrix(i.second, j.second)) {
+          return false;
+        }
+      }
+    }
+
+    return this->_intervals.leq(other._intervals);
+  }
+
+  bool equals(const DBM& other) const override {
+    return this->leq(other) && other.leq(*this);
+  }
+
+private:
+  /// \brief Apply a pointwise binary operator on the matrices
+  template < typename BinaryOperator >
+  DBM pointwise_binary_op(const DBM& other, const BinaryOperator& op) const {
+    DBM dbm; // result dbm
+
+    // marker for an invalid index
+    const MatrixIndex none = std::numeric_limits< MatrixIndex >::max();
+
+    // Build index map
+    MatrixIndex next_index = 1;
+    std::vector< std::pair< MatrixIndex, MatrixIndex > > vars;
+    vars.reserve(this->_var_index_map.size());
+
+    for (auto l = this->_var_index_map.begin(),
+              r = other._var_index_map.begin();
+         l != this->_var_index_map.end() || r != other._var_index_map.end();) {
+      if (l == this->_var_index_map.end() ||
+          (r != other._var_index_map.end() && r->first < l->first)) {
+        // Variable in `other` but not in `this`
+        if (op.meet_semantic()) {
+          dbm._var_index_map.emplace_hint(dbm._var_index_map.end(),
+                                          r->first,
+                                          next_index++);
+          vars.emplace_back(none, r->second);
+        }
+        ++r;
+      } else if (r == other._var_index_map.end() ||
+                 (l != this->_var_index_map.end() && l->first < r->first)) {
+        // Variable in `this` but not in `other`
+        if (op.meet_semantic()) {
+          dbm._var_index_map.emplace_hint(dbm._var_index_map.end(),
+                                          l->first,
+                                          next_index++);
+          vars.emplace_back(l->second, none);
+        }
+        l++;
+      } else {
+        ikos_assert(l->first == r->first);
+        dbm._var_index_map.emplace_hint(dbm._var_index_map.end(),
+                                        l->first,
+                                        next_index++);
+        vars.emplace_back(l->second, r->second);
+        l++;
+        r++;
+      }
+    }
+
+    // Allocate memory for the result matrix
+    dbm._matrix.clear_resize(static_cast< MatrixIndex >(vars.size() + 1));
+
+    // Compute the result matrix
+    for (std::size_t i_index = 0; i_index < vars.size(); ++i_index) {
+      const auto& i = vars[i_index];
+      const auto i_res = static_cast< MatrixIndex >(i_index + 1);
+
+      if (op.meet_semantic() && i.second == none) {
+        dbm._matrix(i_res, 0) = this->_matrix(i.first, 0);
+        dbm._matrix(0, i_res) = this->_matrix(0, i.first);
+      } else if (op.meet_semantic() && i.first == none) {
+        dbm._matrix(i_res, 0) = other._matrix(i.second, 0);
+        dbm._matrix(0, i_res) = other._matrix(0, i.second);
+      } else {
+        dbm._matrix(i_res, 0) =
+            op(this->_matrix(i.first, 0), other._matrix(i.second, 0));
+        dbm._matrix(0, i_res) =
+            op(this->_matrix(0, i.first), other._matrix(0, i.second));
+      }
+
+      for (std::size_t j_index = 0; j_index < vars.size(); ++j_index) {
+        const auto& j = vars[j_index];
+        const auto j_res = static_cast< MatrixIndex >(j_index + 1);
+
+        if (i_res == j_res) {
+          continue;
+        } else if (op.meet_semantic() && (i.first == none || j.first == none) &&
+                   (i.second == none || j.second == none)) {
+          continue;
+        } else if (op.meet_semantic() &&
+                   (i.second == none || j.second == none)) {
+          dbm._matrix(i_res, j_res) = this->_matrix(i.first, j.first);
+        } else if (op.meet_semantic() && (i.first == none || j.first == none)) {
+          dbm._matrix(i_res, j_res) = other._matrix(i.second, j.second);
+        } else {
+          dbm._matrix(i_res, j_res) = op(this->_matrix(i.first, j.first),
+                                         other._matrix(i.second, j.second));
+        }
+      }
+    }
+
+    dbm._is_normalized = false;
+    return dbm;
+  }
+
+  struct JoinOperator {
+    bool meet_semantic() const { return false; }
+
+    Weight operator()(Weight x, Weight y) const { return std::max(x, y); }
+  };
+
+  struct WideningOperator {
+    bool meet_semantic() const { return false; }
+
+    Weight operator()(Weight x, Weight y) const {
+      if (y <= x) {
+        return x;
+      } else {
+        return dbm_impl::Infinity;
+      }
+    }
+  };
+
+  struct WideningThresholdOperator {
+    Weight threshold;
+
+    explicit WideningThresholdOperator(Weight threshold_)
+        : threshold(threshold_) {}
+
+    bool meet_semantic() const { return false; }
+
+    Weight operator()(Weight x, Weight y) const {
+      if (y <= x) {
+        return x;
+      } else if (threshold >= y) {
+        return threshold;
+      } else {
+        return dbm_impl::Infinity;
+      }
+    }
+  };
+
+  struct MeetOperator {
+    bool meet_semantic() const { return true; }
+
+    Weight operator()(Weight x, Weight y) const { return std::min(x, y); }
+  };
+
+  struct NarrowingOperator {
+    bool meet_semantic() const { return true; }
+
+    Weight operator()(Weight x, Weight y) const {
+      if (x == dbm_impl::Infinity) {
+        return y;
+      } else {
+        return x;
+      }
+    }
+  };
+
+public:
+  void join_with(const DBM& other) override {
+    if (this->is_bottom()) {
+      this->operator=(other);
+    } else if (other.is_bottom()) {
+      return;
+    } else {
+      DBM dbm = this->pointwise_binary_op(other, JoinOperator{});
+      dbm._is_normalized = true; // The join is normalized by construction
+      dbm._intervals = this->_intervals.join(other._intervals);
+      this->operator=(std::move(dbm));
+    }
+  }
+
+private:
+  /// \brief Perform the widening of the matrices with the given operator
+  template < typename BinaryOperator >
+  void widen_matrix_with(const DBM& other, const BinaryOperator& op) {
+    // Requires the normalization of the right operand.
+    // The left operand (this) should not be normalized.
+    if (this->_is_bottom || this->_intervals.is_bottom()) {
+      this->operator=(other);
+    } else if (other.is_bottom()) {
+      return;
+    } else {
+      DBM dbm = this->pointwise_binary_op(other, op);
+      dbm._intervals = this->_intervals;
+      this->operator=(std::move(dbm));
+    }
+  }
+
+public:
+  void widen_with(const DBM& other) override {
+    this->widen_matrix_with(other, WideningOperator{});
+    this->_intervals.widen_with(other._intervals);
+  }
+
+  void widen_threshold_with(const DBM& other,
+                            const MachineInt& threshold) override {
+    if (threshold.fits< Weight >()) {
+      this->widen_matrix_with(other,
+                              WideningThresholdOperator{
+                                  threshold.to< Weight >()});
+    } else {
+      this->widen_matrix_with(other, WideningOperator{});
+    }
+    this->_intervals.widen_threshold_with(other._intervals, threshold);
+  }
+
+  void meet_with(const DBM& other) override {
+    if (this->is_bottom()) {
+      return;
+    } else if (other.is_bottom()) {
+      this->set_to_bottom();
+    } else {
+      DBM dbm = this->pointwise_binary_op(other, MeetOperator{});
+      dbm._intervals = this->_intervals.meet(other._intervals);
+      this->operator=(std::move(dbm));
+    }
+  }
+
+  void narrow_with(const DBM& other) override {
+    if (this->is_bottom()) {
+      return;
+    } else if (other.is_bottom()) {
+      this->set_to_bottom();
+    } else {
+      DBM dbm = this->pointwise_binary_op(other, NarrowingOperator{});
+      dbm._intervals = this->_intervals.narrowing(other._intervals);
+      this->operator=(std::move(dbm));
+    }
+  }
+
+private:
+  /// \brief Get the index of variable x in _matrix
+  ///
+  /// Create a new one if not found
+  MatrixIndex var_index(VariableRef x) {
+    ikos_assert(in_matrix(x));
+
+    if (this->_matrix.num_vars() == 0) {
+      MatrixIndex i = this->_matrix.add_variable();
+      this->_var_index_map.emplace(x, i);
+      return i;
+    }
+
+    auto it = this->_var_index_map.find(x);
+    if (it == this->_var_index_map.end()) {
+      // look for an unused index in _matrix
+      std::vector< bool > is_used(this->_matrix.num_vars(), false);
+
+      is_used[0] = true;
+      for (const auto& p : this->_var_index_map) {
+        is_used[p.second] = true;
+      }
+
+      auto unused_index = std::find(is_used.begin(), is_used.end(), false);
+      if (unused_index == is_used.end()) {
+        // no unused index found, we resize the matrix
+        MatrixIndex i = this->_matrix.add_variable();
+        this->_var_index_map.emplace(x, i);
+        return i;
+      } else {
+        MatrixIndex i = static_cast< MatrixIndex >(
+            std::distance(is_used.begin(), unused_index));
+        this->_var_index_map.emplace(x, i);
+        return i;
+      }
+    } else {
+      return it->second;
+    }
+  }
+
+  /// \brief Add constraint v_i - v_j <= c
+  ///
+  /// If the matrix is normalized, it stays normalized.
+  void add_constraint(MatrixIndex i, MatrixIndex j, Weight c) {
+    if (this->_is_bottom || c >= this->_matrix(j, i)) {
+      return;
+    }
+
+    this->_matrix(j, i) = c;
+
+    if (this->_is_normalized &&
+        (!this->_matrix.close(j, i) || !this->check_bounds())) {
+      this->set_to_bottom();
+    }
+  }
+
+  /// \brief Apply v_i = v_i + c
+  void increment(MatrixIndex i, Weight c) {
+    if (c == 0) {
+      return;
+    }
+
+    for (MatrixIndex j = 0; j < this->_matrix.num_vars(); j++) {
+      if (i != j) {
+        this->_matrix(i, j) = dbm_impl::add(this->_matrix(i, j), -c);
+        this->_matrix(j, i) = dbm_impl::add(this->_matrix(j, i), c);
+      }
+    }
+  }
+
+  /// \brief Forget all informations about variable k
+  void forget(MatrixIndex k) {
+    // Use informations about k to improve all constraints
+    // Not necessary if already normalized
+    if (!this->_is_normalized) {
+      for (MatrixIndex i = 0; i < this->_matrix.num_vars(); i++) {
+        Weight w_i_k = this->_matrix(i, k);
+
+        if (dbm_impl::add(w_i_k, this->_matrix(k, i)) < 0) {
+          this->set_to_bottom();
+          return;
+        }
+
+        if (w_i_k == dbm_impl::Infinity) {
+          continue;
+        }
+
+        for (MatrixIndex j = 0; j < this->_matrix.num_vars(); j++) {
+          if (i != k && j != k && i != j) {
+            this->_matrix(i, j) =
+                std::min(this->_matrix(i, j),
+                         dbm_impl::add(w_i_k, this->_matrix(k, j)));
+          }
+        }
+      }
+    }
+
+    for (MatrixIndex i = 0; i < this->_matrix.num_vars(); i++) {
+      this->_matrix(i, k) = dbm_impl::Infinity;
+      this->_matrix(k, i) = dbm_impl::Infinity;
+    }
+    this->_matrix(k, k) = 0;
+  }
+
+  /// \brief Refine the value of the variable at index i with an interval
+  void refine(MatrixIndex i, const Interval& value) {
+    if (!value.ub().is_max()) {
+      this->add_constraint(i, 0, value.ub().to< Weight >());
+    }
+    if (!value.lb().is_min()) {
+      this->add_constraint(0, i, -value.lb().to< Weight >());
+    }
+  }
+
+  /// \brief Assign `x = y + c`, where c is an integer
+  ///
+  /// The result wraps around the type of `x`. The relation between `x` and `y`
+  /// is kept if all the values of `y` wrap the same way.
+  ///
+  /// \returns false if the relation cannot be kept
+  bool assign_offset(VariableRef x,
+                     VariableRef y,
+                     const ZNumber& c,
+                     bool allow_wrap) {
+    if (!in_matrix(x) || !in_matrix(y)) {
+      return false;
+    }
+
+    Interval v_y = this->to_interval(y);
+    if (v_y.is_bottom()) {
+      return true;
+    }
+
+    unsigned bit_width = VariableTrait::bit_width(x);
+    Signedness sign = VariableTrait::sign(x);
+
+    // Compute the wrap around of the lower bound
+    ZNumber lb = v_y.lb().to_z_number() + c;
+    ZNumber ub = v_y.ub().to_z_number() + c;
+    ZNumber delta = MachineInt(lb, bit_width, sign).to_z_number() - lb;
+
+    if (delta != 0 && !allow_wrap) {
+      return false;
+    }
+
+    // Check that the upper bound wraps the same way
+    if (ub + delta > MachineInt::max(bit_width, sign).to_z_number()) {
+      return false;
+    }
+
+    ZNumber k = c + delta;
+    if (!k.fits< Weight >() || k.to< Weight >() < dbm_impl::MinWeight) {
+      return false;
+    }
+
+    Weight w = k.to< Weight >();
+    MatrixIndex i = this->var_index(x);
+    if (x == y) { // x = x + w
+      this->increment(i, w);
+    } else { // x = y + w
+      MatrixIndex j = this->var_index(y);
+      this->forget(i);
+      this->add_constraint(i, j, w);
+      this->add_constraint(j, i, -w);
+    }
+    return true;
+  }
+
+public:
+  void assign(VariableRef x, const MachineInt& n) override {
+    this->set(x, Interval(n));
+  }
+
+  void assign(VariableRef x, VariableRef y) override {
+    if (this->is_bottom()) {
+      return;
+    }
+
+    if (!this->assign_offset(x, y, ZNumber(0), true)) {
+      this->set(x, this->to_interval(y));
+    }
+  }
+
+  void assign(VariableRef x, const LinearExpressionT& e) override {
+    if (this->is_bottom()) {
+      return;
+    }
+
+    if (e.num_terms() == 1 && e.begin()->second == 1) { // x = y + c
+      VariableRef y = e.begin()->first;
+      if (this->assign_offset(x, y, e.constant().to_z_number(), true)) {
+        return;
+      }
+    }
+
+    this->set(x, this->to_interval(e));
+  }
+
+  void apply(UnaryOperator op, VariableRef x, VariableRef y) override {
+    if (this->is_bottom()) {
+      return;
+    }
+
+    // The result is equal to `y`, modulo 2^n where n is the bit-width of `x`
+    if (this->assign_offset(x, y, ZNumber(0), true)) {
+      return;
+    }
+
+    this->set(x,
+              apply_unary_operator(op,
+                                   this->to_interval(y),
+                                   VariableTrait::bit_width(x),
+                                   VariableTrait::sign(x)));
+  }
+
+  void apply(BinaryOperator op,
+             VariableRef x,
+             VariableRef y,
+             VariableRef z) override {
+    if (this->is_bottom()) {
+      return;
+    }
+
+    Interval v_y = this->to_interval(y);
+    Interval v_z = this->to_interval(z);
+
+    if (boost::optional< MachineInt > n = v_z.singleton()) {
+      this->apply(op, x, y, *n);
+    } else if (boost::optional< MachineInt > m = v_y.singleton()) {
+      this->apply(op, x, *m, z);
+    } else {
+      this->set(x, apply_bin_operator(op, v_y, v_z));
+    }
+  }
+
+  void apply(BinaryOperator op,
+             VariableRef x,
+             VariableRef y,
+             const MachineInt& z) override {
+    if (this->is_bottom()) {
+      return;
+    }
+
+    switch (op) {
+      case BinaryOperator::Add:
+      case BinaryOperator::AddNoWrap: {
+        if (this->assign_offset(x,
+                                y,
+                                z.to_z_number(),
+                                op == BinaryOperator::Add)) {
+          return;
+        }
+      } break;
+      case BinaryOperator::Sub:
+      case BinaryOperator::SubNoWrap: {
+        if (this->assign_offset(x,
+                                y,
+                                -z.to_z_number(),
+                                op == BinaryOperator::Sub)) {
+          return;
+        }
+      } break;
+      case BinaryOperator::Mul:
+      case BinaryOperator::MulNoWrap:
+      case BinaryOperator::Div:
+      case BinaryOperator::DivExact: {
+        if (z == 1 && this->assign_offset(x, y, ZNumber(0), true)) {
+          return;
+        }
+      } break;
+      default: {
+        break;
+      }
+    }
+
+    this->set(x, apply_bin_operator(op, this->to_interval(y), Interval(z)));
+  }
+
+  void apply(BinaryOperator op,
+             VariableRef x,
+             const MachineInt& y,
+             VariableRef z) override {
+    if (this->is_bottom()) {
+      return;
+    }
+
+    switch (op) {
+      case BinaryOperator::Add:
+      case BinaryOperator::AddNoWrap: {
+        if (this->assign_offset(x,
+                                z,
+                                y.to_z_number(),
+                                op == BinaryOperator::Add)) {
+          return;
+        }
+      } break;
+      case BinaryOperator::Mul:
+      case BinaryOperator::MulNoWrap: {
+        if (y == 1 && this->assign_offset(x, z, ZNumber(0), true)) {
+          return;
+        }
+      } break;
+      default: {
+        break;
+      }
+    }
+
+    this->set(x, apply_bin_operator(op, Interval(y), this->to_interval(z)));
+  }
+
+  void add(Predicate pred, VariableRef x, VariableRef y) override {
+    if (this->is_bottom()) {
+      return;
+    }
+
+    // Note that x and y have the same type
+    if (!in_matrix(x)) {
+      this->_intervals.add(pred, x, y);
+      return;
+    }
+
+    switch (pred) {
+      case Predicate::EQ: {
+        if (x == y) {
+          return;
+        }
+        MatrixIndex i = this->var_index(x);
+        MatrixIndex j = this->var_index(y);
+        this->add_constraint(i, j, 0);
+        this->add_constraint(j, i, 0);
+      } break;
+      case Predicate::NE: {
+        if (x == y) {
+          this->set_to_bottom();
+          return;
+        }
+        Interval xi = this->to_interval(x);
+        Interval yi = this->to_interval(y);
+        if (xi.singleton()) {
+          this->refine(y, trim_bound(yi, *xi.singleton()));
+        }
+        if (yi.singleton()) {
+          this->refine(x, trim_bound(xi, *yi.singleton()));
+        }
+      } break;
+      case Predicate::GT: {
+        this->add(Predicate::LT, y, x);
+      } break;
+      case Predicate::GE: {
+        this->add(Predicate::LE, y, x);
+      } break;
+      case Predicate::LT: {
+        if (x == y) {
+          this->set_to_bottom();
+          return;
+        }
+        MatrixIndex i = this->var_index(x);
+        MatrixIndex j = this->var_index(y);
+        this->add_constraint(i, j, -1);
+      } break;
+      case Predicate::LE: {
+        if (x == y) {
+          return;
+        }
+        MatrixIndex i = this->var_index(x);
+        MatrixIndex j = this->var_index(y);
+        this->add_constraint(i, j, 0);
+      } break;
+    }
+  }
+
+  void add(Predicate pred, VariableRef x, const MachineInt& y) override {
+    if (this->is_bottom()) {
+      return;
+    }
+
+    if (!in_matrix(x)) {
+      this->_intervals.add(pred, x, y);
+      return;
+    }
+
+    Interval xi = this->to_interval(x);
+    Interval yi(y);
+
+    switch (pred) {
+      case Predicate::EQ: {
+        this->refine(x, yi);
+      } break;
+      case Predicate::NE: {
+        this->refine(x, trim_bound(xi, y));
+      } break;
+      case Predicate::GT: {
+        if (y.is_max()) {
+          this->set_to_bottom();
+          return;
+        }
+        MachineInt int_max = MachineInt::max(xi.bit_width(), xi.sign());
+        MachineInt one(1, xi.bit_width(), xi.sign());
+        this->refine(x, Interval(y + one, int_max));
+      } break;
+      case Predicate::GE: {
+        this->refine(x, yi.upper_half_line());
+      } break;
+      case Predicate::LT: {
+        if (y.is_min()) {
+          this->set_to_bottom();
+          return;
+        }
+        MachineInt int_min = MachineInt::min(xi.bit_width(), xi.sign());
+        MachineInt one(1, xi.bit_width(), xi.sign());
+        this->refine(x, Interval(int_min, y - one));
+      } break;
+      case Predicate::LE: {
+        this->refine(x, yi.lower_half_line());
+      } break;
+    }
+  }
+
+  void add(Predicate pred, const MachineInt& x, VariableRef y) override {
+    Parent::add(pred, x, y);
+  }
+
+  void set(VariableRef x, const Interval& value) override {
+    if (this->is_bottom()) {
+      return;
+    } else if (value.is_bottom()) {
+      this->set_to_bottom();
+    } else if (!in_matrix(x)) {
+      this->_intervals.set(x, value);
+    } else {
+      MatrixIndex i = this->var_index(x);
+      this->forget(i);
+      this->refine(i, value);
+    }
+  }
+
+  void set(VariableRef x, const Congruence& value) override {
+    if (this->is_bottom()) {
+      return;
+    } else if (value.is_bottom()) {
+      this->set_to_bottom();
+    } else {
+      boost::optional< MachineInt > n = value.singleton();
+      if (n) {
+        this->set(x, Interval(*n));
+      } else {
+        this->forget(x);
+      }
+    }
+  }
+
+  void set(VariableRef x, const IntervalCongruence& value) override {
+    this->set(x, value.interval());
+  }
+
+  void refine(VariableRef x, const Interval& value) override {
+    if (this->is_bottom()) {
+      return;
+    } else if (value.is_bottom()) {
+      this->set_to_bottom();
+    } else if (!in_matrix(x)) {
+      this->_intervals.refine(x, value);
+    } else {
+      this->refine(this->var_index(x), value);
+    }
+  }
+
+  void refine(VariableRef x, const Congruence& value) override {
+    if (this->is_bottom()) {
+      return;
+    } else if (value.is_bottom()) {
+      this->set_to_bottom();
+    } else {
+      IntervalCongruence iv(this->to_interval(x), value);
+      this->refine(x, iv.interval());
+    }
+  }
+
+  void refine(VariableRef x, const IntervalCongruence& value) override {
+    if (this->is_bottom()) {
+      return;
+    } else if (value.is_bottom()) {
+      this->set_to_bottom();
+    } else {
+      IntervalCongruence iv =
+          IntervalCongruence(this->to_interval(x)).meet(value);
+      this->refine(x, iv.interval());
+    }
+  }
+
+  void forget(VariableRef x) override {
+    if (this->_is_bottom) {
+      return;
+    }
+
+    if (!in_matrix(x)) {
+      this->_intervals.forget(x);
+      return;
+    }
+
+    auto it = this->_var_index_map.find(x);
+    if (it != this->_var_index_map.end()) {
+      this->forget(it->second);
+      this->_var_index_map.erase(x);
+    }
+  }
+
+  Interval to_interval(VariableRef x) const override {
+    if (this->is_bottom()) {
+      return Interval::bottom(VariableTrait::bit_width(x),
+                              VariableTrait::sign(x));
+    } else if (!in_matrix(x)) {
+      return this->_intervals.to_interval(x);
+    }
+
+    auto it = this->_var_index_map.find(x);
+    if (it == this->_var_index_map.end()) {
+      return Interval::top(VariableTrait::bit_width(x), VariableTrait::sign(x));
+    } else {
+      return this->interval(x, it->second);
+    }
+  }
+
+  Interval to_interval(const LinearExpressionT& e) const override {
+    // Result type
+    unsigned bit_width = e.constant().bit_width();
+    Signedness sign = e.constant().sign();
+
+    if (this->is_bottom()) {
+      return Interval::bottom(bit_width, sign);
+    }
+
+    Interval r(e.constant());
+    for (const auto& term : e) {
+      r = machine_int::add(r,
+                           machine_int::mul(Interval(term.second),
+                                            this->to_interval(term.first)
+                                                .cast(bit_width, sign)));
+    }
+    return r;
+  }
+
+  Congruence to_congruence(VariableRef x) const override {
+    return this->to_interval_congruence(x).congruence();
+  }
+
+  Congruence to_congruence(const LinearExpressionT& e) const override {
+    return this->to_interval_congruence(e).congruence();
+  }
+
+  IntervalCongruence to_interval_congruence(VariableRef x) const override {
+    return IntervalCongruence(this->to_interval(x));
+  }
+
+  IntervalCongruence to_interval_congruence(
+      const LinearExpressionT& e) const override {
+    // Result type
+    unsigned bit_width = e.constant().bit_width();
+    Signedness sign = e.constant().sign();
+
+    if (this->is_bottom()) {
+      return IntervalCongruence::bottom(bit_width, sign);
+    }
+
+    IntervalCongruence r(e.constant());
+    for (const auto& term : e) {
+      r = machine_int::add(r,
+                           machine_int::mul(IntervalCongruence(term.second),
+                                            IntervalCongruence(
+                                                this->to_interval(term.first)
+                                                    .cast(bit_width, sign))));
+    }
+    return r;
+  }
+
+  void dump(std::ostream& o) const override {
+    if (this->is_bottom()) {
+      o << "⊥";
+      return;
+    }
+
+    o << "{";
+    bool first = true;
+    for (auto it = this->_var_index_map.begin(),
+              et = this->_var_index_map.end();
+         it != et;
+         ++it) {
+      if (!first) {
+        o << "; ";
+      }
+      first = false;
+      DumpableTraits< VariableRef >::dump(o, it->first);
+      o << " -> " << this->interval(it->first, it->second);
+
+      for (auto it2 = this->_var_index_map.begin(); it2 != et; ++it2) {
+        Weight w = this->_matrix(it2->second, it->second);
+        if (it != it2 && w != dbm_impl::Infinity) {
+          o << "; ";
+          DumpableTraits< VariableRef >::dump(o, it->first);
+          o << " - ";
+          DumpableTraits< VariableRef >::dump(o, it2->first);
+          o << " <= " << w;
+        }
+      }
+    }
+    for (const auto& p : this->_intervals) {
+      if (!first) {
+        o << "; ";
+      }
+      first = false;
+      DumpableTraits< VariableRef >::dump(o, p.first);
+      o << " -> " << p.second;
+    }
+    o << "}";
+  }
+
+  static std::string name() { return "machine integer dbm"; }
+
+}; // end class DBM
+
+} // end namespace machine_int
+} // end namespace core
+} // end namespace ikos
@@ -47,7 +47,10 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <type_traits>
 
 #include <ikos/core/domain/machine_int/abstract_domain.hpp>
 #include <ikos/core/support/assert.hpp>
@@ -62,6 +65,16 @@ namespace machine_int {
 /// The PolymorphicDomain is a machine integer abstract domain whose behavior
 /// depends on the abstract domain it is constructed with. It allows the use of
 /// different abstract domains at runtime.
+///
+/// Abstract values are shared between copies. A value that has been shared
+/// once is never written again: each holder clones it on its first write, even
+/// if the other copies are gone, since copies might live in other threads.
+///
+/// The underlying abstract domain might normalize its value in const methods.
+/// A value is thus normalized when it is shared for the first time, before any
+/// copy can read it. Concurrent copies of the same object synchronize on a
+/// once flag, so that the normalization happens exactly once. Shared values
+/// are then only read.
 template < typename VariableRef >
 class PolymorphicDomain final
     : public machine_int::AbstractDomain< VariableRef,
@@ -96,8 +109,14 @@ private:
     /// \brief Destructor
     virtual ~PolymorphicBase() = default;
 
+    /// \brief True if the abstract value has been shared between copies
+    mutable std::atomic< bool > shared{false};
+
+    /// \brief Flag to normalize the abstract value once, before sharing it
+    mutable std::once_flag share_once;
+
     /// \brief Clone the abstract value
-    virtual std::unique_ptr< PolymorphicBase > clone() const = 0;
+    virtual std::shared_ptr< PolymorphicBase > clone() const = 0;
 
     /// \brief Check if the abstract value is bottom
     virtual bool is_bottom() const = 0;
@@ -265,8 +284,8 @@ private:
     ~PolymorphicDerived() override = default;
 
     /// \brief Clone the abstract value
-    std::unique_ptr< PolymorphicBase > clone() const override {
-      return std::make_unique< PolymorphicDerivedT >(this->_inv);
+    std::shared_ptr< PolymorphicBase > clone() const override {
+      return std::make_shared< PolymorphicDerivedT >(this->_inv);
     }
 
     /// \brief Check if the abstract value is bottom
@@ -517,7 +536,9 @@ private:
 
 private:
   /// \brief Pointer on the polymorphic base class, or nullptr (for bottom)
-  std::unique_ptr< PolymorphicBase > _ptr;
+  ///
+  /// The abstract value might be shared with other copies.
+  std::shared_ptr< PolymorphicBase > _ptr;
 
 private:
   struct BottomTag {};
@@ -525,6 +546,34 @@ private:
   /// \brief Create the bottom abstract value
   explicit PolymorphicDomain(BottomTag) : _ptr(nullptr) {}
 
+  /// \brief Return the abstract value to share it with a copy
+  ///
+  /// The first time a value is shared, it is normalized. Threads copying the
+  /// same object concurrently wait until the normalization is done.
+  std::shared_ptr< PolymorphicBase > share() const {
+    if (this->_ptr != nullptr &&
+        !this->_ptr->shared.load(std::memory_order_acquire)) {
+      const PolymorphicBase& base = *this->_ptr;
+      std::call_once(base.share_once, [&base] {
+        base.normalize();
+        base.shared.store(true, std::memory_order_release);
+      });
+    }
+    return this->_ptr;
+  }
+
+  /// \brief Apply the write `f` on the abstract value
+  ///
+  /// The abstract value is cloned first if it has been shared.
+  template < typename Function >
+  void write(Function f) {
+    ikos_assert(this->_ptr != nullptr);
+    if (this->_ptr->shared.load(std::memory_order_acquire)) {
+      this->_ptr = this->_ptr->clone();
+    }
+    f(*this->_ptr);
+  }
+
 public:
   /// \brief Create the top abstract value
   PolymorphicDomain() {
@@ -532,26 +581,24 @@ public:
   }
 
   /// \brief Create a polymorphic domain with the given abstract value
-  template < typename RuntimeDomain >
+  template < typename RuntimeDomain,
+             typename = std::enable_if_t<
+                 !std::is_same< remove_cvref_t< RuntimeDomain >,
+                                PolymorphicDomain >::value > >
   explicit PolymorphicDomain(RuntimeDomain&& inv)
-      : _ptr(std::make_unique<
+      : _ptr(std::make_shared<
              PolymorphicDerived< remove_cvref_t< RuntimeDomain > > >(
             std::forward< RuntimeDomain >(inv))) {}
 
   /// \brief Copy constructor
-  PolymorphicDomain(const PolymorphicDomain& other)
-      : _ptr((other._ptr != nullptr) ? other._ptr->clone() : nullptr) {}
+  PolymorphicDomain(const PolymorphicDomain& other) : _ptr(other.share()) {}
 
   /// \brief Move constructor
   PolymorphicDomain(PolymorphicDomain&&) noexcept = default;
 
   /// \brief Copy assignment operator
   PolymorphicDomain& operator=(const PolymorphicDomain& other) {
-    if (other._ptr != nullptr) {
-      this->_ptr = other._ptr->clone();
-    } else {
-      this->_ptr = nullptr;
-    }
+    this->_ptr = other.share();
     return *this;
   }
 
@@ -587,7 +634,7 @@ public:
 
   void set_to_bottom() override {
     if (this->_ptr != nullptr) {
-      this->_ptr->set_to_bottom();
+      this->write([&](PolymorphicBase& inv) { inv.set_to_bottom(); });
     } else {
       // no-op
     }
@@ -595,7 +642,7 @@ public:
 
   void set_to_top() override {
     if (this->_ptr != nullptr) {
-      this->_ptr->set_to_top();
+      this->write([&](PolymorphicBase& inv) { inv.set_to_top(); });
     } else {
       ikos_unreachable("cannot set bottom to top for PolymorphicDomain");
     }
@@ -606,6 +653,8 @@ public:
       return true;
     } else if (other._ptr == nullptr) {
       return this->_ptr->is_bottom();
+    } else if (this->_ptr == other._ptr) {
+      return true;
     } else {
       return this->_ptr->leq(*other._ptr);
     }
@@ -616,6 +665,8 @@ public:
       return other.is_bottom();
     } else if (other._ptr == nullptr) {
       return this->is_bottom();
+    } else if (this->_ptr == other._ptr) {
+      return true;
     } else {
       return this->_ptr->equals(*other._ptr);
     }
@@ -626,8 +677,10 @@ public:
       return;
     } else if (this->_ptr == nullptr) {
       this->operator=(other);
+    } else if (this->_ptr == other._ptr) {
+      return;
     } else {
-      this->_ptr->join_with(*other._ptr);
+      this->write([&](PolymorphicBase& inv) { inv.join_with(*other._ptr); });
     }
   }
 
@@ -636,8 +689,11 @@ public:
       return;
     } else if (this->_ptr == nullptr) {
       this->operator=(other);
+    } else if (this->_ptr == other._ptr) {
+      return;
     } else {
-      this->_ptr->join_loop_with(*other._ptr);
+      this->write(
+          [&](PolymorphicBase& inv) { inv.join_loop_with(*other._ptr); });
     }
   }
 
@@ -646,8 +702,11 @@ public:
       return;
     } else if (this->_ptr == nullptr) {
       this->operator=(other);
+    } else if (this->_ptr == other._ptr) {
+      return;
     } else {
-      this->_ptr->join_iter_with(*other._ptr);
+      this->write(
+          [&](PolymorphicBase& inv) { inv.join_iter_with(*other._ptr); });
     }
   }
 
@@ -656,8 +715,10 @@ public:
       return;
     } else if (this->_ptr == nullptr) {
       this->operator=(other);
+    } else if (this->_ptr == other._ptr) {
+      return;
     } else {
-      this->_ptr->widen_with(*other._ptr);
+      this->write([&](PolymorphicBase& inv) { inv.widen_with(*other._ptr); });
     }
   }
 
@@ -667,8 +728,12 @@ public:
       return;
     } else if (this->_ptr == nullptr) {
       this->operator=(other);
+    } else if (this->_ptr == other._ptr) {
+      return;
     } else {
-      this->_ptr->widen_threshold_with(*other._ptr, threshold);
+      this->write([&](PolymorphicBase& inv) {
+        inv.widen_threshold_with(*other._ptr, threshold);
+      });
     }
   }
 
@@ -676,9 +741,11 @@ public:
     if (this->_ptr == nullptr) {
       return;
     } else if (other._ptr == nullptr) {
-      this->_ptr->set_to_bottom();
+      this->write([&](PolymorphicBase& inv) { inv.set_to_bottom(); });
+    } else if (this->_ptr == other._ptr) {
+      return;
     } else {
-      this->_ptr->meet_with(*other._ptr);
+      this->write([&](PolymorphicBase& inv) { inv.meet_with(*other._ptr); });
     }
   }
 
@@ -686,9 +753,11 @@ public:
     if (this->_ptr == nullptr) {
       return;
     } else if (other._ptr == nullptr) {
-      this->_ptr->set_to_bottom();
+      this->write([&](PolymorphicBase& inv) { inv.set_to_bottom(); });
+    } else if (this->_ptr == other._ptr) {
+      return;
     } else {
-      this->_ptr->narrow_with(*other._ptr);
+      this->write([&](PolymorphicBase& inv) { inv.narrow_with(*other._ptr); });
     }
   }
 
@@ -697,25 +766,25 @@ public:
 
   void assign(VariableRef x, const MachineInt& n) override {
     if (this->_ptr != nullptr) {
-      this->_ptr->assign(x, n);
+      this->write([&](PolymorphicBase& inv) { inv.assign(x, n); });
     }
   }
 
   void assign(VariableRef x, VariableRef y) override {
     if (this->_ptr != nullptr) {
-      this->_ptr->assign(x, y);
+      this->write([&](PolymorphicBase& inv) { inv.assign(x, y); });
     }
   }
 
   void assign(VariableRef x, const LinearExpressionT& e) override {
     if (this->_ptr != nullptr) {
-      this->_ptr->assign(x, e);
+      this->write([&](PolymorphicBase& inv) { inv.assign(x, e); });
     }
   }
 
   void apply(UnaryOperator op, VariableRef x, VariableRef y) override {
     if (this->_ptr != nullptr) {
-      this->_ptr->apply(op, x, y);
+      this->write([&](PolymorphicBase& inv) { inv.apply(op, x, y); });
     }
   }
 
@@ -724,7 +793,7 @@ public:
              VariableRef y,
              VariableRef z) override {
     if (this->_ptr != nullptr) {
-      this->_ptr->apply(op, x, y, z);
+      this->write([&](PolymorphicBase& inv) { inv.apply(op, x, y, z); });
     }
   }
 
@@ -733,7 +802,7 @@ public:
              VariableRef y,
              const MachineInt& z) override {
     if (this->_ptr != nullptr) {
-      this->_ptr->apply(op, x, y, z);
+      this->write([&](PolymorphicBase& inv) { inv.apply(op, x, y, z); });
     }
   }
 
@@ -742,67 +811,67 @@ public:
              const MachineInt& y,
              VariableRef z) override {
     if (this->_ptr != nullptr) {
-      this->_ptr->apply(op, x, y, z);
+      this->write([&](PolymorphicBase& inv) { inv.apply(op, x, y, z); });
     }
   }
 
   void add(Predicate pred, VariableRef x, VariableRef y) override {
     if (this->_ptr != nullptr) {
-      this->_ptr->add(pred, x, y);
+      this->write([&](PolymorphicBase& inv) { inv.add(pred, x, y); });
     }
   }
 
   void add(Predicate pred, VariableRef x, const MachineInt& y) override {
     if (this->_ptr != nullptr) {
-      this->_ptr->add(pred, x, y);
+      this->write([&](PolymorphicBase& inv) { inv.add(pred, x, y); });
     }
   }
 
   void add(Predicate pred, const MachineInt& x, VariableRef y) override {
     if (this->_ptr != nullptr) {
-      this->_ptr->add(pred, x, y);
+      this->write([&](PolymorphicBase& inv) { inv.add(pred, x, y); });
     }
   }
 
   void set(VariableRef x, const Interval& value) override {
     if (this->_ptr != nullptr) {
-      this->_ptr->set(x, value);
+      this->write([&](PolymorphicBase& inv) { inv.set(x, value); });
     }
   }
 
   void set(VariableRef x, const Congruence& value) override {
     if (this->_ptr != nullptr) {
-      this->_ptr->set(x, value);
+      this->write([&](PolymorphicBase& inv) { inv.set(x, value); });
     }
   }
 
   void set(VariableRef x, const IntervalCongruence& value) override {
     if (this->_ptr != nullptr) {
-      this->_ptr->set(x, value);
+      this->write([&](PolymorphicBase& inv) { inv.set(x, value); });
     }
   }
 
   void refine(VariableRef x, const Interval& value) override {
     if (this->_ptr != nullptr) {
-      this->_ptr->refine(x, value);
+      this->write([&](PolymorphicBase& inv) { inv.refine(x, value); });
     }
   }
 
   void refine(VariableRef x, const Congruence& value) override {
     if (this->_ptr != nullptr) {
-      this->_ptr->refine(x, value);
+      this->write([&](PolymorphicBase& inv) { inv.refine(x, value); });
     }
   }
 
   void refine(VariableRef x, const IntervalCongruence& value) override {
     if (this->_ptr != nullptr) {
-      this->_ptr->refine(x, value);
+      this->write([&](PolymorphicBase& inv) { inv.refine(x, value); });
     }
   }
 
   void forget(VariableRef x) override {
     if (this->_ptr != nullptr) {
-      this->_ptr->forget(x);
+      this->write([&](PolymorphicBase& inv) { inv.forget(x); });
     }
   }
 
@@ -871,31 +940,31 @@ public:
 
   void mark_counter(VariableRef x) override {
     if (this->_ptr != nullptr) {
-      this->_ptr->mark_counter(x);
+      this->write([&](PolymorphicBase& inv) { inv.mark_counter(x); });
     }
   }
 
   void unmark_counter(VariableRef x) override {
     if (this->_ptr != nullptr) {
-      this->_ptr->unmark_counter(x);
+      this->write([&](PolymorphicBase& inv) { inv.unmark_counter(x); });
     }
   }
 
   void init_counter(VariableRef x, const MachineInt& c) override {
     if (this->_ptr != nullptr) {
-      this->_ptr->init_counter(x, c);
+      this->write([&](PolymorphicBase& inv) { inv.init_counter(x, c); });
     }
   }
 
   void incr_counter(VariableRef x, const MachineInt& k) override {
     if (this->_ptr != nullptr) {
-      this->_ptr->incr_counter(x, k);
+      this->write([&](PolymorphicBase& inv) { inv.incr_counter(x, k); });
     }
   }
 
   void forget_counter(VariableRef x) override {
     if (this->_ptr != nullptr) {
-      this->_ptr->forget_counter(x);
+      this->write([&](PolymorphicBase& inv) { inv.forget_counter(x); });
     }
   }
 
@@ -51,6 +51,7 @@
 
 #pragma once
 
+#include <ikos/core/adt/small_vector.hpp>
 #include <ikos/core/domain/memory/abstract_domain.hpp>
 #include <ikos/core/domain/memory/value/cell_set.hpp>
 #include <ikos/core/domain/memory/value/mem_loc_to_cell_set.hpp>
@@ -143,13 +144,10 @@ private:
   using CellFactoryTrait =
       CellFactoryTraits< VariableRef, MemoryLocationRef, VariableFactory >;
 
-  /// \brief Set of cells
-  using CellSetT = CellSet< VariableRef >;
+  /// \brief Set of cells, indexed by offset
+  using CellSetT = MemLocCellSet< MemoryLocationRef, VariableRef >;
 
   /// \brief Map from base addresses to set of synthetic cells
-  ///
-  /// TODO(jnavas): it should be a map from pointer offsets to set of
-  /// overlapping cells to make operations faster.
   using MemLocToCellSetT = MemLocToCellSet< MemoryLocationRef, VariableRef >;
 
   /// \brief Points-to set
@@ -445,17 +443,6 @@ private:
     return Interval(offset, offset + size - one);
   }
 
-  /// \brief Return true if the given cell overlaps with the given byte range
-  bool cell_overlap(VariableRef cell, const Interval& range) {
-    Interval meet = this->cell_range(cell).meet(range);
-    return !meet.is_bottom();
-  }
-
-  /// \brief Return true if the given cells overlap
-  bool cell_overlap(VariableRef a, VariableRef b) {
-    return this->cell_overlap(a, this->cell_range(b));
-  }
-
   /// \brief Return true if the memory write at `offset` of size `size`
   /// can update the given cell. Return false if the number of overlaps between
   /// the cell and the memory write is not exactly 1.
@@ -529,17 +516,27 @@ private:
       return new_cell;
     }
 
-    CellSetT new_cells = cells;
+    // collect overlapping cells
+    Interval range = this->cell_range(new_cell);
     bool found = false;
-
-    // remove overlapping cells
-    for (VariableRef cell : cells) {
+    CellList overlapping_cells;
+    cells.for_each_overlap(range.lb(), range.ub(), [&](VariableRef cell) {
       if (cell == new_cell) {
         found = true;
-      } else if (this->cell_overlap(cell, new_cell)) {
-        this->forget_surface_cell(cell);
-        new_cells.remove(cell);
+      } else {
+        overlapping_cells.push_back(cell);
       }
+    });
+
+    if (found && overlapping_cells.empty()) {
+      return new_cell;
+    }
+
+    // remove overlapping cells
+    CellSetT new_cells = cells;
+    for (VariableRef cell : overlapping_cells) {
+      this->forget_surface_cell(cell);
+      new_cells.remove(cell);
     }
 
     if (!found) {
@@ -549,12 +546,15 @@ private:
     return new_cell;
   }
 
+  /// \brief List of cells returned by write_realize_range_cells()
+  using CellList = SmallVector< VariableRef, 4 >;
+
   /// \brief Perform a write with an approximated offset.
   ///
   /// Returns a list of cells on which we should perform a weak update.
-  std::vector< VariableRef > write_realize_range_cells(MemoryLocationRef base,
-                                                       VariableRef offset,
-                                                       const MachineInt& size) {
+  CellList write_realize_range_cells(MemoryLocationRef base,
+                                     VariableRef offset,
+                                     const MachineInt& size) {
     // offset interval
     Interval offset_intv = this->integers().to_interval(offset);
     Interval size_intv(MachineInt::zero(size.bit_width(), Unsigned),
@@ -563,27 +563,31 @@ private:
 
     const CellSetT& cells = this->_cells.get(base);
 
-    if (cells.is_empty()) {
+    if (cells.is_empty() || range.is_bottom()) {
       // no cell found for the base address
       return {};
     }
 
-    CellSetT new_cells = cells;
-    std::vector< VariableRef > updated_cells;
+    CellList updated_cells;
+    CellList removed_cells;
 
-    for (VariableRef cell : cells) {
-      if (this->cell_overlap(cell, range)) {
-        if (this->cell_realizes_once(cell, offset, size)) {
-          // that cell has only one way to be affected by the write statement
-          updated_cells.push_back(cell);
-        } else {
-          this->forget_surface_cell(cell);
-          new_cells.remove(cell);
-        }
+    cells.for_each_overlap(range.lb(), range.ub(), [&](VariableRef cell) {
+      if (this->cell_realizes_once(cell, offset, size)) {
+        // that cell has only one way to be affected by the write statement
+        updated_cells.push_back(cell);
+      } else {
+        removed_cells.push_back(cell);
       }
-    }
+    });
 
-    this->_cells.set(base, new_cells);
+    if (!removed_cells.empty()) {
+      CellSetT new_cells = cells;
+      for (VariableRef cell : removed_cells) {
+        this->forget_surface_cell(cell);
+        new_cells.remove(cell);
+      }
+      this->_cells.set(base, new_cells);
+    }
     return updated_cells;
   }
 
@@ -862,7 +866,7 @@ public:
       // update.
 
       for (MemoryLocationRef addr : addrs) {
-        std::vector< VariableRef > cells =
+        CellList cells =
             this->write_realize_range_cells(addr, this->offset_var(ptr), size);
         for (VariableRef cell : cells) {
           this->weak_update(cell, rhs);
@@ -1313,19 +1317,25 @@ private:
     ikos_assert(!range.is_bottom());
 
     const CellSetT& cells = this->_cells.get(addr);
-    CellSetT new_cells = cells;
 
     if (cells.is_empty()) {
       return;
     }
 
-    for (VariableRef cell : cells) {
-      if (cell_overlap(cell, range)) {
-        this->forget_surface_cell(cell);
-        new_cells.remove(cell);
-      }
+    CellList removed_cells;
+    cells.for_each_overlap(range.lb(), range.ub(), [&](VariableRef cell) {
+      removed_cells.push_back(cell);
+    });
+
+    if (removed_cells.empty()) {
+      return;
     }
 
+    CellSetT new_cells = cells;
+    for (VariableRef cell : removed_cells) {
+      this->forget_surface_cell(cell);
+      new_cells.remove(cell);
+    }
     this->_cells.set(addr, new_cells);
   }
 
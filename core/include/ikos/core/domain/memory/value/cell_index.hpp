@@ -0,0 +1,905 @@
+/**************************************************************************/ /**
+ *
+ * \file
+ * \brief Set of cells indexed by offset
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2018 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+#include <ikos/core/number/machine_int.hpp>
+#include <ikos/core/semantic/dumpable.hpp>
+#include <ikos/core/semantic/indexable.hpp>
+#include <ikos/core/semantic/memory/cell.hpp>
+#include <ikos/core/support/assert.hpp>
+
+namespace ikos {
+namespace core {
+namespace memory {
+namespace cell_index_impl {
+
+/// \brief Maximum number of cells in a chunk
+constexpr std::size_t MaxChunkSize = 64;
+
+/// \brief Number of cells in the chunks created by set operations
+constexpr std::size_t ChunkSize = 32;
+
+/// \brief Minimum number of cells in a chunk before an existing chunk can be
+/// reused by set operations
+constexpr std::size_t MinChunkSize = 16;
+
+/// \brief A sorted non-empty sequence of cells
+///
+/// Chunks are immutable and shared between cell indexes.
+template < typename VariableRef >
+struct Chunk {
+  /// \brief Cells, sorted by offset, size and index
+  std::vector< VariableRef > cells;
+
+  /// \brief Maximum offset of the last byte of the cells
+  MachineInt max_last_byte;
+};
+
+template < typename VariableRef >
+using ChunkPtr = std::shared_ptr< const Chunk< VariableRef > >;
+
+/// \brief Content of a non-empty cell index
+template < typename VariableRef >
+struct Data {
+  /// \brief Chunks, sorted
+  std::vector< ChunkPtr< VariableRef > > chunks;
+
+  /// \brief Number of cells
+  std::size_t size;
+
+  /// \brief Binary tree of the chunks with the maximum last byte
+  ///
+  /// Node 1 is the root and node i has children 2i and 2i+1. Leaves are the
+  /// nodes `width + i`, where `width` is the smallest power of two greater or
+  /// equal to the number of chunks. Each node holds the position of the
+  /// chunk with the maximum `max_last_byte` in its subtree, or `NoChunk`.
+  std::vector< std::size_t > max_last_byte_tree;
+};
+
+/// \brief Empty node of `Data::max_last_byte_tree`
+constexpr std::size_t NoChunk = static_cast< std::size_t >(-1);
+
+template < typename VariableRef >
+using DataPtr = std::shared_ptr< const Data< VariableRef > >;
+
+/// \brief Helper for cells
+template < typename VariableRef, typename MemoryLocationRef >
+struct CellHelper {
+  using CellVariableTrait =
+      CellVariableTraits< VariableRef, MemoryLocationRef >;
+
+  /// \brief Return the offset of the given cell
+  static const MachineInt& offset(VariableRef cell) {
+    return CellVariableTrait::offset(cell);
+  }
+
+  /// \brief Return the size of the given cell
+  static const MachineInt& size(VariableRef cell) {
+    return CellVariableTrait::size(cell);
+  }
+
+  /// \brief Return the offset of the last byte of the given cell
+  ///
+  /// Returns the maximum offset on overflow.
+  static MachineInt last_byte(VariableRef cell) {
+    const MachineInt& offset = CellVariableTrait::offset(cell);
+    const MachineInt& size = CellVariableTrait::size(cell);
+    bool overflow = false;
+    MachineInt r =
+        add(offset,
+            sub(size, MachineInt(1, size.bit_width(), size.sign())),
+            overflow);
+    if (overflow) {
+      r.set_max();
+    }
+    return r;
+  }
+
+  /// \brief Return true if `a` is strictly before `b`
+  ///
+  /// Cells are ordered by offset, size and index.
+  static bool less(VariableRef a, VariableRef b) {
+    const MachineInt& a_offset = CellVariableTrait::offset(a);
+    const MachineInt& b_offset = CellVariableTrait::offset(b);
+    if (a_offset != b_offset) {
+      return a_offset < b_offset;
+    }
+    const MachineInt& a_size = CellVariableTrait::size(a);
+    const MachineInt& b_size = CellVariableTrait::size(b);
+    if (a_size != b_size) {
+      return a_size < b_size;
+    }
+    return IndexableTraits< VariableRef >::index(a) <
+           IndexableTraits< VariableRef >::index(b);
+  }
+
+  /// \brief Create a chunk with the given sorted cells
+  static ChunkPtr< VariableRef > make_chunk(std::vector< VariableRef > cells) {
+    ikos_assert(!cells.empty());
+    MachineInt max_last_byte = last_byte(cells.front());
+    for (VariableRef cell : cells) {
+      max_last_byte = max(max_last_byte, last_byte(cell));
+    }
+    return std::make_shared< const Chunk< VariableRef > >(
+        Chunk< VariableRef >{std::move(cells), std::move(max_last_byte)});
+  }
+
+  /// \brief Create the content of a cell index with the given chunks
+  ///
+  /// Returns nullptr if there is no chunk.
+  static DataPtr< VariableRef > make_data(
+      std::vector< ChunkPtr< VariableRef > > chunks) {
+    if (chunks.empty()) {
+      return nullptr;
+    }
+    std::size_t size = 0;
+    for (const ChunkPtr< VariableRef >& chunk : chunks) {
+      size += chunk->cells.size();
+    }
+
+    std::size_t width = 1;
+    while (width < chunks.size()) {
+      width *= 2;
+    }
+    std::vector< std::size_t > tree(2 * width, NoChunk);
+    for (std::size_t i = 0; i < chunks.size(); i++) {
+      tree[width + i] = i;
+    }
+    for (std::size_t i = width - 1; i >= 1; i--) {
+      std::size_t l = tree[2 * i], r = tree[2 * i + 1];
+      if (r == NoChunk || (l != NoChunk && chunks[r]->max_last_byte <=
+                                              chunks[l]->max_last_byte)) {
+        tree[i] = l;
+      } else {
+        tree[i] = r;
+      }
+    }
+
+    return std::make_shared< const Data< VariableRef > >(
+        Data< VariableRef >{std::move(chunks), size, std::move(tree)});
+  }
+
+  /// \brief Return the position of the first chunk with a cell greater or
+  /// equal to the given cell, or the end position
+  static typename std::vector< ChunkPtr< VariableRef > >::const_iterator
+  find_chunk(const std::vector< ChunkPtr< VariableRef > >& chunks,
+             VariableRef cell) {
+    return std::lower_bound(chunks.begin(),
+                            chunks.end(),
+                            cell,
+                            [](const ChunkPtr< VariableRef >& c,
+                               VariableRef key) {
+                              return less(c->cells.back(), key);
+                            });
+  }
+
+  /// \brief Return the position of the first cell greater or equal to the
+  /// given cell in the given chunk, or the end position
+  static typename std::vector< VariableRef >::const_iterator find_cell(
+      const std::vector< VariableRef >& cells, VariableRef cell) {
+    return std::lower_bound(cells.begin(), cells.end(), cell, less);
+  }
+};
+
+/// \brief Position in a cell index, used by set operations
+template < typename VariableRef >
+class Cursor {
+private:
+  const ChunkPtr< VariableRef >* _chunk = nullptr;
+  const ChunkPtr< VariableRef >* _end = nullptr;
+  std::size_t _pos = 0;
+
+public:
+  /// \brief Create a cursor at the beginning of the given content
+  explicit Cursor(const Data< VariableRef >& data)
+      : _chunk(data.chunks.data()),
+        _end(data.chunks.data() + data.chunks.size()) {}
+
+  /// \brief Return true if the cursor reached the end
+  bool done() const { return this->_chunk == this->_end; }
+
+  /// \brief Return true if the cursor is at the beginning of a chunk
+  bool at_chunk_start() const { return this->_pos == 0; }
+
+  /// \brief Return the current chunk
+  const ChunkPtr< VariableRef >& chunk() const { return *this->_chunk; }
+
+  /// \brief Return the current cell
+  VariableRef cell() const { return (*this->_chunk)->cells[this->_pos]; }
+
+  /// \brief Move to the next cell
+  void next() {
+    if (++this->_pos == (*this->_chunk)->cells.size()) {
+      this->next_chunk();
+    }
+  }
+
+  /// \brief Move to the beginning of the next chunk
+  void next_chunk() {
+    this->_pos = 0;
+    ++this->_chunk;
+  }
+};
+
+/// \brief Builder of chunks, used by set operations
+template < typename VariableRef, typename MemoryLocationRef >
+class Builder {
+private:
+  using Helper = CellHelper< VariableRef, MemoryLocationRef >;
+
+private:
+  std::vector< ChunkPtr< VariableRef > > _chunks;
+  std::vector< VariableRef > _cells;
+
+public:
+  /// \brief Add a cell, greater than the previous ones
+  void push(VariableRef cell) {
+    this->_cells.push_back(cell);
+    if (this->_cells.size() == ChunkSize) {
+      this->flush();
+    }
+  }
+
+  /// \brief Add a chunk, greater than the previous cells
+  ///
+  /// The chunk is shared if the pending cells are enough to form a chunk.
+  void push(const ChunkPtr< VariableRef >& chunk) {
+    if (this->_cells.empty() || this->_cells.size() >= MinChunkSize) {
+      this->flush();
+      this->_chunks.push_back(chunk);
+    } else {
+      for (VariableRef cell : chunk->cells) {
+        this->push(cell);
+      }
+    }
+  }
+
+  /// \brief Return the content of the cell index
+  DataPtr< VariableRef > build() {
+    this->flush();
+    return Helper::make_data(std::move(this->_chunks));
+  }
+
+private:
+  /// \brief Create a chunk with the pending cells
+  void flush() {
+    if (!this->_cells.empty()) {
+      this->_chunks.push_back(Helper::make_chunk(std::move(this->_cells)));
+      this->_cells.clear();
+      this->_cells.reserve(ChunkSize);
+    }
+  }
+};
+
+/// \brief Return true if `s` is a subset of `t`
+template < typename VariableRef, typename MemoryLocationRef >
+inline bool is_subset_of(const Data< VariableRef >& s,
+                         const Data< VariableRef >& t) {
+  using Helper = CellHelper< VariableRef, MemoryLocationRef >;
+  if (s.size > t.size) {
+    return false;
+  }
+  Cursor< VariableRef > s_it(s), t_it(t);
+  while (!s_it.done()) {
+    if (t_it.done()) {
+      return false;
+    } else if (s_it.at_chunk_start() && t_it.at_chunk_start() &&
+               s_it.chunk() == t_it.chunk()) {
+      s_it.next_chunk();
+      t_it.next_chunk();
+    } else if (Helper::less(t_it.cell(), s_it.cell())) {
+      t_it.next();
+    } else if (t_it.cell() == s_it.cell()) {
+      s_it.next();
+      t_it.next();
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// \brief Return true if `s` and `t` are equal
+template < typename VariableRef >
+inline bool equals(const Data< VariableRef >& s, const Data< VariableRef >& t) {
+  if (s.size != t.size) {
+    return false;
+  }
+  Cursor< VariableRef > s_it(s), t_it(t);
+  while (!s_it.done()) {
+    if (s_it.at_chunk_start() && t_it.at_chunk_start() &&
+        s_it.chunk() == t_it.chunk()) {
+      s_it.next_chunk();
+      t_it.next_chunk();
+    } else if (s_it.cell() == t_it.cell()) {
+      s_it.next();
+      t_it.next();
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// \brief Add the remaining cells of `it` in the given builder
+template < typename VariableRef, typename MemoryLocationRef >
+inline void push_remaining(Builder< VariableRef, MemoryLocationRef >& builder,
+                           Cursor< VariableRef >& it) {
+  while (!it.done()) {
+    if (it.at_chunk_start()) {
+      builder.push(it.chunk());
+      it.next_chunk();
+    } else {
+      builder.push(it.cell());
+      it.next();
+    }
+  }
+}
+
+/// \brief Return the union of two cell indexes
+template < typename VariableRef, typename MemoryLocationRef >
+inline DataPtr< VariableRef > join(const DataPtr< VariableRef >& s,
+                                   const DataPtr< VariableRef >& t) {
+  using Helper = CellHelper< VariableRef, MemoryLocationRef >;
+  if (s == t || t == nullptr) {
+    return s;
+  } else if (s == nullptr) {
+    return t;
+  }
+
+  Builder< VariableRef, MemoryLocationRef > builder;
+  bool is_s = true, is_t = true;
+  Cursor< VariableRef > s_it(*s), t_it(*t);
+  while (!s_it.done() && !t_it.done()) {
+    if (s_it.at_chunk_start() && t_it.at_chunk_start() &&
+        s_it.chunk() == t_it.chunk()) {
+      builder.push(s_it.chunk());
+      s_it.next_chunk();
+      t_it.next_chunk();
+    } else if (s_it.at_chunk_start() &&
+               Helper::less(s_it.chunk()->cells.back(), t_it.cell())) {
+      builder.push(s_it.chunk());
+      s_it.next_chunk();
+      is_t = false;
+    } else if (t_it.at_chunk_start() &&
+               Helper::less(t_it.chunk()->cells.back(), s_it.cell())) {
+      builder.push(t_it.chunk());
+      t_it.next_chunk();
+      is_s = false;
+    } else if (Helper::less(s_it.cell(), t_it.cell())) {
+      builder.push(s_it.cell());
+      s_it.next();
+      is_t = false;
+    } else if (Helper::less(t_it.cell(), s_it.cell())) {
+      builder.push(t_it.cell());
+      t_it.next();
+      is_s = false;
+    } else {
+      builder.push(s_it.cell());
+      s_it.next();
+      t_it.next();
+    }
+  }
+  is_t = is_t && s_it.done();
+  is_s = is_s && t_it.done();
+
+  if (is_s) {
+    return s;
+  } else if (is_t) {
+    return t;
+  }
+  push_remaining(builder, s_it);
+  push_remaining(builder, t_it);
+  return builder.build();
+}
+
+/// \brief Return the intersection (or the difference, if `Difference` is
+/// true) of two cell indexes
+template < bool Difference, typename VariableRef, typename MemoryLocationRef >
+inline DataPtr< VariableRef > intersect_or_difference(
+    const DataPtr< VariableRef >& s, const DataPtr< VariableRef >& t) {
+  using Helper = CellHelper< VariableRef, MemoryLocationRef >;
+  if (s == t) {
+    return Difference ? nullptr : s;
+  } else if (s == nullptr || t == nullptr) {
+    return Difference ? s : nullptr;
+  }
+
+  Builder< VariableRef, MemoryLocationRef > builder;
+  bool is_s = true;
+  Cursor< VariableRef > s_it(*s), t_it(*t);
+  while (!s_it.done() && !t_it.done()) {
+    if (s_it.at_chunk_start() && t_it.at_chunk_start() &&
+        s_it.chunk() == t_it.chunk()) {
+      if (Difference) {
+        is_s = false;
+      } else {
+        builder.push(s_it.chunk());
+      }
+      s_it.next_chunk();
+      t_it.next_chunk();
+    } else if (s_it.at_chunk_start() &&
+               Helper::less(s_it.chunk()->cells.back(), t_it.cell())) {
+      if (Difference) {
+        builder.push(s_it.chunk());
+      } else {
+        is_s = false;
+      }
+      s_it.next_chunk();
+    } else if (t_it.at_chunk_start() &&
+               Helper::less(t_it.chunk()->cells.back(), s_it.cell())) {
+      t_it.next_chunk();
+    } else if (Helper::less(s_it.cell(), t_it.cell())) {
+      if (Difference) {
+        builder.push(s_it.cell());
+      } else {
+        is_s = false;
+      }
+      s_it.next();
+    } else if (Helper::less(t_it.cell(), s_it.cell())) {
+      t_it.next();
+    } else {
+      if (Difference) {
+        is_s = false;
+      } else {
+        builder.push(s_it.cell());
+      }
+      s_it.next();
+      t_it.next();
+    }
+  }
+  if (Difference) {
+    if (is_s) {
+      return s;
+    }
+    push_remaining(builder, s_it);
+  } else {
+    is_s = is_s && s_it.done();
+    if (is_s) {
+      return s;
+    }
+  }
+  return builder.build();
+}
+
+/// \brief Forward iterator over the cells of a cell index
+template < typename VariableRef >
+class CellIndexIterator final {
+public:
+  // Required types for iterators
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = const VariableRef&;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const VariableRef*;
+  using reference = const VariableRef&;
+
+private:
+  /// \brief Current chunk, or nullptr for the end iterator
+  const ChunkPtr< VariableRef >* _chunk = nullptr;
+
+  /// \brief End of the chunks
+  const ChunkPtr< VariableRef >* _chunk_end = nullptr;
+
+  /// \brief Position of the current cell in the current chunk
+  std::size_t _pos = 0;
+
+public:
+  /// \brief Create an end iterator
+  CellIndexIterator() = default;
+
+  /// \brief Create an iterator over the given non-empty chunks
+  CellIndexIterator(const ChunkPtr< VariableRef >* begin,
+                    const ChunkPtr< VariableRef >* end)
+      : _chunk(begin), _chunk_end(end) {}
+
+  /// \brief Pre-increment the iterator
+  CellIndexIterator& operator++() {
+    ikos_assert(this->_chunk != nullptr);
+    if (++this->_pos == (*this->_chunk)->cells.size()) {
+      this->_pos = 0;
+      if (++this->_chunk == this->_chunk_end) {
+        // We reached the end
+        this->_chunk = nullptr;
+      }
+    }
+    return *this;
+  }
+
+  /// \brief Post-increment the iterator
+  const CellIndexIterator operator++(int) {
+    CellIndexIterator r = *this;
+    ++(*this);
+    return r;
+  }
+
+  /// \brief Compare two iterators
+  bool operator==(const CellIndexIterator& other) const {
+    return this->_chunk == other._chunk && this->_pos == other._pos;
+  }
+
+  /// \brief Compare two iterators
+  bool operator!=(const CellIndexIterator& other) const {
+    return !this->operator==(other);
+  }
+
+  /// \brief Dereference the iterator
+  reference operator*() const { return (*this->_chunk)->cells[this->_pos]; }
+
+  /// \brief Dereference the iterator
+  pointer operator->() const { return &(*this->_chunk)->cells[this->_pos]; }
+
+}; // end class CellIndexIterator
+
+} // end namespace cell_index_impl
+
+/// \brief A set of cells of a memory location, ordered by offset
+///
+/// This is a drop-in replacement for PatriciaTreeSet, with an additional
+/// `for_each_overlap()` that enumerates the cells overlapping a byte range
+/// without a scan of all the cells.
+///
+/// Cells are stored in a sorted array of chunks of at most 64 cells. Each
+/// chunk keeps the maximum offset of the last byte of its cells, and a binary
+/// tree over the chunks keeps the maximum of these, so subtrees of chunks that
+/// cannot overlap a range are skipped. Chunks are immutable and shared
+/// between sets, as well as the array itself, so copies are cheap and an
+/// insertion or a removal only copies one chunk. Like the Patricia tree, set
+/// operations reuse the chunks common to both operands.
+///
+/// Requirements:
+///
+/// VariableRef must implement IndexableTraits
+/// VariableRef must implement CellVariableTraits
+/// VariableRef must implement bool VariableRef::operator==(VariableRef) const
+template < typename VariableRef, typename MemoryLocationRef >
+class CellIndex final {
+public:
+  static_assert(IsIndexable< VariableRef >::value,
+                "VariableRef must implement IndexableTraits");
+  static_assert(IsCellVariable< VariableRef, MemoryLocationRef >::value,
+                "VariableRef must implement CellVariableTraits");
+
+private:
+  using Data = cell_index_impl::Data< VariableRef >;
+  using DataPtr = cell_index_impl::DataPtr< VariableRef >;
+  using ChunkPtr = cell_index_impl::ChunkPtr< VariableRef >;
+  using Helper = cell_index_impl::CellHelper< VariableRef, MemoryLocationRef >;
+
+public:
+  using Iterator = cell_index_impl::CellIndexIterator< VariableRef >;
+
+private:
+  /// \brief Content of the set, or nullptr if the set is empty
+  DataPtr _data;
+
+private:
+  /// \brief Private constructor
+  explicit CellIndex(DataPtr data) : _data(std::move(data)) {}
+
+public:
+  /// \brief Create an empty cell index
+  CellIndex() = default;
+
+  /// \brief Create a cell index with the given cells
+  CellIndex(std::initializer_list< VariableRef > cells) {
+    for (VariableRef cell : cells) {
+      this->insert(cell);
+    }
+  }
+
+  /// \brief Copy constructor
+  CellIndex(const CellIndex&) noexcept = default;
+
+  /// \brief Move constructor
+  CellIndex(CellIndex&&) noexcept = default;
+
+  /// \brief Copy assignment operator
+  CellIndex& operator=(const CellIndex&) noexcept = default;
+
+  /// \brief Move assignment operator
+  CellIndex& operator=(CellIndex&&) noexcept = default;
+
+  /// \brief Destructor
+  ~CellIndex() = default;
+
+  /// \brief Return true if the set is empty
+  bool empty() const { return this->_data == nullptr; }
+
+  /// \brief Return the number of cells in the set
+  std::size_t size() const {
+    return this->_data != nullptr ? this->_data->size : 0;
+  }
+
+  /// \brief Clear the content of the set
+  void clear() { this->_data.reset(); }
+
+  /// \brief Return true if the set contains the given cell
+  bool contains(VariableRef cell) const {
+    if (this->_data == nullptr) {
+      return false;
+    }
+    auto it = Helper::find_chunk(this->_data->chunks, cell);
+    if (it == this->_data->chunks.end()) {
+      return false;
+    }
+    auto pos = Helper::find_cell((*it)->cells, cell);
+    return pos != (*it)->cells.end() && *pos == cell;
+  }
+
+  /// \brief Return true if the set is a subset of `other`
+  bool is_subset_of(const CellIndex& other) const {
+    if (this->_data == other._data || this->_data == nullptr) {
+      return true;
+    } else if (other._data == nullptr) {
+      return false;
+    } else {
+      return cell_index_impl::is_subset_of< VariableRef, MemoryLocationRef >(
+          *this->_data, *other._data);
+    }
+  }
+
+  /// \brief Return true if the sets are equal
+  bool equals(const CellIndex& other) const {
+    if (this->_data == other._data) {
+      return true;
+    } else if (this->_data == nullptr || other._data == nullptr) {
+      return false;
+    } else {
+      return cell_index_impl::equals(*this->_data, *other._data);
+    }
+  }
+
+  /// \brief Return true if the sets are equal
+  bool operator==(const CellIndex& other) const { return this->equals(other); }
+
+  /// \brief Return the begin iterator over the cells, ordered by offset
+  Iterator begin() const {
+    if (this->_data == nullptr) {
+      return Iterator();
+    }
+    const ChunkPtr* chunks = this->_data->chunks.data();
+    return Iterator(chunks, chunks + this->_data->chunks.size());
+  }
+
+  /// \brief Return the end iterator over the cells
+  Iterator end() const { return Iterator(); }
+
+  /// \brief Insert a cell in the set
+  void insert(VariableRef cell) {
+    if (this->_data == nullptr) {
+      this->_data = Helper::make_data({Helper::make_chunk({cell})});
+      return;
+    }
+    auto chunk = Helper::find_chunk(this->_data->chunks, cell);
+    if (chunk == this->_data->chunks.end()) {
+      // Insert at the end of the last chunk
+      --chunk;
+    }
+    auto pos = Helper::find_cell((*chunk)->cells, cell);
+    if (pos != (*chunk)->cells.end() && *pos == cell) {
+      return;
+    }
+    std::vector< ChunkPtr > chunks = this->_data->chunks;
+    auto it = chunks.begin() + (chunk - this->_data->chunks.begin());
+    std::vector< VariableRef > cells = (*it)->cells;
+    cells.insert(cells.begin() + (pos - (*chunk)->cells.begin()), cell);
+    if (cells.size() > cell_index_impl::MaxChunkSize) {
+      // Split the chunk in two halves
+      auto middle = cells.begin() + cells.size() / 2;
+      std::vector< VariableRef > upper(middle, cells.end());
+      cells.erase(middle, cells.end());
+      *it = Helper::make_chunk(std::move(cells));
+      chunks.insert(it + 1, Helper::make_chunk(std::move(upper)));
+    } else {
+      *it = Helper::make_chunk(std::move(cells));
+    }
+    this->_data = Helper::make_data(std::move(chunks));
+  }
+
+  /// \brief Remove a cell from the set
+  void erase(VariableRef cell) {
+    if (this->_data == nullptr) {
+      return;
+    }
+    auto chunk = Helper::find_chunk(this->_data->chunks, cell);
+    if (chunk == this->_data->chunks.end()) {
+      return;
+    }
+    auto pos = Helper::find_cell((*chunk)->cells, cell);
+    if (pos == (*chunk)->cells.end() || !(*pos == cell)) {
+      return;
+    }
+    std::vector< ChunkPtr > chunks = this->_data->chunks;
+    auto it = chunks.begin() + (chunk - this->_data->chunks.begin());
+    if ((*it)->cells.size() == 1) {
+      chunks.erase(it);
+    } else {
+      std::vector< VariableRef > cells = (*it)->cells;
+      cells.erase(cells.begin() + (pos - (*chunk)->cells.begin()));
+      *it = Helper::make_chunk(std::move(cells));
+    }
+    this->_data = Helper::make_data(std::move(chunks));
+  }
+
+  /// \brief Call `f` on each cell overlapping the byte range [lb, ub]
+  ///
+  /// Cells are enumerated by offset. `f` must not modify the set.
+  ///
+  /// This runs in O(log n + c log n), where `c` is the number of chunks
+  /// with at least one overlapping cell. A large cell only adds its own chunk.
+  template < typename Function >
+  void for_each_overlap(const MachineInt& lb,
+                        const MachineInt& ub,
+                        Function f) const {
+    if (this->_data == nullptr) {
+      return;
+    }
+
+    // Chunks after `end` start after `ub`
+    const std::vector< ChunkPtr >& chunks = this->_data->chunks;
+    std::size_t end = static_cast< std::size_t >(
+        std::upper_bound(chunks.begin(),
+                         chunks.end(),
+                         ub,
+                         [](const MachineInt& o, const ChunkPtr& c) {
+                           return o < Helper::offset(c->cells.front());
+                         }) -
+        chunks.begin());
+    if (end == 0) {
+      return;
+    }
+
+    // Depth-first traversal of the tree, skipping subtrees that end before
+    // `lb`, so that chunks are visited by offset
+    const std::vector< std::size_t >& tree = this->_data->max_last_byte_tree;
+    std::size_t width = tree.size() / 2;
+    std::vector< std::pair< std::size_t, std::size_t > > stack;
+    stack.emplace_back(1, width);
+    while (!stack.empty()) {
+      std::size_t node = stack.back().first;
+      std::size_t node_width = stack.back().second;
+      stack.pop_back();
+
+      std::size_t first = node * node_width - width;
+      if (first >= end || tree[node] == cell_index_impl::NoChunk ||
+          chunks[tree[node]]->max_last_byte < lb) {
+        continue;
+      }
+
+      if (node_width > 1) {
+        stack.emplace_back(2 * node + 1, node_width / 2);
+        stack.emplace_back(2 * node, node_width / 2);
+        continue;
+      }
+
+      for (VariableRef cell : chunks[first]->cells) {
+        if (ub < Helper::offset(cell)) {
+          break;
+        } else if (lb <= Helper::last_byte(cell)) {
+          f(cell);
+        }
+      }
+    }
+  }
+
+  /// \brief Perform the union of two cell indexes
+  void join_with(const CellIndex& other) {
+    this->_data = cell_index_impl::join< VariableRef, MemoryLocationRef >(
+        this->_data, other._data);
+  }
+
+  /// \brief Perform the union of two cell indexes
+  CellIndex join(const CellIndex& other) const {
+    return CellIndex(
+        cell_index_impl::join< VariableRef, MemoryLocationRef >(this->_data,
+                                                                other._data));
+  }
+
+  /// \brief Perform the intersection of two cell indexes
+  void intersect_with(const CellIndex& other) {
+    this->_data = cell_index_impl::
+        intersect_or_difference< false, VariableRef, MemoryLocationRef >(
+            this->_data, other._data);
+  }
+
+  /// \brief Perform the intersection of two cell indexes
+  CellIndex intersect(const CellIndex& other) const {
+    return CellIndex(
+        cell_index_impl::
+            intersect_or_difference< false, VariableRef, MemoryLocationRef >(
+                this->_data, other._data));
+  }
+
+  /// \brief Perform the difference of two cell indexes
+  void difference_with(const CellIndex& other) {
+    this->_data = cell_index_impl::
+        intersect_or_difference< true, VariableRef, MemoryLocationRef >(
+            this->_data, other._data);
+  }
+
+  /// \brief Perform the difference of two cell indexes
+  CellIndex difference(const CellIndex& other) const {
+    return CellIndex(
+        cell_index_impl::
+            intersect_or_difference< true, VariableRef, MemoryLocationRef >(
+                this->_data, other._data));
+  }
+
+  /// \brief Dump the set, for debugging purpose
+  void dump(std::ostream& o) const {
+    static_assert(IsDumpable< VariableRef >::value,
+                  "VariableRef must implement DumpableTraits");
+    o << "{";
+    for (auto it = this->begin(), et = this->end(); it != et;) {
+      DumpableTraits< VariableRef >::dump(o, *it);
+      ++it;
+      if (it != et) {
+        o << "; ";
+      }
+    }
+    o << "}";
+  }
+
+}; // end class CellIndex
+
+/// \brief Write a cell index on a stream
+template < typename VariableRef, typename MemoryLocationRef >
+inline std::ostream& operator<<(
+    std::ostream& o, const CellIndex< VariableRef, MemoryLocationRef >& set) {
+  set.dump(o);
+  return o;
+}
+
+} // end namespace memory
+} // end namespace core
+} // end namespace ikos
@@ -47,6 +47,7 @@
 
 #include <ikos/core/adt/patricia_tree/set.hpp>
 #include <ikos/core/domain/abstract_domain.hpp>
+#include <ikos/core/number/machine_int.hpp>
 
 namespace ikos {
 namespace core {
@@ -60,16 +61,18 @@ namespace memory {
 /// The bottom value is represented as top.
 ///
 /// Note that this is not a lattice.
-template < typename VariableRef >
-class CellSet final : public core::AbstractDomain< CellSet< VariableRef > > {
-private:
-  using PatriciaTreeSetT = PatriciaTreeSet< VariableRef >;
-
+///
+/// `Set` can be any set with the interface of PatriciaTreeSet, e.g BitsetSet or
+/// CellIndex.
+template < typename VariableRef,
+           typename Set = PatriciaTreeSet< VariableRef > >
+class CellSet final
+    : public core::AbstractDomain< CellSet< VariableRef, Set > > {
 public:
-  using Iterator = typename PatriciaTreeSetT::Iterator;
+  using Iterator = typename Set::Iterator;
 
 private:
-  PatriciaTreeSetT _set;
+  Set _set;
 
 private:
   struct EmptyTag {};
@@ -192,6 +195,16 @@ public:
     return this->is_top() || this->_set.contains(cell);
   }
 
+  /// \brief Call `f` on each cell overlapping the byte range [lb, ub]
+  ///
+  /// This requires `Set` to be a CellIndex.
+  template < typename Function >
+  void for_each_overlap(const MachineInt& lb,
+                        const MachineInt& ub,
+                        Function f) const {
+    this->_set.for_each_overlap(lb, ub, f);
+  }
+
   void dump(std::ostream& o) const override {
     if (this->is_top()) {
       o << "⊤";
@@ -43,6 +43,7 @@
 
 #pragma once
 
+#include <ikos/core/domain/memory/value/cell_index.hpp>
 #include <ikos/core/domain/memory/value/cell_set.hpp>
 #include <ikos/core/domain/separate_domain.hpp>
 
@@ -50,10 +51,16 @@ namespace ikos {
 namespace core {
 namespace memory {
 
+/// \brief Set of synthetic cells of a memory location, indexed by offset
+template < typename MemoryLocationRef, typename VariableRef >
+using MemLocCellSet =
+    CellSet< VariableRef, CellIndex< VariableRef, MemoryLocationRef > >;
+
 /// \brief Map from memory locations to set of synthetic cells
 template < typename MemoryLocationRef, typename VariableRef >
 using MemLocToCellSet =
-    SeparateDomain< MemoryLocationRef, CellSet< VariableRef > >;
+    SeparateDomain< MemoryLocationRef,
+                    MemLocCellSet< MemoryLocationRef, VariableRef > >;
 
 } // end namespace memory
 } // end namespace core
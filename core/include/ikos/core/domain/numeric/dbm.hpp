@@ -46,6 +46,9 @@
 
 #pragma once
 
+#include <iterator>
+
+#include <boost/container/flat_map.hpp>
 #include <boost/iterator/transform_iterator.hpp>
 
 #include <ikos/core/domain/numeric/abstract_domain.hpp>
@@ -1052,7 +1055,7 @@ public:
     }
 
     auto it = cst.begin();
-    auto it2 = ++cst.begin();
+    auto it2 = std::next(cst.begin());
     MatrixIndex i, j;
     const Number& c = cst.constant();
 
@@ -1117,7 +1120,7 @@ public:
         }
       } else if (cst.is_inequality() || cst.is_equality()) {
         auto it = cst.begin();
-        auto it2 = ++cst.begin();
+        auto it2 = std::next(cst.begin());
         MatrixIndex i, j;
         const Number& c = cst.constant();
 
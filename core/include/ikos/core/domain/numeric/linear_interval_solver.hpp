@@ -157,7 +157,8 @@ private:
       const Number& c = term.second;
       VariableRef pivot = term.first;
 
-      IntervalT rhs = this->compute_residual(cst, pivot, inv) / IntervalT(c);
+      IntervalT residual = this->compute_residual(cst, pivot, inv);
+      IntervalT rhs = residual / IntervalT(c);
       if (cst.is_equality()) {
         this->refine(pivot, rhs, inv);
       } else if (cst.is_inequality()) {
@@ -167,9 +168,9 @@ private:
           this->refine(pivot, rhs.upper_half_line(), inv);
         }
       } else {
-        // cst is a disequation
+        // cst is a disequation, the division must be exact
         boost::optional< Number > k = rhs.singleton();
-        if (k) {
+        if (k && residual == IntervalT((*k) * c)) {
           IntervalT old_i = inv.to_interval(pivot);
           IntervalT new_i = trim_bound(old_i, BoundT(*k));
           if (new_i.is_bottom()) {
@@ -48,6 +48,9 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <vector>
 
 #include <boost/container/flat_map.hpp>
@@ -71,8 +74,12 @@ namespace numeric {
 /// fashion (O(n^2)) as it is intended to be used for small sets of
 /// variables (~10-20).
 ///
-/// XXX: The implementation has several issues (segfaults, unsoundness, etc.).
-/// Prefer the APRON octagon domain if necessary.
+/// The strong closure is computed on native floating point bounds when all
+/// bounds are small enough integers, and on arbitrary precision bounds
+/// otherwise.
+///
+/// Disequations and constraints that are not octagonal are approximated using
+/// intervals.
 template < typename Number, typename VariableRef >
 class Octagon final
     : public numeric::AbstractDomain< Number,
@@ -236,6 +243,152 @@ private:
 
   }; // end class Matrix
 
+  /// \brief Matrix of native floating point bounds, used by the closure
+  ///
+  /// The matrix is stored in row-major order, using 0-based indexes, so that
+  /// the inner loops of the closure are over contiguous memory and can be
+  /// vectorized by the compiler. +oo is represented by the IEEE infinity.
+  ///
+  /// Only integer bounds in [-max_bound(), max_bound()] are represented, so
+  /// that a sum of 3 bounds is always an exact double.
+  class NativeMatrix {
+  private:
+    std::vector< double > _matrix;
+    MatrixIndex _dim = 0; // 2 * number of variables
+
+  public:
+    /// \brief Largest bound represented in a native matrix
+    static double max_bound() { return 1125899906842624.0; } // 2^50
+
+    /// \brief Convert a bound into a native bound
+    ///
+    /// Return false if the bound cannot be represented.
+    static bool to_native(const Bound< ZNumber >& b, double& d) {
+      if (b.is_plus_infinity()) {
+        d = std::numeric_limits< double >::infinity();
+        return true;
+      } else if (b.is_minus_infinity()) {
+        return false;
+      }
+
+      ZNumber n = *b.number();
+      if (!n.fits< long long >()) {
+        return false;
+      }
+
+      d = static_cast< double >(n.to< long long >());
+      return d >= -max_bound() && d <= max_bound();
+    }
+
+    /// \brief Native bounds are only supported for integers
+    template < typename N >
+    static bool to_native(const Bound< N >&, double&) {
+      return false;
+    }
+
+    /// \brief Convert a native bound into a bound
+    static BoundT from_native(double d) {
+      if (d == std::numeric_limits< double >::infinity()) {
+        return BoundT::plus_infinity();
+      } else {
+        return BoundT(Number(static_cast< long long >(d)));
+      }
+    }
+
+  public:
+    /// \brief Create the native matrix of `m`
+    ///
+    /// Return false if a bound of `m` cannot be represented.
+    bool load(const Matrix& m) {
+      this->_dim = 2 * m.size();
+      this->_matrix.resize(this->_dim * this->_dim);
+
+      for (MatrixIndex i = 0; i < this->_dim; i++) {
+        for (MatrixIndex j = 0; j < this->_dim; j++) {
+          if (!to_native(m(i + 1, j + 1), this->_matrix[i * this->_dim + j])) {
+            return false;
+          }
+        }
+      }
+
+      return true;
+    }
+
+    /// \brief Write the native matrix back into `m`
+    void store(Matrix& m) const {
+      for (MatrixIndex i = 0; i < this->_dim; i++) {
+        for (MatrixIndex j = 0; j < this->_dim; j++) {
+          m(i + 1, j + 1) = from_native(this->_matrix[i * this->_dim + j]);
+        }
+      }
+    }
+
+    /// \brief Perform the closure step of the strong closure for variable k
+    ///
+    /// Computes m_ij = min(m_ij, m_ia + m_aj, m_ib + m_bj, m_ia + m_ab + m_bj,
+    /// m_ib + m_ba + m_aj) where a = 2k and b = 2k + 1.
+    void close(MatrixIndex k) {
+      const MatrixIndex n = this->_dim;
+      const MatrixIndex a = 2 * k;
+      const MatrixIndex b = 2 * k + 1;
+      double* m = this->_matrix.data();
+
+      // Copy rows a and b, so that the inner loop does not alias
+      const std::vector< double > row_a(m + a * n, m + (a + 1) * n);
+      const std::vector< double > row_b(m + b * n, m + (b + 1) * n);
+      const double* ra = row_a.data();
+      const double* rb = row_b.data();
+      const double m_ab = ra[b];
+      const double m_ba = rb[a];
+
+      for (MatrixIndex i = 0; i < n; i++) {
+        double* ri = m + i * n;
+        const double ca = std::min(ri[a], ri[b] + m_ba);
+        const double cb = std::min(ri[b], ri[a] + m_ab);
+
+        for (MatrixIndex j = 0; j < n; j++) {
+          ri[j] = std::min(ri[j], std::min(ca + ra[j], cb + rb[j]));
+        }
+      }
+    }
+
+    /// \brief Perform the strengthening step of the strong closure
+    ///
+    /// Computes m_ij = min(m_ij, (m_ii' + m_j'j) / 2) where i' = i xor 1.
+    void strengthen() {
+      const MatrixIndex n = this->_dim;
+      double* m = this->_matrix.data();
+
+      // m_j'j, for all j
+      std::vector< double > diag(n);
+      for (MatrixIndex j = 0; j < n; j++) {
+        diag[j] = m[(j ^ 1) * n + j];
+      }
+      const double* d = diag.data();
+
+      for (MatrixIndex i = 0; i < n; i++) {
+        double* ri = m + i * n;
+        const double c = d[i ^ 1];
+
+        for (MatrixIndex j = 0; j < n; j++) {
+          // Integer division rounds towards zero, as for ZNumber
+          ri[j] = std::min(ri[j], std::trunc((c + d[j]) * 0.5));
+        }
+      }
+    }
+
+    /// \brief Return true if all the bounds are still exact
+    bool is_exact() const {
+      for (double d : this->_matrix) {
+        if (d < -max_bound()) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+  }; // end class NativeMatrix
+
 private:
   bool _is_bottom;
   bool _is_normalized;
@@ -305,6 +458,16 @@ private:
     this->_norm_vector.resize(this->_var_index_map.size(), 0);
   }
 
+  /// \brief Set the matrix as not normalized after a change of the constraints
+  /// on the variable at index i
+  void set_unnormalized(MatrixIndex i) {
+    if (this->_is_bottom) {
+      return;
+    }
+    this->_is_normalized = false;
+    this->_norm_vector[i - 1] = 0;
+  }
+
 public:
   /// \brief Compute the strong closure algorithm
   void normalize() const override {
@@ -321,6 +484,59 @@ public:
 
     const MatrixIndex num_var = this->_matrix.size();
 
+    if (!self->normalize_native()) {
+      self->normalize_exact();
+    }
+
+    // Check for negative cycle
+    for (MatrixIndex i = 1; i <= 2 * num_var; ++i) {
+      if (this->_matrix(i, i) < BoundT(0)) {
+        self->_is_bottom = true;
+        self->_is_normalized = true;
+        return;
+      }
+      self->_matrix(i, i) = BoundT(0);
+    }
+
+    self->_is_normalized = true;
+  }
+
+private:
+  /// \brief Compute the strong closure using native bounds
+  ///
+  /// Return false, without any modification, if a bound is not representable.
+  bool normalize_native() {
+    NativeMatrix m;
+    if (!m.load(this->_matrix)) {
+      return false;
+    }
+
+    const MatrixIndex num_var = this->_matrix.size();
+
+    for (MatrixIndex k = 0; k < num_var; ++k) {
+      if (this->_norm_vector[k]) {
+        continue;
+      }
+
+      m.close(k);
+      m.strengthen();
+    }
+
+    // Bounds can only decrease, hence all intermediate results were exact
+    // if the final bounds are within range.
+    if (!m.is_exact()) {
+      return false;
+    }
+
+    m.store(this->_matrix);
+    std::fill(this->_norm_vector.begin(), this->_norm_vector.end(), 1);
+    return true;
+  }
+
+  /// \brief Compute the strong closure using arbitrary precision bounds
+  void normalize_exact() {
+    const MatrixIndex num_var = this->_matrix.size();
+
     for (MatrixIndex k = 1; k <= num_var; ++k) {
       if (this->_norm_vector[k - 1]) {
         continue;
@@ -329,7 +545,7 @@ public:
       for (MatrixIndex i = 1; i <= 2 * num_var; ++i) {
         for (MatrixIndex j = 1; j <= 2 * num_var; ++j) {
           // to ensure the "closed" property
-          self->_matrix(i, j) =
+          this->_matrix(i, j) =
               C(this->_matrix(i, j),
                 this->_matrix(i, 2 * k - 1) + this->_matrix(2 * k - 1, j),
                 this->_matrix(i, 2 * k) + this->_matrix(2 * k, j),
@@ -343,37 +559,39 @@ public:
       // to ensure for all i,j: m_ij <= (m_i+i- + m_j-j+)/2
       for (MatrixIndex i = 1; i <= 2 * num_var; ++i) {
         for (MatrixIndex j = 1; j <= 2 * num_var; ++j) {
-          self->_matrix(i, j) = min(this->_matrix(i, j),
+          this->_matrix(i, j) = min(this->_matrix(i, j),
                                     (this->_matrix(i, i + 2 * (i % 2) - 1) +
                                      this->_matrix(j + 2 * (j % 2) - 1, j)) /
                                         BoundT(2));
         }
       }
 
-      self->_norm_vector[k - 1] = 1;
-    }
-
-    // Check for negative cycle
-    for (MatrixIndex i = 1; i <= 2 * num_var; ++i) {
-      if (this->_matrix(i, i) < BoundT(0)) {
-        self->_is_bottom = true;
-        self->_is_normalized = true;
-        return;
-      }
-      self->_matrix(i, i) = BoundT(0);
+      this->_norm_vector[k - 1] = 1;
     }
-
-    self->_is_normalized = true;
   }
 
+public:
   bool is_bottom() const override {
     this->normalize();
     return this->_is_bottom;
   }
 
   bool is_top() const override {
-    // TODO(marthaud): This is not correct.
-    return !this->_var_index_map.size() && !this->is_bottom();
+    // Does not require normalization
+
+    if (this->_is_bottom) {
+      return false;
+    }
+
+    for (MatrixIndex i = 1; i <= 2 * this->_matrix.size(); ++i) {
+      for (MatrixIndex j = 1; j <= 2 * this->_matrix.size(); ++j) {
+        if (i != j && !this->_matrix(i, j).is_plus_infinity()) {
+          return false;
+        }
+      }
+    }
+
+    return true;
   }
 
   void set_to_bottom() override {
@@ -413,11 +631,15 @@ public:
          ++ito) {
       i2 = ito->second;
       if (this->_var_index_map.find(ito->first) == this->_var_index_map.end()) {
-        if (!other._matrix(2 * i2 - 1, 2 * i2).is_infinite() ||
-            !other._matrix(2 * i2, 2 * i2 - 1).is_infinite()) {
-          // Case: Variable exists and is finite in _other but
-          // does not exist in _this.
-          return false;
+        // Case: Variable does not exist in `this`, thus it must not be
+        // constrained in `other`
+        for (MatrixIndex k = 1; k <= 2 * other._matrix.size(); ++k) {
+          for (MatrixIndex r = 2 * i2 - 1; r <= 2 * i2; ++r) {
+            if (k != r && (!other._matrix(r, k).is_plus_infinity() ||
+                           !other._matrix(k, r).is_plus_infinity())) {
+              return false;
+            }
+          }
         }
       } else {
         temp.emplace(ito->first, 0);
@@ -543,6 +765,67 @@ private:
     return n;
   }
 
+  /// \brief Apply a pointwise binary operator on the union of the variables
+  ///
+  /// Bounds involving a variable that is missing in an operand are +oo.
+  template < typename BinaryOperator >
+  static Octagon pointwise_union_op(const Octagon& o1,
+                                    const Octagon& o2,
+                                    const BinaryOperator& op) {
+    Octagon n;
+
+    // Set union of the two maps
+    for (auto it = o1._var_index_map.begin(); it != o1._var_index_map.end();
+         ++it) {
+      n._var_index_map.emplace(it->first, n._var_index_map.size() + 1);
+    }
+    for (auto it = o2._var_index_map.begin(); it != o2._var_index_map.end();
+         ++it) {
+      n._var_index_map.emplace(it->first, n._var_index_map.size() + 1);
+    }
+
+    if (n._var_index_map.empty()) {
+      return top();
+    }
+
+    n.resize();
+
+    // Index of each variable of `n` in `o1` and `o2`, or 0 if missing
+    std::vector< MatrixIndex > idx1(n._matrix.size(), 0);
+    std::vector< MatrixIndex > idx2(n._matrix.size(), 0);
+    for (auto it = n._var_index_map.begin(); it != n._var_index_map.end();
+         ++it) {
+      auto it1 = o1._var_index_map.find(it->first);
+      if (it1 != o1._var_index_map.end()) {
+        idx1[it->second - 1] = it1->second;
+      }
+      auto it2 = o2._var_index_map.find(it->first);
+      if (it2 != o2._var_index_map.end()) {
+        idx2[it->second - 1] = it2->second;
+      }
+    }
+
+    // Return the row of an operand matching the row `i` of `n`, or 0
+    auto row = [](const std::vector< MatrixIndex >& idx, MatrixIndex i) {
+      MatrixIndex k = idx[(i - 1) / 2];
+      return (k == 0) ? MatrixIndex(0) : 2 * k - (i % 2);
+    };
+
+    const BoundT inf = BoundT::plus_infinity();
+    for (MatrixIndex i = 1; i <= 2 * n._matrix.size(); ++i) {
+      MatrixIndex i1 = row(idx1, i);
+      MatrixIndex i2 = row(idx2, i);
+      for (MatrixIndex j = 1; j <= 2 * n._matrix.size(); ++j) {
+        MatrixIndex j1 = row(idx1, j);
+        MatrixIndex j2 = row(idx2, j);
+        n._matrix(i, j) = op((i1 != 0 && j1 != 0) ? o1._matrix(i1, j1) : inf,
+                             (i2 != 0 && j2 != 0) ? o2._matrix(i2, j2) : inf);
+      }
+    }
+
+    return n;
+  }
+
   struct JoinOperator {
     BoundT operator()(const BoundT& x, const BoundT& y) const {
       return max(x, y);
@@ -576,6 +859,22 @@ private:
     }
   };
 
+  struct MeetOperator {
+    BoundT operator()(const BoundT& x, const BoundT& y) const {
+      return min(x, y);
+    }
+  };
+
+  struct NarrowingOperator {
+    BoundT operator()(const BoundT& x, const BoundT& y) const {
+      if (x.is_infinite()) {
+        return y;
+      } else {
+        return x;
+      }
+    }
+  };
+
 public:
   Octagon join(const Octagon& other) const override {
     // Requires normalization
@@ -649,148 +948,8 @@ public:
     if (this->_is_bottom || other._is_bottom) {
       return bottom();
     } else {
-      Octagon n;
-
-      // Set union of the two maps
-      for (auto it = this->_var_index_map.begin();
-           it != this->_var_index_map.end();
-           ++it) {
-        n._var_index_map.emplace(it->first, n._var_index_map.size() + 1);
-      }
-      for (auto it = other._var_index_map.begin();
-           it != other._var_index_map.end();
-           ++it) {
-        n._var_index_map.emplace(it->first, n._var_index_map.size() + 1);
-      }
-
-      if (n._var_index_map.empty()) {
-        return top();
-      }
-
-      n.resize();
+      Octagon n = pointwise_union_op(*this, other, MeetOperator{});
       n.set_normalized(false);
-
-      typename VarIndexMap::const_iterator testi1, testi2, testj1, testj2;
-      MatrixIndex i1, i2, i3, j1, j2, j3;
-      i1 = i2 = i3 = j1 = j2 = j3 = 0;
-      for (auto it = n._var_index_map.begin(); it != n._var_index_map.end();
-           ++it) {
-        // Finds the intersection on each 2x2 identity matrix.
-        testi1 = this->_var_index_map.find(it->first);
-        testi2 = other._var_index_map.find(it->first);
-        i3 = it->second;
-
-        if (testi1 == this->_var_index_map.end()) {
-          i1 = 0;
-        } else {
-          i1 = testi1->second;
-        }
-        if (testi2 == other._var_index_map.end()) {
-          i2 = 0;
-        } else {
-          i2 = testi2->second;
-        }
-
-        n._matrix(2 * i3 - 1, 2 * i3 - 1) =
-            (!i1) ? other._matrix(2 * i2 - 1, 2 * i2 - 1)
-                  : ((!i2) ? this->_matrix(2 * i1 - 1, 2 * i1 - 1)
-                           : min(this->_matrix(2 * i1 - 1, 2 * i1 - 1),
-                                 other._matrix(2 * i2 - 1, 2 * i2 - 1)));
-        n._matrix(2 * i3 - 1, 2 * i3) =
-            (!i1) ? other._matrix(2 * i2 - 1, 2 * i2)
-                  : ((!i2) ? this->_matrix(2 * i1 - 1, 2 * i1)
-                           : min(this->_matrix(2 * i1 - 1, 2 * i1),
-                                 other._matrix(2 * i2 - 1, 2 * i2)));
-        n._matrix(2 * i3, 2 * i3 - 1) =
-            (!i1) ? other._matrix(2 * i2, 2 * i2 - 1)
-                  : ((!i2) ? this->_matrix(2 * i1, 2 * i1 - 1)
-                           : min(this->_matrix(2 * i1, 2 * i1 - 1),
-                                 other._matrix(2 * i2, 2 * i2 - 1)));
-        n._matrix(2 * i3, 2 * i3) =
-            (!i1) ? other._matrix(2 * i2, 2 * i2)
-                  : ((!i2) ? this->_matrix(2 * i1, 2 * i1)
-                           : min(this->_matrix(2 * i1, 2 * i1),
-                                 other._matrix(2 * i2, 2 * i2)));
-
-        for (auto it2 = it + 1; it2 != n._var_index_map.end(); ++it2) {
-          // Finds the intersection of each pair of 2x2 relational matrices.
-          testj1 = this->_var_index_map.find(it2->first);
-          testj2 = other._var_index_map.find(it2->first);
-          j3 = it2->second;
-
-          if (testj1 == this->_var_index_map.end()) {
-            j1 = 0;
-          } else {
-            j1 = testj1->second;
-          }
-          if (testj2 == other._var_index_map.end()) {
-            j2 = 0;
-          } else {
-            j2 = testj2->second;
-          }
-
-          if (((i1 && !j1) || (!i1 && j1)) && ((i2 && !j2) || (!i2 && j2))) {
-            continue;
-          }
-          if (i1 > j1) {
-            std::swap(i1, j1);
-          }
-          if (i2 > j2) {
-            std::swap(i2, j2);
-          }
-
-          n._matrix(2 * i3 - 1, 2 * j3 - 1) =
-              (!i1 || !j1)
-                  ? other._matrix(2 * i2 - 1, 2 * j2 - 1)
-                  : ((!i2 || !j2) ? this->_matrix(2 * i1 - 1, 2 * j1 - 1)
-                                  : min(this->_matrix(2 * i1 - 1, 2 * j1 - 1),
-                                        other._matrix(2 * i2 - 1, 2 * j2 - 1)));
-          n._matrix(2 * i3 - 1, 2 * j3) =
-              (!i1 || !j1)
-                  ? other._matrix(2 * i2 - 1, 2 * j2)
-                  : ((!i2 || !j2) ? this->_matrix(2 * i1 - 1, 2 * j1)
-                                  : min(this->_matrix(2 * i1 - 1, 2 * j1),
-                                        other._matrix(2 * i2 - 1, 2 * j2)));
-          n._matrix(2 * i3, 2 * j3 - 1) =
-              (!i1 || !j1)
-                  ? other._matrix(2 * i2, 2 * j2 - 1)
-                  : ((!i2 || !j2) ? this->_matrix(2 * i1, 2 * j1 - 1)
-                                  : min(this->_matrix(2 * i1, 2 * j1 - 1),
-                                        other._matrix(2 * i2, 2 * j2 - 1)));
-          n._matrix(2 * i3, 2 * j3) =
-              (!i1 || !j1)
-                  ? other._matrix(2 * i2, 2 * j2)
-                  : ((!i2 || !j2) ? this->_matrix(2 * i1, 2 * j1)
-                                  : min(this->_matrix(2 * i1, 2 * j1),
-                                        other._matrix(2 * i2, 2 * j2)));
-
-          n._matrix(2 * j3 - 1, 2 * i3 - 1) =
-              (!i1 || !j1)
-                  ? other._matrix(2 * j2 - 1, 2 * i2 - 1)
-                  : ((!i2 || !j2) ? this->_matrix(2 * j1 - 1, 2 * i1 - 1)
-                                  : min(this->_matrix(2 * j1 - 1, 2 * i1 - 1),
-                                        other._matrix(2 * j2 - 1, 2 * i2 - 1)));
-          n._matrix(2 * j3 - 1, 2 * i3) =
-              (!i1 || !j1)
-                  ? other._matrix(2 * j2 - 1, 2 * i2)
-                  : ((!i2 || !j2) ? this->_matrix(2 * j1 - 1, 2 * i1)
-                                  : min(this->_matrix(2 * j1 - 1, 2 * i1),
-                                        other._matrix(2 * j2 - 1, 2 * i2)));
-          n._matrix(2 * j3, 2 * i3 - 1) =
-              (!i1 || !j1)
-                  ? other._matrix(2 * j2, 2 * i2 - 1)
-                  : ((!i2 || !j2) ? this->_matrix(2 * j1, 2 * i1 - 1)
-                                  : min(this->_matrix(2 * j1, 2 * i1 - 1),
-                                        other._matrix(2 * j2, 2 * i2 - 1)));
-          n._matrix(2 * j3, 2 * i3) =
-              (!i1 || !j1)
-                  ? other._matrix(2 * j2, 2 * i2)
-                  : ((!i2 || !j2) ? this->_matrix(2 * j1, 2 * i1)
-                                  : min(this->_matrix(2 * j1, 2 * i1),
-                                        other._matrix(2 * j2, 2 * i2)));
-        }
-      }
-
       return n;
     }
   }
@@ -804,150 +963,8 @@ public:
     if (this->_is_bottom || other._is_bottom) {
       return bottom();
     } else {
-      Octagon n;
-
-      // Set union of the two maps
-      for (auto it = this->_var_index_map.begin();
-           it != this->_var_index_map.end();
-           ++it) {
-        n._var_index_map.emplace(it->first, n._var_index_map.size() + 1);
-      }
-      for (auto it = other._var_index_map.begin();
-           it != other._var_index_map.end();
-           ++it) {
-        n._var_index_map.emplace(it->first, n._var_index_map.size() + 1);
-      }
-      if (n._var_index_map.empty()) {
-        return top();
-      }
-
-      n.resize();
+      Octagon n = pointwise_union_op(*this, other, NarrowingOperator{});
       n.set_normalized(false);
-
-      typename VarIndexMap::const_iterator testi1, testi2, testj1, testj2;
-      MatrixIndex i1, i2, i3, j1, j2, j3;
-      i1 = i2 = i3 = j1 = j2 = j3 = 0;
-      for (auto it = n._var_index_map.begin(); it != n._var_index_map.end();
-           ++it) {
-        // Finds the narrowing on each 2x2 identity matrix.
-        testi1 = this->_var_index_map.find(it->first);
-        testi2 = other._var_index_map.find(it->first);
-        i3 = it->second;
-
-        if (testi1 == this->_var_index_map.end()) {
-          i1 = 0;
-        } else {
-          i1 = testi1->second;
-        }
-        if (testi2 == other._var_index_map.end()) {
-          i2 = 0;
-        } else {
-          i2 = testi2->second;
-        }
-
-        n._matrix(2 * i3 - 1, 2 * i3 - 1) =
-            (!i2)
-                ? this->_matrix(2 * i1 - 1, 2 * i1 - 1)
-                : ((!i1 || this->_matrix(2 * i1 - 1, 2 * i1 - 1).is_infinite())
-                       ? other._matrix(2 * i2 - 1, 2 * i2 - 1)
-                       : this->_matrix(2 * i1 - 1, 2 * i1 - 1));
-        n._matrix(2 * i3 - 1, 2 * i3) =
-            (!i2) ? this->_matrix(2 * i1 - 1, 2 * i1)
-                  : ((!i1 || this->_matrix(2 * i1 - 1, 2 * i1).is_infinite())
-                         ? other._matrix(2 * i2 - 1, 2 * i2)
-                         : this->_matrix(2 * i1 - 1, 2 * i1));
-        n._matrix(2 * i3, 2 * i3 - 1) =
-            (!i2) ? this->_matrix(2 * i1, 2 * i1 - 1)
-                  : ((!i1 || this->_matrix(2 * i1, 2 * i1 - 1).is_infinite())
-                         ? other._matrix(2 * i2, 2 * i2 - 1)
-                         : this->_matrix(2 * i1, 2 * i1 - 1));
-        n._matrix(2 * i3, 2 * i3) =
-            (!i2) ? this->_matrix(2 * i1, 2 * i1)
-                  : ((!i1 || this->_matrix(2 * i1, 2 * i1).is_infinite())
-                         ? other._matrix(2 * i2, 2 * i2)
-                         : this->_matrix(2 * i1, 2 * i1));
-
-        for (auto it2 = it + 1; it2 != n._var_index_map.end(); ++it2) {
-          // Finds the narrowing of each pair of 2x2 relational matrices.
-          testj1 = this->_var_index_map.find(it2->first);
-          testj2 = other._var_index_map.find(it2->first);
-          j3 = it2->second;
-
-          if (testj1 == this->_var_index_map.end()) {
-            j1 = 0;
-          } else {
-            j1 = testj1->second;
-          }
-          if (testj2 == other._var_index_map.end()) {
-            j2 = 0;
-          } else {
-            j2 = testj2->second;
-          }
-
-          if (((i1 && !j1) || (!i1 && j1)) && ((i2 && !j2) || (!i2 && j2))) {
-            continue;
-          }
-          if (i1 > j1) {
-            std::swap(i1, j1);
-          }
-          if (i2 > j2) {
-            std::swap(i2, j2);
-          }
-
-          n._matrix(2 * i3 - 1, 2 * j3 - 1) =
-              (!i2 || !j2)
-                  ? this->_matrix(2 * i1 - 1, 2 * j1 - 1)
-                  : ((!i1 || !j1 ||
-                      this->_matrix(2 * i1 - 1, 2 * j1 - 1).is_infinite())
-                         ? other._matrix(2 * i2 - 1, 2 * j2 - 1)
-                         : this->_matrix(2 * i1 - 1, 2 * j1 - 1));
-          n._matrix(2 * i3 - 1, 2 * j3) =
-              (!i2 || !j2) ? this->_matrix(2 * i1 - 1, 2 * j1)
-                           : ((!i1 || !j1 ||
-                               this->_matrix(2 * i1 - 1, 2 * j1).is_infinite())
-                                  ? other._matrix(2 * i2 - 1, 2 * j2)
-                                  : this->_matrix(2 * i1 - 1, 2 * j1));
-          n._matrix(2 * i3, 2 * j3 - 1) =
-              (!i2 || !j2) ? this->_matrix(2 * i1, 2 * j1 - 1)
-                           : ((!i1 || !j1 ||
-                               this->_matrix(2 * i1, 2 * j1 - 1).is_infinite())
-                                  ? other._matrix(2 * i2, 2 * j2 - 1)
-                                  : this->_matrix(2 * i1, 2 * j1 - 1));
-          n._matrix(2 * i3, 2 * j3) =
-              (!i2 || !j2)
-                  ? this->_matrix(2 * i1, 2 * j1)
-                  : ((!i1 || !j1 || this->_matrix(2 * i1, 2 * j1).is_infinite())
-                         ? other._matrix(2 * i2, 2 * j2)
-                         : this->_matrix(2 * i1, 2 * j1));
-
-          n._matrix(2 * j3 - 1, 2 * i3 - 1) =
-              (!i2 || !j2)
-                  ? this->_matrix(2 * j1 - 1, 2 * i1 - 1)
-                  : ((!i1 || !j1 ||
-                      this->_matrix(2 * j1 - 1, 2 * i1 - 1).is_infinite())
-                         ? other._matrix(2 * j2 - 1, 2 * i2 - 1)
-                         : this->_matrix(2 * j1 - 1, 2 * i1 - 1));
-          n._matrix(2 * j3 - 1, 2 * i3) =
-              (!i2 || !j2) ? this->_matrix(2 * j1 - 1, 2 * i1)
-                           : ((!i1 || !j1 ||
-                               this->_matrix(2 * j1 - 1, 2 * i1).is_infinite())
-                                  ? other._matrix(2 * j2 - 1, 2 * i2)
-                                  : this->_matrix(2 * j1 - 1, 2 * i1));
-          n._matrix(2 * j3, 2 * i3 - 1) =
-              (!i2 || !j2) ? this->_matrix(2 * j1, 2 * i1 - 1)
-                           : ((!i1 || !j1 ||
-                               this->_matrix(2 * j1, 2 * i1 - 1).is_infinite())
-                                  ? other._matrix(2 * j2, 2 * i2 - 1)
-                                  : this->_matrix(2 * j1, 2 * i1 - 1));
-          n._matrix(2 * j3, 2 * i3) =
-              (!i2 || !j2)
-                  ? this->_matrix(2 * j1, 2 * i1)
-                  : ((!i1 || !j1 || this->_matrix(2 * j1, 2 * i1).is_infinite())
-                         ? other._matrix(2 * j2, 2 * i2)
-                         : this->_matrix(2 * j1, 2 * i1));
-        }
-      }
-
       return n;
     }
   }
@@ -983,6 +1000,10 @@ private:
 
   void apply_constraint(MatrixIndex var, bool is_positive, BoundT constraint) {
     // Application of single variable octagonal constraints.
+    // set_to_bottom() clears the matrix, hence var might be out of bounds.
+    if (this->_is_bottom) {
+      return;
+    }
     constraint *= BoundT(2);
     if (is_positive) { // 2*v1 <= constraint
       this->_matrix(2 * var, 2 * var - 1) =
@@ -1004,6 +1025,9 @@ private:
                         bool is2_positive,
                         const BoundT& constraint) {
     // Application of double variable octagonal constraints.
+    if (this->_is_bottom) {
+      return;
+    }
     if (is1_positive && is2_positive) { // v1 + v2 <= constraint
       this->_matrix(2 * j, 2 * i - 1) =
           min(this->_matrix(2 * j, 2 * i - 1), constraint);
@@ -1267,8 +1291,7 @@ private:
       default: { ikos_unreachable("invalid operation"); }
     }
 
-    this->_norm_vector[i - 1] = 0;
-    // Result is not normalized.
+    this->set_unnormalized(i);
   }
 
 public:
@@ -1333,19 +1356,36 @@ public:
   }
 
 private:
-  /// \brief Check satisfiability of cst using intervals
+  /// \brief Add a constraint using intervals
   ///
   /// Only to be used if cst is too hard for octagons
-  bool check_sat(const LinearConstraintT& cst) {
-    IntervalDomainT inv;
+  void add_using_intervals(const LinearConstraintT& cst) {
     this->normalize();
+
+    if (this->_is_bottom) {
+      return;
+    }
+
+    IntervalDomainT inv;
     for (const auto& term : cst) {
       inv.set(term.first, this->to_interval(term.first));
     }
     inv.add(cst);
-    return !inv.is_bottom();
+
+    if (inv.is_bottom()) {
+      this->set_to_bottom();
+      return;
+    }
+
+    for (const auto& term : cst) {
+      this->refine(term.first, inv.to_interval(term.first));
+    }
   }
 
+  /// \brief Return true if the coefficient is accepted in an octagonal
+  /// constraint
+  static bool is_unit(const Number& n) { return n == 1 || n == -1; }
+
 public:
   void add(const LinearConstraintT& cst) override {
     // Does not require normalization.
@@ -1353,83 +1393,54 @@ public:
       return;
     }
 
-    bool v1, v2, is1_positive, is2_positive;
-    v1 = v2 = is1_positive = is2_positive = false;
-    MatrixIndex i, j;
-    i = j = 0;
-    for (const auto& term : cst) {
-      if (!v1) {
-        // Calculates and loads information for the first variable.
-        if (term.second == -1) {
-          is1_positive = false;
-        } else if (term.second == 1) {
-          is1_positive = true;
-        } else {
-          ikos_unreachable(
-              "expr contains unexpected coefficient (accepted values are -1, "
-              "0, and 1).");
-        }
-
-        i = this->_var_index_map.emplace(term.first, _var_index_map.size() + 1)
-                .first->second;
-        v1 = true;
-      } else if (!v2) {
-        // Calculates and loads information for the second variable,
-        // if it exists.
-        if (term.second == -1) {
-          is2_positive = false;
-        } else if (term.second == 1) {
-          is2_positive = true;
-        } else {
-          ikos_unreachable(
-              "expr contains unexpected coefficient (accepted values are -1, "
-              "0, and 1).");
-        }
-
-        j = this->_var_index_map.emplace(term.first, _var_index_map.size() + 1)
-                .first->second;
-        v2 = true;
-      } else {
-        ikos_unreachable("constraint is not an octagon constraint");
-      }
-    }
-    if (!v1) {
+    if (cst.num_terms() == 0) {
       if (cst.is_contradiction()) {
         this->set_to_bottom();
       }
       return;
     }
-    this->resize();
+
+    auto it = cst.begin();
+    auto it2 = std::next(cst.begin());
+
+    if (cst.is_disequation() || cst.num_terms() > 2 || !is_unit(it->second) ||
+        (cst.num_terms() == 2 && !is_unit(it2->second))) {
+      // we use intervals to reason about disequations and non-octagonal
+      // constraints
+      this->add_using_intervals(cst);
+      return;
+    }
+
+    MatrixIndex i =
+        this->_var_index_map.emplace(it->first, _var_index_map.size() + 1)
+            .first->second;
+    bool is1_positive = (it->second == 1);
     BoundT constant(cst.constant()), neg_constant(-cst.constant());
 
-    if (cst.is_inequality()) { // Applies inequality constraints in the form of
-                               // octagonal constraints.
-      if (v1 && !v2) {
-        this->apply_constraint(i, is1_positive, constant);
-      } else /*if(v1 && v2)*/ {
-        this->apply_constraint(i, j, is1_positive, is2_positive, constant);
-      }
-    } else if (cst.is_equality()) { // Applies equality constraints as two
-                                    // octagonal constraints.
-      if (v1 && !v2) {
-        this->apply_constraint(i, is1_positive, constant);
+    if (cst.num_terms() == 1) {
+      this->resize();
+      this->apply_constraint(i, is1_positive, constant);
+      if (cst.is_equality()) {
         this->apply_constraint(i, !is1_positive, neg_constant);
-      } else /*if(v1 && v2)*/ {
-        this->apply_constraint(i, j, is1_positive, is2_positive, constant);
+      }
+      this->set_unnormalized(i);
+    } else {
+      MatrixIndex j =
+          this->_var_index_map.emplace(it2->first, _var_index_map.size() + 1)
+              .first->second;
+      bool is2_positive = (it2->second == 1);
+      this->resize();
+      this->apply_constraint(i, j, is1_positive, is2_positive, constant);
+      if (cst.is_equality()) {
         this->apply_constraint(i,
                                j,
                                !is1_positive,
                                !is2_positive,
                                neg_constant);
       }
-    } else if (cst.is_disequation()) {
-      // we use intervals to reason about disequations
-      if (!this->check_sat(cst)) {
-        this->set_to_bottom();
-        return;
-      }
+      this->set_unnormalized(i);
+      this->set_unnormalized(j);
     }
-    this->_is_normalized = false;
   }
 
   void add(const LinearConstraintSystemT& csts) override {
@@ -1460,6 +1471,7 @@ public:
     this->abstract(x);                               // normalize
     this->apply_constraint(idx, true, value.ub());   // x <= ub
     this->apply_constraint(idx, false, -value.lb()); // -x <= -lb
+    this->set_unnormalized(idx);
   }
 
   void set(VariableRef x, const CongruenceT& value) override {
@@ -1481,17 +1493,43 @@ public:
     this->set(x, value.interval());
   }
 
-  void refine(VariableRef /*x*/, const IntervalT& /*value*/) override {
-    // TODO(marthaud)
+  void refine(VariableRef x, const IntervalT& value) override {
+    if (this->_is_bottom) {
+      return;
+    } else if (value.is_bottom()) {
+      this->set_to_bottom();
+    } else {
+      MatrixIndex idx =
+          this->_var_index_map.emplace(x, this->_var_index_map.size() + 1)
+              .first->second;
+      this->resize();
+      this->apply_constraint(idx, true, value.ub());   // x <= ub
+      this->apply_constraint(idx, false, -value.lb()); // -x <= -lb
+      this->set_unnormalized(idx);
+    }
   }
 
-  void refine(VariableRef /*x*/, const CongruenceT& /*value*/) override {
-    // TODO(marthaud)
+  void refine(VariableRef x, const CongruenceT& value) override {
+    if (this->_is_bottom) {
+      return;
+    } else if (value.is_bottom()) {
+      this->set_to_bottom();
+    } else {
+      IntervalCongruenceT iv(this->to_interval(x), value);
+      this->refine(x, iv.interval());
+    }
   }
 
-  void refine(VariableRef /*x*/,
-              const IntervalCongruenceT& /*value*/) override {
-    // TODO(marthaud)
+  void refine(VariableRef x, const IntervalCongruenceT& value) override {
+    if (this->_is_bottom) {
+      return;
+    } else if (value.is_bottom()) {
+      this->set_to_bottom();
+    } else {
+      IntervalCongruenceT iv(this->to_interval(x));
+      iv.meet_with(value);
+      this->refine(x, iv.interval());
+    }
   }
 
   void forget(VariableRef x) override {
@@ -1505,16 +1543,22 @@ public:
            itz != this->_var_index_map.end();
            ++itz) {
         if (itz->second > n) {
-          this->_var_index_map[itz->first]--;
+          itz->second--;
         }
       }
-      this->_norm_vector.resize(this->_var_index_map.size(), 0);
-      this->_is_normalized = false;
+      // abstract() normalized the matrix, and removing a variable from a
+      // normalized matrix keeps it normalized
+      this->_norm_vector.erase(this->_norm_vector.begin() + (n - 1));
     }
   }
 
   IntervalT to_interval(VariableRef x) const override {
-    // projection requires normalization.
+    // Does not require normalization, but the result is more precise if the
+    // matrix is normalized.
+    if (this->_is_bottom) {
+      return IntervalT::bottom();
+    }
+
     auto it = this->_var_index_map.find(x);
     if (it == this->_var_index_map.end()) {
       return IntervalT::top();
@@ -0,0 +1,1377 @@
+/**************************************************************************/ /**
+ *
+ * \file
+ * \brief Sparse domain of Difference-Bound Matrices
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Based on Graeme Gange, Jorge A. Navas, Peter Schachte, Harald Sondergaard
+ * and Peter J. Stuckey's paper: Exploiting Sparsity in Difference-Bound
+ * Matrices, in SAS, 189-211, 2016.
+ *
+ * Notices:
+ *
+ * Copyright (c) 2018 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <iterator>
+#include <limits>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <boost/container/flat_map.hpp>
+#include <boost/iterator/transform_iterator.hpp>
+
+#include <ikos/core/domain/numeric/abstract_domain.hpp>
+#include <ikos/core/domain/numeric/linear_interval_solver.hpp>
+#include <ikos/core/number/bound.hpp>
+#include <ikos/core/support/assert.hpp>
+#include <ikos/core/value/numeric/congruence.hpp>
+#include <ikos/core/value/numeric/interval.hpp>
+#include <ikos/core/value/numeric/interval_congruence.hpp>
+
+namespace ikos {
+namespace core {
+namespace numeric {
+
+/// \brief Sparse Difference-Bound Matrices abstract domain
+///
+/// Constraints are stored in a sparse weighted graph. Vertex 0 is the special
+/// zero variable, and an edge `i -> j` of weight `c` represents the constraint
+/// `v_j - v_i <= c`. Missing edges are +oo.
+///
+/// The graph is kept closed in split normal form: the edges from and to the
+/// vertex 0 (i.e, the bounds) are tight, and an edge between two variables is
+/// only needed if it is tighter than the one implied by their bounds. Adding a
+/// constraint only updates the predecessors and successors of the new edge,
+/// and forgetting a variable only removes its edges.
+///
+/// Note that this abstract domain is not thread-safe.
+template < typename Number,
+           typename VariableRef,
+           std::size_t MaxReductionCycles = 10 >
+class SparseDBM final
+    : public numeric::AbstractDomain<
+          Number,
+          VariableRef,
+          SparseDBM< Number, VariableRef, MaxReductionCycles > > {
+public:
+  using BoundT = Bound< Number >;
+  using IntervalT = Interval< Number >;
+  using CongruenceT = Congruence< Number >;
+  using IntervalCongruenceT = IntervalCongruence< Number >;
+  using VariableExprT = VariableExpression< Number, VariableRef >;
+  using LinearExpressionT = LinearExpression< Number, VariableRef >;
+  using LinearConstraintT = LinearConstraint< Number, VariableRef >;
+  using LinearConstraintSystemT = LinearConstraintSystem< Number, VariableRef >;
+
+private:
+  /// \brief Index of a variable in the graph
+  using VertexIndex = unsigned;
+
+  // \brief Map from variable to index
+  using VarIndexMap = boost::container::flat_map< VariableRef, VertexIndex >;
+
+  /// \brief Solver
+  using LinearIntervalSolverT =
+      LinearIntervalSolver< Number, VariableRef, SparseDBM >;
+
+  /// \brief Parent
+  using Parent = numeric::AbstractDomain< Number, VariableRef, SparseDBM >;
+
+  /// \brief Marker for an invalid index
+  static VertexIndex none() { return std::numeric_limits< VertexIndex >::max(); }
+
+  class Graph {
+  public:
+    /// \brief Map from vertex to edge weight
+    using EdgeMap = boost::container::flat_map< VertexIndex, Number >;
+
+  private:
+    std::vector< EdgeMap > _succs; // _succs[i][j] = weight of i -> j
+    std::vector< EdgeMap > _preds; // _preds[j][i] = weight of i -> j
+    std::vector< VertexIndex > _free; // unused vertices
+
+  public:
+    /// \brief Create a graph with only the vertex 0
+    Graph() : _succs(1), _preds(1) {}
+
+    /// \brief Copy constructor
+    Graph(const Graph&) = default;
+
+    /// \brief Move constructor
+    Graph(Graph&&) = default;
+
+    /// \brief Copy assignment operator
+    Graph& operator=(const Graph&) = default;
+
+    /// \brief Move assignment operator
+    Graph& operator=(Graph&&) = default;
+
+    /// \brief Destructor
+    ~Graph() = default;
+
+    /// \brief Return the number of vertices, including unused ones
+    VertexIndex num_vertices() const {
+      return static_cast< VertexIndex >(this->_succs.size());
+    }
+
+    /// \brief Return the successors of i
+    const EdgeMap& succs(VertexIndex i) const { return this->_succs[i]; }
+
+    /// \brief Return the predecessors of j
+    const EdgeMap& preds(VertexIndex j) const { return this->_preds[j]; }
+
+    /// \brief Return the weight of i -> j, or +oo
+    BoundT weight(VertexIndex i, VertexIndex j) const {
+      auto it = this->_succs[i].find(j);
+      if (it == this->_succs[i].end()) {
+        return BoundT::plus_infinity();
+      } else {
+        return BoundT(it->second);
+      }
+    }
+
+    /// \brief Set the weight of i -> j
+    void set_edge(VertexIndex i, VertexIndex j, const Number& c) {
+      ikos_assert(i != j);
+      this->_succs[i][j] = c;
+      this->_preds[j][i] = c;
+    }
+
+    /// \brief Set the weight of i -> j to min(weight(i, j), c)
+    void tighten(VertexIndex i, VertexIndex j, const Number& c) {
+      ikos_assert(i != j);
+      auto it = this->_succs[i].find(j);
+      if (it == this->_succs[i].end()) {
+        this->_succs[i].emplace(j, c);
+        this->_preds[j].emplace(i, c);
+      } else if (c < it->second) {
+        it->second = c;
+        this->_preds[j][i] = c;
+      }
+    }
+
+    /// \brief Apply v_i = v_i + c on the edges of i
+    void shift(VertexIndex i, const Number& c) {
+      for (auto& p : this->_succs[i]) {
+        p.second -= c;
+        this->_preds[p.first][i] = p.second;
+      }
+      for (auto& p : this->_preds[i]) {
+        p.second += c;
+        this->_succs[p.first][i] = p.second;
+      }
+    }
+
+    /// \brief Return true if the graph has no edge
+    bool empty() const {
+      for (const EdgeMap& succs : this->_succs) {
+        if (!succs.empty()) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    /// \brief Return a new vertex without any edge
+    VertexIndex add_vertex() {
+      if (!this->_free.empty()) {
+        VertexIndex i = this->_free.back();
+        this->_free.pop_back();
+        return i;
+      }
+
+      this->_succs.emplace_back();
+      this->_preds.emplace_back();
+      return static_cast< VertexIndex >(this->_succs.size() - 1);
+    }
+
+    /// \brief Remove all the edges of i
+    void clear_vertex(VertexIndex i) {
+      for (const auto& p : this->_succs[i]) {
+        this->_preds[p.first].erase(i);
+      }
+      for (const auto& p : this->_preds[i]) {
+        this->_succs[p.first].erase(i);
+      }
+      this->_succs[i].clear();
+      this->_preds[i].clear();
+    }
+
+    /// \brief Remove the vertex i, so that it can be reused
+    void remove_vertex(VertexIndex i) {
+      ikos_assert(i != 0);
+      this->clear_vertex(i);
+      this->_free.push_back(i);
+    }
+
+    /// \brief Remove all the edges, but keep the vertices
+    void clear_edges() {
+      for (EdgeMap& succs : this->_succs) {
+        succs.clear();
+      }
+      for (EdgeMap& preds : this->_preds) {
+        preds.clear();
+      }
+    }
+
+    /// \brief Remove all the vertices, except 0
+    void clear() {
+      this->_succs.resize(1);
+      this->_preds.resize(1);
+      this->_succs[0].clear();
+      this->_preds[0].clear();
+      this->_free.clear();
+    }
+
+  }; // end class Graph
+
+private:
+  bool _is_bottom;
+  bool _is_normalized;
+  Graph _graph;
+  VarIndexMap _var_index_map;
+
+private:
+  struct TopTag {};
+  struct BottomTag {};
+
+  /// \brief Create the top abstract value
+  explicit SparseDBM(TopTag) : _is_bottom(false), _is_normalized(true) {}
+
+  /// \brief Create the bottom abstract value
+  explicit SparseDBM(BottomTag) : _is_bottom(true), _is_normalized(true) {}
+
+public:
+  /// \brief Create the top abstract value
+  SparseDBM() : SparseDBM(TopTag{}) {}
+
+  /// \brief Copy constructor
+  SparseDBM(const SparseDBM&) = default;
+
+  /// \brief Move constructor
+  SparseDBM(SparseDBM&&) = default;
+
+  /// \brief Copy assignment operator
+  SparseDBM& operator=(const SparseDBM&) = default;
+
+  /// \brief Move assignment operator
+  SparseDBM& operator=(SparseDBM&&) = default;
+
+  /// \brief Destructor
+  ~SparseDBM() override = default;
+
+  /// \brief Create the top abstract value
+  static SparseDBM top() { return SparseDBM(TopTag{}); }
+
+  /// \brief Create the bottom abstract value
+  static SparseDBM bottom() { return SparseDBM(BottomTag{}); }
+
+  /// \brief Normalize the graph
+  ///
+  /// This is only needed after a widening or a narrowing, the other operations
+  /// keep the graph closed.
+  void normalize() const override {
+    if (this->_is_normalized) {
+      return;
+    }
+
+    auto self = const_cast< SparseDBM* >(this);
+    self->_is_normalized = true;
+
+    if (this->_is_bottom) {
+      return;
+    }
+
+    // Add all the edges back, one by one
+    std::vector< std::tuple< VertexIndex, VertexIndex, Number > > edges;
+    for (VertexIndex i = 0; i < this->_graph.num_vertices(); i++) {
+      for (const auto& p : this->_graph.succs(i)) {
+        edges.emplace_back(i, p.first, p.second);
+      }
+    }
+
+    self->_graph.clear_edges();
+
+    for (const auto& edge : edges) {
+      self->close_edge(std::get< 0 >(edge),
+                       std::get< 1 >(edge),
+                       std::get< 2 >(edge));
+
+      if (this->_is_bottom) {
+        return;
+      }
+    }
+  }
+
+  bool is_bottom() const override {
+    this->normalize();
+    return this->_is_bottom;
+  }
+
+  bool is_top() const override {
+    // Does not require normalization
+
+    if (this->_is_bottom) {
+      return false;
+    }
+
+    return this->_graph.empty();
+  }
+
+  void set_to_bottom() override {
+    this->_is_bottom = true;
+    this->_is_normalized = true;
+    this->_graph.clear();
+    this->_var_index_map.clear();
+  }
+
+  void set_to_top() override {
+    this->_is_bottom = false;
+    this->_is_normalized = true;
+    this->_graph.clear();
+    this->_var_index_map.clear();
+  }
+
+private:
+  /// \brief Return the tightest bound of v_j - v_i
+  ///
+  /// This requires a normalized graph.
+  BoundT distance(VertexIndex i, VertexIndex j) const {
+    if (i == j) {
+      return BoundT(0);
+    }
+
+    BoundT w = this->_graph.weight(i, j);
+    if (i != 0 && j != 0) {
+      w = min(w, this->_graph.weight(i, 0) + this->_graph.weight(0, j));
+    }
+    return w;
+  }
+
+  /// \brief Return, for each vertex of `other`, the vertex of `this` for the
+  /// same variable, or none()
+  std::vector< VertexIndex > vertex_map(const SparseDBM& other) const {
+    std::vector< VertexIndex > map(other._graph.num_vertices(), none());
+    map[0] = 0;
+
+    // Iterate over this->_var_index_map and other._var_index_map in parallel
+    // This is possible because var_index_map is sorted.
+    for (auto l = this->_var_index_map.begin(),
+              r = other._var_index_map.begin();
+         l != this->_var_index_map.end() && r != other._var_index_map.end();) {
+      if (l->first < r->first) {
+        ++l;
+      } else if (r->first < l->first) {
+        ++r;
+      } else {
+        map[r->second] = l->second;
+        ++l;
+        ++r;
+      }
+    }
+
+    return map;
+  }
+
+public:
+  bool leq(const SparseDBM& other) const override {
+    // Requires normalization
+    this->normalize();
+    other.normalize();
+
+    if (this->_is_bottom) {
+      return true;
+    }
+
+    if (other._is_bottom) {
+      return false;
+    }
+
+    // Relations implied by the bounds of `other` are implied by the bounds of
+    // `this`, hence we only need to check the edges of `other`.
+    std::vector< VertexIndex > map = this->vertex_map(other);
+
+    for (VertexIndex i = 0; i < other._graph.num_vertices(); i++) {
+      for (const auto& p : other._graph.succs(i)) {
+        if (map[i] == none() || map[p.first] == none()) {
+          // v_j - v_i is unbounded in `this`
+          return false;
+        }
+        if (!(this->distance(map[i], map[p.first]) <= BoundT(p.second))) {
+          return false;
+        }
+      }
+    }
+
+    return true;
+  }
+
+  bool equals(const SparseDBM& other) const override {
+    return this->leq(other) && other.leq(*this);
+  }
+
+private:
+  /// \brief Create the result of a binary operation on the common variables of
+  /// `this` and `other`
+  ///
+  /// Set `l_map` and `r_map` to the map from the vertices of `this` and `other`
+  /// to the vertices of the result.
+  SparseDBM common_variables(const SparseDBM& other,
+                             std::vector< VertexIndex >& l_map,
+                             std::vector< VertexIndex >& r_map) const {
+    SparseDBM dbm; // result dbm
+    l_map.assign(this->_graph.num_vertices(), none());
+    r_map.assign(other._graph.num_vertices(), none());
+    l_map[0] = 0;
+    r_map[0] = 0;
+
+    for (auto l = this->_var_index_map.begin(),
+              r = other._var_index_map.begin();
+         l != this->_var_index_map.end() && r != other._var_index_map.end();) {
+      if (l->first < r->first) {
+        ++l;
+      } else if (r->first < l->first) {
+        ++r;
+      } else {
+        VertexIndex k = dbm._graph.add_vertex();
+        dbm._var_index_map.emplace_hint(dbm._var_index_map.end(),
+                                        l->first,
+                                        k);
+        l_map[l->second] = k;
+        r_map[r->second] = k;
+        ++l;
+        ++r;
+      }
+    }
+
+    return dbm;
+  }
+
+public:
+  SparseDBM join(const SparseDBM& other) const override {
+    // Requires normalization
+    this->normalize();
+    other.normalize();
+
+    if (this->_is_bottom) {
+      return other;
+    } else if (other._is_bottom) {
+      return *this;
+    }
+
+    std::vector< VertexIndex > l_map, r_map;
+    SparseDBM dbm = this->common_variables(other, l_map, r_map);
+
+    // Map from the result vertices to the operand vertices
+    std::vector< std::pair< VertexIndex, VertexIndex > > vars(
+        dbm._graph.num_vertices(), {none(), none()});
+    for (VertexIndex i = 0; i < l_map.size(); i++) {
+      if (l_map[i] != none()) {
+        vars[l_map[i]].first = i;
+      }
+    }
+    for (VertexIndex i = 0; i < r_map.size(); i++) {
+      if (r_map[i] != none()) {
+        vars[r_map[i]].second = i;
+      }
+    }
+
+    // Bounds
+    for (VertexIndex k = 1; k < vars.size(); k++) {
+      const auto& v = vars[k];
+      BoundT lb = max(this->_graph.weight(v.first, 0),
+                      other._graph.weight(v.second, 0));
+      BoundT ub = max(this->_graph.weight(0, v.first),
+                      other._graph.weight(0, v.second));
+      if (lb.is_finite()) {
+        dbm._graph.set_edge(k, 0, *lb.number());
+      }
+      if (ub.is_finite()) {
+        dbm._graph.set_edge(0, k, *ub.number());
+      }
+    }
+
+    // Relation between the result vertices i and j
+    auto join_edge = [&](VertexIndex i, VertexIndex j) {
+      BoundT w = max(this->distance(vars[i].first, vars[j].first),
+                     other.distance(vars[i].second, vars[j].second));
+      if (w < dbm.distance(i, j)) {
+        dbm._graph.set_edge(i, j, *w.number());
+      }
+    };
+
+    // Edges between variables, from both operands
+    for (VertexIndex i = 1; i < l_map.size(); i++) {
+      if (l_map[i] == none()) {
+        continue;
+      }
+      for (const auto& p : this->_graph.succs(i)) {
+        if (p.first != 0 && l_map[p.first] != none()) {
+          join_edge(l_map[i], l_map[p.first]);
+        }
+      }
+    }
+    for (VertexIndex i = 1; i < r_map.size(); i++) {
+      if (r_map[i] == none()) {
+        continue;
+      }
+      for (const auto& p : other._graph.succs(i)) {
+        if (p.first != 0 && r_map[p.first] != none()) {
+          join_edge(r_map[i], r_map[p.first]);
+        }
+      }
+    }
+
+    // Relations implied by the bounds in both operands, but not by the bounds
+    // of the result. This happens when the bound of i comes from one operand
+    // and the bound of j comes from the other one.
+    std::vector< VertexIndex > l_lb, r_lb, l_ub, r_ub;
+    for (VertexIndex k = 1; k < vars.size(); k++) {
+      const auto& v = vars[k];
+      BoundT l = this->_graph.weight(v.first, 0);
+      BoundT r = other._graph.weight(v.second, 0);
+      if (l.is_finite() && r.is_finite()) {
+        if (r < l) {
+          l_lb.push_back(k);
+        } else if (l < r) {
+          r_lb.push_back(k);
+        }
+      }
+      l = this->_graph.weight(0, v.first);
+      r = other._graph.weight(0, v.second);
+      if (l.is_finite() && r.is_finite()) {
+        if (r < l) {
+          l_ub.push_back(k);
+        } else if (l < r) {
+          r_ub.push_back(k);
+        }
+      }
+    }
+    for (VertexIndex i : l_lb) {
+      for (VertexIndex j : r_ub) {
+        if (i != j) {
+          join_edge(i, j);
+        }
+      }
+    }
+    for (VertexIndex i : r_lb) {
+      for (VertexIndex j : l_ub) {
+        if (i != j) {
+          join_edge(i, j);
+        }
+      }
+    }
+
+    // The join is normalized by construction
+    return dbm;
+  }
+
+  void join_with(const SparseDBM& other) override {
+    this->operator=(this->join(other));
+  }
+
+private:
+  /// \brief Widening, with an optional threshold
+  SparseDBM widening_impl(const SparseDBM& other,
+                          const BoundT& threshold) const {
+    // Requires the normalization of the right operand.
+    // The left operand (this) should not be normalized.
+    other.normalize();
+
+    if (this->_is_bottom) {
+      return other;
+    } else if (other._is_bottom) {
+      return *this;
+    }
+
+    std::vector< VertexIndex > l_map, r_map;
+    SparseDBM dbm = this->common_variables(other, l_map, r_map);
+
+    // Inverse of r_map
+    std::vector< VertexIndex > r_vertex(dbm._graph.num_vertices(), none());
+    for (VertexIndex i = 0; i < r_map.size(); i++) {
+      if (r_map[i] != none()) {
+        r_vertex[r_map[i]] = i;
+      }
+    }
+
+    // Keep the stable edges of `this`
+    for (VertexIndex i = 0; i < l_map.size(); i++) {
+      if (l_map[i] == none()) {
+        continue;
+      }
+      for (const auto& p : this->_graph.succs(i)) {
+        if (l_map[p.first] == none()) {
+          continue;
+        }
+        VertexIndex k = l_map[i];
+        VertexIndex l = l_map[p.first];
+        BoundT w = other.distance(r_vertex[k], r_vertex[l]);
+        if (w <= BoundT(p.second)) {
+          dbm._graph.set_edge(k, l, p.second);
+        } else if (threshold.is_finite() && w <= threshold) {
+          dbm._graph.set_edge(k, l, *threshold.number());
+        }
+      }
+    }
+
+    dbm._is_normalized = false;
+    return dbm;
+  }
+
+public:
+  SparseDBM widening(const SparseDBM& other) const override {
+    return this->widening_impl(other, BoundT::plus_infinity());
+  }
+
+  void widen_with(const SparseDBM& other) override {
+    this->operator=(this->widening(other));
+  }
+
+  SparseDBM widening_threshold(const SparseDBM& other,
+                               const Number& threshold) const override {
+    return this->widening_impl(other, BoundT(threshold));
+  }
+
+  void widen_threshold_with(const SparseDBM& other,
+                            const Number& threshold) override {
+    this->operator=(this->widening_threshold(other, threshold));
+  }
+
+private:
+  /// \brief Add the edges of `other` to `this`
+  ///
+  /// If `only_unbounded` is true, only add the edges that are +oo in `this`.
+  void add_edges(const SparseDBM& other, bool only_unbounded) {
+    std::vector< VertexIndex > map = this->vertex_map(other);
+    for (const auto& p : other._var_index_map) {
+      if (map[p.second] == none()) {
+        map[p.second] = this->var_index(p.first);
+      }
+    }
+
+    // Collect the edges first, since adding an edge updates `this`
+    std::vector< std::tuple< VertexIndex, VertexIndex, Number > > edges;
+    for (VertexIndex i = 0; i < other._graph.num_vertices(); i++) {
+      for (const auto& p : other._graph.succs(i)) {
+        VertexIndex k = map[i];
+        VertexIndex l = map[p.first];
+        if (!only_unbounded || this->distance(k, l).is_plus_infinity()) {
+          edges.emplace_back(k, l, p.second);
+        }
+      }
+    }
+
+    for (const auto& edge : edges) {
+      this->close_edge(std::get< 0 >(edge),
+                       std::get< 1 >(edge),
+                       std::get< 2 >(edge));
+
+      if (this->_is_bottom) {
+        return;
+      }
+    }
+  }
+
+public:
+  SparseDBM meet(const SparseDBM& other) const override {
+    // Requires normalization
+    this->normalize();
+    other.normalize();
+
+    if (this->_is_bottom || other._is_bottom) {
+      return bottom();
+    } else {
+      SparseDBM dbm(*this);
+      dbm.add_edges(other, /*only_unbounded=*/false);
+      return dbm;
+    }
+  }
+
+  void meet_with(const SparseDBM& other) override {
+    this->operator=(this->meet(other));
+  }
+
+  SparseDBM narrowing(const SparseDBM& other) const override {
+    // Requires normalization
+    this->normalize();
+    other.normalize();
+
+    if (this->_is_bottom || other._is_bottom) {
+      return bottom();
+    } else {
+      SparseDBM dbm(*this);
+      dbm.add_edges(other, /*only_unbounded=*/true);
+      return dbm;
+    }
+  }
+
+  void narrow_with(const SparseDBM& other) override {
+    this->operator=(this->narrowing(other));
+  }
+
+private:
+  /// \brief Get the index of variable x in _graph
+  ///
+  /// Create a new one if not found
+  VertexIndex var_index(VariableRef x) {
+    auto it = this->_var_index_map.find(x);
+    if (it == this->_var_index_map.end()) {
+      VertexIndex i = this->_graph.add_vertex();
+      this->_var_index_map.emplace(x, i);
+      return i;
+    } else {
+      return it->second;
+    }
+  }
+
+  /// \brief Add the edge i -> j of weight c, i.e, v_j - v_i <= c, and restore
+  /// the normal form
+  ///
+  /// The graph is closed before adding the edge, hence a shortest path using
+  /// i -> j is either a path k -> i -> j -> l with explicit edges, or it goes
+  /// through the vertex 0 and it is implied by the new bounds. Only the
+  /// predecessors of i and the successors of j need to be updated.
+  void close_edge(VertexIndex i, VertexIndex j, const Number& c) {
+    ikos_assert(this->_is_normalized);
+    ikos_assert(i != j);
+
+    if (this->distance(j, i) + BoundT(c) < BoundT(0)) {
+      // Negative cycle
+      this->set_to_bottom();
+      return;
+    }
+
+    if (this->distance(i, j) <= BoundT(c)) {
+      return;
+    }
+
+    // Vertices with an explicit path to i, and from j
+    std::vector< std::pair< VertexIndex, Number > > srcs, dsts;
+    srcs.emplace_back(i, Number(0));
+    if (i != 0) {
+      srcs.insert(srcs.end(),
+                  this->_graph.preds(i).begin(),
+                  this->_graph.preds(i).end());
+    }
+    dsts.emplace_back(j, Number(0));
+    if (j != 0) {
+      dsts.insert(dsts.end(),
+                  this->_graph.succs(j).begin(),
+                  this->_graph.succs(j).end());
+    }
+
+    // Update the bounds first
+    for (const auto& src : srcs) {
+      for (const auto& dst : dsts) {
+        if (src.first != dst.first && (src.first == 0 || dst.first == 0)) {
+          this->_graph.tighten(src.first, dst.first, src.second + c + dst.second);
+        }
+      }
+    }
+
+    // Update the relations between variables, unless implied by the bounds
+    for (const auto& src : srcs) {
+      if (src.first == 0) {
+        continue;
+      }
+      for (const auto& dst : dsts) {
+        if (dst.first == 0 || src.first == dst.first) {
+          continue;
+        }
+        Number w = src.second + c + dst.second;
+        if (BoundT(w) < this->_graph.weight(src.first, 0) +
+                            this->_graph.weight(0, dst.first)) {
+          this->_graph.tighten(src.first, dst.first, w);
+        }
+      }
+    }
+  }
+
+  /// \brief Add constraint v_i - v_j <= c
+  void add_constraint(VertexIndex i, VertexIndex j, const BoundT& c) {
+    if (this->_is_bottom || c.is_plus_infinity()) {
+      return;
+    }
+
+    this->close_edge(j, i, *c.number());
+  }
+
+  /// \brief Add constraint v_i - v_j <= c
+  void add_constraint(VertexIndex i, VertexIndex j, const Number& c) {
+    if (this->_is_bottom) {
+      return;
+    }
+
+    this->close_edge(j, i, c);
+  }
+
+  /// \brief Apply v_i = v_i + c
+  void increment(VertexIndex i, const Number& c) {
+    if (c == 0) {
+      return;
+    }
+
+    // The graph stays closed
+    this->_graph.shift(i, c);
+  }
+
+  /// \brief Apply v_i = v_j + c
+  void assign_shift(VertexIndex i, VertexIndex j, const Number& c) {
+    this->_graph.clear_vertex(i);
+
+    // v_i has the same relations as v_j, hence the graph stays closed
+    for (const auto& p : this->_graph.succs(j)) {
+      this->_graph.set_edge(i, p.first, p.second - c);
+    }
+    for (const auto& p : this->_graph.preds(j)) {
+      this->_graph.set_edge(p.first, i, p.second + c);
+    }
+    this->_graph.set_edge(j, i, c);
+    this->_graph.set_edge(i, j, -c);
+  }
+
+  /// \brief Set the bounds of v_i, forgetting all its relations
+  void set_bounds(VertexIndex i, const BoundT& lb, const BoundT& ub) {
+    this->_graph.clear_vertex(i);
+
+    // v_i has no relation, hence the graph stays closed
+    if (ub.is_finite()) {
+      this->_graph.set_edge(0, i, *ub.number());
+    }
+    if (lb.is_finite()) {
+      this->_graph.set_edge(i, 0, -*lb.number());
+    }
+  }
+
+public:
+  void assign(VariableRef x, int n) override { this->assign(x, Number(n)); }
+
+  void assign(VariableRef x, const Number& n) override {
+    this->normalize();
+
+    if (this->_is_bottom) {
+      return;
+    }
+
+    this->set_bounds(this->var_index(x), BoundT(n), BoundT(n));
+  }
+
+  void assign(VariableRef x, VariableRef y) override {
+    this->normalize();
+
+    if (this->_is_bottom) {
+      return;
+    }
+
+    if (x == y) {
+      return;
+    }
+
+    VertexIndex i = this->var_index(x);
+    VertexIndex j = this->var_index(y);
+    this->assign_shift(i, j, Number(0));
+  }
+
+  void assign(VariableRef x, const LinearExpressionT& e) override {
+    this->normalize();
+
+    if (this->_is_bottom) {
+      return;
+    }
+
+    if (e.is_constant()) { // x = c
+      this->set_bounds(this->var_index(x),
+                       BoundT(e.constant()),
+                       BoundT(e.constant()));
+      return;
+    }
+
+    if (e.num_terms() == 1 && e.begin()->second == 1) { // x = y + c
+      VertexIndex i = this->var_index(x);
+      VariableRef y = e.begin()->first;
+      const Number& c = e.constant();
+
+      if (x == y) { // x = x + c
+        this->increment(i, c);
+      } else {
+        VertexIndex j = this->var_index(y);
+        this->assign_shift(i, j, c);
+      }
+      return;
+    }
+
+    // Projection using intervals
+    this->set(x, this->to_interval(e));
+  }
+
+  void apply(BinaryOperator op,
+             VariableRef x,
+             VariableRef y,
+             VariableRef z) override {
+    this->normalize();
+
+    if (this->_is_bottom) {
+      return;
+    }
+
+    IntervalT v_y = this->to_interval(y);
+    IntervalT v_z = this->to_interval(z);
+
+    if (v_z.singleton()) {
+      this->apply(op, x, y, *v_z.singleton());
+    } else if (v_y.singleton()) {
+      this->apply(op, x, *v_y.singleton(), z);
+    } else {
+      this->set(x, apply_bin_operator(op, v_y, v_z));
+    }
+  }
+
+  void apply(BinaryOperator op,
+             VariableRef x,
+             VariableRef y,
+             const Number& z) override {
+    this->normalize();
+
+    if (this->_is_bottom) {
+      return;
+    }
+
+    switch (op) {
+      case BinaryOperator::Add: {
+        VertexIndex i = this->var_index(x);
+        if (x == y) { // x = x + z
+          this->increment(i, z);
+        } else { // x = y + z
+          this->assign_shift(i, this->var_index(y), z);
+        }
+      } break;
+      case BinaryOperator::Sub: {
+        VertexIndex i = this->var_index(x);
+        if (x == y) { // x = x - z
+          this->increment(i, -z);
+        } else { // x = y - z
+          this->assign_shift(i, this->var_index(y), -z);
+        }
+      } break;
+      case BinaryOperator::Mul: {
+        if (z == 1) { // x = y
+          this->assign(x, y);
+        } else {
+          this->set(x, this->to_interval(y) * IntervalT(z));
+        }
+      } break;
+      case BinaryOperator::Div: {
+        if (z == 1) { // x = y
+          this->assign(x, y);
+        } else {
+          this->set(x, this->to_interval(y) / IntervalT(z));
+        }
+      } break;
+      case BinaryOperator::Mod: {
+        if (z == 0) {
+          this->set_to_bottom();
+          return;
+        }
+
+        IntervalT v_y = this->to_interval(y);
+        boost::optional< Number > n = v_y.mod_to_sub(z);
+
+        if (n) {
+          // Equivalent to x = y - n
+          VertexIndex i = this->var_index(x);
+          if (x == y) { // x = x - n
+            this->increment(i, -(*n));
+          } else { // x = y - n
+            this->assign_shift(i, this->var_index(y), -(*n));
+          }
+        } else {
+          this->set(x, IntervalT(BoundT(0), BoundT(abs(z) - 1)));
+        }
+      } break;
+      case BinaryOperator::Rem:
+      case BinaryOperator::Shl:
+      case BinaryOperator::Shr:
+      case BinaryOperator::And:
+      case BinaryOperator::Or:
+      case BinaryOperator::Xor: {
+        this->set(x,
+                  apply_bin_operator(op, this->to_interval(y), IntervalT(z)));
+      } break;
+    }
+  }
+
+  void apply(BinaryOperator op,
+             VariableRef x,
+             const Number& y,
+             VariableRef z) override {
+    this->normalize();
+
+    if (this->_is_bottom) {
+      return;
+    }
+
+    switch (op) {
+      case BinaryOperator::Add: {
+        VertexIndex i = this->var_index(x);
+        if (x == z) { // x = y + x
+          this->increment(i, y);
+        } else { // x = y + z
+          this->assign_shift(i, this->var_index(z), y);
+        }
+      } break;
+      case BinaryOperator::Sub: {
+        this->set(x, IntervalT(y) - this->to_interval(z));
+      } break;
+      case BinaryOperator::Mul: {
+        if (y == 1) { // x = z
+          this->assign(x, z);
+        } else {
+          this->set(x, IntervalT(y) * this->to_interval(z));
+        }
+      } break;
+      case BinaryOperator::Div:
+      case BinaryOperator::Rem:
+      case BinaryOperator::Mod:
+      case BinaryOperator::Shl:
+      case BinaryOperator::Shr:
+      case BinaryOperator::And:
+      case BinaryOperator::Or:
+      case BinaryOperator::Xor: {
+        this->set(x,
+                  apply_bin_operator(op, IntervalT(y), this->to_interval(z)));
+      } break;
+    }
+  }
+
+private:
+  /// \brief Add a constraint of the form `x <= c`, `-x <= c` or `x - y <= c`
+  ///
+  /// Return false if the constraint is not a difference constraint.
+  bool add_difference(const LinearConstraintT& cst) {
+    auto it = cst.begin();
+    auto it2 = std::next(cst.begin());
+    VertexIndex i, j;
+    const Number& c = cst.constant();
+
+    if (cst.num_terms() == 1 && it->second == 1) {
+      i = this->var_index(it->first);
+      j = 0;
+    } else if (cst.num_terms() == 1 && it->second == -1) {
+      i = 0;
+      j = this->var_index(it->first);
+    } else if (cst.num_terms() == 2 && it->second == 1 && it2->second == -1) {
+      i = this->var_index(it->first);
+      j = this->var_index(it2->first);
+    } else if (cst.num_terms() == 2 && it->second == -1 && it2->second == 1) {
+      i = this->var_index(it2->first);
+      j = this->var_index(it->first);
+    } else {
+      return false;
+    }
+
+    if (cst.is_inequality()) {
+      this->add_constraint(i, j, c);
+    } else {
+      this->add_constraint(i, j, c);
+      this->add_constraint(j, i, -c);
+    }
+    return true;
+  }
+
+public:
+  void add(const LinearConstraintT& cst) override {
+    this->normalize();
+
+    if (this->_is_bottom) {
+      return;
+    }
+
+    if (cst.num_terms() == 0) {
+      if (cst.is_contradiction()) {
+        this->set_to_bottom();
+      }
+      return;
+    }
+
+    if ((cst.is_inequality() || cst.is_equality()) &&
+        this->add_difference(cst)) {
+      return;
+    }
+
+    // use the linear interval solver
+    LinearIntervalSolverT solver(MaxReductionCycles);
+    solver.add(cst);
+    solver.run(*this);
+  }
+
+  void add(const LinearConstraintSystemT& csts) override {
+    this->normalize();
+
+    if (this->_is_bottom) {
+      return;
+    }
+
+    LinearIntervalSolverT solver(MaxReductionCycles);
+
+    for (const LinearConstraintT& cst : csts) {
+      // process each constraint
+      if (cst.num_terms() == 0) {
+        if (cst.is_contradiction()) {
+          this->set_to_bottom();
+          return;
+        }
+      } else if (cst.is_inequality() || cst.is_equality()) {
+        if (!this->add_difference(cst)) {
+          solver.add(cst);
+        }
+      } else {
+        solver.add(cst);
+      }
+
+      if (this->_is_bottom) {
+        return;
+      }
+    }
+
+    if (!solver.empty()) {
+      // use the linear interval solver
+      solver.run(*this);
+    }
+  }
+
+  void set(VariableRef x, const IntervalT& value) override {
+    this->normalize();
+
+    if (this->_is_bottom) {
+      return;
+    } else if (value.is_bottom()) {
+      this->set_to_bottom();
+    } else {
+      this->set_bounds(this->var_index(x), value.lb(), value.ub());
+    }
+  }
+
+  void set(VariableRef x, const CongruenceT& value) override {
+    this->normalize();
+
+    if (this->_is_bottom) {
+      return;
+    } else if (value.is_bottom()) {
+      this->set_to_bottom();
+    } else {
+      boost::optional< Number > n = value.singleton();
+      if (n) {
+        this->set_bounds(this->var_index(x), BoundT(*n), BoundT(*n));
+      } else {
+        this->forget(x);
+      }
+    }
+  }
+
+  void set(VariableRef x, const IntervalCongruenceT& value) override {
+    this->set(x, value.interval());
+  }
+
+  void refine(VariableRef x, const IntervalT& value) override {
+    this->normalize();
+
+    if (this->_is_bottom) {
+      return;
+    } else if (value.is_bottom()) {
+      this->set_to_bottom();
+    } else {
+      VertexIndex i = this->var_index(x);
+      this->add_constraint(i, 0, value.ub());
+      this->add_constraint(0, i, -value.lb());
+    }
+  }
+
+  void refine(VariableRef x, const CongruenceT& value) override {
+    if (this->is_bottom()) {
+      return;
+    } else if (value.is_bottom()) {
+      this->set_to_bottom();
+    } else {
+      IntervalCongruenceT iv(this->to_interval(x), value);
+      this->refine(x, iv.interval());
+    }
+  }
+
+  void refine(VariableRef x, const IntervalCongruenceT& value) override {
+    if (this->is_bottom()) {
+      return;
+    } else if (value.is_bottom()) {
+      this->set_to_bottom();
+    } else {
+      IntervalCongruenceT iv(this->to_interval(x));
+      iv.meet_with(value);
+      this->refine(x, iv.interval());
+    }
+  }
+
+  void forget(VariableRef x) override {
+    this->normalize();
+
+    if (this->_is_bottom) {
+      return;
+    }
+
+    auto it = this->_var_index_map.find(x);
+    if (it != this->_var_index_map.end()) {
+      // The graph is closed, so removing a vertex keeps it closed
+      this->_graph.remove_vertex(it->second);
+      this->_var_index_map.erase(it);
+    }
+  }
+
+private:
+  struct GetVar {
+    const VariableRef& operator()(
+        const std::pair< VariableRef, VertexIndex >& p) const {
+      return p.first;
+    }
+  };
+
+public:
+  /// \brief Iterator over a list of variables
+  using VariableIterator =
+      boost::transform_iterator< GetVar, typename VarIndexMap::const_iterator >;
+
+  /// \brief Begin iterator over the list of variables
+  VariableIterator var_begin() const {
+    return boost::make_transform_iterator(this->_var_index_map.cbegin(),
+                                          GetVar());
+  }
+
+  /// \brief End iterator over the list of variables
+  VariableIterator var_end() const {
+    return boost::make_transform_iterator(this->_var_index_map.cend(),
+                                          GetVar());
+  }
+
+  IntervalT to_interval(VariableRef x) const override {
+    this->normalize();
+
+    if (this->_is_bottom) {
+      return IntervalT::bottom();
+    } else {
+      auto it = this->_var_index_map.find(x);
+
+      if (it == this->_var_index_map.cend()) {
+        return IntervalT::top();
+      } else {
+        return IntervalT(-this->_graph.weight(it->second, 0),
+                         this->_graph.weight(0, it->second));
+      }
+    }
+  }
+
+  IntervalT to_interval(const LinearExpressionT& e) const override {
+    return Parent::to_interval(e);
+  }
+
+  CongruenceT to_congruence(VariableRef x) const override {
+    if (this->is_bottom()) {
+      return CongruenceT::bottom();
+    } else {
+      boost::optional< Number > n = this->to_interval(x).singleton();
+      if (n) {
+        return CongruenceT(*n);
+      } else {
+        return CongruenceT::top();
+      }
+    }
+  }
+
+  CongruenceT to_congruence(const LinearExpressionT& e) const override {
+    return Parent::to_congruence(e);
+  }
+
+  IntervalCongruenceT to_interval_congruence(VariableRef x) const override {
+    return IntervalCongruenceT(this->to_interval(x));
+  }
+
+  IntervalCongruenceT to_interval_congruence(
+      const LinearExpressionT& e) const override {
+    return Parent::to_interval_congruence(e);
+  }
+
+  LinearConstraintSystemT to_linear_constraint_system() const override {
+    this->normalize();
+
+    if (this->_is_bottom) {
+      return LinearConstraintSystemT(LinearConstraintT::contradiction());
+    }
+
+    std::vector< const VariableRef* > vars(this->_graph.num_vertices(),
+                                           nullptr);
+    for (const auto& p : this->_var_index_map) {
+      vars[p.second] = &p.first;
+    }
+
+    LinearConstraintSystemT csts;
+    for (const auto& p : this->_var_index_map) {
+      csts.add(within_interval(p.first,
+                               IntervalT(-this->_graph.weight(p.second, 0),
+                                         this->_graph.weight(0, p.second))));
+
+      // Explicit relations, v_j - v_i <= c
+      for (const auto& q : this->_graph.succs(p.second)) {
+        if (q.first != 0) {
+          csts.add(VariableExprT(*vars[q.first]) - VariableExprT(p.first) <=
+                   q.second);
+        }
+      }
+    }
+
+    return csts;
+  }
+
+  void dump(std::ostream& o) const override {
+    this->to_linear_constraint_system().dump(o);
+  }
+
+  static std::string name() { return "sparse-dbm"; }
+
+}; // end class SparseDBM
+
+} // end namespace numeric
+} // end namespace core
+} // end namespace ikos
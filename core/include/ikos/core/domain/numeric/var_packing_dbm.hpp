@@ -46,6 +46,8 @@
 
 #pragma once
 
+#include <iterator>
+
 #include <ikos/core/domain/numeric/abstract_domain.hpp>
 #include <ikos/core/domain/numeric/dbm.hpp>
 #include <ikos/core/domain/numeric/linear_interval_solver.hpp>
@@ -266,7 +268,7 @@ public:
     }
 
     auto it = cst.begin();
-    auto it2 = ++cst.begin();
+    auto it2 = std::next(cst.begin());
 
     if ((cst.is_inequality() || cst.is_equality()) &&
         ((cst.num_terms() == 1 && it->second == 1) ||
@@ -303,7 +305,7 @@ public:
         }
       } else if (cst.is_inequality() || cst.is_equality()) {
         auto it = cst.begin();
-        auto it2 = ++cst.begin();
+        auto it2 = std::next(cst.begin());
 
         if ((cst.num_terms() == 1 && it->second == 1) ||
             (cst.num_terms() == 1 && it->second == -1) ||
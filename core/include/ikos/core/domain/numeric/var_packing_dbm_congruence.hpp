@@ -45,6 +45,8 @@
 
 #pragma once
 
+#include <iterator>
+
 #include <ikos/core/domain/numeric/abstract_domain.hpp>
 #include <ikos/core/domain/numeric/congruence.hpp>
 #include <ikos/core/domain/numeric/domain_product.hpp>
@@ -90,9 +92,7 @@ private:
   /// \brief Reduce the equivalence class containing the variable `v`
   ///
   /// Does not normalize the entire domain.
-  ///
-  /// `need_copy` is false if we know that a copy has already been made.
-  void reduce_equivalence_class(VariableRef v, bool need_copy = true) {
+  void reduce_equivalence_class(VariableRef v) {
     if (this->_product.first()._inv._is_bottom ||
         this->_product.second().is_bottom()) {
       return;
@@ -104,8 +104,9 @@ private:
       return;
     }
 
-    std::shared_ptr< DBM< Number, VariableRef > > subdomain =
-        equiv_relation.find_domain(v);
+    DBM< Number, VariableRef >* subdomain =
+        equiv_relation.find_domain(v).get();
+    bool need_copy = true;
     subdomain->normalize();
 
     if (subdomain->is_bottom()) {
@@ -138,9 +139,8 @@ private:
 
         if (val.interval() != i) {
           if (need_copy) {
-            // need to copy the subdomain before updating it
-            equiv_relation.find_equiv_class(v).copy_domain();
-            subdomain = equiv_relation.find_domain(v);
+            // need to copy the subdomain before updating it, if it is shared
+            subdomain = &equiv_relation.find_domain_ref(v);
             need_copy = false;
           }
 
@@ -293,12 +293,12 @@ public:
 
   void assign(VariableRef x, VariableRef y) override {
     this->_product.assign(x, y);
-    this->reduce_equivalence_class(x, false);
+    this->reduce_equivalence_class(x);
   }
 
   void assign(VariableRef x, const LinearExpressionT& e) override {
     this->_product.assign(x, e);
-    this->reduce_equivalence_class(x, false);
+    this->reduce_equivalence_class(x);
   }
 
   void apply(BinaryOperator op,
@@ -306,7 +306,7 @@ public:
              VariableRef y,
              VariableRef z) override {
     this->_product.apply(op, x, y, z);
-    this->reduce_equivalence_class(x, false);
+    this->reduce_equivalence_class(x);
   }
 
   void apply(BinaryOperator op,
@@ -314,7 +314,7 @@ public:
              VariableRef y,
              const Number& z) override {
     this->_product.apply(op, x, y, z);
-    this->reduce_equivalence_class(x, false);
+    this->reduce_equivalence_class(x);
   }
 
   void apply(BinaryOperator op,
@@ -322,7 +322,7 @@ public:
              const Number& y,
              VariableRef z) override {
     this->_product.apply(op, x, y, z);
-    this->reduce_equivalence_class(x, false);
+    this->reduce_equivalence_class(x);
   }
 
   void add(const LinearConstraintT& cst) override {
@@ -338,7 +338,7 @@ public:
     }
 
     auto it = cst.begin();
-    auto it2 = ++cst.begin();
+    auto it2 = std::next(cst.begin());
 
     if ((cst.is_inequality() || cst.is_equality()) &&
         ((cst.num_terms() == 1 && it->second == 1) ||
@@ -346,7 +346,7 @@ public:
          (cst.num_terms() == 2 && it->second == 1 && it2->second == -1) ||
          (cst.num_terms() == 2 && it->second == -1 && it2->second == 1))) {
       // variables are together in the same equivalence class
-      this->reduce_equivalence_class(it->first, false);
+      this->reduce_equivalence_class(it->first);
     } else {
       for (const auto& term : cst) {
         this->reduce_equivalence_class(term.first);
@@ -367,7 +367,7 @@ public:
         continue;
       } else {
         auto it = cst.begin();
-        auto it2 = ++cst.begin();
+        auto it2 = std::next(cst.begin());
 
         if ((cst.is_inequality() || cst.is_equality()) &&
             ((cst.num_terms() == 1 && it->second == 1) ||
@@ -375,7 +375,7 @@ public:
              (cst.num_terms() == 2 && it->second == 1 && it2->second == -1) ||
              (cst.num_terms() == 2 && it->second == -1 && it2->second == 1))) {
           // variables are together in the same equivalence class
-          this->reduce_equivalence_class(it->first, false);
+          this->reduce_equivalence_class(it->first);
         } else {
           for (const auto& term : cst) {
             this->reduce_equivalence_class(term.first);
@@ -53,15 +53,20 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <unordered_map>
 
 #include <boost/container/flat_set.hpp>
+#include <boost/functional/hash.hpp>
 #include <boost/iterator/transform_iterator.hpp>
 #include <boost/optional.hpp>
 
+#include <ikos/core/adt/patricia_tree/map.hpp>
 #include <ikos/core/domain/numeric/abstract_domain.hpp>
+#include <ikos/core/domain/numeric/linear_interval_solver.hpp>
 #include <ikos/core/semantic/indexable.hpp>
+#include <ikos/core/semantic/packable.hpp>
 #include <ikos/core/support/assert.hpp>
 #include <ikos/core/value/numeric/congruence.hpp>
 #include <ikos/core/value/numeric/interval.hpp>
@@ -87,6 +92,12 @@ class VarPackingDBMCongruence;
 /// The idea is to keep a set of equivalence classes, using the union-find
 /// structure. Each equivalence class holds an abstract domain over all
 /// variables within the class.
+///
+/// Variables can have a syntactic pack (see PackableTraits). Variables of
+/// different packs are never merged in the same equivalence class: a transfer
+/// function that would relate them is computed with intervals instead. This
+/// bounds the size of the equivalence classes. Variables without a pack can
+/// be merged with any equivalence class.
 template < typename Number, typename VariableRef, typename Domain >
 class VarPackingDomain final
     : public numeric::AbstractDomain<
@@ -131,10 +142,53 @@ private:
   using Parent =
       numeric::AbstractDomain< Number, VariableRef, VarPackingDomain >;
 
+  /// \brief Traits for the syntactic packs
+  using PackableTrait = PackableTraits< VariableRef >;
+
+  /// \brief Linear interval solver, for constraints between different packs
+  using LinearIntervalSolverT =
+      LinearIntervalSolver< Number, VariableRef, VarPackingDomain >;
+
+  /// \brief Maximum number of cycles of the linear interval solver
+  static constexpr std::size_t MaxReductionCycles = 10;
+
   /*
    * Implementation of Union-Find
+   *
+   * The parent and class tables are persistent patricia tree maps, thus
+   * copying a VarPackingDomain is O(1), and binary operations on values
+   * sharing most of their tables only visit the classes that differ.
    */
 
+  /// \brief Owner of an abstract domain
+  ///
+  /// Each equivalence relation has an owner identifier, shared by its copies
+  /// until one of them is updated, see EquivalenceRelation::exclusive_owner().
+  /// An abstract domain tagged with the owner of a relation that is the only
+  /// holder of its owner is only referenced by this relation, and can be
+  /// updated in place.
+  using Owner = std::size_t;
+
+  /// \brief Owner of an abstract domain that might be shared
+  static constexpr Owner NoOwner = 0;
+
+  /// \brief Return a new unique owner
+  static Owner new_owner() {
+    static std::atomic< Owner > counter(NoOwner);
+    return ++counter;
+  }
+
+  /// \brief Owner shared by the copies of an equivalence relation
+  struct OwnerToken {
+    Owner id;
+
+    // True if a relation holding this token got a new owner, so that the
+    // other holders might still reference domains tagged with `id`
+    std::atomic< bool > revoked;
+
+    explicit OwnerToken(Owner id_) : id(id_), revoked(false) {}
+  };
+
   // forward declaration
   class EquivalenceRelation;
 
@@ -146,6 +200,12 @@ private:
     std::size_t rank;
     DomainPtr domain;
 
+    // Syntactic pack of the variables, or boost::none
+    boost::optional< PackId > pack;
+
+    // Owner of the domain, or NoOwner
+    Owner owner;
+
     // TODO(marthaud): We could store the list of variables in the class
 
     // Note: The reason why sometimes we explicitly call domain->normalize() is
@@ -153,9 +213,9 @@ private:
     // do that, some methods will normalize a copy.
 
   public:
-    /// \brief Create an empty equivalence class
-    explicit EquivalenceClass()
-        : rank(0), domain(std::make_shared< Domain >()) {}
+    /// \brief Create an empty equivalence class owned by `owner_`
+    explicit EquivalenceClass(Owner owner_)
+        : rank(0), domain(std::make_shared< Domain >()), owner(owner_) {}
 
     /// \brief Copy constructor
     EquivalenceClass(const EquivalenceClass&) noexcept = default;
@@ -172,13 +232,18 @@ private:
     /// \brief Destructor
     ~EquivalenceClass() = default;
 
-    /// \brief Copy before a write
-    void copy_domain() {
-      // XXX(marthaud): This is not thread safe.
-      if (this->domain.use_count() == 1) {
-        return; // copy is unnecessary
-      }
-      this->domain = std::make_shared< Domain >(*this->domain);
+    /// \brief Equality comparison, required by PatriciaTreeMap
+    bool operator==(const EquivalenceClass& other) const {
+      return this->rank == other.rank && this->domain == other.domain &&
+             this->pack == other.pack && this->owner == other.owner;
+    }
+
+    /// \brief Hash function, used by the hash-consing of PatriciaTreeMap
+    friend std::size_t hash_value(const EquivalenceClass& c) {
+      std::size_t hash = 0;
+      boost::hash_combine(hash, c.domain.get());
+      boost::hash_combine(hash, c.owner);
+      return hash;
     }
 
   }; // end class EquivalenceClass
@@ -188,10 +253,8 @@ private:
   /// Hold the equivalence classes
   class EquivalenceRelation {
   private:
-    using ParentMap =
-        std::unordered_map< VariableRef, VariableRef, VariableRefHash >;
-    using ClassMap =
-        std::unordered_map< VariableRef, EquivalenceClass, VariableRefHash >;
+    using ParentMap = PatriciaTreeMap< VariableRef, VariableRef >;
+    using ClassMap = PatriciaTreeMap< VariableRef, EquivalenceClass >;
 
   private:
     // Map from variable to parent
@@ -200,31 +263,66 @@ private:
     // Map from root variable to equivalence class
     ClassMap _classes;
 
-    // Note: We are using at(key) instead of operator[](key) because VariableRef
-    // may not have a default constructor
+    // Owner of the domains updated by this relation, shared with the copies
+    std::shared_ptr< OwnerToken > _owner;
+
+    // Note: There is no path compression, since it would require to update
+    // the persistent parent map on lookups. The union by rank keeps the trees
+    // of logarithmic depth.
 
   public:
     /// \brief Create an empty equivalence relation
-    explicit EquivalenceRelation() = default;
+    explicit EquivalenceRelation()
+        : _owner(std::make_shared< OwnerToken >(new_owner())) {}
 
     /// \brief Copy constructor
+    ///
+    /// The copy shares the owner of `other`, thus neither updates the domains
+    /// in place until it gets a new owner, see exclusive_owner().
     EquivalenceRelation(const EquivalenceRelation&) = default;
 
     /// \brief Move constructor
-    EquivalenceRelation(EquivalenceRelation&&) = default;
+    EquivalenceRelation(EquivalenceRelation&&) noexcept = default;
 
     /// \brief Copy assignment operator
     EquivalenceRelation& operator=(const EquivalenceRelation&) = default;
 
     /// \brief Move assignment operator
-    EquivalenceRelation& operator=(EquivalenceRelation&&) = default;
+    EquivalenceRelation& operator=(EquivalenceRelation&&) noexcept = default;
 
     /// \brief Destructor
     ~EquivalenceRelation() = default;
 
+  private:
+    /// \brief Return the owner of the domains updated by this relation
+    ///
+    /// If the owner is shared with a copy, or was shared with a copy that got
+    /// a new owner, a new owner is created first. Thus, the domains referenced
+    /// by a copy are never updated in place.
+    Owner exclusive_owner() {
+      if (this->_owner == nullptr || this->_owner.use_count() > 1 ||
+          this->_owner->revoked) {
+        if (this->_owner != nullptr) {
+          this->_owner->revoked = true;
+        }
+        this->_owner = std::make_shared< OwnerToken >(new_owner());
+      }
+      return this->_owner->id;
+    }
+
+  public:
     /// \brief Return true if the equivalence relation contains `v`
     bool contains(VariableRef v) const {
-      return this->_parents.find(v) != this->_parents.end();
+      return static_cast< bool >(this->_parents.at(v));
+    }
+
+    /// \brief Return true if both relations have the same equivalence classes,
+    /// with the same root variables
+    bool same_classes(const EquivalenceRelation& other) const {
+      return this->_parents.equals(other._parents,
+                                   [](VariableRef x, VariableRef y) {
+                                     return x == y;
+                                   });
     }
 
     /// \brief Create an equivalence class containing the given variable
@@ -232,8 +330,10 @@ private:
     /// Precondition: `v` is not already present in the relation
     void add_equiv_class(VariableRef v) {
       ikos_assert_msg(!this->contains(v), "variable already present");
-      this->_parents.emplace(v, v);
-      this->_classes.emplace(v, EquivalenceClass());
+      EquivalenceClass equiv_class(this->exclusive_owner());
+      equiv_class.pack = PackableTrait::pack(v);
+      this->_parents.insert_or_assign(v, v);
+      this->_classes.insert_or_assign(v, equiv_class);
     }
 
     /// \brief Add a variable in an equivalence class
@@ -245,54 +345,118 @@ private:
       ikos_assert_msg(this->contains(parent), "variable missing");
 
       VariableRef parent_root = this->find_root_var(parent);
-      EquivalenceClass& parent_class = this->_classes[parent_root];
+      const EquivalenceClass& parent_class = *this->_classes.at(parent_root);
 
-      if (parent_class.rank == 0) {
-        parent_class.rank++;
+      if (parent_class.rank == 0 || !parent_class.pack) {
+        EquivalenceClass new_class = parent_class;
+        if (new_class.rank == 0) {
+          new_class.rank++;
+        }
+        if (!new_class.pack) {
+          new_class.pack = PackableTrait::pack(v);
+        }
+        this->_classes.insert_or_assign(parent_root, new_class);
       }
-      this->_parents.emplace(v, parent_root);
+      this->_parents.insert_or_assign(v, parent_root);
     }
 
     /// \brief Find the root of the equivalence class containing `v`
-    VariableRef find_root_var(VariableRef v) {
-      VariableRef& parent = this->_parents.at(v);
-
-      if (parent == v) {
-        return v;
-      } else {
-        return parent = this->find_root_var(parent);
+    VariableRef find_root_var(VariableRef v) const {
+      for (;;) {
+        VariableRef parent = *this->_parents.at(v);
+        if (parent == v) {
+          return v;
+        }
+        v = parent;
       }
     }
 
-    /// \brief Find the root of the equivalence class containing `v`
-    VariableRef cfind_root_var(VariableRef v) const {
-      VariableRef parent = this->_parents.at(v);
+    /// \brief Find the equivalence class containing `v`
+    const EquivalenceClass& find_equiv_class(VariableRef v) const {
+      return *this->_classes.at(this->find_root_var(v));
+    }
 
-      if (parent == v) {
-        return v;
+    /// \brief Find the syntactic pack of the equivalence class containing `v`
+    ///
+    /// Returns the pack of `v` if it is not in the relation.
+    boost::optional< PackId > find_pack(VariableRef v) const {
+      if (this->contains(v)) {
+        return this->find_equiv_class(v).pack;
       } else {
-        return this->cfind_root_var(parent);
+        return PackableTrait::pack(v);
       }
     }
 
-    /// \brief Find the equivalence class containing `v`
-    EquivalenceClass& find_equiv_class(VariableRef v) {
-      return this->_classes[this->find_root_var(v)];
+    /// \brief Find the abstract domain containing `v`
+    const DomainPtr& find_domain(VariableRef v) const {
+      return this->find_equiv_class(v).domain;
     }
 
-    /// \brief Find the equivalence class containing `v`
-    const EquivalenceClass& cfind_equiv_class(VariableRef v) const {
-      return this->_classes.at(this->cfind_root_var(v));
+    /// \brief Find the abstract domain containing `v`, before a write
+    ///
+    /// The abstract domain is copied if it might be shared.
+    Domain& find_domain_ref(VariableRef v) {
+      VariableRef root = this->find_root_var(v);
+      const EquivalenceClass& equiv_class = *this->_classes.at(root);
+
+      Owner owner = this->exclusive_owner();
+
+      if (equiv_class.owner == owner) {
+        return *equiv_class.domain; // copy is unnecessary
+      }
+
+      EquivalenceClass new_class = equiv_class;
+      new_class.domain = std::make_shared< Domain >(*equiv_class.domain);
+      new_class.owner = owner;
+      Domain& domain = *new_class.domain;
+      this->_classes.insert_or_assign(root, new_class);
+      return domain;
     }
 
-    /// \brief Find the abstract domain containing `v`
-    const DomainPtr& find_domain(VariableRef v) {
-      return this->find_equiv_class(v).domain;
+    /// \brief Set the abstract domain of the equivalence class containing `v`
+    void set_domain(VariableRef v, Domain domain) {
+      VariableRef root = this->find_root_var(v);
+      EquivalenceClass new_class = *this->_classes.at(root);
+      new_class.domain = std::make_shared< Domain >(std::move(domain));
+      new_class.owner = this->exclusive_owner();
+      this->_classes.insert_or_assign(root, new_class);
     }
 
-    /// \brief Find the abstract domain containing `v`
-    const DomainPtr& cfind_domain(VariableRef v) const {
-      return this->cfind_equiv_class(v).domain;
+    /// \brief Share the abstract domain of another equivalence relation with
+    /// the equivalence class containing `v`
+    void share_domain(VariableRef v, const DomainPtr& domain) {
+      VariableRef root = this->find_root_var(v);
+      EquivalenceClass new_class = *this->_classes.at(root);
+      new_class.domain = domain;
+      new_class.owner = NoOwner;
+      this->_classes.insert_or_assign(root, new_class);
+    }
+
+    /// \brief Apply a binary operation on the abstract domains of two
+    /// relations with the same equivalence classes
+    ///
+    /// Precondition: `this->same_classes(other)`
+    ///
+    /// Subtrees shared by both class maps are not visited.
+    template < typename BinaryOperator >
+    void apply_binary_op(const EquivalenceRelation& other,
+                         const BinaryOperator& op) {
+      Owner owner = this->exclusive_owner();
+      this->_classes.join_with(other._classes,
+                               [&](const EquivalenceClass& left,
+                                   const EquivalenceClass& right)
+                                   -> boost::optional< EquivalenceClass > {
+                                 if (left.domain == right.domain) {
+                                   return left;
+                                 }
+                                 EquivalenceClass result = left;
+                                 result.domain = std::make_shared< Domain >();
+                                 result.owner = owner;
+                                 op(*result.domain,
+                                    *left.domain,
+                                    *right.domain);
+                                 return result;
+                               });
     }
 
     /// \brief Merge two equivalence classes
@@ -306,8 +470,8 @@ private:
         return false;
       }
 
-      EquivalenceClass& x_class = this->_classes[x_root];
-      EquivalenceClass& y_class = this->_classes[y_root];
+      EquivalenceClass x_class = *this->_classes.at(x_root);
+      EquivalenceClass y_class = *this->_classes.at(y_root);
 
       // Merge the domains
       DomainPtr merge_domain = std::make_shared< Domain >();
@@ -315,19 +479,22 @@ private:
       y_class.domain->normalize();
       *merge_domain = (*x_class.domain).meet(*y_class.domain);
 
-      if (x_class.rank > y_class.rank) {
-        this->_parents.at(y_root) = x_root;
+      EquivalenceClass merge_class(this->exclusive_owner());
+      merge_class.domain = std::move(merge_domain);
+      merge_class.pack = x_class.pack ? x_class.pack : y_class.pack;
 
-        x_class.domain.swap(merge_domain);
+      if (x_class.rank > y_class.rank) {
+        merge_class.rank = x_class.rank;
+        this->_parents.insert_or_assign(y_root, x_root);
+        this->_classes.insert_or_assign(x_root, merge_class);
         this->_classes.erase(y_root);
       } else {
-        this->_parents.at(x_root) = y_root;
-
+        merge_class.rank = y_class.rank;
         if (x_class.rank == y_class.rank) {
-          y_class.rank++;
+          merge_class.rank++;
         }
-
-        y_class.domain.swap(merge_domain);
+        this->_parents.insert_or_assign(x_root, y_root);
+        this->_classes.insert_or_assign(y_root, merge_class);
         this->_classes.erase(x_root);
       }
 
@@ -337,7 +504,7 @@ private:
   private:
     struct GetVar {
       const VariableRef& operator()(
-          const std::pair< const VariableRef, VariableRef >& p) const {
+          const std::pair< VariableRef, VariableRef >& p) const {
         return p.first;
       }
     };
@@ -345,19 +512,22 @@ private:
   public:
     /// \brief Begin iterator on the variables
     auto var_begin() const {
-      return boost::make_transform_iterator(this->_parents.cbegin(), GetVar());
+      return boost::make_transform_iterator(this->_parents.begin(), GetVar());
     }
 
     /// \brief End iterator on the variables
     auto var_end() const {
-      return boost::make_transform_iterator(this->_parents.cend(), GetVar());
+      return boost::make_transform_iterator(this->_parents.end(), GetVar());
     }
 
     /// \brief Begin iterator on the equivalence classes
-    auto begin() const { return this->_classes.cbegin(); }
+    ///
+    /// Iterators remain valid if the relation is updated, and iterate on the
+    /// equivalence classes at the time of the call.
+    auto begin() const { return this->_classes.begin(); }
 
     /// \brief End iterator on the equivalence classes
-    auto end() const { return this->_classes.cend(); }
+    auto end() const { return this->_classes.end(); }
 
     /// \brief Return the list of variables
     std::vector< VariableRef > variables() const {
@@ -372,50 +542,64 @@ private:
 
     /// \brief Forget the given variable
     void forget(VariableRef v) {
-      auto it = this->_parents.find(v);
+      boost::optional< const VariableRef& > parent = this->_parents.at(v);
 
-      if (it == this->_parents.end()) {
+      if (!parent) {
         return;
       }
 
-      if (it->second != v) {
+      if (*parent != v) {
         // v is not the root of the equivalence class
         VariableRef root = this->find_root_var(v);
 
-        // update parents
-        for (auto& p : this->_parents) {
-          if (p.second == v) {
-            p.second = root;
-          }
-        }
-
-        EquivalenceClass& equiv_class = this->_classes[root];
-        equiv_class.copy_domain();
-        equiv_class.domain->forget(v);
+        // update parents, remove v
+        this->_parents.transform(
+            [&](VariableRef w, VariableRef w_parent)
+                -> boost::optional< VariableRef > {
+              if (w == v) {
+                return boost::none;
+              } else if (w_parent == v) {
+                return root;
+              } else {
+                return w_parent;
+              }
+            });
+
+        this->find_domain_ref(root).forget(v);
       } else {
         // v is the root of the equivalence class
         boost::optional< VariableRef > new_root;
 
-        for (auto& p : this->_parents) {
-          if (p.second == v && p.first != v) {
-            if (!new_root) {
-              new_root = p.first;
-            }
-            p.second = *new_root;
-          }
-        }
+        // update parents, remove v
+        this->_parents.transform(
+            [&](VariableRef w, VariableRef w_parent)
+                -> boost::optional< VariableRef > {
+              if (w == v) {
+                return boost::none;
+              } else if (w_parent == v) {
+                if (!new_root) {
+                  new_root = w;
+                }
+                return *new_root;
+              } else {
+                return w_parent;
+              }
+            });
 
         if (new_root) {
-          EquivalenceClass equiv_class = std::move(this->_classes[v]);
-          equiv_class.copy_domain();
+          EquivalenceClass equiv_class = *this->_classes.at(v);
+          Owner owner = this->exclusive_owner();
+          if (equiv_class.owner != owner) {
+            equiv_class.domain =
+                std::make_shared< Domain >(*equiv_class.domain);
+            equiv_class.owner = owner;
+          }
           equiv_class.domain->forget(v);
-          this->_classes.emplace(*new_root, std::move(equiv_class));
+          this->_classes.insert_or_assign(*new_root, equiv_class);
         }
 
         this->_classes.erase(v);
       }
-
-      this->_parents.erase(v);
     }
 
     /// \brief Forget the equivalence class containing the given variable
@@ -426,13 +610,15 @@ private:
 
       VariableRef root = this->find_root_var(v);
 
-      for (auto it = this->_parents.begin(); it != this->_parents.end();) {
-        if (this->find_root_var(it->second) == root) {
-          it = _parents.erase(it);
-        } else {
-          ++it;
-        }
-      }
+      this->_parents.transform(
+          [&](VariableRef w, VariableRef w_parent)
+              -> boost::optional< VariableRef > {
+            if (this->find_root_var(w_parent) == root) {
+              return boost::none;
+            } else {
+              return w_parent;
+            }
+          });
 
       this->_classes.erase(root);
     }
@@ -442,7 +628,7 @@ private:
     RootVariablesMap root_to_vars() const {
       RootVariablesMap roots;
       for (const auto& p : this->_parents) {
-        roots[this->cfind_root_var(p.second)].push_back(p.first);
+        roots[this->find_root_var(p.second)].push_back(p.first);
       }
       return roots;
     }
@@ -583,6 +769,28 @@ public:
       return true;
     } else if (other.is_bottom()) {
       return false;
+    } else if (this->_equiv_relation.same_classes(other._equiv_relation)) {
+      // Compare the abstract domains of each equivalence class
+      //
+      // Both class maps have the same keys, thus the same iteration order
+      for (auto it = this->_equiv_relation.begin(),
+                et = this->_equiv_relation.end(),
+                other_it = other._equiv_relation.begin();
+           it != et;
+           ++it, ++other_it) {
+        const DomainPtr& this_domain = it->second.domain;
+        const DomainPtr& other_domain = other_it->second.domain;
+
+        if (this_domain != other_domain) {
+          this_domain->normalize();
+          other_domain->normalize();
+          if (!((*this_domain).leq(*other_domain))) {
+            return false;
+          }
+        }
+      }
+
+      return true;
     } else {
       RootVariablesMap other_roots = other._equiv_relation.root_to_vars();
 
@@ -590,7 +798,7 @@ public:
       for (const auto& other_class : other_roots) {
         const VariableRef& other_root = other_class.first;
         const DomainPtr& other_domain =
-            other._equiv_relation.cfind_domain(other_root);
+            other._equiv_relation.find_domain(other_root);
 
         // Set of root variables of equivalence classes we have merged
         boost::container::flat_set< VariableRef > this_roots;
@@ -604,7 +812,7 @@ public:
             continue; // v not in `this`
           }
 
-          VariableRef this_root = this->_equiv_relation.cfind_root_var(v);
+          VariableRef this_root = this->_equiv_relation.find_root_var(v);
 
           if (this_roots.find(this_root) != this_roots.end()) {
             continue; // equivalence class for v already merged
@@ -613,7 +821,7 @@ public:
           this_roots.insert(this_root);
 
           const DomainPtr& domain =
-              this->_equiv_relation.cfind_domain(this_root);
+              this->_equiv_relation.find_domain(this_root);
 
           // Merge `domain` into `this_domain`
           if (this_domain == nullptr) {
@@ -654,6 +862,44 @@ public:
   }
 
 private:
+  /// \brief Merge the syntactic pack `other` into `pack`
+  ///
+  /// Returns false if `pack` and `other` are different packs.
+  static bool merge_pack(boost::optional< PackId >& pack,
+                         const boost::optional< PackId >& other) {
+    if (!other) {
+      return true;
+    } else if (!pack) {
+      pack = other;
+      return true;
+    } else {
+      return *pack == *other;
+    }
+  }
+
+  /// \brief Return true if `x` can be related to `y`
+  ///
+  /// `x` is the assigned variable, its current equivalence class is ignored.
+  bool can_relate(VariableRef x, VariableRef y) const {
+    boost::optional< PackId > pack;
+    if (x != y) {
+      pack = PackableTrait::pack(x);
+    }
+    return merge_pack(pack, this->_equiv_relation.find_pack(y));
+  }
+
+  /// \brief Return true if `x` can be related to `y` and `z`
+  ///
+  /// `x` is the assigned variable, its current equivalence class is ignored.
+  bool can_relate(VariableRef x, VariableRef y, VariableRef z) const {
+    boost::optional< PackId > pack;
+    if (x != y && x != z) {
+      pack = PackableTrait::pack(x);
+    }
+    return merge_pack(pack, this->_equiv_relation.find_pack(y)) &&
+           merge_pack(pack, this->_equiv_relation.find_pack(z));
+  }
+
   void merge_existing_equiv_classes(boost::optional< VariableRef >& root,
                                     VariableRef v) {
     if (!this->_equiv_relation.contains(v)) {
@@ -683,12 +929,20 @@ private:
 
   /// \brief Apply a binary operation using a union semantic (join, widening)
   template < typename BinaryOperator >
-  VarPackingDomain union_binary_op(VarPackingDomain other,
+  VarPackingDomain union_binary_op(const VarPackingDomain& other_,
                                    const BinaryOperator& op) const {
-    // `other` is a copy, thus we can update it
-    /// TODO(marthaud): try to implement this without copying `other`
     VarPackingDomain result(*this);
 
+    if (result._equiv_relation.same_classes(other_._equiv_relation)) {
+      // Only compute the binary operation on the classes that differ
+      result._equiv_relation.apply_binary_op(other_._equiv_relation, op);
+      result._is_normalized = false;
+      return result;
+    }
+
+    // `other` is a copy, thus we can update it
+    VarPackingDomain other(other_);
+
     // Forget variables in `result` that are not in `other`
     // TODO(marthaud): variables() needs to creates a temporary vector because
     // forget() might invalidate iterators
@@ -735,14 +989,13 @@ private:
         }
 
         if (root) {
-          EquivalenceClass& equiv_class =
-              result._equiv_relation.find_equiv_class(*root);
-          if (equiv_class.domain == other_domain) {
+          const DomainPtr& domain = result._equiv_relation.find_domain(*root);
+          if (domain == other_domain) {
             // nothing to do, left and right packs are the same
           } else {
-            DomainPtr merge_domain = std::make_shared< Domain >();
-            op(*merge_domain, *equiv_class.domain, *other_domain);
-            equiv_class.domain = merge_domain;
+            Domain merge_domain;
+            op(merge_domain, *domain, *other_domain);
+            result._equiv_relation.set_domain(*root, std::move(merge_domain));
           }
         }
       }
@@ -758,11 +1011,18 @@ private:
                                   BinaryOperator op) const {
     VarPackingDomain result(*this);
 
+    if (result._equiv_relation.same_classes(other._equiv_relation)) {
+      // Only compute the binary operation on the classes that differ
+      result._equiv_relation.apply_binary_op(other._equiv_relation, op);
+      result._is_normalized = false;
+      return result;
+    }
+
     RootVariablesMap other_roots = other._equiv_relation.root_to_vars();
     for (const auto& other_class : other_roots) {
       const VariableRef& other_root = other_class.first;
       const DomainPtr& other_domain =
-          other._equiv_relation.cfind_domain(other_root);
+          other._equiv_relation.find_domain(other_root);
 
       boost::optional< VariableRef > root;
       for (VariableRef v : other_class.second) {
@@ -774,18 +1034,17 @@ private:
         result.merge_unexisting_equiv_classes(root, v);
       }
 
-      EquivalenceClass& equiv_class =
-          result._equiv_relation.find_equiv_class(*root);
       if (!new_domain) {
-        if (equiv_class.domain == other_domain) {
+        const DomainPtr& domain = result._equiv_relation.find_domain(*root);
+        if (domain == other_domain) {
           // nothing to do, left and right packs are the same
         } else {
-          DomainPtr merge_domain = std::make_shared< Domain >();
-          op(*merge_domain, *equiv_class.domain, *other_domain);
-          equiv_class.domain = merge_domain;
+          Domain merge_domain;
+          op(merge_domain, *domain, *other_domain);
+          result._equiv_relation.set_domain(*root, std::move(merge_domain));
         }
       } else {
-        equiv_class.domain = other_domain;
+        result._equiv_relation.share_domain(*root, other_domain);
       }
     }
 
@@ -931,7 +1190,7 @@ public:
 
     this->forget(x);
     this->_equiv_relation.add_equiv_class(x);
-    this->_equiv_relation.find_domain(x)->assign(x, n);
+    this->_equiv_relation.find_domain_ref(x).assign(x, n);
     this->_is_normalized = false;
   }
 
@@ -944,6 +1203,11 @@ public:
       return;
     }
 
+    if (!this->can_relate(x, y)) {
+      this->set(x, this->to_interval(y));
+      return;
+    }
+
     if (!this->_equiv_relation.contains(y)) {
       this->_equiv_relation.add_equiv_class(y);
     }
@@ -951,9 +1215,7 @@ public:
     this->forget(x);
     this->_equiv_relation.add_var_to_equiv_class(x, y);
 
-    EquivalenceClass& equiv_class = this->_equiv_relation.find_equiv_class(y);
-    equiv_class.copy_domain();
-    equiv_class.domain->assign(x, y);
+    this->_equiv_relation.find_domain_ref(y).assign(x, y);
     this->_is_normalized = false;
   }
 
@@ -967,6 +1229,17 @@ public:
       return;
     }
 
+    boost::optional< PackId > pack;
+    if (e.factor(x) == 0) {
+      pack = PackableTrait::pack(x);
+    }
+    for (const auto& term : e) {
+      if (!merge_pack(pack, this->_equiv_relation.find_pack(term.first))) {
+        this->set(x, this->to_interval(e));
+        return;
+      }
+    }
+
     boost::optional< VariableRef > root;
 
     for (const auto& term : e) {
@@ -984,16 +1257,13 @@ public:
 
     // otherwise, x has already been merged
 
-    EquivalenceClass& equiv_class =
-        this->_equiv_relation.find_equiv_class(*root);
-    equiv_class.copy_domain();
-    equiv_class.domain->assign(x, e);
+    this->_equiv_relation.find_domain_ref(*root).assign(x, e);
     this->_is_normalized = false;
   }
 
 private:
   /// \brief Add a relation x = f(y, z)
-  const DomainPtr& add_relation(VariableRef x, VariableRef y, VariableRef z) {
+  Domain& add_relation(VariableRef x, VariableRef y, VariableRef z) {
     boost::optional< VariableRef > root;
     this->merge_existing_equiv_classes(root, y);
     this->merge_existing_equiv_classes(root, z);
@@ -1006,14 +1276,11 @@ private:
     }
     // otherwise, x has already been merged
 
-    EquivalenceClass& equiv_class =
-        this->_equiv_relation.find_equiv_class(*root);
-    equiv_class.copy_domain();
-    return equiv_class.domain;
+    return this->_equiv_relation.find_domain_ref(*root);
   }
 
   /// \brief Add a relation x = f(y)
-  const DomainPtr& add_relation(VariableRef x, VariableRef y) {
+  Domain& add_relation(VariableRef x, VariableRef y) {
     if (!this->_equiv_relation.contains(y)) {
       this->_equiv_relation.add_equiv_class(y);
     }
@@ -1023,9 +1290,7 @@ private:
       this->_equiv_relation.add_var_to_equiv_class(x, y);
     }
 
-    EquivalenceClass& equiv_class = this->_equiv_relation.find_equiv_class(y);
-    equiv_class.copy_domain();
-    return equiv_class.domain;
+    return this->_equiv_relation.find_domain_ref(y);
   }
 
 public:
@@ -1037,7 +1302,15 @@ public:
       return;
     }
 
-    this->add_relation(x, y, z)->apply(op, x, y, z);
+    if (!this->can_relate(x, y, z)) {
+      this->set(x,
+                apply_bin_operator(op,
+                                   this->to_interval(y),
+                                   this->to_interval(z)));
+      return;
+    }
+
+    this->add_relation(x, y, z).apply(op, x, y, z);
     this->_is_normalized = false;
   }
 
@@ -1049,7 +1322,12 @@ public:
       return;
     }
 
-    add_relation(x, y)->apply(op, x, y, z);
+    if (!this->can_relate(x, y)) {
+      this->set(x, apply_bin_operator(op, this->to_interval(y), IntervalT(z)));
+      return;
+    }
+
+    this->add_relation(x, y).apply(op, x, y, z);
     this->_is_normalized = false;
   }
 
@@ -1061,7 +1339,12 @@ public:
       return;
     }
 
-    add_relation(x, z)->apply(op, x, y, z);
+    if (!this->can_relate(x, z)) {
+      this->set(x, apply_bin_operator(op, IntervalT(y), this->to_interval(z)));
+      return;
+    }
+
+    this->add_relation(x, z).apply(op, x, y, z);
     this->_is_normalized = false;
   }
 
@@ -1077,6 +1360,16 @@ public:
       return;
     }
 
+    boost::optional< PackId > pack;
+    for (const auto& term : cst) {
+      if (!merge_pack(pack, this->_equiv_relation.find_pack(term.first))) {
+        LinearIntervalSolverT solver(MaxReductionCycles);
+        solver.add(cst);
+        solver.run(*this);
+        return;
+      }
+    }
+
     boost::optional< VariableRef > root;
     for (const auto& term : cst) {
       this->merge_existing_equiv_classes(root, term.first);
@@ -1086,10 +1379,7 @@ public:
       this->merge_unexisting_equiv_classes(root, term.first);
     }
 
-    EquivalenceClass& equiv_class =
-        this->_equiv_relation.find_equiv_class(*root);
-    equiv_class.copy_domain();
-    equiv_class.domain->add(cst);
+    this->_equiv_relation.find_domain_ref(*root).add(cst);
     this->_is_normalized = false;
   }
 
@@ -1115,7 +1405,7 @@ public:
     }
 
     this->_equiv_relation.add_equiv_class(x);
-    this->_equiv_relation.find_domain(x)->set(x, value);
+    this->_equiv_relation.find_domain_ref(x).set(x, value);
     this->_is_normalized = false;
   }
 
@@ -1135,7 +1425,7 @@ public:
     }
 
     this->_equiv_relation.add_equiv_class(x);
-    this->_equiv_relation.find_domain(x)->set(x, value);
+    this->_equiv_relation.find_domain_ref(x).set(x, value);
     this->_is_normalized = false;
   }
 
@@ -1155,7 +1445,7 @@ public:
     }
 
     this->_equiv_relation.add_equiv_class(x);
-    this->_equiv_relation.find_domain(x)->set(x, value);
+    this->_equiv_relation.find_domain_ref(x).set(x, value);
     this->_is_normalized = false;
   }
 
@@ -1174,13 +1464,11 @@ public:
     }
 
     if (this->_equiv_relation.contains(x)) {
-      EquivalenceClass& equiv_class = this->_equiv_relation.find_equiv_class(x);
-      equiv_class.copy_domain();
-      equiv_class.domain->refine(x, value);
+      this->_equiv_relation.find_domain_ref(x).refine(x, value);
       this->_is_normalized = false;
     } else {
       this->_equiv_relation.add_equiv_class(x);
-      this->_equiv_relation.find_domain(x)->set(x, value);
+      this->_equiv_relation.find_domain_ref(x).set(x, value);
     }
   }
 
@@ -1199,13 +1487,11 @@ public:
     }
 
     if (this->_equiv_relation.contains(x)) {
-      EquivalenceClass& equiv_class = this->_equiv_relation.find_equiv_class(x);
-      equiv_class.copy_domain();
-      equiv_class.domain->refine(x, value);
+      this->_equiv_relation.find_domain_ref(x).refine(x, value);
       this->_is_normalized = false;
     } else {
       this->_equiv_relation.add_equiv_class(x);
-      this->_equiv_relation.find_domain(x)->set(x, value);
+      this->_equiv_relation.find_domain_ref(x).set(x, value);
     }
   }
 
@@ -1224,13 +1510,11 @@ public:
     }
 
     if (this->_equiv_relation.contains(x)) {
-      EquivalenceClass& equiv_class = this->_equiv_relation.find_equiv_class(x);
-      equiv_class.copy_domain();
-      equiv_class.domain->refine(x, value);
+      this->_equiv_relation.find_domain_ref(x).refine(x, value);
       this->_is_normalized = false;
     } else {
       this->_equiv_relation.add_equiv_class(x);
-      this->_equiv_relation.find_domain(x)->set(x, value);
+      this->_equiv_relation.find_domain_ref(x).set(x, value);
     }
   }
 
@@ -1252,7 +1536,7 @@ public:
       return IntervalT::bottom();
     } else {
       if (this->_equiv_relation.contains(x)) {
-        return this->_equiv_relation.cfind_domain(x)->to_interval(x);
+        return this->_equiv_relation.find_domain(x)->to_interval(x);
       } else {
         return IntervalT::top();
       }
@@ -1268,7 +1552,7 @@ public:
       return CongruenceT::bottom();
     } else {
       if (this->_equiv_relation.contains(x)) {
-        return this->_equiv_relation.cfind_domain(x)->to_congruence(x);
+        return this->_equiv_relation.find_domain(x)->to_congruence(x);
       } else {
         return CongruenceT::top();
       }
@@ -1284,7 +1568,7 @@ public:
       return IntervalCongruenceT::bottom();
     } else {
       if (this->_equiv_relation.contains(x)) {
-        return this->_equiv_relation.cfind_domain(x)->to_interval_congruence(x);
+        return this->_equiv_relation.find_domain(x)->to_interval_congruence(x);
       } else {
         return IntervalCongruenceT::top();
       }
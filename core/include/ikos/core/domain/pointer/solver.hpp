@@ -55,9 +55,14 @@
 
 #pragma once
 
+#include <algorithm>
+#include <deque>
 #include <iosfwd>
+#include <iterator>
 #include <memory>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include <ikos/core/semantic/dumpable.hpp>
@@ -376,6 +381,21 @@ public:
 }; // end class LoadConstraint
 
 /// \brief System of pointer constraints
+///
+/// The system is solved using a worklist algorithm: a constraint is processed
+/// again only when a pointer or a memory location it reads is updated.
+///
+/// The fixpoint is computed by rounds. Each round processes the constraints in
+/// the worklist. Results are joined directly into the pointers and memory
+/// locations, until they reach the widening threshold. After that, the results
+/// of a round are collected and applied once, at the end of the round. This
+/// ensures that the widening is applied between two consecutive iterations of
+/// a given pointer or memory location, even if several constraints update it.
+///
+/// Pointers and memory locations that are on a cycle of exact copies (e.g,
+/// `p = q + 0`, `*p = q + 0` or `q = *p`) have the same value at the fixpoint.
+/// These cycles are detected lazily, when a copy does not change the value of
+/// its destination, and collapsed into a single node of the constraint graph.
 template < typename VariableRef, typename MemoryLocationRef >
 class ConstraintSystem {
 public:
@@ -417,10 +437,109 @@ private:
   using MemoryMap = std::
       unordered_map< MemoryLocationRef, PointerAbsValueT, MemoryLocationHash >;
 
+  /// \brief Identifier of a node in the constraint graph
+  using NodeId = std::size_t;
+
+  /// \brief Copy edge in the constraint graph
+  using Edge = std::pair< NodeId, NodeId >;
+
+  /// \brief Hash for Edge
+  struct EdgeHash {
+    std::size_t operator()(const Edge& e) const {
+      return std::hash< NodeId >()(e.first) * 31 +
+             std::hash< NodeId >()(e.second);
+    }
+  };
+
+  using PointerNodeMap =
+      std::unordered_map< VariableRef, NodeId, VariableHash >;
+  using MemoryNodeMap =
+      std::unordered_map< MemoryLocationRef, NodeId, MemoryLocationHash >;
+
+  /// \brief Node in the constraint graph
+  ///
+  /// A node represents a pointer variable or a memory location. When nodes
+  /// are collapsed, the representative holds the value and the resolution
+  /// state of all of them.
+  struct Node {
+    // Representative of the node
+    NodeId rep;
+
+    // Whether the node represents a memory location
+    bool is_memory;
+
+    // Position of the pointer or memory location in the list of keys
+    std::size_t key;
+
+    // Whether a constraint wrote the value
+    bool written = false;
+
+    // Pointer abstract value
+    PointerAbsValueT value;
+
+    // Whether results were collected during the current round
+    bool has_pending = false;
+
+    // Results collected during the current round, applied at the end of it
+    PointerAbsValueT pending;
+
+    // Number of rounds during which the value was updated
+    std::size_t iteration = 0;
+
+    // Last round during which the value was updated
+    std::size_t round = 0;
+
+    // Constraints reading the value, sorted by index
+    std::vector< std::size_t > users;
+
+    // Nodes receiving an exact copy of the value, sorted
+    std::vector< NodeId > copies;
+
+    // Nodes collapsed into this one, including itself, sorted
+    std::vector< NodeId > members;
+
+    // Cycle detection state
+    std::size_t visit = 0;
+    std::size_t index = 0;
+    std::size_t lowlink = 0;
+    bool on_stack = false;
+
+    Node(NodeId id,
+         bool is_memory_,
+         std::size_t key_,
+         const PointerAbsValueT& bottom)
+        : rep(id),
+          is_memory(is_memory_),
+          key(key_),
+          value(bottom),
+          pending(bottom) {}
+  };
+
+  /// \brief Nodes of a constraint
+  struct ConstraintNodes {
+    // Result of an assignment or a load, pointer of a store
+    NodeId result;
+
+    // Pointer variable of the operand, if any
+    NodeId operand;
+
+    // Whether the operand is an exact copy of a pointer variable
+    bool copy;
+  };
+
+  /// \brief Invalid node identifier
+  static constexpr NodeId NoNode = static_cast< NodeId >(-1);
+
 public:
   using PointerIterator = typename PointerMap::const_iterator;
   using MemoryIterator = typename MemoryMap::const_iterator;
 
+  /// \brief Cycle of copies collapsed during the resolution
+  struct Cycle {
+    std::vector< VariableRef > pointers;
+    std::vector< MemoryLocationRef > memory_locations;
+  };
+
 private:
   // List of pointer constraints
   ConstraintVector _csts;
@@ -433,22 +552,66 @@ private:
   // `_memory[m]` contains the abstract union of all the pointers stored at `m`
   MemoryMap _memory;
 
+  // Cycles collapsed during the resolution
+  std::vector< Cycle > _cycles;
+
   // Bit-width of pointer offsets (e.g, 32 or 64)
   unsigned _offsets_bit_width;
 
   // Signedness of pointer offsets (usually Unsigned)
   Signedness _offsets_sign;
 
-  // Number of iterations
-  std::size_t _iteration = 0;
+  // Bottom pointer abstract value
+  PointerAbsValueT _bottom;
+
+  // Nodes of the constraint graph
+  std::deque< Node > _nodes;
+
+  // Map from pointer variables to nodes
+  PointerNodeMap _pointer_nodes;
+
+  // Map from memory locations to nodes
+  //
+  // Memory locations are added during the resolution, since they depend on the
+  // points-to sets of the store and load operands.
+  MemoryNodeMap _memory_nodes;
+
+  // Pointer variables, indexed by Node::key
+  std::vector< VariableRef > _pointer_keys;
+
+  // Memory locations, indexed by Node::key
+  std::vector< MemoryLocationRef > _memory_keys;
+
+  // Nodes of each constraint
+  std::vector< ConstraintNodes > _constraint_nodes;
+
+  // Current round
+  std::size_t _round = 0;
+
+  // Constraints to process during the next round
+  std::vector< std::size_t > _worklist;
 
-  // Change seen during iteration
-  bool _change_seen = false;
+  // Whether a constraint is waiting to be processed
+  std::vector< bool > _queued;
+
+  // Nodes with results collected during the current round
+  std::vector< NodeId > _pending;
+
+  // Whether cycles of copies are detected and collapsed
+  bool _collapse = false;
+
+  // Copy edges that already triggered a cycle detection
+  std::unordered_set< Edge, EdgeHash > _checked_edges;
+
+  // Number of cycle detections
+  std::size_t _visit = 0;
 
 public:
   /// \brief Default constructor
   ConstraintSystem(unsigned offsets_bit_width, Signedness offsets_sign)
-      : _offsets_bit_width(offsets_bit_width), _offsets_sign(offsets_sign) {}
+      : _offsets_bit_width(offsets_bit_width),
+        _offsets_sign(offsets_sign),
+        _bottom(PointerAbsValueT::bottom(offsets_bit_width, offsets_sign)) {}
 
   /// \brief Deleted copy constructor
   ConstraintSystem(const ConstraintSystem&) = delete;
@@ -470,12 +633,24 @@ public:
     this->_csts.emplace_back(std::move(cst));
   }
 
+  /// \brief Move the pointer constraints of `other` at the end of this system
+  void merge(ConstraintSystem&& other) {
+    this->_csts.insert(this->_csts.end(),
+                       std::make_move_iterator(other._csts.begin()),
+                       std::make_move_iterator(other._csts.end()));
+    other._csts.clear();
+  }
+
 private:
   class BinaryOp {
   public:
     virtual bool convergence_achieved(const PointerAbsValueT& before,
                                       const PointerAbsValueT& after) const = 0;
 
+    /// \brief Return true if the results of a round must be collected and
+    /// applied once, at the end of the round
+    virtual bool delayed(std::size_t iteration) const = 0;
+
     virtual void apply(PointerAbsValueT& before,
                        const PointerAbsValueT& after,
                        std::size_t iteration) const = 0;
@@ -495,6 +670,10 @@ private:
       return after.leq(before);
     }
 
+    bool delayed(std::size_t iteration) const override {
+      return iteration >= this->_threshold;
+    }
+
     void apply(PointerAbsValueT& before,
                const PointerAbsValueT& after,
                std::size_t iteration) const override {
@@ -521,6 +700,8 @@ private:
       return false;
     }
 
+    bool delayed(std::size_t /*iteration*/) const override { return true; }
+
     void apply(PointerAbsValueT& before,
                const PointerAbsValueT& after,
                std::size_t /*iteration*/) const override {
@@ -534,45 +715,210 @@ private:
     }
   };
 
-  /// \brief Perform a step of the fixpoint convergence using the given operator
+  /// \brief Add the element `x` in the sorted list `list`
+  template < typename T >
+  static void add_sorted(std::vector< T >& list, T x) {
+    auto it = std::lower_bound(list.begin(), list.end(), x);
+    if (it == list.end() || *it != x) {
+      list.insert(it, x);
+    }
+  }
+
+  /// \brief Return the node of the given pointer, creating it if needed
+  NodeId pointer_node(VariableRef p) {
+    auto it = this->_pointer_nodes.find(p);
+    if (it != this->_pointer_nodes.end()) {
+      return it->second;
+    }
+    NodeId id = this->_nodes.size();
+    this->_nodes.emplace_back(id,
+                              /*is_memory=*/false,
+                              this->_pointer_keys.size(),
+                              this->_bottom);
+    this->_pointer_keys.push_back(p);
+    this->_pointer_nodes.emplace(p, id);
+    return id;
+  }
+
+  /// \brief Return the node of the given memory location, creating it if
+  /// needed
+  NodeId memory_node(MemoryLocationRef m) {
+    auto it = this->_memory_nodes.find(m);
+    if (it != this->_memory_nodes.end()) {
+      return it->second;
+    }
+    NodeId id = this->_nodes.size();
+    this->_nodes.emplace_back(id,
+                              /*is_memory=*/true,
+                              this->_memory_keys.size(),
+                              this->_bottom);
+    this->_memory_keys.push_back(m);
+    this->_memory_nodes.emplace(m, id);
+    return id;
+  }
+
+  /// \brief Return the representative of the given node
+  NodeId find(NodeId n) {
+    NodeId root = n;
+    while (this->_nodes[root].rep != root) {
+      root = this->_nodes[root].rep;
+    }
+    while (this->_nodes[n].rep != root) {
+      NodeId next = this->_nodes[n].rep;
+      this->_nodes[n].rep = root;
+      n = next;
+    }
+    return root;
+  }
+
+  /// \brief Return the representative node of the given node
+  Node& node(NodeId n) { return this->_nodes[this->find(n)]; }
+
+  /// \brief Initialize the constraint graph
+  ///
+  /// This computes the constraints reading each pointer variable, and the
+  /// copies between pointer variables.
+  void init_graph() {
+    this->_nodes.clear();
+    this->_pointer_nodes.clear();
+    this->_memory_nodes.clear();
+    this->_pointer_keys.clear();
+    this->_memory_keys.clear();
+    this->_constraint_nodes.clear();
+    this->_constraint_nodes.reserve(this->_csts.size());
+    this->_checked_edges.clear();
+    this->_pending.clear();
+    this->_round = 0;
+    this->_visit = 0;
+
+    for (std::size_t i = 0; i < this->_csts.size(); i++) {
+      const ConstraintT* cst = this->_csts[i].get();
+      const OperandT* op = nullptr;
+      ConstraintNodes nodes{NoNode, NoNode, false};
+      switch (cst->kind()) {
+        case ConstraintT::AssignKind: {
+          auto assign = static_cast< const AssignConstraintT* >(cst);
+          nodes.result = this->pointer_node(assign->result());
+          op = assign->operand();
+        } break;
+        case ConstraintT::StoreKind: {
+          auto store = static_cast< const StoreConstraintT* >(cst);
+          nodes.result = this->pointer_node(store->pointer());
+          add_sorted(this->_nodes[nodes.result].users, i);
+          op = store->operand();
+        } break;
+        case ConstraintT::LoadKind: {
+          auto load = static_cast< const LoadConstraintT* >(cst);
+          nodes.result = this->pointer_node(load->result());
+          op = load->operand();
+        } break;
+        default: { ikos_unreachable("unexpected kind"); }
+      }
+      if (op->kind() == OperandT::VariableKind) {
+        auto variable_op = static_cast< const VariableOperandT* >(op);
+        nodes.operand = this->pointer_node(variable_op->var());
+        nodes.copy = variable_op->offset().is_zero();
+        add_sorted(this->_nodes[nodes.operand].users, i);
+      }
+      if (cst->kind() == ConstraintT::AssignKind && nodes.copy &&
+          nodes.operand != nodes.result) {
+        add_sorted(this->_nodes[nodes.operand].copies, nodes.result);
+      }
+      this->_constraint_nodes.push_back(nodes);
+    }
+  }
+
+  /// \brief Add all the constraints in the worklist
+  void enqueue_all() {
+    for (std::size_t i = 0; i < this->_csts.size(); i++) {
+      if (!this->_queued[i]) {
+        this->_queued[i] = true;
+        this->_worklist.push_back(i);
+      }
+    }
+  }
+
+  /// \brief Add the users of the given node in the worklist
+  void enqueue_users(const Node& n) {
+    for (std::size_t i : n.users) {
+      if (!this->_queued[i]) {
+        this->_queued[i] = true;
+        this->_worklist.push_back(i);
+      }
+    }
+  }
+
+  /// \brief Mark the given node as updated, and add its users in the worklist
+  void updated(Node& n) {
+    if (n.round != this->_round) {
+      n.round = this->_round;
+      n.iteration++;
+    }
+    this->enqueue_users(n);
+  }
+
+  /// \brief Perform a round of the fixpoint computation
   ///
-  /// It processes all the constraints once.
+  /// It processes all the constraints in the worklist, in order, using the
+  /// given operator.
   void step(const BinaryOp& op) {
-    for (auto it = this->_csts.begin(), et = this->_csts.end(); it != et;
-         ++it) {
-      this->process_constraint(it->get(), op);
+    this->_round++;
+    std::vector< std::size_t > worklist;
+    worklist.swap(this->_worklist);
+    std::sort(worklist.begin(), worklist.end());
+
+    for (std::size_t i : worklist) {
+      this->_queued[i] = false;
+      this->process_constraint(i, op);
     }
+
+    this->apply_pending(op);
   }
 
   /// \brief Process the given constraint
-  ///
-  /// It updates this->_pointers and this->_memory
-  void process_constraint(const ConstraintT* cst, const BinaryOp& op) {
+  void process_constraint(std::size_t i, const BinaryOp& op) {
+    const ConstraintT* cst = this->_csts[i].get();
+    const ConstraintNodes& nodes = this->_constraint_nodes[i];
     switch (cst->kind()) {
       case ConstraintT::AssignKind: {
         auto assign = static_cast< const AssignConstraintT* >(cst);
-        PointerAbsValueT op_value = this->process_operand(assign->operand());
-        this->add_pointer(assign->result(), op_value, op);
+        if (nodes.copy) {
+          this->check_copy(nodes.operand, nodes.result);
+        }
+        PointerAbsValueT op_value =
+            this->process_operand(assign->operand(), nodes.operand);
+        this->add(nodes.result, op_value, op);
       } break;
       case ConstraintT::StoreKind: {
         auto store = static_cast< const StoreConstraintT* >(cst);
-        PointerAbsValueT ptr_value = this->get_pointer(store->pointer());
-        PointerAbsValueT op_value = this->process_operand(store->operand());
+        // Copy the value, since the node might be collapsed with a memory
+        // location during the loop
+        PointerAbsValueT ptr_value = this->node(nodes.result).value;
         if (ptr_value.is_bottom()) {
           return;
         }
+        PointerAbsValueT op_value =
+            this->process_operand(store->operand(), nodes.operand);
         for (MemoryLocationRef addr : ptr_value.points_to()) {
-          this->add_memory(addr, op_value, op);
+          NodeId m = this->memory_node(addr);
+          if (nodes.copy) {
+            this->add_copy(nodes.operand, m);
+          }
+          this->add(m, op_value, op);
         }
       } break;
       case ConstraintT::LoadKind: {
         auto load = static_cast< const LoadConstraintT* >(cst);
-        PointerAbsValueT op_value = this->process_operand(load->operand());
+        PointerAbsValueT op_value =
+            this->process_operand(load->operand(), nodes.operand);
         if (op_value.is_bottom()) {
           return;
         }
         for (MemoryLocationRef addr : op_value.points_to()) {
-          this->add_pointer(load->result(), this->get_memory(addr), op);
+          NodeId m = this->memory_node(addr);
+          add_sorted(this->node(m).users, i);
+          this->add_copy(m, nodes.result);
+          this->add(nodes.result, this->node(m).value, op);
         }
       } break;
       default: { ikos_unreachable("unexpected kind"); }
@@ -580,11 +926,11 @@ private:
   }
 
   /// \brief Return the abstract value for the given operand
-  PointerAbsValueT process_operand(const OperandT* op) {
+  PointerAbsValueT process_operand(const OperandT* op, NodeId operand) {
     switch (op->kind()) {
       case OperandT::VariableKind: {
         auto variable_op = static_cast< const VariableOperandT* >(op);
-        PointerAbsValueT value = this->get_pointer(variable_op->var());
+        PointerAbsValueT value = this->node(operand).value;
         value.add_offset(variable_op->offset());
         return value;
       }
@@ -599,118 +945,345 @@ private:
     }
   }
 
-public:
-  /// \brief Return the abstract value for the given pointer
-  PointerAbsValueT get_pointer(VariableRef p) {
-    auto it = this->_pointers.find(p);
-    if (it == this->_pointers.end()) {
-      return PointerAbsValueT::bottom(this->_offsets_bit_width,
-                                      this->_offsets_sign);
-    } else {
-      return it->second;
+  /// \brief Add the copy `dst = src`, and check for a cycle
+  void add_copy(NodeId src, NodeId dst) {
+    NodeId s = this->find(src);
+    NodeId d = this->find(dst);
+    if (s == d) {
+      return;
     }
+    add_sorted(this->_nodes[s].copies, d);
+    this->check_copy(s, d);
   }
 
-  /// \brief Begin iterator over the pairs (pointer, abstract value)
-  PointerIterator pointer_begin() const { return this->_pointers.cbegin(); }
+  /// \brief Check for a cycle going through the copy `dst = src`
+  ///
+  /// This implements the lazy cycle detection: if the source and the
+  /// destination already have the same value, they are likely on a cycle.
+  /// Each copy triggers a detection at most once.
+  void check_copy(NodeId src, NodeId dst) {
+    if (!this->_collapse) {
+      return;
+    }
+    NodeId s = this->find(src);
+    NodeId d = this->find(dst);
+    if (s == d) {
+      return;
+    }
+    const PointerAbsValueT& value = this->_nodes[s].value;
+    if (value.is_bottom() || !value.equals(this->_nodes[d].value)) {
+      return;
+    }
+    if (this->_checked_edges.emplace(s, d).second) {
+      this->collapse_cycles(d);
+    }
+  }
 
-  /// \brief End iterator over the pairs (pointer, abstract value)
-  PointerIterator pointer_end() const { return this->_pointers.cend(); }
+  /// \brief Collapse the cycles of copies reachable from the given node
+  ///
+  /// This uses Tarjan's algorithm to compute the strongly connected components
+  /// of the copy graph.
+  void collapse_cycles(NodeId start) {
+    struct Frame {
+      NodeId node;
+      std::size_t next;
+    };
+
+    std::size_t visit = ++this->_visit;
+    std::size_t index = 0;
+    std::vector< Frame > frames;
+    std::vector< NodeId > stack;
+
+    auto enter = [&](NodeId n) {
+      Node& node = this->_nodes[n];
+      node.visit = visit;
+      node.index = node.lowlink = index++;
+      node.on_stack = true;
+      stack.push_back(n);
+      frames.push_back(Frame{n, 0});
+    };
+
+    enter(this->find(start));
+    while (!frames.empty()) {
+      Frame& frame = frames.back();
+      Node& node = this->_nodes[frame.node];
+
+      if (frame.next < node.copies.size()) {
+        NodeId succ = this->find(node.copies[frame.next++]);
+        if (succ == frame.node) {
+          continue;
+        }
+        Node& succ_node = this->_nodes[succ];
+        if (succ_node.visit != visit) {
+          enter(succ);
+        } else if (succ_node.on_stack) {
+          node.lowlink = std::min(node.lowlink, succ_node.index);
+        }
+        continue;
+      }
 
-  /// \brief Return the abstract value for pointers stored at the given memory
-  /// location
-  PointerAbsValueT get_memory(MemoryLocationRef m) {
-    auto it = this->_memory.find(m);
-    if (it == this->_memory.end()) {
-      return PointerAbsValueT::bottom(this->_offsets_bit_width,
-                                      this->_offsets_sign);
+      NodeId n = frame.node;
+      frames.pop_back();
+      if (!frames.empty()) {
+        Node& parent = this->_nodes[frames.back().node];
+        parent.lowlink = std::min(parent.lowlink, node.lowlink);
+      }
+      if (node.lowlink == node.index) {
+        std::vector< NodeId > scc;
+        NodeId m;
+        do {
+          m = stack.back();
+          stack.pop_back();
+          this->_nodes[m].on_stack = false;
+          scc.push_back(m);
+        } while (m != n);
+        if (scc.size() > 1) {
+          this->collapse(scc);
+        }
+      }
+    }
+  }
+
+  /// \brief Collapse the given nodes into a single node
+  void collapse(std::vector< NodeId >& scc) {
+    std::sort(scc.begin(), scc.end());
+    NodeId rep_id = scc.front();
+    Node& rep = this->_nodes[rep_id];
+    if (rep.members.empty()) {
+      rep.members.push_back(rep_id);
+    }
+
+    for (auto it = std::next(scc.begin()); it != scc.end(); ++it) {
+      Node& n = this->_nodes[*it];
+      n.rep = rep_id;
+      rep.written = rep.written || n.written;
+      rep.value.join_with(n.value);
+      n.value = this->_bottom;
+      if (n.has_pending) {
+        if (rep.has_pending) {
+          rep.pending.join_with(n.pending);
+        } else {
+          rep.pending = n.pending;
+          rep.has_pending = true;
+          this->_pending.push_back(rep_id);
+        }
+        n.has_pending = false;
+        n.pending = this->_bottom;
+      }
+      rep.iteration = std::max(rep.iteration, n.iteration);
+      rep.round = std::max(rep.round, n.round);
+
+      std::vector< std::size_t > users;
+      users.reserve(rep.users.size() + n.users.size());
+      std::set_union(rep.users.begin(),
+                     rep.users.end(),
+                     n.users.begin(),
+                     n.users.end(),
+                     std::back_inserter(users));
+      rep.users.swap(users);
+      std::vector< std::size_t >().swap(n.users);
+
+      rep.copies.insert(rep.copies.end(), n.copies.begin(), n.copies.end());
+      std::vector< NodeId >().swap(n.copies);
+
+      if (n.members.empty()) {
+        rep.members.push_back(*it);
+      } else {
+        rep.members.insert(rep.members.end(),
+                           n.members.begin(),
+                           n.members.end());
+        std::vector< NodeId >().swap(n.members);
+      }
+    }
+
+    // Remove the copies between collapsed nodes
+    for (NodeId& succ : rep.copies) {
+      succ = this->find(succ);
+    }
+    std::sort(rep.copies.begin(), rep.copies.end());
+    rep.copies.erase(std::unique(rep.copies.begin(), rep.copies.end()),
+                     rep.copies.end());
+    rep.copies.erase(std::remove(rep.copies.begin(), rep.copies.end(), rep_id),
+                     rep.copies.end());
+    std::sort(rep.members.begin(), rep.members.end());
+
+    // The value of each collapsed node might have changed
+    this->enqueue_users(rep);
+  }
+
+  /// \brief Add `value` for the given node, applying the binary operator `op`
+  ///
+  /// If the operator is delayed, the value is collected for the end of the
+  /// round.
+  void add(NodeId id, const PointerAbsValueT& value, const BinaryOp& op) {
+    NodeId rep_id = this->find(id);
+    Node& n = this->_nodes[rep_id];
+    n.written = true;
+    if (op.convergence_achieved(n.value, value)) {
+      return;
+    }
+
+    if (op.delayed(n.iteration)) {
+      if (n.has_pending) {
+        n.pending.join_with(value);
+      } else {
+        n.pending = value;
+        n.has_pending = true;
+        this->_pending.push_back(rep_id);
+      }
     } else {
-      return it->second;
+      op.apply(n.value, value, n.iteration);
+      this->updated(n);
     }
   }
 
-  /// \brief Begin iterator over the pairs (memory location, abstract value)
-  MemoryIterator memory_begin() const { return this->_memory.cbegin(); }
+  /// \brief Apply the results collected during the current round, using the
+  /// binary operator `op`
+  void apply_pending(const BinaryOp& op) {
+    for (NodeId id : this->_pending) {
+      Node& n = this->node(id);
+      if (!n.has_pending) {
+        continue;
+      }
+      if (!op.convergence_achieved(n.value, n.pending)) {
+        op.apply(n.value, n.pending, n.iteration);
+        this->updated(n);
+      }
+      n.has_pending = false;
+      n.pending = this->_bottom;
+    }
+    this->_pending.clear();
+  }
 
-  /// \brief End iterator over the pairs (memory location, abstract value)
-  MemoryIterator memory_end() const { return this->_memory.cend(); }
+  /// \brief Export the results of the resolution, and release the constraint
+  /// graph
+  void export_results() {
+    this->_pointers.clear();
+    this->_memory.clear();
+    this->_cycles.clear();
+
+    for (const auto& entry : this->_pointer_nodes) {
+      const Node& n = this->node(entry.second);
+      if (n.written) {
+        this->_pointers.emplace(entry.first, n.value);
+      }
+    }
+    for (const auto& entry : this->_memory_nodes) {
+      const Node& n = this->node(entry.second);
+      if (n.written) {
+        this->_memory.emplace(entry.first, n.value);
+      }
+    }
+    for (const Node& n : this->_nodes) {
+      if (n.members.size() > 1) {
+        Cycle cycle;
+        for (NodeId member : n.members) {
+          const Node& m = this->_nodes[member];
+          if (m.is_memory) {
+            cycle.memory_locations.push_back(this->_memory_keys[m.key]);
+          } else {
+            cycle.pointers.push_back(this->_pointer_keys[m.key]);
+          }
+        }
+        this->_cycles.push_back(std::move(cycle));
+      }
+    }
 
-private:
-  /// \brief Add a pointer abstraction for the given pointer
-  void add_pointer(VariableRef p,
-                   const PointerAbsValueT& value,
-                   const BinaryOp& op) {
-    // Get a reference on the current value
+    this->_nodes.clear();
+    this->_pointer_nodes.clear();
+    this->_memory_nodes.clear();
+    this->_pointer_keys.clear();
+    this->_memory_keys.clear();
+    this->_constraint_nodes.clear();
+    this->_checked_edges.clear();
+    this->_worklist.clear();
+    this->_queued.clear();
+  }
+
+  /// \brief Return a reference on the abstract value for the given pointer
+  const PointerAbsValueT& pointer(VariableRef p) const {
     auto it = this->_pointers.find(p);
     if (it == this->_pointers.end()) {
-      // add default value
-      auto res = this->_pointers
-                     .emplace(p,
-                              PointerAbsValueT::bottom(this->_offsets_bit_width,
-                                                       this->_offsets_sign));
-      it = res.first;
+      return this->_bottom;
+    } else {
+      return it->second;
     }
-    this->add_apply(it->second, value, op);
   }
 
-  /// \brief Add a pointer abstraction for the given memory location
-  void add_memory(MemoryLocationRef m,
-                  const PointerAbsValueT& value,
-                  const BinaryOp& op) {
-    // Get a reference on the current value
+  /// \brief Return a reference on the abstract value for pointers stored at
+  /// the given memory location
+  const PointerAbsValueT& memory(MemoryLocationRef m) const {
     auto it = this->_memory.find(m);
     if (it == this->_memory.end()) {
-      // add default value
-      auto res = this->_memory
-                     .emplace(m,
-                              PointerAbsValueT::bottom(this->_offsets_bit_width,
-                                                       this->_offsets_sign));
-      it = res.first;
-    }
-    this->add_apply(it->second, value, op);
-  }
-
-  /// \brief Add `after` in `before`, applying the given binary operator `op`
-  void add_apply(PointerAbsValueT& before,
-                 const PointerAbsValueT& after,
-                 const BinaryOp& op) {
-    if (!op.convergence_achieved(before, after)) {
-      this->_change_seen = true;
-      op.apply(before, after, this->_iteration);
+      return this->_bottom;
+    } else {
+      return it->second;
     }
   }
 
 public:
   /// \brief Solve the constraint system
+  ///
+  /// \param widening_threshold Number of updates of a pointer or a memory
+  ///   location before using a widening instead of a join
+  /// \param narrowing_threshold Number of narrowing iterations
   void solve(std::size_t widening_threshold = 50,
-             std::size_t /*narrowing_threshold*/ = 1) {
-    this->_iteration = 0;
+             std::size_t narrowing_threshold = 1) {
+    this->init_graph();
+    this->_worklist.clear();
+    this->_queued.assign(this->_csts.size(), false);
+
+    // Ascending iterations
+    //
+    // Cycles of copies are only collapsed during the ascending iterations,
+    // since a refinement does not preserve the equality of their values.
     Extrapolate widening_op(widening_threshold);
-    do {
-      this->_iteration++;
-      this->_change_seen = false;
+    this->_collapse = true;
+    this->enqueue_all();
+    while (!this->_worklist.empty()) {
       this->step(widening_op);
-    } while (this->_change_seen);
+    }
+    this->_collapse = false;
 
-    // TODO(marthaud): commented out because this is unsound.
+    // Descending iterations
     //
-    // The algorithm here does not compute a proper fixpoint, because the
-    // widening and narrowing operations should be applied between two
-    // consecutive iterations. We can have several constraints updating the
-    // same pointer, thus calling the widening/narrowing several times on the
-    // same iteration. This is unsound.
-    //
-    // As a short fix, the narrowing step is disabled.
-    //
-    // See https://babelfish.arc.nasa.gov/jira/projects/IKOS/issues/IKOS-71
+    // Each round processes all the constraints to compute the new value of
+    // each pointer and memory location, before refining it.
+    Refine narrowing_op;
+    for (std::size_t k = 0; k < narrowing_threshold; k++) {
+      this->enqueue_all();
+      this->step(narrowing_op);
+    }
 
-    // Refine narrowing_op;
-    // this->_iteration = 0;
-    // for (; this->_iteration < narrowing_threshold; ++this->_iteration) {
-    //  this->step(narrowing_op);
-    // }
+    this->export_results();
+  }
+
+  /// \brief Return the abstract value for the given pointer
+  const PointerAbsValueT& get_pointer(VariableRef p) const {
+    return this->pointer(p);
   }
 
+  /// \brief Begin iterator over the pairs (pointer, abstract value)
+  PointerIterator pointer_begin() const { return this->_pointers.cbegin(); }
+
+  /// \brief End iterator over the pairs (pointer, abstract value)
+  PointerIterator pointer_end() const { return this->_pointers.cend(); }
+
+  /// \brief Return the abstract value for pointers stored at the given memory
+  /// location
+  const PointerAbsValueT& get_memory(MemoryLocationRef m) const {
+    return this->memory(m);
+  }
+
+  /// \brief Begin iterator over the pairs (memory location, abstract value)
+  MemoryIterator memory_begin() const { return this->_memory.cbegin(); }
+
+  /// \brief End iterator over the pairs (memory location, abstract value)
+  MemoryIterator memory_end() const { return this->_memory.cend(); }
+
+  /// \brief Return the cycles of copies collapsed during the resolution
+  const std::vector< Cycle >& cycles() const { return this->_cycles; }
+
   /// \brief Dump the constraint system, for debugging purpose
   void dump(std::ostream& o) const {
     o << "{\n";
@@ -47,6 +47,7 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -728,9 +729,16 @@ private:
   // Invariant at checkpoints
   std::unordered_map< std::string, AbstractDomain > _checkpoints;
 
+  // Mutex protecting the checkpoints, for concurrent iterations
+  std::mutex _checkpoints_mutex;
+
 public:
   /// \brief Create a fixpoint iterator on the given ControlFlowGraph
-  explicit FixpointIterator(ControlFlowGraphT& cfg) : Parent(&cfg) {}
+  explicit FixpointIterator(
+      ControlFlowGraphT& cfg,
+      InvariantStorage storage = InvariantStorage::Full,
+      unsigned jobs = 1)
+      : Parent(&cfg, storage, jobs) {}
 
   /// \brief Compute the fixpoint
   void run() { Parent::run(AbstractDomain::top()); }
@@ -756,6 +764,8 @@ private:
 
     std::unordered_map< std::string, AbstractDomain >& checkpoints;
 
+    std::mutex& checkpoints_mutex;
+
   public:
     using ResultType = void;
 
@@ -779,7 +789,10 @@ private:
 
     void operator()(QLinearAssertionT* s) { inv.second().add(s->constraint()); }
 
-    void operator()(CheckPointT* s) { checkpoints[s->name()] = inv; }
+    void operator()(CheckPointT* s) {
+      std::lock_guard< std::mutex > lock(checkpoints_mutex);
+      checkpoints[s->name()] = inv;
+    }
 
   }; // end class ExecutionEngine
 
@@ -790,7 +803,9 @@ public:
   /// of the program upon entering the node. The method should return an
   /// abstract value representing the state of the program after the node.
   AbstractDomain analyze_node(BasicBlockT* bb, AbstractDomain inv) override {
-    ExecutionEngine engine{std::move(inv), this->_checkpoints};
+    ExecutionEngine engine{std::move(inv),
+                           this->_checkpoints,
+                           this->_checkpoints_mutex};
     for (StatementT* stmt : *bb) {
       apply_visitor(engine, stmt);
     }
@@ -47,12 +47,24 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
 #include <memory>
+#include <mutex>
+#include <type_traits>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
+#include <vector>
 
+#include <ikos/core/exception.hpp>
 #include <ikos/core/fixpoint/fixpoint_iterator.hpp>
 #include <ikos/core/fixpoint/wto.hpp>
+#include <ikos/core/support/mpl.hpp>
+#include <ikos/core/support/thread_pool.hpp>
 
 namespace ikos {
 namespace core {
@@ -65,8 +77,29 @@ class WtoIterator;
 template < typename GraphRef, typename AbstractValue, typename GraphTrait >
 class WtoProcessor;
 
+template < typename GraphRef, typename GraphTrait >
+class WtoHeadCollector;
+
+template < typename GraphRef, typename AbstractValue, typename GraphTrait >
+class ConcurrentScheduler;
+
 } // end namespace interleaved_fwd_fixpoint_iterator_impl
 
+/// \brief Policy to store the invariants of a fixpoint iterator
+enum class InvariantStorage {
+  /// \brief Keep the pre and post invariants of every node
+  Full,
+
+  /// \brief Only keep the invariants required to recompute the others
+  ///
+  /// Once the fixpoint is reached, only the pre invariants of the entry node,
+  /// the cycle heads and the join points (nodes with several predecessors) are
+  /// kept, along with the post invariants of the cycle heads. Other invariants
+  /// are recomputed on demand without being stored, and give exactly the same
+  /// result.
+  Sparse,
+};
+
 template < typename GraphRef,
            typename AbstractValue,
            typename GraphTrait = GraphTraits< GraphRef > >
@@ -74,29 +107,72 @@ class InterleavedFwdFixpointIterator
     : public ForwardFixpointIterator< GraphRef, AbstractValue, GraphTrait > {
   friend class interleaved_fwd_fixpoint_iterator_impl::
       WtoIterator< GraphRef, AbstractValue, GraphTrait >;
+  friend class interleaved_fwd_fixpoint_iterator_impl::
+      ConcurrentScheduler< GraphRef, AbstractValue, GraphTrait >;
 
 private:
   using NodeRef = typename GraphTrait::NodeRef;
   using InvariantTable = std::unordered_map< NodeRef, AbstractValue >;
   using InvariantTablePtr = std::shared_ptr< InvariantTable >;
+  using NodeSet = std::unordered_set< NodeRef >;
+  using NodeSetPtr = std::shared_ptr< NodeSet >;
   using WtoT = Wto< GraphRef, GraphTrait >;
   using WtoIterator = interleaved_fwd_fixpoint_iterator_impl::
       WtoIterator< GraphRef, AbstractValue, GraphTrait >;
   using WtoProcessor = interleaved_fwd_fixpoint_iterator_impl::
       WtoProcessor< GraphRef, AbstractValue, GraphTrait >;
+  using HeadCollector = interleaved_fwd_fixpoint_iterator_impl::
+      WtoHeadCollector< GraphRef, GraphTrait >;
+  using ConcurrentScheduler = interleaved_fwd_fixpoint_iterator_impl::
+      ConcurrentScheduler< GraphRef, AbstractValue, GraphTrait >;
 
 private:
   GraphRef _cfg;
   WtoT _wto;
   InvariantTablePtr _pre, _post;
+  InvariantStorage _storage;
+  unsigned _jobs;
+
+  /// \brief Nodes with invariants dropped by the sparse storage
+  NodeSetPtr _dropped;
 
 public:
   /// \brief Create an interleaved forward fixpoint iterator
-  explicit InterleavedFwdFixpointIterator(GraphRef cfg)
+  ///
+  /// \param cfg Control flow graph
+  /// \param storage Policy to store invariants
+  /// \param jobs Number of threads used to iterate over independent
+  ///   components of the weak topological order
+  explicit InterleavedFwdFixpointIterator(
+      GraphRef cfg,
+      InvariantStorage storage = InvariantStorage::Full,
+      unsigned jobs = 1)
       : _cfg(cfg),
         _wto(cfg),
         _pre(std::make_shared< InvariantTable >()),
-        _post(std::make_shared< InvariantTable >()) {}
+        _post(std::make_shared< InvariantTable >()),
+        _storage(storage),
+        _jobs(jobs),
+        _dropped(std::make_shared< NodeSet >()) {}
+
+  /// \brief Create an interleaved forward fixpoint iterator using a
+  /// precomputed weak topological order of the graph
+  ///
+  /// The weak topological order only depends on the graph, and copies share
+  /// the same underlying components. This allows several fixpoint iterators on
+  /// the same graph to compute the weak topological order only once.
+  InterleavedFwdFixpointIterator(
+      GraphRef cfg,
+      const WtoT& wto,
+      InvariantStorage storage = InvariantStorage::Full,
+      unsigned jobs = 1)
+      : _cfg(cfg),
+        _wto(wto),
+        _pre(std::make_shared< InvariantTable >()),
+        _post(std::make_shared< InvariantTable >()),
+        _storage(storage),
+        _jobs(jobs),
+        _dropped(std::make_shared< NodeSet >()) {}
 
   /// \brief Copy constructor
   InterleavedFwdFixpointIterator(const InterleavedFwdFixpointIterator&) =
@@ -119,6 +195,13 @@ public:
   /// \brief Get the weak topological order of the graph
   const WtoT& wto() const { return this->_wto; }
 
+  /// \brief Get the policy to store invariants
+  InvariantStorage storage() const { return this->_storage; }
+
+  /// \brief Get the number of threads used to iterate over independent
+  /// components
+  unsigned jobs() const { return this->_jobs; }
+
 private:
   /// \brief Set the invariant for the given node
   static void set(const InvariantTablePtr& table,
@@ -154,17 +237,163 @@ private:
     }
   }
 
+  /// \brief Return true if the invariants of the given node were dropped by
+  /// the sparse storage
+  bool is_dropped(NodeRef node) const {
+    return this->_dropped->find(node) != this->_dropped->end();
+  }
+
+  /// \brief Drop the invariants that can be recomputed, for the sparse storage
+  void drop_invariants() {
+    NodeRef entry = GraphTrait::entry(this->_cfg);
+    NodeSet heads;
+    HeadCollector collector(heads);
+    this->_wto.accept(collector);
+
+    // Post invariants are kept for cycle heads only, since the post invariant
+    // of a cycle head is computed before the last update of its pre invariant.
+    // Nodes without pre invariant were not visited (unreachable), keep their
+    // post invariant.
+    for (auto it = this->_post->begin(); it != this->_post->end();) {
+      if (heads.find(it->first) == heads.end() &&
+          this->_pre->find(it->first) != this->_pre->end()) {
+        this->_dropped->insert(it->first);
+        it = this->_post->erase(it);
+      } else {
+        ++it;
+      }
+    }
+
+    // Pre invariants are kept for the entry node, cycle heads and join points
+    for (auto it = this->_pre->begin(); it != this->_pre->end();) {
+      NodeRef node = it->first;
+      auto pred_it = GraphTrait::predecessor_begin(node);
+      auto pred_end = GraphTrait::predecessor_end(node);
+      if (node != entry && heads.find(node) == heads.end() &&
+          pred_it != pred_end && ++pred_it == pred_end) {
+        it = this->_pre->erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  /// \brief Return true if the pre invariant of the given node was dropped
+  bool is_pre_dropped(NodeRef node) const {
+    return this->is_dropped(node) &&
+           this->_pre->find(node) == this->_pre->end();
+  }
+
+  /// \brief Compute the pre invariant of a node with a dropped pre invariant
+  ///
+  /// Walk backward along single predecessors up to a node with a known or
+  /// directly computable post invariant, then propagate forward.
+  AbstractValue compute_dropped_pre(NodeRef node) {
+    // Nodes with a dropped pre invariant, in backward order
+    std::vector< NodeRef > chain;
+    NodeRef pred = node;
+    do {
+      chain.push_back(pred);
+      pred = *GraphTrait::predecessor_begin(pred);
+    } while (this->is_pre_dropped(pred));
+
+    AbstractValue inv = this->recompute_post(pred);
+    for (auto it = chain.rbegin(), et = chain.rend(); it != et; ++it) {
+      NodeRef current = *it;
+      inv = this->analyze_edge(pred, current, std::move(inv));
+      if (current != node) {
+        inv = this->analyze_node(current, std::move(inv));
+      }
+      pred = current;
+    }
+
+    return inv;
+  }
+
 public:
   /// \brief Get the pre invariant for the given node
+  ///
+  /// \throws LogicError if the invariant was dropped by the sparse storage.
+  /// Use recompute_pre() or visit_chain() to recompute dropped invariants.
   const AbstractValue& pre(NodeRef node) const {
+    if (this->is_pre_dropped(node)) {
+      throw LogicError("fixpoint iterator: pre invariant was dropped");
+    }
     return this->get(this->_pre, node);
   }
 
   /// \brief Get the post invariant for the given node
+  ///
+  /// \throws LogicError if the invariant was dropped by the sparse storage.
+  /// Use recompute_post() or visit_chain() to recompute dropped invariants.
   const AbstractValue& post(NodeRef node) const {
+    if (this->is_dropped(node)) {
+      throw LogicError("fixpoint iterator: post invariant was dropped");
+    }
+    return this->get(this->_post, node);
+  }
+
+  /// \brief Return a copy of the pre invariant for the given node, recomputing
+  /// it if it was dropped by the sparse storage
+  ///
+  /// The recomputed invariant is not stored. It walks back to the closest
+  /// stored invariant, thus calling it on every node takes a quadratic time on
+  /// long chains of nodes. Use visit_chain() to visit all nodes.
+  AbstractValue recompute_pre(NodeRef node) {
+    if (this->is_pre_dropped(node)) {
+      return this->compute_dropped_pre(node);
+    }
+    return this->get(this->_pre, node);
+  }
+
+  /// \brief Return a copy of the post invariant for the given node,
+  /// recomputing it if it was dropped by the sparse storage
+  ///
+  /// The recomputed invariant is not stored.
+  AbstractValue recompute_post(NodeRef node) {
+    if (this->is_dropped(node)) {
+      return this->analyze_node(node, this->recompute_pre(node));
+    }
     return this->get(this->_post, node);
   }
 
+  /// \brief Visit the given node and the nodes whose pre invariant is
+  /// recomputed from it
+  ///
+  /// `f(node, pre)` is called with the pre invariant of the node and must
+  /// return its post invariant. With the sparse storage, the pre invariant of a
+  /// successor that was dropped is computed from the returned post invariant,
+  /// and the successor is visited in turn.
+  ///
+  /// Nothing is visited if the pre invariant of `node` was dropped, since
+  /// `node` is visited from its single predecessor. Hence, calling it on every
+  /// node visits each node exactly once, and each invariant is propagated once.
+  template < typename Function >
+  void visit_chain(NodeRef node, Function f) {
+    if (this->is_pre_dropped(node)) {
+      return;
+    }
+
+    // Nodes to visit, with their pre invariant
+    std::vector< std::pair< NodeRef, AbstractValue > > worklist;
+    worklist.emplace_back(node, this->get(this->_pre, node));
+    while (!worklist.empty()) {
+      NodeRef current = worklist.back().first;
+      AbstractValue post = f(current, std::move(worklist.back().second));
+      worklist.pop_back();
+
+      for (auto it = GraphTrait::successor_begin(current),
+                et = GraphTrait::successor_end(current);
+           it != et;
+           ++it) {
+        NodeRef succ = *it;
+        if (this->is_pre_dropped(succ)) {
+          worklist.emplace_back(succ, this->analyze_edge(current, succ, post));
+        }
+      }
+    }
+  }
+
   /// \brief Extrapolate the new state after an increasing iteration
   ///
   /// This is called after each iteration of a cycle, until the fixpoint is
@@ -236,18 +465,33 @@ public:
   }
 
   /// \brief Compute the fixpoint with the given initial abstract value
+  ///
+  /// With several jobs, independent components of the weak topological order
+  /// are analyzed concurrently, and the result is the same as with one job.
+  /// In that case, extrapolate(), refine_iteration(), refine(), analyze_node()
+  /// and analyze_edge() must be thread-safe.
   void run(AbstractValue init) {
+    this->_dropped = std::make_shared< NodeSet >();
     this->set_pre(GraphTrait::entry(this->_cfg), std::move(init));
-    WtoIterator iterator(*this);
-    this->_wto.accept(iterator);
+    if (this->_jobs > 1) {
+      ConcurrentScheduler scheduler(*this);
+      scheduler.run();
+    } else {
+      WtoIterator iterator(*this);
+      this->_wto.accept(iterator);
+    }
     WtoProcessor processor(*this);
     this->_wto.accept(processor);
+    if (this->_storage == InvariantStorage::Sparse) {
+      this->drop_invariants();
+    }
   }
 
   /// \brief Clear the current fixpoint
   void clear() {
     this->_pre = std::make_shared< InvariantTable >();
     this->_post = std::make_shared< InvariantTable >();
+    this->_dropped = std::make_shared< NodeSet >();
   }
 
   /// \brief Destructor
@@ -268,11 +512,17 @@ public:
   using WtoT = Wto< GraphRef, GraphTrait >;
   using WtoNestingT = typename WtoT::WtoNestingT;
 
+  using ConcurrentSchedulerT =
+      ConcurrentScheduler< GraphRef, AbstractValue, GraphTrait >;
+
 private:
   InterleavedIterator& _iterator;
+  ConcurrentSchedulerT* _scheduler;
 
 public:
-  explicit WtoIterator(InterleavedIterator& iterator) : _iterator(iterator) {}
+  explicit WtoIterator(InterleavedIterator& iterator,
+                       ConcurrentSchedulerT* scheduler = nullptr)
+      : _iterator(iterator), _scheduler(scheduler) {}
 
   void visit(const WtoVertexT& vertex) override {
     NodeRef node = vertex.node();
@@ -297,6 +547,17 @@ public:
     this->_iterator.set_post(node, this->_iterator.analyze_node(node, pre));
   }
 
+  /// \brief Visit the components of the body of a cycle
+  void visit_body(const WtoCycleT& cycle) {
+    if (this->_scheduler != nullptr) {
+      this->_scheduler->run(cycle);
+    } else {
+      for (auto it = cycle.begin(), et = cycle.end(); it != et; ++it) {
+        it->accept(*this);
+      }
+    }
+  }
+
   void visit(const WtoCycleT& cycle) override {
     NodeRef head = cycle.head();
     WtoNestingT cycle_nesting = this->_iterator.wto().nesting(head);
@@ -320,9 +581,7 @@ public:
       this->_iterator.set_pre(head, pre);
       this->_iterator.set_post(head, this->_iterator.analyze_node(head, pre));
 
-      for (auto it = cycle.begin(), et = cycle.end(); it != et; ++it) {
-        it->accept(*this);
-      }
+      this->visit_body(cycle);
 
       // Invariant from the head of the loop
       AbstractValue new_pre_in = AbstractValue::bottom();
@@ -378,9 +637,7 @@ public:
          ++iteration) {
       this->_iterator.set_post(head, this->_iterator.analyze_node(head, pre));
 
-      for (auto it = cycle.begin(), et = cycle.end(); it != et; ++it) {
-        it->accept(*this);
-      }
+      this->visit_body(cycle);
 
       // Invariant from the head of the loop
       AbstractValue new_pre_in = AbstractValue::bottom();
@@ -449,14 +706,16 @@ public:
 
   void visit(const WtoVertexT& vertex) override {
     NodeRef node = vertex.node();
-    this->_iterator.process_pre(node, this->_iterator.pre(node));
-    this->_iterator.process_post(node, this->_iterator.post(node));
+    const InterleavedIterator& iterator = this->_iterator;
+    this->_iterator.process_pre(node, iterator.pre(node));
+    this->_iterator.process_post(node, iterator.post(node));
   }
 
   void visit(const WtoCycleT& cycle) override {
     NodeRef head = cycle.head();
-    this->_iterator.process_pre(head, this->_iterator.pre(head));
-    this->_iterator.process_post(head, this->_iterator.post(head));
+    const InterleavedIterator& iterator = this->_iterator;
+    this->_iterator.process_pre(head, iterator.pre(head));
+    this->_iterator.process_post(head, iterator.post(head));
 
     for (auto it = cycle.begin(), et = cycle.end(); it != et; ++it) {
       it->accept(*this);
@@ -465,6 +724,374 @@ public:
 
 }; // end class WtoProcessor
 
+template < typename GraphRef, typename GraphTrait >
+class WtoHeadCollector final
+    : public WtoComponentVisitor< GraphRef, GraphTrait > {
+public:
+  using NodeRef = typename GraphTrait::NodeRef;
+  using WtoVertexT = WtoVertex< GraphRef, GraphTrait >;
+  using WtoCycleT = WtoCycle< GraphRef, GraphTrait >;
+
+private:
+  std::unordered_set< NodeRef >& _heads;
+
+public:
+  explicit WtoHeadCollector(std::unordered_set< NodeRef >& heads)
+      : _heads(heads) {}
+
+  void visit(const WtoVertexT&) override {}
+
+  void visit(const WtoCycleT& cycle) override {
+    this->_heads.insert(cycle.head());
+
+    for (auto it = cycle.begin(), et = cycle.end(); it != et; ++it) {
+      it->accept(*this);
+    }
+  }
+
+}; // end class WtoHeadCollector
+
+/// \brief Type of `inv.normalize()`
+template < typename AbstractValue >
+using NormalizeOp =
+    decltype(std::declval< const AbstractValue& >().normalize());
+
+/// \brief Normalize the given abstract value, if the domain supports it
+template < typename AbstractValue >
+std::enable_if_t< is_detected< NormalizeOp, AbstractValue >::value >
+normalize_invariant(const AbstractValue& inv) {
+  inv.normalize();
+}
+
+/// \brief Normalize the given abstract value, if the domain supports it
+template < typename AbstractValue >
+std::enable_if_t< !is_detected< NormalizeOp, AbstractValue >::value >
+normalize_invariant(const AbstractValue&) {}
+
+/// \brief Schedule independent components of a weak topological order on
+/// several threads
+///
+/// Sibling components (at the top level, or in the body of a cycle) only
+/// depend on the components that contain a predecessor of one of their nodes.
+/// A component is analyzed as soon as all the components it depends on are
+/// analyzed. Each component only writes the invariants of its own nodes and
+/// only reads invariants that are final, hence the result is deterministic.
+///
+/// Some abstract domains normalize lazily, and copies share the underlying
+/// representation, so that reading an invariant might update it. Post
+/// invariants read by several threads are thus normalized before they are
+/// published: invariants from outside of the sibling components are
+/// normalized before the fan-out, and invariants read by other sibling
+/// components are normalized by the thread that computed them. Copies from
+/// several threads must still be safe, e.g, using atomic reference counts.
+///
+/// The total number of threads is bounded by the number of jobs, including
+/// nested schedules in cycle bodies. The calling thread analyzes components
+/// along with helpers from the global ThreadPool, so the iteration still
+/// completes when the pool has no thread available. Sibling components with
+/// less than MinConcurrentNodes nodes are analyzed sequentially.
+template < typename GraphRef, typename AbstractValue, typename GraphTrait >
+class ConcurrentScheduler {
+public:
+  using InterleavedIterator =
+      InterleavedFwdFixpointIterator< GraphRef, AbstractValue, GraphTrait >;
+  using NodeRef = typename GraphTrait::NodeRef;
+  using WtoComponentT = WtoComponent< GraphRef, GraphTrait >;
+  using WtoVertexT = WtoVertex< GraphRef, GraphTrait >;
+  using WtoCycleT = WtoCycle< GraphRef, GraphTrait >;
+  using WtoIteratorT = WtoIterator< GraphRef, AbstractValue, GraphTrait >;
+
+private:
+  /// \brief Dependencies between sibling components
+  struct Schedule {
+    /// \brief Sibling components, in the weak topological order
+    std::vector< const WtoComponentT* > components;
+
+    /// \brief Components depending on each component
+    std::vector< std::vector< std::size_t > > successors;
+
+    /// \brief Number of components each component depends on
+    std::vector< std::size_t > num_predecessors;
+
+    /// \brief True if the components are totally ordered
+    bool sequential = true;
+
+    /// \brief Total number of nodes in the components
+    std::size_t num_nodes = 0;
+
+    /// \brief Nodes of each component with a post invariant read by other
+    /// sibling components
+    std::vector< std::vector< NodeRef > > exported;
+
+    /// \brief Predecessors of the components that are not part of them
+    std::vector< NodeRef > imported;
+  };
+
+  /// \brief Minimum number of nodes to analyze sibling components concurrently
+  ///
+  /// Below this size, the cost of the synchronization exceeds the gain.
+  static constexpr std::size_t MinConcurrentNodes = 8;
+
+  /// \brief Collect the nodes of a component
+  class NodeCollector final
+      : public WtoComponentVisitor< GraphRef, GraphTrait > {
+  private:
+    std::vector< NodeRef >& _nodes;
+
+  public:
+    explicit NodeCollector(std::vector< NodeRef >& nodes) : _nodes(nodes) {}
+
+    void visit(const WtoVertexT& vertex) override {
+      this->_nodes.push_back(vertex.node());
+    }
+
+    void visit(const WtoCycleT& cycle) override {
+      this->_nodes.push_back(cycle.head());
+      for (auto it = cycle.begin(), et = cycle.end(); it != et; ++it) {
+        it->accept(*this);
+      }
+    }
+
+  }; // end class NodeCollector
+
+private:
+  InterleavedIterator& _iterator;
+
+  /// \brief Number of threads that can still be started
+  std::atomic< unsigned > _available_threads;
+
+  /// \brief Schedules, for the top level (nullptr) and cycle bodies
+  std::unordered_map< const WtoComponentT*, std::unique_ptr< Schedule > >
+      _schedules;
+
+  /// \brief Mutex protecting the schedules
+  std::mutex _schedules_mutex;
+
+public:
+  explicit ConcurrentScheduler(InterleavedIterator& iterator)
+      : _iterator(iterator), _available_threads(iterator.jobs() - 1) {}
+
+  ConcurrentScheduler(const ConcurrentScheduler&) = delete;
+
+  ConcurrentScheduler& operator=(const ConcurrentScheduler&) = delete;
+
+  /// \brief Analyze the whole weak topological order
+  void run() {
+    this->prepare_invariants();
+    this->run(this->schedule(nullptr,
+                             this->_iterator.wto().begin(),
+                             this->_iterator.wto().end()));
+  }
+
+  /// \brief Analyze the body of a cycle
+  void run(const WtoCycleT& cycle) {
+    this->run(this->schedule(&cycle, cycle.begin(), cycle.end()));
+  }
+
+private:
+  /// \brief Insert all invariants in the tables beforehand
+  ///
+  /// Threads can then update invariants of distinct nodes without
+  /// synchronization.
+  void prepare_invariants() {
+    std::vector< NodeRef > nodes;
+    NodeCollector collector(nodes);
+    for (auto it = this->_iterator.wto().begin(),
+              et = this->_iterator.wto().end();
+         it != et;
+         ++it) {
+      it->accept(collector);
+    }
+
+    for (NodeRef node : nodes) {
+      this->_iterator._pre->emplace(node, AbstractValue::bottom());
+      this->_iterator._post->emplace(node, AbstractValue::bottom());
+    }
+
+    // Post invariants of predecessors are read, even if they are unreachable
+    for (NodeRef node : nodes) {
+      for (auto it = GraphTrait::predecessor_begin(node),
+                et = GraphTrait::predecessor_end(node);
+           it != et;
+           ++it) {
+        this->_iterator._post->emplace(*it, AbstractValue::bottom());
+      }
+    }
+  }
+
+  /// \brief Get or compute the schedule of the given sibling components
+  template < typename Iterator >
+  const Schedule& schedule(const WtoComponentT* parent,
+                           Iterator begin,
+                           Iterator end) {
+    std::lock_guard< std::mutex > lock(this->_schedules_mutex);
+
+    auto it = this->_schedules.find(parent);
+    if (it != this->_schedules.end()) {
+      return *it->second;
+    }
+
+    auto schedule = std::make_unique< Schedule >();
+
+    // Component index of each node
+    std::unordered_map< NodeRef, std::size_t > index;
+    std::vector< std::vector< NodeRef > > nodes;
+    for (auto c = begin; c != end; ++c) {
+      nodes.emplace_back();
+      NodeCollector collector(nodes.back());
+      c->accept(collector);
+      for (NodeRef node : nodes.back()) {
+        index.emplace(node, schedule->components.size());
+      }
+      schedule->components.push_back(&*c);
+    }
+
+    std::size_t n = schedule->components.size();
+    schedule->num_nodes = index.size();
+    schedule->successors.resize(n);
+    schedule->num_predecessors.assign(n, 0);
+    std::vector< std::unordered_set< NodeRef > > exported(n);
+    std::unordered_set< NodeRef > imported;
+
+    for (std::size_t i = 0; i < n; i++) {
+      std::vector< std::size_t > deps;
+      for (NodeRef node : nodes[i]) {
+        for (auto p = GraphTrait::predecessor_begin(node),
+                  pe = GraphTrait::predecessor_end(node);
+             p != pe;
+             ++p) {
+          auto j = index.find(*p);
+          if (j == index.end()) {
+            imported.insert(*p);
+          } else if (j->second != i) {
+            deps.push_back(j->second);
+            exported[j->second].insert(*p);
+          }
+        }
+      }
+      std::sort(deps.begin(), deps.end());
+      deps.erase(std::unique(deps.begin(), deps.end()), deps.end());
+
+      for (std::size_t j : deps) {
+        schedule->successors[j].push_back(i);
+      }
+      schedule->num_predecessors[i] = deps.size();
+
+      if (i > 0 && !std::binary_search(deps.begin(), deps.end(), i - 1)) {
+        schedule->sequential = false;
+      }
+    }
+
+    for (const auto& nodes_i : exported) {
+      schedule->exported.emplace_back(nodes_i.begin(), nodes_i.end());
+    }
+    schedule->imported.assign(imported.begin(), imported.end());
+
+    auto res = this->_schedules.emplace(parent, std::move(schedule));
+    return *res.first->second;
+  }
+
+  /// \brief Try to reserve up to `n` threads
+  unsigned acquire_threads(unsigned n) {
+    unsigned available = this->_available_threads.load();
+    unsigned reserved;
+    do {
+      reserved = std::min(available, n);
+    } while (reserved > 0 && !this->_available_threads.compare_exchange_weak(
+                                 available, available - reserved));
+    return reserved;
+  }
+
+  /// \brief Release `n` threads
+  void release_threads(unsigned n) { this->_available_threads += n; }
+
+  /// \brief Analyze the given sibling components
+  void run(const Schedule& schedule) {
+    std::size_t n = schedule.components.size();
+    unsigned threads = 0;
+    if (!schedule.sequential && schedule.num_nodes >= MinConcurrentNodes) {
+      threads = this->acquire_threads(
+          static_cast< unsigned >(std::min< std::size_t >(n - 1, ~0U)));
+    }
+
+    if (threads == 0) {
+      WtoIteratorT iterator(this->_iterator, this);
+      for (const WtoComponentT* component : schedule.components) {
+        component->accept(iterator);
+      }
+      return;
+    }
+
+    // Invariants from outside are final, normalize them before the fan-out
+    for (NodeRef node : schedule.imported) {
+      normalize_invariant(this->_iterator.get(this->_iterator._post, node));
+    }
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector< std::size_t > remaining = schedule.num_predecessors;
+    std::deque< std::size_t > ready;
+    std::size_t done = 0;
+    std::exception_ptr error = nullptr;
+
+    for (std::size_t i = 0; i < n; i++) {
+      if (remaining[i] == 0) {
+        ready.push_back(i);
+      }
+    }
+
+    auto worker = [&]() {
+      WtoIteratorT iterator(this->_iterator, this);
+      std::unique_lock< std::mutex > lock(mutex);
+      while (true) {
+        cv.wait(lock, [&] {
+          return !ready.empty() || done == n || error != nullptr;
+        });
+        if (done == n || error != nullptr) {
+          return;
+        }
+        std::size_t i = ready.front();
+        ready.pop_front();
+        lock.unlock();
+
+        try {
+          schedule.components[i]->accept(iterator);
+
+          // Normalize the invariants read by the next components
+          for (NodeRef node : schedule.exported[i]) {
+            normalize_invariant(
+                this->_iterator.get(this->_iterator._post, node));
+          }
+        } catch (...) {
+          lock.lock();
+          if (error == nullptr) {
+            error = std::current_exception();
+          }
+          cv.notify_all();
+          return;
+        }
+
+        lock.lock();
+        done++;
+        for (std::size_t succ : schedule.successors[i]) {
+          if (--remaining[succ] == 0) {
+            ready.push_back(succ);
+          }
+        }
+        cv.notify_all();
+      }
+    };
+
+    ThreadPool::get().run(threads, worker);
+    this->release_threads(threads);
+
+    if (error != nullptr) {
+      std::rethrow_exception(error);
+    }
+  }
+
+}; // end class ConcurrentScheduler
+
 } // end namespace interleaved_fwd_fixpoint_iterator_impl
 
 } // end namespace core
@@ -580,11 +580,14 @@ public:
 
   /// \brief Copy constructor
   Wto(const Wto& other)
-      : _components(other._components), _nesting_table(other._nesting_table) {}
+      : _components(other._components),
+        _num(0),
+        _nesting_table(other._nesting_table) {}
 
   /// \brief Move constructor
   Wto(Wto&& other)
       : _components(std::move(other._components)),
+        _num(0),
         _nesting_table(std::move(other._nesting_table)) {}
 
   /// \brief Copy assignment operator
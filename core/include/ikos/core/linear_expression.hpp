@@ -43,12 +43,14 @@
 
 #pragma once
 
+#include <algorithm>
 #include <iostream>
+#include <utility>
 
-#include <boost/container/flat_map.hpp>
 #include <boost/optional.hpp>
 
 #include <ikos/core/adt/patricia_tree/set.hpp>
+#include <ikos/core/adt/small_vector.hpp>
 #include <ikos/core/semantic/dumpable.hpp>
 #include <ikos/core/semantic/indexable.hpp>
 #include <ikos/core/semantic/variable.hpp>
@@ -113,17 +115,22 @@ public:
   using VariableExpressionT = VariableExpression< Number, VariableRef >;
 
 private:
-  using Map = boost::container::flat_map< VariableRef, Number >;
+  using Term = std::pair< VariableRef, Number >;
+
+  /// \brief List of terms, sorted by variable
+  ///
+  /// Most linear expressions have one or two terms, which are stored inline.
+  using Terms = SmallVector< Term, 2 >;
 
 public:
   /// \brief Iterator over the terms
-  using TermIterator = typename Map::iterator;
+  using TermIterator = typename Terms::iterator;
 
   /// \brief Constant iterator over the terms
-  using TermConstIterator = typename Map::const_iterator;
+  using TermConstIterator = typename Terms::const_iterator;
 
 private:
-  Map _map;
+  Terms _terms;
   Number _cst;
 
 public:
@@ -138,25 +145,25 @@ public:
 
   /// \brief Create a variable expression
   explicit LinearExpression(VariableRef var) {
-    this->_map.emplace(var, Number(1));
+    this->_terms.emplace_back(var, Number(1));
   }
 
   /// \brief Create a variable expression
   explicit LinearExpression(VariableExpressionT e) {
-    this->_map.emplace(e.var(), Number(1));
+    this->_terms.emplace_back(e.var(), Number(1));
   }
 
   /// \brief Create the expression cst * var
   LinearExpression(Number cst, VariableRef var) {
     if (cst != 0) {
-      this->_map.emplace(var, std::move(cst));
+      this->_terms.emplace_back(var, std::move(cst));
     }
   }
 
   /// \brief Create the expression cst * var
   LinearExpression(int cst, VariableRef var) {
     if (cst != 0) {
-      this->_map.emplace(var, Number(cst));
+      this->_terms.emplace_back(var, Number(cst));
     }
   }
 
@@ -177,8 +184,28 @@ public:
 
 private:
   /// \brief Private constructor
-  LinearExpression(Map map, Number cst)
-      : _map(std::move(map)), _cst(std::move(cst)) {}
+  LinearExpression(Terms terms, Number cst)
+      : _terms(std::move(terms)), _cst(std::move(cst)) {}
+
+  /// \brief Return the first term with a variable not less than `var`
+  TermIterator lower_bound(VariableRef var) {
+    return std::lower_bound(this->_terms.begin(),
+                            this->_terms.end(),
+                            var,
+                            [](const Term& t, VariableRef v) {
+                              return t.first < v;
+                            });
+  }
+
+  /// \brief Return the first term with a variable not less than `var`
+  TermConstIterator lower_bound(VariableRef var) const {
+    return std::lower_bound(this->_terms.begin(),
+                            this->_terms.end(),
+                            var,
+                            [](const Term& t, VariableRef v) {
+                              return t.first < v;
+                            });
+  }
 
 public:
   /// \brief Add a constant
@@ -192,61 +219,61 @@ public:
 
   /// \brief Add a term cst * var
   void add(const Number& cst, VariableRef var) {
-    auto it = this->_map.find(var);
-    if (it != this->_map.end()) {
+    auto it = this->lower_bound(var);
+    if (it != this->_terms.end() && it->first == var) {
       Number r = it->second + cst;
       if (r == 0) {
-        this->_map.erase(it);
+        this->_terms.erase(it);
       } else {
         it->second = r;
       }
     } else {
       if (cst != 0) {
-        this->_map.emplace(var, cst);
+        this->_terms.emplace(it, var, cst);
       }
     }
   }
 
   /// \brief Add a term cst * var
   void add(int cst, VariableRef var) {
-    auto it = this->_map.find(var);
-    if (it != this->_map.end()) {
+    auto it = this->lower_bound(var);
+    if (it != this->_terms.end() && it->first == var) {
       Number r = it->second + cst;
       if (r == 0) {
-        this->_map.erase(it);
+        this->_terms.erase(it);
       } else {
         it->second = r;
       }
     } else {
       if (cst != 0) {
-        this->_map.emplace(var, Number(cst));
+        this->_terms.emplace(it, var, Number(cst));
       }
     }
   }
 
   /// \brief Return the begin iterator over the terms
-  TermIterator begin() { return this->_map.begin(); }
-  TermConstIterator begin() const { return this->_map.begin(); }
-  TermConstIterator cbegin() const { return this->_map.cbegin(); }
+  TermIterator begin() { return this->_terms.begin(); }
+  TermConstIterator begin() const { return this->_terms.begin(); }
+  TermConstIterator cbegin() const { return this->_terms.cbegin(); }
 
   /// \brief Return the end iterator over the terms
-  TermIterator end() { return this->_map.end(); }
-  TermConstIterator end() const { return this->_map.end(); }
-  TermConstIterator cend() const { return this->_map.cend(); }
+  TermIterator end() { return this->_terms.end(); }
+  TermConstIterator end() const { return this->_terms.end(); }
+  TermConstIterator cend() const { return this->_terms.cend(); }
 
   /// \brief Return the number of terms
-  std::size_t num_terms() const { return this->_map.size(); }
+  std::size_t num_terms() const { return this->_terms.size(); }
 
   /// \brief Return true if the linear expression is constant
-  bool is_constant() const { return this->_map.empty(); }
+  bool is_constant() const { return this->_terms.empty(); }
 
   /// \brief Return the constant
   const Number& constant() const { return this->_cst; }
 
   /// \brief Return the factor for the given variable
   Number factor(VariableRef var) const {
-    auto it = this->_map.find(var);
-    if (it != this->_map.end()) {
+    auto it = this->lower_bound(var);
+    if (it != this->_terms.end() && it->first == var) {
       return it->second;
     } else {
       return Number(0);
@@ -297,10 +324,10 @@ public:
   /// \brief Multiply by a constant
   void operator*=(const Number& n) {
     if (n == 0) {
-      this->_map.clear();
+      this->_terms.clear();
       this->_cst = 0;
     } else {
-      for (auto& term : this->_map) {
+      for (auto& term : this->_terms) {
         term.second *= n;
       }
       this->_cst *= n;
@@ -310,10 +337,10 @@ public:
   /// \brief Multiply by a constant
   void operator*=(int n) {
     if (n == 0) {
-      this->_map.clear();
+      this->_terms.clear();
       this->_cst = 0;
     } else {
-      for (auto& term : this->_map) {
+      for (auto& term : this->_terms) {
         term.second *= n;
       }
       this->_cst *= n;
@@ -323,8 +350,8 @@ public:
   /// \brief If the linear expression is just a variable v, return v, otherwise
   /// return boost::none.
   boost::optional< VariableRef > variable() const {
-    if (this->_cst == 0 && this->_map.size() == 1) {
-      auto it = this->_map.begin();
+    if (this->_cst == 0 && this->_terms.size() == 1) {
+      auto it = this->_terms.begin();
       if (it->second == 1) {
         return it->first;
       }
@@ -335,7 +362,7 @@ public:
   /// \brief Return the set of variables present in the linear expression
   PatriciaTreeSet< VariableRef > variables() const {
     PatriciaTreeSet< VariableRef > vars;
-    for (const auto& term : this->_map) {
+    for (const auto& term : this->_terms) {
       vars.insert(term.first);
     }
     return vars;
@@ -343,10 +370,11 @@ public:
 
   /// \brief Dump the linear expression, for debugging purpose
   void dump(std::ostream& o) const {
-    for (auto it = this->_map.begin(), et = this->_map.end(); it != et; ++it) {
+    for (auto it = this->_terms.begin(), et = this->_terms.end(); it != et;
+         ++it) {
       const Number& cst = it->second;
       VariableRef var = it->first;
-      if (cst > 0 && it != this->_map.begin()) {
+      if (cst > 0 && it != this->_terms.begin()) {
         o << "+";
       }
       if (cst == -1) {
@@ -356,10 +384,10 @@ public:
       }
       DumpableTraits< VariableRef >::dump(o, var);
     }
-    if (this->_cst > 0 && !this->_map.empty()) {
+    if (this->_cst > 0 && !this->_terms.empty()) {
       o << "+";
     }
-    if (this->_cst != 0 || this->_map.empty()) {
+    if (this->_cst != 0 || this->_terms.empty()) {
       o << this->_cst;
     }
   }
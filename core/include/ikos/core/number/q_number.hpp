@@ -81,7 +81,7 @@ struct ZNumberAdapter : public MpzAdapter< T > {};
 
 template <>
 struct ZNumberAdapter< const ZNumber& > {
-  const mpz_class& operator()(const ZNumber& n) { return n.mpz(); }
+  mpz_class operator()(const ZNumber& n) { return n.mpz(); }
 };
 
 } // end namespace detail
@@ -141,10 +141,10 @@ public:
   QNumber(QNumber&&) = default;
 
   /// \brief Create a QNumber from a ZNumber
-  explicit QNumber(const ZNumber& n) : _n(n._n) {}
+  explicit QNumber(const ZNumber& n) : _n(n.mpz()) {}
 
   /// \brief Create a QNumber from a ZNumber
-  explicit QNumber(ZNumber&& n) : _n(std::move(n)._n) {}
+  explicit QNumber(ZNumber&& n) : _n(n.mpz()) {}
 
   /// \brief Create a QNumber from an integral type
   template < typename N,
@@ -175,14 +175,15 @@ public:
   }
 
   /// \brief Create a QNumber from a numerator and a denominator
-  explicit QNumber(const ZNumber& n, const ZNumber& d) : _n(n._n, d._n) {
+  explicit QNumber(const ZNumber& n, const ZNumber& d)
+      : _n(n.mpz(), d.mpz()) {
     ikos_assert_msg(this->_n.get_den() != 0, "denominator is zero");
     this->_n.canonicalize();
   }
 
   /// \brief Create a QNumber from a numerator and a denominator
   explicit QNumber(ZNumber&& n, ZNumber&& d)
-      : _n(std::move(n)._n, std::move(d)._n) {
+      : _n(n.mpz(), d.mpz()) {
     ikos_assert_msg(this->_n.get_den() != 0, "denominator is zero");
     this->_n.canonicalize();
   }
@@ -210,13 +211,13 @@ public:
 
   /// \brief Assignment for ZNumber
   QNumber& operator=(const ZNumber& n) {
-    this->_n = n._n;
+    this->_n = n.mpz();
     return *this;
   }
 
   /// \brief Assignment for ZNumber
   QNumber& operator=(ZNumber&& n) noexcept {
-    this->_n = std::move(n._n);
+    this->_n = n.mpz();
     return *this;
   }
 
@@ -46,8 +46,12 @@
 
 #pragma once
 
+#include <cstdint>
+#include <cstdlib>
 #include <functional>
 #include <iosfwd>
+#include <limits>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <type_traits>
@@ -280,12 +284,115 @@ template <>
 struct MpzTo< long long >
     : public MpzToLongLong< sizeof(long long) == sizeof(long) > {};
 
+
+/// \brief Return true if the given integer fits in a int64_t
+template < typename T >
+inline bool fits_int64(T n) {
+  return std::is_signed< T >::value ||
+         static_cast< std::uint64_t >(n) <=
+             static_cast< std::uint64_t >(
+                 std::numeric_limits< std::int64_t >::max());
+}
+
+/// \brief Return true if the given int64_t fits in the integer type T
+template < typename T >
+inline bool int64_fits(std::int64_t n) {
+  if (std::is_signed< T >::value) {
+    return n >= static_cast< std::int64_t >(std::numeric_limits< T >::min()) &&
+           n <= static_cast< std::int64_t >(std::numeric_limits< T >::max());
+  } else {
+    return n >= 0 && static_cast< std::uint64_t >(n) <=
+                         static_cast< std::uint64_t >(
+                             std::numeric_limits< T >::max());
+  }
+}
+
+/// \brief Return the absolute value of the given int64_t, as a uint64_t
+///
+/// This is well defined for INT64_MIN.
+inline std::uint64_t abs_uint64(std::int64_t n) {
+  return n < 0 ? -static_cast< std::uint64_t >(n)
+               : static_cast< std::uint64_t >(n);
+}
+
 } // end namespace detail
 
 /// \brief Class for unlimited precision integers
+///
+/// Numbers that fit in a int64_t are stored inline and handled with native
+/// arithmetic. Operations check for overflows using the compiler builtins and
+/// fall back to GMP when the result does not fit anymore.
+///
+/// The representation is canonical: a number is stored with GMP if and only
+/// if it does not fit in a int64_t.
 class ZNumber {
 private:
-  mpz_class _n;
+  /// \brief Inline value, valid if `_big` is null
+  std::int64_t _small = 0;
+
+  /// \brief GMP value, for numbers that do not fit in a int64_t
+  std::unique_ptr< mpz_class > _big;
+
+private:
+  /// \brief Convert a int64_t into an operand for gmpxx
+  static auto gmp_operand(std::int64_t n) {
+    return detail::MpzAdapter< std::int64_t >()(n);
+  }
+
+  /// \brief Switch to the GMP representation, and return it
+  mpz_class& promote() {
+    if (!this->_big) {
+      this->_big = std::make_unique< mpz_class >(gmp_operand(this->_small));
+    }
+    return *this->_big;
+  }
+
+  /// \brief Switch back to the inline representation, if the number fits
+  void normalize() {
+    if (this->_big && detail::MpzFits< std::int64_t >()(*this->_big)) {
+      this->_small = detail::MpzTo< std::int64_t >()(*this->_big);
+      this->_big.reset();
+    }
+  }
+
+  /// \brief Set the number from a mpz_class
+  void set(const mpz_class& n) {
+    if (detail::MpzFits< std::int64_t >()(n)) {
+      this->_small = detail::MpzTo< std::int64_t >()(n);
+      this->_big.reset();
+    } else if (this->_big) {
+      *this->_big = n;
+    } else {
+      this->_big = std::make_unique< mpz_class >(n);
+    }
+  }
+
+  /// \brief Slow path, apply `f(mpz_class&, operand)` with GMP
+  template < typename Function >
+  void apply_gmp(const ZNumber& x, Function f) {
+    mpz_class& n = this->promote();
+    if (x._big) {
+      f(n, *x._big);
+    } else {
+      f(n, gmp_operand(x._small));
+    }
+    this->normalize();
+  }
+
+  /// \brief Return -1, 0 or 1 depending on the sign of the number
+  int sign() const {
+    if (!this->_big) {
+      return (this->_small > 0) - (this->_small < 0);
+    }
+    return mpz_sgn(this->_big->get_mpz_t());
+  }
+
+  /// \brief Return the given shift count, as an unsigned long
+  static unsigned long shift_count(const ZNumber& x) {
+    ikos_assert_msg(x.sign() >= 0, "shift count is negative");
+    ikos_assert_msg(x.fits< unsigned long >(), "shift count is too big");
+    return x.to< unsigned long >();
+  }
 
 public:
   /// \brief Create a ZNumber from a string representation
@@ -331,21 +438,36 @@ public:
   ZNumber() = default;
 
   /// \brief Copy constructor
-  ZNumber(const ZNumber&) = default;
+  ZNumber(const ZNumber& n)
+      : _small(n._small),
+        _big(n._big ? std::make_unique< mpz_class >(*n._big) : nullptr) {}
 
   /// \brief Move constructor
-  ZNumber(ZNumber&&) = default;
+  ZNumber(ZNumber&&) noexcept = default;
 
   /// \brief Create a ZNumber from a mpz_class
-  explicit ZNumber(const mpz_class& n) : _n(n) {}
+  explicit ZNumber(const mpz_class& n) { this->set(n); }
 
   /// \brief Create a ZNumber from a mpz_class
-  explicit ZNumber(mpz_class&& n) : _n(std::move(n)) {}
+  explicit ZNumber(mpz_class&& n) {
+    if (detail::MpzFits< std::int64_t >()(n)) {
+      this->_small = detail::MpzTo< std::int64_t >()(n);
+    } else {
+      this->_big = std::make_unique< mpz_class >(std::move(n));
+    }
+  }
 
   /// \brief Create a ZNumber from an integral type
   template < typename T,
              class = std::enable_if_t< IsSupportedIntegral< T >::value > >
-  explicit ZNumber(T n) : _n(detail::MpzAdapter< T >()(n)) {}
+  explicit ZNumber(T n) {
+    if (detail::fits_int64(n)) {
+      this->_small = static_cast< std::int64_t >(n);
+    } else {
+      this->_big =
+          std::make_unique< mpz_class >(detail::MpzAdapter< T >()(n));
+    }
+  }
 
   /// \brief Destructor
   ~ZNumber() = default;
@@ -355,7 +477,18 @@ public:
   /// @{
 
   /// \brief Copy assignment
-  ZNumber& operator=(const ZNumber&) = default;
+  ZNumber& operator=(const ZNumber& n) {
+    if (this == &n) {
+      return *this;
+    }
+    if (n._big) {
+      this->set(*n._big);
+    } else {
+      this->_small = n._small;
+      this->_big.reset();
+    }
+    return *this;
+  }
 
   /// \brief Move assignment
   ZNumber& operator=(ZNumber&&) noexcept = default;
@@ -364,13 +497,18 @@ public:
   template < typename T,
              class = std::enable_if_t< IsSupportedIntegral< T >::value > >
   ZNumber& operator=(T n) {
-    this->_n = detail::MpzAdapter< T >()(n);
-    return *this;
+    return this->operator=(ZNumber(n));
   }
 
   /// \brief Addition assignment
   ZNumber& operator+=(const ZNumber& x) {
-    this->_n += x._n;
+    std::int64_t r;
+    if (!this->_big && !x._big &&
+        !__builtin_add_overflow(this->_small, x._small, &r)) {
+      this->_small = r;
+    } else {
+      this->apply_gmp(x, [](mpz_class& n, const auto& y) { n += y; });
+    }
     return *this;
   }
 
@@ -378,13 +516,18 @@ public:
   template < typename T,
              class = std::enable_if_t< IsSupportedIntegral< T >::value > >
   ZNumber& operator+=(T x) {
-    this->_n += detail::MpzAdapter< T >()(x);
-    return *this;
+    return this->operator+=(ZNumber(x));
   }
 
   /// \brief Subtraction assignment
   ZNumber& operator-=(const ZNumber& x) {
-    this->_n -= x._n;
+    std::int64_t r;
+    if (!this->_big && !x._big &&
+        !__builtin_sub_overflow(this->_small, x._small, &r)) {
+      this->_small = r;
+    } else {
+      this->apply_gmp(x, [](mpz_class& n, const auto& y) { n -= y; });
+    }
     return *this;
   }
 
@@ -392,13 +535,18 @@ public:
   template < typename T,
              class = std::enable_if_t< IsSupportedIntegral< T >::value > >
   ZNumber& operator-=(T x) {
-    this->_n -= detail::MpzAdapter< T >()(x);
-    return *this;
+    return this->operator-=(ZNumber(x));
   }
 
   /// \brief Multiplication assignment
   ZNumber& operator*=(const ZNumber& x) {
-    this->_n *= x._n;
+    std::int64_t r;
+    if (!this->_big && !x._big &&
+        !__builtin_mul_overflow(this->_small, x._small, &r)) {
+      this->_small = r;
+    } else {
+      this->apply_gmp(x, [](mpz_class& n, const auto& y) { n *= y; });
+    }
     return *this;
   }
 
@@ -406,16 +554,21 @@ public:
   template < typename T,
              class = std::enable_if_t< IsSupportedIntegral< T >::value > >
   ZNumber& operator*=(T x) {
-    this->_n *= detail::MpzAdapter< T >()(x);
-    return *this;
+    return this->operator*=(ZNumber(x));
   }
 
   /// \brief Integer division assignment
   ///
   /// Integer division with rounding towards zero.
   ZNumber& operator/=(const ZNumber& x) {
-    ikos_assert_msg(x._n != 0, "division by zero");
-    this->_n /= x._n;
+    ikos_assert_msg(x.sign() != 0, "division by zero");
+    if (!this->_big && !x._big &&
+        !(x._small == -1 &&
+          this->_small == std::numeric_limits< std::int64_t >::min())) {
+      this->_small /= x._small;
+    } else {
+      this->apply_gmp(x, [](mpz_class& n, const auto& y) { n /= y; });
+    }
     return *this;
   }
 
@@ -426,8 +579,7 @@ public:
              class = std::enable_if_t< IsSupportedIntegral< T >::value > >
   ZNumber& operator/=(T x) {
     ikos_assert_msg(x != 0, "division by zero");
-    this->_n /= detail::MpzAdapter< T >()(x);
-    return *this;
+    return this->operator/=(ZNumber(x));
   }
 
   /// \brief Remainder assignment
@@ -438,8 +590,13 @@ public:
   /// The sign of `x` is ignored, and the result will have the same sign as
   /// `this`.
   ZNumber& operator%=(const ZNumber& x) {
-    ikos_assert_msg(x._n != 0, "division by zero");
-    this->_n %= x._n;
+    ikos_assert_msg(x.sign() != 0, "division by zero");
+    if (!this->_big && !x._big) {
+      // Avoid the overflow of INT64_MIN % -1
+      this->_small = (x._small == -1) ? 0 : (this->_small % x._small);
+    } else {
+      this->apply_gmp(x, [](mpz_class& n, const auto& y) { n %= y; });
+    }
     return *this;
   }
 
@@ -454,13 +611,16 @@ public:
              class = std::enable_if_t< IsSupportedIntegral< T >::value > >
   ZNumber& operator%=(T x) {
     ikos_assert_msg(x != 0, "division by zero");
-    this->_n %= detail::MpzAdapter< T >()(x);
-    return *this;
+    return this->operator%=(ZNumber(x));
   }
 
   /// \brief Bitwise AND assignment
   ZNumber& operator&=(const ZNumber& x) {
-    this->_n &= x._n;
+    if (!this->_big && !x._big) {
+      this->_small &= x._small;
+    } else {
+      this->apply_gmp(x, [](mpz_class& n, const auto& y) { n &= y; });
+    }
     return *this;
   }
 
@@ -468,13 +628,16 @@ public:
   template < typename T,
              class = std::enable_if_t< IsSupportedIntegral< T >::value > >
   ZNumber& operator&=(T x) {
-    this->_n &= detail::MpzAdapter< T >()(x);
-    return *this;
+    return this->operator&=(ZNumber(x));
   }
 
   /// \brief Bitwise OR assignment
   ZNumber& operator|=(const ZNumber& x) {
-    this->_n |= x._n;
+    if (!this->_big && !x._big) {
+      this->_small |= x._small;
+    } else {
+      this->apply_gmp(x, [](mpz_class& n, const auto& y) { n |= y; });
+    }
     return *this;
   }
 
@@ -482,13 +645,16 @@ public:
   template < typename T,
              class = std::enable_if_t< IsSupportedIntegral< T >::value > >
   ZNumber& operator|=(T x) {
-    this->_n |= detail::MpzAdapter< T >()(x);
-    return *this;
+    return this->operator|=(ZNumber(x));
   }
 
   /// \brief Bitwise XOR assignment
   ZNumber& operator^=(const ZNumber& x) {
-    this->_n ^= x._n;
+    if (!this->_big && !x._big) {
+      this->_small ^= x._small;
+    } else {
+      this->apply_gmp(x, [](mpz_class& n, const auto& y) { n ^= y; });
+    }
     return *this;
   }
 
@@ -496,18 +662,14 @@ public:
   template < typename T,
              class = std::enable_if_t< IsSupportedIntegral< T >::value > >
   ZNumber& operator^=(T x) {
-    this->_n ^= detail::MpzAdapter< T >()(x);
-    return *this;
+    return this->operator^=(ZNumber(x));
   }
 
   /// \brief Left binary shift assignment
   ///
   /// This is undefined if `x` isn't between 0 and 2**32 - 1
   ZNumber& operator<<=(const ZNumber& x) {
-    ikos_assert_msg(x._n >= 0, "shift count is negative");
-    ikos_assert_msg(x._n.fits_ulong_p(), "shift count is too big");
-    this->_n <<= x._n.get_ui();
-    return *this;
+    return this->shl(shift_count(x));
   }
 
   /// \brief Left binary shift assignment with integral types
@@ -517,18 +679,14 @@ public:
              class = std::enable_if_t< IsSupportedIntegral< T >::value > >
   ZNumber& operator<<=(T x) {
     ikos_assert_msg(x >= 0, "shift count is negative");
-    this->_n <<= static_cast< unsigned long int >(x);
-    return *this;
+    return this->shl(static_cast< unsigned long >(x));
   }
 
   /// \brief Right binary shift
   ///
   /// This is undefined if `x` isn't between 0 and 2**32 - 1
   ZNumber& operator>>=(const ZNumber& x) {
-    ikos_assert_msg(x._n >= 0, "shift count is negative");
-    ikos_assert_msg(x._n.fits_ulong_p(), "shift count is too big");
-    this->_n >>= x._n.get_ui();
-    return *this;
+    return this->ashr(shift_count(x));
   }
 
   /// \brief Right binary shift with integral types
@@ -538,10 +696,46 @@ public:
              class = std::enable_if_t< IsSupportedIntegral< T >::value > >
   ZNumber& operator>>=(T x) {
     ikos_assert_msg(x >= 0, "shift count is negative");
-    this->_n >>= static_cast< unsigned long int >(x);
+    return this->ashr(static_cast< unsigned long >(x));
+  }
+
+private:
+  /// \brief Left binary shift assignment by `s` bits
+  ZNumber& shl(unsigned long s) {
+    std::int64_t r;
+    if (!this->_big &&
+        (this->_small == 0 ||
+         (s < 63 && !__builtin_mul_overflow(this->_small,
+                                            std::int64_t(1) << s,
+                                            &r)))) {
+      if (this->_small != 0) {
+        this->_small = r;
+      }
+    } else {
+      this->promote() <<= s;
+      this->normalize();
+    }
     return *this;
   }
 
+  /// \brief Arithmetic right binary shift assignment by `s` bits
+  ///
+  /// The result is rounded towards negative infinity.
+  ZNumber& ashr(unsigned long s) {
+    if (!this->_big) {
+      if (s >= 64) {
+        this->_small = (this->_small < 0) ? -1 : 0;
+      } else {
+        this->_small >>= s;
+      }
+    } else {
+      *this->_big >>= s;
+      this->normalize();
+    }
+    return *this;
+  }
+
+public:
   /// @}
   /// \name Unary Operators
   /// @{
@@ -551,30 +745,49 @@ public:
 
   /// \brief Prefix increment
   ZNumber& operator++() {
-    ++this->_n;
+    std::int64_t r;
+    if (!this->_big && !__builtin_add_overflow(this->_small, 1, &r)) {
+      this->_small = r;
+    } else {
+      ++this->promote();
+      this->normalize();
+    }
     return *this;
   }
 
   /// \brief Postfix increment
   const ZNumber operator++(int) {
     ZNumber r(*this);
-    ++this->_n;
+    ++(*this);
     return r;
   }
 
   /// \brief Unary minus
-  const ZNumber operator-() const { return ZNumber(-this->_n); }
+  const ZNumber operator-() const {
+    if (!this->_big &&
+        this->_small != std::numeric_limits< std::int64_t >::min()) {
+      return ZNumber(-this->_small);
+    } else {
+      return ZNumber(-this->mpz());
+    }
+  }
 
   /// \brief Prefix decrement
   ZNumber& operator--() {
-    --this->_n;
+    std::int64_t r;
+    if (!this->_big && !__builtin_sub_overflow(this->_small, 1, &r)) {
+      this->_small = r;
+    } else {
+      --this->promote();
+      this->normalize();
+    }
     return *this;
   }
 
   /// \brief Postfix decrement
   const ZNumber operator--(int) {
     ZNumber r(*this);
-    --this->_n;
+    --(*this);
     return r;
   }
 
@@ -582,14 +795,17 @@ public:
   ///
   /// This is undefined for negative numbers.
   ZNumber next_power_of_2() const {
-    ikos_assert(this->_n >= 0);
+    ikos_assert(this->sign() >= 0);
 
-    if (this->_n <= 1) {
+    if (!this->_big && this->_small <= 1) {
       return ZNumber(1);
     }
 
-    ZNumber n(this->_n - 1);
-    return ZNumber(mpz_class(1) << n.size_in_bits());
+    ZNumber n(*this);
+    --n;
+    ZNumber r(1);
+    r <<= n.size_in_bits();
+    return r;
   }
 
   /// @}
@@ -600,66 +816,114 @@ public:
   ///
   /// This is undefined if the number is 0.
   uint64_t trailing_zeros() const {
-    ikos_assert(this->_n != 0);
-    return mpz_scan1(this->_n.get_mpz_t(), 0);
+    ikos_assert(this->sign() != 0);
+    if (!this->_big) {
+      return static_cast< uint64_t >(
+          __builtin_ctzll(static_cast< unsigned long long >(this->_small)));
+    }
+    return mpz_scan1(this->_big->get_mpz_t(), 0);
   }
 
   /// \brief Return the number of trailing '1' bits
   ///
   /// This is undefined if the number is -1.
   uint64_t trailing_ones() const {
-    ikos_assert(this->_n != -1);
-    return mpz_scan0(this->_n.get_mpz_t(), 0);
+    ikos_assert(this->_big || this->_small != -1);
+    if (!this->_big) {
+      return static_cast< uint64_t >(
+          __builtin_ctzll(~static_cast< unsigned long long >(this->_small)));
+    }
+    return mpz_scan0(this->_big->get_mpz_t(), 0);
   }
 
   /// \brief Return the number of bits
   ///
   /// The sign is ignored.
   uint64_t size_in_bits() const {
-    return mpz_sizeinbase(this->_n.get_mpz_t(), 2);
+    if (!this->_big) {
+      if (this->_small == 0) {
+        return 1;
+      }
+      return 64 - static_cast< uint64_t >(__builtin_clzll(
+                      detail::abs_uint64(this->_small)));
+    }
+    return mpz_sizeinbase(this->_big->get_mpz_t(), 2);
   }
 
   /// @}
   /// \name Conversion Functions
   /// @{
 
-  /// \brief Get the internal representation
-  const mpz_class& mpz() const { return this->_n; }
+  /// \brief Return the number as a mpz_class
+  mpz_class mpz() const {
+    if (this->_big) {
+      return *this->_big;
+    }
+    return mpz_class(gmp_operand(this->_small));
+  }
 
   /// \brief Return true if the number fits in the given integer type
   template < typename T,
              class = std::enable_if_t< IsSupportedIntegral< T >::value > >
   bool fits() const {
-    return detail::MpzFits< T >()(this->_n);
+    if (!this->_big) {
+      return detail::int64_fits< T >(this->_small);
+    }
+    return detail::MpzFits< T >()(*this->_big);
   }
 
   /// \brief Return the number as the given integer type
   template < typename T,
              class = std::enable_if_t< IsSupportedIntegral< T >::value > >
   T to() const {
-    ikos_assert_msg(detail::MpzFits< T >()(this->_n), "does not fit");
-    return detail::MpzTo< T >()(this->_n);
+    ikos_assert_msg(this->fits< T >(), "does not fit");
+    if (!this->_big) {
+      return static_cast< T >(this->_small);
+    }
+    return detail::MpzTo< T >()(*this->_big);
   }
 
   /// \brief Return a string representation of the ZNumber in the given base
   ///
   /// The base can vary from 2 to 36, or from -2 to -36
-  std::string str(int base = 10) const { return this->_n.get_str(base); }
+  std::string str(int base = 10) const {
+    if (!this->_big && base == 10) {
+      return std::to_string(this->_small);
+    }
+    return this->mpz().get_str(base);
+  }
 
   /// @}
+  /// \name Comparison
+  /// @{
 
-  friend ZNumber mod(const ZNumber&, const ZNumber&);
+  /// \brief Compare with the given number
+  ///
+  /// Return a negative value if `this < x`, zero if `this == x` and a positive
+  /// value if `this > x`.
+  int compare(const ZNumber& x) const {
+    if (!this->_big && !x._big) {
+      return (this->_small > x._small) - (this->_small < x._small);
+    } else if (!this->_big) {
+      // x does not fit in a int64_t
+      return -mpz_sgn(x._big->get_mpz_t());
+    } else if (!x._big) {
+      // this does not fit in a int64_t
+      return mpz_sgn(this->_big->get_mpz_t());
+    } else {
+      return cmp(*this->_big, *x._big);
+    }
+  }
 
-  friend ZNumber gcd(const ZNumber&, const ZNumber&);
+  /// @}
 
-  friend ZNumber lcm(const ZNumber&, const ZNumber&);
+  friend ZNumber mod(const ZNumber&, const ZNumber&);
 
-  friend void gcd_extended(
-      const ZNumber&, const ZNumber&, ZNumber&, ZNumber&, ZNumber&);
+  friend ZNumber abs(const ZNumber&);
 
-  friend std::istream& operator>>(std::istream& i, ZNumber& n);
+  friend ZNumber gcd(const ZNumber&, const ZNumber&);
 
-  friend class QNumber;
+  friend std::size_t hash_value(const ZNumber&);
 
 }; // end class ZNumber
 
@@ -668,67 +932,86 @@ public:
 
 /// \brief Addition
 inline ZNumber operator+(const ZNumber& lhs, const ZNumber& rhs) {
-  return ZNumber(lhs.mpz() + rhs.mpz());
+  ZNumber r(lhs);
+  r += rhs;
+  return r;
 }
 
 /// \brief Addition with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline ZNumber operator+(const ZNumber& lhs, T rhs) {
-  return ZNumber(lhs.mpz() + detail::MpzAdapter< T >()(rhs));
+  ZNumber r(lhs);
+  r += rhs;
+  return r;
 }
 
 /// \brief Addition with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline ZNumber operator+(T lhs, const ZNumber& rhs) {
-  return ZNumber(detail::MpzAdapter< T >()(lhs) + rhs.mpz());
+  ZNumber r(lhs);
+  r += rhs;
+  return r;
 }
 
 /// \brief Subtraction
 inline ZNumber operator-(const ZNumber& lhs, const ZNumber& rhs) {
-  return ZNumber(lhs.mpz() - rhs.mpz());
+  ZNumber r(lhs);
+  r -= rhs;
+  return r;
 }
 
 /// \brief Subtraction with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline ZNumber operator-(const ZNumber& lhs, T rhs) {
-  return ZNumber(lhs.mpz() - detail::MpzAdapter< T >()(rhs));
+  ZNumber r(lhs);
+  r -= rhs;
+  return r;
 }
 
 /// \brief Subtraction with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline ZNumber operator-(T lhs, const ZNumber& rhs) {
-  return ZNumber(detail::MpzAdapter< T >()(lhs) - rhs.mpz());
+  ZNumber r(lhs);
+  r -= rhs;
+  return r;
 }
 
 /// \brief Multiplication
 inline ZNumber operator*(const ZNumber& lhs, const ZNumber& rhs) {
-  return ZNumber(lhs.mpz() * rhs.mpz());
+  ZNumber r(lhs);
+  r *= rhs;
+  return r;
 }
 
 /// \brief Multiplication with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline ZNumber operator*(const ZNumber& lhs, T rhs) {
-  return ZNumber(lhs.mpz() * detail::MpzAdapter< T >()(rhs));
+  ZNumber r(lhs);
+  r *= rhs;
+  return r;
 }
 
 /// \brief Multiplication with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline ZNumber operator*(T lhs, const ZNumber& rhs) {
-  return ZNumber(detail::MpzAdapter< T >()(lhs) * rhs.mpz());
+  ZNumber r(lhs);
+  r *= rhs;
+  return r;
 }
 
 /// \brief Integer division
 ///
 /// Integer division with rounding towards zero.
 inline ZNumber operator/(const ZNumber& lhs, const ZNumber& rhs) {
-  ikos_assert_msg(rhs.mpz() != 0, "division by zero");
-  return ZNumber(lhs.mpz() / rhs.mpz());
+  ZNumber r(lhs);
+  r /= rhs;
+  return r;
 }
 
 /// \brief Integer division with integral types
@@ -737,8 +1020,9 @@ inline ZNumber operator/(const ZNumber& lhs, const ZNumber& rhs) {
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline ZNumber operator/(const ZNumber& lhs, T rhs) {
-  ikos_assert_msg(rhs != 0, "division by zero");
-  return ZNumber(lhs.mpz() / detail::MpzAdapter< T >()(rhs));
+  ZNumber r(lhs);
+  r /= rhs;
+  return r;
 }
 
 /// \brief Integer division with integral types
@@ -747,8 +1031,9 @@ inline ZNumber operator/(const ZNumber& lhs, T rhs) {
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline ZNumber operator/(T lhs, const ZNumber& rhs) {
-  ikos_assert_msg(rhs.mpz() != 0, "division by zero");
-  return ZNumber(detail::MpzAdapter< T >()(lhs) / rhs.mpz());
+  ZNumber r(lhs);
+  r /= rhs;
+  return r;
 }
 
 /// \brief Remainder
@@ -759,8 +1044,9 @@ inline ZNumber operator/(T lhs, const ZNumber& rhs) {
 /// The sign of `rhs` is ignored, and the result will have the same sign as
 /// `lhs`.
 inline ZNumber operator%(const ZNumber& lhs, const ZNumber& rhs) {
-  ikos_assert_msg(rhs.mpz() != 0, "division by zero");
-  return ZNumber(lhs.mpz() % rhs.mpz());
+  ZNumber r(lhs);
+  r %= rhs;
+  return r;
 }
 
 /// \brief Remainder with integral types
@@ -773,8 +1059,9 @@ inline ZNumber operator%(const ZNumber& lhs, const ZNumber& rhs) {
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline ZNumber operator%(const ZNumber& lhs, T rhs) {
-  ikos_assert_msg(rhs != 0, "division by zero");
-  return ZNumber(lhs.mpz() % detail::MpzAdapter< T >()(rhs));
+  ZNumber r(lhs);
+  r %= rhs;
+  return r;
 }
 
 /// \brief Remainder with integral types
@@ -787,74 +1074,93 @@ inline ZNumber operator%(const ZNumber& lhs, T rhs) {
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline ZNumber operator%(T lhs, const ZNumber& rhs) {
-  ikos_assert_msg(rhs.mpz() != 0, "division by zero");
-  return ZNumber(detail::MpzAdapter< T >()(lhs) % rhs.mpz());
+  ZNumber r(lhs);
+  r %= rhs;
+  return r;
 }
 
 /// \brief Bitwise AND
 inline ZNumber operator&(const ZNumber& lhs, const ZNumber& rhs) {
-  return ZNumber(lhs.mpz() & rhs.mpz());
+  ZNumber r(lhs);
+  r &= rhs;
+  return r;
 }
 
 /// \brief Bitwise AND with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline ZNumber operator&(const ZNumber& lhs, T rhs) {
-  return ZNumber(lhs.mpz() & detail::MpzAdapter< T >()(rhs));
+  ZNumber r(lhs);
+  r &= rhs;
+  return r;
 }
 
 /// \brief Bitwise AND with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline ZNumber operator&(T lhs, const ZNumber& rhs) {
-  return ZNumber(detail::MpzAdapter< T >()(lhs) & rhs.mpz());
+  ZNumber r(lhs);
+  r &= rhs;
+  return r;
 }
 
 /// \brief Bitwise OR
 inline ZNumber operator|(const ZNumber& lhs, const ZNumber& rhs) {
-  return ZNumber(lhs.mpz() | rhs.mpz());
+  ZNumber r(lhs);
+  r |= rhs;
+  return r;
 }
 
 /// \brief Bitwise OR with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline ZNumber operator|(const ZNumber& lhs, T rhs) {
-  return ZNumber(lhs.mpz() | detail::MpzAdapter< T >()(rhs));
+  ZNumber r(lhs);
+  r |= rhs;
+  return r;
 }
 
 /// \brief Bitwise OR with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline ZNumber operator|(T lhs, const ZNumber& rhs) {
-  return ZNumber(detail::MpzAdapter< T >()(lhs) | rhs.mpz());
+  ZNumber r(lhs);
+  r |= rhs;
+  return r;
 }
 
 /// \brief Bitwise XOR
 inline ZNumber operator^(const ZNumber& lhs, const ZNumber& rhs) {
-  return ZNumber(lhs.mpz() ^ rhs.mpz());
+  ZNumber r(lhs);
+  r ^= rhs;
+  return r;
 }
 
 /// \brief Bitwise XOR with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline ZNumber operator^(const ZNumber& lhs, T rhs) {
-  return ZNumber(lhs.mpz() ^ detail::MpzAdapter< T >()(rhs));
+  ZNumber r(lhs);
+  r ^= rhs;
+  return r;
 }
 
 /// \brief Bitwise XOR with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline ZNumber operator^(T lhs, const ZNumber& rhs) {
-  return ZNumber(detail::MpzAdapter< T >()(lhs) ^ rhs.mpz());
+  ZNumber r(lhs);
+  r ^= rhs;
+  return r;
 }
 
 /// \brief Left binary shift
 ///
 /// This is undefined if `rhs` isn't between 0 and 2**32 - 1
 inline ZNumber operator<<(const ZNumber& lhs, const ZNumber& rhs) {
-  ikos_assert_msg(rhs.mpz() >= 0, "shift count is negative");
-  ikos_assert_msg(rhs.mpz().fits_ulong_p(), "shift count is too big");
-  return ZNumber(lhs.mpz() << rhs.mpz().get_ui());
+  ZNumber r(lhs);
+  r <<= rhs;
+  return r;
 }
 
 /// \brief Left binary shift with integral types
@@ -863,8 +1169,9 @@ inline ZNumber operator<<(const ZNumber& lhs, const ZNumber& rhs) {
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline ZNumber operator<<(const ZNumber& lhs, T rhs) {
-  ikos_assert_msg(rhs >= 0, "shift count is negative");
-  return ZNumber(lhs.mpz() << static_cast< unsigned long int >(rhs));
+  ZNumber r(lhs);
+  r <<= rhs;
+  return r;
 }
 
 /// \brief Left binary shift with integral types
@@ -882,9 +1189,9 @@ inline ZNumber operator<<(T lhs, const ZNumber& rhs) {
 ///
 /// This is undefined if `rhs` isn't between 0 and 2**32 - 1
 inline ZNumber operator>>(const ZNumber& lhs, const ZNumber& rhs) {
-  ikos_assert_msg(rhs.mpz() >= 0, "shift count is negative");
-  ikos_assert_msg(rhs.mpz().fits_ulong_p(), "shift count is too big");
-  return ZNumber(lhs.mpz() >> rhs.mpz().get_ui());
+  ZNumber r(lhs);
+  r >>= rhs;
+  return r;
 }
 
 /// \brief Right binary shift with integral types
@@ -893,8 +1200,9 @@ inline ZNumber operator>>(const ZNumber& lhs, const ZNumber& rhs) {
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline ZNumber operator>>(const ZNumber& lhs, T rhs) {
-  ikos_assert_msg(rhs >= 0, "shift count is negative");
-  return ZNumber(lhs.mpz() >> static_cast< unsigned long int >(rhs));
+  ZNumber r(lhs);
+  r >>= rhs;
+  return r;
 }
 
 /// \brief Right binary shift with integral types
@@ -914,116 +1222,116 @@ inline ZNumber operator>>(T lhs, const ZNumber& rhs) {
 
 /// \brief Equality operator
 inline bool operator==(const ZNumber& lhs, const ZNumber& rhs) {
-  return lhs.mpz() == rhs.mpz();
+  return lhs.compare(rhs) == 0;
 }
 
 /// \brief Equality operator with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline bool operator==(const ZNumber& lhs, T rhs) {
-  return lhs.mpz() == detail::MpzAdapter< T >()(rhs);
+  return lhs.compare(ZNumber(rhs)) == 0;
 }
 
 /// \brief Equality operator with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline bool operator==(T lhs, const ZNumber& rhs) {
-  return detail::MpzAdapter< T >()(lhs) == rhs.mpz();
+  return ZNumber(lhs).compare(rhs) == 0;
 }
 
 /// \brief Inequality operator
 inline bool operator!=(const ZNumber& lhs, const ZNumber& rhs) {
-  return lhs.mpz() != rhs.mpz();
+  return lhs.compare(rhs) != 0;
 }
 
 /// \brief Inequality operator with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline bool operator!=(const ZNumber& lhs, T rhs) {
-  return lhs.mpz() != detail::MpzAdapter< T >()(rhs);
+  return lhs.compare(ZNumber(rhs)) != 0;
 }
 
 /// \brief Inequality operator with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline bool operator!=(T lhs, const ZNumber& rhs) {
-  return detail::MpzAdapter< T >()(lhs) != rhs.mpz();
+  return ZNumber(lhs).compare(rhs) != 0;
 }
 
 /// \brief Less than comparison
 inline bool operator<(const ZNumber& lhs, const ZNumber& rhs) {
-  return lhs.mpz() < rhs.mpz();
+  return lhs.compare(rhs) < 0;
 }
 
 /// \brief Less than comparison with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline bool operator<(const ZNumber& lhs, T rhs) {
-  return lhs.mpz() < detail::MpzAdapter< T >()(rhs);
+  return lhs.compare(ZNumber(rhs)) < 0;
 }
 
 /// \brief Less than comparison with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline bool operator<(T lhs, const ZNumber& rhs) {
-  return detail::MpzAdapter< T >()(lhs) < rhs.mpz();
+  return ZNumber(lhs).compare(rhs) < 0;
 }
 
 /// \brief Less or equal comparison
 inline bool operator<=(const ZNumber& lhs, const ZNumber& rhs) {
-  return lhs.mpz() <= rhs.mpz();
+  return lhs.compare(rhs) <= 0;
 }
 
 /// \brief Less or equal comparison with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline bool operator<=(const ZNumber& lhs, T rhs) {
-  return lhs.mpz() <= detail::MpzAdapter< T >()(rhs);
+  return lhs.compare(ZNumber(rhs)) <= 0;
 }
 
 /// \brief Less or equal comparison with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline bool operator<=(T lhs, const ZNumber& rhs) {
-  return detail::MpzAdapter< T >()(lhs) <= rhs.mpz();
+  return ZNumber(lhs).compare(rhs) <= 0;
 }
 
 /// \brief Greater than comparison
 inline bool operator>(const ZNumber& lhs, const ZNumber& rhs) {
-  return lhs.mpz() > rhs.mpz();
+  return lhs.compare(rhs) > 0;
 }
 
 /// \brief Greater than comparison with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline bool operator>(const ZNumber& lhs, T rhs) {
-  return lhs.mpz() > detail::MpzAdapter< T >()(rhs);
+  return lhs.compare(ZNumber(rhs)) > 0;
 }
 
 /// \brief Greater than comparison with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline bool operator>(T lhs, const ZNumber& rhs) {
-  return detail::MpzAdapter< T >()(lhs) > rhs.mpz();
+  return ZNumber(lhs).compare(rhs) > 0;
 }
 
 /// \brief Greater or equal comparison
 inline bool operator>=(const ZNumber& lhs, const ZNumber& rhs) {
-  return lhs.mpz() >= rhs.mpz();
+  return lhs.compare(rhs) >= 0;
 }
 
 /// \brief Greater or equal comparison with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline bool operator>=(const ZNumber& lhs, T rhs) {
-  return lhs.mpz() >= detail::MpzAdapter< T >()(rhs);
+  return lhs.compare(ZNumber(rhs)) >= 0;
 }
 
 /// \brief Greater or equal comparison with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline bool operator>=(T lhs, const ZNumber& rhs) {
-  return detail::MpzAdapter< T >()(lhs) >= rhs.mpz();
+  return ZNumber(lhs).compare(rhs) >= 0;
 }
 
 /// @}
@@ -1077,15 +1385,31 @@ inline const ZNumber& max(const ZNumber& a,
 ///
 /// The sign of `d` is ignored, and the result is always non-negative.
 inline ZNumber mod(const ZNumber& n, const ZNumber& d) {
-  ikos_assert_msg(d.mpz() != 0, "division by zero");
-  ZNumber r;
-  mpz_mod(r._n.get_mpz_t(), n._n.get_mpz_t(), d._n.get_mpz_t());
-  return r;
+  ikos_assert_msg(d != 0, "division by zero");
+  if (!n._big && !d._big) {
+    if (d._small == -1) {
+      return ZNumber(0);
+    }
+    std::int64_t r = n._small % d._small;
+    if (r < 0) {
+      // Cannot overflow since abs(r) < abs(d)
+      r = (d._small < 0) ? r - d._small : r + d._small;
+    }
+    return ZNumber(r);
+  }
+  mpz_class r;
+  mpz_class m = n.mpz();
+  mpz_class e = d.mpz();
+  mpz_mod(r.get_mpz_t(), m.get_mpz_t(), e.get_mpz_t());
+  return ZNumber(std::move(r));
 }
 
 /// \brief Return the absolute value of the given number
 inline ZNumber abs(const ZNumber& n) {
-  return ZNumber(abs(n.mpz()));
+  if (!n._big) {
+    return ZNumber(detail::abs_uint64(n._small));
+  }
+  return ZNumber(abs(*n._big));
 }
 
 /// \brief Return the greatest common divisor of the given numbers
@@ -1094,9 +1418,21 @@ inline ZNumber abs(const ZNumber& n) {
 /// negative. Except if both inputs are zero; then this function defines
 /// `gcd(0, 0) = 0`.
 inline ZNumber gcd(const ZNumber& a, const ZNumber& b) {
-  ZNumber r;
-  mpz_gcd(r._n.get_mpz_t(), a._n.get_mpz_t(), b._n.get_mpz_t());
-  return r;
+  if (!a._big && !b._big) {
+    std::uint64_t x = detail::abs_uint64(a._small);
+    std::uint64_t y = detail::abs_uint64(b._small);
+    while (y != 0) {
+      std::uint64_t t = x % y;
+      x = y;
+      y = t;
+    }
+    return ZNumber(x);
+  }
+  mpz_class r;
+  mpz_class x = a.mpz();
+  mpz_class y = b.mpz();
+  mpz_gcd(r.get_mpz_t(), x.get_mpz_t(), y.get_mpz_t());
+  return ZNumber(std::move(r));
 }
 
 /// \brief Return the greatest common divisor of the given numbers
@@ -1106,9 +1442,11 @@ inline ZNumber gcd(const ZNumber& a, const ZNumber& b, const ZNumber& c) {
 
 /// \brief Return the least common multiple of the given numbers
 inline ZNumber lcm(const ZNumber& a, const ZNumber& b) {
-  ZNumber r;
-  mpz_lcm(r._n.get_mpz_t(), a._n.get_mpz_t(), b._n.get_mpz_t());
-  return r;
+  mpz_class r;
+  mpz_class x = a.mpz();
+  mpz_class y = b.mpz();
+  mpz_lcm(r.get_mpz_t(), x.get_mpz_t(), y.get_mpz_t());
+  return ZNumber(std::move(r));
 }
 
 /// \brief Run Euclid's algorithm
@@ -1119,11 +1457,17 @@ inline ZNumber lcm(const ZNumber& a, const ZNumber& b) {
 /// negative (or zero if both inputs are zero).
 inline void gcd_extended(
     const ZNumber& a, const ZNumber& b, ZNumber& g, ZNumber& u, ZNumber& v) {
-  mpz_gcdext(g._n.get_mpz_t(),
-             u._n.get_mpz_t(),
-             v._n.get_mpz_t(),
-             a._n.get_mpz_t(),
-             b._n.get_mpz_t());
+  mpz_class x = a.mpz();
+  mpz_class y = b.mpz();
+  mpz_class rg, ru, rv;
+  mpz_gcdext(rg.get_mpz_t(),
+             ru.get_mpz_t(),
+             rv.get_mpz_t(),
+             x.get_mpz_t(),
+             y.get_mpz_t());
+  g = ZNumber(std::move(rg));
+  u = ZNumber(std::move(ru));
+  v = ZNumber(std::move(rv));
 }
 
 /// @}
@@ -1138,16 +1482,29 @@ inline std::ostream& operator<<(std::ostream& o, const ZNumber& n) {
 
 /// \brief Read a ZNumber from a stream, in base 10
 inline std::istream& operator>>(std::istream& i, ZNumber& n) {
-  i >> n._n;
+  mpz_class m;
+  i >> m;
+  n = ZNumber(std::move(m));
   return i;
 }
 
 /// @}
 
 /// \brief Return the hash of a ZNumber
+///
+/// Small numbers are hashed like a GMP number with a single limb.
 inline std::size_t hash_value(const ZNumber& n) {
-  const mpz_class& m = n.mpz();
   std::size_t result = 0;
+  if (!n._big) {
+    boost::hash_combine(result, n.sign());
+    if (n._small != 0) {
+      boost::hash_combine(result,
+                          static_cast< mp_limb_t >(
+                              detail::abs_uint64(n._small)));
+    }
+    return result;
+  }
+  const mpz_class& m = *n._big;
   boost::hash_combine(result, m.get_mpz_t()[0]._mp_size);
   for (int i = 0, e = std::abs(m.get_mpz_t()[0]._mp_size); i < e; ++i) {
     boost::hash_combine(result, m.get_mpz_t()[0]._mp_d[i]);
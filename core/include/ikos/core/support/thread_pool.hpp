@@ -0,0 +1,199 @@
+/**************************************************************************/ /**
+ *
+ * \file
+ * \brief Pool of persistent worker threads
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2017-2018 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ikos {
+namespace core {
+
+/// \brief Pool of persistent worker threads
+///
+/// A thread is created when a task is submitted and no thread is idle, unless
+/// the pool already holds the maximum number of threads. In that case, the
+/// task waits in a queue until a thread is available. Threads are never
+/// destroyed, they are reused by the next tasks.
+///
+/// Tasks must not throw exceptions.
+class ThreadPool {
+private:
+  /// \brief Mutex protecting the pool
+  std::mutex _mutex;
+
+  /// \brief Condition variable signaled when a task is submitted
+  std::condition_variable _cv;
+
+  /// \brief Tasks waiting for a thread
+  std::deque< std::function< void() > > _tasks;
+
+  /// \brief Worker threads
+  std::vector< std::thread > _threads;
+
+  /// \brief Number of threads waiting for a task
+  std::size_t _idle = 0;
+
+  /// \brief Maximum number of worker threads
+  std::size_t _max_threads =
+      std::max< std::size_t >(std::thread::hardware_concurrency(), 1);
+
+private:
+  ThreadPool() = default;
+
+public:
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool(ThreadPool&&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  ThreadPool& operator=(ThreadPool&&) = delete;
+
+  /// \brief Return the global pool
+  ///
+  /// The pool is never destroyed, since tasks might run during the
+  /// destruction of static objects.
+  static ThreadPool& get() {
+    static auto pool = new ThreadPool();
+    return *pool;
+  }
+
+  /// \brief Set the maximum number of worker threads
+  ///
+  /// Existing threads are kept. By default, the pool holds at most one thread
+  /// per hardware thread.
+  void set_max_threads(std::size_t n) {
+    std::lock_guard< std::mutex > lock(this->_mutex);
+    this->_max_threads = std::max< std::size_t >(n, 1);
+  }
+
+  /// \brief Return the maximum number of worker threads
+  std::size_t max_threads() {
+    std::lock_guard< std::mutex > lock(this->_mutex);
+    return this->_max_threads;
+  }
+
+  /// \brief Run the given task on a worker thread
+  void submit(std::function< void() > task) {
+    std::lock_guard< std::mutex > lock(this->_mutex);
+    this->_tasks.push_back(std::move(task));
+    if (this->_idle < this->_tasks.size() &&
+        this->_threads.size() < this->_max_threads) {
+      this->_threads.emplace_back([this] { this->work(); });
+    } else {
+      this->_cv.notify_one();
+    }
+  }
+
+  /// \brief Run `worker` on the calling thread and on up to `helpers` worker
+  /// threads, and wait for them
+  ///
+  /// Helpers still queued when the calling thread returns from `worker` are
+  /// cancelled, thus the calling thread never waits for a task that did not
+  /// start. `worker` must therefore be able to complete the whole work alone.
+  ///
+  /// `worker` must not throw exceptions.
+  void run(unsigned helpers, const std::function< void() >& worker) {
+    struct Helpers {
+      std::mutex mutex;
+      std::condition_variable cv;
+      bool cancelled = false;
+      unsigned running = 0;
+    };
+    auto state = std::make_shared< Helpers >();
+
+    for (unsigned i = 0; i < helpers; i++) {
+      this->submit([state, &worker] {
+        {
+          std::lock_guard< std::mutex > lock(state->mutex);
+          if (state->cancelled) {
+            return;
+          }
+          state->running++;
+        }
+        worker();
+        std::lock_guard< std::mutex > lock(state->mutex);
+        state->running--;
+        state->cv.notify_all();
+      });
+    }
+
+    worker();
+
+    std::unique_lock< std::mutex > lock(state->mutex);
+    state->cancelled = true;
+    state->cv.wait(lock, [&] { return state->running == 0; });
+  }
+
+  /// \brief Return the number of worker threads
+  std::size_t num_threads() {
+    std::lock_guard< std::mutex > lock(this->_mutex);
+    return this->_threads.size();
+  }
+
+private:
+  /// \brief Main loop of a worker thread
+  void work() {
+    std::unique_lock< std::mutex > lock(this->_mutex);
+    while (true) {
+      if (this->_tasks.empty()) {
+        this->_idle++;
+        this->_cv.wait(lock, [this] { return !this->_tasks.empty(); });
+        this->_idle--;
+      }
+      std::function< void() > task = std::move(this->_tasks.front());
+      this->_tasks.pop_front();
+      lock.unlock();
+      task();
+      lock.lock();
+    }
+  }
+
+}; // end class ThreadPool
+
+} // end namespace core
+} // end namespace ikos
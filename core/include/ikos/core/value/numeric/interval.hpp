@@ -47,6 +47,7 @@
 
 #pragma once
 
+#include <boost/functional/hash.hpp>
 #include <boost/optional.hpp>
 
 #include <ikos/core/domain/abstract_domain.hpp>
@@ -735,6 +736,17 @@ inline Interval< ZNumber > operator^(const Interval< ZNumber >& lhs,
   }
 }
 
+/// \brief Return the hash of an interval
+template < typename Number >
+inline std::size_t hash_value(const Interval< Number >& interval) {
+  std::size_t hash = 0;
+  if (!interval.is_bottom()) {
+    boost::hash_combine(hash, interval.lb());
+    boost::hash_combine(hash, interval.ub());
+  }
+  return hash;
+}
+
 /// \brief Write an interval on a stream
 template < typename Number >
 inline std::ostream& operator<<(std::ostream& o,
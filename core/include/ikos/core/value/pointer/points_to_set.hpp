@@ -45,7 +45,7 @@
 
 #include <boost/optional.hpp>
 
-#include <ikos/core/adt/patricia_tree/set.hpp>
+#include <ikos/core/adt/bitset_set.hpp>
 #include <ikos/core/domain/abstract_domain.hpp>
 #include <ikos/core/semantic/memory_location.hpp>
 
@@ -53,6 +53,11 @@ namespace ikos {
 namespace core {
 
 /// \brief Represents a set of memory locations (i.e, addresses)
+///
+/// The set is a sparse bit-vector indexed by the memory locations, thus memory
+/// locations should have dense indexes. Its content is immutable and shared
+/// between copies, so copying a points-to set is cheap, and a union with a
+/// subset returns the same representation.
 template < typename MemoryLocationRef >
 class PointsToSet final
     : public core::AbstractDomain< PointsToSet< MemoryLocationRef > > {
@@ -65,14 +70,14 @@ private:
   enum Kind { BottomKind, TopKind, SetKind };
 
 private:
-  using PatriciaTreeSetT = PatriciaTreeSet< MemoryLocationRef >;
+  using BitsetSetT = BitsetSet< MemoryLocationRef >;
 
 public:
-  using Iterator = typename PatriciaTreeSetT::Iterator;
+  using Iterator = typename BitsetSetT::Iterator;
 
 private:
   Kind _kind;
-  PatriciaTreeSetT _set;
+  BitsetSetT _set;
 
 private:
   struct TopTag {};
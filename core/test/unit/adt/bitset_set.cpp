@@ -0,0 +1,292 @@
+/*******************************************************************************
+ *
+ * Tests for BitsetSet
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2018 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <set>
+
+#define BOOST_TEST_MODULE test_bitset_set
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <ikos/core/adt/bitset_set.hpp>
+
+using Index = ikos::core::Index;
+using Set = ikos::core::BitsetSet< Index >;
+
+BOOST_AUTO_TEST_CASE(test_insert_erase) {
+  Set s;
+
+  // test insert
+  BOOST_CHECK(s.empty());
+  BOOST_CHECK(s.size() == 0);
+  BOOST_CHECK(!s.contains(1));
+
+  s.insert(1);
+  BOOST_CHECK(!s.empty());
+  BOOST_CHECK(s.size() == 1);
+  BOOST_CHECK(s.contains(1));
+  BOOST_CHECK(!s.contains(2));
+
+  s.insert(1);
+  BOOST_CHECK(s.size() == 1);
+
+  // insert 200, 199, ..., 2
+  for (std::size_t i = 200; i >= 2; i--) {
+    s.insert(i);
+  }
+
+  BOOST_CHECK(s.size() == 200);
+  for (std::size_t i = 1; i <= 200; i++) {
+    BOOST_CHECK(s.contains(i));
+  }
+  BOOST_CHECK(!s.contains(0));
+  BOOST_CHECK(!s.contains(201));
+
+  // test erase
+  s.erase(0);
+  BOOST_CHECK(s.size() == 200);
+
+  s.erase(64);
+  BOOST_CHECK(s.size() == 199);
+  BOOST_CHECK(!s.contains(64));
+  BOOST_CHECK(s.contains(63));
+  BOOST_CHECK(s.contains(65));
+
+  // erase 1, 2, ..., 200
+  for (std::size_t i = 1; i <= 200; i++) {
+    s.erase(i);
+  }
+
+  BOOST_CHECK(s.empty());
+  BOOST_CHECK(s.size() == 0);
+  BOOST_CHECK((s.begin() == s.end()));
+
+  // test clear
+  s.insert(1);
+  s.insert(2);
+  BOOST_CHECK(s.size() == 2);
+
+  s.clear();
+  BOOST_CHECK(s.empty());
+  BOOST_CHECK(s.size() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_iterators) {
+  Set s;
+  BOOST_CHECK((s.begin() == s.end()));
+
+  // Elements are sorted by index
+  Index tab[] = {0, 3, 63, 64, 1000, 1u << 20, static_cast< Index >(-1)};
+  for (auto it = std::rbegin(tab); it != std::rend(tab); ++it) {
+    s.insert(*it);
+  }
+  BOOST_CHECK(std::equal(s.begin(), s.end(), std::begin(tab), std::end(tab)));
+}
+
+BOOST_AUTO_TEST_CASE(test_copy_on_write) {
+  Set s1{1, 2, 3};
+  Set s2 = s1;
+
+  s2.insert(4);
+  BOOST_CHECK(s1.equals(Set({1, 2, 3})));
+  BOOST_CHECK(s2.equals(Set({1, 2, 3, 4})));
+
+  s1.erase(1);
+  BOOST_CHECK(s1.equals(Set({2, 3})));
+  BOOST_CHECK(s2.equals(Set({1, 2, 3, 4})));
+}
+
+BOOST_AUTO_TEST_CASE(test_leq_equals) {
+  Set s1, s2;
+  BOOST_CHECK(s1.is_subset_of(s2));
+  BOOST_CHECK(s1.equals(s2));
+
+  s1.insert(1);
+  s2.insert(1);
+  s2.insert(2);
+  BOOST_CHECK(s1.is_subset_of(s2));
+  BOOST_CHECK(!s2.is_subset_of(s1));
+  BOOST_CHECK(!s1.equals(s2));
+
+  s1.insert(3);
+  BOOST_CHECK(!s1.is_subset_of(s2));
+
+  s1.insert(2);
+  s2.insert(3);
+  BOOST_CHECK(s1.is_subset_of(s2));
+  BOOST_CHECK(s2.is_subset_of(s1));
+  BOOST_CHECK(s1.equals(s2));
+  BOOST_CHECK(s1 == s2);
+
+  s1.insert(100);
+  s2.insert(101);
+  BOOST_CHECK(!s1.is_subset_of(s2));
+  BOOST_CHECK(!s2.is_subset_of(s1));
+  BOOST_CHECK(!s1.equals(s2));
+}
+
+BOOST_AUTO_TEST_CASE(test_join) {
+  Set s1{1, 2};
+  Set s2{1};
+  BOOST_CHECK(s1.join(s2).equals(s1));
+  BOOST_CHECK(s2.join(s1).equals(s1));
+  BOOST_CHECK(s1.join(Set()).equals(s1));
+  BOOST_CHECK(Set().join(s1).equals(s1));
+
+  s1 = Set{2, 70, 1000};
+  s2 = Set{1, 70, 500};
+  Set s3 = s1.join(s2);
+  BOOST_CHECK(s3.equals(Set({1, 2, 70, 500, 1000})));
+  BOOST_CHECK(s3.size() == 5);
+  Index tab[] = {1, 2, 70, 500, 1000};
+  BOOST_CHECK(std::equal(s3.begin(), s3.end(), std::begin(tab), std::end(tab)));
+
+  s1.join_with(s2);
+  BOOST_CHECK(s1.equals(s3));
+}
+
+BOOST_AUTO_TEST_CASE(test_intersect) {
+  Set s1{1, 2};
+  Set s2{1};
+  BOOST_CHECK(s1.intersect(s2).equals(Set({1})));
+  BOOST_CHECK(s1.intersect(Set()).empty());
+  BOOST_CHECK(s1.intersect(Set({3, 200})).empty());
+
+  s1 = Set{2, 70, 1000, 1001};
+  s2 = Set{1, 70, 500, 1001};
+  BOOST_CHECK(s1.intersect(s2).equals(Set({70, 1001})));
+  BOOST_CHECK(s1.intersect(s2).size() == 2);
+
+  s1.intersect_with(s2);
+  BOOST_CHECK(s1.equals(Set({70, 1001})));
+}
+
+BOOST_AUTO_TEST_CASE(test_difference) {
+  Set s1{1, 2};
+  Set s2{1};
+  BOOST_CHECK(s1.difference(s2).equals(Set({2})));
+  BOOST_CHECK(s1.difference(Set()).equals(s1));
+  BOOST_CHECK(s1.difference(s1).empty());
+  BOOST_CHECK(Set().difference(s1).empty());
+
+  s1 = Set{2, 70, 1000, 1001};
+  s2 = Set{1, 70, 500, 1001};
+  BOOST_CHECK(s1.difference(s2).equals(Set({2, 1000})));
+  BOOST_CHECK(s1.difference(s2).size() == 2);
+
+  s1.difference_with(s2);
+  BOOST_CHECK(s1.equals(Set({2, 1000})));
+}
+
+BOOST_AUTO_TEST_CASE(test_filter) {
+  Set s;
+  for (Index i = 0; i < 200; i++) {
+    s.insert(i);
+  }
+  s.filter([](Index i) { return i % 3 == 0; });
+  BOOST_CHECK(s.size() == 67);
+  for (Index i = 0; i < 200; i++) {
+    BOOST_CHECK(s.contains(i) == (i % 3 == 0));
+  }
+
+  s.filter([](Index) { return false; });
+  BOOST_CHECK(s.empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_random) {
+  // Compare against std::set on random operations
+  std::uint64_t state = 42;
+  auto rand = [&state](Index bound) {
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return static_cast< Index >(state >> 33) % bound;
+  };
+  auto check = [](const Set& s, const std::set< Index >& t) {
+    return s.size() == t.size() &&
+           std::equal(s.begin(), s.end(), t.begin(), t.end());
+  };
+
+  for (int k = 0; k < 100; k++) {
+    Set s1, s2;
+    std::set< Index > t1, t2;
+    for (int i = 0; i < 50; i++) {
+      Index x = rand(300), y = rand(300);
+      s1.insert(x);
+      t1.insert(x);
+      s2.insert(y);
+      t2.insert(y);
+      if (i % 4 == 0) {
+        s1.erase(y);
+        t1.erase(y);
+      }
+    }
+    BOOST_CHECK(check(s1, t1));
+    BOOST_CHECK(check(s2, t2));
+
+    std::set< Index > r;
+    std::set_union(t1.begin(),
+                   t1.end(),
+                   t2.begin(),
+                   t2.end(),
+                   std::inserter(r, r.end()));
+    BOOST_CHECK(check(s1.join(s2), r));
+
+    r.clear();
+    std::set_intersection(t1.begin(),
+                          t1.end(),
+                          t2.begin(),
+                          t2.end(),
+                          std::inserter(r, r.end()));
+    BOOST_CHECK(check(s1.intersect(s2), r));
+
+    r.clear();
+    std::set_difference(t1.begin(),
+                        t1.end(),
+                        t2.begin(),
+                        t2.end(),
+                        std::inserter(r, r.end()));
+    BOOST_CHECK(check(s1.difference(s2), r));
+    BOOST_CHECK(s1.difference(s2).is_subset_of(s1));
+    BOOST_CHECK(s1.join(s2).equals(s2.join(s1)));
+  }
+}
@@ -0,0 +1,180 @@
+/*******************************************************************************
+ *
+ * Benchmark of BitsetSet against PatriciaTreeSet on a liveness analysis
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2018 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <cstdint>
+#include <vector>
+
+#define BOOST_TEST_MODULE test_bitset_set_benchmark
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <ikos/core/adt/bitset_set.hpp>
+#include <ikos/core/adt/patricia_tree/set.hpp>
+
+#include "benchmark_timer.hpp"
+
+// Run with `--log_level=message` to display the timings.
+
+namespace {
+
+using Index = ikos::core::Index;
+
+/// \brief Number of variables in the function
+constexpr std::size_t NumVariables = 5000;
+
+/// \brief Number of basic blocks in the function
+constexpr std::size_t NumBlocks = 2000;
+
+/// \brief Number of statements per basic block
+constexpr std::size_t NumStatements = 8;
+
+/// \brief Number of operands per statement
+constexpr std::size_t NumOperands = 2;
+
+/// \brief Simple linear congruential generator, for reproducible results
+class Random {
+private:
+  std::uint64_t _state = 42;
+
+public:
+  std::size_t operator()(std::size_t bound) {
+    _state = _state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return static_cast< std::size_t >(_state >> 33) % bound;
+  }
+};
+
+/// \brief A basic block: a list of (result, operands) statements
+struct BasicBlock {
+  std::vector< std::vector< Index > > statements;
+  std::vector< std::size_t > successors;
+};
+
+/// \brief Build a function with loops
+///
+/// Variables are mostly used close to their definition, as in real code.
+std::vector< BasicBlock > make_function() {
+  Random rand;
+  std::vector< BasicBlock > blocks(NumBlocks);
+  for (std::size_t b = 0; b < NumBlocks; ++b) {
+    std::size_t base = b * NumVariables / NumBlocks;
+    for (std::size_t s = 0; s < NumStatements; ++s) {
+      std::vector< Index > stmt;
+      for (std::size_t o = 0; o <= NumOperands; ++o) {
+        std::size_t near = base + rand(64);
+        stmt.push_back(rand(8) == 0 ? rand(NumVariables)
+                                    : near % NumVariables);
+      }
+      blocks[b].statements.push_back(stmt);
+    }
+    if (b + 1 < NumBlocks) {
+      blocks[b].successors.push_back(b + 1);
+    }
+    if (b % 10 == 9) {
+      blocks[b].successors.push_back(b - 1 - rand(b < 50 ? b : 50));
+    }
+  }
+  return blocks;
+}
+
+/// \brief Run a backward liveness analysis, return the time in ms
+template < typename Set >
+double liveness(const std::vector< BasicBlock >& blocks, std::size_t& acc) {
+  BenchmarkTimer timer;
+
+  // Compute kill/gen sets
+  std::vector< Set > kill(blocks.size()), gen(blocks.size());
+  for (std::size_t b = 0; b < blocks.size(); ++b) {
+    for (auto it = blocks[b].statements.rbegin(),
+              et = blocks[b].statements.rend();
+         it != et;
+         ++it) {
+      kill[b].insert(it->front());
+      gen[b].erase(it->front());
+      for (auto op = it->begin() + 1; op != it->end(); ++op) {
+        gen[b].insert(*op);
+      }
+    }
+  }
+
+  // Round-robin iteration, in reverse order
+  std::vector< Set > live_in(blocks.size());
+  bool change = true;
+  while (change) {
+    change = false;
+    for (std::size_t b = blocks.size(); b-- > 0;) {
+      Set out;
+      for (std::size_t succ : blocks[b].successors) {
+        out.join_with(live_in[succ]);
+      }
+      out.difference_with(kill[b]);
+      out.join_with(gen[b]);
+      if (!out.is_subset_of(live_in[b])) {
+        live_in[b].join_with(out);
+        change = true;
+      }
+    }
+  }
+  double time = timer.elapsed_ms();
+
+  for (const Set& s : live_in) {
+    acc += s.size();
+  }
+  return time;
+}
+
+} // end anonymous namespace
+
+BOOST_AUTO_TEST_CASE(benchmark_liveness) {
+  std::vector< BasicBlock > blocks = make_function();
+
+  std::size_t acc_patricia = 0;
+  double patricia =
+      liveness< ikos::core::PatriciaTreeSet< Index > >(blocks, acc_patricia);
+
+  std::size_t acc_bitset = 0;
+  double bitset = liveness< ikos::core::BitsetSet< Index > >(blocks, acc_bitset);
+
+  BOOST_CHECK(acc_patricia > 0);
+  BOOST_CHECK(acc_patricia == acc_bitset);
+  BOOST_TEST_MESSAGE("liveness with PatriciaTreeSet: " << patricia << "ms");
+  BOOST_TEST_MESSAGE("liveness with BitsetSet: " << bitset << "ms");
+}
@@ -46,6 +46,8 @@
 #include <boost/test/output_test_stream.hpp>
 #include <boost/test/unit_test.hpp>
 
+#include <thread>
+
 #include <ikos/core/adt/patricia_tree/map.hpp>
 
 BOOST_AUTO_TEST_CASE(test_patricia_tree_map) {
@@ -268,3 +270,24 @@ BOOST_AUTO_TEST_CASE(test_patricia_tree_map) {
   const std::pair< Index, std::string > tab4[] = {{1, "hellozzzzz"}};
   BOOST_CHECK(std::equal(m.begin(), m.end(), std::begin(tab4), std::end(tab4)));
 }
+
+BOOST_AUTO_TEST_CASE(test_patricia_tree_map_thread_exit) {
+  using Index = ikos::core::Index;
+  using Map = ikos::core::PatriciaTreeMap< Index, std::string >;
+  using ikos::core::patricia_tree_utils::NodeAllocator;
+
+  auto fill = [] {
+    Map m;
+    for (Index i = 0; i < 1000; i++) {
+      m.insert_or_assign(i, "a");
+    }
+  };
+
+  // Memory of exited threads is reused by the next threads
+  std::thread(fill).join();
+  std::size_t chunks = NodeAllocator::num_chunks();
+  for (int t = 0; t < 32; t++) {
+    std::thread(fill).join();
+  }
+  BOOST_CHECK(NodeAllocator::num_chunks() == chunks);
+}
@@ -0,0 +1,215 @@
+/*******************************************************************************
+ *
+ * Tests for PatriciaTreeMap with hash-consing
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2018 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#define IKOS_PATRICIA_TREE_HASH_CONSING
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#define BOOST_TEST_MODULE test_patricia_tree_map_hash_consing
+#define BOOST_TEST_DYN_LINK
+#include <boost/optional.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <ikos/core/adt/patricia_tree/map.hpp>
+
+using Index = ikos::core::Index;
+using Map = ikos::core::PatriciaTreeMap< Index, int >;
+using HashConsingTraits =
+    ikos::core::patricia_tree_map_impl::HashConsingTraits< Index, int >;
+
+namespace {
+
+std::size_t table_size() {
+  return HashConsingTraits::table().size();
+}
+
+bool map_leq(const Map& m1, const Map& m2) {
+  return m1.leq(m2, [](int x, int y) { return x <= y; });
+}
+
+bool map_equals(const Map& m1, const Map& m2) {
+  return m1.equals(m2, [](int x, int y) { return x == y; });
+}
+
+Map map_join(const Map& m1, const Map& m2) {
+  return m1.join(m2, [](int x, int y) {
+    return boost::optional< int >(std::max(x, y));
+  });
+}
+
+Map map_intersect(const Map& m1, const Map& m2) {
+  return m1.intersect(m2, [](int x, int y) {
+    return boost::optional< int >(std::max(x, y));
+  });
+}
+
+} // end anonymous namespace
+
+BOOST_AUTO_TEST_CASE(test_sharing) {
+  BOOST_CHECK(table_size() == 0);
+
+  {
+    Map m1;
+    Map m2;
+    for (Index i = 0; i < 100; i++) {
+      m1.insert_or_assign(i, static_cast< int >(i));
+    }
+    for (Index i = 100; i-- > 0;) {
+      m2.insert_or_assign(i, static_cast< int >(i));
+    }
+
+    // 100 leaves and 99 nodes, shared by m1 and m2
+    BOOST_CHECK(table_size() == 199);
+  }
+
+  // Nodes are removed from the table when they are destroyed
+  BOOST_CHECK(table_size() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_equals) {
+  Map m1;
+  Map m2;
+  for (Index i = 0; i < 100; i++) {
+    m1.insert_or_assign(i, static_cast< int >(i));
+  }
+  for (Index i = 100; i-- > 0;) {
+    m2.insert_or_assign(i, static_cast< int >(i));
+  }
+
+  BOOST_CHECK(map_equals(m1, m2));
+  BOOST_CHECK(map_leq(m1, m2));
+  BOOST_CHECK(map_leq(m2, m1));
+
+  m2.insert_or_assign(42, 43);
+  BOOST_CHECK(!map_equals(m1, m2));
+  BOOST_CHECK(map_leq(m1, m2));
+  BOOST_CHECK(!map_leq(m2, m1));
+
+  m2.insert_or_assign(42, 42);
+  BOOST_CHECK(map_equals(m1, m2));
+
+  m2.erase(42);
+  BOOST_CHECK(!map_equals(m1, m2));
+  BOOST_CHECK(m2.size() == 99);
+  BOOST_CHECK(!m2.at(42));
+
+  m2.insert_or_assign(42, 42);
+  BOOST_CHECK(map_equals(m1, m2));
+
+  // Distinct trees that are equal according to the comparison
+  m2.insert_or_assign(42, 142);
+  BOOST_CHECK(!map_equals(m1, m2));
+  BOOST_CHECK(m1.equals(m2, [](int x, int y) { return x % 100 == y % 100; }));
+}
+
+BOOST_AUTO_TEST_CASE(test_memoization) {
+  Map m1;
+  Map m2;
+  for (Index i = 0; i < 64; i++) {
+    m1.insert_or_assign(i, static_cast< int >(i % 7));
+    m2.insert_or_assign(i + 32, static_cast< int >(i % 5));
+  }
+
+  // Run the operations twice, the second time uses the memoization cache
+  for (int k = 0; k < 2; k++) {
+    Map j = map_join(m1, m2);
+    BOOST_CHECK(j.size() == 96);
+    for (Index i = 0; i < 96; i++) {
+      int expected = -1;
+      if (i < 64) {
+        expected = std::max(expected, static_cast< int >(i % 7));
+      }
+      if (i >= 32) {
+        expected = std::max(expected, static_cast< int >((i - 32) % 5));
+      }
+      auto x = j.at(i);
+      BOOST_CHECK(x && *x == expected);
+    }
+
+    Map m = map_intersect(m1, m2);
+    BOOST_CHECK(m.size() == 32);
+    for (Index i = 32; i < 64; i++) {
+      auto x = m.at(i);
+      BOOST_CHECK(x && *x == static_cast< int >(std::max(i % 7, (i - 32) % 5)));
+    }
+
+    // Missing keys are considered greater than any value
+    BOOST_CHECK(!map_leq(m1, m2));
+    BOOST_CHECK(!map_leq(m1, j));
+    BOOST_CHECK(map_leq(m1, m));
+    BOOST_CHECK(map_leq(m2, m));
+    BOOST_CHECK(map_leq(j, m));
+    BOOST_CHECK(!map_leq(m, m1));
+    BOOST_CHECK(map_equals(map_join(j, m1), j));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_threads) {
+  // Memoization caches might hold nodes from previous tests
+  std::size_t size = table_size();
+
+  std::vector< Map > maps(4);
+  std::vector< std::thread > threads;
+  for (std::size_t t = 0; t < maps.size(); t++) {
+    threads.emplace_back([&maps, t] {
+      for (int k = 0; k < 100; k++) {
+        Map m;
+        for (Index i = 0; i < 200; i++) {
+          m.insert_or_assign((i * 7 + t) % 200, static_cast< int >(1000 + k));
+        }
+        maps[t] = m;
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (std::size_t t = 1; t < maps.size(); t++) {
+    BOOST_CHECK(map_equals(maps[0], maps[t]));
+  }
+  BOOST_CHECK(table_size() == size + 399);
+  maps.clear();
+  BOOST_CHECK(table_size() == size);
+}
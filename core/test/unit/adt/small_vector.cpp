@@ -0,0 +1,202 @@
+/*******************************************************************************
+ *
+ * Tests for SmallVector
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2018 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <iterator>
+#include <list>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#define BOOST_TEST_MODULE test_small_vector
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <ikos/core/adt/small_vector.hpp>
+
+using IntVector = ikos::core::SmallVector< int, 4 >;
+using StringVector = ikos::core::SmallVector< std::string, 2 >;
+
+BOOST_AUTO_TEST_CASE(test_inline_storage) {
+  IntVector v;
+  BOOST_CHECK(v.empty());
+  BOOST_CHECK(v.is_small());
+  BOOST_CHECK(v.capacity() == 4);
+
+  v.push_back(1);
+  v.push_back(2);
+  v.push_back(3);
+  v.push_back(4);
+  BOOST_CHECK(v.is_small());
+  BOOST_CHECK(v.size() == 4);
+
+  v.push_back(5);
+  BOOST_CHECK(!v.is_small());
+  BOOST_CHECK(v.size() == 5);
+  BOOST_CHECK(v.capacity() >= 5);
+  BOOST_CHECK((v == IntVector{1, 2, 3, 4, 5}));
+
+  v.resize(2);
+  v.shrink_to_fit();
+  BOOST_CHECK(v.is_small());
+  BOOST_CHECK((v == IntVector{1, 2}));
+
+  v.clear();
+  BOOST_CHECK(v.empty());
+  BOOST_CHECK(v.is_small());
+}
+
+BOOST_AUTO_TEST_CASE(test_constructors) {
+  IntVector a(3);
+  BOOST_CHECK((a == IntVector{0, 0, 0}));
+
+  IntVector b(6, 7);
+  BOOST_CHECK(b.size() == 6);
+  BOOST_CHECK(!b.is_small());
+  for (int x : b) {
+    BOOST_CHECK(x == 7);
+  }
+
+  std::list< int > l = {3, 1, 2};
+  IntVector c(l.begin(), l.end());
+  BOOST_CHECK((c == IntVector{3, 1, 2}));
+
+  std::istringstream stream("1 2 3 4 5 6");
+  IntVector d(std::istream_iterator< int >(stream),
+              (std::istream_iterator< int >()));
+  BOOST_CHECK((d == IntVector{1, 2, 3, 4, 5, 6}));
+}
+
+BOOST_AUTO_TEST_CASE(test_insert_erase) {
+  IntVector v = {1, 2, 3};
+
+  auto it = v.insert(v.begin(), 0);
+  BOOST_CHECK(*it == 0);
+  BOOST_CHECK((v == IntVector{0, 1, 2, 3}));
+
+  it = v.insert(v.begin() + 2, 2, 9);
+  BOOST_CHECK(*it == 9);
+  BOOST_CHECK((v == IntVector{0, 1, 9, 9, 2, 3}));
+
+  std::vector< int > w = {7, 8};
+  it = v.insert(v.end(), w.begin(), w.end());
+  BOOST_CHECK(*it == 7);
+  BOOST_CHECK((v == IntVector{0, 1, 9, 9, 2, 3, 7, 8}));
+
+  it = v.erase(v.begin() + 2, v.begin() + 4);
+  BOOST_CHECK(*it == 2);
+  BOOST_CHECK((v == IntVector{0, 1, 2, 3, 7, 8}));
+
+  it = v.erase(v.begin());
+  BOOST_CHECK(*it == 1);
+  BOOST_CHECK((v == IntVector{1, 2, 3, 7, 8}));
+
+  it = v.emplace(v.begin() + 3, 5);
+  BOOST_CHECK(*it == 5);
+  BOOST_CHECK((v == IntVector{1, 2, 3, 5, 7, 8}));
+
+  v.pop_back();
+  BOOST_CHECK(v.back() == 7);
+  BOOST_CHECK(v.front() == 1);
+  BOOST_CHECK_THROW(v.at(5), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(test_aliasing) {
+  // Insert elements of the vector itself, while it reallocates
+  IntVector v = {1, 2, 3, 4};
+  v.push_back(v[0]);
+  BOOST_CHECK((v == IntVector{1, 2, 3, 4, 1}));
+
+  IntVector w = {1, 2, 3, 4};
+  w.insert(w.begin(), w.begin(), w.end());
+  BOOST_CHECK((w == IntVector{1, 2, 3, 4, 1, 2, 3, 4}));
+
+  StringVector s = {"a", "b"};
+  s.emplace_back(s[0]);
+  s.insert(s.begin(), s[2]);
+  BOOST_CHECK((s == StringVector{"a", "a", "b", "a"}));
+}
+
+BOOST_AUTO_TEST_CASE(test_copy_move_swap) {
+  StringVector small = {"a"};
+  StringVector large = {"a", "b", "c"};
+
+  StringVector copy_small(small);
+  StringVector copy_large(large);
+  BOOST_CHECK(copy_small == small);
+  BOOST_CHECK(copy_large == large);
+
+  StringVector moved_small(std::move(copy_small));
+  StringVector moved_large(std::move(copy_large));
+  BOOST_CHECK(moved_small == small);
+  BOOST_CHECK(moved_large == large);
+  BOOST_CHECK(moved_small.is_small());
+  BOOST_CHECK(!moved_large.is_small());
+  BOOST_CHECK(copy_large.empty());
+
+  moved_small = large;
+  moved_large = small;
+  BOOST_CHECK(moved_small == large);
+  BOOST_CHECK(moved_large == small);
+
+  moved_small = std::move(moved_large);
+  BOOST_CHECK(moved_small == small);
+
+  StringVector x = {"x"};
+  StringVector y = {"y", "y", "y"};
+  swap(x, y);
+  BOOST_CHECK((x == StringVector{"y", "y", "y"}));
+  BOOST_CHECK((y == StringVector{"x"}));
+  x.swap(y);
+  BOOST_CHECK((x == StringVector{"x"}));
+  BOOST_CHECK((y == StringVector{"y", "y", "y"}));
+}
+
+BOOST_AUTO_TEST_CASE(test_compare) {
+  BOOST_CHECK((IntVector{1, 2} == IntVector{1, 2}));
+  BOOST_CHECK((IntVector{1, 2} != IntVector{1, 2, 3}));
+  BOOST_CHECK((IntVector{1, 2} < IntVector{1, 2, 3}));
+  BOOST_CHECK((IntVector{1, 3} > IntVector{1, 2, 3}));
+  BOOST_CHECK((IntVector{1, 2} <= IntVector{1, 2}));
+  BOOST_CHECK((IntVector{} >= IntVector{}));
+}
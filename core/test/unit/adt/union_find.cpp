@@ -0,0 +1,96 @@
+/*******************************************************************************
+ *
+ * Tests for UnionFind
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2018 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#define BOOST_TEST_MODULE test_union_find
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <ikos/core/adt/union_find.hpp>
+
+using Index = ikos::core::Index;
+using UnionFind = ikos::core::UnionFind< Index >;
+
+BOOST_AUTO_TEST_CASE(test_merge) {
+  UnionFind uf;
+  for (Index i = 0; i < 6; i++) {
+    uf.add(i);
+  }
+
+  BOOST_CHECK(uf.merge(4, 2));
+  BOOST_CHECK(uf.merge(5, 4));
+  BOOST_CHECK(uf.merge(3, 1));
+  BOOST_CHECK(uf.find(5) == 2);
+  BOOST_CHECK(uf.find(3) == 1);
+  BOOST_CHECK(uf.size(4) == 3);
+  BOOST_CHECK(uf.size(0) == 1);
+
+  BOOST_CHECK(uf.merge(5, 3));
+  BOOST_CHECK(uf.find(2) == 1);
+  BOOST_CHECK(uf.find(4) == 1);
+  BOOST_CHECK(uf.size(2) == 5);
+}
+
+BOOST_AUTO_TEST_CASE(test_chained_computation) {
+  // Packs of `x[i+1] = x[i] + a[i]` for i in [0, 100), where x[i] has index i
+  // and a[i] has index 1000 + i
+  const std::size_t max_size = 8;
+  UnionFind uf(max_size);
+  for (Index i = 0; i <= 100; i++) {
+    uf.add(i);
+    uf.add(1000 + i);
+  }
+  for (Index i = 0; i < 100; i++) {
+    uf.merge(i + 1, i);
+    uf.merge(i + 1, 1000 + i);
+  }
+
+  std::size_t num_elements = 0;
+  for (const auto& p : uf) {
+    BOOST_CHECK(uf.size(p.first) <= max_size);
+    num_elements++;
+  }
+  BOOST_CHECK(num_elements == 202);
+
+  // Neighbours in the chain are still packed
+  BOOST_CHECK(uf.find(1) == uf.find(0));
+  BOOST_CHECK(uf.size(0) == max_size);
+}
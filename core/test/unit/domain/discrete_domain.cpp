@@ -46,14 +46,20 @@
 #include <boost/test/output_test_stream.hpp>
 #include <boost/test/unit_test.hpp>
 
+#include <ikos/core/adt/bitset_set.hpp>
 #include <ikos/core/domain/discrete_domain.hpp>
 #include <ikos/core/example/variable_factory.hpp>
 
 using VariableFactory = ikos::core::example::VariableFactory;
 using Variable = ikos::core::example::VariableFactory::VariableRef;
-using DiscreteDomain = ikos::core::DiscreteDomain< Variable >;
-
-BOOST_AUTO_TEST_CASE(is_top_and_bottom) {
+using DiscreteDomains = boost::mpl::list<
+    ikos::core::DiscreteDomain< Variable >,
+    ikos::core::DiscreteDomain< Variable,
+                                ikos::core::BitsetSet< Variable > > >;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(is_top_and_bottom,
+                              DiscreteDomain,
+                              DiscreteDomains) {
   VariableFactory vfac;
   Variable x(vfac.get("x"));
 
@@ -76,7 +82,7 @@ BOOST_AUTO_TEST_CASE(is_top_and_bottom) {
   BOOST_CHECK(!inv.is_bottom());
 }
 
-BOOST_AUTO_TEST_CASE(iterators) {
+BOOST_AUTO_TEST_CASE_TEMPLATE(iterators, DiscreteDomain, DiscreteDomains) {
   VariableFactory vfac;
   Variable x(vfac.get("x"));
   Variable y(vfac.get("y"));
@@ -92,16 +98,21 @@ BOOST_AUTO_TEST_CASE(iterators) {
                          std::end(tab),
                          [](Variable a, Variable b) { return a == b; }));
 
+  // The iteration order depends on the underlying set
   inv.add(y);
   Variable tab2[] = {{y}, {x}};
-  BOOST_CHECK(std::equal(inv.begin(),
-                         inv.end(),
-                         std::begin(tab2),
-                         std::end(tab2),
-                         [](Variable a, Variable b) { return a == b; }));
+  BOOST_CHECK(std::distance(inv.begin(), inv.end()) == 2);
+  BOOST_CHECK(std::is_permutation(inv.begin(),
+                                  inv.end(),
+                                  std::begin(tab2),
+                                  [](Variable a, Variable b) {
+                                    return a == b;
+                                  }));
 }
 
-BOOST_AUTO_TEST_CASE(set_to_top_and_bottom) {
+BOOST_AUTO_TEST_CASE_TEMPLATE(set_to_top_and_bottom,
+                              DiscreteDomain,
+                              DiscreteDomains) {
   VariableFactory vfac;
   Variable x(vfac.get("x"));
   Variable y(vfac.get("y"));
@@ -119,7 +130,7 @@ BOOST_AUTO_TEST_CASE(set_to_top_and_bottom) {
   BOOST_CHECK(!inv.is_bottom());
 }
 
-BOOST_AUTO_TEST_CASE(leq) {
+BOOST_AUTO_TEST_CASE_TEMPLATE(leq, DiscreteDomain, DiscreteDomains) {
   VariableFactory vfac;
   Variable x(vfac.get("x"));
   Variable y(vfac.get("y"));
@@ -150,7 +161,7 @@ BOOST_AUTO_TEST_CASE(leq) {
   BOOST_CHECK(!inv2.leq(inv3));
 }
 
-BOOST_AUTO_TEST_CASE(equals) {
+BOOST_AUTO_TEST_CASE_TEMPLATE(equals, DiscreteDomain, DiscreteDomains) {
   VariableFactory vfac;
   Variable x(vfac.get("x"));
   Variable y(vfac.get("y"));
@@ -180,7 +191,7 @@ BOOST_AUTO_TEST_CASE(equals) {
   BOOST_CHECK(!inv1.equals(inv3));
 }
 
-BOOST_AUTO_TEST_CASE(join) {
+BOOST_AUTO_TEST_CASE_TEMPLATE(join, DiscreteDomain, DiscreteDomains) {
   VariableFactory vfac;
   Variable x(vfac.get("x"));
   Variable y(vfac.get("y"));
@@ -213,7 +224,7 @@ BOOST_AUTO_TEST_CASE(join) {
   BOOST_CHECK((inv3.join(inv4) == DiscreteDomain{x, y, z}));
 }
 
-BOOST_AUTO_TEST_CASE(meet) {
+BOOST_AUTO_TEST_CASE_TEMPLATE(meet, DiscreteDomain, DiscreteDomains) {
   VariableFactory vfac;
   Variable x(vfac.get("x"));
   Variable y(vfac.get("y"));
@@ -253,7 +264,7 @@ BOOST_AUTO_TEST_CASE(meet) {
   BOOST_CHECK((inv4.meet(inv3) == inv2));
 }
 
-BOOST_AUTO_TEST_CASE(difference) {
+BOOST_AUTO_TEST_CASE_TEMPLATE(difference, DiscreteDomain, DiscreteDomains) {
   VariableFactory vfac;
   Variable x(vfac.get("x"));
   Variable y(vfac.get("y"));
@@ -294,7 +305,7 @@ BOOST_AUTO_TEST_CASE(difference) {
   BOOST_CHECK((inv4.difference(inv3) == DiscreteDomain{z}));
 }
 
-BOOST_AUTO_TEST_CASE(add) {
+BOOST_AUTO_TEST_CASE_TEMPLATE(add, DiscreteDomain, DiscreteDomains) {
   VariableFactory vfac;
   Variable x(vfac.get("x"));
   Variable y(vfac.get("y"));
@@ -313,7 +324,7 @@ BOOST_AUTO_TEST_CASE(add) {
   BOOST_CHECK((inv == DiscreteDomain{x, y}));
 }
 
-BOOST_AUTO_TEST_CASE(remove_) {
+BOOST_AUTO_TEST_CASE_TEMPLATE(remove_, DiscreteDomain, DiscreteDomains) {
   VariableFactory vfac;
   Variable x(vfac.get("x"));
   Variable y(vfac.get("y"));
@@ -0,0 +1,183 @@
+/*******************************************************************************
+ *
+ * Tests for ExceptionDomain
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2018 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#define BOOST_TEST_MODULE test_exception_domain
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <ikos/core/domain/exception/exception.hpp>
+#include <ikos/core/domain/numeric/interval.hpp>
+#include <ikos/core/example/variable_factory.hpp>
+#include <ikos/core/number/z_number.hpp>
+
+using ZNumber = ikos::core::ZNumber;
+using VariableFactory = ikos::core::example::VariableFactory;
+using Variable = ikos::core::example::VariableFactory::VariableRef;
+using Interval = ikos::core::numeric::ZInterval;
+using IntervalDomain = ikos::core::numeric::IntervalDomain< ZNumber, Variable >;
+using ExceptionDomain =
+    ikos::core::exception::ExceptionDomain< IntervalDomain >;
+
+BOOST_AUTO_TEST_CASE(is_top_and_bottom) {
+  BOOST_CHECK(ExceptionDomain::top().is_top());
+  BOOST_CHECK(!ExceptionDomain::top().is_bottom());
+
+  BOOST_CHECK(!ExceptionDomain::bottom().is_top());
+  BOOST_CHECK(ExceptionDomain::bottom().is_bottom());
+
+  ExceptionDomain inv = ExceptionDomain::top_no_exceptions();
+  BOOST_CHECK(!inv.is_top());
+  BOOST_CHECK(!inv.is_bottom());
+  BOOST_CHECK(inv.is_normal_flow_top());
+  BOOST_CHECK(inv.is_caught_exceptions_bottom());
+  BOOST_CHECK(inv.is_propagated_exceptions_bottom());
+
+  inv.set_to_top();
+  BOOST_CHECK(inv.is_top());
+  inv.set_to_bottom();
+  BOOST_CHECK(inv.is_bottom());
+
+  inv = ExceptionDomain(IntervalDomain::top(),
+                        IntervalDomain::bottom(),
+                        IntervalDomain::top());
+  BOOST_CHECK(inv.is_caught_exceptions_bottom());
+  BOOST_CHECK(inv.is_propagated_exceptions_top());
+}
+
+BOOST_AUTO_TEST_CASE(leq_and_equals) {
+  VariableFactory vfac;
+  Variable x(vfac.get("x"));
+
+  ExceptionDomain inv1 = ExceptionDomain::top_no_exceptions();
+  ExceptionDomain inv2 = ExceptionDomain::top_no_exceptions();
+  BOOST_CHECK(inv1.leq(inv2));
+  BOOST_CHECK(inv1.equals(inv2));
+
+  inv2.throw_exception();
+  BOOST_CHECK(!inv1.leq(inv2));
+  BOOST_CHECK(!inv2.leq(inv1));
+  BOOST_CHECK(!inv1.equals(inv2));
+
+  // A materialized bottom state is equal to a lazy bottom state
+  inv2 = ExceptionDomain::top_no_exceptions();
+  BOOST_CHECK(inv2.caught_exceptions().is_bottom());
+  BOOST_CHECK(inv1.equals(inv2));
+  BOOST_CHECK(inv2.equals(inv1));
+  BOOST_CHECK(inv2.leq(inv1));
+
+  inv2.caught_exceptions().set_to_top();
+  inv2.caught_exceptions().set(x, Interval(1));
+  BOOST_CHECK(inv1.leq(inv2));
+  BOOST_CHECK(!inv2.leq(inv1));
+  BOOST_CHECK(ExceptionDomain::bottom().leq(inv1));
+  BOOST_CHECK(inv2.leq(ExceptionDomain::top()));
+}
+
+BOOST_AUTO_TEST_CASE(join_and_meet) {
+  VariableFactory vfac;
+  Variable x(vfac.get("x"));
+
+  ExceptionDomain inv1 = ExceptionDomain::top_no_exceptions();
+  inv1.normal().set(x, Interval(1));
+  ExceptionDomain inv2 = inv1;
+  inv2.normal().set(x, Interval(2));
+  inv2.throw_exception();
+  BOOST_CHECK(inv2.is_normal_flow_bottom());
+  BOOST_CHECK(inv2.caught_exceptions().to_interval(x) == Interval(2));
+
+  ExceptionDomain join = inv1.join(inv2);
+  BOOST_CHECK(join.normal().to_interval(x) == Interval(1));
+  BOOST_CHECK(join.caught_exceptions().to_interval(x) == Interval(2));
+  BOOST_CHECK(join.is_propagated_exceptions_bottom());
+  BOOST_CHECK(inv2.join(inv1).equals(join));
+
+  ExceptionDomain widening = inv1.widening(inv2);
+  BOOST_CHECK(widening.equals(join));
+
+  ExceptionDomain meet = join.meet(inv2);
+  BOOST_CHECK(meet.equals(inv2));
+  BOOST_CHECK(join.meet(inv1).equals(inv1));
+  BOOST_CHECK(inv1.meet(inv2).is_bottom());
+  BOOST_CHECK(join.narrowing(inv1).equals(inv1));
+}
+
+BOOST_AUTO_TEST_CASE(exceptions) {
+  VariableFactory vfac;
+  Variable x(vfac.get("x"));
+
+  ExceptionDomain inv = ExceptionDomain::top_no_exceptions();
+  inv.normal().set(x, Interval(1));
+  inv.throw_exception();
+  BOOST_CHECK(inv.is_normal_flow_bottom());
+  BOOST_CHECK(inv.caught_exceptions().to_interval(x) == Interval(1));
+
+  inv.merge_caught_in_propagated_exceptions();
+  BOOST_CHECK(inv.is_caught_exceptions_bottom());
+  BOOST_CHECK(inv.propagated_exceptions().to_interval(x) == Interval(1));
+
+  inv.merge_propagated_in_caught_exceptions();
+  BOOST_CHECK(inv.is_propagated_exceptions_bottom());
+  BOOST_CHECK(inv.caught_exceptions().to_interval(x) == Interval(1));
+
+  inv.enter_catch();
+  BOOST_CHECK(inv.normal().to_interval(x) == Interval(1));
+  BOOST_CHECK(inv.is_caught_exceptions_bottom());
+  BOOST_CHECK(inv.is_propagated_exceptions_bottom());
+
+  inv.enter_catch();
+  BOOST_CHECK(inv.is_bottom());
+
+  inv = ExceptionDomain::top();
+  inv.ignore_exceptions();
+  BOOST_CHECK(inv.equals(ExceptionDomain::top_no_exceptions()));
+}
+
+BOOST_AUTO_TEST_CASE(const_accessors) {
+  const ExceptionDomain inv1 = ExceptionDomain::top_no_exceptions();
+  const ExceptionDomain inv2 = ExceptionDomain::bottom();
+
+  // Bottom exception states are shared, not materialized
+  BOOST_CHECK(inv1.caught_exceptions().is_bottom());
+  BOOST_CHECK(inv1.propagated_exceptions().is_bottom());
+  BOOST_CHECK(&inv1.caught_exceptions() == &inv2.caught_exceptions());
+  BOOST_CHECK(&inv1.propagated_exceptions() == &inv2.propagated_exceptions());
+}
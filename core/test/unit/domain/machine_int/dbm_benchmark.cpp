@@ -0,0 +1,202 @@
+/*******************************************************************************
+ *
+ * Benchmark for machine_int::DBM
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2018 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#define BOOST_TEST_MODULE test_machine_int_dbm_benchmark
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <ikos/core/domain/machine_int/dbm.hpp>
+#include <ikos/core/domain/machine_int/numeric_domain_adapter.hpp>
+#include <ikos/core/domain/numeric/dbm.hpp>
+#include <ikos/core/domain/numeric/var_packing_dbm.hpp>
+#include <ikos/core/example/machine_int/variable_factory.hpp>
+
+#include "benchmark_timer.hpp"
+
+// Run with `--log_level=message` to display the timings.
+
+namespace {
+
+using ZNumber = ikos::core::ZNumber;
+using Int = ikos::core::MachineInt;
+using ikos::core::Signed;
+using ikos::core::machine_int::BinaryOperator;
+using ikos::core::machine_int::Predicate;
+using VariableFactory = ikos::core::example::machine_int::VariableFactory;
+using Variable = VariableFactory::VariableRef;
+
+using NativeDBM = ikos::core::machine_int::DBM< Variable >;
+using AdapterDBM = ikos::core::machine_int::NumericDomainAdapter<
+    Variable,
+    ikos::core::numeric::DBM< ZNumber, Variable > >;
+using AdapterVarPackDBM = ikos::core::machine_int::NumericDomainAdapter<
+    Variable,
+    ikos::core::numeric::VarPackingDBM< ZNumber, Variable > >;
+
+/// \brief Number of loop iterations before the widening
+constexpr int NumIterations = 24;
+
+/// \brief Number of statements in each branch of the loop body
+constexpr int NumStatements = 16;
+
+/// \brief Simple linear congruential generator, for reproducible results
+class Random {
+private:
+  std::uint64_t _state = 42;
+
+public:
+  std::size_t operator()(std::size_t bound) {
+    _state = _state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return static_cast< std::size_t >(_state >> 33) % bound;
+  }
+};
+
+/// \brief Return a 32 bits signed integer
+Int int32(std::size_t n) {
+  return Int(n, 32, Signed);
+}
+
+/// \brief Apply a random statement
+template < typename Domain >
+void statement(Domain& inv, const std::vector< Variable >& vars, Random& rand) {
+  Variable x = vars[rand(vars.size())];
+  Variable y = vars[rand(vars.size())];
+
+  switch (rand(4)) {
+    case 0: {
+      inv.apply(BinaryOperator::Add, x, y, int32(1 + rand(8)));
+    } break;
+    case 1: {
+      inv.apply(BinaryOperator::Sub, x, x, int32(1));
+    } break;
+    case 2: {
+      inv.assign(x, y);
+    } break;
+    default: {
+      inv.add(Predicate::LE, x, int32(1000 + rand(1000)));
+    } break;
+  }
+}
+
+/// \brief Analyze a loop with two branches, return the time in ms
+///
+/// The loop counter is compared to the other variables, so that the relations
+/// between variables are used by the domains.
+template < typename Domain >
+double run(const std::vector< Variable >& vars, std::size_t& acc) {
+  BenchmarkTimer timer;
+  Random rand;
+
+  Variable i = vars[0];
+  Variable n = vars[1];
+  Domain inv;
+  for (std::size_t k = 0; k < vars.size(); ++k) {
+    inv.assign(vars[k], int32(k));
+  }
+  inv.add(Predicate::LE, n, int32(100));
+
+  for (int iter = 0; iter < NumIterations; ++iter) {
+    Domain body = inv;
+    body.add(Predicate::LT, i, n);
+
+    Domain lhs = body;
+    Domain rhs = body;
+    for (int k = 0; k < NumStatements; ++k) {
+      statement(lhs, vars, rand);
+      statement(rhs, vars, rand);
+    }
+    lhs.join_with(rhs);
+    lhs.apply(BinaryOperator::Add, i, i, int32(1));
+
+    Domain next = inv.join(lhs);
+    if (iter < NumIterations / 2) {
+      inv = next;
+    } else {
+      inv.widen_with(next);
+    }
+
+    acc += inv.to_interval(i).is_top() ? 0 : 1;
+  }
+
+  return timer.elapsed_ms();
+}
+
+/// \brief Display the time of the machine integer DBM and the adapters
+void benchmark(const char* name, std::size_t num_vars) {
+  VariableFactory vfac;
+  std::vector< Variable > vars;
+  vars.reserve(num_vars);
+  for (std::size_t k = 0; k < num_vars; ++k) {
+    vars.push_back(vfac.get("x" + std::to_string(k), 32, Signed));
+  }
+
+  std::size_t acc_native = 0;
+  std::size_t acc_dbm = 0;
+  std::size_t acc_var_pack_dbm = 0;
+  double native_time = run< NativeDBM >(vars, acc_native);
+  double dbm_time = run< AdapterDBM >(vars, acc_dbm);
+  double var_pack_dbm_time = run< AdapterVarPackDBM >(vars, acc_var_pack_dbm);
+
+  BOOST_CHECK(acc_native > 0);
+  BOOST_CHECK(acc_native >= acc_dbm);
+  BOOST_TEST_MESSAGE(name << ": native-dbm " << native_time << "ms, dbm "
+                          << dbm_time << "ms, var-pack-dbm "
+                          << var_pack_dbm_time << "ms");
+}
+
+} // end anonymous namespace
+
+BOOST_AUTO_TEST_CASE(benchmark_small) {
+  benchmark("8 variables", 8);
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_medium) {
+  benchmark("32 variables", 32);
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_large) {
+  benchmark("64 variables", 64);
+}
@@ -42,6 +42,9 @@
 
 #define BOOST_TEST_MODULE test_machine_int_polymorphic_domain
 #define BOOST_TEST_DYN_LINK
+#include <thread>
+#include <vector>
+
 #include <boost/mpl/list.hpp>
 #include <boost/test/output_test_stream.hpp>
 #include <boost/test/unit_test.hpp>
@@ -945,3 +948,71 @@ BOOST_AUTO_TEST_CASE(to_congruence) {
   BOOST_CHECK(inv.to_congruence(e2) ==
               Congruence(Int(4, 32, Signed), Int(2, 32, Signed)));
 }
+
+BOOST_AUTO_TEST_CASE(copy_on_write) {
+  VariableFactory vfac;
+  Variable x(vfac.get("x", 32, Signed));
+  Variable y(vfac.get("y", 32, Signed));
+
+  PolymorphicDomain inv1(IntervalDomain::top());
+  inv1.set(x, Interval(Int(0, 32, Signed), Int(1, 32, Signed)));
+
+  PolymorphicDomain inv2(inv1);
+  BOOST_CHECK(inv1.leq(inv2));
+  BOOST_CHECK(inv1.equals(inv2));
+  inv2.join_with(inv1);
+  inv2.meet_with(inv1);
+  BOOST_CHECK(inv2.to_interval(x) ==
+              Interval(Int(0, 32, Signed), Int(1, 32, Signed)));
+
+  inv2.assign(y, Int(2, 32, Signed));
+  inv2.forget(x);
+  BOOST_CHECK(inv1.to_interval(x) ==
+              Interval(Int(0, 32, Signed), Int(1, 32, Signed)));
+  BOOST_CHECK(inv1.to_interval(y) == Interval::top(32, Signed));
+  BOOST_CHECK(inv2.to_interval(x) == Interval::top(32, Signed));
+  BOOST_CHECK(inv2.to_interval(y) == Interval(Int(2, 32, Signed)));
+
+  PolymorphicDomain inv3(IntervalDomain::top());
+  inv3 = inv1;
+  inv1.set_to_bottom();
+  BOOST_CHECK(inv1.is_bottom());
+  BOOST_CHECK(!inv3.is_bottom());
+  inv1.set_to_top();
+  BOOST_CHECK(inv1.is_top());
+  BOOST_CHECK(inv3.to_interval(x) ==
+              Interval(Int(0, 32, Signed), Int(1, 32, Signed)));
+
+  inv3.meet_with(PolymorphicDomain::bottom());
+  BOOST_CHECK(inv3.is_bottom());
+  BOOST_CHECK(inv1.is_top());
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_copies) {
+  VariableFactory vfac;
+  Variable x(vfac.get("x", 32, Signed));
+
+  PolymorphicDomain inv(IntervalDomain::top());
+  inv.set(x, Interval(Int(0, 32, Signed), Int(1, 32, Signed)));
+
+  // Threads share the same abstract value, then write their own copy
+  std::vector< int > results(4, 0);
+  std::vector< std::thread > threads;
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&, t] {
+      PolymorphicDomain copy(inv);
+      copy.set(x, Interval(Int(t + 2, 32, Signed)));
+      bool shared_ok = inv.to_interval(x) ==
+                       Interval(Int(0, 32, Signed), Int(1, 32, Signed));
+      bool copy_ok = copy.to_interval(x) == Interval(Int(t + 2, 32, Signed));
+      results[t] = shared_ok && copy_ok ? 1 : 0;
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  for (int result : results) {
+    BOOST_CHECK(result == 1);
+  }
+}
@@ -0,0 +1,377 @@
+/*******************************************************************************
+ *
+ * Tests for CellIndex
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2018 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <set>
+#include <vector>
+
+#define BOOST_TEST_MODULE test_cell_index
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <ikos/core/domain/memory/value/cell_index.hpp>
+
+namespace {
+
+using ikos::core::Index;
+using ikos::core::Unsigned;
+using Int = ikos::core::MachineInt;
+
+/// \brief Memory location
+struct MemLoc {};
+
+/// \brief Cell of a memory location
+struct Cell {
+  Index id;
+  Int offset;
+  Int size;
+};
+
+/// \brief Factory for cells
+class Factory {
+private:
+  Index _next_id = 1;
+  std::deque< Cell > _cells;
+
+public:
+  Cell* cell(uint64_t offset, uint64_t size) {
+    _cells.push_back(
+        Cell{_next_id++, Int(offset, 64, Unsigned), Int(size, 64, Unsigned)});
+    return &_cells.back();
+  }
+};
+
+} // end anonymous namespace
+
+namespace ikos {
+namespace core {
+
+template <>
+struct IndexableTraits< Cell* > {
+  static Index index(Cell* c) { return c->id; }
+};
+
+template <>
+struct DumpableTraits< Cell* > {
+  static void dump(std::ostream& o, Cell* c) {
+    o << "C{" << c->offset << "," << c->size << "}";
+  }
+};
+
+namespace memory {
+
+template <>
+struct CellVariableTraits< Cell*, MemLoc* > {
+  static MemLoc* base(Cell*) { return nullptr; }
+  static const MachineInt& offset(Cell* c) { return c->offset; }
+  static const MachineInt& size(Cell* c) { return c->size; }
+};
+
+} // end namespace memory
+
+} // end namespace core
+} // end namespace ikos
+
+namespace {
+
+using Set = ikos::core::memory::CellIndex< Cell*, MemLoc* >;
+
+/// \brief Order of the cells in a cell index
+struct CellLess {
+  bool operator()(Cell* a, Cell* b) const {
+    if (a->offset != b->offset) {
+      return a->offset < b->offset;
+    } else if (a->size != b->size) {
+      return a->size < b->size;
+    } else {
+      return a->id < b->id;
+    }
+  }
+};
+
+using RefSet = std::set< Cell*, CellLess >;
+
+/// \brief Return true if the cell index contains exactly the given cells
+bool check(const Set& s, const RefSet& t) {
+  return s.size() == t.size() &&
+         std::equal(s.begin(), s.end(), t.begin(), t.end());
+}
+
+/// \brief Return the cells overlapping [lb, ub], in order
+std::vector< Cell* > overlap(const Set& s, uint64_t lb, uint64_t ub) {
+  std::vector< Cell* > cells;
+  s.for_each_overlap(Int(lb, 64, Unsigned),
+                     Int(ub, 64, Unsigned),
+                     [&cells](Cell* c) { cells.push_back(c); });
+  return cells;
+}
+
+/// \brief Return the cells overlapping [lb, ub] by scanning all the cells
+std::vector< Cell* > overlap_scan(const RefSet& t, uint64_t lb, uint64_t ub) {
+  std::vector< Cell* > cells;
+  for (Cell* c : t) {
+    uint64_t offset = c->offset.to< uint64_t >();
+    uint64_t last = offset + c->size.to< uint64_t >() - 1;
+    if (offset <= ub && lb <= last) {
+      cells.push_back(c);
+    }
+  }
+  return cells;
+}
+
+} // end anonymous namespace
+
+BOOST_AUTO_TEST_CASE(test_insert_erase) {
+  Factory fac;
+  std::vector< Cell* > cells;
+  for (uint64_t i = 0; i < 200; i++) {
+    cells.push_back(fac.cell(4 * i, 4));
+  }
+
+  Set s;
+  BOOST_CHECK(s.empty());
+  BOOST_CHECK(s.size() == 0);
+  BOOST_CHECK(!s.contains(cells[0]));
+
+  s.insert(cells[0]);
+  BOOST_CHECK(!s.empty());
+  BOOST_CHECK(s.size() == 1);
+  BOOST_CHECK(s.contains(cells[0]));
+  BOOST_CHECK(!s.contains(cells[1]));
+
+  s.insert(cells[0]);
+  BOOST_CHECK(s.size() == 1);
+
+  // insert in reverse order, to split chunks
+  for (std::size_t i = 199; i >= 1; i--) {
+    s.insert(cells[i]);
+  }
+  BOOST_CHECK(s.size() == 200);
+  for (Cell* c : cells) {
+    BOOST_CHECK(s.contains(c));
+  }
+  BOOST_CHECK(std::equal(s.begin(), s.end(), cells.begin(), cells.end()));
+
+  s.erase(cells[64]);
+  BOOST_CHECK(s.size() == 199);
+  BOOST_CHECK(!s.contains(cells[64]));
+  BOOST_CHECK(s.contains(cells[63]));
+  BOOST_CHECK(s.contains(cells[65]));
+
+  s.erase(cells[64]);
+  BOOST_CHECK(s.size() == 199);
+
+  for (Cell* c : cells) {
+    s.erase(c);
+  }
+  BOOST_CHECK(s.empty());
+  BOOST_CHECK((s.begin() == s.end()));
+
+  s.insert(cells[1]);
+  s.insert(cells[2]);
+  BOOST_CHECK(s.size() == 2);
+  s.clear();
+  BOOST_CHECK(s.empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_iterators) {
+  Factory fac;
+  Cell* a = fac.cell(8, 4);
+  Cell* b = fac.cell(0, 8);
+  Cell* c = fac.cell(0, 4);
+  Cell* d = fac.cell(4, 1);
+
+  // Cells are sorted by offset, then size
+  Set s{a, b, c, d};
+  std::vector< Cell* > expected = {c, b, d, a};
+  BOOST_CHECK(std::equal(s.begin(), s.end(), expected.begin(), expected.end()));
+}
+
+BOOST_AUTO_TEST_CASE(test_copy_on_write) {
+  Factory fac;
+  Cell* a = fac.cell(0, 4);
+  Cell* b = fac.cell(4, 4);
+  Cell* c = fac.cell(8, 4);
+
+  Set s1{a, b};
+  Set s2 = s1;
+
+  s2.insert(c);
+  BOOST_CHECK(s1.equals(Set({a, b})));
+  BOOST_CHECK(s2.equals(Set({a, b, c})));
+
+  s1.erase(a);
+  BOOST_CHECK(s1.equals(Set({b})));
+  BOOST_CHECK(s2.equals(Set({a, b, c})));
+}
+
+BOOST_AUTO_TEST_CASE(test_for_each_overlap) {
+  Factory fac;
+  Cell* a = fac.cell(0, 4);
+  Cell* b = fac.cell(4, 4);
+  Cell* c = fac.cell(8, 8);
+  Cell* d = fac.cell(16, 1);
+  Cell* e = fac.cell(UINT64_MAX - 1, 4); // wraps around
+  Set s{a, b, c, d, e};
+
+  BOOST_CHECK((overlap(s, 0, 0) == std::vector< Cell* >{a}));
+  BOOST_CHECK((overlap(s, 3, 4) == std::vector< Cell* >{a, b}));
+  BOOST_CHECK((overlap(s, 12, 12) == std::vector< Cell* >{c}));
+  BOOST_CHECK((overlap(s, 7, 16) == std::vector< Cell* >{b, c, d}));
+  BOOST_CHECK(overlap(s, 17, 100).empty());
+  BOOST_CHECK((overlap(s, UINT64_MAX, UINT64_MAX) == std::vector< Cell* >{e}));
+  BOOST_CHECK(overlap(Set(), 0, 100).empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_for_each_overlap_large_cell) {
+  // A large cell at the beginning must not hide the cells after it
+  Factory fac;
+  Cell* big = fac.cell(0, 100000);
+  Set s{big};
+  RefSet t{big};
+  for (uint64_t i = 0; i < 1000; i++) {
+    Cell* c = fac.cell(200000 + 4 * i, 4);
+    s.insert(c);
+    t.insert(c);
+  }
+
+  BOOST_CHECK((overlap(s, 50000, 50000) == std::vector< Cell* >{big}));
+  BOOST_CHECK(overlap(s, 100000, 199999).empty());
+  BOOST_CHECK(overlap(s, 99999, 200003) == overlap_scan(t, 99999, 200003));
+  BOOST_CHECK(overlap(s, 201000, 201100) == overlap_scan(t, 201000, 201100));
+}
+
+BOOST_AUTO_TEST_CASE(test_sharing) {
+  Factory fac;
+  Set s;
+  for (uint64_t i = 0; i < 300; i++) {
+    s.insert(fac.cell(4 * i, 4));
+  }
+  Set t = s;
+  t.insert(fac.cell(2000, 4));
+  Set u = s;
+  u.erase(*s.begin());
+
+  BOOST_CHECK(s.is_subset_of(t));
+  BOOST_CHECK(!t.is_subset_of(s));
+  BOOST_CHECK(u.is_subset_of(s));
+  BOOST_CHECK(s.join(u).equals(s));
+  BOOST_CHECK(s.join(t).equals(t));
+  BOOST_CHECK(s.intersect(t).equals(s));
+  BOOST_CHECK(s.intersect(u).equals(u));
+  BOOST_CHECK(t.difference(s).size() == 1);
+  BOOST_CHECK(s.difference(u).size() == 1);
+  BOOST_CHECK(s.difference(s).empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_random) {
+  // Compare against std::set on random operations
+  std::uint64_t state = 42;
+  auto rand = [&state](uint64_t bound) {
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return (state >> 33) % bound;
+  };
+
+  Factory fac;
+  std::vector< Cell* > cells;
+  for (int i = 0; i < 400; i++) {
+    cells.push_back(fac.cell(rand(1000), 1 + rand(i % 10 == 0 ? 64 : 8)));
+  }
+
+  for (int k = 0; k < 100; k++) {
+    Set s1, s2;
+    RefSet t1, t2;
+    for (int i = 0; i < 150; i++) {
+      Cell* x = cells[rand(cells.size())];
+      Cell* y = cells[rand(cells.size())];
+      s1.insert(x);
+      t1.insert(x);
+      s2.insert(y);
+      t2.insert(y);
+      if (i % 4 == 0) {
+        s1.erase(y);
+        t1.erase(y);
+      }
+    }
+    BOOST_CHECK(check(s1, t1));
+    BOOST_CHECK(check(s2, t2));
+
+    for (int i = 0; i < 10; i++) {
+      uint64_t lb = rand(1100);
+      uint64_t ub = lb + rand(i % 2 == 0 ? 4 : 100);
+      BOOST_CHECK(overlap(s1, lb, ub) == overlap_scan(t1, lb, ub));
+    }
+
+    RefSet r;
+    std::set_union(t1.begin(),
+                   t1.end(),
+                   t2.begin(),
+                   t2.end(),
+                   std::inserter(r, r.end()),
+                   CellLess());
+    BOOST_CHECK(check(s1.join(s2), r));
+
+    r.clear();
+    std::set_intersection(t1.begin(),
+                          t1.end(),
+                          t2.begin(),
+                          t2.end(),
+                          std::inserter(r, r.end()),
+                          CellLess());
+    BOOST_CHECK(check(s1.intersect(s2), r));
+
+    r.clear();
+    std::set_difference(t1.begin(),
+                        t1.end(),
+                        t2.begin(),
+                        t2.end(),
+                        std::inserter(r, r.end()),
+                        CellLess());
+    BOOST_CHECK(check(s1.difference(s2), r));
+    BOOST_CHECK(s1.difference(s2).is_subset_of(s1));
+    BOOST_CHECK(s1.join(s2).equals(s2.join(s1)));
+    BOOST_CHECK(s1.intersect(s2).is_subset_of(s2));
+  }
+}
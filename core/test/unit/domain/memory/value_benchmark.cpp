@@ -0,0 +1,419 @@
+/*******************************************************************************
+ *
+ * Benchmark of memory writes in the value domain
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2018 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <cstddef>
+#include <cstdlib>
+#include <deque>
+#include <map>
+#include <new>
+#include <ostream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#define BOOST_TEST_MODULE test_value_domain_benchmark
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <ikos/core/domain/exception/exception.hpp>
+#include <ikos/core/domain/lifetime/lifetime.hpp>
+#include <ikos/core/domain/machine_int/interval_congruence.hpp>
+#include <ikos/core/domain/memory/value.hpp>
+#include <ikos/core/domain/nullity/nullity.hpp>
+#include <ikos/core/domain/pointer/pointer.hpp>
+#include <ikos/core/domain/uninitialized/uninitialized.hpp>
+
+#include "benchmark_timer.hpp"
+
+// Run with `--log_level=message` to display the timings.
+
+namespace {
+
+/// \brief Number of dynamic allocations since the start of the program
+std::size_t NumAllocations = 0;
+
+} // end anonymous namespace
+
+// Count dynamic allocations by replacing the global allocation functions
+//
+// GCC reports a false positive when the replaced `operator delete` is inlined.
+#if !defined(__clang__) && defined(__GNUC__) && __GNUC__ >= 11
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(std::size_t size) {
+  ++NumAllocations;
+  if (void* p = std::malloc(size == 0 ? 1 : size)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+  std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+  std::free(p);
+}
+
+namespace {
+
+using ikos::core::Index;
+using ikos::core::Signedness;
+using ikos::core::Signed;
+using ikos::core::Unsigned;
+using Int = ikos::core::MachineInt;
+using Interval = ikos::core::machine_int::Interval;
+using Congruence = ikos::core::machine_int::Congruence;
+using IntervalCongruence = ikos::core::machine_int::IntervalCongruence;
+
+/// \brief Memory location
+struct MemLoc {
+  Index id;
+  std::string name;
+};
+
+/// \brief Variable, either a scalar (integer or pointer) or a memory cell
+struct Var {
+  enum Kind { IntKind, PointerKind, CellKind };
+
+  Index id;
+  Kind kind;
+  std::string name;
+  unsigned bit_width;
+  Signedness sign;
+  Var* offset_var; // for pointers and cells
+  MemLoc* base;    // for cells
+  Int offset;      // for cells
+  Int size;        // for cells
+};
+
+/// \brief Factory for variables, memory locations and cells
+class Factory {
+private:
+  Index _next_id = 1;
+  std::deque< Var > _vars;
+  std::deque< MemLoc > _locs;
+  std::map< std::tuple< MemLoc*, Int, Int >, Var* > _cells;
+
+public:
+  Var* integer(const std::string& name) {
+    _vars.push_back(Var{_next_id++,
+                        Var::IntKind,
+                        name,
+                        64,
+                        Unsigned,
+                        nullptr,
+                        nullptr,
+                        Int::zero(64, Unsigned),
+                        Int::zero(64, Unsigned)});
+    return &_vars.back();
+  }
+
+  Var* pointer(const std::string& name) {
+    Var* offset = this->integer(name + ".offset");
+    Var* p = this->integer(name);
+    p->kind = Var::PointerKind;
+    p->offset_var = offset;
+    return p;
+  }
+
+  MemLoc* memory_location(const std::string& name) {
+    _locs.push_back(MemLoc{_next_id++, name});
+    return &_locs.back();
+  }
+
+  Var* cell(MemLoc* base, const Int& offset, const Int& size) {
+    auto key = std::make_tuple(base, offset, size);
+    auto it = _cells.find(key);
+    if (it != _cells.end()) {
+      return it->second;
+    }
+    std::string name =
+        "C{" + base->name + "," + offset.str() + "," + size.str() + "}";
+    Var* c = this->pointer(name);
+    c->kind = Var::CellKind;
+    c->bit_width = size.to< unsigned >() * 8;
+    c->sign = Signed;
+    c->base = base;
+    c->offset = offset;
+    c->size = size;
+    _cells.emplace(key, c);
+    return c;
+  }
+};
+
+} // end anonymous namespace
+
+namespace ikos {
+namespace core {
+
+template <>
+struct IndexableTraits< Var* > {
+  static Index index(Var* v) { return v->id; }
+};
+
+template <>
+struct DumpableTraits< Var* > {
+  static void dump(std::ostream& o, Var* v) { o << v->name; }
+};
+
+template <>
+struct IndexableTraits< MemLoc* > {
+  static Index index(MemLoc* m) { return m->id; }
+};
+
+template <>
+struct DumpableTraits< MemLoc* > {
+  static void dump(std::ostream& o, MemLoc* m) { o << m->name; }
+};
+
+namespace machine_int {
+
+template <>
+struct VariableTraits< Var* > {
+  static unsigned bit_width(Var* v) { return v->bit_width; }
+  static Signedness sign(Var* v) { return v->sign; }
+};
+
+} // end namespace machine_int
+
+namespace pointer {
+
+template <>
+struct VariableTraits< Var* > {
+  static Var* offset_var(Var* v) { return v->offset_var; }
+};
+
+} // end namespace pointer
+
+namespace memory {
+
+template <>
+struct VariableTraits< Var* > {
+  static bool is_cell(Var* v) { return v->kind == Var::CellKind; }
+  static bool is_int(Var* v) { return v->kind != Var::PointerKind; }
+  static bool is_float(Var*) { return false; }
+  static bool is_pointer(Var* v) { return v->kind == Var::PointerKind; }
+};
+
+template <>
+struct CellVariableTraits< Var*, MemLoc* > {
+  static MemLoc* base(Var* v) { return v->base; }
+  static const MachineInt& offset(Var* v) { return v->offset; }
+  static const MachineInt& size(Var* v) { return v->size; }
+};
+
+template <>
+struct CellFactoryTraits< Var*, MemLoc*, Factory > {
+  static Var* cell(Factory& fac,
+                   MemLoc* base,
+                   const MachineInt& offset,
+                   const MachineInt& size) {
+    return fac.cell(base, offset, size);
+  }
+};
+
+} // end namespace memory
+
+} // end namespace core
+} // end namespace ikos
+
+namespace {
+
+using MachineIntDomain =
+    ikos::core::machine_int::IntervalCongruenceDomain< Var* >;
+using NullityDomain = ikos::core::nullity::NullityDomain< Var* >;
+using PointerDomain = ikos::core::pointer::
+    PointerDomain< Var*, MemLoc*, MachineIntDomain, NullityDomain >;
+using UninitializedDomain =
+    ikos::core::uninitialized::UninitializedDomain< Var* >;
+using LifetimeDomain = ikos::core::lifetime::LifetimeDomain< MemLoc* >;
+using ValueDomain = ikos::core::memory::ValueDomain< Var*,
+                                                      MemLoc*,
+                                                      Factory,
+                                                      MachineIntDomain,
+                                                      NullityDomain,
+                                                      PointerDomain,
+                                                      UninitializedDomain,
+                                                      LifetimeDomain >;
+using ExceptionDomain = ikos::core::exception::ExceptionDomain< ValueDomain >;
+using Literal = ikos::core::Literal< Var*, MemLoc* >;
+
+/// \brief Number of cells updated by a write with an offset range
+constexpr int RangeCells = 4;
+
+/// \brief Number of memory writes
+constexpr int Iterations = 20000;
+
+/// \brief Write in an array of `num_cells` integers, return the number of
+/// allocations per write
+///
+/// The first writes initialize every cell, the following writes perform
+/// `*p = i` where p points to `&a + [0, 4 * (RangeCells - 1)]` with
+/// `offset = 4Z+0`, updating `RangeCells` cells at once.
+void benchmark(const char* name, int num_cells, bool range) {
+  Factory fac;
+  MemLoc* a = fac.memory_location("a");
+  Var* p = fac.pointer("p");
+  Int four(4, 64, Unsigned);
+
+  ValueDomain inv = ValueDomain::top();
+  inv.pointers().assign_address(p, a, ikos::core::Nullity::non_null());
+  inv.uninitialized().assign_initialized(p);
+  for (int i = 0; i < num_cells; ++i) {
+    inv.integers().assign(p->offset_var, Int(4 * i, 64, Unsigned));
+    inv.mem_write(fac, p, Literal::machine_int(Int(i, 32, Signed)), four);
+  }
+
+  if (range) {
+    inv.integers().set(p->offset_var,
+                       IntervalCongruence(Interval(Int(0, 64, Unsigned),
+                                                   Int(4 * (RangeCells - 1),
+                                                       64,
+                                                       Unsigned)),
+                                          Congruence(Int(4, 64, Unsigned),
+                                                     Int(0, 64, Unsigned))));
+  } else {
+    inv.integers().assign(p->offset_var, Int(0, 64, Unsigned));
+  }
+
+  std::size_t allocations = NumAllocations;
+  BenchmarkTimer timer;
+  for (int i = 0; i < Iterations; ++i) {
+    ValueDomain tmp = inv;
+    tmp.mem_write(fac, p, Literal::machine_int(Int(i, 32, Signed)), four);
+    BOOST_CHECK(!tmp.is_bottom());
+  }
+  allocations = NumAllocations - allocations;
+
+  double time = timer.elapsed_ms();
+  BOOST_TEST_MESSAGE(name << ": " << time << "ms, "
+                          << static_cast< double >(allocations) / Iterations
+                          << " allocations per write");
+}
+
+/// \brief Number of basic blocks
+constexpr int NumBlocks = 32;
+
+/// \brief Number of variables dead at the end of each basic block
+constexpr int NumDeadVariables = 8;
+
+/// \brief Forget a variable in all the states that are not bottom, as the
+/// execution engine does when leaving a basic block
+void forget_surface(ExceptionDomain& inv, Var* x) {
+  inv.normal().forget_surface(x);
+  if (!inv.is_caught_exceptions_bottom()) {
+    inv.caught_exceptions().forget_surface(x);
+  }
+  if (!inv.is_propagated_exceptions_bottom()) {
+    inv.propagated_exceptions().forget_surface(x);
+  }
+}
+
+/// \brief Simulate the analysis of basic blocks with no exceptions, as in C
+///
+/// Each basic block joins the invariants of its predecessors, assigns a
+/// variable, forgets the dead variables and checks for convergence.
+void benchmark_blocks(const char* name, int num_vars) {
+  Factory fac;
+  std::vector< Var* > vars;
+  ExceptionDomain entry = ExceptionDomain::top_no_exceptions();
+  for (int i = 0; i < num_vars; ++i) {
+    vars.push_back(fac.integer("x" + std::to_string(i)));
+    entry.normal().integers().assign(vars.back(), Int(i, 64, Unsigned));
+    entry.normal().uninitialized().assign_initialized(vars.back());
+  }
+  std::vector< ExceptionDomain > invs(NumBlocks, entry);
+
+  std::size_t acc = 0;
+  std::size_t allocations = NumAllocations;
+  BenchmarkTimer timer;
+  for (int k = 0; k < Iterations / NumBlocks; ++k) {
+    for (int b = 1; b < NumBlocks; ++b) {
+      ExceptionDomain inv = invs[b - 1];
+      inv.join_with(invs[b / 2]);
+      Var* x = vars[(k + b) % num_vars];
+      inv.normal().integers().assign(x, Int(k, 64, Unsigned));
+      for (int i = 0; i < NumDeadVariables; ++i) {
+        forget_surface(inv, vars[(k + 2 * b + i) % num_vars]);
+      }
+      acc += inv.leq(invs[b]) ? 0 : 1;
+      invs[b] = inv;
+    }
+  }
+  allocations = NumAllocations - allocations;
+
+  BOOST_CHECK(acc > 0);
+  double time = timer.elapsed_ms();
+  int blocks = (Iterations / NumBlocks) * (NumBlocks - 1);
+  BOOST_TEST_MESSAGE(name << ": " << time << "ms, "
+                     << static_cast< double >(allocations) / blocks
+                     << " allocations per block");
+}
+
+} // end anonymous namespace
+
+BOOST_AUTO_TEST_CASE(benchmark_mem_write_single) {
+  benchmark("mem_write (singleton offset)", 4, false);
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_mem_write_range) {
+  benchmark("mem_write (offset range)", 4, true);
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_mem_write_large_single) {
+  benchmark("mem_write (singleton offset, 512 cells)", 512, false);
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_mem_write_large_range) {
+  benchmark("mem_write (offset range, 512 cells)", 512, true);
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_exception_blocks_small) {
+  benchmark_blocks("basic blocks (no exceptions, 8 variables)", 8);
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_exception_blocks_large) {
+  benchmark_blocks("basic blocks (no exceptions, 64 variables)", 64);
+}
@@ -0,0 +1,138 @@
+/*******************************************************************************
+ *
+ * Benchmark of Octagon against ApronDomain with Domain = Octagon
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2018 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#define BOOST_TEST_MODULE test_apron_octagon_benchmark
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <ikos/core/domain/numeric/apron.hpp>
+#include <ikos/core/domain/numeric/octagon.hpp>
+#include <ikos/core/example/variable_factory.hpp>
+#include <ikos/core/number/z_number.hpp>
+
+#include "benchmark_timer.hpp"
+
+// Run with `--log_level=message` to display the timings.
+
+namespace {
+
+using ZNumber = ikos::core::ZNumber;
+using VariableFactory = ikos::core::example::VariableFactory;
+using Variable = ikos::core::example::VariableFactory::VariableRef;
+using VariableExpr = ikos::core::VariableExpression< ZNumber, Variable >;
+using Octagon = ikos::core::numeric::Octagon< ZNumber, Variable >;
+using ApronOctagon =
+    ikos::core::numeric::ApronDomain< ikos::core::numeric::apron::Octagon,
+                                      ZNumber,
+                                      Variable >;
+
+/// \brief Number of closures
+constexpr int Iterations = 20;
+
+/// \brief Add pseudo-random difference constraints on the given variables
+template < typename Domain >
+Domain make_invariant(const std::vector< Variable >& vars) {
+  Domain inv;
+  std::uint64_t state = 42;
+  for (const Variable& x : vars) {
+    inv.add(VariableExpr(x) >= 0);
+    inv.add(VariableExpr(x) <= 1000);
+  }
+  for (int k = 0; k < 10 * static_cast< int >(vars.size()); ++k) {
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    std::size_t i = (state >> 33) % vars.size();
+    std::size_t j = (state >> 43) % vars.size();
+    int c = static_cast< int >((state >> 53) % 100);
+    if (i != j) {
+      inv.add(VariableExpr(vars[i]) - VariableExpr(vars[j]) <= c);
+    }
+  }
+  return inv;
+}
+
+/// \brief Compute the closure of a widened invariant, return the time in ms
+template < typename Domain >
+double run(const std::vector< Variable >& vars) {
+  Domain inv = make_invariant< Domain >(vars);
+  BenchmarkTimer timer;
+  for (int k = 0; k < Iterations; ++k) {
+    // The widening returns a non-normalized invariant
+    Domain w = inv.widening(inv);
+    BOOST_CHECK(!w.is_bottom());
+  }
+  return timer.elapsed_ms();
+}
+
+/// \brief Compare the closure time of Octagon and ApronOctagon
+void benchmark(std::size_t num_vars) {
+  VariableFactory vfac;
+  std::vector< Variable > vars;
+  for (std::size_t i = 0; i < num_vars; ++i) {
+    vars.push_back(vfac.get("x" + std::to_string(i)));
+  }
+
+  double oct_time = run< Octagon >(vars);
+  double apron_time = run< ApronOctagon >(vars);
+
+  BOOST_TEST_MESSAGE(num_vars << " variables: Octagon " << oct_time
+                              << "ms, ApronOctagon " << apron_time
+                              << "ms, speedup " << (apron_time / oct_time)
+                              << "x");
+}
+
+} // end anonymous namespace
+
+BOOST_AUTO_TEST_CASE(benchmark_10) {
+  benchmark(10);
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_20) {
+  benchmark(20);
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_40) {
+  benchmark(40);
+}
@@ -533,6 +533,15 @@ BOOST_AUTO_TEST_CASE(add) {
 
   inv.add(VariableExpr(x) >= VariableExpr(z));
   BOOST_CHECK(inv.is_bottom());
+
+  // 2 * w != 1 holds for any integer w
+  inv.set_to_top();
+  inv.set(w, Interval(Bound(0), Bound(1)));
+  inv.add(2 * VariableExpr(w) != 1);
+  BOOST_CHECK(inv.to_interval(w) == Interval(Bound(0), Bound(1)));
+
+  inv.add(2 * VariableExpr(w) != 2);
+  BOOST_CHECK(inv.to_interval(w) == Interval(Bound(0)));
 }
 
 BOOST_AUTO_TEST_CASE(set) {
@@ -323,3 +323,152 @@ BOOST_AUTO_TEST_CASE(test_9) {
 
   // TODO(marthaud): Add checks
 }
+
+BOOST_AUTO_TEST_CASE(test_10) {
+  VariableFactory vfac;
+  Variable x(vfac.get("x"));
+  Variable y(vfac.get("y"));
+  Variable z(vfac.get("z"));
+
+  // Bounds are too large for the native closure
+  ZNumber big = ZNumber::from_string("1000000000000000000000");
+
+  Octagon s1(Octagon::top());
+  s1.add(VariableExpr(x) >= big);
+  s1.add(VariableExpr(x) - VariableExpr(y) <= 1);
+  s1.add(VariableExpr(y) - VariableExpr(z) <= 1);
+  s1.add(VariableExpr(z) <= big);
+
+  Octagon s2 = s1.widening(s1);
+  BOOST_CHECK(!s2.is_bottom());
+  BOOST_CHECK(s2.to_interval(x) == ZInterval(ZBound(big), ZBound(big + 2)));
+  BOOST_CHECK(s2.to_interval(z) == ZInterval(ZBound(big - 2), ZBound(big)));
+
+  s2.add(VariableExpr(x) - VariableExpr(z) >= 3);
+  BOOST_CHECK(s2.is_bottom());
+}
+
+BOOST_AUTO_TEST_CASE(meet) {
+  VariableFactory vfac;
+  Variable x(vfac.get("x"));
+  Variable y(vfac.get("y"));
+  Variable z(vfac.get("z"));
+
+  // Variables are inserted in different orders in the two octagons
+  Octagon s1(Octagon::top());
+  s1.add(VariableExpr(x) - VariableExpr(y) <= 1);
+  s1.add(VariableExpr(y) - VariableExpr(z) <= 1);
+
+  Octagon s2(Octagon::top());
+  s2.add(VariableExpr(z) <= 0);
+  s2.add(VariableExpr(y) >= -5);
+  s2.add(VariableExpr(x) >= -10);
+
+  for (const Octagon& s3 : {s1.meet(s2), s2.meet(s1)}) {
+    s3.normalize();
+    BOOST_CHECK(s3.to_interval(x) == ZInterval(ZBound(-10), ZBound(2)));
+    BOOST_CHECK(s3.to_interval(y) == ZInterval(ZBound(-5), ZBound(1)));
+    BOOST_CHECK(s3.to_interval(z) == ZInterval(ZBound(-6), ZBound(0)));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(leq) {
+  VariableFactory vfac;
+  Variable x(vfac.get("x"));
+  Variable y(vfac.get("y"));
+
+  Octagon s1(Octagon::top());
+  s1.assign(x, 0);
+
+  // y is not bounded, but related to x
+  Octagon s2(Octagon::top());
+  s2.add(VariableExpr(x) - VariableExpr(y) <= 0);
+
+  BOOST_CHECK(!s1.leq(s2));
+  BOOST_CHECK(!s2.leq(s1));
+
+  Octagon s3(s2);
+  s3.add(VariableExpr(x) == 0);
+  BOOST_CHECK(s3.leq(s1));
+  BOOST_CHECK(s3.leq(s2));
+}
+
+BOOST_AUTO_TEST_CASE(is_top) {
+  VariableFactory vfac;
+  Variable x(vfac.get("x"));
+  Variable y(vfac.get("y"));
+
+  Octagon inv(Octagon::top());
+  inv.set(x, ZInterval::top());
+  BOOST_CHECK(inv.is_top());
+
+  inv.add(VariableExpr(x) - VariableExpr(y) <= 0);
+  BOOST_CHECK(!inv.is_top());
+
+  inv.forget(x);
+  BOOST_CHECK(inv.is_top());
+}
+
+BOOST_AUTO_TEST_CASE(forget) {
+  VariableFactory vfac;
+  Variable x(vfac.get("x"));
+  Variable y(vfac.get("y"));
+  Variable z(vfac.get("z"));
+
+  Octagon inv(Octagon::top());
+  inv.assign(x, 1);
+  inv.assign(y, 2);
+  inv.add(VariableExpr(z) - VariableExpr(y) <= 0);
+  inv.normalize();
+
+  inv.forget(x);
+  BOOST_CHECK(inv.to_interval(x).is_top());
+  BOOST_CHECK(inv.to_interval(y) == ZInterval(ZNumber(2)));
+  BOOST_CHECK(inv.to_interval(z) == ZInterval(ZBound::minus_infinity(),
+                                              ZBound(2)));
+
+  inv.add(VariableExpr(y) == 3);
+  BOOST_CHECK(inv.is_bottom());
+}
+
+BOOST_AUTO_TEST_CASE(refine) {
+  VariableFactory vfac;
+  Variable x(vfac.get("x"));
+  Variable y(vfac.get("y"));
+
+  Octagon inv(Octagon::top());
+  inv.add(VariableExpr(x) - VariableExpr(y) <= 0);
+  inv.refine(y, ZInterval(ZBound(0), ZBound(3)));
+  BOOST_CHECK(inv.to_interval(y) == ZInterval(ZBound(0), ZBound(3)));
+  inv.normalize();
+  BOOST_CHECK(inv.to_interval(x) == ZInterval(ZBound::minus_infinity(),
+                                              ZBound(3)));
+
+  inv.refine(x, ZInterval(ZBound(5), ZBound(6)));
+  BOOST_CHECK(inv.is_bottom());
+}
+
+BOOST_AUTO_TEST_CASE(non_octagonal_constraints) {
+  VariableFactory vfac;
+  Variable x(vfac.get("x"));
+  Variable y(vfac.get("y"));
+  Variable z(vfac.get("z"));
+
+  Octagon inv(Octagon::top());
+  inv.set(y, ZInterval(ZBound(0), ZBound(4)));
+  inv.set(z, ZInterval(ZBound(1), ZBound(2)));
+  inv.add(2 * VariableExpr(x) <= VariableExpr(y));
+  BOOST_CHECK(inv.to_interval(x) == ZInterval(ZBound::minus_infinity(),
+                                              ZBound(2)));
+
+  inv.add(VariableExpr(x) + VariableExpr(y) + VariableExpr(z) >= 7);
+  BOOST_CHECK(!inv.is_bottom());
+  BOOST_CHECK(inv.to_interval(x) == ZInterval(ZBound(1), ZBound(2)));
+
+  // 2 * x != 3 holds for any integer x
+  inv.add(2 * VariableExpr(x) != 3);
+  BOOST_CHECK(inv.to_interval(x) == ZInterval(ZBound(1), ZBound(2)));
+
+  inv.add(2 * VariableExpr(x) != 2);
+  BOOST_CHECK(inv.to_interval(x) == ZInterval(ZNumber(2)));
+}
@@ -63,6 +63,26 @@ using DBM = ikos::core::numeric::DBM< ZNumber, Variable >;
 using VarPackingDomain =
     ikos::core::numeric::VarPackingDomain< ZNumber, Variable, DBM >;
 
+namespace ikos {
+namespace core {
+
+/// \brief Syntactic packs for the tests
+///
+/// The pack of a variable is the prefix of its name before a dot, if any.
+template <>
+struct PackableTraits< Variable > {
+  static boost::optional< PackId > pack(const Variable& v) {
+    std::size_t dot = v->name().find('.');
+    if (dot == std::string::npos) {
+      return boost::none;
+    }
+    return std::hash< std::string >()(v->name().substr(0, dot));
+  }
+};
+
+} // end namespace core
+} // end namespace ikos
+
 BOOST_AUTO_TEST_CASE(is_top_and_bottom) {
   VariableFactory vfac;
   Variable x(vfac.get("x"));
@@ -905,3 +925,105 @@ BOOST_AUTO_TEST_CASE(to_interval_congruence) {
                                          3 * VariableExpr(y) + 1) ==
               IntervalCongruence(Interval(Bound(-9), Bound(-4))));
 }
+
+BOOST_AUTO_TEST_CASE(syntactic_packs) {
+  VariableFactory vfac;
+  Variable x(vfac.get("p.x"));
+  Variable y(vfac.get("p.y"));
+  Variable z(vfac.get("q.z"));
+  Variable w(vfac.get("w"));
+
+  VarPackingDomain inv;
+  inv.set(x, Interval(Bound(0), Bound(10)));
+  inv.set(z, Interval(Bound(0), Bound(10)));
+
+  // Different packs, only the bounds are refined
+  inv.add(VariableExpr(x) - VariableExpr(z) <= -5);
+  BOOST_CHECK(inv.to_interval(x) == Interval(Bound(0), Bound(5)));
+  BOOST_CHECK(inv.to_interval(z) == Interval(Bound(5), Bound(10)));
+  inv.add(VariableExpr(z) <= 7);
+  BOOST_CHECK(inv.to_interval(x) == Interval(Bound(0), Bound(5)));
+
+  // Same pack
+  inv.add(VariableExpr(x) - VariableExpr(y) <= 0);
+  inv.add(VariableExpr(y) <= 2);
+  inv.normalize();
+  BOOST_CHECK(inv.to_interval(x) == Interval(Bound(0), Bound(2)));
+
+  // Variables without a pack can be related to any pack
+  inv.assign(w, z);
+  inv.add(VariableExpr(w) <= 6);
+  inv.normalize();
+  BOOST_CHECK(inv.to_interval(z) == Interval(Bound(5), Bound(6)));
+
+  // `w` is now in the pack of `z`
+  inv.assign(y, VariableExpr(w) + 1);
+  BOOST_CHECK(inv.to_interval(y) == Interval(Bound(6), Bound(7)));
+  inv.add(VariableExpr(w) <= 5);
+  inv.normalize();
+  BOOST_CHECK(inv.to_interval(y) == Interval(Bound(6), Bound(7)));
+
+  inv.apply(BinaryOperator::Add, x, y, z);
+  BOOST_CHECK(inv.to_interval(x) == Interval(Bound(11), Bound(12)));
+  inv.add(VariableExpr(z) >= 5);
+  inv.normalize();
+  BOOST_CHECK(inv.to_interval(x) == Interval(Bound(11), Bound(12)));
+
+  inv.apply(BinaryOperator::Add, x, y, ZNumber(1));
+  inv.normalize();
+  BOOST_CHECK(inv.to_interval(x) == Interval(Bound(7), Bound(8)));
+  inv.add(VariableExpr(y) <= 6);
+  inv.normalize();
+  BOOST_CHECK(inv.to_interval(x) == Interval(Bound(7), Bound(7)));
+}
+
+BOOST_AUTO_TEST_CASE(copy_on_write) {
+  VariableFactory vfac;
+  Variable x(vfac.get("x"));
+  Variable y(vfac.get("y"));
+  Variable z(vfac.get("z"));
+
+  VarPackingDomain inv1;
+  inv1.assign(x, 1);
+  inv1.add(VariableExpr(x) - VariableExpr(y) <= 0);
+  inv1.assign(z, 0);
+
+  // Updating a copy does not update the original
+  VarPackingDomain inv2(inv1);
+  inv2.add(VariableExpr(y) <= 3);
+  inv2.assign(z, 1);
+  inv1.normalize();
+  inv2.normalize();
+  BOOST_CHECK(inv1.to_interval(y) == Interval(Bound(1), Bound::plus_infinity()));
+  BOOST_CHECK(inv1.to_interval(z) == Interval(Bound(0)));
+  BOOST_CHECK(inv2.to_interval(y) == Interval(Bound(1), Bound(3)));
+  BOOST_CHECK(inv2.to_interval(z) == Interval(Bound(1)));
+
+  // Updating the original does not update the copy
+  inv1.forget(x);
+  BOOST_CHECK(inv1.to_interval(x) == Interval::top());
+  BOOST_CHECK(inv2.to_interval(x) == Interval(Bound(1)));
+
+  // Same equivalence classes
+  VarPackingDomain inv3(inv2);
+  inv3.assign(z, 2);
+  BOOST_CHECK(inv2.leq(inv2.join(inv3)));
+  BOOST_CHECK(inv3.leq(inv2.join(inv3)));
+  BOOST_CHECK(inv2.join(inv3).to_interval(z) == Interval(Bound(1), Bound(2)));
+  BOOST_CHECK(inv2.meet(inv3).is_bottom());
+  BOOST_CHECK(inv2.to_interval(z) == Interval(Bound(1)));
+  BOOST_CHECK(inv3.to_interval(z) == Interval(Bound(2)));
+
+  // Updating a copy, then the original, does not update the copy
+  VarPackingDomain inv4;
+  inv4.add(VariableExpr(x) <= 10);
+  VarPackingDomain inv5(inv4);
+  inv5.add(VariableExpr(y) <= 2);
+  inv4.add(VariableExpr(x) <= 5);
+  inv4.normalize();
+  inv5.normalize();
+  BOOST_CHECK(inv4.to_interval(x) ==
+              Interval(Bound::minus_infinity(), Bound(5)));
+  BOOST_CHECK(inv5.to_interval(x) ==
+              Interval(Bound::minus_infinity(), Bound(10)));
+}
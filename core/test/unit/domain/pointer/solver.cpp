@@ -40,6 +40,9 @@
  *
  ******************************************************************************/
 
+#include <string>
+#include <vector>
+
 #define BOOST_TEST_MODULE test_pointer_solver
 #define BOOST_TEST_DYN_LINK
 #include <boost/mpl/list.hpp>
@@ -352,3 +355,216 @@ BOOST_AUTO_TEST_CASE(test_4) {
                                                      Uninitialized::top()));
   BOOST_CHECK(s.get_memory(nrows) == PointerAbsValue::bottom(64, Unsigned));
 }
+
+BOOST_AUTO_TEST_CASE(test_5) {
+  // Several constraints updating the same pointer should be joined before
+  // applying the widening
+  //
+  // p = &x;
+  // p = &x + 8;
+
+  VariableFactory vfac;
+  MemoryFactory memfac;
+
+  Variable p(vfac.get("p"));
+
+  MemLocation x(memfac.get("x"));
+
+  ConstraintSystem s(64, Unsigned);
+
+  s.add(Assign::create(p,
+                       AddrOperand::create(x, Interval(Int(0, 64, Unsigned)))));
+  s.add(Assign::create(p,
+                       AddrOperand::create(x, Interval(Int(8, 64, Unsigned)))));
+
+  s.solve(/*widening_threshold=*/0);
+
+  BOOST_CHECK(
+      s.get_pointer(p) ==
+      PointerAbsValue(PointsToSet{x},
+                      Interval(Int(0, 64, Unsigned), Int(8, 64, Unsigned)),
+                      Nullity::top(),
+                      Uninitialized::top()));
+}
+
+BOOST_AUTO_TEST_CASE(test_6) {
+  // Chain of loads and stores, in reverse order
+  //
+  // p[0] = *q[1];
+  // *q[1] = p[1];
+  // ...
+  // p[n-1] = *q[n];
+  // *q[n] = p[n];
+  // q[i] = &m[i] for all i
+  // p[n] = &x;
+
+  VariableFactory vfac;
+  MemoryFactory memfac;
+
+  const int n = 50;
+  std::vector< Variable > p;
+  std::vector< Variable > q;
+  std::vector< MemLocation > m;
+  for (int i = 0; i <= n; i++) {
+    p.push_back(vfac.get("p" + std::to_string(i)));
+    q.push_back(vfac.get("q" + std::to_string(i)));
+    m.push_back(memfac.get("m" + std::to_string(i)));
+  }
+  MemLocation x(memfac.get("x"));
+
+  ConstraintSystem s(64, Unsigned);
+  Interval zero(Int(0, 64, Unsigned));
+
+  for (int i = 0; i < n; i++) {
+    s.add(Load::create(p[i], VarOperand::create(q[i + 1], zero)));
+    s.add(Store::create(q[i + 1], VarOperand::create(p[i + 1], zero)));
+  }
+  for (int i = 0; i <= n; i++) {
+    s.add(Assign::create(q[i], AddrOperand::create(m[i], zero)));
+  }
+  s.add(Assign::create(p[n], AddrOperand::create(x, zero)));
+
+  s.solve();
+
+  for (int i = 0; i <= n; i++) {
+    BOOST_CHECK(s.get_pointer(p[i]) ==
+                PointerAbsValue(PointsToSet{x},
+                                zero,
+                                Nullity::top(),
+                                Uninitialized::top()));
+  }
+  for (int i = 1; i <= n; i++) {
+    BOOST_CHECK(s.get_memory(m[i]) ==
+                PointerAbsValue(PointsToSet{x},
+                                zero,
+                                Nullity::top(),
+                                Uninitialized::top()));
+  }
+  BOOST_CHECK(s.get_memory(m[0]) == PointerAbsValue::bottom(64, Unsigned));
+}
+
+BOOST_AUTO_TEST_CASE(test_7) {
+  // Cycle of copies
+  //
+  // p1 = p2;
+  // p2 = p3;
+  // p3 = p1;
+  // p1 = &x;
+
+  VariableFactory vfac;
+  MemoryFactory memfac;
+
+  Variable p1(vfac.get("p1"));
+  Variable p2(vfac.get("p2"));
+  Variable p3(vfac.get("p3"));
+
+  MemLocation x(memfac.get("x"));
+
+  ConstraintSystem s(64, Unsigned);
+  Interval zero(Int(0, 64, Unsigned));
+
+  s.add(Assign::create(p1, VarOperand::create(p2, zero)));
+  s.add(Assign::create(p2, VarOperand::create(p3, zero)));
+  s.add(Assign::create(p3, VarOperand::create(p1, zero)));
+  s.add(Assign::create(p1, AddrOperand::create(x, zero)));
+
+  s.solve();
+
+  PointerAbsValue expected(PointsToSet{x},
+                           zero,
+                           Nullity::top(),
+                           Uninitialized::top());
+  BOOST_CHECK(s.get_pointer(p1) == expected);
+  BOOST_CHECK(s.get_pointer(p2) == expected);
+  BOOST_CHECK(s.get_pointer(p3) == expected);
+
+  BOOST_CHECK(s.cycles().size() == 1);
+  BOOST_CHECK(s.cycles()[0].pointers == (std::vector< Variable >{p1, p2, p3}));
+  BOOST_CHECK(s.cycles()[0].memory_locations.empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_8) {
+  // Cycle of copies through a memory location, and a copy with an offset
+  //
+  // *q = p;
+  // p = *q;
+  // r = p + 4;
+  // q = &m;
+  // p = &x;
+
+  VariableFactory vfac;
+  MemoryFactory memfac;
+
+  Variable p(vfac.get("p"));
+  Variable q(vfac.get("q"));
+  Variable r(vfac.get("r"));
+
+  MemLocation m(memfac.get("m"));
+  MemLocation x(memfac.get("x"));
+
+  ConstraintSystem s(64, Unsigned);
+  Interval zero(Int(0, 64, Unsigned));
+
+  s.add(Store::create(q, VarOperand::create(p, zero)));
+  s.add(Load::create(p, VarOperand::create(q, zero)));
+  s.add(Assign::create(r,
+                       VarOperand::create(p, Interval(Int(4, 64, Unsigned)))));
+  s.add(Assign::create(q, AddrOperand::create(m, zero)));
+  s.add(Assign::create(p, AddrOperand::create(x, zero)));
+
+  s.solve();
+
+  PointerAbsValue expected(PointsToSet{x},
+                           zero,
+                           Nullity::top(),
+                           Uninitialized::top());
+  BOOST_CHECK(s.get_pointer(p) == expected);
+  BOOST_CHECK(s.get_memory(m) == expected);
+  BOOST_CHECK(s.get_pointer(r) ==
+              PointerAbsValue(PointsToSet{x},
+                              Interval(Int(4, 64, Unsigned)),
+                              Nullity::top(),
+                              Uninitialized::top()));
+
+  BOOST_CHECK(s.cycles().size() == 1);
+  BOOST_CHECK(s.cycles()[0].pointers == (std::vector< Variable >{p}));
+  BOOST_CHECK(s.cycles()[0].memory_locations ==
+              (std::vector< MemLocation >{m}));
+}
+
+BOOST_AUTO_TEST_CASE(test_9) {
+  // Constraints generated separately, then merged
+  //
+  // p = &x;    (first system)
+  // q = p + 4; (second system)
+
+  VariableFactory vfac;
+  MemoryFactory memfac;
+
+  Variable p(vfac.get("p"));
+  Variable q(vfac.get("q"));
+
+  MemLocation x(memfac.get("x"));
+
+  ConstraintSystem s1(64, Unsigned);
+  ConstraintSystem s2(64, Unsigned);
+  Interval zero(Int(0, 64, Unsigned));
+  Interval four(Int(4, 64, Unsigned));
+
+  s1.add(Assign::create(p, AddrOperand::create(x, zero)));
+  s2.add(Assign::create(q, VarOperand::create(p, four)));
+
+  ConstraintSystem s(64, Unsigned);
+  s.merge(std::move(s1));
+  s.merge(std::move(s2));
+  s.solve();
+
+  BOOST_CHECK(s.get_pointer(q) == PointerAbsValue(PointsToSet{x},
+                                                  four,
+                                                  Nullity::top(),
+                                                  Uninitialized::top()));
+
+  boost::test_tools::output_test_stream output;
+  s1.dump(output);
+  BOOST_CHECK(output.is_equal("{\n}"));
+}
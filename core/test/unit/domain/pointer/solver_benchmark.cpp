@@ -0,0 +1,238 @@
+/*******************************************************************************
+ *
+ * Benchmark of the pointer constraint solver
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2018 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#define BOOST_TEST_MODULE test_pointer_solver_benchmark
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <ikos/core/domain/pointer/solver.hpp>
+#include <ikos/core/example/variable_factory.hpp>
+
+#include "benchmark_timer.hpp"
+
+// Run with `--log_level=message` to display the timings.
+
+namespace {
+
+using ikos::core::Unsigned;
+using Int = ikos::core::MachineInt;
+using Interval = ikos::core::machine_int::Interval;
+using VariableFactory = ikos::core::example::VariableFactory;
+using Variable = VariableFactory::VariableRef;
+using MemoryFactory = ikos::core::example::VariableFactory;
+using MemLocation = MemoryFactory::VariableRef;
+using VarOperand =
+    ikos::core::pointer::VariableOperand< Variable, MemLocation >;
+using AddrOperand =
+    ikos::core::pointer::AddressOperand< Variable, MemLocation >;
+using Assign = ikos::core::pointer::AssignConstraint< Variable, MemLocation >;
+using Store = ikos::core::pointer::StoreConstraint< Variable, MemLocation >;
+using Load = ikos::core::pointer::LoadConstraint< Variable, MemLocation >;
+using ConstraintSystem =
+    ikos::core::pointer::ConstraintSystem< Variable, MemLocation >;
+
+/// \brief Number of functions
+constexpr std::size_t NumFunctions = 300;
+
+/// \brief Number of local pointer variables per function
+constexpr std::size_t NumLocals = 24;
+
+/// \brief Number of global variables
+constexpr std::size_t NumGlobals = 200;
+
+/// \brief Simple linear congruential generator, for reproducible results
+class Random {
+private:
+  std::uint64_t _state = 42;
+
+public:
+  std::size_t operator()(std::size_t bound) {
+    _state = _state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return static_cast< std::size_t >(_state >> 33) % bound;
+  }
+};
+
+} // end anonymous namespace
+
+BOOST_AUTO_TEST_CASE(benchmark_solve) {
+  VariableFactory vfac;
+  MemoryFactory memfac;
+  Random rand;
+
+  std::vector< MemLocation > globals;
+  globals.reserve(NumGlobals);
+  for (std::size_t i = 0; i < NumGlobals; ++i) {
+    globals.push_back(memfac.get("g" + std::to_string(i)));
+  }
+
+  // locals[f][0] is the parameter of function f, locals[f][NumLocals - 1] is
+  // its return value
+  std::vector< std::vector< Variable > > locals(NumFunctions);
+  for (std::size_t f = 0; f < NumFunctions; ++f) {
+    for (std::size_t i = 0; i < NumLocals; ++i) {
+      locals[f].push_back(
+          vfac.get("f" + std::to_string(f) + ".p" + std::to_string(i)));
+    }
+  }
+
+  // Generate constraints similar to the ones of a program: mostly copies
+  // between local pointers, a few address-of, loads, stores and calls, and
+  // some loops incrementing a pointer.
+  ConstraintSystem s(64, Unsigned);
+  Interval zero(Int(0, 64, Unsigned));
+  Interval field(Int(0, 64, Unsigned), Int(8, 64, Unsigned));
+  Interval four(Int(4, 64, Unsigned));
+  for (std::size_t f = 0; f < NumFunctions; ++f) {
+    const std::vector< Variable >& vars = locals[f];
+    for (std::size_t i = 1; i < NumLocals; ++i) {
+      Variable p = vars[i];
+      Variable q = vars[rand(i)];
+      switch (rand(12)) {
+        case 0: {
+          MemLocation alloc = memfac.get("f" + std::to_string(f) + ".m" +
+                                         std::to_string(i));
+          s.add(Assign::create(p, AddrOperand::create(alloc, zero)));
+        } break;
+        case 1: {
+          s.add(Assign::create(p,
+                               AddrOperand::create(globals[rand(NumGlobals)],
+                                                   zero)));
+        } break;
+        case 2: {
+          s.add(Store::create(q, VarOperand::create(p, zero)));
+          s.add(Assign::create(p, VarOperand::create(q, zero)));
+        } break;
+        case 3: {
+          s.add(Load::create(p, VarOperand::create(q, zero)));
+        } break;
+        case 4: {
+          s.add(Assign::create(p, VarOperand::create(q, field)));
+        } break;
+        case 5: {
+          // call
+          const std::vector< Variable >& callee = locals[rand(NumFunctions)];
+          s.add(Assign::create(callee[0], VarOperand::create(q, zero)));
+          s.add(Assign::create(p,
+                               VarOperand::create(callee[NumLocals - 1],
+                                                  zero)));
+        } break;
+        case 6: {
+          // loop
+          s.add(Assign::create(p, VarOperand::create(q, zero)));
+          s.add(Assign::create(p, VarOperand::create(p, four)));
+        } break;
+        default: {
+          s.add(Assign::create(p, VarOperand::create(q, zero)));
+        } break;
+      }
+    }
+  }
+
+  BenchmarkTimer timer;
+  s.solve();
+  double time = timer.elapsed_ms();
+
+  std::size_t num_pointers = 0;
+  for (auto it = s.pointer_begin(); it != s.pointer_end(); ++it) {
+    if (!it->second.is_bottom()) {
+      num_pointers++;
+    }
+  }
+  BOOST_CHECK(num_pointers > 0);
+  BOOST_TEST_MESSAGE("solve: " << time << "ms (" << num_pointers
+                               << " non-bottom pointers, "
+                               << s.cycles().size() << " collapsed cycles)");
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_callback_table) {
+  VariableFactory vfac;
+  MemoryFactory memfac;
+  Random rand;
+
+  // A table of callbacks, filled with the address of many functions and read
+  // through several chains of copies: every pointer ends up with a large
+  // points-to set.
+  constexpr std::size_t NumCallbacks = 2000;
+  constexpr std::size_t NumReaders = 400;
+  constexpr std::size_t ChainLength = 10;
+
+  ConstraintSystem s(64, Unsigned);
+  Interval zero(Int(0, 64, Unsigned));
+  Interval slot(Int(0, 64, Unsigned), Int(8 * NumCallbacks, 64, Unsigned));
+
+  MemLocation table = memfac.get("table");
+  Variable table_ptr = vfac.get("table_ptr");
+  s.add(Assign::create(table_ptr, AddrOperand::create(table, slot)));
+
+  for (std::size_t i = 0; i < NumCallbacks; ++i) {
+    MemLocation fun = memfac.get("fun" + std::to_string(i));
+    Variable fun_ptr = vfac.get("fun_ptr" + std::to_string(i));
+    s.add(Assign::create(fun_ptr, AddrOperand::create(fun, zero)));
+    s.add(Store::create(table_ptr, VarOperand::create(fun_ptr, zero)));
+  }
+
+  for (std::size_t i = 0; i < NumReaders; ++i) {
+    Variable prev = vfac.get("r" + std::to_string(i) + ".0");
+    s.add(Load::create(prev, VarOperand::create(table_ptr, zero)));
+    for (std::size_t j = 1; j < ChainLength; ++j) {
+      Variable next =
+          vfac.get("r" + std::to_string(i) + "." + std::to_string(j));
+      s.add(Assign::create(next, VarOperand::create(prev, zero)));
+      if (rand(4) == 0) {
+        // Some readers also store back into the table
+        s.add(Store::create(table_ptr, VarOperand::create(next, zero)));
+      }
+      prev = next;
+    }
+  }
+
+  BenchmarkTimer timer;
+  s.solve();
+  double time = timer.elapsed_ms();
+
+  BOOST_CHECK(s.get_memory(table).points_to().size() == NumCallbacks);
+  BOOST_TEST_MESSAGE("callback table: " << time << "ms");
+}
@@ -0,0 +1,190 @@
+/*******************************************************************************
+ *
+ * Micro-benchmarks for SeparateDomain
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2018 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#define BOOST_TEST_MODULE test_separate_domain_benchmark
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <ikos/core/domain/separate_domain.hpp>
+#include <ikos/core/example/variable_factory.hpp>
+#include <ikos/core/number/z_number.hpp>
+#include <ikos/core/value/numeric/interval.hpp>
+
+#include "benchmark_timer.hpp"
+
+// Run with `--log_level=message` to display the timings.
+
+namespace {
+
+using ZNumber = ikos::core::ZNumber;
+using VariableFactory = ikos::core::example::VariableFactory;
+using Variable = ikos::core::example::VariableFactory::VariableRef;
+using Bound = ikos::core::ZBound;
+using Interval = ikos::core::numeric::ZInterval;
+using SeparateDomain = ikos::core::SeparateDomain< Variable, Interval >;
+
+/// \brief Number of variables in the environments
+constexpr std::size_t NumVariables = 2000;
+
+/// \brief Number of environments derived from the same base environment
+constexpr std::size_t NumEnvironments = 64;
+
+/// \brief Number of variables updated in each derived environment
+constexpr std::size_t NumUpdates = 16;
+
+/// \brief Number of iterations over the environments
+constexpr int Iterations = 20;
+
+/// \brief Simple linear congruential generator, for reproducible results
+class Random {
+private:
+  std::uint64_t _state = 42;
+
+public:
+  std::size_t operator()(std::size_t bound) {
+    _state = _state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return static_cast< std::size_t >(_state >> 33) % bound;
+  }
+};
+
+/// \brief Build environments sharing most of their bindings
+///
+/// This is what the fixpoint iterator sees in practice: each environment is a
+/// copy of the same base environment with a few updated variables.
+std::vector< SeparateDomain > make_environments(
+    const std::vector< Variable >& vars) {
+  SeparateDomain base = SeparateDomain::top();
+  for (std::size_t i = 0; i < vars.size(); ++i) {
+    base.set(vars[i], Interval(Bound(0), Bound(ZNumber(i))));
+  }
+
+  Random rand;
+  std::vector< SeparateDomain > envs;
+  envs.reserve(NumEnvironments);
+  for (std::size_t k = 0; k < NumEnvironments; ++k) {
+    SeparateDomain env = base;
+    for (std::size_t j = 0; j < NumUpdates; ++j) {
+      std::size_t i = rand(vars.size());
+      env.set(vars[i], Interval(Bound(0), Bound(ZNumber(i + 1 + rand(100)))));
+    }
+    envs.push_back(env);
+  }
+  return envs;
+}
+
+/// \brief Apply `f` on all consecutive environments, return the time in ms
+template < typename Function >
+double run(const std::vector< SeparateDomain >& envs,
+           std::size_t& acc,
+           Function f) {
+  BenchmarkTimer timer;
+  for (int k = 0; k < Iterations; ++k) {
+    for (std::size_t i = 1; i < envs.size(); ++i) {
+      f(acc, envs[i - 1], envs[i]);
+    }
+  }
+  return timer.elapsed_ms();
+}
+
+/// \brief Display the time of an operation on SeparateDomain
+template < typename Function >
+void benchmark(const char* name, Function f) {
+  VariableFactory vfac;
+  std::vector< Variable > vars;
+  vars.reserve(NumVariables);
+  for (std::size_t i = 0; i < NumVariables; ++i) {
+    vars.push_back(vfac.get("x" + std::to_string(i)));
+  }
+
+  BenchmarkTimer timer;
+  std::vector< SeparateDomain > envs = make_environments(vars);
+  double build_time = timer.elapsed_ms();
+
+  std::size_t acc = 0;
+  double time = run(envs, acc, f);
+
+  BOOST_CHECK(acc > 0);
+  BOOST_TEST_MESSAGE(name << ": " << time << "ms (build " << build_time
+                          << "ms)");
+}
+
+} // end anonymous namespace
+
+BOOST_AUTO_TEST_CASE(benchmark_join) {
+  benchmark("join", [](std::size_t& acc, const auto& x, const auto& y) {
+    auto z = x.join(y);
+    acc += z.is_top() ? 0 : 1;
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_join_with) {
+  benchmark("join_with", [](std::size_t& acc, const auto& x, const auto& y) {
+    auto z = x;
+    z.join_with(y);
+    z.join_with(x);
+    acc += z.is_top() ? 0 : 1;
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_leq) {
+  benchmark("leq", [](std::size_t& acc, const auto& x, const auto& y) {
+    auto z = x.join(y);
+    acc += x.leq(z) ? 1 : 0;
+    acc += y.leq(z) ? 1 : 0;
+    acc += z.leq(x) ? 1 : 0;
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_convergence) {
+  // Similar to the convergence check of the fixpoint iterator, where the new
+  // invariant is equal to the previous one, but computed separately
+  benchmark("convergence", [](std::size_t& acc, const auto& x, const auto& y) {
+    auto z1 = x.join(y);
+    auto z2 = y.join(x);
+    acc += z1.leq(z2) ? 1 : 0;
+    acc += z2.leq(z1) ? 1 : 0;
+  });
+}
@@ -42,6 +42,9 @@
 
 #define BOOST_TEST_MODULE test_muzq
 #define BOOST_TEST_DYN_LINK
+#include <set>
+#include <vector>
+
 #include <boost/mpl/list.hpp>
 #include <boost/test/output_test_stream.hpp>
 #include <boost/test/unit_test.hpp>
@@ -570,3 +573,184 @@ BOOST_AUTO_TEST_CASE(test6) {
   BOOST_CHECK(end.to_interval(temp1) ==
               ZInterval(ZBound(5), ZBound::plus_infinity()));
 }
+
+BOOST_AUTO_TEST_CASE(sparse_storage) {
+  ControlFlowGraph cfg("entry");
+
+  BasicBlock* entry = cfg.get("entry");
+  BasicBlock* loop1 = cfg.get("loop1");
+  BasicBlock* loop1_t = cfg.get("loop1_t");
+  BasicBlock* loop2 = cfg.get("loop2");
+  BasicBlock* loop2_t = cfg.get("loop2_t");
+  BasicBlock* loop2_body = cfg.get("loop2_body");
+  BasicBlock* loop2_f = cfg.get("loop2_f");
+  BasicBlock* loop1_f = cfg.get("loop1_f");
+  BasicBlock* if_t = cfg.get("if_t");
+  BasicBlock* if_f = cfg.get("if_f");
+  BasicBlock* ret = cfg.get("ret");
+
+  VariableFactory vfac;
+  Variable i(vfac.get("i"));
+  Variable j(vfac.get("j"));
+  Variable s(vfac.get("s"));
+
+  entry->add_successor(loop1);
+  loop1->add_successor(loop1_t);
+  loop1->add_successor(loop1_f);
+  loop1_t->add_successor(loop2);
+  loop2->add_successor(loop2_t);
+  loop2->add_successor(loop2_f);
+  loop2_t->add_successor(loop2_body);
+  loop2_body->add_successor(loop2);
+  loop2_f->add_successor(loop1);
+  loop1_f->add_successor(if_t);
+  loop1_f->add_successor(if_f);
+  if_t->add_successor(ret);
+  if_f->add_successor(ret);
+
+  entry->add(std::make_unique< ZLinearAssignment >(i, ZLinearExpression(0)));
+  entry->add(std::make_unique< ZLinearAssignment >(s, ZLinearExpression(0)));
+
+  loop1_t->add(std::make_unique< ZLinearAssertion >(ZVarExpr(i) <= 9));
+  loop1_t->add(std::make_unique< ZLinearAssignment >(j, ZLinearExpression(0)));
+
+  loop2_t->add(std::make_unique< ZLinearAssertion >(ZVarExpr(j) <= 9));
+  loop2_body->add(std::make_unique< ZLinearAssignment >(j, ZVarExpr(j) + 1));
+  loop2_body->add(std::make_unique< ZLinearAssignment >(s, ZVarExpr(s) + 1));
+
+  loop2_f->add(std::make_unique< ZLinearAssertion >(ZVarExpr(j) >= 10));
+  loop2_f->add(std::make_unique< ZLinearAssignment >(i, ZVarExpr(i) + 1));
+
+  loop1_f->add(std::make_unique< ZLinearAssertion >(ZVarExpr(i) >= 10));
+
+  if_t->add(std::make_unique< ZLinearAssertion >(ZVarExpr(s) <= 50));
+  if_t->add(std::make_unique< ZLinearAssignment >(j, ZLinearExpression(1)));
+  if_f->add(std::make_unique< ZLinearAssertion >(ZVarExpr(s) >= 51));
+  if_f->add(std::make_unique< ZLinearAssignment >(j, ZLinearExpression(2)));
+
+  ret->add(std::make_unique< CheckPoint >("end"));
+
+  muzq::FixpointIterator< Variable, ZIntervalDomain, QIntervalDomain > full(
+      cfg, InvariantStorage::Full);
+  full.run();
+
+  muzq::FixpointIterator< Variable, ZIntervalDomain, QIntervalDomain > sparse(
+      cfg, InvariantStorage::Sparse);
+  sparse.run();
+
+  // Same invariants, in reverse order to recompute long chains
+  std::vector< BasicBlock* > blocks(cfg.begin(), cfg.end());
+  for (auto it = blocks.rbegin(), et = blocks.rend(); it != et; ++it) {
+    BasicBlock* bb = *it;
+    BOOST_CHECK(sparse.recompute_pre(bb).leq(full.pre(bb)));
+    BOOST_CHECK(full.pre(bb).leq(sparse.recompute_pre(bb)));
+    BOOST_CHECK(sparse.recompute_post(bb).leq(full.post(bb)));
+    BOOST_CHECK(full.post(bb).leq(sparse.recompute_post(bb)));
+  }
+
+  // Same invariants when propagated along chains, each block visited once
+  std::set< BasicBlock* > visited;
+  for (BasicBlock* bb : blocks) {
+    sparse.visit_chain(bb, [&](BasicBlock* node, auto pre) {
+      BOOST_CHECK(visited.insert(node).second);
+      BOOST_CHECK(pre.leq(full.pre(node)));
+      BOOST_CHECK(full.pre(node).leq(pre));
+      return sparse.analyze_node(node, std::move(pre));
+    });
+  }
+  BOOST_CHECK(visited.size() == blocks.size());
+
+  // Recomputed invariants are not stored
+  BOOST_CHECK_THROW(sparse.pre(if_t), LogicError);
+  BOOST_CHECK_THROW(sparse.post(if_t), LogicError);
+  BOOST_CHECK_NO_THROW(sparse.pre(ret));
+
+  ZIntervalDomain end = sparse.checkpoint("end").first();
+  BOOST_CHECK(end.to_interval(i) == ZInterval(10));
+  BOOST_CHECK(end.to_interval(j) == ZInterval(ZBound(1), ZBound(2)));
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_iteration) {
+  ControlFlowGraph cfg("entry");
+
+  BasicBlock* entry = cfg.get("entry");
+  BasicBlock* outer = cfg.get("outer");
+  BasicBlock* outer_t = cfg.get("outer_t");
+  BasicBlock* a = cfg.get("a");
+  BasicBlock* a_t = cfg.get("a_t");
+  BasicBlock* a_f = cfg.get("a_f");
+  BasicBlock* b = cfg.get("b");
+  BasicBlock* b_t = cfg.get("b_t");
+  BasicBlock* b_f = cfg.get("b_f");
+  BasicBlock* join = cfg.get("join");
+  BasicBlock* outer_f = cfg.get("outer_f");
+
+  VariableFactory vfac;
+  Variable i(vfac.get("i"));
+  Variable j(vfac.get("j"));
+  Variable k(vfac.get("k"));
+  Variable s(vfac.get("s"));
+
+  entry->add_successor(outer);
+  outer->add_successor(outer_t);
+  outer->add_successor(outer_f);
+  outer_t->add_successor(a);
+  outer_t->add_successor(b);
+  a->add_successor(a_t);
+  a->add_successor(a_f);
+  a_t->add_successor(a);
+  b->add_successor(b_t);
+  b->add_successor(b_f);
+  b_t->add_successor(b);
+  a_f->add_successor(join);
+  b_f->add_successor(join);
+  join->add_successor(outer);
+
+  entry->add(std::make_unique< ZLinearAssignment >(k, ZLinearExpression(0)));
+  entry->add(std::make_unique< ZLinearAssignment >(s, ZLinearExpression(0)));
+
+  outer_t->add(std::make_unique< ZLinearAssertion >(ZVarExpr(k) <= 9));
+  outer_t->add(std::make_unique< ZLinearAssignment >(i, ZLinearExpression(0)));
+  outer_t->add(std::make_unique< ZLinearAssignment >(j, ZLinearExpression(0)));
+
+  a_t->add(std::make_unique< ZLinearAssertion >(ZVarExpr(i) <= 4));
+  a_t->add(std::make_unique< ZLinearAssignment >(i, ZVarExpr(i) + 1));
+  a_f->add(std::make_unique< ZLinearAssertion >(ZVarExpr(i) >= 5));
+  a_f->add(std::make_unique< CheckPoint >("a.exit"));
+
+  b_t->add(std::make_unique< ZLinearAssertion >(ZVarExpr(j) <= 7));
+  b_t->add(std::make_unique< ZLinearAssignment >(j, ZVarExpr(j) + 2));
+  b_f->add(std::make_unique< ZLinearAssertion >(ZVarExpr(j) >= 8));
+  b_f->add(std::make_unique< CheckPoint >("b.exit"));
+
+  join->add(std::make_unique< ZLinearAssignment >(k, ZVarExpr(k) + 1));
+  join->add(std::make_unique< ZLinearAssignment >(s, ZVarExpr(s) + 2));
+
+  outer_f->add(std::make_unique< ZLinearAssertion >(ZVarExpr(k) >= 10));
+  outer_f->add(std::make_unique< CheckPoint >("end"));
+
+  muzq::FixpointIterator< Variable, ZIntervalDomain, QIntervalDomain >
+      sequential(cfg, InvariantStorage::Full, 1);
+  sequential.run();
+
+  for (unsigned jobs : {2U, 4U, 16U}) {
+    muzq::FixpointIterator< Variable, ZIntervalDomain, QIntervalDomain >
+        concurrent(cfg, InvariantStorage::Full, jobs);
+    concurrent.run();
+
+    for (BasicBlock* bb : cfg) {
+      BOOST_CHECK(concurrent.pre(bb).leq(sequential.pre(bb)));
+      BOOST_CHECK(sequential.pre(bb).leq(concurrent.pre(bb)));
+      BOOST_CHECK(concurrent.post(bb).leq(sequential.post(bb)));
+      BOOST_CHECK(sequential.post(bb).leq(concurrent.post(bb)));
+    }
+
+    for (const char* name : {"a.exit", "b.exit", "end"}) {
+      BOOST_CHECK(concurrent.checkpoint(name).leq(sequential.checkpoint(name)));
+      BOOST_CHECK(sequential.checkpoint(name).leq(concurrent.checkpoint(name)));
+    }
+  }
+
+  ZIntervalDomain end = sequential.checkpoint("end").first();
+  BOOST_CHECK(end.to_interval(k) == ZInterval(10));
+}
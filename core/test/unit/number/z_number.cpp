@@ -595,3 +595,70 @@ BOOST_AUTO_TEST_CASE(test_z_number) {
   output << Z(42);
   BOOST_CHECK(output.is_equal("42"));
 }
+
+BOOST_AUTO_TEST_CASE(test_z_number_int64_limits) {
+  using Z = ikos::core::ZNumber;
+
+  const Z min(std::numeric_limits< long long >::min());
+  const Z max(std::numeric_limits< long long >::max());
+  const Z two_63 = Z(1) << 63;
+
+  // overflows of the inline representation
+  BOOST_CHECK(max + 1 == two_63);
+  BOOST_CHECK(max + 1 - 1 == max);
+  BOOST_CHECK(min - 1 == -two_63 - 1);
+  BOOST_CHECK(min - 1 + 1 == min);
+  BOOST_CHECK(max * 2 == (two_63 << 1) - 2);
+  BOOST_CHECK(max * 2 / 2 == max);
+  BOOST_CHECK(min * -1 == two_63);
+  BOOST_CHECK(min / -1 == two_63);
+  BOOST_CHECK(min % -1 == 0);
+  BOOST_CHECK(mod(min, Z(-1)) == 0);
+  BOOST_CHECK(mod(Z(-7), min) == two_63 - 7);
+  BOOST_CHECK(-min == two_63);
+  BOOST_CHECK(-(-min) == min);
+  BOOST_CHECK(abs(min) == two_63);
+  BOOST_CHECK(Z(1) << 62 << 1 == two_63);
+  BOOST_CHECK(Z(-1) << 63 == min);
+  BOOST_CHECK(Z(-1) << 64 == -(two_63 << 1));
+  BOOST_CHECK(two_63 >> 1 == Z(1) << 62);
+  BOOST_CHECK(min >> 64 == -1);
+  BOOST_CHECK(max >> 64 == 0);
+  BOOST_CHECK(gcd(min, Z(0)) == two_63);
+  BOOST_CHECK(gcd(min, min) == two_63);
+
+  Z n = max;
+  ++n;
+  BOOST_CHECK(n == two_63);
+  --n;
+  BOOST_CHECK(n == max);
+  n = min;
+  --n;
+  BOOST_CHECK(n == -two_63 - 1);
+  ++n;
+  BOOST_CHECK(n == min);
+
+  // comparison between inline and GMP representations
+  BOOST_CHECK(max < two_63);
+  BOOST_CHECK(min > -two_63 - 1);
+  BOOST_CHECK(Z(0) < two_63);
+  BOOST_CHECK(Z(0) > -two_63 - 1);
+  BOOST_CHECK(two_63 - 1 == max);
+  BOOST_CHECK(two_63 != max);
+
+  // the hash does not depend on the history of the number
+  BOOST_CHECK(hash_value(two_63 - 1) == hash_value(max));
+  BOOST_CHECK(hash_value(-two_63) == hash_value(min));
+
+  // bit operations
+  BOOST_CHECK(two_63.trailing_zeros() == 63);
+  BOOST_CHECK(min.trailing_zeros() == 63);
+  BOOST_CHECK(max.trailing_ones() == 63);
+  BOOST_CHECK(max.size_in_bits() == 63);
+  BOOST_CHECK(min.size_in_bits() == 64);
+  BOOST_CHECK(two_63.size_in_bits() == 64);
+  BOOST_CHECK(((two_63 << 1) | Z(1)) - (two_63 << 1) == 1);
+  BOOST_CHECK((two_63 & max) == 0);
+  BOOST_CHECK((min ^ Z(-1)) == max);
+  BOOST_CHECK(max.next_power_of_2() == two_63);
+}
@@ -0,0 +1,139 @@
+/*******************************************************************************
+ *
+ * Micro-benchmarks for ZNumber
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2018 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <cstdint>
+#include <vector>
+
+#define BOOST_TEST_MODULE test_z_number_benchmark
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <ikos/core/number/z_number.hpp>
+
+#include "benchmark_timer.hpp"
+
+// Run with `--log_level=message` to display the timings.
+
+namespace {
+
+using Z = ikos::core::ZNumber;
+
+/// \brief Number of iterations over the operands
+constexpr int Iterations = 20;
+
+/// \brief Return a vector of pseudo-random operands in [-2**20, 2**20]
+template < typename Number >
+std::vector< Number > make_operands(std::size_t size) {
+  std::vector< Number > operands;
+  operands.reserve(size);
+  std::uint64_t state = 42;
+  for (std::size_t i = 0; i < size; ++i) {
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    long n = static_cast< long >(state >> 43) - (1L << 20);
+    // Avoid zero, since the operands are also used as divisors
+    operands.emplace_back(n == 0 ? 1L : n);
+  }
+  return operands;
+}
+
+/// \brief Apply `f(x, y)` on all consecutive operands, return the time in ms
+template < typename Number, typename Function >
+double run(const std::vector< Number >& operands, Number& acc, Function f) {
+  BenchmarkTimer timer;
+  for (int k = 0; k < Iterations; ++k) {
+    for (std::size_t i = 1; i < operands.size(); ++i) {
+      f(acc, operands[i - 1], operands[i]);
+    }
+  }
+  return timer.elapsed_ms();
+}
+
+/// \brief Compare the time of an operation on ZNumber and mpz_class
+template < typename Function >
+void benchmark(const char* name, Function f) {
+  const std::size_t size = 10000;
+  std::vector< Z > z_operands = make_operands< Z >(size);
+  std::vector< mpz_class > mpz_operands = make_operands< mpz_class >(size);
+
+  Z z_acc(0);
+  mpz_class mpz_acc(0);
+  double z_time = run(z_operands, z_acc, f);
+  double mpz_time = run(mpz_operands, mpz_acc, f);
+
+  BOOST_CHECK(z_acc.mpz() == mpz_acc);
+  BOOST_TEST_MESSAGE(name << ": ZNumber " << z_time << "ms, mpz_class "
+                          << mpz_time << "ms, speedup "
+                          << (mpz_time / z_time) << "x");
+}
+
+} // end anonymous namespace
+
+BOOST_AUTO_TEST_CASE(benchmark_add) {
+  benchmark("add", [](auto& acc, const auto& x, const auto& y) {
+    acc += x + y;
+    acc -= y;
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_mul) {
+  benchmark("mul", [](auto& acc, const auto& x, const auto& y) {
+    acc += x * y;
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_div) {
+  benchmark("div", [](auto& acc, const auto& x, const auto& y) {
+    acc += (x * 1000) / y;
+    acc += (x * 1000) % y;
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_compare) {
+  benchmark("compare", [](auto& acc, const auto& x, const auto& y) {
+    if (x < y) {
+      ++acc;
+    }
+    if (x == y || x >= acc) {
+      --acc;
+    }
+  });
+}